@@ -0,0 +1,140 @@
+// Benchmarks the heap traffic of the CPU half of an import (ModelManager::ImportScene) with
+// scratch data on the heap and in the per-thread arenas (ScratchArena). Counts every
+// operator new of the process, arena blocks included, so the numbers cover the loader, the
+// post-processing and the optimizer. Peak RSS is measured per run where the platform can reset it (Linux).
+// Without a path, an OBJ grid without normals is generated first.
+//
+// Usage: bench_import_memory [modelPath | gridSize] [runs]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Arena.h"
+#include "Utility/Log.hpp"
+#include "Utility/MemoryStats.h"
+#include "Utility/Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+using namespace isaacObjectViewer;
+
+static std::atomic<std::size_t> s_Allocations { 0 };
+static std::atomic<std::size_t> s_AllocatedBytes { 0 };
+
+void* operator new(std::size_t size)
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// std::pmr::new_delete_resource allocates through the aligned forms; the original malloc
+// pointer is kept just below the aligned block
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    unsigned char* raw = static_cast<unsigned char*>(operator new(size + align + sizeof(void*)));
+    const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + align - 1) & ~std::uintptr_t(align - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void  operator delete(void* p, std::align_val_t) noexcept { if (p) std::free(static_cast<void**>(p)[-1]); }
+void  operator delete[](void* p, std::align_val_t a) noexcept { operator delete(p, a); }
+void  operator delete(void* p, std::size_t, std::align_val_t a) noexcept { operator delete(p, a); }
+void  operator delete[](void* p, std::size_t, std::align_val_t a) noexcept { operator delete(p, a); }
+
+static std::string WriteGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_import_memory.obj").string();
+    std::ofstream out(path);
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "v " << x * 0.01f << ' ' << y * 0.01f << ' ' << ((x * y) % 7) * 0.001f << '\n';
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "vt " << float(x) / n << ' ' << float(y) / n << '\n';
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            const int i = y * (n + 1) + x + 1;
+            out << "f " << i << '/' << i << ' ' << i + 1 << '/' << i + 1 << ' '
+                << i + n + 2 << '/' << i + n + 2 << ' ' << i + n + 1 << '/' << i + n + 1 << '\n';
+        }
+    return path;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    std::string path;
+    bool generated = false;
+    if (argc > 1 && std::filesystem::exists(argv[1]))
+        path = argv[1];
+    else
+    {
+        path = WriteGrid(argc > 1 ? std::atoi(argv[1]) : 1000);
+        generated = true;
+    }
+    const int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    std::printf("%s, %d runs each\n", path.c_str(), runs);
+
+    MeshCache::SetEnabled(false);
+    const PostProcessOptions options; // every stage in the engine, where the arenas are used
+
+    // first-touch costs (file cache, allocator pools, thread pool) would land on the first mode
+    ModelManager::ImportScene(path, nullptr, options);
+
+    std::printf("  %-8s %14s %12s %12s %14s %10s\n", "scratch", "allocations", "MB allocated", "time", "peak RSS +MB", "blocks");
+    for (const bool arena : { false, true })
+    {
+        ScratchArena::SetEnabled(arena);
+        std::size_t allocations = 0, bytes = 0, peak = 0, blocks = 0;
+        float ms = 0.0f;
+        for (int r = 0; r < runs; ++r)
+        {
+            MemoryStats::ResetPeak();
+            const std::size_t residentBefore = MemoryStats::GetResidentBytes();
+            const std::size_t count0 = s_Allocations.load(), bytes0 = s_AllocatedBytes.load();
+            const std::size_t blocks0 = ScratchArena::GetBlocksAllocated();
+
+            Timer timer;
+            timer.Start();
+            std::unique_ptr<ImportedScene> scene = ModelManager::ImportScene(path, nullptr, options);
+            ms += timer.Stop() * 1000.0f;
+            if (!scene)
+            {
+                std::printf("import failed\n");
+                return 1;
+            }
+
+            allocations += s_Allocations.load() - count0;
+            bytes       += s_AllocatedBytes.load() - bytes0;
+            blocks      += ScratchArena::GetBlocksAllocated() - blocks0;
+            const std::size_t peakNow = MemoryStats::GetPeakResidentBytes();
+            peak = std::max(peak, peakNow > residentBefore ? peakNow - residentBefore : 0);
+        }
+        std::printf("  %-8s %14zu %12.1f %9.1f ms %14.1f %10zu\n", arena ? "arena" : "heap",
+                    allocations / runs, MemoryStats::ToMB(bytes / runs), ms / runs, MemoryStats::ToMB(peak), blocks / runs);
+    }
+    std::printf("  (averages per import; peak RSS is the largest rise over one import)\n");
+
+    if (generated)
+        std::filesystem::remove(path);
+    return 0;
+}
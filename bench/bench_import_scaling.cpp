@@ -0,0 +1,84 @@
+// Benchmarks how import time scales with model size. For each format (OBJ, PLY, glTF) a
+// synthetic model is generated with SyntheticAsset at doubling triangle counts, up to the
+// maximum, and imported with ModelManager::ImportScene (mesh cache disabled, so every run
+// parses). Each row shows the time, throughput, and the time ratio to the previous size:
+// a ratio near 2 is linear scaling, well above 2 points at something superlinear.
+// Rendering needs a GL context; for render curves, generate the same files with iov-gen
+// and load them in the viewer (Draw Statistics panel).
+//
+// Usage: bench_import_scaling [maxTriangles] [meshes] [seed]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Graphics/SyntheticAsset.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+using namespace isaacObjectViewer;
+
+static std::size_t CountTriangles(const ImportedScene& scene)
+{
+    std::size_t triangles = 0;
+    for (const MeshData& mesh : scene.Meshes)
+        triangles += mesh.Indices.size() / 3;
+    for (const MeshStreams& mesh : scene.StreamMeshes)
+        triangles += mesh.IndexCount / 3;
+    return triangles;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    const std::uint64_t maxTriangles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::uint64_t(1) << 22);
+    const unsigned int  meshes       = argc > 2 ? unsigned(std::atoi(argv[2])) : 16;
+    const std::uint64_t seed         = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+
+    MeshCache::SetEnabled(false);
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "bench_import_scaling";
+
+    for (SyntheticFormat format : { SyntheticFormat::Obj, SyntheticFormat::Ply, SyntheticFormat::Gltf })
+    {
+        std::printf("%s, %u meshes, seed %llu\n", SyntheticAsset::GetExtension(format) + 1, meshes, static_cast<unsigned long long>(seed));
+        std::printf("  %12s %10s %10s %12s %8s\n", "triangles", "MB", "ms", "M tris/s", "ratio");
+
+        double previous = 0.0;
+        for (std::uint64_t triangles = 1u << 14; triangles <= maxTriangles; triangles *= 2)
+        {
+            SyntheticAssetOptions options;
+            options.Format    = format;
+            options.Triangles = triangles;
+            options.Meshes    = meshes;
+            options.Seed      = seed;
+            const std::string path = (dir / (std::string("scaling") + SyntheticAsset::GetExtension(format))).string();
+            SyntheticAssetStats stats;
+            if (!SyntheticAsset::Write(path, options, &stats))
+                return 1;
+
+            Timer timer;
+            timer.Start();
+            std::unique_ptr<ImportedScene> scene = ModelManager::ImportScene(path);
+            const double seconds = timer.Stop();
+            if (!scene)
+            {
+                std::printf("  %12llu failed\n", static_cast<unsigned long long>(triangles));
+                continue;
+            }
+
+            char ratio[16] = "-";
+            if (previous > 0.0)
+                std::snprintf(ratio, sizeof(ratio), "%.2f", seconds / previous);
+            std::printf("  %12zu %10.1f %10.1f %12.2f %8s\n", CountTriangles(*scene), stats.Bytes / (1024.0 * 1024.0),
+                        seconds * 1000.0, double(triangles) / seconds / 1e6, ratio);
+            previous = seconds;
+        }
+        std::printf("\n");
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Benchmarks the on-disk mesh cache: writing an entry, then reading it back through mmap.
+// With a model path, also times a full cold import (Assimp, cache disabled) against a warm
+// one (cache hit) through ModelManager::ImportScene.
+//
+// Usage: bench_mesh_cache [meshCount] [verticesPerMesh] [modelPath]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+using namespace isaacObjectViewer;
+
+static ImportedScene MakeScene(unsigned int meshCount, unsigned int verticesPerMesh)
+{
+    ImportedScene scene;
+    scene.Materials.resize(4);
+    scene.Meshes.resize(meshCount);
+    for (unsigned int m = 0; m < meshCount; ++m)
+    {
+        MeshData& mesh = scene.Meshes[m];
+        mesh.Name          = "mesh_" + std::to_string(m);
+        mesh.MaterialIndex = m % 4;
+        mesh.Vertices.resize(verticesPerMesh);
+        for (unsigned int v = 0; v < verticesPerMesh; ++v)
+            mesh.Vertices[v].Position = glm::vec3(float(v + m));
+        mesh.Indices.resize(verticesPerMesh);
+        for (unsigned int i = 0; i < verticesPerMesh; ++i)
+            mesh.Indices[i] = i;
+    }
+    return scene;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    const unsigned int meshCount       = argc > 1 ? std::atoi(argv[1]) : 200;
+    const unsigned int verticesPerMesh = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+    ThreadPool& pool = ThreadPool::GetInstance();
+    const ImportedScene scene = MakeScene(meshCount, verticesPerMesh);
+    const double megabytes = double(meshCount) * verticesPerMesh * (sizeof(Vertex) + sizeof(unsigned int)) / (1024.0 * 1024.0);
+
+    const std::string cachePath = (std::filesystem::temp_directory_path() / "bench_mesh_cache.iovmesh").string();
+    MeshCacheKey key;
+    key.SourceHash    = 0x1234;
+    key.EngineVersion = ENGINE_VERSION;
+
+    std::printf("mesh cache: %u meshes x %u vertices (%.1f MB), %u worker threads\n",
+                meshCount, verticesPerMesh, megabytes, pool.GetThreadCount());
+
+    Timer timer;
+    timer.Start();
+    MeshCache::Write(cachePath, scene, key);
+    const float writeMs = timer.Stop() * 1000.0f;
+
+    timer.Start();
+    auto loaded = MeshCache::Read(cachePath, key);
+    const float readMs = timer.Stop() * 1000.0f;
+    if (!loaded || loaded->Meshes.size() != scene.Meshes.size())
+    {
+        std::printf("  read back failed\n");
+        return 1;
+    }
+
+    std::printf("  write  %8.2f ms  (%7.1f MB/s)\n", writeMs, megabytes / (writeMs / 1000.0));
+    std::printf("  read   %8.2f ms  (%7.1f MB/s)\n", readMs,  megabytes / (readMs  / 1000.0));
+    std::filesystem::remove(cachePath);
+
+    if (argc > 3)
+    {
+        const std::string model = argv[3];
+
+        MeshCache::SetEnabled(false);
+        timer.Start();
+        auto cold = ModelManager::ImportScene(model);
+        const float coldMs = timer.Stop() * 1000.0f;
+
+        MeshCache::SetEnabled(true);
+        ModelManager::ImportScene(model); // make sure the entry exists
+        timer.Start();
+        auto warm = ModelManager::ImportScene(model);
+        const float warmMs = timer.Stop() * 1000.0f;
+
+        if (!cold || !warm)
+        {
+            std::printf("  failed to import %s\n", model.c_str());
+            return 1;
+        }
+        std::printf("%s\n  cold   %8.2f ms\n  warm   %8.2f ms  (%.1fx)\n",
+                    model.c_str(), coldMs, warmMs, coldMs / warmMs);
+    }
+    return 0;
+}
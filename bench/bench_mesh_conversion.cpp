@@ -0,0 +1,148 @@
+// Benchmarks aiMesh -> MeshData conversion: the original per-vertex path against
+// ModelManager::ConvertMeshes on one thread and on the shared worker pool.
+//
+// Usage: bench_mesh_conversion [meshCount] [verticesPerMesh]
+
+#include "Graphics/ModelManager.h"
+#include "Utility/Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+
+using namespace isaacObjectViewer;
+
+// Synthetic triangulated scene shaped like a CAD export: many small/medium meshes
+static aiScene* MakeScene(unsigned int meshCount, unsigned int verticesPerMesh)
+{
+    auto* scene = new aiScene();
+    scene->mNumMeshes = meshCount;
+    scene->mMeshes    = new aiMesh*[meshCount];
+    scene->mRootNode  = new aiNode();
+    scene->mRootNode->mNumMeshes = meshCount;
+    scene->mRootNode->mMeshes    = new unsigned int[meshCount];
+    std::iota(scene->mRootNode->mMeshes, scene->mRootNode->mMeshes + meshCount, 0u);
+
+    const unsigned int faceCount = verticesPerMesh / 3;
+    for (unsigned int m = 0; m < meshCount; ++m)
+    {
+        auto* mesh = new aiMesh();
+        mesh->mName            = aiString("mesh_" + std::to_string(m));
+        mesh->mPrimitiveTypes  = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices     = verticesPerMesh;
+        mesh->mVertices        = new aiVector3D[verticesPerMesh];
+        mesh->mNormals         = new aiVector3D[verticesPerMesh];
+        mesh->mTangents        = new aiVector3D[verticesPerMesh];
+        mesh->mBitangents      = new aiVector3D[verticesPerMesh];
+        mesh->mTextureCoords[0]   = new aiVector3D[verticesPerMesh];
+        mesh->mNumUVComponents[0] = 2;
+        for (unsigned int v = 0; v < verticesPerMesh; ++v)
+        {
+            const float f = float(v + m);
+            mesh->mVertices[v]         = aiVector3D(f, f * 0.5f, f * 0.25f);
+            mesh->mNormals[v]          = aiVector3D(0.0f, 1.0f, 0.0f);
+            mesh->mTangents[v]         = aiVector3D(1.0f, 0.0f, 0.0f);
+            mesh->mBitangents[v]       = aiVector3D(0.0f, 0.0f, 1.0f);
+            mesh->mTextureCoords[0][v] = aiVector3D(f * 0.01f, f * 0.02f, 0.0f);
+        }
+
+        mesh->mNumFaces = faceCount;
+        mesh->mFaces    = new aiFace[faceCount];
+        for (unsigned int f = 0; f < faceCount; ++f)
+        {
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f].mIndices    = new unsigned int[3] { f * 3, f * 3 + 1, f * 3 + 2 };
+        }
+        scene->mMeshes[m] = mesh;
+    }
+    return scene;
+}
+
+// The conversion loop as it was before the parallel path: per-vertex branches + push_back
+static MeshData LegacyConvertMesh(const aiMesh* mesh)
+{
+    MeshData out;
+    out.Name = mesh->mName.C_Str();
+    for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+    {
+        Vertex v{};
+        v.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        if (mesh->HasNormals())
+            v.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+        if (mesh->mTextureCoords[0])
+        {
+            v.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+            if (mesh->HasTangentsAndBitangents())
+            {
+                v.Tangent   = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+                v.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+            }
+        }
+        out.Vertices.push_back(v);
+    }
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++)
+        for (unsigned int j = 0; j < mesh->mFaces[i].mNumIndices; j++)
+            out.Indices.push_back(mesh->mFaces[i].mIndices[j]);
+    return out;
+}
+
+// Best of a few runs, in milliseconds
+template<typename F>
+static double BestOf(int runs, F&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; ++r)
+    {
+        Timer timer;
+        timer.Start();
+        fn();
+        best = std::min(best, double(timer.Stop()) * 1000.0);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    const unsigned int meshCount       = argc > 1 ? unsigned(std::atoi(argv[1])) : 2000;
+    const unsigned int verticesPerMesh = argc > 2 ? unsigned(std::atoi(argv[2])) : 1500;
+    const int          runs            = 3;
+
+    std::printf("Mesh conversion: %u meshes x %u vertices (%.1f M vertices)\n",
+                meshCount, verticesPerMesh, meshCount * double(verticesPerMesh) / 1e6);
+
+    aiScene* scene = MakeScene(meshCount, verticesPerMesh);
+    std::vector<unsigned int> order(meshCount);
+    std::iota(order.begin(), order.end(), 0u);
+
+    std::size_t checksum = 0;
+    const double legacyMs = BestOf(runs, [&]()
+    {
+        std::vector<MeshData> out;
+        out.reserve(order.size());
+        for (unsigned int i : order)
+            out.push_back(LegacyConvertMesh(scene->mMeshes[i]));
+        checksum += out.back().Vertices.size();
+    });
+
+    ThreadPool serial(0);
+    const double serialMs = BestOf(runs, [&]()
+    {
+        auto out = ModelManager::ConvertMeshes(scene, order, serial);
+        checksum += out.back().Vertices.size();
+    });
+
+    ThreadPool& pool = ThreadPool::GetInstance();
+    const double parallelMs = BestOf(runs, [&]()
+    {
+        auto out = ModelManager::ConvertMeshes(scene, order, pool);
+        checksum += out.back().Vertices.size();
+    });
+
+    std::printf("  legacy serial      : %9.2f ms\n", legacyMs);
+    std::printf("  bulk, 1 thread     : %9.2f ms  (%.2fx vs legacy)\n", serialMs, legacyMs / serialMs);
+    std::printf("  bulk, %2u threads   : %9.2f ms  (%.2fx vs legacy, %.2fx vs 1 thread)\n",
+                pool.GetThreadCount() + 1, parallelMs, legacyMs / parallelMs, serialMs / parallelMs);
+    std::printf("  (checksum %zu)\n", checksum);
+
+    delete scene;
+    return 0;
+}
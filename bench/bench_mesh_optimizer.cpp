@@ -0,0 +1,134 @@
+// Benchmarks the mesh optimization stage (MeshOptimizer): ACMR/ATVR of the imported order,
+// of Assimp's aiProcess_ImproveCacheLocality and of the engine passes, with each pass timed on
+// its own. ACMR is vertex shader runs per triangle (0.5 is ideal for a regular grid), ATVR per
+// referenced vertex (1.0 is ideal), both for a 16-entry FIFO. Without a path, an OBJ grid is
+// generated first and its triangles are shuffled, the worst case for the cache.
+//
+// Usage: bench_mesh_optimizer [modelPath | gridSize]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/MeshOptimizer.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace isaacObjectViewer;
+
+static std::string WriteShuffledGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_mesh_optimizer.obj").string();
+    std::ofstream out(path);
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "v " << x * 0.01f << ' ' << y * 0.01f << ' ' << ((x * y) % 7) * 0.001f << '\n';
+    std::vector<std::array<int, 4>> quads;
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            const int i = y * (n + 1) + x + 1;
+            quads.push_back({ i, i + 1, i + n + 2, i + n + 1 });
+        }
+    std::shuffle(quads.begin(), quads.end(), std::mt19937(1));
+    for (const auto& q : quads)
+        out << "f " << q[0] << ' ' << q[1] << ' ' << q[2] << ' ' << q[3] << '\n';
+    return path;
+}
+
+// triangle-weighted over all meshes
+static VertexCacheStats Analyze(const std::vector<MeshData>& meshes)
+{
+    VertexCacheStats total;
+    double triangles = 0.0, vertices = 0.0;
+    for (const MeshData& mesh : meshes)
+    {
+        const VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(),
+                                                                         mesh.Vertices.size());
+        const double t = mesh.Indices.size() / 3.0, v = stats.Atvr > 0.0f ? stats.Acmr * t / stats.Atvr : 0.0;
+        total.Acmr += float(stats.Acmr * t);
+        total.Atvr += float(stats.Atvr * v);
+        triangles  += t;
+        vertices   += v;
+    }
+    if (triangles > 0.0) total.Acmr /= float(triangles);
+    if (vertices > 0.0)  total.Atvr /= float(vertices);
+    return total;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    std::string path;
+    bool generated = false;
+    if (argc > 1 && std::filesystem::exists(argv[1]))
+        path = argv[1];
+    else
+    {
+        path = WriteShuffledGrid(argc > 1 ? std::atoi(argv[1]) : 500);
+        generated = true;
+    }
+    std::printf("%s\n", path.c_str());
+
+    MeshCache::SetEnabled(false);
+
+    PostProcessOptions options;
+    options.Optimize = PostProcessMode::Off;
+    options.Batch    = false; // the meshes as imported
+    std::unique_ptr<ImportedScene> raw = ModelManager::ImportScene(path, nullptr, options);
+    if (!raw)
+    {
+        std::printf("import failed\n");
+        return 1;
+    }
+    std::size_t triangles = 0;
+    for (const MeshData& mesh : raw->Meshes)
+        triangles += mesh.Indices.size() / 3;
+    std::printf("  %zu meshes, %zu triangles\n\n", raw->Meshes.size(), triangles);
+
+    Timer timer;
+    auto report = [](const char* label, const VertexCacheStats& stats, float ms)
+    {
+        std::printf("  %-20s ACMR %.3f  ATVR %.3f  %9.1f ms\n", label, stats.Acmr, stats.Atvr, ms);
+    };
+    report("imported order", Analyze(raw->Meshes), 0.0f);
+
+    // Assimp's pass needs its own import; its cost is the difference to the import without it
+    ModelManager::SetNativeLoadersEnabled(false);
+    timer.Start();
+    std::unique_ptr<ImportedScene> plain = ModelManager::ImportScene(path, nullptr, options);
+    const float plainMs = timer.Stop() * 1000.0f;
+    options.Optimize = PostProcessMode::Assimp;
+    timer.Start();
+    std::unique_ptr<ImportedScene> assimp = ModelManager::ImportScene(path, nullptr, options);
+    const float assimpMs = timer.Stop() * 1000.0f;
+    ModelManager::SetNativeLoadersEnabled(true);
+    if (plain && assimp)
+        report("assimp", Analyze(assimp->Meshes), assimpMs - plainMs);
+
+    std::vector<MeshData> meshes = raw->Meshes;
+    timer.Start();
+    for (MeshData& mesh : meshes)
+        MeshOptimizer::OptimizeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+    report("engine: cache", Analyze(meshes), timer.Stop() * 1000.0f);
+
+    timer.Start();
+    for (MeshData& mesh : meshes)
+        MeshOptimizer::OptimizeOverdraw(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.data(), mesh.Vertices.size());
+    report("engine: overdraw", Analyze(meshes), timer.Stop() * 1000.0f);
+
+    timer.Start();
+    for (MeshData& mesh : meshes)
+        MeshOptimizer::OptimizeVertexFetch(mesh);
+    report("engine: fetch", Analyze(meshes), timer.Stop() * 1000.0f);
+
+    if (generated)
+        std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Benchmarks OBJ import: the native ObjLoader on one thread and on the shared worker pool,
+// against the Assimp path (ModelManager::ImportScene with native loaders and the mesh cache
+// disabled) on the same file. Without a path, a textured grid OBJ is generated first.
+//
+// Usage: bench_obj_loader [objPath | gridSize] [--skip-assimp]
+
+#include "Graphics/ObjLoader.h"
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+static std::string WriteGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_obj_loader.obj").string();
+    std::ofstream out(path);
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "v " << x * 0.01f << ' ' << y * 0.01f << ' ' << ((x * y) % 7) * 0.001f << '\n';
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "vt " << float(x) / n << ' ' << float(y) / n << '\n';
+    out << "vn 0 0 1\n";
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            const int i = y * (n + 1) + x + 1;
+            const int c[4] = { i, i + 1, i + n + 2, i + n + 1 };
+            out << "f";
+            for (int k : c)
+                out << ' ' << k << '/' << k << "/1";
+            out << '\n';
+        }
+    return path;
+}
+
+static std::size_t CountTriangles(const ImportedScene& scene)
+{
+    std::size_t triangles = 0;
+    for (const MeshData& mesh : scene.Meshes)
+        triangles += mesh.Indices.size() / 3;
+    return triangles;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    bool skipAssimp = false;
+    std::string path;
+    bool generated = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--skip-assimp") == 0)
+            skipAssimp = true;
+        else if (std::filesystem::exists(argv[i]))
+            path = argv[i];
+        else
+        {
+            path = WriteGrid(std::atoi(argv[i]));
+            generated = true;
+        }
+    }
+    if (path.empty())
+    {
+        path = WriteGrid(1000);
+        generated = true;
+    }
+
+    const double megabytes = double(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+    std::printf("%s (%.1f MB)\n", path.c_str(), megabytes);
+
+    Timer timer;
+    auto run = [&](const char* label, auto&& load)
+    {
+        timer.Start();
+        std::unique_ptr<ImportedScene> scene = load();
+        const float ms = timer.Stop() * 1000.0f;
+        if (!scene)
+        {
+            std::printf("  %-24s failed\n", label);
+            return;
+        }
+        std::printf("  %-24s %9.1f ms  %7.1f MB/s  %zu meshes, %zu triangles\n",
+                    label, ms, megabytes / (ms / 1000.0), scene->Meshes.size(), CountTriangles(*scene));
+    };
+
+    ThreadPool serial(0);
+    ThreadPool& shared = ThreadPool::GetInstance();
+    run("native, 1 thread", [&]() { return ObjLoader::Load(path, serial); });
+    char label[64];
+    std::snprintf(label, sizeof(label), "native, %u threads", shared.GetThreadCount() + 1);
+    run(label, [&]() { return ObjLoader::Load(path, shared); });
+
+    if (!skipAssimp)
+    {
+        MeshCache::SetEnabled(false);
+        ModelManager::SetNativeLoadersEnabled(false);
+        run("assimp", [&]() { return ModelManager::ImportScene(path); });
+    }
+
+    if (generated)
+        std::filesystem::remove(path);
+    return 0;
+}
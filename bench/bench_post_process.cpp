@@ -0,0 +1,132 @@
+// Benchmarks the geometry post-processing stages: each engine stage (MeshProcessing) on one
+// thread and on the shared worker pool, against the Assimp flag it replaces. Assimp's cost
+// for a flag is the import time with only that flag minus the import time with none.
+// Without a path, an OBJ grid without normals is generated first.
+//
+// Usage: bench_post_process [modelPath | gridSize]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/MeshProcessing.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+static std::string WriteGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_post_process.obj").string();
+    std::ofstream out(path);
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "v " << x * 0.01f << ' ' << y * 0.01f << ' ' << ((x * y) % 7) * 0.001f << '\n';
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            out << "vt " << float(x) / n << ' ' << float(y) / n << '\n';
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            const int i = y * (n + 1) + x + 1;
+            out << "f " << i << '/' << i << ' ' << i + 1 << '/' << i + 1 << ' '
+                << i + n + 2 << '/' << i + n + 2 << ' ' << i + n + 1 << '/' << i + n + 1 << '\n';
+        }
+    return path;
+}
+
+static PostProcessOptions AllStages(PostProcessMode mode)
+{
+    PostProcessOptions options;
+    options.Weld = options.Normals = options.Tangents = mode;
+    return options;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    std::string path;
+    bool generated = false;
+    if (argc > 1 && std::filesystem::exists(argv[1]))
+        path = argv[1];
+    else
+    {
+        path = WriteGrid(argc > 1 ? std::atoi(argv[1]) : 1000);
+        generated = true;
+    }
+    std::printf("%s\n", path.c_str());
+
+    MeshCache::SetEnabled(false);
+    ModelManager::SetNativeLoadersEnabled(false);
+
+    Timer timer;
+    auto import = [&](const PostProcessOptions& options, float& ms)
+    {
+        timer.Start();
+        std::unique_ptr<ImportedScene> scene = ModelManager::ImportScene(path, nullptr, options);
+        ms = timer.Stop() * 1000.0f;
+        return scene;
+    };
+
+    // raw converted meshes: the input of every engine stage
+    float baseMs = 0.0f;
+    std::unique_ptr<ImportedScene> raw = import(AllStages(PostProcessMode::Off), baseMs);
+    if (!raw)
+    {
+        std::printf("import failed\n");
+        return 1;
+    }
+    std::size_t vertices = 0;
+    for (const MeshData& mesh : raw->Meshes)
+        vertices += mesh.Vertices.size();
+    std::printf("  %zu meshes, %zu vertices; import without post-processing %.1f ms\n\n",
+                raw->Meshes.size(), vertices, baseMs);
+
+    struct Stage
+    {
+        const char*      Name;
+        PostProcessMode PostProcessOptions::* Member;
+        void           (*Run)(MeshData&, ThreadPool&);
+    };
+    const Stage stages[] = {
+        { "weld",     &PostProcessOptions::Weld,     [](MeshData& m, ThreadPool& p) { MeshProcessing::WeldVertices(m, p); } },
+        { "normals",  &PostProcessOptions::Normals,  [](MeshData& m, ThreadPool& p) { MeshProcessing::GenerateNormals(m, p); } },
+        { "tangents", &PostProcessOptions::Tangents, [](MeshData& m, ThreadPool& p) { MeshProcessing::GenerateTangents(m, p); } },
+    };
+
+    ThreadPool serial(0);
+    ThreadPool& shared = ThreadPool::GetInstance();
+    std::printf("  %-10s %14s %14s %14s\n", "stage", "assimp", "engine x1",
+                ("engine x" + std::to_string(shared.GetThreadCount() + 1)).c_str());
+    for (const Stage& stage : stages)
+    {
+        PostProcessOptions assimpOnly = AllStages(PostProcessMode::Off);
+        assimpOnly.*stage.Member = PostProcessMode::Assimp;
+        float assimpMs = 0.0f;
+        import(assimpOnly, assimpMs);
+
+        float engineMs[2] = {};
+        ThreadPool* pools[2] = { &serial, &shared };
+        for (int p = 0; p < 2; ++p)
+        {
+            std::vector<MeshData> meshes = raw->Meshes;
+            timer.Start();
+            for (MeshData& mesh : meshes)
+                stage.Run(mesh, *pools[p]);
+            engineMs[p] = timer.Stop() * 1000.0f;
+        }
+        std::printf("  %-10s %11.1f ms %11.1f ms %11.1f ms\n", stage.Name, assimpMs - baseMs, engineMs[0], engineMs[1]);
+    }
+
+    float assimpAll = 0.0f, engineAll = 0.0f;
+    import(AllStages(PostProcessMode::Assimp), assimpAll);
+    import(AllStages(PostProcessMode::Engine), engineAll);
+    std::printf("\n  full import: all stages in assimp %.1f ms, all stages in engine %.1f ms\n", assimpAll, engineAll);
+
+    if (generated)
+        std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Benchmarks the scan importers: the native StlLoader and PlyLoader on one thread and on the
+// shared worker pool, against the Assimp path (ModelManager::ImportScene with native loaders
+// and the mesh cache disabled) on the same file. Reports triangles per second and the peak
+// resident memory of each run. Without a path, a binary STL and a binary PLY grid of
+// gridSize x gridSize quads (2 * gridSize^2 triangles) are generated first.
+//
+// Usage: bench_scan_loaders [stlOrPlyPath | gridSize] [--skip-assimp]
+
+#include "Graphics/StlLoader.h"
+#include "Graphics/PlyLoader.h"
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/MemoryStats.h"
+#include "Utility/Timer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+static float GridHeight(int x, int y) { return ((x * y) % 7) * 0.001f; }
+
+static std::string WriteStlGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_scan_loaders.stl").string();
+    std::ofstream out(path, std::ios::binary);
+    char header[80] = "bench_scan_loaders grid";
+    out.write(header, sizeof(header));
+    const std::uint32_t count = std::uint32_t(2) * n * n;
+    out.write(reinterpret_cast<const char*>(&count), 4);
+
+    std::vector<char> row;
+    for (int y = 0; y < n; ++y)
+    {
+        row.clear();
+        for (int x = 0; x < n; ++x)
+        {
+            const float c[4][3] = {
+                { x * 0.01f,       y * 0.01f,       GridHeight(x, y) },
+                { (x + 1) * 0.01f, y * 0.01f,       GridHeight(x + 1, y) },
+                { (x + 1) * 0.01f, (y + 1) * 0.01f, GridHeight(x + 1, y + 1) },
+                { x * 0.01f,       (y + 1) * 0.01f, GridHeight(x, y + 1) },
+            };
+            const int triangles[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+            for (const auto& t : triangles)
+            {
+                const float normal[3] = { 0.0f, 0.0f, 1.0f };
+                const std::uint16_t attribute = 0;
+                row.insert(row.end(), reinterpret_cast<const char*>(normal), reinterpret_cast<const char*>(normal) + 12);
+                for (int k : t)
+                    row.insert(row.end(), reinterpret_cast<const char*>(c[k]), reinterpret_cast<const char*>(c[k]) + 12);
+                row.insert(row.end(), reinterpret_cast<const char*>(&attribute), reinterpret_cast<const char*>(&attribute) + 2);
+            }
+        }
+        out.write(row.data(), std::streamsize(row.size()));
+    }
+    return path;
+}
+
+static std::string WritePlyGrid(int n)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_scan_loaders.ply").string();
+    std::ofstream out(path, std::ios::binary);
+    out << "ply\nformat binary_little_endian 1.0\n"
+        << "element vertex " << std::size_t(n + 1) * (n + 1) << "\n"
+        << "property float x\nproperty float y\nproperty float z\n"
+        << "element face " << std::size_t(2) * n * n << "\n"
+        << "property list uchar int vertex_indices\n"
+        << "end_header\n";
+
+    std::vector<char> row;
+    for (int y = 0; y <= n; ++y)
+    {
+        row.clear();
+        for (int x = 0; x <= n; ++x)
+        {
+            const float p[3] = { x * 0.01f, y * 0.01f, GridHeight(x, y) };
+            row.insert(row.end(), reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(p) + 12);
+        }
+        out.write(row.data(), std::streamsize(row.size()));
+    }
+    for (int y = 0; y < n; ++y)
+    {
+        row.clear();
+        for (int x = 0; x < n; ++x)
+        {
+            const std::int32_t i = y * (n + 1) + x;
+            const std::int32_t faces[2][3] = { { i, i + 1, i + n + 2 }, { i, i + n + 2, i + n + 1 } };
+            for (const auto& f : faces)
+            {
+                row.push_back(3);
+                row.insert(row.end(), reinterpret_cast<const char*>(f), reinterpret_cast<const char*>(f) + 12);
+            }
+        }
+        out.write(row.data(), std::streamsize(row.size()));
+    }
+    return path;
+}
+
+static bool s_PeakNotReset = false;
+
+static std::size_t CountTriangles(const ImportedScene& scene)
+{
+    std::size_t triangles = 0;
+    for (const MeshData& mesh : scene.Meshes)
+        triangles += mesh.Indices.size() / 3;
+    return triangles;
+}
+
+static void Bench(const std::string& path, bool skipAssimp)
+{
+    const bool isPly = std::filesystem::path(path).extension() == ".ply";
+    const double megabytes = double(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+    std::printf("%s (%.1f MB)\n", path.c_str(), megabytes);
+
+    Timer timer;
+    auto run = [&](const char* label, auto&& load)
+    {
+        const bool peakReset = MemoryStats::ResetPeak();
+        s_PeakNotReset |= !peakReset;
+        const std::size_t baseline = MemoryStats::GetResidentBytes();
+        timer.Start();
+        std::unique_ptr<ImportedScene> scene = load();
+        const float seconds = timer.Stop();
+        if (!scene)
+        {
+            std::printf("  %-24s failed\n", label);
+            return;
+        }
+        const std::size_t triangles = CountTriangles(*scene);
+        const std::size_t peak      = MemoryStats::GetPeakResidentBytes();
+        std::printf("  %-24s %9.1f ms  %7.2f M tris/s  peak %7.0f MB%s (+%.0f MB)  %zu meshes, %zu triangles\n",
+                    label, seconds * 1000.0f, double(triangles) / seconds / 1e6,
+                    MemoryStats::ToMB(peak), peakReset ? "" : "*", MemoryStats::ToMB(peak - std::min(baseline, peak)),
+                    scene->Meshes.size(), triangles);
+    };
+
+    ThreadPool serial(0);
+    ThreadPool& shared = ThreadPool::GetInstance();
+    auto native = [&](ThreadPool& pool)
+    {
+        return isPly ? PlyLoader::Load(path, pool) : StlLoader::Load(path, pool);
+    };
+    run("native, 1 thread", [&]() { return native(serial); });
+    char label[64];
+    std::snprintf(label, sizeof(label), "native, %u threads", shared.GetThreadCount() + 1);
+    run(label, [&]() { return native(shared); });
+
+    if (!skipAssimp)
+    {
+        MeshCache::SetEnabled(false);
+        ModelManager::SetNativeLoadersEnabled(false);
+        run("assimp", [&]() { return ModelManager::ImportScene(path); });
+        ModelManager::SetNativeLoadersEnabled(true);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    bool skipAssimp = false;
+    std::string path;
+    int gridSize = 1000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--skip-assimp") == 0)
+            skipAssimp = true;
+        else if (std::filesystem::exists(argv[i]))
+            path = argv[i];
+        else
+            gridSize = std::atoi(argv[i]);
+    }
+
+    if (!path.empty())
+    {
+        Bench(path, skipAssimp);
+        return 0;
+    }
+
+    for (const std::string& generated : { WriteStlGrid(gridSize), WritePlyGrid(gridSize) })
+    {
+        Bench(generated, skipAssimp);
+        std::filesystem::remove(generated);
+    }
+    if (s_PeakNotReset)
+        std::puts("* peak could not be reset on this platform; it covers the whole process so far");
+    return 0;
+}
@@ -4,7 +4,14 @@
 #include "Mouse.h"
 #include <utility>
 #include "Graphics/TextureManager.h"
+#include "Graphics/ModelManager.h"
+#include "Graphics/ModelImportJob.h"
 #include "Graphics/Tracer.h"
+#include "Graphics/LodSelector.h"
+#include "Graphics/ClusterCuller.h"
+#include "Graphics/ImpostorSelector.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/Timer.h"
 
 namespace isaacObjectViewer
 {
@@ -15,6 +22,7 @@ namespace isaacObjectViewer
         : m_Window(nullptr),
           m_Shader(nullptr),
           m_MainShader(nullptr),
+          m_ImpostorShader(nullptr),
           m_Camera(nullptr),
           m_SelectedObject(nullptr),
           m_DirLight(nullptr),
@@ -107,6 +115,10 @@ namespace isaacObjectViewer
         
         m_MainShader = new Shader(colors_vs.c_str(), colors_fs.c_str());
         m_MainShader->Bind();
+
+        std::string impostor_vs = GetProjectRootPath("src/Resources/Shaders/impostor.vs");
+        std::string impostor_fs = GetProjectRootPath("src/Resources/Shaders/impostor.fs");
+        m_ImpostorShader = new Shader(impostor_vs.c_str(), impostor_fs.c_str());
                                         
         m_BackgroundColor = glm::vec3(0.0f, 0.0f, 0.0f);
 
@@ -208,6 +220,10 @@ namespace isaacObjectViewer
                         case SDLK_H:
                             m_ImGuiLayer.SetGizmoOperation(GizmoMode::NONE);
                             break;
+                        case SDLK_D:
+                            if (MainEvent.key.mod & SDL_KMOD_CTRL)
+                                DuplicateSelectedModel();
+                            break;
                         case SDLK_DELETE:
                             if(m_SelectedObject)
                             {
@@ -230,6 +246,26 @@ namespace isaacObjectViewer
             m_Camera->Update(dt);
 
         Tracer::GetInstance()->Update(dt);
+
+        // background imports: GL uploads get a few ms per frame so the viewer stays interactive
+        constexpr float kImportUploadBudgetMs = 4.0f;
+        Timer budget;
+        budget.Start();
+        for (Model* model : ModelManager::GetInstance().UpdateImports(kImportUploadBudgetMs))
+        {
+            AddSceneObject(model);
+            SetSelectedObject(model);
+        }
+
+        // impostor bakes need the uploaded meshes and the main shader, so they run here on the GL
+        // thread, in what the uploads left of the budget; each gets at least one view a frame
+        for (IObject* obj : m_SceneObjects)
+        {
+            auto* model = dynamic_cast<Model*>(obj);
+            if (model && model->BakeImpostor(m_Renderer, *m_MainShader, kImportUploadBudgetMs - budget.Peek() * 1000.0f)
+                && budget.Peek() * 1000.0f >= kImportUploadBudgetMs)
+                break;
+        }
     }
 
     // @brief renders all of the engine textures, sounds and objects.
@@ -245,24 +281,62 @@ namespace isaacObjectViewer
         m_MainShader->Bind();
         m_MainShader->setVec3("viewPos", m_Camera->GetPosition());
         
-        SendAllLightsToShader();
+        SendAllLightsToShader(m_MainShader);
         m_DirLight->SetUniforms(m_MainShader);
         m_MainShader->setBool("useBlinnPhong", m_BlinnPhongShading);
 
         glm::mat4 view = m_Camera->GetViewMatrix(); // VIEW
         glm::mat4 projection = m_Camera->GetProjectionMatrix(); 
+        LodSelector::BeginFrame(view, projection, static_cast<float>(display_h), m_DeltaTime);
+        ImpostorSelector::BeginFrame();
+
+        // models small on screen are drawn as impostors after the meshes; the meshlets of every other
+        // large mesh are culled up front, in parallel, and each mesh then draws what survived
+        m_ClusterJobs.clear();
+        m_Impostors.clear();
+        const glm::mat4 viewProjection = projection * view;
+        for (auto& obj : m_SceneObjects)
+        {
+            auto* model = dynamic_cast<Model*>(obj);
+            if (!model)
+                continue;
+            if (model->UpdateImpostor())
+                m_Impostors.push_back(model);
+            else
+                model->AddClusterJobs(viewProjection, m_Camera->GetPosition(), m_ClusterJobs);
+        }
+        ClusterCuller::Run(m_ClusterJobs, ThreadPool::GetInstance());
 
         for (auto& obj : m_SceneObjects)
         {
             obj->Render(m_Renderer, view, projection, m_MainShader); 
         }
 
+        if (!m_Impostors.empty())
+        {
+            m_ImpostorShader->Bind();
+            m_ImpostorShader->setVec3("viewPos", m_Camera->GetPosition());
+            SendAllLightsToShader(m_ImpostorShader);
+            m_DirLight->SetUniforms(m_ImpostorShader);
+            m_ImpostorShader->setBool("useBlinnPhong", m_BlinnPhongShading);
+            for (Model* model : m_Impostors)
+                model->RenderImpostor(m_Camera->GetPosition(), view, projection, m_ImpostorShader);
+        }
+
+        // stand-ins for models still importing; not scene objects, so they can't be selected or deleted
+        for (const auto& job : ModelManager::GetInstance().GetImportJobs())
+        {
+            if (Model* preview = job->GetPreview())
+                preview->Render(m_Renderer, view, projection, m_MainShader);
+        }
+
         Tracer::GetInstance()->Render(view, projection, display_w, display_h);
     }
 
     // @brief cleans all of the engine resources.
     void Engine::Clean()
     {
+        ModelManager::GetInstance().CancelImports();
         TextureManager::UnloadAll();
         ClearSceneObjects();
         if(m_SelectedObject)
@@ -270,6 +344,8 @@ namespace isaacObjectViewer
         delete m_Camera;
         delete m_Shader;
         delete m_MainShader;
+        delete m_ImpostorShader;
+        VertexArray::ReleaseShared();
         delete m_Window;
         SDL_Quit();
     }
@@ -293,21 +369,21 @@ namespace isaacObjectViewer
         SDL_SetWindowRelativeMouseMode(m_Window->GetSDLWindow(),true);
     }
         
-    void Engine::SendAllLightsToShader()
+    void Engine::SendAllLightsToShader(Shader* shader)
     {
         int numLights = std::min(int(m_LightObjects.size()),MAX_LIGHTS);
 
         for (int i = 0; i < numLights; ++i) 
         {
-            m_MainShader->setVec3("point_lights[" + std::to_string(i) + "].position", m_LightObjects[i]->GetPosition());
-            m_MainShader->setVec3("point_lights[" + std::to_string(i) + "].ambient", m_LightObjects[i]->GetAmbientIntensity());
-            m_MainShader->setVec3("point_lights[" + std::to_string(i) + "].diffuse", m_LightObjects[i]->GetDiffuseIntensity());
-            m_MainShader->setVec3("point_lights[" + std::to_string(i) + "].specular", m_LightObjects[i]->GetSpecularIntensity());
-            m_MainShader->setFloat("point_lights["+ std::to_string(i) + "].constant", 1.0f);
-            m_MainShader->setFloat("point_lights["+ std::to_string(i) + "].linear", 0.09f);
-            m_MainShader->setFloat("point_lights["+ std::to_string(i) + "].quadratic", 0.032f);
+            shader->setVec3("point_lights[" + std::to_string(i) + "].position", m_LightObjects[i]->GetPosition());
+            shader->setVec3("point_lights[" + std::to_string(i) + "].ambient", m_LightObjects[i]->GetAmbientIntensity());
+            shader->setVec3("point_lights[" + std::to_string(i) + "].diffuse", m_LightObjects[i]->GetDiffuseIntensity());
+            shader->setVec3("point_lights[" + std::to_string(i) + "].specular", m_LightObjects[i]->GetSpecularIntensity());
+            shader->setFloat("point_lights["+ std::to_string(i) + "].constant", 1.0f);
+            shader->setFloat("point_lights["+ std::to_string(i) + "].linear", 0.09f);
+            shader->setFloat("point_lights["+ std::to_string(i) + "].quadratic", 0.032f);
         }
-        m_MainShader->setInt("numPointLights", numLights);
+        shader->setInt("numPointLights", numLights);
         // ----------------------------------------------------
     }
 
@@ -40,6 +40,7 @@
 #include "Graphics/Primitives/Cylinder.h"
 #include "Graphics/Lighting/PointLight.h"
 #include "Graphics/Lighting/DirectionalLight.h"
+#include "Graphics/Model.h"
 #include "Graphics/Renderer/Renderer.h"
 #include "Graphics/Shader/Shader.h"
 #include "../UI/ImGuiLayer.h"
@@ -239,6 +240,19 @@ namespace isaacObjectViewer
             delete object;                           // finally free the memory
         }
 
+        /// @brief Adds a copy of the selected model, sharing its GPU geometry.
+        /// @note only imported models can be duplicated.
+        inline void DuplicateSelectedModel()
+        {
+            auto* model = dynamic_cast<Model*>(m_SelectedObject);
+            if (!model)
+            {
+                LOG_INFO("Select an imported model to duplicate.");
+                return;
+            }
+            AddSceneObject(model->Duplicate());
+        }
+
         /// @brief Clears all scene objects from the engine.
         inline void ClearSceneObjects()
         {
@@ -267,8 +281,9 @@ namespace isaacObjectViewer
         void SetSelectedObject(IObject* obj) { m_SelectedObject = obj; }
 
         // Light
-        /// @brief Sends all light objects to the shader.
-        void SendAllLightsToShader();
+        /// @brief Sends all light objects to a shader.
+        /// @param shader The shader; the main shader or the impostor shader.
+        void SendAllLightsToShader(Shader* shader);
         
         /// @brief Gets the Blinn-Phong shading state.
         /// @return A reference to the Blinn-Phong shading state.
@@ -330,6 +345,7 @@ namespace isaacObjectViewer
         Window* m_Window;
         Shader* m_Shader;
         Shader* m_MainShader;
+        Shader* m_ImpostorShader;
         
         Camera* m_Camera;
         
@@ -342,6 +358,10 @@ namespace isaacObjectViewer
         bool m_UseMaterial = true;
 
         Renderer m_Renderer;
+        /// @brief This frame's cluster culling, kept to reuse its capacity.
+        std::vector<ClusterCullJob> m_ClusterJobs;
+        /// @brief Models drawn as impostors this frame.
+        std::vector<Model*> m_Impostors;
 
         ImGuiLayer m_ImGuiLayer;
 
@@ -5,14 +5,16 @@
 namespace isaacObjectViewer
 {
 
-IndexBuffer::IndexBuffer(const void* data, unsigned int count)
+IndexBuffer::IndexBuffer(const void* data, unsigned int count, unsigned int type)
 : m_Count(count)
+, m_Type(type)
 {
     assert(sizeof(unsigned int) == sizeof(GLuint));
+    assert(type == GL_UNSIGNED_INT || type == GL_UNSIGNED_SHORT);
 
     glGenBuffers(1, &m_RendererID);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count) * GetIndexSize(), data, GL_STATIC_DRAW);
 }
 
 IndexBuffer::~IndexBuffer() { glDeleteBuffers(1, &m_RendererID); }
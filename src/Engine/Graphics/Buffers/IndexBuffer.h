@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "Utility/config.h"
+
 namespace isaacObjectViewer
 {
     class IndexBuffer
@@ -16,7 +18,8 @@ namespace isaacObjectViewer
         /// @brief Constructs an IndexBuffer with the given data and count.
         /// @param data The index data.
         /// @param count The number of indices.
-        IndexBuffer(const void* data, unsigned int count);
+        /// @param type The index type, GL_UNSIGNED_INT or GL_UNSIGNED_SHORT.
+        IndexBuffer(const void* data, unsigned int count, unsigned int type = GL_UNSIGNED_INT);
 
         /// @brief Destroys the IndexBuffer.
         ~IndexBuffer();
@@ -30,8 +33,18 @@ namespace isaacObjectViewer
         /// @brief Gets the number of indices in the IndexBuffer.
         inline unsigned int GetCount() const { return m_Count; }
 
+        /// @brief Gets the type of the indices, to pass to glDrawElements.
+        inline unsigned int GetType() const { return m_Type; }
+
+        /// @brief Gets the size of one index.
+        inline unsigned int GetIndexSize() const { return m_Type == GL_UNSIGNED_SHORT ? 2u : 4u; }
+
+        /// @brief Gets the renderer ID of the IndexBuffer.
+        inline unsigned int GetRendererID() const { return m_RendererID; }
+
     private:
         unsigned int m_RendererID;
         unsigned int m_Count;
+        unsigned int m_Type;
     };
 }
\ No newline at end of file
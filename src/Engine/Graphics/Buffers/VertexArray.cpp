@@ -3,33 +3,91 @@
 
 namespace isaacObjectViewer
 {
-VertexArray::VertexArray() { GLCall(glGenVertexArrays(1, &m_RendererID)); }
-VertexArray::~VertexArray() { GLCall(glDeleteVertexArrays(1, &m_RendererID)); }
+VertexArray::VertexArray(unsigned int shared, std::vector<BufferBinding> bindings)
+    : m_RendererID(shared), m_Bindings(std::move(bindings))
+{
+}
 
-void VertexArray::Bind() const { GLCall(glBindVertexArray(m_RendererID)); }
+void VertexArray::Bind() const
+{
+    for (std::size_t b = 0; b < m_Bindings.size(); ++b)
+        if (m_Bindings[b].Buffer != 0)
+            GLCall(glVertexArrayVertexBuffer(m_RendererID, static_cast<GLuint>(b), m_Bindings[b].Buffer,
+                                             static_cast<GLintptr>(m_Bindings[b].Offset), m_Bindings[b].Stride));
+    GLCall(glBindVertexArray(m_RendererID));
+}
 
 void VertexArray::Unbind() const { GLCall(glBindVertexArray(0)); }
 
-void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+void VertexArray::BindVertexBuffer(unsigned int binding, const VertexBuffer& vb, std::size_t offset, unsigned int stride) const
+{
+    GLCall(glVertexArrayVertexBuffer(m_RendererID, binding, static_cast<unsigned int>(vb.getRendererID()),
+                                     static_cast<GLintptr>(offset), stride));
+}
+
+unsigned int VertexArray::CreateShared(const std::vector<BoundAttribute>& attributes)
+{
+    // the formats are recorded once; each set of buffers only changes the bindings
+    unsigned int id = 0;
+    GLCall(glCreateVertexArrays(1, &id));
+    for (const BoundAttribute& bound : attributes)
+    {
+        const VertexBufferAttribute& attribute = bound.Attribute;
+        const VertexBufferElement&   element   = attribute.m_Element;
+        GLCall(glEnableVertexArrayAttrib(id, attribute.m_Location));
+        if (element.m_Integer)
+            GLCall(glVertexArrayAttribIFormat(id, attribute.m_Location, element.m_Count, element.m_Type, attribute.m_Offset));
+        else
+            GLCall(glVertexArrayAttribFormat(id, attribute.m_Location, element.m_Count, element.m_Type,
+                                             element.m_Normalized ? GL_TRUE : GL_FALSE, attribute.m_Offset));
+        GLCall(glVertexArrayAttribBinding(id, attribute.m_Location, bound.Binding));
+        GLCall(glVertexArrayBindingDivisor(id, bound.Binding, bound.Divisor));
+    }
+    return id;
+}
+
+unsigned int VertexArray::GetShared(const void* key, const VertexBufferAttribute* attributes, std::size_t count)
+{
+    auto it = s_Shared.find(key);
+    if (it != s_Shared.end())
+        return it->second;
+
+    std::vector<BoundAttribute> bound;
+    bound.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        bound.push_back({ attributes[i], 0, 0 });
+    const unsigned int id = CreateShared(bound);
+    s_Shared.emplace(key, id);
+    return id;
+}
+
+std::unique_ptr<VertexArray> VertexArray::ForAttributes(const std::vector<BoundAttribute>& attributes,
+                                                        std::vector<BufferBinding> bindings)
 {
-    Bind();
-    vb.Bind();
-    const auto&  elements = layout.GetElements();
-    unsigned int offset   = 0;
-    for (unsigned int i = 0; i < elements.size(); i++)
+    // the key is everything recorded in the vertex array, and nothing about the buffers
+    std::vector<std::uint32_t> key;
+    key.reserve(attributes.size() * 8);
+    for (const BoundAttribute& bound : attributes)
     {
-        const auto& element = elements[i];
-        // Enable and specify the vertex attribute pointer
-        GLboolean normalized = (element.m_Normalized) ? GL_TRUE : GL_FALSE;
-        GLCall(glEnableVertexAttribArray(i));
-        GLCall(glVertexAttribPointer(
-            i,
-            element.m_Count,
-            element.m_Type,
-            normalized,
-            layout.GetStride(),
-            reinterpret_cast<const void*>(static_cast<std::intptr_t>(offset))));
-        offset += element.m_Count * VertexBufferElement::GetSizeOfType(element.m_Type);
+        const VertexBufferAttribute& attribute = bound.Attribute;
+        key.insert(key.end(), { attribute.m_Location, attribute.m_Element.m_Count, attribute.m_Element.m_Type,
+                                attribute.m_Element.m_Normalized, attribute.m_Element.m_Integer, attribute.m_Offset,
+                                bound.Binding, bound.Divisor });
     }
+
+    auto it = s_SharedFormats.find(key);
+    if (it == s_SharedFormats.end())
+        it = s_SharedFormats.emplace(std::move(key), CreateShared(attributes)).first;
+    return std::unique_ptr<VertexArray>(new VertexArray(it->second, std::move(bindings)));
+}
+
+void VertexArray::ReleaseShared()
+{
+    for (const auto& [key, id] : s_Shared)
+        glDeleteVertexArrays(1, &id);
+    s_Shared.clear();
+    for (const auto& [key, id] : s_SharedFormats)
+        glDeleteVertexArrays(1, &id);
+    s_SharedFormats.clear();
 }
-}  // namespace isaacGraphicsEngine
\ No newline at end of file
+}  // namespace isaacGraphicsEngine
@@ -4,33 +4,114 @@
  *  This class represents a vertex array in the graphics pipeline.
  *  It manages the storage and access of vertex data for rendering,
  *  And provides a method for binding and unbinding the vertex array.
+ *  Buffers of a vertex struct with a VertexLayoutOf share one vertex array per struct
+ *  (ForVertexType): its attribute formats are set once, and binding it only points it at the buffer.
+ *  Layouts only known at runtime (see VertexFormat, and glTF accessors) share one vertex array per
+ *  distinct set of attribute formats the same way (ForAttributes), with one buffer binding per stream.
  */
 
 #pragma once
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace isaacObjectViewer
 {
 class VertexArray
 {
 public:
-    /// @brief Constructs a VertexArray.
-    VertexArray();
+    /// @brief One attribute of a layout only known at runtime.
+    struct BoundAttribute
+    {
+        /// @brief The location, format and offset; the offset is inside one element of the binding.
+        VertexBufferAttribute Attribute;
+        /// @brief The buffer binding the attribute reads from.
+        unsigned int          Binding { 0 };
+        /// @brief Instances per element of the binding; 0 advances it per vertex.
+        unsigned int          Divisor { 0 };
+    };
 
-    /// @brief Destroys the VertexArray.
-    ~VertexArray();
+    /// @brief Where one buffer binding reads from.
+    struct BufferBinding
+    {
+        unsigned int Buffer { 0 };
+        /// @brief Byte offset of the first element in the buffer.
+        std::size_t  Offset { 0 };
+        unsigned int Stride { 0 };
+    };
 
-    /// @brief Binds the VertexArray.
+    /// @brief Destroys the wrapper. The shared vertex array stays alive until ReleaseShared.
+    ~VertexArray() = default;
+
+    VertexArray(const VertexArray&) = delete;
+    VertexArray& operator=(const VertexArray&) = delete;
+
+    /// @brief Gets a vertex array for a buffer of V vertices, laid out as VertexLayoutOf<V>.
+    /// Every buffer of the same vertex type shares one GL vertex array, set up the first time.
+    /// @tparam V The vertex struct.
+    /// @param vb The buffer holding the vertices.
+    /// @return The vertex array; Bind points the shared array at vb.
+    template<typename V>
+    static std::unique_ptr<VertexArray> ForVertexType(const VertexBuffer& vb)
+    {
+        constexpr const auto& layout = VertexLayoutOf<V>::Layout;
+        const unsigned int shared = GetShared(&layout, layout.GetAttributes().data(), layout.GetAttributes().size());
+        return std::unique_ptr<VertexArray>(new VertexArray(shared, { { static_cast<unsigned int>(vb.getRendererID()), 0, layout.GetStride() } }));
+    }
+
+    /// @brief Gets a vertex array for a layout only known at runtime. Every call with the same attribute
+    /// formats shares one GL vertex array, set up the first time; the buffers are the wrapper's own.
+    /// @param attributes The attributes.
+    /// @param bindings The buffers, by binding index, that Bind points the shared array at. Bindings
+    /// left out (an instance buffer, say) are pointed at a buffer with BindVertexBuffer before each draw.
+    /// @return The vertex array.
+    static std::unique_ptr<VertexArray> ForAttributes(const std::vector<BoundAttribute>& attributes,
+                                                      std::vector<BufferBinding> bindings);
+
+    /// @brief Deletes the shared vertex arrays. Call before the GL context goes away.
+    static void ReleaseShared();
+
+    /// @brief Binds the VertexArray, pointing its bindings at the wrapper's buffers.
     void Bind() const;
 
     /// @brief Unbinds the VertexArray.
     void Unbind() const;
 
-    /// @brief Adds a buffer to the VertexArray.
-    void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+    /// @brief Points one binding of the shared vertex array at a buffer, until the next call for it.
+    /// @param binding The binding index.
+    /// @param vb The buffer.
+    /// @param offset The byte offset of the first element in the buffer.
+    /// @param stride The byte distance between consecutive elements.
+    void BindVertexBuffer(unsigned int binding, const VertexBuffer& vb, std::size_t offset, unsigned int stride) const;
+
+    /// @brief Gets the renderer ID of the VertexArray.
+    /// @return The renderer ID.
+    unsigned int GetRendererID() const { return m_RendererID; }
 
 private:
+    /// @brief Wraps a shared vertex array for one set of buffers.
+    VertexArray(unsigned int shared, std::vector<BufferBinding> bindings);
+
+    /// @brief Gets the shared vertex array of a layout, creating it and its attribute formats the first time.
+    /// @param key Identifies the layout (the address of its VertexLayoutOf<V>::Layout).
+    /// @param attributes The attributes, all read from binding 0.
+    /// @param count The number of attributes.
+    /// @return The vertex array.
+    static unsigned int GetShared(const void* key, const VertexBufferAttribute* attributes, std::size_t count);
+
+    /// @brief Creates a vertex array and records the attribute formats and binding divisors in it.
+    static unsigned int CreateShared(const std::vector<BoundAttribute>& attributes);
+
     unsigned int m_RendererID;
+    /// @brief The buffers Bind points the shared vertex array at, by binding index.
+    std::vector<BufferBinding> m_Bindings;
+
+    static inline std::unordered_map<const void*, unsigned int> s_Shared;
+    /// @brief Vertex arrays of runtime layouts, keyed by their attribute formats.
+    static inline std::map<std::vector<std::uint32_t>, unsigned int> s_SharedFormats;
 };
 }
\ No newline at end of file
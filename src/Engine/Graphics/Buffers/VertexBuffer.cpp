@@ -7,6 +7,7 @@ namespace isaacObjectViewer
 {
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+: m_Size(size)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
@@ -18,4 +19,10 @@ VertexBuffer::~VertexBuffer() { GLCall(glDeleteBuffers(1, &m_RendererID)); }
 void VertexBuffer::Bind() const { GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID)); }
 
 void VertexBuffer::Unbind() const { GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0)); }
+
+void VertexBuffer::SetData(unsigned int offset, const void* data, unsigned int size) const
+{
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+}
 }
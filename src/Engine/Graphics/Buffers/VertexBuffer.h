@@ -18,6 +18,10 @@ public:
     /// @param size the size in bytes
     VertexBuffer(const void* data, unsigned int size);
 
+    /// @brief Creates a vertex buffer object with uninitialized storage, to be filled with SetData
+    /// @param size the size in bytes
+    explicit VertexBuffer(unsigned int size) : VertexBuffer(nullptr, size) { }
+
     /// @brief Destroys the VertexBuffer.
     ~VertexBuffer();
 
@@ -27,11 +31,22 @@ public:
     /// @brief Unbinds the VertexBuffer.
     void Unbind() const;
 
+    /// @brief Writes part of the buffer.
+    /// @param offset the byte offset to write at
+    /// @param data pointer to the data
+    /// @param size the size in bytes
+    void SetData(unsigned int offset, const void* data, unsigned int size) const;
+
     /// @brief Gets the renderer ID of the VertexBuffer.
     /// @return The renderer ID.
     int  getRendererID() const { return m_RendererID; }
 
+    /// @brief Gets the size of the buffer.
+    /// @return The size in bytes.
+    unsigned int GetSize() const { return m_Size; }
+
 private:
     unsigned int m_RendererID;
+    unsigned int m_Size;
 };
 }
\ No newline at end of file
@@ -1,14 +1,23 @@
 /**
  *  @file VertexBufferLayout.h
- *  @brief Header file for the VertexBufferLayout class.
- *   This class represents the layout of a vertex buffer in the graphics pipeline.
- *   It manages the organization and attributes of vertex data for rendering.
+ *  @brief Header file for the VertexBufferLayout struct.
+ *   A layout describes how the vertices of a buffer are organised, and is derived at compile time
+ *   from the C++ struct the vertices are written as: the stride is sizeof the struct, each
+ *   attribute's offset is offsetof its member, and the member's type gives the component count,
+ *   the GL type and whether the shader reads it as an integer (glVertexAttribIPointer) or as a
+ *   float. A vertex type declares its layout by specializing VertexLayoutOf; VertexArray::ForVertexType
+ *   then sets up one vertex array per vertex type and shares it between every buffer of that type.
  */
 
 #pragma once
 
 #include "Utility/config.h"
 #include "Utility/GLErrorManager.h"
+#include "Graphics/Vertex.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace isaacObjectViewer
 {
@@ -18,6 +27,7 @@ struct VertexBufferElement
     unsigned int m_Count; // The number of components per vertex attribute
     unsigned int m_Type;  // The data type of the vertex attribute
     bool         m_Normalized; // Whether the attribute is normalized
+    bool         m_Integer = false; // Whether the shader reads the attribute as integers (no conversion to float)
 
     /// @brief  Gets the size of a specific type.
     /// @param type The type to get the size of.
@@ -29,8 +39,14 @@ struct VertexBufferElement
             case GL_FLOAT:
                 return 4;
             case GL_UNSIGNED_INT:
+            case GL_INT:
                 return 4;
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+            case GL_HALF_FLOAT:
+                return 2;
             case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
                 return 1;
         }
         ASSERT(false);
@@ -38,30 +54,108 @@ struct VertexBufferElement
     }
 };
 
-class VertexBufferLayout
+/// @brief One attribute of a vertex struct: where the shader reads it and where it sits in the struct.
+struct VertexBufferAttribute
 {
-public:
-    /// @brief Constructs a VertexBufferLayout.
-    VertexBufferLayout();
+    unsigned int        m_Location;
+    VertexBufferElement m_Element;
+    unsigned int        m_Offset;
+};
+
+/// @brief The GL type of one component of an attribute member.
+template<typename T> struct VertexComponentType;
+template<> struct VertexComponentType<float>         { static constexpr unsigned int Value = GL_FLOAT; };
+template<> struct VertexComponentType<unsigned int>  { static constexpr unsigned int Value = GL_UNSIGNED_INT; };
+template<> struct VertexComponentType<int>           { static constexpr unsigned int Value = GL_INT; };
+template<> struct VertexComponentType<std::uint16_t> { static constexpr unsigned int Value = GL_UNSIGNED_SHORT; };
+template<> struct VertexComponentType<std::int16_t>  { static constexpr unsigned int Value = GL_SHORT; };
+template<> struct VertexComponentType<std::uint8_t>  { static constexpr unsigned int Value = GL_UNSIGNED_BYTE; };
+template<> struct VertexComponentType<std::int8_t>   { static constexpr unsigned int Value = GL_BYTE; };
+
+/// @brief The component type and count of an attribute member: a scalar, a glm vector or a C array.
+template<typename T> struct VertexAttributeTraits
+{
+    using Component = T;
+    static constexpr unsigned int Count = 1;
+};
+template<typename T, std::size_t N> struct VertexAttributeTraits<T[N]>
+{
+    using Component = T;
+    static constexpr unsigned int Count = static_cast<unsigned int>(N);
+};
+template<glm::length_t L, typename T, glm::qualifier Q> struct VertexAttributeTraits<glm::vec<L, T, Q>>
+{
+    using Component = T;
+    static constexpr unsigned int Count = static_cast<unsigned int>(L);
+};
+
+/// @brief Describes an attribute member of type T.
+/// Integer members are read as integers unless normalized, which converts them to [0, 1] or [-1, 1] floats.
+/// @tparam T The member's type.
+/// @param location The attribute location in the shader.
+/// @param offset The member's offset in the vertex struct.
+/// @param normalized True to normalize integer components.
+/// @return The attribute.
+template<typename T>
+constexpr VertexBufferAttribute MakeVertexAttribute(unsigned int location, std::size_t offset, bool normalized = false)
+{
+    using Traits    = VertexAttributeTraits<std::remove_cv_t<T>>;
+    using Component = typename Traits::Component;
+    static_assert(Traits::Count >= 1 && Traits::Count <= 4, "a vertex attribute has one to four components");
+    const bool integer = std::is_integral_v<Component> && !normalized;
+    return { location, { Traits::Count, VertexComponentType<Component>::Value, normalized, integer }, static_cast<unsigned int>(offset) };
+}
+
+/// @brief Describes the member Member of the vertex struct VertexType, read at shader location Location.
+#define VERTEX_ATTRIBUTE(VertexType, Member, Location) \
+    ::isaacObjectViewer::MakeVertexAttribute<decltype(VertexType::Member)>(Location, offsetof(VertexType, Member))
 
-    /// @brief  Pushes a new element into the layout.
-    /// @tparam T The type of the element.
-    /// @param count The number of elements.
-    template<typename T> 
-    void Push(unsigned int count);
+/// @brief The attributes of a vertex struct, fixed at compile time.
+/// @tparam N The number of attributes.
+template<std::size_t N>
+struct VertexBufferLayout
+{
+    unsigned int                         m_Stride;
+    std::array<VertexBufferAttribute, N> m_Attributes;
 
     /// @brief  Gets the stride of the layout.
     /// @return The stride in bytes.
-    inline unsigned int GetStride() const { return m_Stride; }
+    constexpr unsigned int GetStride() const { return m_Stride; }
 
-    /// @brief  Gets the elements of the layout.
-    /// @return The elements of the layout.
-    inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
+    /// @brief  Gets the attributes of the layout.
+    /// @return The attributes of the layout.
+    constexpr const std::array<VertexBufferAttribute, N>& GetAttributes() const { return m_Attributes; }
+};
 
-private:
-    std::vector<VertexBufferElement> m_Elements;
-    unsigned int                     m_Stride;
+/// @brief Builds the layout of a vertex struct from its attributes; the stride is the struct's size.
+/// @tparam V The vertex struct.
+/// @param attributes The attributes, usually VERTEX_ATTRIBUTE(V, Member, Location).
+/// @return The layout.
+template<typename V, typename... Attributes>
+constexpr VertexBufferLayout<sizeof...(Attributes)> MakeVertexBufferLayout(Attributes... attributes)
+{
+    static_assert(std::is_standard_layout_v<V>, "vertex structs must be standard layout for offsetof");
+    return { static_cast<unsigned int>(sizeof(V)), { { attributes... } } };
+}
+
+/// @brief The layout of a vertex struct. Specialize with a static constexpr member Layout.
+template<typename V> struct VertexLayoutOf;
+
+/// @brief Position, normal and UV: the cube and plane primitives.
+template<> struct VertexLayoutOf<PositionNormalTexVertex>
+{
+    static constexpr auto Layout = MakeVertexBufferLayout<PositionNormalTexVertex>(
+        VERTEX_ATTRIBUTE(PositionNormalTexVertex, Position, 0),
+        VERTEX_ATTRIBUTE(PositionNormalTexVertex, Normal, 1),
+        VERTEX_ATTRIBUTE(PositionNormalTexVertex, TexCoords, 2));
 };
 
+/// @brief Position and normal: the sphere and cylinder primitives.
+template<> struct VertexLayoutOf<PositionNormalVertex>
+{
+    static constexpr auto Layout = MakeVertexBufferLayout<PositionNormalVertex>(
+        VERTEX_ATTRIBUTE(PositionNormalVertex, Position, 0),
+        VERTEX_ATTRIBUTE(PositionNormalVertex, Normal, 1));
+};
 
 }
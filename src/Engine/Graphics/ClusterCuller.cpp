@@ -0,0 +1,141 @@
+#include "ClusterCuller.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace isaacObjectViewer
+{
+    // a run of one job's meshlets, tested by one task
+    struct CullBlock
+    {
+        std::size_t             Job;
+        std::size_t             Begin;
+        std::size_t             End;
+        std::vector<IndexRange> Visible;
+        ClusterCullStats        Stats;
+    };
+
+    // frustum planes of a clip-from-object matrix, in object space (Gribb and Hartmann), normalized
+    static void frustumPlanes(const glm::mat4& m, glm::vec4 planes[6])
+    {
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        planes[0] = row3 + row0;
+        planes[1] = row3 - row0;
+        planes[2] = row3 + row1;
+        planes[3] = row3 - row1;
+        planes[4] = row3 + row2;
+        planes[5] = row3 - row2;
+        for (int i = 0; i < 6; ++i)
+        {
+            const float length = glm::length(glm::vec3(planes[i]));
+            if (length > 0.0f)
+                planes[i] /= length;
+        }
+    }
+
+    static void appendRange(std::vector<IndexRange>& ranges, const IndexRange& range)
+    {
+        if (!ranges.empty() && ranges.back().FirstIndex + ranges.back().IndexCount == range.FirstIndex)
+            ranges.back().IndexCount += range.IndexCount;
+        else
+            ranges.push_back(range);
+    }
+
+    static void cullBlock(const ClusterCullJob& job, CullBlock& block, bool cullBackfaces)
+    {
+        glm::vec4 planes[6];
+        frustumPlanes(job.ClipFromMesh, planes);
+
+        const std::vector<Meshlet>& meshlets = *job.Meshlets;
+        for (std::size_t i = block.Begin; i < block.End; ++i)
+        {
+            const Meshlet& meshlet = meshlets[i];
+            const std::size_t triangles = meshlet.IndexCount / 3;
+            block.Stats.Triangles += triangles;
+
+            bool outside = false;
+            for (int p = 0; p < 6 && !outside; ++p)
+                outside = glm::dot(glm::vec3(planes[p]), meshlet.Center) + planes[p].w < -meshlet.Radius;
+            if (outside)
+            {
+                block.Stats.FrustumTriangles += triangles;
+                continue;
+            }
+
+            // every triangle faces away when the camera is inside the cone's back region, even at the sphere's edge
+            if (job.ConesValid && meshlet.ConeCutoff < 1.0f)
+            {
+                const glm::vec3 toCenter = meshlet.Center - job.Camera;
+                if (glm::dot(toCenter, meshlet.ConeAxis) >= meshlet.ConeCutoff * glm::length(toCenter) + meshlet.Radius)
+                {
+                    block.Stats.BackfaceTriangles += triangles;
+                    if (cullBackfaces)
+                        continue;
+                }
+            }
+
+            ++block.Stats.VisibleClusters;
+            appendRange(block.Visible, { meshlet.FirstIndex, meshlet.IndexCount });
+        }
+    }
+
+    const ClusterCullStats& ClusterCuller::Run(const std::vector<ClusterCullJob>& jobs, ThreadPool& pool)
+    {
+        Timer timer;
+        timer.Start();
+
+        std::vector<CullBlock> blocks;
+        for (std::size_t j = 0; j < jobs.size(); ++j)
+        {
+            const std::size_t count = jobs[j].Meshlets->size();
+            for (std::size_t begin = 0; begin < count; begin += kBlockSize)
+                blocks.push_back({ j, begin, std::min(begin + kBlockSize, count), {}, {} });
+        }
+
+        const bool cullBackfaces = s_Settings.Backfaces;
+        pool.ParallelFor(blocks.size(), [&](std::size_t b)
+        {
+            cullBlock(jobs[blocks[b].Job], blocks[b], cullBackfaces);
+        });
+
+        // blocks are in job order, so each job's ranges come out in index order
+        ClusterCullStats stats;
+        stats.Meshes = jobs.size();
+        for (const ClusterCullJob& job : jobs)
+        {
+            job.Visible->clear();
+            stats.Clusters += job.Meshlets->size();
+        }
+        for (const CullBlock& block : blocks)
+        {
+            std::vector<IndexRange>& visible = *jobs[block.Job].Visible;
+            for (const IndexRange& range : block.Visible)
+                appendRange(visible, range);
+            stats.VisibleClusters   += block.Stats.VisibleClusters;
+            stats.Triangles         += block.Stats.Triangles;
+            stats.FrustumTriangles  += block.Stats.FrustumTriangles;
+            stats.BackfaceTriangles += block.Stats.BackfaceTriangles;
+        }
+        for (const ClusterCullJob& job : jobs)
+            stats.Ranges += job.Visible->size();
+
+        stats.Milliseconds = timer.Stop() * 1000.0;
+        s_LastFrame = stats;
+        return s_LastFrame;
+    }
+
+    bool ClusterCuller::KeepsAngles(const glm::mat4& model)
+    {
+        const glm::vec3 x(model[0]), y(model[1]), z(model[2]);
+        const float xx = glm::dot(x, x), yy = glm::dot(y, y), zz = glm::dot(z, z);
+        const float tolerance = 1e-3f * std::max({ xx, yy, zz });
+        return std::abs(xx - yy) <= tolerance && std::abs(xx - zz) <= tolerance
+            && std::abs(glm::dot(x, y)) <= tolerance && std::abs(glm::dot(x, z)) <= tolerance && std::abs(glm::dot(y, z)) <= tolerance
+            && xx > 0.0f;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file ClusterCuller.h
+ * @brief Culls meshlets on the CPU before a frame is drawn.
+ * Each mesh with meshlets adds a job: its meshlets, its clip-from-mesh matrix and the camera in
+ * its space. Run tests every meshlet's bounding sphere against the six frustum planes and its
+ * normal cone against the camera, in blocks spread over the thread pool, and leaves each mesh
+ * the index ranges still to draw, with neighbouring survivors merged into one range.
+ *
+ * The viewer draws back faces (there is no GL face culling), so dropping clusters that face away
+ * would open holes in single-sided surfaces such as scans. Backface culling is therefore off by
+ * default; the stats count what it would remove either way.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include <cstddef>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    /// @brief A range of an index buffer.
+    struct IndexRange
+    {
+        unsigned int FirstIndex;
+        unsigned int IndexCount;
+    };
+
+    /// @brief User settings of cluster culling.
+    struct ClusterCullSettings
+    {
+        /// @brief False draws meshes whole.
+        bool Enabled   { true };
+        /// @brief Also drops clusters that face away from the camera.
+        bool Backfaces { false };
+    };
+
+    /// @brief One mesh to cull.
+    struct ClusterCullJob
+    {
+        const std::vector<Meshlet>* Meshlets;
+        /// @brief projection * view * model.
+        glm::mat4                   ClipFromMesh;
+        /// @brief The camera position, in the mesh's space.
+        glm::vec3                   Camera;
+        /// @brief False when the model matrix scales unevenly or shears, which bends the normal cones.
+        bool                        ConesValid;
+        /// @brief Receives the ranges to draw.
+        std::vector<IndexRange>*    Visible;
+    };
+
+    /// @brief What the last Run culled.
+    struct ClusterCullStats
+    {
+        std::size_t Meshes            = 0;
+        std::size_t Clusters          = 0;
+        std::size_t VisibleClusters   = 0;
+        std::size_t Triangles         = 0;
+        /// @brief Triangles outside the view frustum.
+        std::size_t FrustumTriangles  = 0;
+        /// @brief Triangles of clusters inside the frustum but facing away; only culled with Backfaces.
+        std::size_t BackfaceTriangles = 0;
+        /// @brief Ranges left to draw, after merging neighbours.
+        std::size_t Ranges            = 0;
+        double      Milliseconds      = 0.0;
+    };
+
+    class ClusterCuller
+    {
+    public:
+        /// @brief Meshlets one pool task tests.
+        static constexpr std::size_t kBlockSize = 512;
+
+        /// @brief Culls every job's meshlets and fills in its Visible ranges.
+        /// @param jobs The meshes to cull.
+        /// @param pool The pool to fan out on.
+        /// @return What was culled; also kept for GetLastFrame.
+        static const ClusterCullStats& Run(const std::vector<ClusterCullJob>& jobs, ThreadPool& pool);
+
+        /// @brief Checks if normal cones stay valid under a transform: rotation, translation and uniform scale.
+        /// @param model The model matrix.
+        /// @return True if the transform keeps angles.
+        static bool KeepsAngles(const glm::mat4& model);
+
+        /// @brief Gets what the last Run culled.
+        static const ClusterCullStats& GetLastFrame() { return s_LastFrame; }
+
+        /// @brief Gets the settings, for the UI to edit.
+        static ClusterCullSettings& GetSettings() { return s_Settings; }
+
+    private:
+        ClusterCuller() = delete;
+
+        static inline ClusterCullSettings s_Settings;
+        static inline ClusterCullStats    s_LastFrame;
+    };
+}
@@ -0,0 +1,92 @@
+#include "CpuGeometry.h"
+#include <cmath>
+#include <limits>
+
+namespace isaacObjectViewer
+{
+    CpuGeometry::CpuGeometry(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, CpuResidency residency)
+        : m_Residency(residency)
+    {
+        switch (residency)
+        {
+            case CpuResidency::Full:
+                m_Vertices = std::move(vertices);
+                m_Indices  = std::move(indices);
+                break;
+            case CpuResidency::Picking:
+                m_Positions.reserve(vertices.size());
+                for (const Vertex& v : vertices)
+                    m_Positions.push_back(v.Position);
+                m_Indices = std::move(indices);
+                break;
+            case CpuResidency::None:
+                break;
+        }
+    }
+
+    CpuGeometry::CpuGeometry(std::vector<glm::vec3>&& positions, std::vector<unsigned int>&& indices)
+        : m_Residency(CpuResidency::Picking)
+        , m_Positions(std::move(positions))
+        , m_Indices(std::move(indices))
+    {
+    }
+
+    bool CpuGeometry::IntersectRay(const glm::vec3& origin, const glm::vec3& direction, float* outT) const
+    {
+        const std::size_t vertexCount = m_Residency == CpuResidency::Full ? m_Vertices.size() : m_Positions.size();
+        auto position = [&](unsigned int i) -> const glm::vec3&
+        {
+            return m_Residency == CpuResidency::Full ? m_Vertices[i].Position : m_Positions[i];
+        };
+
+        // Moller-Trumbore, without culling: picking should hit back faces too
+        float nearest = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i + 2 < m_Indices.size(); i += 3)
+        {
+            const unsigned int a = m_Indices[i], b = m_Indices[i + 1], c = m_Indices[i + 2];
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+                continue;
+            const glm::vec3 p0 = position(a);
+            const glm::vec3 e1 = position(b) - p0;
+            const glm::vec3 e2 = position(c) - p0;
+            const glm::vec3 p  = glm::cross(direction, e2);
+            const float det = glm::dot(e1, p);
+            if (std::abs(det) < 1e-12f)
+                continue;
+            const float inverse = 1.0f / det;
+            const glm::vec3 s = origin - p0;
+            const float u = glm::dot(s, p) * inverse;
+            if (u < 0.0f || u > 1.0f)
+                continue;
+            const glm::vec3 q = glm::cross(s, e1);
+            const float v = glm::dot(direction, q) * inverse;
+            if (v < 0.0f || u + v > 1.0f)
+                continue;
+            const float t = glm::dot(e2, q) * inverse;
+            if (t >= 0.0f && t < nearest)
+                nearest = t;
+        }
+        if (nearest == std::numeric_limits<float>::max())
+            return false;
+        if (outT)
+            *outT = nearest;
+        return true;
+    }
+
+    std::size_t CpuGeometry::GetBytes() const
+    {
+        return m_Vertices.size() * sizeof(Vertex) + m_Positions.size() * sizeof(glm::vec3)
+             + m_Indices.size() * sizeof(unsigned int);
+    }
+
+    std::size_t CpuGeometry::BytesFor(CpuResidency residency, std::size_t vertexCount, std::size_t indexCount)
+    {
+        switch (residency)
+        {
+            case CpuResidency::Full:    return vertexCount * sizeof(Vertex) + indexCount * sizeof(unsigned int);
+            case CpuResidency::Picking: return vertexCount * sizeof(glm::vec3) + indexCount * sizeof(unsigned int);
+            case CpuResidency::None:    return 0;
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file CpuGeometry.h
+ * @brief Header file for the CpuResidency enum and the CpuGeometry class.
+ * What stays in system memory of a mesh once it is uploaded. After upload the viewer only
+ * reads positions and indices (for triangle picking), so imports keep just those by default
+ * rather than every 88-byte Vertex; dropping everything leaves picking to bounding boxes.
+ * Like MeshData it owns no GL objects.
+ */
+
+#pragma once
+
+#include "Graphics/Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief How much of a mesh is kept on the CPU after upload.
+    enum class CpuResidency : std::uint8_t
+    {
+        /// @brief Every vertex attribute and index.
+        Full,
+        /// @brief Positions and indices, for triangle picking.
+        Picking,
+        /// @brief Nothing; picking falls back to bounding boxes.
+        None,
+    };
+
+    class CpuGeometry
+    {
+    public:
+        /// @brief Constructs empty geometry (CpuResidency::None).
+        CpuGeometry() = default;
+
+        /// @brief Keeps what the residency asks for of a mesh's vertices and indices.
+        /// @param vertices The vertices; moved from only for CpuResidency::Full.
+        /// @param indices The triangle list; moved from unless the residency is CpuResidency::None.
+        /// @param residency What to keep.
+        CpuGeometry(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, CpuResidency residency);
+
+        /// @brief Keeps positions and indices, for meshes that have nothing else on the CPU.
+        /// @param positions The positions.
+        /// @param indices The triangle list.
+        CpuGeometry(std::vector<glm::vec3>&& positions, std::vector<unsigned int>&& indices);
+
+        /// @brief Gets what is kept.
+        CpuResidency GetResidency() const { return m_Residency; }
+
+        /// @brief Gets the full vertices.
+        /// @return The vertices; empty unless the residency is CpuResidency::Full.
+        const std::vector<Vertex>&       GetVertices()  const { return m_Vertices; }
+
+        /// @brief Gets the positions.
+        /// @return The positions; empty unless the residency is CpuResidency::Picking.
+        const std::vector<glm::vec3>&    GetPositions() const { return m_Positions; }
+
+        /// @brief Gets the indices.
+        /// @return The triangle list; empty for CpuResidency::None.
+        const std::vector<unsigned int>& GetIndices()   const { return m_Indices; }
+
+        /// @brief Checks if triangles can be picked.
+        bool HasTriangles() const { return !m_Indices.empty(); }
+
+        /// @brief Finds the nearest triangle the ray hits, from either side.
+        /// @param origin The ray origin, in the mesh's space.
+        /// @param direction The ray direction, in the mesh's space; need not be normalized.
+        /// @param outT Receives the hit as a multiple of direction from origin.
+        /// @return False if no triangle is hit in front of the origin, or none is kept.
+        bool IntersectRay(const glm::vec3& origin, const glm::vec3& direction, float* outT) const;
+
+        /// @brief Gets the bytes kept.
+        std::size_t GetBytes() const;
+
+        /// @brief Gets the bytes a residency would keep of a mesh.
+        /// @param residency The residency.
+        /// @param vertexCount The number of vertices.
+        /// @param indexCount The number of indices.
+        /// @return The bytes.
+        static std::size_t BytesFor(CpuResidency residency, std::size_t vertexCount, std::size_t indexCount);
+
+    private:
+        CpuResidency              m_Residency { CpuResidency::None };
+        std::vector<Vertex>       m_Vertices;
+        std::vector<glm::vec3>    m_Positions;
+        std::vector<unsigned int> m_Indices;
+    };
+}
@@ -0,0 +1,1001 @@
+#include "GltfLoader.h"
+#include "ModelManager.h"
+#include "Utility/Json.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include "Utility/ThreadPool.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace isaacObjectViewer
+{
+    // --- container -----------------------------------------------------------
+
+    static constexpr std::uint32_t kGlbMagic     = 0x46546C67; // "glTF"
+    static constexpr std::uint32_t kGlbChunkJson = 0x4E4F534A; // "JSON"
+    static constexpr std::uint32_t kGlbChunkBin  = 0x004E4942; // "BIN\0"
+
+    // glTF primitive modes (accessor component types are the GL enums themselves)
+    static constexpr int kModeTriangles     = 4;
+    static constexpr int kModeTriangleStrip = 5;
+    static constexpr int kModeTriangleFan   = 6;
+
+    static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+    static constexpr unsigned int kNoMesh = std::numeric_limits<unsigned int>::max();
+
+    static inline std::uint32_t read32(const unsigned char* p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    struct ByteSpan
+    {
+        const unsigned char* Data = nullptr;
+        std::size_t          Size = 0;
+    };
+
+    struct GltfDocument
+    {
+        JsonValue             Root;
+        std::vector<ByteSpan> Buffers;
+        std::filesystem::path BaseDir;
+    };
+
+    static bool decodeBase64(std::string_view in, std::vector<unsigned char>& out)
+    {
+        auto value = [](char c) -> int
+        {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+' || c == '-') return 62;
+            if (c == '/' || c == '_') return 63;
+            return -1;
+        };
+
+        out.clear();
+        out.reserve(in.size() / 4 * 3);
+        unsigned int acc  = 0;
+        int          bits = 0;
+        for (char c : in)
+        {
+            if (c == '=')
+                break;
+            const int v = value(c);
+            if (v < 0)
+                return false;
+            acc   = (acc << 6) | static_cast<unsigned int>(v);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                out.push_back(static_cast<unsigned char>((acc >> bits) & 0xFF));
+            }
+        }
+        return true;
+    }
+
+    // URIs in glTF are percent-encoded ("my%20model.bin")
+    static std::string decodeUri(const std::string& uri)
+    {
+        auto hex = [](char c) -> int
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+
+        std::string out;
+        out.reserve(uri.size());
+        for (std::size_t i = 0; i < uri.size(); ++i)
+        {
+            if (uri[i] == '%' && i + 2 < uri.size() && hex(uri[i + 1]) >= 0 && hex(uri[i + 2]) >= 0)
+            {
+                out += static_cast<char>(hex(uri[i + 1]) * 16 + hex(uri[i + 2]));
+                i += 2;
+            }
+            else
+            {
+                out += uri[i];
+            }
+        }
+        return out;
+    }
+
+    static inline bool isDataUri(const std::string& uri) { return uri.rfind("data:", 0) == 0; }
+
+    // --- accessors -----------------------------------------------------------
+
+    static int componentCount(const std::string& type)
+    {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2")   return 2;
+        if (type == "VEC3")   return 3;
+        if (type == "VEC4")   return 4;
+        if (type == "MAT2")   return 4;
+        if (type == "MAT3")   return 9;
+        if (type == "MAT4")   return 16;
+        return 0;
+    }
+
+    static std::size_t componentSize(std::uint32_t type)
+    {
+        switch (type)
+        {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:  return 1;
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT: return 2;
+            case GL_UNSIGNED_INT:
+            case GL_FLOAT:          return 4;
+        }
+        return 0;
+    }
+
+    // an accessor resolved against its buffer view and buffer
+    struct GltfAccessor
+    {
+        const JsonValue*     Json          = nullptr;
+        const JsonValue*     Sparse        = nullptr;
+        /// first element; nullptr when the accessor has no buffer view (all zeros before sparse values)
+        const unsigned char* Data          = nullptr;
+        std::size_t          Count         = 0;
+        std::size_t          Stride        = 0;
+        std::size_t          ElementSize   = 0;
+        std::uint32_t        ComponentType = GL_FLOAT;
+        int                  Components    = 0;
+        bool                 Normalized    = false;
+        std::size_t          Buffer        = 0;
+        /// offset of the first element inside Buffer
+        std::size_t          BufferOffset  = 0;
+
+        /// can be bound as a GL attribute without touching the bytes on the CPU
+        bool IsDirect() const { return Data && !Sparse && Stride % 4 == 0 && BufferOffset % 4 == 0; }
+    };
+
+    static bool resolveView(const GltfDocument& doc, std::size_t viewIndex, std::size_t offset, std::size_t length,
+                            const unsigned char*& data, std::size_t* bufferIndex = nullptr, std::size_t* stride = nullptr)
+    {
+        const JsonValue& view = doc.Root["bufferViews"][viewIndex];
+        const std::size_t buffer = view["buffer"].AsSize(kNone);
+        if (!view.IsObject() || buffer >= doc.Buffers.size())
+            return false;
+
+        const ByteSpan&   bytes      = doc.Buffers[buffer];
+        const std::size_t viewOffset = view["byteOffset"].AsSize();
+        const std::size_t viewLength = view["byteLength"].AsSize();
+        if (viewOffset > bytes.Size || viewLength > bytes.Size - viewOffset || offset > viewLength || length > viewLength - offset)
+            return false;
+
+        data = bytes.Data + viewOffset + offset;
+        if (bufferIndex)
+            *bufferIndex = buffer;
+        if (stride)
+            *stride = view["byteStride"].AsSize();
+        return true;
+    }
+
+    static bool resolveAccessor(const GltfDocument& doc, std::size_t index, GltfAccessor& out)
+    {
+        const JsonValue& acc = doc.Root["accessors"][index];
+        if (!acc.IsObject())
+            return false;
+
+        out.Json          = &acc;
+        out.Count         = acc["count"].AsSize();
+        out.ComponentType = static_cast<std::uint32_t>(acc["componentType"].AsInt());
+        out.Components    = componentCount(acc["type"].AsString());
+        out.Normalized    = acc["normalized"].AsBool();
+        out.ElementSize   = componentSize(out.ComponentType) * static_cast<std::size_t>(out.Components);
+        out.Sparse        = acc.Has("sparse") ? &acc["sparse"] : nullptr;
+        out.Stride        = out.ElementSize;
+        if (out.ElementSize == 0)
+            return false;
+        if (!acc.Has("bufferView"))
+            return true;
+
+        // peek at the stride first, then check the whole strided range lies inside the view
+        const unsigned char* data   = nullptr;
+        std::size_t          stride = 0;
+        if (!resolveView(doc, acc["bufferView"].AsSize(kNone), 0, 0, data, nullptr, &stride))
+            return false;
+        if (stride != 0)
+            out.Stride = stride;
+        if (out.Count > 0 && (out.Count - 1) > (std::numeric_limits<std::size_t>::max() - out.ElementSize) / out.Stride)
+            return false;
+
+        const std::size_t offset = acc["byteOffset"].AsSize();
+        const std::size_t length = out.Count > 0 ? (out.Count - 1) * out.Stride + out.ElementSize : 0;
+        if (!resolveView(doc, acc["bufferView"].AsSize(kNone), offset, length, out.Data, &out.Buffer))
+            return false;
+        out.BufferOffset = static_cast<std::size_t>(out.Data - doc.Buffers[out.Buffer].Data);
+        return true;
+    }
+
+    static float readComponent(const unsigned char* p, std::uint32_t type, bool normalized)
+    {
+        switch (type)
+        {
+            case GL_FLOAT:          { float v; std::memcpy(&v, p, 4); return v; }
+            case GL_UNSIGNED_INT:   { std::uint32_t v; std::memcpy(&v, p, 4); return float(v); }
+            case GL_UNSIGNED_SHORT: { std::uint16_t v; std::memcpy(&v, p, 2); return normalized ? v / 65535.0f : float(v); }
+            case GL_SHORT:          { std::int16_t v;  std::memcpy(&v, p, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : float(v); }
+            case GL_UNSIGNED_BYTE:  { return normalized ? p[0] / 255.0f : float(p[0]); }
+            case GL_BYTE:           { std::int8_t v = static_cast<std::int8_t>(p[0]); return normalized ? std::max(v / 127.0f, -1.0f) : float(v); }
+        }
+        return 0.0f;
+    }
+
+    static std::uint32_t readIndex(const unsigned char* p, std::uint32_t type)
+    {
+        switch (type)
+        {
+            case GL_UNSIGNED_INT:   { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+            case GL_UNSIGNED_SHORT: { std::uint16_t v; std::memcpy(&v, p, 2); return v; }
+            case GL_UNSIGNED_BYTE:  return p[0];
+        }
+        return 0;
+    }
+
+    // copies an accessor into tightly packed floats, sparse substitutions applied
+    static std::vector<float> readFloats(const GltfDocument& doc, const GltfAccessor& a)
+    {
+        const std::size_t components = static_cast<std::size_t>(a.Components);
+        const std::size_t compSize   = componentSize(a.ComponentType);
+        std::vector<float> out(a.Count * components, 0.0f);
+
+        auto readElement = [&](const unsigned char* src, std::size_t i)
+        {
+            for (std::size_t c = 0; c < components; ++c)
+                out[i * components + c] = readComponent(src + c * compSize, a.ComponentType, a.Normalized);
+        };
+
+        if (a.Data)
+            for (std::size_t i = 0; i < a.Count; ++i)
+                readElement(a.Data + i * a.Stride, i);
+
+        if (a.Sparse)
+        {
+            const JsonValue&  sparse  = *a.Sparse;
+            const std::size_t count   = sparse["count"].AsSize();
+            const JsonValue&  indices = sparse["indices"];
+            const JsonValue&  values  = sparse["values"];
+            const std::uint32_t indexType = static_cast<std::uint32_t>(indices["componentType"].AsInt());
+
+            const unsigned char* indexData = nullptr;
+            const unsigned char* valueData = nullptr;
+            if (componentSize(indexType) == 0 ||
+                !resolveView(doc, indices["bufferView"].AsSize(kNone), indices["byteOffset"].AsSize(), count * componentSize(indexType), indexData) ||
+                !resolveView(doc, values["bufferView"].AsSize(kNone), values["byteOffset"].AsSize(), count * a.ElementSize, valueData))
+            {
+                LOG_ERROR("glTF: invalid sparse accessor");
+                return out;
+            }
+
+            for (std::size_t s = 0; s < count; ++s)
+            {
+                const std::size_t target = readIndex(indexData + s * componentSize(indexType), indexType);
+                if (target < a.Count)
+                    readElement(valueData + s * a.ElementSize, target);
+            }
+        }
+        return out;
+    }
+
+    // --- primitives ----------------------------------------------------------
+
+    // expands strips and fans into a triangle list; drops triangles with out-of-range vertices
+    static std::vector<std::uint32_t> toTriangleList(int mode, const std::vector<std::uint32_t>& src, std::size_t vertexCount)
+    {
+        std::vector<std::uint32_t> out;
+        auto emit = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c)
+        {
+            if (a < vertexCount && b < vertexCount && c < vertexCount)
+            {
+                out.push_back(a);
+                out.push_back(b);
+                out.push_back(c);
+            }
+        };
+
+        if (mode == kModeTriangles)
+        {
+            out.reserve(src.size() / 3 * 3);
+            for (std::size_t i = 0; i + 2 < src.size(); i += 3)
+                emit(src[i], src[i + 1], src[i + 2]);
+        }
+        else if (mode == kModeTriangleStrip)
+        {
+            out.reserve(src.size() > 2 ? (src.size() - 2) * 3 : 0);
+            for (std::size_t i = 0; i + 2 < src.size(); ++i)
+            {
+                // every other triangle is flipped to keep the winding consistent
+                if (i % 2 == 0)
+                    emit(src[i], src[i + 1], src[i + 2]);
+                else
+                    emit(src[i + 1], src[i], src[i + 2]);
+            }
+        }
+        else if (mode == kModeTriangleFan)
+        {
+            out.reserve(src.size() > 2 ? (src.size() - 2) * 3 : 0);
+            for (std::size_t i = 1; i + 1 < src.size(); ++i)
+                emit(src[i], src[i + 1], src[0]);
+        }
+        return out;
+    }
+
+    static std::vector<std::uint32_t> sourceIndices(const GltfAccessor* indices, std::size_t vertexCount)
+    {
+        std::vector<std::uint32_t> out;
+        if (!indices)
+        {
+            out.resize(vertexCount);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                out[i] = static_cast<std::uint32_t>(i);
+            return out;
+        }
+
+        out.resize(indices->Count);
+        for (std::size_t i = 0; i < indices->Count; ++i)
+            out[i] = readIndex(indices->Data + i * indices->Stride, indices->ComponentType);
+        return out;
+    }
+
+    // Checks a packed index accessor against the vertex count before the GPU reads it as is: a
+    // read-only pass in parallel blocks, stopping early once any block finds an index out of range
+    static bool indicesInRange(const GltfAccessor& indices, std::size_t vertexCount, ThreadPool& pool)
+    {
+        static constexpr std::size_t kBlock = std::size_t(1) << 16;
+        std::atomic<bool> inRange { true };
+        pool.ParallelFor((indices.Count + kBlock - 1) / kBlock, [&](std::size_t b)
+        {
+            if (!inRange.load(std::memory_order_relaxed))
+                return;
+            const std::size_t last = std::min(indices.Count, (b + 1) * kBlock);
+            std::uint32_t maxIndex = 0;
+            for (std::size_t i = b * kBlock; i < last; ++i)
+                maxIndex = std::max(maxIndex, readIndex(indices.Data + i * indices.ElementSize, indices.ComponentType));
+            if (maxIndex >= vertexCount)
+                inRange.store(false, std::memory_order_relaxed);
+        });
+        return inRange.load();
+    }
+
+    enum class PrimitiveKind
+    {
+        Skipped,
+        Streams,
+        Data
+    };
+
+    // Zero-copy path: record where the attributes live and merge overlapping byte ranges,
+    // so an interleaved buffer view is uploaded once rather than once per attribute
+    static void buildStreams(const GltfAccessor* const (&attributes)[3], MeshStreams& out)
+    {
+        struct Span
+        {
+            std::size_t Buffer, Begin, End;
+            const unsigned char* Data;
+        };
+
+        VertexStream* streams[3] = { &out.Position, &out.Normal, &out.TexCoord };
+
+        std::vector<Span> spans;
+        for (const GltfAccessor* a : attributes)
+        {
+            if (a)
+                spans.push_back({ a->Buffer, a->BufferOffset, a->BufferOffset + (a->Count - 1) * a->Stride + a->ElementSize,
+                                  a->Data });
+        }
+        std::sort(spans.begin(), spans.end(), [](const Span& l, const Span& r)
+        {
+            return l.Buffer != r.Buffer ? l.Buffer < r.Buffer : l.Begin < r.Begin;
+        });
+
+        std::vector<Span> merged;
+        for (const Span& span : spans)
+        {
+            if (!merged.empty() && merged.back().Buffer == span.Buffer && span.Begin < merged.back().End)
+                merged.back().End = std::max(merged.back().End, span.End);
+            else
+                merged.push_back(span);
+        }
+
+        for (const Span& span : merged)
+            out.Ranges.push_back({ span.Data, span.End - span.Begin });
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const GltfAccessor* a = attributes[i];
+            if (!a)
+                continue;
+            for (std::size_t r = 0; r < merged.size(); ++r)
+            {
+                if (merged[r].Buffer == a->Buffer && a->BufferOffset >= merged[r].Begin && a->BufferOffset < merged[r].End)
+                {
+                    streams[i]->Range = static_cast<std::uint32_t>(r);
+                    streams[i]->Offset = a->BufferOffset - merged[r].Begin;
+                    break;
+                }
+            }
+            streams[i]->Stride        = static_cast<std::uint32_t>(a->Stride);
+            streams[i]->ComponentType = a->ComponentType;
+            streams[i]->Components    = a->Components;
+            streams[i]->Normalized    = a->Normalized;
+        }
+    }
+
+    static bool accessorBounds(const GltfAccessor& a, glm::vec3& outMin, glm::vec3& outMax)
+    {
+        const JsonValue& mn = (*a.Json)["min"];
+        const JsonValue& mx = (*a.Json)["max"];
+        if (a.Sparse || mn.Size() < 3 || mx.Size() < 3)
+            return false;
+
+        // bounds are stored in the raw component range
+        float scale = 1.0f;
+        if (a.Normalized)
+        {
+            switch (a.ComponentType)
+            {
+                case GL_UNSIGNED_BYTE:  scale = 1.0f / 255.0f;   break;
+                case GL_BYTE:           scale = 1.0f / 127.0f;   break;
+                case GL_UNSIGNED_SHORT: scale = 1.0f / 65535.0f; break;
+                case GL_SHORT:          scale = 1.0f / 32767.0f; break;
+            }
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            outMin[c] = mn[c].AsFloat() * scale;
+            outMax[c] = mx[c].AsFloat() * scale;
+        }
+        return true;
+    }
+
+    static PrimitiveKind convertPrimitive(const GltfDocument& doc, const JsonValue& prim, MeshStreams& streams, MeshData& data,
+                                          ThreadPool& pool)
+    {
+        const int mode = prim["mode"].AsInt(kModeTriangles);
+        if (mode != kModeTriangles && mode != kModeTriangleStrip && mode != kModeTriangleFan)
+            return PrimitiveKind::Skipped; // points and lines
+
+        const JsonValue& attributes = prim["attributes"];
+        GltfAccessor position, normal, uv, indices;
+        if (!resolveAccessor(doc, attributes["POSITION"].AsSize(kNone), position) || position.Components != 3 || position.Count == 0)
+            return PrimitiveKind::Skipped;
+
+        const std::size_t vertexCount = position.Count;
+        const bool hasNormal  = resolveAccessor(doc, attributes["NORMAL"].AsSize(kNone), normal) &&
+                                normal.Components == 3 && normal.Count == vertexCount;
+        const bool hasUv      = resolveAccessor(doc, attributes["TEXCOORD_0"].AsSize(kNone), uv) &&
+                                uv.Components == 2 && uv.Count == vertexCount;
+        const bool hasIndices = prim.Has("indices");
+        if (hasIndices)
+        {
+            if (!resolveAccessor(doc, prim["indices"].AsSize(kNone), indices) || indices.Components != 1 ||
+                indices.Sparse || !indices.Data || indices.ComponentType == GL_FLOAT ||
+                indices.ComponentType == GL_BYTE || indices.ComponentType == GL_SHORT)
+                return PrimitiveKind::Skipped;
+        }
+
+        // --- zero-copy: the GPU reads the source bytes as they are ---
+        if (position.IsDirect() && hasNormal && normal.IsDirect() && (!hasUv || uv.IsDirect()))
+        {
+            const GltfAccessor* const used[3] = { &position, &normal, hasUv ? &uv : nullptr };
+            buildStreams(used, streams);
+            streams.VertexCount = vertexCount;
+
+            const bool packedIndices = hasIndices && indices.Stride == indices.ElementSize &&
+                                       (indices.ComponentType == GL_UNSIGNED_SHORT || indices.ComponentType == GL_UNSIGNED_INT) &&
+                                       indices.BufferOffset % indices.ElementSize == 0;
+            // indices that point past the vertices would make the GPU fetch out of bounds; those
+            // primitives take the copying path, which drops the bad triangles
+            if (mode == kModeTriangles && packedIndices && indicesInRange(indices, vertexCount, pool))
+            {
+                streams.Indices    = indices.Data;
+                streams.IndexType  = indices.ComponentType;
+                streams.IndexCount = static_cast<std::uint32_t>(indices.Count);
+            }
+            else
+            {
+                // byte indices, strips/fans and unindexed primitives need an index list built here
+                const std::vector<std::uint32_t> list = toTriangleList(mode, sourceIndices(hasIndices ? &indices : nullptr, vertexCount), vertexCount);
+                streams.IndexCount = static_cast<std::uint32_t>(list.size());
+                if (vertexCount <= 0x10000)
+                {
+                    streams.IndexType = GL_UNSIGNED_SHORT;
+                    streams.OwnedIndices.resize(list.size() * sizeof(std::uint16_t));
+                    auto* dst = reinterpret_cast<std::uint16_t*>(streams.OwnedIndices.data());
+                    for (std::size_t i = 0; i < list.size(); ++i)
+                        dst[i] = static_cast<std::uint16_t>(list[i]);
+                }
+                else
+                {
+                    streams.IndexType = GL_UNSIGNED_INT;
+                    streams.OwnedIndices.resize(list.size() * sizeof(std::uint32_t));
+                    std::memcpy(streams.OwnedIndices.data(), list.data(), streams.OwnedIndices.size());
+                }
+            }
+
+            if (!accessorBounds(position, streams.BBoxMin, streams.BBoxMax))
+            {
+                // no min/max in the file: one read-only pass over the positions
+                streams.BBoxMin = glm::vec3(std::numeric_limits<float>::max());
+                streams.BBoxMax = glm::vec3(std::numeric_limits<float>::lowest());
+                const std::size_t compSize = componentSize(position.ComponentType);
+                for (std::size_t i = 0; i < vertexCount; ++i)
+                {
+                    const unsigned char* p = position.Data + i * position.Stride;
+                    const glm::vec3 v(readComponent(p, position.ComponentType, position.Normalized),
+                                      readComponent(p + compSize, position.ComponentType, position.Normalized),
+                                      readComponent(p + 2 * compSize, position.ComponentType, position.Normalized));
+                    streams.BBoxMin = glm::min(streams.BBoxMin, v);
+                    streams.BBoxMax = glm::max(streams.BBoxMax, v);
+                }
+            }
+            return PrimitiveKind::Streams;
+        }
+
+        // --- fallback: sparse or unaligned data, or normals to generate ---
+        const std::vector<float> positions = readFloats(doc, position);
+        const std::vector<float> normals   = hasNormal ? readFloats(doc, normal) : std::vector<float>();
+        const std::vector<float> uvs       = hasUv ? readFloats(doc, uv) : std::vector<float>();
+        const std::vector<std::uint32_t> list = toTriangleList(mode, sourceIndices(hasIndices ? &indices : nullptr, vertexCount), vertexCount);
+
+        auto makeVertex = [&](std::size_t v)
+        {
+            Vertex out{};
+            out.Position = glm::vec3(positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]);
+            if (hasNormal)
+                out.Normal = glm::vec3(normals[v * 3], normals[v * 3 + 1], normals[v * 3 + 2]);
+            if (hasUv)
+                out.TexCoords = glm::vec2(uvs[v * 2], uvs[v * 2 + 1]);
+            return out;
+        };
+
+        if (hasNormal)
+        {
+            data.Vertices.resize(vertexCount);
+            for (std::size_t v = 0; v < vertexCount; ++v)
+                data.Vertices[v] = makeVertex(v);
+            data.Indices.assign(list.begin(), list.end());
+        }
+        else
+        {
+            // the spec asks for flat normals, so every triangle gets its own corners
+            data.Vertices.resize(list.size());
+            data.Indices.resize(list.size());
+            for (std::size_t t = 0; t + 2 < list.size(); t += 3)
+            {
+                Vertex corners[3] = { makeVertex(list[t]), makeVertex(list[t + 1]), makeVertex(list[t + 2]) };
+                const glm::vec3 n = glm::cross(corners[1].Position - corners[0].Position, corners[2].Position - corners[0].Position);
+                const float     len = glm::length(n);
+                for (int c = 0; c < 3; ++c)
+                {
+                    corners[c].Normal = len > 0.0f ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+                    data.Vertices[t + c] = corners[c];
+                    data.Indices[t + c]  = static_cast<unsigned int>(t + c);
+                }
+            }
+        }
+        return PrimitiveKind::Data;
+    }
+
+    // --- materials -----------------------------------------------------------
+
+    // the texture key of every image: a canonical path for external files, an embedded image key
+    // for data URIs and buffer views (GLB); empty if the image can't be found
+    static std::vector<std::string> resolveImages(const GltfDocument& doc, ImportedScene& scene)
+    {
+        const JsonValue& images = doc.Root["images"];
+        std::vector<std::string> keys(images.Size());
+        for (std::size_t i = 0; i < images.Size(); ++i)
+        {
+            const JsonValue&   image = images[i];
+            const std::string& uri   = image["uri"].AsString();
+            if (!uri.empty() && !isDataUri(uri))
+            {
+                keys[i] = ModelManager::ResolveTexturePath(doc.BaseDir, decodeUri(uri));
+                continue;
+            }
+
+            const unsigned char* data = nullptr;
+            std::size_t          size = 0;
+            if (!uri.empty())
+            {
+                const std::size_t comma = uri.find(',');
+                std::vector<unsigned char> bytes;
+                if (comma != std::string::npos && decodeBase64(std::string_view(uri).substr(comma + 1), bytes))
+                {
+                    scene.SourceBuffers.push_back(std::move(bytes));
+                    data = scene.SourceBuffers.back().data();
+                    size = scene.SourceBuffers.back().size();
+                }
+            }
+            else
+            {
+                // straight out of the mapping, no copy
+                const std::size_t view = image["bufferView"].AsSize(kNone);
+                size = doc.Root["bufferViews"][view]["byteLength"].AsSize();
+                if (!resolveView(doc, view, 0, size, data))
+                    data = nullptr;
+            }
+
+            if (data && size > 0)
+                keys[i] = scene.AddEmbeddedImage(data, size);
+            else
+                LOG_ERROR("glTF: image {} could not be loaded", i);
+        }
+        return keys;
+    }
+
+    static MaterialData convertMaterial(const GltfDocument& doc, const JsonValue& mat, const std::vector<std::string>& imageKeys)
+    {
+        MaterialData out;
+        const JsonValue& pbr = mat["pbrMetallicRoughness"];
+
+        const JsonValue& factor = pbr["baseColorFactor"];
+        if (factor.Size() >= 3)
+            out.DiffuseColor = glm::vec3(factor[0].AsFloat(1.0f), factor[1].AsFloat(1.0f), factor[2].AsFloat(1.0f));
+
+        // no specular workflow in metallic-roughness: smooth surfaces get a brighter, tighter highlight
+        const float roughness = std::clamp(pbr["roughnessFactor"].AsFloat(1.0f), 0.0f, 1.0f);
+        const float r4        = std::max(roughness * roughness * roughness * roughness, 1e-4f);
+        out.SpecularColor     = glm::vec3(0.5f * (1.0f - roughness));
+        out.Shininess         = std::clamp(2.0f / r4 - 2.0f, 1.0f, 256.0f);
+
+        auto imagePath = [&](const JsonValue& textureInfo) -> std::string
+        {
+            if (!textureInfo.IsObject())
+                return {};
+            const JsonValue&  texture = doc.Root["textures"][textureInfo["index"].AsSize(kNone)];
+            const std::size_t image   = texture["source"].AsSize(kNone);
+            return image < imageKeys.size() ? imageKeys[image] : std::string();
+        };
+
+        if (std::string path = imagePath(pbr["baseColorTexture"]); !path.empty())
+        {
+            out.Textures.push_back({ path, TextureType::DIFFUSE });
+            out.DiffuseMap = path;
+        }
+        if (std::string path = imagePath(mat["normalTexture"]); !path.empty())
+            out.Textures.push_back({ path, TextureType::NORMAL });
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+
+    // a node's transform: either "matrix" (column-major, like glm) or translation * rotation * scale
+    static glm::mat4 nodeTransform(const JsonValue& node)
+    {
+        glm::mat4 transform(1.0f);
+        const JsonValue& matrix = node["matrix"];
+        if (matrix.Size() == 16)
+        {
+            for (int i = 0; i < 16; ++i)
+                transform[i / 4][i % 4] = matrix[i].AsFloat(i % 5 == 0 ? 1.0f : 0.0f);
+            return transform;
+        }
+
+        const JsonValue& t = node["translation"];
+        const JsonValue& r = node["rotation"];
+        const JsonValue& s = node["scale"];
+        if (t.Size() == 3)
+            transform = glm::translate(transform, glm::vec3(t[0].AsFloat(), t[1].AsFloat(), t[2].AsFloat()));
+        if (r.Size() == 4)
+            transform *= glm::mat4_cast(glm::quat(r[3].AsFloat(1.0f), r[0].AsFloat(), r[1].AsFloat(), r[2].AsFloat()));
+        if (s.Size() == 3)
+            transform = glm::scale(transform, glm::vec3(s[0].AsFloat(1.0f), s[1].AsFloat(1.0f), s[2].AsFloat(1.0f)));
+        return transform;
+    }
+
+    // the node tree of the default scene, parents first; node Meshes hold glTF mesh indices.
+    // meshOrder receives every mesh the nodes use, each once, in traversal order
+    static std::vector<SceneNode> collectNodes(const JsonValue& root, std::vector<std::size_t>& meshOrder)
+    {
+        std::vector<SceneNode> nodes;
+        const JsonValue& scenes = root["scenes"];
+        if (scenes.Size() == 0)
+        {
+            // no scene: every mesh once, untransformed
+            for (std::size_t m = 0; m < root["meshes"].Size(); ++m)
+                meshOrder.push_back(m);
+            return nodes;
+        }
+
+        std::unordered_set<std::size_t> seenMeshes, seenNodes;
+        struct Pending { std::size_t Index; int Parent; };
+        std::vector<Pending> stack;
+        const JsonValue& roots = scenes[root["scene"].AsSize(0)]["nodes"];
+        for (std::size_t i = roots.Size(); i-- > 0;)
+            stack.push_back({ roots[i].AsSize(kNone), -1 });
+
+        while (!stack.empty())
+        {
+            const Pending pending = stack.back();
+            stack.pop_back();
+            const JsonValue& node = root["nodes"][pending.Index];
+            if (!node.IsObject() || !seenNodes.insert(pending.Index).second)
+                continue;
+
+            const int index = static_cast<int>(nodes.size());
+            SceneNode& out = nodes.emplace_back();
+            out.Name      = node["name"].AsString();
+            out.Parent    = pending.Parent;
+            out.Transform = nodeTransform(node);
+            if (node.Has("mesh"))
+            {
+                const std::size_t mesh = node["mesh"].AsSize(kNone);
+                if (mesh < root["meshes"].Size())
+                {
+                    out.Meshes.push_back(static_cast<unsigned int>(mesh));
+                    if (seenMeshes.insert(mesh).second)
+                        meshOrder.push_back(mesh);
+                }
+            }
+            const JsonValue& children = node["children"];
+            for (std::size_t i = children.Size(); i-- > 0;)
+                stack.push_back({ children[i].AsSize(kNone), index });
+        }
+        return nodes;
+    }
+
+    std::unique_ptr<ImportedScene> GltfLoader::Load(const std::string& path, ThreadPool& pool, ImportProgress* progress)
+    {
+        MappedFile file(path);
+        if (!file.IsOpen())
+        {
+            LOG_ERROR("Failed to open glTF file: {}", path);
+            if (progress)
+                progress->Enter(ImportStage::Failed);
+            return nullptr;
+        }
+
+        auto scene = LoadFromMemory(file.Data(), file.Size(), std::filesystem::path(path).parent_path(), pool, progress);
+        // a .glb's stream meshes point into this mapping
+        if (scene)
+            scene->SourceFiles.push_back(std::move(file));
+        return scene;
+    }
+
+    std::unique_ptr<ImportedScene> GltfLoader::LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                              const std::filesystem::path& baseDir,
+                                                              ThreadPool& pool, ImportProgress* progress)
+    {
+        auto fail = [progress](ImportStage stage) -> std::unique_ptr<ImportedScene>
+        {
+            if (progress)
+                progress->Enter(stage);
+            return nullptr;
+        };
+
+        if (progress)
+            progress->Enter(ImportStage::Parsing);
+
+        // --- container: GLB chunks or plain JSON ---
+        std::string_view json(reinterpret_cast<const char*>(data), size);
+        ByteSpan         binChunk;
+        if (size >= 12 && read32(data) == kGlbMagic)
+        {
+            if (read32(data + 4) != 2)
+            {
+                LOG_ERROR("glTF: unsupported GLB version {}", read32(data + 4));
+                return fail(ImportStage::Failed);
+            }
+
+            const std::size_t length = std::min<std::size_t>(read32(data + 8), size);
+            json = {};
+            for (std::size_t offset = 12; offset + 8 <= length;)
+            {
+                const std::size_t chunkLength = read32(data + offset);
+                const std::uint32_t chunkType = read32(data + offset + 4);
+                if (chunkLength > length - offset - 8)
+                    break;
+                if (chunkType == kGlbChunkJson && json.empty())
+                    json = std::string_view(reinterpret_cast<const char*>(data + offset + 8), chunkLength);
+                else if (chunkType == kGlbChunkBin && !binChunk.Data)
+                    binChunk = { data + offset + 8, chunkLength };
+                offset += 8 + ((chunkLength + 3) & ~std::size_t(3));
+            }
+            if (json.empty())
+            {
+                LOG_ERROR("glTF: GLB has no JSON chunk");
+                return fail(ImportStage::Failed);
+            }
+        }
+
+        GltfDocument doc;
+        doc.BaseDir = baseDir;
+        std::string error;
+        if (!JsonValue::Parse(json, doc.Root, &error))
+        {
+            LOG_ERROR("glTF: {}", error);
+            return fail(ImportStage::Failed);
+        }
+
+        for (const JsonValue& extension : doc.Root["extensionsRequired"].Elements())
+        {
+            // compressed geometry needs a decoder we don't have; everything else degrades gracefully
+            if (extension.AsString().find("compression") != std::string::npos)
+            {
+                LOG_ERROR("glTF: required extension {} is not supported", extension.AsString());
+                return fail(ImportStage::Failed);
+            }
+        }
+
+        auto scene = std::make_unique<ImportedScene>();
+
+        // --- buffers: the GLB chunk, mapped .bin files or decoded data URIs ---
+        const JsonValue& buffers = doc.Root["buffers"];
+        for (std::size_t b = 0; b < buffers.Size(); ++b)
+        {
+            const std::string& uri = buffers[b]["uri"].AsString();
+            ByteSpan span;
+            if (uri.empty())
+            {
+                span = b == 0 ? binChunk : ByteSpan{};
+            }
+            else if (isDataUri(uri))
+            {
+                const std::size_t comma = uri.find(',');
+                std::vector<unsigned char> bytes;
+                if (comma != std::string::npos && decodeBase64(std::string_view(uri).substr(comma + 1), bytes))
+                {
+                    scene->SourceBuffers.push_back(std::move(bytes));
+                    span = { scene->SourceBuffers.back().data(), scene->SourceBuffers.back().size() };
+                }
+            }
+            else
+            {
+                const std::string binPath = ModelManager::ResolveTexturePath(baseDir, decodeUri(uri));
+                MappedFile file(binPath);
+                if (file.IsOpen())
+                {
+                    span = { file.Data(), file.Size() };
+                    scene->SourceFiles.push_back(std::move(file));
+                }
+            }
+
+            if (!span.Data && buffers[b]["byteLength"].AsSize() > 0)
+                LOG_ERROR("glTF: buffer {} could not be loaded", uri.empty() ? std::to_string(b) : uri);
+            doc.Buffers.push_back(span);
+        }
+
+        if (progress)
+        {
+            if (progress->CancelRequested.load())
+                return fail(ImportStage::Cancelled);
+            progress->Enter(ImportStage::Converting);
+        }
+
+        // --- materials ---
+        const std::vector<std::string> imageKeys = resolveImages(doc, *scene);
+        const JsonValue& materials = doc.Root["materials"];
+        scene->Materials.reserve(materials.Size() + 1);
+        for (const JsonValue& material : materials.Elements())
+            scene->Materials.push_back(convertMaterial(doc, material, imageKeys));
+
+        // --- primitives ---
+        struct PrimitiveRef
+        {
+            const JsonValue* Json;
+            std::string      Name;
+            unsigned int     MaterialIndex;
+            std::size_t      Mesh;
+        };
+
+        std::vector<std::size_t> meshOrder;
+        std::vector<SceneNode>   nodes = collectNodes(doc.Root, meshOrder);
+        std::vector<PrimitiveRef> primitives;
+        unsigned int defaultMaterial = std::numeric_limits<unsigned int>::max();
+        for (std::size_t m : meshOrder)
+        {
+            const JsonValue&   mesh  = doc.Root["meshes"][m];
+            const JsonValue&   prims = mesh["primitives"];
+            const std::string& name  = mesh["name"].AsString();
+            for (std::size_t p = 0; p < prims.Size(); ++p)
+            {
+                std::string primName = name.empty() ? "mesh" + std::to_string(m) : name;
+                if (prims.Size() > 1)
+                    primName += "_" + std::to_string(p);
+
+                std::size_t material = prims[p]["material"].AsSize(kNone);
+                if (material >= scene->Materials.size())
+                {
+                    // glTF's default material is plain white
+                    if (defaultMaterial == std::numeric_limits<unsigned int>::max())
+                    {
+                        defaultMaterial = static_cast<unsigned int>(scene->Materials.size());
+                        scene->Materials.emplace_back();
+                    }
+                    material = defaultMaterial;
+                }
+                primitives.push_back({ &prims[p], std::move(primName), static_cast<unsigned int>(material), m });
+            }
+        }
+
+        std::vector<PrimitiveKind> kinds(primitives.size(), PrimitiveKind::Skipped);
+        std::vector<MeshStreams>   streams(primitives.size());
+        std::vector<MeshData>      meshes(primitives.size());
+        std::atomic<std::size_t>   converted { 0 };
+        pool.ParallelFor(primitives.size(), [&](std::size_t i)
+        {
+            if (progress && progress->CancelRequested.load())
+                return;
+
+            kinds[i] = convertPrimitive(doc, *primitives[i].Json, streams[i], meshes[i], pool);
+
+            if (progress)
+                progress->Fraction.store(float(converted.fetch_add(1) + 1) / float(primitives.size()));
+        });
+        if (progress && progress->CancelRequested.load())
+            return fail(ImportStage::Cancelled);
+
+        // where each primitive ends up: Meshes index, or StreamMeshes index with kStreamBit set
+        static constexpr unsigned int kStreamBit = 1u << 31;
+        std::vector<unsigned int> placed(primitives.size(), kNoMesh);
+        std::size_t skipped = 0;
+        for (std::size_t i = 0; i < primitives.size(); ++i)
+        {
+            switch (kinds[i])
+            {
+                case PrimitiveKind::Streams:
+                    streams[i].Name          = primitives[i].Name;
+                    streams[i].MaterialIndex = primitives[i].MaterialIndex;
+                    placed[i] = static_cast<unsigned int>(scene->StreamMeshes.size()) | kStreamBit;
+                    scene->StreamMeshes.push_back(std::move(streams[i]));
+                    break;
+                case PrimitiveKind::Data:
+                    meshes[i].Name          = primitives[i].Name;
+                    meshes[i].MaterialIndex = primitives[i].MaterialIndex;
+                    if (!meshes[i].Empty())
+                    {
+                        placed[i] = static_cast<unsigned int>(scene->Meshes.size());
+                        scene->Meshes.push_back(std::move(meshes[i]));
+                    }
+                    break;
+                case PrimitiveKind::Skipped:
+                    ++skipped;
+                    break;
+            }
+        }
+        if (skipped > 0)
+            LOG_INFO("glTF: skipped {} primitives (points, lines or invalid accessors)", skipped);
+
+        // nodes place whole glTF meshes; the model's meshes are their primitives, Meshes then StreamMeshes
+        if (!nodes.empty())
+        {
+            std::unordered_map<std::size_t, std::vector<unsigned int>> meshParts;
+            const unsigned int dataCount = static_cast<unsigned int>(scene->Meshes.size());
+            for (std::size_t i = 0; i < primitives.size(); ++i)
+            {
+                if (placed[i] == kNoMesh)
+                    continue;
+                const unsigned int index = (placed[i] & kStreamBit) ? dataCount + (placed[i] & ~kStreamBit) : placed[i];
+                meshParts[primitives[i].Mesh].push_back(index);
+            }
+            for (SceneNode& node : nodes)
+            {
+                std::vector<unsigned int> parts;
+                for (unsigned int mesh : node.Meshes)
+                {
+                    auto it = meshParts.find(mesh);
+                    if (it != meshParts.end())
+                        parts.insert(parts.end(), it->second.begin(), it->second.end());
+                }
+                node.Meshes = std::move(parts);
+            }
+            scene->Nodes = std::move(nodes);
+        }
+
+        return scene;
+    }
+}
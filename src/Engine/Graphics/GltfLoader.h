@@ -0,0 +1,57 @@
+/**
+ * @file GltfLoader.h
+ * @brief Native glTF 2.0 (.gltf + .bin, and binary .glb) importer.
+ * The .glb file or the external .bin buffers are memory-mapped, and every primitive whose
+ * accessors the GPU can read directly becomes a MeshStreams entry that points into the
+ * mapping: the bytes go to the GL buffer as they are, with no aiMesh or Vertex copy in
+ * between. Only POSITION, NORMAL and TEXCOORD_0 are looked at, since those are all the
+ * shaders read. Primitives that need CPU work first (no normals, sparse accessors) fall
+ * back to regular MeshData.
+ *
+ * The default scene's node tree is kept in ImportedScene::Nodes; a mesh placed by several
+ * nodes is loaded once and drawn instanced.
+ *
+ * Materials map the metallic-roughness base color, normal texture and roughness onto the
+ * engine's diffuse/specular Material. Images stored inside the file (GLB buffer views, data
+ * URIs) become ImportedScene::EmbeddedImages and are decoded from memory with the other textures.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    class GltfLoader
+    {
+    public:
+        /// @brief Loads a .gltf or .glb file and the buffers it references.
+        /// @param path The path to the file.
+        /// @param pool The pool to prepare primitives on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene (without decoded images), or nullptr on failure or cancel.
+        /// The scene keeps the mappings its StreamMeshes point into.
+        static std::unique_ptr<ImportedScene> Load(const std::string& path, ThreadPool& pool,
+                                                   ImportProgress* progress = nullptr);
+
+        /// @brief Loads glTF JSON or GLB bytes that are already in memory.
+        /// @param data The file contents; StreamMeshes point into it, so it must outlive the scene.
+        /// @param size The size of the contents in bytes.
+        /// @param baseDir The directory buffer and image URIs are relative to.
+        /// @param pool The pool to prepare primitives on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene (without decoded images), or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                             const std::filesystem::path& baseDir,
+                                                             ThreadPool& pool,
+                                                             ImportProgress* progress = nullptr);
+
+    private:
+        GltfLoader() = delete;
+    };
+}
@@ -0,0 +1,219 @@
+#include "GpuGeometry.h"
+#include "Graphics/MeshProcessing.h"
+#include <cstring>
+
+namespace isaacObjectViewer
+{
+    GpuGeometry::GpuGeometry(std::vector<Vertex> vertices, std::vector<unsigned int> indices, const VertexFormat& format,
+                             CpuResidency residency, const std::vector<MeshLod>& lods, std::vector<Meshlet> meshlets)
+        : m_Meshlets(std::move(meshlets))
+        , m_Format(format)
+    {
+        if (vertices.empty())
+            return;
+
+        m_VertexCount = static_cast<unsigned int>(vertices.size());
+        m_IndexCount  = static_cast<unsigned int>(indices.size());
+
+        // positions as their own stream, then the attributes the format keeps (see VertexFormat.h)
+        std::vector<unsigned char> packed;
+        VertexPacker::Pack(vertices, m_Format, packed);
+        m_VertexBuffer = std::make_unique<VertexBuffer>(packed.data(), static_cast<unsigned int>(packed.size()));
+
+        // the levels of detail go after the full list, in the same buffer
+        std::vector<unsigned int> allLevels;
+        m_Lods = MeshProcessing::ConcatenateLevels(indices, lods, allLevels);
+        const std::vector<unsigned int>& uploaded = allLevels.empty() ? indices : allLevels;
+        const unsigned int uploadedCount = static_cast<unsigned int>(uploaded.size());
+
+        // 16-bit whenever the vertices fit
+        std::vector<std::uint16_t> shortIndices;
+        if (MeshProcessing::NarrowIndices(uploaded.data(), uploaded.size(), vertices.size(), shortIndices))
+            m_IndexBuffer = std::make_unique<IndexBuffer>(shortIndices.data(), uploadedCount, GL_UNSIGNED_SHORT);
+        else if (!uploaded.empty())
+            m_IndexBuffer = std::make_unique<IndexBuffer>(uploaded.data(), uploadedCount);
+
+        CreateFormatVertexArrays();
+
+        // Tight AABB
+        m_BBoxMin = m_BBoxMax = vertices[0].Position;
+        for (std::size_t i = 1; i < vertices.size(); ++i)
+        {
+            m_BBoxMin = glm::min(m_BBoxMin, vertices[i].Position);
+            m_BBoxMax = glm::max(m_BBoxMax, vertices[i].Position);
+        }
+
+        m_Cpu = CpuGeometry(std::move(vertices), std::move(indices), residency);
+    }
+
+    GpuGeometry::GpuGeometry(const PackedGeometry& packed, const VertexFormat& format, CpuResidency residency,
+                             std::vector<Meshlet> meshlets)
+        : m_Lods(packed.Levels)
+        , m_Meshlets(std::move(meshlets))
+        , m_Format(format)
+        , m_BBoxMin(packed.BBoxMin)
+        , m_BBoxMax(packed.BBoxMax)
+    {
+        if (packed.VertexCount == 0 || !packed.IsSet())
+            return;
+
+        m_VertexCount = static_cast<unsigned int>(packed.VertexCount);
+        m_IndexCount  = m_Lods.empty() ? 0 : m_Lods[0].IndexCount;
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(packed.Vertices, static_cast<unsigned int>(VertexPacker::PackedSize(packed.VertexCount, m_Format)));
+        if (packed.IndexCount > 0)
+            m_IndexBuffer = std::make_unique<IndexBuffer>(packed.Indices, static_cast<unsigned int>(packed.IndexCount),
+                                                          packed.ShortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT);
+        CreateFormatVertexArrays();
+
+        // the packed memory goes away after this call: copy out what the residency keeps
+        if (residency == CpuResidency::None)
+            return;
+        std::vector<unsigned int> indices(m_IndexCount);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            indices[i] = packed.ShortIndices ? static_cast<const std::uint16_t*>(packed.Indices)[i]
+                                             : static_cast<const std::uint32_t*>(packed.Indices)[i];
+        if (residency == CpuResidency::Full)
+        {
+            std::vector<Vertex> vertices;
+            VertexPacker::Unpack(packed.Vertices, packed.VertexCount, m_Format, vertices);
+            m_Cpu = CpuGeometry(std::move(vertices), std::move(indices), residency);
+        }
+        else
+        {
+            // the position stream is already a tight vec3 array
+            std::vector<glm::vec3> positions(packed.VertexCount);
+            std::memcpy(positions.data(), packed.Vertices, positions.size() * sizeof(glm::vec3));
+            m_Cpu = CpuGeometry(std::move(positions), std::move(indices));
+        }
+    }
+
+    GpuGeometry::GpuGeometry(const MeshStreams& streams, CpuResidency residency)
+        : m_FromStreams(true)
+        , m_BBoxMin(streams.BBoxMin)
+        , m_BBoxMax(streams.BBoxMax)
+    {
+        if (streams.VertexCount == 0 || !streams.Position.IsPresent())
+            return;
+
+        // the source ranges go back to back, each 4-byte aligned as attribute offsets require
+        std::vector<std::size_t> rangeOffsets;
+        rangeOffsets.reserve(streams.Ranges.size());
+        std::size_t size = 0;
+        for (const StreamRange& range : streams.Ranges)
+        {
+            size = (size + 3) & ~std::size_t(3);
+            rangeOffsets.push_back(size);
+            size += range.Size;
+        }
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(static_cast<unsigned int>(size));
+        for (std::size_t i = 0; i < streams.Ranges.size(); ++i)
+            m_VertexBuffer->SetData(static_cast<unsigned int>(rangeOffsets[i]), streams.Ranges[i].Data,
+                                    static_cast<unsigned int>(streams.Ranges[i].Size));
+
+        std::vector<std::uint16_t> shortIndices;
+        if (streams.IndexType == GL_UNSIGNED_INT
+            && MeshProcessing::NarrowIndices(static_cast<const unsigned int*>(streams.IndexData()), streams.IndexCount, streams.VertexCount, shortIndices))
+            m_IndexBuffer = std::make_unique<IndexBuffer>(shortIndices.data(), streams.IndexCount, GL_UNSIGNED_SHORT);
+        else if (streams.IndexCount > 0)
+            m_IndexBuffer = std::make_unique<IndexBuffer>(streams.IndexData(), streams.IndexCount, streams.IndexType);
+
+        // each stream has a stride and offset of its own, so it reads from a binding of its own
+        std::vector<VertexArray::BoundAttribute> attributes;
+        std::vector<VertexArray::BufferBinding>  bindings(3);
+        const unsigned int buffer = static_cast<unsigned int>(m_VertexBuffer->getRendererID());
+        auto addStream = [&](unsigned int location, const VertexStream& stream)
+        {
+            if (!stream.IsPresent())
+                return;
+            const VertexBufferElement element { static_cast<unsigned int>(stream.Components), stream.ComponentType, stream.Normalized };
+            attributes.push_back({ { location, element, 0 }, location });
+            bindings[location] = { buffer, rangeOffsets[stream.Range] + stream.Offset, static_cast<unsigned int>(stream.Stride) };
+        };
+        addStream(0, streams.Position);
+        addStream(1, streams.Normal);
+        addStream(2, streams.TexCoord);
+        CreateVertexArrays(std::move(attributes), bindings);
+
+        m_VertexCount = static_cast<unsigned int>(streams.VertexCount);
+        m_IndexCount  = streams.IndexCount;
+        if (m_IndexCount > 0)
+            m_Lods.push_back({ 0, m_IndexCount, 0.0f });
+
+        // the stream memory goes away after this call: gather positions and indices for picking
+        if (residency != CpuResidency::None && streams.Position.ComponentType == GL_FLOAT && streams.Position.Components == 3)
+        {
+            const unsigned char* source = streams.Ranges[streams.Position.Range].Data + streams.Position.Offset;
+            std::vector<glm::vec3> positions(streams.VertexCount);
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                std::memcpy(&positions[i], source + i * streams.Position.Stride, sizeof(glm::vec3));
+
+            std::vector<unsigned int> indices(streams.IndexCount);
+            for (std::size_t i = 0; i < indices.size(); ++i)
+                indices[i] = streams.IndexType == GL_UNSIGNED_SHORT ? static_cast<const std::uint16_t*>(streams.IndexData())[i]
+                                                                    : static_cast<const std::uint32_t*>(streams.IndexData())[i];
+            m_Cpu = CpuGeometry(std::move(positions), std::move(indices));
+        }
+    }
+
+    void GpuGeometry::CreateFormatVertexArrays()
+    {
+        // binding 0 reads the position stream, binding 1 the attribute stream (offsets are inside one element)
+        const unsigned int direction = m_Format.Quantized ? GL_SHORT : GL_FLOAT;
+        const unsigned int directionCount = m_Format.Quantized ? 2 : 3;
+        const unsigned int texCoord  = m_Format.HalfTexCoords ? GL_HALF_FLOAT : GL_FLOAT;
+        const unsigned int boneID    = m_Format.Quantized ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        const unsigned int weight    = m_Format.Quantized ? GL_UNSIGNED_SHORT : GL_FLOAT;
+        std::vector<VertexArray::BoundAttribute> attributes;
+        auto add = [&](unsigned int location, VertexBufferElement element, unsigned int offset)
+        {
+            attributes.push_back({ { location, element, offset }, 1 });
+        };
+        attributes.push_back({ { 0, { 3, GL_FLOAT, false }, 0 }, 0 });
+        add(1, { directionCount, direction, m_Format.Quantized }, m_Format.NormalOffset());
+        add(2, { 2, texCoord, false }, m_Format.TexCoordOffset());
+        if (m_Format.Tangents)
+        {
+            add(3, { directionCount, direction, m_Format.Quantized }, m_Format.TangentOffset());
+            add(4, { directionCount, direction, m_Format.Quantized }, m_Format.BitangentOffset());
+        }
+        if (m_Format.Skinned)
+        {
+            add(5, { 4, boneID, false, true }, m_Format.BoneIDOffset());   // read as uvec4, not converted to float
+            add(6, { 4, weight, m_Format.Quantized }, m_Format.WeightOffset());
+        }
+        const unsigned int buffer = static_cast<unsigned int>(m_VertexBuffer->getRendererID());
+        CreateVertexArrays(std::move(attributes), {
+            { buffer, 0, VertexFormat::kPositionStride },
+            { buffer, VertexPacker::AttributeOffset(m_VertexCount), m_Format.AttributeStride() },
+        });
+    }
+
+    void GpuGeometry::CreateVertexArrays(std::vector<VertexArray::BoundAttribute> attributes,
+                                         const std::vector<VertexArray::BufferBinding>& bindings)
+    {
+        m_VertexArray = VertexArray::ForAttributes(attributes, bindings);
+
+        // a mat4 takes four consecutive locations, one column each
+        for (unsigned int column = 0; column < 4; ++column)
+            attributes.push_back({ { kInstanceLocation + column, { 4, GL_FLOAT, false }, static_cast<unsigned int>(sizeof(glm::vec4)) * column },
+                                   kInstanceBinding, 1 });
+        m_InstancedVertexArray = VertexArray::ForAttributes(attributes, bindings);
+    }
+
+    std::size_t GpuGeometry::GetGpuBytes() const
+    {
+        std::size_t bytes = m_VertexBuffer ? m_VertexBuffer->GetSize() : 0;
+        if (m_IndexBuffer)
+            bytes += std::size_t(m_IndexBuffer->GetCount()) * m_IndexBuffer->GetIndexSize();
+        return bytes;
+    }
+
+    std::size_t GpuGeometry::GetCpuBytesFor(CpuResidency residency) const
+    {
+        if (m_FromStreams && residency == CpuResidency::Full)
+            residency = CpuResidency::Picking;
+        return CpuGeometry::BytesFor(residency, m_VertexCount, m_IndexCount);
+    }
+}
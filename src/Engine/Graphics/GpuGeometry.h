@@ -0,0 +1,147 @@
+/**
+ * @file GpuGeometry.h
+ * @brief Header file for the GpuGeometry class.
+ * The immutable, shared part of a mesh: its vertex and index buffers, uploaded once, and where
+ * each attribute sits in them. Meshes hold it through a shared_ptr, so copying a Mesh or a whole
+ * Model shares the buffers instead of uploading them again. What may differ between copies
+ * (transform, material, instance placements) stays on the Mesh. The vertex arrays are shared too:
+ * every geometry with the same vertex format draws through one GL vertex array (one more for
+ * instanced draws), set up once, which binding only points at this geometry's buffers.
+ * How much stays on the CPU is up to CpuResidency.
+ * Levels of detail follow the full triangle list in the same index buffer, as ranges of it.
+ */
+
+#pragma once
+
+#include "Utility/config.h"
+#include "Buffers/IndexBuffer.h"
+#include "Buffers/VertexArray.h"
+#include "Buffers/VertexBuffer.h"
+#include "Buffers/VertexBufferLayout.h"
+#include "Graphics/Vertex.h"
+#include "Graphics/VertexFormat.h"
+#include "Graphics/MeshStreams.h"
+#include "Graphics/MeshData.h"
+#include "Graphics/LodSelector.h"
+#include "Graphics/CpuGeometry.h"
+
+namespace isaacObjectViewer
+{
+    class GpuGeometry
+    {
+    public:
+        /// @brief Packs and uploads vertices in the given format, with 16-bit indices when they fit.
+        /// @param vertices The vertices.
+        /// @param indices The triangle list.
+        /// @param format The attributes and encodings to upload (see VertexPacker::SelectFormat).
+        /// @param residency What to keep of the vertices and indices after upload.
+        /// @param lods Coarser levels over the same vertices, appended to the index buffer; never kept on the CPU.
+        /// @param meshlets Clusters of the full triangle list, kept for culling.
+        GpuGeometry(std::vector<Vertex> vertices, std::vector<unsigned int> indices, const VertexFormat& format,
+                    CpuResidency residency = CpuResidency::Full, const std::vector<MeshLod>& lods = {},
+                    std::vector<Meshlet> meshlets = {});
+
+        /// @brief Uploads a mesh already in its upload layout, as it is.
+        /// @param packed The packed vertices, indices and levels; their memory only needs to live for this call.
+        /// @param format The format the vertices were packed in.
+        /// @param residency What to keep after upload; Full decodes the vertices again (VertexPacker::Unpack).
+        /// @param meshlets Clusters of the full triangle list, kept for culling.
+        GpuGeometry(const PackedGeometry& packed, const VertexFormat& format, CpuResidency residency = CpuResidency::Full,
+                    std::vector<Meshlet> meshlets = {});
+
+        /// @brief Uploads source streams as-is; only position, normal and UV are bound.
+        /// @param streams The vertex/index streams; their memory only needs to live for this call.
+        /// @param residency What to keep after upload. There are no full vertices, so Full keeps what Picking does.
+        explicit GpuGeometry(const MeshStreams& streams, CpuResidency residency = CpuResidency::Full);
+
+        GpuGeometry(const GpuGeometry&) = delete;
+        GpuGeometry& operator=(const GpuGeometry&) = delete;
+
+        /// @brief First attribute location of the per-instance model matrix (four locations, see main.vs).
+        static constexpr unsigned int kInstanceLocation = 8;
+
+        /// @brief Buffer binding of the per-instance model matrices, pointed at a buffer before each instanced draw.
+        static constexpr unsigned int kInstanceBinding = 3;
+
+        /// @brief Gets the vertex array that draws the geometry; the index buffer is bound per draw.
+        /// @param instanced True for the one that also reads a model matrix per instance from kInstanceBinding.
+        /// @return The vertex array, or nullptr for empty geometry.
+        const VertexArray* GetVertexArray(bool instanced = false) const
+        {
+            return instanced ? m_InstancedVertexArray.get() : m_VertexArray.get();
+        }
+
+        /// @brief Checks if there is anything to draw.
+        /// @return True if the vertex buffer was created.
+        bool IsValid() const { return m_VertexBuffer != nullptr; }
+
+        /// @brief Gets the vertex buffer.
+        /// @return The vertex buffer, or nullptr for empty geometry.
+        const VertexBuffer* GetVertexBuffer() const { return m_VertexBuffer.get(); }
+
+        /// @brief Gets the index buffer.
+        /// @return The index buffer, or nullptr when there are no indices.
+        const IndexBuffer*  GetIndexBuffer()  const { return m_IndexBuffer.get(); }
+
+        /// @brief Gets the vertex count.
+        unsigned int        GetVertexCount()  const { return m_VertexCount; }
+
+        /// @brief Gets the index count of the full mesh (level 0).
+        unsigned int        GetIndexCount()   const { return m_IndexCount; }
+
+        /// @brief Gets the levels of detail.
+        /// @return The levels, level 0 (the full mesh) first; empty when there are no indices.
+        const std::vector<LodRange>& GetLods() const { return m_Lods; }
+
+        /// @brief Gets the clusters of level 0, for ClusterCuller.
+        /// @return The meshlets; empty for meshes drawn whole.
+        const std::vector<Meshlet>&  GetMeshlets() const { return m_Meshlets; }
+
+        /// @brief Gets the format the vertices were uploaded in.
+        /// @return The format; geometry built from MeshStreams reports the default.
+        const VertexFormat& GetVertexFormat() const { return m_Format; }
+
+        /// @brief Gets the minimum corner of the bounding box.
+        const glm::vec3&    GetBBoxMin()      const { return m_BBoxMin; }
+
+        /// @brief Gets the maximum corner of the bounding box.
+        const glm::vec3&    GetBBoxMax()      const { return m_BBoxMax; }
+
+        /// @brief Gets the bytes of the vertex and index buffers.
+        std::size_t         GetGpuBytes()     const;
+
+        /// @brief Gets what is kept on the CPU.
+        const CpuGeometry&  GetCpu()          const { return m_Cpu; }
+
+        /// @brief Gets the CPU bytes a residency would keep of this geometry.
+        /// @param residency The residency.
+        /// @return The bytes; Full counts as Picking for geometry built from MeshStreams.
+        std::size_t         GetCpuBytesFor(CpuResidency residency) const;
+
+    private:
+        /// @brief Creates the vertex arrays that read m_Format from the vertex buffer, packed as VertexPacker::Pack writes it.
+        void CreateFormatVertexArrays();
+
+        /// @brief Creates the vertex arrays over the vertex buffer.
+        /// @param attributes The attributes, without the instance matrix.
+        /// @param bindings Where each binding reads from in the vertex buffer.
+        void CreateVertexArrays(std::vector<VertexArray::BoundAttribute> attributes,
+                                const std::vector<VertexArray::BufferBinding>& bindings);
+
+        CpuGeometry                   m_Cpu;
+
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        std::unique_ptr<IndexBuffer>  m_IndexBuffer;
+        std::unique_ptr<VertexArray>  m_VertexArray;
+        std::unique_ptr<VertexArray>  m_InstancedVertexArray;
+        std::vector<LodRange>         m_Lods;
+        std::vector<Meshlet>          m_Meshlets;
+
+        VertexFormat m_Format;
+        bool         m_FromStreams = false;
+        unsigned int m_VertexCount = 0;
+        unsigned int m_IndexCount  = 0;
+        glm::vec3    m_BBoxMin { 0.0f };
+        glm::vec3    m_BBoxMax { 0.0f };
+    };
+}
@@ -0,0 +1,275 @@
+#include "ImportPreview.h"
+#include "Graphics/ImportedScene.h"
+#include "Utility/MappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+namespace isaacObjectViewer
+{
+    static inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static inline bool parseFloat(const char*& p, const char* end, float& value)
+    {
+        while (p < end && isBlank(*p))
+            ++p;
+        if (p < end && *p == '+')
+            ++p;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc())
+            return false;
+        p = result.ptr;
+        return true;
+    }
+
+    // "<keyword> x y z" lines in evenly spaced windows of a text file; a window starts at the next full line
+    static void sampleTextLines(const char* data, std::size_t size, const char* keyword, std::vector<glm::vec3>& out)
+    {
+        const std::size_t len = std::strlen(keyword);
+        const bool whole = size <= ImportPreviewBuilder::kSampleWindows * ImportPreviewBuilder::kWindowSize;
+        const std::size_t windows   = whole ? 1 : ImportPreviewBuilder::kSampleWindows;
+        const std::size_t perWindow = ImportPreviewBuilder::kMaxSamples / windows;
+
+        for (std::size_t w = 0; w < windows; ++w)
+        {
+            const std::size_t begin = whole ? 0 : size / windows * w;
+            const char* p     = data + begin;
+            const char* stop  = whole ? data + size : data + std::min(size, begin + ImportPreviewBuilder::kWindowSize);
+            const char* end   = data + size;
+            if (begin > 0)
+            {
+                p = static_cast<const char*>(std::memchr(p, '\n', std::size_t(end - p)));
+                if (!p)
+                    break;
+                ++p;
+            }
+
+            std::size_t found = 0;
+            while (p < stop && found < perWindow)
+            {
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', std::size_t(end - p)));
+                if (!lineEnd)
+                    lineEnd = end;
+                while (p < lineEnd && isBlank(*p))
+                    ++p;
+                if (std::size_t(lineEnd - p) > len && std::memcmp(p, keyword, len) == 0 && isBlank(p[len]))
+                {
+                    const char* q = p + len;
+                    glm::vec3 v;
+                    if (parseFloat(q, lineEnd, v.x) && parseFloat(q, lineEnd, v.y) && parseFloat(q, lineEnd, v.z))
+                    {
+                        out.push_back(v);
+                        ++found;
+                    }
+                }
+                p = lineEnd + 1;
+            }
+        }
+    }
+
+    // binary STL: the corners of evenly spaced triangle records
+    static bool sampleBinaryStl(const unsigned char* data, std::size_t size, std::vector<glm::vec3>& out)
+    {
+        static constexpr std::size_t kHeaderSize = 84, kRecordSize = 50, kCornerStart = 12;
+        if (size < kHeaderSize)
+            return false;
+        std::uint32_t count;
+        std::memcpy(&count, data + 80, 4);
+        const std::size_t triangles = std::min<std::size_t>(count, (size - kHeaderSize) / kRecordSize);
+        const bool ascii = size >= 5 && std::memcmp(data, "solid", 5) == 0;
+        if (triangles == 0 || (ascii && kHeaderSize + triangles * kRecordSize != size))
+            return false;
+
+        const std::size_t samples = std::min(triangles, ImportPreviewBuilder::kMaxSamples / 3);
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            const unsigned char* record = data + kHeaderSize + (triangles / samples * i) * kRecordSize;
+            for (int c = 0; c < 3; ++c)
+            {
+                glm::vec3 v;
+                std::memcpy(&v, record + kCornerStart + c * sizeof(glm::vec3), sizeof(glm::vec3));
+                out.push_back(v);
+            }
+        }
+        return true;
+    }
+
+    bool ImportPreviewBuilder::SampleSource(const std::string& path, std::vector<glm::vec3>& outPoints)
+    {
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        if (ext != ".obj" && ext != ".stl")
+            return false;
+
+        MappedFile file;
+        if (!file.Open(path) || file.Size() == 0)
+            return false;
+
+        const std::size_t before = outPoints.size();
+        const char* text = reinterpret_cast<const char*>(file.Data());
+        if (ext == ".obj")
+            sampleTextLines(text, file.Size(), "v", outPoints);
+        else if (!sampleBinaryStl(file.Data(), file.Size(), outPoints))
+            sampleTextLines(text, file.Size(), "vertex", outPoints);
+        return outPoints.size() > before;
+    }
+
+    void ImportPreviewBuilder::SampleScene(const ImportedScene& scene, std::vector<glm::vec3>& outPoints)
+    {
+        const std::size_t meshCount = scene.Meshes.size() + scene.StreamMeshes.size();
+        static const std::vector<glm::mat4> kOnce { glm::mat4(1.0f) };
+        const std::vector<std::vector<glm::mat4>> placements =
+            scene.Nodes.empty() ? std::vector<std::vector<glm::mat4>>() : CollectInstances(scene.Nodes, meshCount);
+        auto placementsOf = [&](std::size_t m) -> const std::vector<glm::mat4>& { return scene.Nodes.empty() ? kOnce : placements[m]; };
+        auto vertexCount  = [&](std::size_t m)
+        {
+            if (m >= scene.Meshes.size())
+                return scene.StreamMeshes[m - scene.Meshes.size()].VertexCount;
+            const MeshData& mesh = scene.Meshes[m];
+            return mesh.Packed.IsSet() ? mesh.Packed.VertexCount : mesh.Vertices.size();
+        };
+
+        std::size_t total = 0;
+        for (std::size_t m = 0; m < meshCount; ++m)
+            total += vertexCount(m) * placementsOf(m).size();
+        if (total == 0)
+            return;
+        const std::size_t stride = (total + kMaxSamples - 1) / kMaxSamples;
+
+        // one stride across every placed vertex, so big meshes and many copies get their share
+        std::size_t next = 0;
+        for (std::size_t m = 0; m < meshCount; ++m)
+        {
+            const std::size_t count = vertexCount(m);
+            const MeshStreams* streams = m < scene.Meshes.size() ? nullptr : &scene.StreamMeshes[m - scene.Meshes.size()];
+            const bool readable = !streams ||
+                                  (streams->Position.IsPresent() && streams->Position.Range < streams->Ranges.size() &&
+                                   streams->Position.ComponentType == GL_FLOAT && streams->Position.Components >= 3);
+            for (const glm::mat4& transform : placementsOf(m))
+            {
+                if (!readable)
+                {
+                    // packed positions: the corners of the stored bounds will do
+                    const glm::vec3 lo = streams->BBoxMin, hi = streams->BBoxMax;
+                    for (int corner = 0; corner < 8; ++corner)
+                    {
+                        const glm::vec3 p((corner & 1) ? hi.x : lo.x, (corner & 2) ? hi.y : lo.y, (corner & 4) ? hi.z : lo.z);
+                        outPoints.push_back(glm::vec3(transform * glm::vec4(p, 1.0f)));
+                    }
+                    continue;
+                }
+
+                std::size_t i = next;
+                for (; i < count; i += stride)
+                {
+                    glm::vec3 p;
+                    if (!streams && scene.Meshes[m].Packed.IsSet())
+                        std::memcpy(&p, scene.Meshes[m].Packed.Vertices + i * VertexFormat::kPositionStride, sizeof(glm::vec3));
+                    else if (!streams)
+                        p = scene.Meshes[m].Vertices[i].Position;
+                    else
+                    {
+                        const StreamRange& range = streams->Ranges[streams->Position.Range];
+                        const std::size_t offset = streams->Position.Offset + i * streams->Position.Stride;
+                        if (offset + sizeof(glm::vec3) > range.Size)
+                            break;
+                        std::memcpy(&p, range.Data + offset, sizeof(glm::vec3));
+                    }
+                    outPoints.push_back(glm::vec3(transform * glm::vec4(p, 1.0f)));
+                }
+                next = i >= count ? i - count : 0;
+            }
+        }
+    }
+
+    ImportPreview ImportPreviewBuilder::FromPoints(const std::vector<glm::vec3>& points, int resolution)
+    {
+        ImportPreview preview;
+        glm::vec3 lo( std::numeric_limits<float>::max());
+        glm::vec3 hi(-std::numeric_limits<float>::max());
+        for (const glm::vec3& p : points)
+        {
+            if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+                continue;
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        if (lo.x > hi.x || resolution < 1)
+            return preview;
+
+        // cubic cells, so the blocks don't stretch along the short sides
+        const glm::vec3 extent = hi - lo;
+        float cell = std::max({ extent.x, extent.y, extent.z }) / float(resolution);
+        if (!(cell > 0.0f))
+            cell = 1.0f;
+        glm::ivec3 dims;
+        for (int a = 0; a < 3; ++a)
+            dims[a] = std::clamp(int(std::ceil(extent[a] / cell)), 1, resolution);
+
+        std::vector<unsigned char> occupied(std::size_t(dims.x) * dims.y * dims.z, 0);
+        for (const glm::vec3& p : points)
+        {
+            if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+                continue;
+            const glm::ivec3 c = glm::clamp(glm::ivec3((p - lo) / cell), glm::ivec3(0), dims - 1);
+            occupied[(std::size_t(c.z) * dims.y + c.y) * dims.x + c.x] = 1;
+        }
+
+        for (int z = 0; z < dims.z; ++z)
+            for (int y = 0; y < dims.y; ++y)
+                for (int x = 0; x < dims.x; ++x)
+                {
+                    if (!occupied[(std::size_t(z) * dims.y + y) * dims.x + x])
+                        continue;
+                    const glm::vec3 cellMin = lo + glm::vec3(x, y, z) * cell;
+                    preview.Boxes.push_back({ cellMin, cellMin + cell });
+                }
+        return preview;
+    }
+
+    MeshData ImportPreviewBuilder::BuildMesh(const ImportPreview& preview)
+    {
+        MeshData mesh;
+        mesh.Name = "Preview";
+        mesh.Vertices.reserve(preview.Boxes.size() * 24);
+        mesh.Indices.reserve(preview.Boxes.size() * 36);
+
+        // per face: the axis it faces along and which side; u x v points out, so the quad winds counter-clockwise
+        static constexpr float kCorners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+        for (const PreviewBox& box : preview.Boxes)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                for (int side = 0; side < 2; ++side)
+                {
+                    int u = (axis + 1) % 3, v = (axis + 2) % 3;
+                    if (side == 0)
+                        std::swap(u, v);
+
+                    const unsigned int base = static_cast<unsigned int>(mesh.Vertices.size());
+                    for (const auto& corner : kCorners)
+                    {
+                        glm::vec3 t(0.0f);
+                        t[axis] = float(side);
+                        t[u]    = corner[0];
+                        t[v]    = corner[1];
+
+                        Vertex vertex{};
+                        vertex.Position     = glm::mix(box.Min, box.Max, t);
+                        vertex.Normal[axis] = side ? 1.0f : -1.0f;
+                        mesh.Vertices.push_back(vertex);
+                    }
+                    for (unsigned int index : { 0u, 1u, 2u, 0u, 2u, 3u })
+                        mesh.Indices.push_back(base + index);
+                }
+            }
+        }
+        return mesh;
+    }
+}
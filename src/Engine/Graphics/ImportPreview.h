@@ -0,0 +1,83 @@
+/**
+ * @file ImportPreview.h
+ * @brief A coarse stand-in for a model that is still importing.
+ * Large files take seconds to parse, decode and upload. Meanwhile the viewer draws a block
+ * proxy: the points of the model are binned into a voxel grid and every occupied cell
+ * becomes a box. The first proxy is sampled straight from the source file (OBJ and STL
+ * vertex records, read in a few evenly spaced windows) within milliseconds of opening it;
+ * a better one follows from the parsed scene, placed by its node tree. The finished
+ * Model replaces the proxy once its upload is done.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    struct ImportedScene;
+
+    /// @brief An axis-aligned box of the proxy, in model space.
+    struct PreviewBox
+    {
+        glm::vec3 Min { 0.0f };
+        glm::vec3 Max { 0.0f };
+    };
+
+    /// @brief The proxy of a model, as published by the importing thread.
+    struct ImportPreview
+    {
+        std::vector<PreviewBox> Boxes;
+        /// @brief Source is Z-up and the proxy needs the same rotation as the final Model.
+        bool                    ZUp { false };
+        /// @brief True when built from the parsed scene, false when sampled from the file.
+        bool                    FromScene { false };
+
+        /// @brief Checks if there is anything to draw.
+        /// @return True if the proxy has no boxes.
+        bool Empty() const { return Boxes.empty(); }
+    };
+
+    class ImportPreviewBuilder
+    {
+    public:
+        /// @brief Cells along the longest side of the model; the proxy has at most this cubed boxes.
+        static constexpr int         kGridResolution = 24;
+        /// @brief Points read from a source file or a scene, at most.
+        static constexpr std::size_t kMaxSamples     = std::size_t(1) << 16;
+        /// @brief Windows the source file is sampled in, and the bytes read per window.
+        static constexpr std::size_t kSampleWindows  = 256;
+        static constexpr std::size_t kWindowSize     = std::size_t(1) << 14;
+
+        /// @brief Reads a spread of vertex positions straight from a model file, without parsing it.
+        /// Handles OBJ ("v" records) and STL (binary triangles, ASCII "vertex" records).
+        /// @param path The path to the model file.
+        /// @param outPoints Receives the positions.
+        /// @return False if the format isn't supported or nothing was found.
+        static bool SampleSource(const std::string& path, std::vector<glm::vec3>& outPoints);
+
+        /// @brief Reads a spread of model-space vertex positions from an imported scene; meshes are
+        /// placed by the node tree, stream meshes with float positions are read from source memory.
+        /// @param scene The scene, geometry done.
+        /// @param outPoints Receives the positions.
+        static void SampleScene(const ImportedScene& scene, std::vector<glm::vec3>& outPoints);
+
+        /// @brief Bins points into a grid of cubic cells over their bounds; each occupied cell is a box.
+        /// @param points The positions.
+        /// @param resolution Cells along the longest side.
+        /// @return The proxy; empty if there are no points.
+        static ImportPreview FromPoints(const std::vector<glm::vec3>& points, int resolution = kGridResolution);
+
+        /// @brief Turns the boxes into a drawable mesh, 24 vertices and 36 indices per box.
+        /// @param preview The proxy.
+        /// @return The mesh, with face normals so the blocks shade.
+        static MeshData BuildMesh(const ImportPreview& preview);
+
+    private:
+        ImportPreviewBuilder() = delete;
+    };
+}
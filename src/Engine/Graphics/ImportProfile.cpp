@@ -0,0 +1,103 @@
+#include "ImportProfile.h"
+#include "Utility/config.h"
+#include "Utility/Json.h"
+#include "Utility/Log.hpp"
+#include "Utility/MemoryStats.h"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+namespace isaacObjectViewer
+{
+    ImportStageTiming& ImportProfile::Add(const std::string& name, double milliseconds, std::uint64_t bytes,
+                                          std::size_t items, int depth)
+    {
+        ImportStageTiming* stage = nullptr;
+        for (ImportStageTiming& existing : Stages)
+        {
+            if (existing.Depth == depth && existing.Name == name)
+            {
+                stage = &existing;
+                break;
+            }
+        }
+        if (!stage)
+        {
+            stage = &Stages.emplace_back();
+            stage->Name  = name;
+            stage->Depth = depth;
+        }
+        stage->Milliseconds += milliseconds;
+        stage->Bytes        += bytes;
+        stage->Items        += items;
+        stage->ResidentBytes = MemoryStats::GetResidentBytes();
+        return *stage;
+    }
+
+    std::string ImportProfile::ToJson() const
+    {
+        char number[64];
+        auto ms = [&](double value) { std::snprintf(number, sizeof(number), "%.3f", value); return std::string(number); };
+
+        std::string out = "{\n";
+        out += "  \"model\": "                + JsonQuote(Model) + ",\n";
+        out += "  \"path\": "                 + JsonQuote(Path) + ",\n";
+        out += "  \"loader\": "               + JsonQuote(Loader) + ",\n";
+        out += "  \"cacheHit\": "             + std::string(CacheHit ? "true" : "false") + ",\n";
+        out += "  \"importMs\": "             + ms(ImportMilliseconds) + ",\n";
+        out += "  \"uploadMs\": "             + ms(UploadMilliseconds) + ",\n";
+        out += "  \"residentBytesBefore\": "  + std::to_string(ResidentBytesBefore) + ",\n";
+        out += "  \"peakResidentBytes\": "    + std::to_string(PeakResidentBytes) + ",\n";
+        out += "  \"stages\": [";
+        for (std::size_t i = 0; i < Stages.size(); ++i)
+        {
+            const ImportStageTiming& stage = Stages[i];
+            out += i == 0 ? "\n" : ",\n";
+            out += "    { \"name\": " + JsonQuote(stage.Name)
+                 + ", \"depth\": "         + std::to_string(stage.Depth)
+                 + ", \"ms\": "            + ms(stage.Milliseconds)
+                 + ", \"bytes\": "         + std::to_string(stage.Bytes)
+                 + ", \"items\": "         + std::to_string(stage.Items)
+                 + ", \"residentBytes\": " + std::to_string(stage.ResidentBytes) + " }";
+        }
+        out += Stages.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return out;
+    }
+
+    bool ImportProfile::WriteJson(const std::string& path) const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << ToJson();
+        if (!file)
+        {
+            LOG_ERROR("Failed to write import profile: {}", path);
+            return false;
+        }
+        LOG_INFO("Import profile written to {}", path);
+        return true;
+    }
+
+    std::string ImportProfile::GetDirectory()
+    {
+        return GetProjectRootPath("profiles/imports");
+    }
+
+    std::string ImportProfile::MakeJsonPath(const std::string& modelName)
+    {
+        const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm local {};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+        return (std::filesystem::path(GetDirectory()) / (modelName + "-" + stamp + ".json")).string();
+    }
+}
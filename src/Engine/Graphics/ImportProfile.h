@@ -0,0 +1,80 @@
+/**
+ * @file ImportProfile.h
+ * @brief Per-stage timings, byte counts and memory of one model import.
+ * Filled in as the import runs (ModelManager::ImportScene on the worker, UploadStep on the
+ * GL thread), kept by the Model for the UI and optionally written out as JSON, so imports
+ * of different versions of an asset can be compared.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief Time and data of one import stage.
+    struct ImportStageTiming
+    {
+        std::string   Name;
+        /// @brief 0 for a stage, 1 for a step within the stage above it (Assimp post-processing steps).
+        int           Depth         { 0 };
+        double        Milliseconds  { 0.0 };
+        /// @brief Bytes the stage produced: geometry, decoded pixels, or data sent to the GPU.
+        std::uint64_t Bytes         { 0 };
+        /// @brief Meshes, images or materials handled, depending on the stage.
+        std::size_t   Items         { 0 };
+        /// @brief Process resident set size when the stage ended.
+        std::size_t   ResidentBytes { 0 };
+    };
+
+    /// @brief The profile of one model import.
+    struct ImportProfile
+    {
+        std::string Model;
+        std::string Path;
+        std::string Loader;
+        bool        CacheHit            { false };
+        /// @brief Wall time of the CPU half (parse, convert, decode), in milliseconds.
+        double      ImportMilliseconds  { 0.0 };
+        /// @brief GL work of the upload, summed over the frames it was spread across.
+        double      UploadMilliseconds  { 0.0 };
+        std::size_t ResidentBytesBefore { 0 };
+        /// @brief Peak resident set size of the process during the import. Process-wide: with
+        /// several imports running at once it covers all of them.
+        std::size_t PeakResidentBytes   { 0 };
+        std::vector<ImportStageTiming> Stages;
+
+        /// @brief Records a stage, or adds to it if a stage of that name and depth exists
+        /// (uploads run in several steps). Samples the resident set size.
+        /// @param name The stage name.
+        /// @param milliseconds Time spent in the stage.
+        /// @param bytes Bytes the stage produced.
+        /// @param items Meshes, images or materials handled.
+        /// @param depth 0 for a stage, 1 for a step within the previous stage.
+        /// @return The stage entry.
+        ImportStageTiming& Add(const std::string& name, double milliseconds, std::uint64_t bytes = 0,
+                               std::size_t items = 0, int depth = 0);
+
+        /// @brief Formats the profile as a JSON object.
+        /// @return The JSON text.
+        std::string ToJson() const;
+
+        /// @brief Writes the profile as JSON, creating the directory if needed.
+        /// @param path The file to write.
+        /// @return True if the file was written.
+        bool WriteJson(const std::string& path) const;
+
+        /// @brief Gets the directory import profiles are written to.
+        /// @return The profile directory.
+        static std::string GetDirectory();
+
+        /// @brief Gets a new file path for a profile of the given model, stamped with the current time
+        /// so successive imports are kept side by side.
+        /// @param modelName The model name.
+        /// @return The file path, inside GetDirectory().
+        static std::string MakeJsonPath(const std::string& modelName);
+    };
+}
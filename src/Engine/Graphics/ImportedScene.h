@@ -0,0 +1,215 @@
+/**
+ * @file ImportedScene.h
+ * @brief CPU-side results of a model import, plus the progress record shared with the UI.
+ * Everything here is plain data: it is filled on a worker thread by
+ * ModelManager::ImportScene and consumed on the GL thread by ModelManager::UploadStep.
+ */
+
+#pragma once
+
+#include "Graphics/ImportPreview.h"
+#include "Graphics/ImportProfile.h"
+#include "Graphics/MeshData.h"
+#include "Graphics/MeshStreams.h"
+#include "Graphics/SceneNode.h"
+#include "Graphics/TextureManager.h"
+#include "Utility/Hash.h"
+#include "Utility/MappedFile.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief The stages an import goes through, in order.
+    enum class ImportStage : int
+    {
+        Queued = 0,
+        Parsing,
+        Converting,
+        DecodingTextures,
+        Uploading,
+        Finished,
+        Failed,
+        Cancelled
+    };
+
+    /// @brief Gets a display name for an import stage.
+    /// @param stage The stage.
+    /// @return The display name of the stage.
+    inline const char* ImportStageName(ImportStage stage)
+    {
+        switch (stage)
+        {
+            case ImportStage::Queued:           return "Queued";
+            case ImportStage::Parsing:          return "Parsing";
+            case ImportStage::Converting:       return "Converting meshes";
+            case ImportStage::DecodingTextures: return "Decoding textures";
+            case ImportStage::Uploading:        return "Uploading";
+            case ImportStage::Finished:         return "Finished";
+            case ImportStage::Failed:           return "Failed";
+            case ImportStage::Cancelled:        return "Cancelled";
+        }
+        return "Unknown";
+    }
+
+    /// @brief Progress of one import, written by the importer and read by the UI.
+    struct ImportProgress
+    {
+        std::atomic<ImportStage> Stage           { ImportStage::Queued };
+        std::atomic<float>       Fraction        { 0.0f };  // progress within the current stage, 0..1
+        std::atomic<bool>        CancelRequested { false };
+
+        /// @brief Enters a new stage with zero progress.
+        /// @param stage The new stage.
+        void Enter(ImportStage stage)
+        {
+            Fraction.store(0.0f);
+            Stage.store(stage);
+        }
+
+        /// @brief Gets the progress across all stages, weighted by their typical cost.
+        /// @return The overall progress, 0..1.
+        float Overall() const
+        {
+            // start of each stage on the overall bar: parse, convert, decode, upload
+            static constexpr float kStageStart[] = { 0.0f, 0.0f, 0.35f, 0.55f, 0.8f, 1.0f };
+            const int stage = static_cast<int>(Stage.load());
+            if (stage >= static_cast<int>(ImportStage::Finished))
+                return 1.0f;
+            const float begin = kStageStart[stage];
+            const float end   = kStageStart[stage + 1];
+            return begin + (end - begin) * Fraction.load();
+        }
+
+        /// @brief Hands a proxy of the model to the GL thread, replacing one it hasn't taken yet.
+        /// @param preview The proxy.
+        void PublishPreview(ImportPreview preview)
+        {
+            auto published = std::make_unique<ImportPreview>(std::move(preview));
+            std::lock_guard<std::mutex> lock(m_PreviewMutex);
+            m_Preview = std::move(published);
+        }
+
+        /// @brief Takes the latest proxy published since the last call.
+        /// @return The proxy, or nullptr if there is no new one.
+        std::unique_ptr<ImportPreview> TakePreview()
+        {
+            std::lock_guard<std::mutex> lock(m_PreviewMutex);
+            return std::move(m_Preview);
+        }
+
+    private:
+        std::mutex                     m_PreviewMutex;
+        std::unique_ptr<ImportPreview> m_Preview;
+    };
+
+    /// @brief A texture referenced by a material, resolved to a full path.
+    struct TextureRef
+    {
+        std::string Path;
+        TextureType Type { TextureType::DIFFUSE };
+    };
+
+    /// @brief CPU-side description of an imported material.
+    struct MaterialData
+    {
+        /// @brief All textures bound to meshes using this material (diffuse, specular, normal, height).
+        std::vector<TextureRef> Textures;
+        /// @brief Diffuse map of the engine Material; empty means use DiffuseColor.
+        std::string             DiffuseMap;
+        /// @brief Specular map of the engine Material; empty means use SpecularColor.
+        std::string             SpecularMap;
+        glm::vec3               DiffuseColor  { 1.0f };
+        glm::vec3               SpecularColor { 0.0f };
+        float                   Shininess     { 32.0f };
+    };
+
+    /// @brief An image stored inside the model file, waiting to be decoded.
+    struct EmbeddedImage
+    {
+        /// @brief The key the texture is cached under; TextureRef::Path uses the same key.
+        std::string          Key;
+        /// @brief Compressed file bytes (PNG, JPEG, ...), or RGBA8 pixels when Width is set.
+        /// Points into ImportedScene::SourceFiles or SourceBuffers.
+        const unsigned char* Data   { nullptr };
+        std::size_t          Size   { 0 };
+        unsigned int         Width  { 0 };
+        unsigned int         Height { 0 };
+    };
+
+    /// @brief Gets the texture key of an embedded image. The key is a hash of the bytes, so an image
+    /// embedded several times, or in several models, is decoded and uploaded once.
+    /// @param data The image bytes.
+    /// @param size The number of bytes.
+    /// @param width The width of raw pixels, 0 for compressed bytes.
+    /// @return The key; the leading '*' keeps it apart from file paths.
+    inline std::string EmbeddedTextureKey(const unsigned char* data, std::size_t size, unsigned int width = 0)
+    {
+        char key[32];
+        std::snprintf(key, sizeof(key), "*embedded-%016llx", static_cast<unsigned long long>(HashBytes(data, size, width)));
+        return key;
+    }
+
+    /// @brief An image decoded during import, waiting for its GL upload.
+    struct DecodedTexture
+    {
+        std::string  Path;
+        TextureType  Type { TextureType::DIFFUSE };
+        DecodedImage Image;
+    };
+
+    /// @brief Everything an import produces before any GL object exists.
+    struct ImportedScene
+    {
+        std::string                 Name;
+        std::string                 Path;
+        /// @brief Source is Z-up (FBX/DAE) and needs rotating into Y-up.
+        bool                        ZUp { false };
+        std::vector<MeshData>       Meshes;
+        /// @brief Meshes uploaded straight from source memory (see MeshStreams).
+        std::vector<MeshStreams>    StreamMeshes;
+        /// @brief Transform tree placing the meshes (Meshes first, then StreamMeshes, by index).
+        /// Empty means every mesh is drawn once, untransformed.
+        std::vector<SceneNode>      Nodes;
+        std::vector<MaterialData>   Materials;
+        std::vector<DecodedTexture> Images;
+        /// @brief Images stored inside the model file, by key; decoded into Images when referenced.
+        std::vector<EmbeddedImage>  EmbeddedImages;
+        /// @brief Other files the import read, such as OBJ material libraries; a mesh cache entry is
+        /// only used while they are unchanged too.
+        std::vector<std::string>    Dependencies;
+        /// @brief Timings of the import so far; handed to the Model when the upload finishes.
+        ImportProfile               Profile;
+        /// @brief Hash of the source (its contents when the mesh cache hashed them, else its size and
+        /// modification time) and the import, which the model's impostor is cached under (see
+        /// Impostor); 0 when no impostor is wanted.
+        std::uint64_t               ImpostorKey { 0 };
+
+        /// @brief Mapped files (the source, or its mesh cache entry) and decoded buffers that StreamMeshes,
+        /// packed meshes and EmbeddedImages point into; released together with the scene once the upload is done.
+        std::vector<MappedFile>                 SourceFiles;
+        std::vector<std::vector<unsigned char>> SourceBuffers;
+
+        /// @brief Registers an image stored inside the model file, once per distinct content.
+        /// @param data The image bytes; must stay valid as long as the scene (see SourceBuffers).
+        /// @param size The number of bytes.
+        /// @param width The width of raw RGBA8 pixels, 0 for compressed bytes.
+        /// @param height The height of raw RGBA8 pixels.
+        /// @return The key TextureRef::Path should hold for this image.
+        std::string AddEmbeddedImage(const unsigned char* data, std::size_t size, unsigned int width = 0, unsigned int height = 0)
+        {
+            std::string key = EmbeddedTextureKey(data, size, width);
+            for (const EmbeddedImage& image : EmbeddedImages)
+            {
+                if (image.Key == key)
+                    return key;
+            }
+            EmbeddedImages.push_back({ key, data, size, width, height });
+            return key;
+        }
+    };
+}
@@ -0,0 +1,315 @@
+#include "Impostor.h"
+#include "ImpostorSelector.h"
+#include "Model.h"
+#include "Texture.h"
+#include "Renderer/Renderer.h"
+#include "Shader/Shader.h"
+#include "Utility/GLErrorManager.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+namespace isaacObjectViewer
+{
+    // mipmaps stop at 8 x 8 views, before a level averages neighbouring tiles together
+    static constexpr int kAtlasMaxLevel = 3;
+
+    Impostor::~Impostor() = default;
+
+    std::size_t Impostor::GetBytes() const
+    {
+        // two RGBA8 atlases, and a third more for the mipmaps
+        const std::size_t level0 = std::size_t(m_AtlasSize) * std::size_t(m_AtlasSize) * 4;
+        return 2 * (level0 + level0 / 3);
+    }
+
+    void Impostor::Upload(const ImpostorBake& bake)
+    {
+        m_Center    = bake.Center;
+        m_Radius    = bake.Radius;
+        m_AtlasSize = bake.FramesPerSide * bake.FrameSize;
+
+        m_Albedo = std::make_unique<Texture>();
+        m_Albedo->Generate(m_AtlasSize, m_AtlasSize, const_cast<unsigned char*>(bake.Albedo.data()), GL_RGBA8, GL_RGBA, TextureType::DIFFUSE);
+        m_Normal = std::make_unique<Texture>();
+        m_Normal->Generate(m_AtlasSize, m_AtlasSize, const_cast<unsigned char*>(bake.Normal.data()), GL_RGBA8, GL_RGBA, TextureType::NORMAL);
+        FinishAtlas(*m_Albedo);
+        FinishAtlas(*m_Normal);
+    }
+
+    bool Impostor::Allocate(const Model& model)
+    {
+        glm::vec3 lo, hi;
+        if (!model.GetLocalBounds(lo, hi))
+            return false;
+        m_Center    = 0.5f * (lo + hi);
+        m_Radius    = std::max(0.5f * glm::length(hi - lo), 1e-4f);
+        m_AtlasSize = ImpostorSelector::kFramesPerSide * ImpostorSelector::kFrameSize;
+
+        m_Albedo = std::make_unique<Texture>();
+        m_Albedo->Generate(m_AtlasSize, m_AtlasSize, nullptr, GL_RGBA8, GL_RGBA, TextureType::DIFFUSE);
+        m_Normal = std::make_unique<Texture>();
+        m_Normal->Generate(m_AtlasSize, m_AtlasSize, nullptr, GL_RGBA8, GL_RGBA, TextureType::NORMAL);
+        return true;
+    }
+
+    void Impostor::FinishAtlas(const Texture& atlas) const
+    {
+        const GLuint id = atlas.GetID();
+        GLCall(glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+        GLCall(glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GLCall(glTextureParameteri(id, GL_TEXTURE_MAX_LEVEL, kAtlasMaxLevel));
+        GLCall(glGenerateTextureMipmap(id));
+    }
+
+    void Impostor::Draw(const glm::mat4& model, const glm::vec3& camera, const glm::mat4& view,
+                        const glm::mat4& projection, Shader& shader) const
+    {
+        if (s_QuadVertexArray == 0)
+            glGenVertexArrays(1, &s_QuadVertexArray);
+
+        const glm::mat3 linear(model);
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+        const float scale = std::max({ glm::length(linear[0]), glm::length(linear[1]), glm::length(linear[2]) });
+        const glm::vec3 center(model * glm::vec4(m_Center, 1.0f));
+
+        // the views around the camera's direction, in the model's space
+        glm::vec3 toCamera = glm::vec3(glm::inverse(model) * glm::vec4(camera, 1.0f)) - m_Center;
+        toCamera = glm::length(toCamera) > 0.0f ? glm::normalize(toCamera) : glm::vec3(0.0f, 0.0f, 1.0f);
+        const ImpostorViews views = ImpostorSelector::SelectViews(toCamera);
+
+        shader.Bind();
+        shader.setMat4("view", view);
+        shader.setMat4("projection", projection);
+        shader.setVec3("center", center);
+        shader.setFloat("halfSize", m_Radius * scale);
+        shader.setMat3("normalMatrix", normalMatrix);
+        shader.setInt("framesPerSide", ImpostorSelector::kFramesPerSide);
+        for (int i = 0; i < 4; ++i)
+        {
+            glm::vec3 right, up;
+            ImpostorSelector::FrameBasis(ImpostorSelector::FrameDirection(views.Tiles[i]), right, up);
+            // a world offset from the center maps to the view's [-0.5, 0.5] square through the model's space
+            const std::string index = "[" + std::to_string(i) + "]";
+            shader.setVec3("frameRight" + index, normalMatrix * right / (2.0f * m_Radius));
+            shader.setVec3("frameUp" + index, normalMatrix * up / (2.0f * m_Radius));
+            shader.setVec2("frameTile" + index, glm::vec2(views.Tiles[i]));
+            shader.setFloat("frameWeight" + index, views.Weights[i]);
+        }
+
+        glActiveTexture(GL_TEXTURE0);
+        m_Albedo->Bind();
+        shader.setInt("atlasAlbedo", 0);
+        glActiveTexture(GL_TEXTURE1);
+        m_Normal->Bind();
+        shader.setInt("atlasNormal", 1);
+
+        glBindVertexArray(s_QuadVertexArray);
+        GLCall(glDrawArrays(GL_TRIANGLES, 0, 6));
+        glBindVertexArray(0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    // --- ImpostorBakeJob -----------------------------------------------------
+
+    ImpostorBakeJob::ImpostorBakeJob(const std::string& name, std::uint64_t contentHash)
+        : m_Name(name), m_Key{ contentHash, ENGINE_VERSION }, m_CachePath(ImpostorCache::GetCachePath(name, m_Key))
+    {
+    }
+
+    ImpostorBakeJob::~ImpostorBakeJob()
+    {
+        Release();
+    }
+
+    void ImpostorBakeJob::Step(Model& model, const Renderer& renderer, Shader& bakeShader, float budgetMs)
+    {
+        Timer timer;
+        timer.Start();
+
+        if (m_Phase == Phase::Start)
+        {
+            if (ImpostorCache::IsEnabled())
+            {
+                const ImpostorBake cached = ImpostorCache::Read(m_CachePath, m_Key);
+                if (cached.IsValid() && cached.FramesPerSide == ImpostorSelector::kFramesPerSide
+                    && cached.FrameSize == ImpostorSelector::kFrameSize)
+                {
+                    auto impostor = std::shared_ptr<Impostor>(new Impostor());
+                    impostor->Upload(cached);
+                    m_Result = std::move(impostor);
+                    m_Milliseconds += timer.Stop() * 1000.0;
+                    Finish(true);
+                    return;
+                }
+            }
+
+            m_Impostor.reset(new Impostor());
+            if (!m_Impostor->Allocate(model) || !BeginViews(model))
+            {
+                m_Impostor.reset();
+                Release();
+                m_Phase = Phase::Done;
+                return;
+            }
+            m_Phase = Phase::Views;
+        }
+
+        if (m_Phase == Phase::Views)
+        {
+            // blending would mix coverage into the colours; Engine::Render sets the viewport back
+            const bool blend = glIsEnabled(GL_BLEND);
+            glDisable(GL_BLEND);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+            bakeShader.Bind();
+            bakeShader.setBool("impostorBake", true);
+
+            const int frames       = ImpostorSelector::kFramesPerSide;
+            const int size         = ImpostorSelector::kFrameSize;
+            const glm::vec3 center = m_Impostor->m_Center;
+            const float radius     = m_Impostor->m_Radius;
+            const glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, 0.5f * radius, 3.5f * radius);
+            do
+            {
+                const int row = m_NextView / frames, column = m_NextView % frames;
+                const glm::vec3 direction = ImpostorSelector::FrameDirection(glm::ivec2(column, row));
+                glm::vec3 right, up;
+                ImpostorSelector::FrameBasis(direction, right, up);
+                const glm::vec3 eye = center + direction * (2.0f * radius);
+
+                glViewport(column * size, row * size, size, size);
+                bakeShader.setVec3("viewPos", eye);
+                model.RenderForBake(renderer, glm::lookAt(eye, center, up), projection, &bakeShader);
+                ++m_NextView;
+            } while (m_NextView < frames * frames && timer.Peek() * 1000.0f < budgetMs);
+
+            bakeShader.Bind();
+            bakeShader.setBool("impostorBake", false);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            if (blend)
+                glEnable(GL_BLEND);
+
+            if (m_NextView == frames * frames)
+            {
+                // drawable from here on; the pixels only matter for the cache
+                m_Impostor->FinishAtlas(*m_Impostor->m_Albedo);
+                m_Impostor->FinishAtlas(*m_Impostor->m_Normal);
+                m_Result = m_Impostor;
+                if (ImpostorCache::IsEnabled())
+                {
+                    BeginReadback();
+                    m_Phase = Phase::Readback;
+                }
+                else
+                {
+                    m_Milliseconds += timer.Stop() * 1000.0;
+                    Finish(false);
+                    return;
+                }
+            }
+            m_Milliseconds += timer.Stop() * 1000.0;
+            return;
+        }
+
+        if (m_Phase == Phase::Readback)
+        {
+            const GLenum status = glClientWaitSync(static_cast<GLsync>(m_Fence), 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+                return;
+
+            ImpostorBake bake;
+            bake.FramesPerSide = ImpostorSelector::kFramesPerSide;
+            bake.FrameSize     = ImpostorSelector::kFrameSize;
+            bake.Center        = m_Impostor->m_Center;
+            bake.Radius        = m_Impostor->m_Radius;
+            if (status != GL_WAIT_FAILED)
+            {
+                bake.Albedo.resize(bake.AtlasBytes());
+                bake.Normal.resize(bake.AtlasBytes());
+                GLCall(glGetNamedBufferSubData(m_PixelBuffer, 0, static_cast<GLsizeiptr>(bake.AtlasBytes()), bake.Albedo.data()));
+                GLCall(glGetNamedBufferSubData(m_PixelBuffer, static_cast<GLintptr>(bake.AtlasBytes()),
+                                               static_cast<GLsizeiptr>(bake.AtlasBytes()), bake.Normal.data()));
+                ImpostorCache::Write(m_CachePath, bake, m_Key);
+            }
+            m_Milliseconds += timer.Stop() * 1000.0;
+            Finish(false);
+        }
+    }
+
+    bool ImpostorBakeJob::BeginViews(const Model& model)
+    {
+        const int atlasSize = m_Impostor->m_AtlasSize;
+        GLCall(glCreateFramebuffers(1, &m_Framebuffer));
+        GLCall(glCreateRenderbuffers(1, &m_Depth));
+        GLCall(glNamedRenderbufferStorage(m_Depth, GL_DEPTH_COMPONENT24, atlasSize, atlasSize));
+        GLCall(glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT0, m_Impostor->m_Albedo->GetID(), 0));
+        GLCall(glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT1, m_Impostor->m_Normal->GetID(), 0));
+        GLCall(glNamedFramebufferRenderbuffer(m_Framebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_Depth));
+        const GLenum buffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        GLCall(glNamedFramebufferDrawBuffers(m_Framebuffer, 2, buffers));
+
+        if (glCheckNamedFramebufferStatus(m_Framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_ERROR("{}: impostor framebuffer is incomplete", model.GetName());
+            return false;
+        }
+
+        // zero everywhere nothing is drawn: impostor.fs divides both atlases by coverage
+        const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        const float clearDepth    = 1.0f;
+        GLCall(glClearNamedFramebufferfv(m_Framebuffer, GL_COLOR, 0, clearColor));
+        GLCall(glClearNamedFramebufferfv(m_Framebuffer, GL_COLOR, 1, clearColor));
+        GLCall(glClearNamedFramebufferfv(m_Framebuffer, GL_DEPTH, 0, &clearDepth));
+        return true;
+    }
+
+    void ImpostorBakeJob::BeginReadback()
+    {
+        // the views are done with the framebuffer; the copies land in the buffer while later frames render
+        glDeleteFramebuffers(1, &m_Framebuffer);
+        glDeleteRenderbuffers(1, &m_Depth);
+        m_Framebuffer = m_Depth = 0;
+
+        const std::size_t atlasBytes = std::size_t(m_Impostor->m_AtlasSize) * std::size_t(m_Impostor->m_AtlasSize) * 4;
+        GLCall(glCreateBuffers(1, &m_PixelBuffer));
+        GLCall(glNamedBufferStorage(m_PixelBuffer, static_cast<GLsizeiptr>(2 * atlasBytes), nullptr, 0));
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_PixelBuffer);
+        GLCall(glGetTextureImage(m_Impostor->m_Albedo->GetID(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                                 static_cast<GLsizei>(atlasBytes), nullptr));
+        GLCall(glGetTextureImage(m_Impostor->m_Normal->GetID(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                                 static_cast<GLsizei>(atlasBytes), reinterpret_cast<void*>(atlasBytes)));
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush(); // Step polls the fence without flushing
+    }
+
+    void ImpostorBakeJob::Release()
+    {
+        if (m_Framebuffer)
+            glDeleteFramebuffers(1, &m_Framebuffer);
+        if (m_Depth)
+            glDeleteRenderbuffers(1, &m_Depth);
+        if (m_PixelBuffer)
+            glDeleteBuffers(1, &m_PixelBuffer);
+        if (m_Fence)
+            glDeleteSync(static_cast<GLsync>(m_Fence));
+        m_Framebuffer = m_Depth = m_PixelBuffer = 0;
+        m_Fence = nullptr;
+    }
+
+    void ImpostorBakeJob::Finish(bool cached)
+    {
+        Release();
+        m_Impostor.reset();
+        m_Phase = Phase::Done;
+        ImpostorSelector::RecordBake(cached, m_Milliseconds);
+        if (cached)
+            LOG_INFO("{}: impostor read from cache in {:.1f} ms", m_Name, m_Milliseconds);
+        else
+            LOG_INFO("{}: impostor baked, {} views of {}x{} px in {:.1f} ms on the GL thread", m_Name,
+                     m_NextView, ImpostorSelector::kFrameSize, ImpostorSelector::kFrameSize, m_Milliseconds);
+    }
+}
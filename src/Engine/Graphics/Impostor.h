@@ -0,0 +1,147 @@
+/**
+ * @file Impostor.h
+ * @brief Header file for the Impostor class.
+ * An impostor stands in for a whole Model once it is only a few pixels tall (see
+ * ImpostorSelector): one quad facing the camera, textured from two atlases of views baked
+ * around the model. The albedo atlas holds colour and coverage, the normal atlas model-space
+ * normals and specular strength, so impostor.fs lights the quad with the scene's lights like
+ * main.fs lights meshes, and moving a light does not need a new bake.
+ *
+ * Bakes render the model with main.fs (impostorBake) into an offscreen framebuffer after the
+ * model is loaded, one orthographic view per atlas tile. An ImpostorBakeJob renders a few views
+ * per frame inside the import upload budget, then reads the atlases back through a pixel buffer
+ * and a fence so the GL thread never waits on the GPU, and writes them to the impostor cache so
+ * the next load only uploads them. Duplicated models share their impostor.
+ */
+
+#pragma once
+
+#include "Graphics/ImpostorCache.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class Model;
+    class Renderer;
+    class Shader;
+    class Texture;
+
+    class Impostor
+    {
+    public:
+        ~Impostor();
+
+        Impostor(const Impostor&) = delete;
+        Impostor& operator=(const Impostor&) = delete;
+
+        /// @brief Draws the impostor of one placed model.
+        /// @param model The model matrix.
+        /// @param camera The camera position, in world space.
+        /// @param view The view matrix.
+        /// @param projection The projection matrix.
+        /// @param shader The impostor shader, with the scene's lights set.
+        void Draw(const glm::mat4& model, const glm::vec3& camera, const glm::mat4& view,
+                  const glm::mat4& projection, Shader& shader) const;
+
+        /// @brief Gets the center of the sphere the views were framed on, in the model's space.
+        const glm::vec3& GetCenter() const { return m_Center; }
+
+        /// @brief Gets the radius of the sphere the views were framed on, in the model's units.
+        float GetRadius() const { return m_Radius; }
+
+        /// @brief Gets the width and height of each atlas, in pixels.
+        int GetAtlasSize() const { return m_AtlasSize; }
+
+        /// @brief Gets the GPU memory of both atlases, mipmaps included.
+        std::size_t GetBytes() const;
+
+    private:
+        Impostor() = default;
+
+        friend class ImpostorBakeJob;
+
+        /// @brief Creates both atlases from cached pixels.
+        void Upload(const ImpostorBake& bake);
+
+        /// @brief Frames the views on the model's bounds and creates both (empty) atlases.
+        /// @return False if the model has no bounds.
+        bool Allocate(const Model& model);
+
+        /// @brief Builds the mipmaps and sampling state of a filled atlas.
+        void FinishAtlas(const Texture& atlas) const;
+
+        std::unique_ptr<Texture> m_Albedo;
+        std::unique_ptr<Texture> m_Normal;
+        glm::vec3                m_Center    { 0.0f };
+        float                    m_Radius    { 0.0f };
+        int                      m_AtlasSize { 0 };
+
+        /// @brief Empty vertex array: impostor.vs places the quad's corners from gl_VertexID.
+        static inline unsigned int s_QuadVertexArray = 0;
+    };
+
+    /// @brief Gets one model's impostor over several frames: from the impostor cache when it has a
+    /// current entry, otherwise by baking a few views per Step. Shared by a model and its duplicates,
+    /// which draw the same geometry. GL thread only.
+    class ImpostorBakeJob
+    {
+    public:
+        /// @param name The model's name, which the cache file is named after.
+        /// @param contentHash Identifies the model's geometry and materials (ImportedScene::ImpostorKey).
+        ImpostorBakeJob(const std::string& name, std::uint64_t contentHash);
+        ~ImpostorBakeJob();
+
+        ImpostorBakeJob(const ImpostorBakeJob&) = delete;
+        ImpostorBakeJob& operator=(const ImpostorBakeJob&) = delete;
+
+        /// @brief Does the next part of the work: the cache lookup, then views until the budget is
+        /// spent (at least one per call), then the readback and cache write once the GPU is done.
+        /// @param model A model with the job's geometry, its meshes uploaded.
+        /// @param renderer The renderer to bake with.
+        /// @param bakeShader The main shader; its impostorBake output is used.
+        /// @param budgetMs Time this call may take.
+        void Step(Model& model, const Renderer& renderer, Shader& bakeShader, float budgetMs);
+
+        /// @brief Checks if the job is finished: the impostor is ready, or there is none.
+        bool IsDone() const { return m_Phase == Phase::Done; }
+
+        /// @brief Gets the impostor; set once every view is rendered, before the cache write.
+        /// @return The impostor, or nullptr while baking or if the model has nothing to draw.
+        const std::shared_ptr<const Impostor>& GetImpostor() const { return m_Result; }
+
+    private:
+        enum class Phase { Start, Views, Readback, Done };
+
+        /// @brief Creates the framebuffer over both atlases and clears it.
+        bool BeginViews(const Model& model);
+
+        /// @brief Starts copying both atlases into the pixel buffer, fenced.
+        void BeginReadback();
+
+        /// @brief Deletes the framebuffer, pixel buffer and fence.
+        void Release();
+
+        /// @brief Records the finished bake and moves to Done.
+        void Finish(bool cached);
+
+        std::string                     m_Name;
+        ImpostorCacheKey                m_Key;
+        std::string                     m_CachePath;
+        Phase                           m_Phase        { Phase::Start };
+        /// @brief The impostor being baked; m_Result once every view is rendered.
+        std::shared_ptr<Impostor>       m_Impostor;
+        std::shared_ptr<const Impostor> m_Result;
+        int                             m_NextView     { 0 };
+        /// @brief GL thread time spent so far, over all steps.
+        double                          m_Milliseconds { 0.0 };
+
+        unsigned int                    m_Framebuffer  { 0 };
+        unsigned int                    m_Depth        { 0 };
+        unsigned int                    m_PixelBuffer  { 0 };
+        /// @brief GLsync of the readback.
+        void*                           m_Fence        { nullptr };
+    };
+}
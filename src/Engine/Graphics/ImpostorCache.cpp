@@ -0,0 +1,133 @@
+#include "ImpostorCache.h"
+#include "Utility/config.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+namespace isaacObjectViewer
+{
+    // --- file layout ---------------------------------------------------------
+    //
+    //  FileHeader, then the albedo atlas, then the normal atlas, AtlasBytes() each, bottom row first
+
+    static constexpr char          kMagic[4]      = { 'I', 'O', 'V', 'I' };
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    struct FileHeader
+    {
+        char          Magic[4];
+        std::uint32_t FormatVersion;
+        std::uint32_t EngineVersion;
+        std::uint32_t FramesPerSide;
+        std::uint64_t ContentHash;
+        std::uint32_t FrameSize;
+        float         Center[3];
+        float         Radius;
+        std::uint32_t Reserved;
+        std::uint64_t FileSize;
+    };
+    static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+    std::string ImpostorCache::GetCacheDirectory()
+    {
+        return GetProjectRootPath("cache/impostors");
+    }
+
+    std::string ImpostorCache::GetCachePath(const std::string& modelName, const ImpostorCacheKey& key)
+    {
+        // readable stem + the content hash, which is what identifies the bake
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key.ContentHash));
+        return (std::filesystem::path(GetCacheDirectory()) / (modelName + "-" + hex + ".iovimp")).string();
+    }
+
+    ImpostorBake ImpostorCache::Read(const std::string& cachePath, const ImpostorCacheKey& key)
+    {
+        ImpostorBake bake;
+        MappedFile file(cachePath);
+        if (!file.IsOpen() || file.Size() < sizeof(FileHeader))
+            return bake;
+
+        FileHeader header;
+        std::memcpy(&header, file.Data(), sizeof(FileHeader));
+        if (std::memcmp(header.Magic, kMagic, sizeof(kMagic)) != 0
+            || header.FormatVersion != kFormatVersion
+            || header.EngineVersion != key.EngineVersion
+            || header.ContentHash   != key.ContentHash
+            || header.FileSize      != file.Size()
+            || header.FramesPerSide == 0 || header.FramesPerSide > 64
+            || header.FrameSize     == 0 || header.FrameSize > 1024)
+            return bake;
+
+        bake.FramesPerSide = static_cast<int>(header.FramesPerSide);
+        bake.FrameSize     = static_cast<int>(header.FrameSize);
+        const std::size_t atlasBytes = bake.AtlasBytes();
+        if (sizeof(FileHeader) + 2 * atlasBytes != file.Size())
+            return ImpostorBake{};
+
+        bake.Center = glm::vec3(header.Center[0], header.Center[1], header.Center[2]);
+        bake.Radius = header.Radius;
+        const unsigned char* pixels = file.Data() + sizeof(FileHeader);
+        bake.Albedo.assign(pixels, pixels + atlasBytes);
+        bake.Normal.assign(pixels + atlasBytes, pixels + 2 * atlasBytes);
+        return bake;
+    }
+
+    bool ImpostorCache::Write(const std::string& cachePath, const ImpostorBake& bake, const ImpostorCacheKey& key)
+    {
+        if (!bake.IsValid())
+            return false;
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+        FileHeader header{};
+        std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+        header.FormatVersion = kFormatVersion;
+        header.EngineVersion = key.EngineVersion;
+        header.FramesPerSide = static_cast<std::uint32_t>(bake.FramesPerSide);
+        header.ContentHash   = key.ContentHash;
+        header.FrameSize     = static_cast<std::uint32_t>(bake.FrameSize);
+        header.Center[0]     = bake.Center.x;
+        header.Center[1]     = bake.Center.y;
+        header.Center[2]     = bake.Center.z;
+        header.Radius        = bake.Radius;
+        header.FileSize      = sizeof(FileHeader) + 2 * bake.AtlasBytes();
+
+        // write next to the target and rename, so readers never see a half-written file
+        const std::string tmpPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_ERROR("Failed to create impostor cache file: {}", tmpPath);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(bake.Albedo.data()), static_cast<std::streamsize>(bake.Albedo.size()));
+            file.write(reinterpret_cast<const char*>(bake.Normal.data()), static_cast<std::streamsize>(bake.Normal.size()));
+            if (!file)
+            {
+                LOG_ERROR("Failed to write impostor cache file: {}", tmpPath);
+                file.close();
+                std::filesystem::remove(tmpPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmpPath, cachePath, ec);
+        if (ec)
+        {
+            LOG_ERROR("Failed to replace impostor cache file {}: {}", cachePath, ec.message());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+        return true;
+    }
+}
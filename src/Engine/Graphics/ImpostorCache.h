@@ -0,0 +1,94 @@
+/**
+ * @file ImpostorCache.h
+ * @brief On-disk cache of baked impostor atlases.
+ * Baking renders every view of a model, so the result is kept: a cache entry holds both atlases
+ * of an Impostor as raw RGBA8 pixels plus the bounding sphere they were framed on. Entries are
+ * keyed by ImportedScene::ImpostorKey (the source and the import, like the mesh cache) and
+ * ENGINE_VERSION; a stale entry is ignored and the model is baked again.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief Identifies the model and engine a bake was made with.
+    struct ImpostorCacheKey
+    {
+        std::uint64_t ContentHash   { 0 };
+        std::uint32_t EngineVersion { 0 };
+    };
+
+    /// @brief The pixels of a bake, as the GL thread reads them back.
+    struct ImpostorBake
+    {
+        int FramesPerSide { 0 };
+        /// @brief Size of one view, in pixels; the atlases are FramesPerSide * FrameSize square.
+        int FrameSize     { 0 };
+        /// @brief The bounding sphere the views were framed on, in the model's space.
+        glm::vec3 Center  { 0.0f };
+        float     Radius  { 0.0f };
+        /// @brief Albedo and coverage, RGBA8.
+        std::vector<unsigned char> Albedo;
+        /// @brief Model-space normal (xyz * 0.5 + 0.5) and specular strength, RGBA8.
+        std::vector<unsigned char> Normal;
+
+        /// @brief Gets the bytes of one atlas.
+        std::size_t AtlasBytes() const
+        {
+            const std::size_t side = std::size_t(FramesPerSide) * std::size_t(FrameSize);
+            return side * side * 4;
+        }
+
+        /// @brief Checks if the bake holds both atlases.
+        bool IsValid() const
+        {
+            return FramesPerSide > 0 && FrameSize > 0 && Radius > 0.0f
+                && Albedo.size() == AtlasBytes() && Normal.size() == AtlasBytes();
+        }
+    };
+
+    class ImpostorCache
+    {
+    public:
+        /// @brief Enables or disables the cache for subsequent bakes.
+        /// @param enabled True to read and write cache files.
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+
+        /// @brief Checks if the cache is enabled.
+        /// @return True if bakes read and write cache files.
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// @brief Gets the directory cache files are written to.
+        /// @return The cache directory.
+        static std::string GetCacheDirectory();
+
+        /// @brief Gets the cache file of a bake.
+        /// @param modelName The model name, for a readable file name.
+        /// @param key The key of the bake.
+        /// @return The cache file path (one file per content hash).
+        static std::string GetCachePath(const std::string& modelName, const ImpostorCacheKey& key);
+
+        /// @brief Loads a cache file if it matches the key.
+        /// @param cachePath The cache file.
+        /// @param key The key the entry must have been written with.
+        /// @return The bake; IsValid() is false on a miss or stale entry.
+        static ImpostorBake Read(const std::string& cachePath, const ImpostorCacheKey& key);
+
+        /// @brief Writes a cache file, replacing any previous entry atomically.
+        /// @param cachePath The cache file.
+        /// @param bake The bake.
+        /// @param key The key of the bake.
+        /// @return True if the file was written.
+        static bool Write(const std::string& cachePath, const ImpostorBake& bake, const ImpostorCacheKey& key);
+
+    private:
+        ImpostorCache() = delete;
+
+        static inline bool s_Enabled = true;
+    };
+}
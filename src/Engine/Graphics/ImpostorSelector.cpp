@@ -0,0 +1,101 @@
+#include "ImpostorSelector.h"
+#include "LodSelector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace isaacObjectViewer
+{
+    glm::vec2 ImpostorSelector::OctEncode(const glm::vec3& direction)
+    {
+        const float l1 = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (l1 <= 0.0f)
+            return glm::vec2(0.0f);
+        glm::vec2 e = glm::vec2(direction) / l1;
+        // the lower half folds out over the corners
+        if (direction.z < 0.0f)
+            e = glm::vec2((1.0f - std::abs(e.y)) * (e.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(e.x)) * (e.y >= 0.0f ? 1.0f : -1.0f));
+        return e;
+    }
+
+    glm::vec3 ImpostorSelector::OctDecode(const glm::vec2& encoded)
+    {
+        glm::vec3 n(encoded, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    glm::vec3 ImpostorSelector::FrameDirection(const glm::ivec2& tile)
+    {
+        const glm::vec2 uv = (glm::vec2(tile) + 0.5f) / float(kFramesPerSide);
+        return OctDecode(uv * 2.0f - 1.0f);
+    }
+
+    void ImpostorSelector::FrameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up)
+    {
+        // the axes glm::lookAt derives, looking down -direction with world +Y (or +Z over the poles) up
+        const glm::vec3 forward   = -direction;
+        const glm::vec3 reference = std::abs(direction.y) > 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        right = glm::normalize(glm::cross(forward, reference));
+        up    = glm::cross(right, forward);
+    }
+
+    ImpostorViews ImpostorSelector::SelectViews(const glm::vec3& direction)
+    {
+        // tile centers sit at half-tile offsets; past the outer centers the nearest tile is repeated
+        const glm::vec2 grid = (OctEncode(direction) * 0.5f + 0.5f) * float(kFramesPerSide) - 0.5f;
+        const glm::vec2 base = glm::floor(grid);
+        const glm::vec2 f    = grid - base;
+        auto tile = [&](int dx, int dy)
+        {
+            return glm::clamp(glm::ivec2(base) + glm::ivec2(dx, dy), glm::ivec2(0), glm::ivec2(kFramesPerSide - 1));
+        };
+
+        ImpostorViews views;
+        views.Tiles[0]   = tile(0, 0);
+        views.Tiles[1]   = tile(1, 0);
+        views.Tiles[2]   = tile(0, 1);
+        views.Tiles[3]   = tile(1, 1);
+        views.Weights[0] = (1.0f - f.x) * (1.0f - f.y);
+        views.Weights[1] = f.x * (1.0f - f.y);
+        views.Weights[2] = (1.0f - f.x) * f.y;
+        views.Weights[3] = f.x * f.y;
+        return views;
+    }
+
+    bool ImpostorSelector::UseImpostor(const glm::vec3& center, float radius, bool current)
+    {
+        if (!s_Settings.Enabled || radius <= 0.0f)
+            return false;
+        // with the camera inside the sphere the projected size is unbounded, so the meshes are drawn
+        const float distance  = glm::length(LodSelector::GetCameraPosition() - center) - radius;
+        const float threshold = current ? s_Settings.ScreenSize * (1.0f + kHysteresis) : s_Settings.ScreenSize;
+        return LodSelector::ProjectedError(2.0f * radius, distance) < threshold;
+    }
+
+    void ImpostorSelector::BeginFrame()
+    {
+        // bakes add up over the session; the rest is per frame
+        s_LastFrame = s_Frame;
+        s_Frame.Models           = 0;
+        s_Frame.Impostors        = 0;
+        s_Frame.SkippedTriangles = 0;
+    }
+
+    void ImpostorSelector::RecordModel(bool impostor, std::size_t triangles)
+    {
+        ++s_Frame.Models;
+        if (!impostor)
+            return;
+        ++s_Frame.Impostors;
+        s_Frame.SkippedTriangles += triangles;
+    }
+
+    void ImpostorSelector::RecordBake(bool cached, double milliseconds)
+    {
+        ++(cached ? s_Frame.Cached : s_Frame.Baked);
+        s_Frame.BakeMilliseconds += milliseconds;
+    }
+}
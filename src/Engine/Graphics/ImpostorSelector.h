@@ -0,0 +1,124 @@
+/**
+ * @file ImpostorSelector.h
+ * @brief Header file for the ImpostorSettings struct and the ImpostorSelector class.
+ * A model whose bounding sphere covers fewer than ImpostorSettings::ScreenSize pixels is drawn
+ * as an impostor: one camera-facing quad textured from an atlas of views baked when the model
+ * was loaded (see Impostor). The atlas holds kFramesPerSide x kFramesPerSide views, laid out
+ * by the octahedral map of their directions, so neighbouring tiles are neighbouring views and
+ * any direction is blended from the four views around it.
+ *
+ * GL-free like LodSelector, whose camera of the frame it uses: Model decides and draws.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+namespace isaacObjectViewer
+{
+    /// @brief User settings of impostor selection.
+    struct ImpostorSettings
+    {
+        /// @brief False always draws the meshes.
+        bool  Enabled    { true };
+        /// @brief Models whose bounding sphere is narrower than this on screen, in pixels, are drawn as impostors.
+        float ScreenSize { 32.0f };
+    };
+
+    /// @brief The four atlas views blended for one direction.
+    struct ImpostorViews
+    {
+        /// @brief Tiles of the views, as (column, row) of the atlas.
+        glm::ivec2 Tiles[4];
+        /// @brief Bilinear weights of the views; they sum to 1.
+        float      Weights[4];
+    };
+
+    /// @brief What impostors did in a frame, and the bakes so far.
+    struct ImpostorFrameStats
+    {
+        /// @brief Models that have an impostor.
+        std::size_t Models           = 0;
+        /// @brief Models drawn as impostors.
+        std::size_t Impostors        = 0;
+        /// @brief Triangles the impostors stood in for.
+        std::size_t SkippedTriangles = 0;
+        std::size_t Baked            = 0;
+        /// @brief Bakes read from the impostor cache instead of rendered.
+        std::size_t Cached           = 0;
+        double      BakeMilliseconds = 0.0;
+    };
+
+    class ImpostorSelector
+    {
+    public:
+        /// @brief Views along each side of the atlas.
+        static constexpr int kFramesPerSide = 8;
+
+        /// @brief Size of one view, in pixels.
+        static constexpr int kFrameSize = 64;
+
+        /// @brief Fraction above ScreenSize a model must grow to before it is drawn as meshes again.
+        static constexpr float kHysteresis = 0.1f;
+
+        /// @brief Maps a unit vector onto the octahedron unfolded into a square.
+        /// @param direction The unit vector.
+        /// @return Its position on the square, [-1, 1] on each axis.
+        static glm::vec2 OctEncode(const glm::vec3& direction);
+
+        /// @brief Inverse of OctEncode.
+        /// @param encoded A position on the square.
+        /// @return The unit vector.
+        static glm::vec3 OctDecode(const glm::vec2& encoded);
+
+        /// @brief Gets the direction a view of the atlas was baked from.
+        /// @param tile The view's tile, as (column, row).
+        /// @return The unit vector from the model's center towards the bake camera.
+        static glm::vec3 FrameDirection(const glm::ivec2& tile);
+
+        /// @brief Gets the screen axes of a view, as its bake camera saw them (glm::lookAt).
+        /// @param direction The unit vector from the model's center towards the camera.
+        /// @param right Receives the unit vector to the right of the view.
+        /// @param up Receives the unit vector up the view.
+        static void FrameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up);
+
+        /// @brief Picks the views to blend for a direction.
+        /// @param direction The unit vector from the model's center towards the camera, in the model's space.
+        /// @return The four surrounding views, with their weights.
+        static ImpostorViews SelectViews(const glm::vec3& direction);
+
+        /// @brief Checks if a model is small enough on screen to be drawn as an impostor.
+        /// @param center The center of its bounding sphere, in world space.
+        /// @param radius The radius of its bounding sphere, in world units.
+        /// @param current True if it was drawn as an impostor last frame; growing back needs kHysteresis.
+        /// @return True to draw the impostor; false when impostors are disabled.
+        static bool UseImpostor(const glm::vec3& center, float radius, bool current);
+
+        /// @brief Starts collecting the stats of a new frame.
+        static void BeginFrame();
+
+        /// @brief Counts a model with an impostor, drawn either way.
+        /// @param impostor True if it was drawn as an impostor.
+        /// @param triangles Triangles its meshes would have drawn.
+        static void RecordModel(bool impostor, std::size_t triangles);
+
+        /// @brief Counts a finished bake.
+        /// @param cached True if it was read from the impostor cache.
+        /// @param milliseconds Time the bake took.
+        static void RecordBake(bool cached, double milliseconds);
+
+        /// @brief Gets what the last complete frame drew, and the bakes so far.
+        static const ImpostorFrameStats& GetLastFrame() { return s_LastFrame; }
+
+        /// @brief Gets the settings, for the UI to edit.
+        static ImpostorSettings& GetSettings() { return s_Settings; }
+
+    private:
+        ImpostorSelector() = delete;
+
+        static inline ImpostorSettings   s_Settings;
+        static inline ImpostorFrameStats s_Frame;
+        static inline ImpostorFrameStats s_LastFrame;
+    };
+}
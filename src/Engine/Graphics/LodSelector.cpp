@@ -0,0 +1,83 @@
+#include "LodSelector.h"
+#include <algorithm>
+#include <limits>
+
+namespace isaacObjectViewer
+{
+    void LodSelector::BeginFrame(const glm::mat4& view, const glm::mat4& projection, float viewportHeight, float deltaSeconds)
+    {
+        s_CameraPosition = glm::vec3(glm::inverse(view)[3]);
+        // projection[1][1] is cot(fov/2) for a perspective and 2/height for an orthographic projection
+        s_Perspective    = projection[3][3] == 0.0f;
+        s_PixelsPerUnit  = 0.5f * viewportHeight * projection[1][1];
+        s_Time          += std::max(deltaSeconds, 0.0f);
+
+        s_LastFrame = s_Frame;
+        s_Frame     = LodFrameStats{};
+    }
+
+    float LodSelector::ProjectedError(float error, float distance)
+    {
+        if (!s_Perspective)
+            return error * s_PixelsPerUnit;
+        // inside the bounds everything is close enough to need the full mesh
+        if (distance <= 0.0f)
+            return error > 0.0f ? std::numeric_limits<float>::max() : 0.0f;
+        return error * s_PixelsPerUnit / distance;
+    }
+
+    unsigned int LodSelector::Select(const LodRange* levels, std::size_t count, float distance, unsigned int current)
+    {
+        if (!s_Settings.Enabled || count == 0)
+            return 0;
+
+        unsigned int selected = 0;
+        for (unsigned int level = 1; level < count; ++level)
+        {
+            const float threshold = level > current ? s_Settings.PixelError * (1.0f - s_Settings.Hysteresis)
+                                                    : s_Settings.PixelError;
+            // errors grow along the chain: once one level is too coarse, so are the rest
+            if (ProjectedError(levels[level].Error, distance) > threshold)
+                break;
+            selected = level;
+        }
+        return selected;
+    }
+
+    void LodSelector::Update(LodState& state, unsigned int level)
+    {
+        if (level == state.Current)
+            return;
+        state.Previous  = state.Current;
+        state.Current   = level;
+        state.FadeStart = s_Settings.FadeSeconds > 0.0f ? s_Time : -1.0f;
+    }
+
+    float LodSelector::GetFade(const LodState& state)
+    {
+        if (state.FadeStart < 0.0f || s_Settings.FadeSeconds <= 0.0f)
+            return 1.0f;
+        return std::clamp((s_Time - state.FadeStart) / s_Settings.FadeSeconds, 0.0f, 1.0f);
+    }
+
+    void LodSelector::RecordDraw(unsigned int level, std::size_t drawnTriangles, std::size_t fullTriangles)
+    {
+        ++s_Frame.Meshes[std::min<std::size_t>(level, LodFrameStats::kLevels - 1)];
+        s_Frame.DrawnTriangles += drawnTriangles;
+        s_Frame.FullTriangles  += fullTriangles;
+    }
+
+    glm::vec3 LodSelector::GetDebugColor(unsigned int level)
+    {
+        static const glm::vec3 kColors[] = {
+            { 0.20f, 0.80f, 0.20f },   // 0: full mesh
+            { 0.20f, 0.60f, 1.00f },
+            { 1.00f, 0.85f, 0.10f },
+            { 1.00f, 0.45f, 0.10f },
+            { 0.90f, 0.15f, 0.15f },
+            { 0.80f, 0.20f, 0.90f },
+        };
+        constexpr unsigned int count = sizeof(kColors) / sizeof(kColors[0]);
+        return kColors[std::min(level, count - 1)];
+    }
+}
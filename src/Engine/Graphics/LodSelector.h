@@ -0,0 +1,129 @@
+/**
+ * @file LodSelector.h
+ * @brief Header file for the LodSettings struct and the LodSelector class.
+ * Picks the level of detail of each mesh from the camera: a level is good enough while its
+ * error, projected to the screen, stays under LodSettings::PixelError. Going coarser needs a
+ * margin (Hysteresis), so a mesh at the threshold distance doesn't flip every frame, and a
+ * change fades over FadeSeconds instead of popping (main.fs dithers the two levels).
+ *
+ * GL-free like MeshSimplifier: Mesh measures its distance and draws the ranges.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+
+namespace isaacObjectViewer
+{
+    /// @brief One level of detail, as a range of an index buffer.
+    struct LodRange
+    {
+        unsigned int FirstIndex;
+        unsigned int IndexCount;
+        /// @brief Estimated distance from the full mesh, in the mesh's units; 0 for level 0.
+        float        Error;
+    };
+
+    /// @brief User settings of LOD selection.
+    struct LodSettings
+    {
+        /// @brief False always draws level 0.
+        bool  Enabled     { true };
+        /// @brief Largest on-screen error of the level drawn, in pixels.
+        float PixelError  { 1.0f };
+        /// @brief Fraction of PixelError a coarser level must stay under before it is picked.
+        float Hysteresis  { 0.25f };
+        /// @brief Length of the dithered cross-fade between two levels; 0 switches at once.
+        float FadeSeconds { 0.25f };
+        /// @brief Tints every mesh by the level it draws.
+        bool  DebugColors { false };
+    };
+
+    /// @brief Selection state of one mesh, kept between frames.
+    struct LodState
+    {
+        unsigned int Current   = 0;
+        /// @brief The level faded out since FadeStart.
+        unsigned int Previous  = 0;
+        float        FadeStart = -1.0f;
+    };
+
+    /// @brief What was drawn in a frame, per level.
+    struct LodFrameStats
+    {
+        static constexpr std::size_t kLevels = 8;
+
+        std::array<std::size_t, kLevels> Meshes {};
+        /// @brief Triangles drawn, fading levels included.
+        std::size_t DrawnTriangles = 0;
+        /// @brief Triangles level 0 would have drawn.
+        std::size_t FullTriangles  = 0;
+    };
+
+    class LodSelector
+    {
+    public:
+        /// @brief Takes the camera of the frame about to be drawn.
+        /// @param view The view matrix.
+        /// @param projection The projection matrix; perspective or orthographic.
+        /// @param viewportHeight The height of the viewport, in pixels.
+        /// @param deltaSeconds The time since the last frame.
+        static void BeginFrame(const glm::mat4& view, const glm::mat4& projection, float viewportHeight, float deltaSeconds);
+
+        /// @brief Gets the camera position of the frame.
+        static const glm::vec3& GetCameraPosition() { return s_CameraPosition; }
+
+        /// @brief Projects an error to the screen.
+        /// @param error The error, in world units.
+        /// @param distance The distance from the camera, in world units; ignored by orthographic projections.
+        /// @return The error, in pixels.
+        static float ProjectedError(float error, float distance);
+
+        /// @brief Picks the coarsest level whose error projects under LodSettings::PixelError.
+        /// @param levels The levels, finest first, with growing errors.
+        /// @param count The number of levels.
+        /// @param distance The distance from the camera, in the units of the errors.
+        /// @param current The level drawn so far; coarser levels must beat the threshold by Hysteresis.
+        /// @return The level to draw; 0 when selection is disabled.
+        static unsigned int Select(const LodRange* levels, std::size_t count, float distance, unsigned int current);
+
+        /// @brief Moves a mesh to a level, starting a fade if it changed.
+        /// @param state The mesh's state.
+        /// @param level The selected level.
+        static void Update(LodState& state, unsigned int level);
+
+        /// @brief Gets how far a mesh's fade is.
+        /// @param state The mesh's state.
+        /// @return 0 at the start of the fade to 1 once only Current is drawn.
+        static float GetFade(const LodState& state);
+
+        /// @brief Counts a mesh drawn this frame.
+        /// @param level The level drawn.
+        /// @param drawnTriangles Triangles drawn, all instances and fading levels included.
+        /// @param fullTriangles Triangles level 0 would have drawn.
+        static void RecordDraw(unsigned int level, std::size_t drawnTriangles, std::size_t fullTriangles);
+
+        /// @brief Gets what the last complete frame drew.
+        static const LodFrameStats& GetLastFrame() { return s_LastFrame; }
+
+        /// @brief Gets the debug tint of a level.
+        static glm::vec3 GetDebugColor(unsigned int level);
+
+        /// @brief Gets the settings, for the UI to edit.
+        static LodSettings& GetSettings() { return s_Settings; }
+
+    private:
+        LodSelector() = delete;
+
+        static inline LodSettings   s_Settings;
+        static inline glm::vec3     s_CameraPosition { 0.0f };
+        /// @brief Pixels per world unit at distance 1 (perspective) or anywhere (orthographic).
+        static inline float         s_PixelsPerUnit = 1.0f;
+        static inline bool          s_Perspective   = true;
+        static inline float         s_Time          = 0.0f;
+        static inline LodFrameStats s_Frame;
+        static inline LodFrameStats s_LastFrame;
+    };
+}
@@ -2,10 +2,11 @@
  * @file Material.h
  * @brief Header file for the Material struct.
  * This struct is responsible for defining the material properties used in the rendering pipeline.
- * Currently handles only diffuse and specular textures.
+ * Handles diffuse and specular textures, and constant colors for materials without them.
  */
 
 #pragma once
+#include <glm/glm.hpp>
 #include <memory>
 
 namespace isaacObjectViewer
@@ -20,6 +21,12 @@ namespace isaacObjectViewer
         std::shared_ptr<Texture> Specular  { };
         /// @brief The shininess factor of the material.
         float                    Shininess { 32.0f };
+        /// @brief Diffuse color used where there is no diffuse texture; only when UseColors is set.
+        glm::vec3                DiffuseColor  { 1.0f };
+        /// @brief Specular tint used where there is no specular texture; only when UseColors is set.
+        glm::vec3                SpecularColor { 1.0f };
+        /// @brief True if the constant colors stand in for missing textures (sent as uniforms, no texture needed).
+        bool                     UseColors { false };
 
         /// @brief Default constructor.
         Material() = default;
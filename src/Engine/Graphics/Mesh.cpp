@@ -1,15 +1,34 @@
 #include "Mesh.h"
 #include "Utility/Log.hpp"
 #include "Core/Engine.h"
+#include <algorithm>
+#include <limits>
 
 namespace isaacObjectViewer
 {
-    Mesh::Mesh(const std::vector<Vertex>& vertices,
-             const std::vector<unsigned int>& indices,
+    Mesh::Mesh(std::vector<Vertex> vertices,
+             std::vector<unsigned int> indices,
              const std::vector<std::shared_ptr<Texture>>& textures, 
+             Material material, const std::string& name,
+             const VertexFormat& format, CpuResidency residency,
+             const std::vector<MeshLod>& lods, std::vector<Meshlet> meshlets)
+            : Mesh(std::make_shared<const GpuGeometry>(std::move(vertices), std::move(indices), format, residency, lods,
+                                                       std::move(meshlets)),
+                   textures, std::move(material), name)
+    {
+    }
+
+    Mesh::Mesh(const MeshStreams& streams,
+             const std::vector<std::shared_ptr<Texture>>& textures,
+             Material material, const std::string& name, CpuResidency residency)
+            : Mesh(std::make_shared<const GpuGeometry>(streams, residency), textures, std::move(material), name)
+    {
+    }
+
+    Mesh::Mesh(std::shared_ptr<const GpuGeometry> geometry,
+             const std::vector<std::shared_ptr<Texture>>& textures,
              Material material, const std::string& name)
-            : m_Vertices(vertices)
-            , m_Indices(indices)
+            : m_Geometry(std::move(geometry))
             , m_Textures(textures)
             , m_Name(name)
             , m_Position(DEFAULT_POSITION)
@@ -18,17 +37,13 @@ namespace isaacObjectViewer
             , m_Scale(DEFAULT_SCALE)
             , m_Color(DEFAULT_COLOR)
             , m_UseMaterial(true)
-            , m_Material(material)
-            , m_BBoxMin(std::numeric_limits<float>::max())      
-            , m_BBoxMax(std::numeric_limits<float>::lowest()) 
+            , m_Material(std::move(material))
     {
-        SetupMesh();
     }
 
 
     Mesh::Mesh(const Mesh& other)
-        : m_Vertices(other.m_Vertices)
-        , m_Indices(other.m_Indices)
+        : m_Geometry(other.m_Geometry)
         , m_Textures(other.m_Textures)
         , m_Name(other.m_Name)
         , m_Position(other.m_Position)
@@ -38,11 +53,12 @@ namespace isaacObjectViewer
         , m_Color(other.m_Color)
         , m_UseMaterial(other.m_UseMaterial)
         , m_Material(other.m_Material)
-        , m_BBoxMin(other.m_BBoxMin)
-        , m_BBoxMax(other.m_BBoxMax)
+        , m_CacheStats(other.m_CacheStats)
+        , m_Parts(other.m_Parts)
+        , m_InstanceTransforms(other.m_InstanceTransforms)
+        , m_InstanceBuffer(other.m_InstanceBuffer)
     {
-        // Rebuild GL objects from CPU data
-        SetupMesh();
+        // nothing is uploaded or set up: the copy draws the same buffers through the same vertex arrays
     }
 
 
@@ -50,8 +66,7 @@ namespace isaacObjectViewer
     {
         if (this != &other)
         {
-            m_Vertices      = other.m_Vertices;
-            m_Indices       = other.m_Indices;
+            m_Geometry      = other.m_Geometry;
             m_Textures      = other.m_Textures;
             m_Name          = other.m_Name;               
             m_Position      = other.m_Position;           
@@ -61,56 +76,19 @@ namespace isaacObjectViewer
             m_Color         = other.m_Color;                  
             m_UseMaterial   = other.m_UseMaterial;
             m_Material      = other.m_Material;
-            // Rebuild GL objects
-            m_IndexBuffer.reset();
-            m_VertexBuffer.reset();
-            m_VertexArray.reset();
-            m_BBoxMin       = other.m_BBoxMin;
-            m_BBoxMax       = other.m_BBoxMax;
-        
-            SetupMesh();
-        }
-        return *this;
-    }
-
-    Mesh::Mesh(Mesh&& other) noexcept
-        : m_Vertices(std::move(other.m_Vertices))
-        , m_Indices(std::move(other.m_Indices))
-        , m_Textures(std::move(other.m_Textures))
-        , m_Name(std::move(other.m_Name))               
-        , m_Position(other.m_Position)                  
-        , m_Rotation(other.m_Rotation)                  
-        , m_Orientation(other.m_Orientation)            
-        , m_Scale(other.m_Scale)  
-        , m_Color(other.m_Color)  
-        , m_UseMaterial(other.m_UseMaterial)
-        , m_Material(std::move(other.m_Material))
-        , m_IndexBuffer(std::move(other.m_IndexBuffer))
-        , m_VertexBuffer(std::move(other.m_VertexBuffer))
-        , m_VertexArray(std::move(other.m_VertexArray))
-        , m_BBoxMin(other.m_BBoxMin)
-        , m_BBoxMax(other.m_BBoxMax)
-    {}
-    Mesh& Mesh::operator=(Mesh&& other) noexcept
-    {
-        if (this != &other)
-        {
-            m_Vertices      = std::move(other.m_Vertices);
-            m_Indices       = std::move(other.m_Indices);
-            m_Textures      = std::move(other.m_Textures);
-            m_Material      = std::move(other.m_Material);
-            m_IndexBuffer   = std::move(other.m_IndexBuffer);
-            m_VertexBuffer  = std::move(other.m_VertexBuffer);
-            m_VertexArray   = std::move(other.m_VertexArray);
-            m_BBoxMin       = other.m_BBoxMin;
-            m_BBoxMax       = other.m_BBoxMax;
+            m_CacheStats    = other.m_CacheStats;
+            m_Parts         = other.m_Parts;
+            m_InstanceTransforms = other.m_InstanceTransforms;
+            m_InstanceBuffer     = other.m_InstanceBuffer;
+            m_Lod                = LodState{};
+            m_ClustersCulled     = false;
         }
         return *this;
     }
 
     void Mesh::Render(const Renderer& renderer, const glm::mat4& view, const glm::mat4& projection, Shader* shader)
     {
-        if (!m_VertexArray || !m_VertexBuffer || (!m_IndexBuffer && GetIndexCount() > 0))
+        if (!GetVertexArray() || !GetIndexBuffer())
         {
             LOG_ERROR("Can't Render Mesh: invalid VAO/VBO/IBO");
             return;
@@ -120,6 +98,7 @@ namespace isaacObjectViewer
         shader->setMat4("view", view);
         shader->setMat4("projection", projection);
         shader->setMat4("model", GetModelMatrix());
+        const bool resetFormat = SetVertexFormatUniforms(shader);
 
         // Select material textures (prefer explicit Material, fallback to mesh textures)
         std::shared_ptr<Texture> diffuse = m_Material.Diffuse;
@@ -147,12 +126,13 @@ namespace isaacObjectViewer
         const bool hasDiffuse  = (diffuse  != nullptr);
         const bool hasSpecular = (specular != nullptr);
         
-        const bool useMaterial = m_UseMaterial && (hasDiffuse || hasSpecular);
+        const bool useMaterial = m_UseMaterial && (hasDiffuse || hasSpecular || m_Material.UseColors);
 
         shader->setBool("useMaterial",   useMaterial);
         shader->setBool("hasDiffuseMap",  hasDiffuse);
         shader->setBool("hasSpecularMap", hasSpecular);
         shader->setFloat("material.shininess", m_Material.Shininess);
+        SetColorUniforms(shader);
 
         if (useMaterial) 
         {
@@ -183,7 +163,10 @@ namespace isaacObjectViewer
             shader->setVec3("objectColor", m_Color);
         }
 
-        renderer.Render(*m_VertexArray, *m_IndexBuffer, *shader);
+        // the index buffer also holds the coarser levels: draw the full mesh's range only
+        renderer.Render(*GetVertexArray(), *GetIndexBuffer(), *shader, GetIndexCount(), 0);
+        if (resetFormat)
+            shader->setBool("octNormals", false);
         glActiveTexture(GL_TEXTURE0);
     }
     void Mesh::RenderWithParent(const Renderer& renderer,
@@ -192,18 +175,21 @@ namespace isaacObjectViewer
                             const glm::mat4& projection,
                             Shader* shader,
                             bool useMaterial,
-                            const glm::vec3& objectColor)
+                            const glm::vec3& objectColor,
+                            bool fullDetail)
     {
-        if (!shader || !m_VertexArray || !m_IndexBuffer)
+        if (!shader || !GetVertexArray() || !GetIndexBuffer())
         {
             LOG_ERROR("Can't Render Mesh: invalid shader or buffers");
             return;
         }
 
         shader->Bind();
-        // parent * local
-        const glm::mat4 model = parentModel * GetModelMatrix();
+        const bool instanced = m_InstanceBuffer && m_InstanceTransforms.size() > 1;
+        const glm::mat4 model = PlacedModel(parentModel);
         shader->setMat4("model", model);
+        shader->setBool("useInstancing", instanced);
+        const bool resetFormat = SetVertexFormatUniforms(shader);
         shader->setMat4("view",       view);
         shader->setMat4("projection", projection);
 
@@ -233,12 +219,13 @@ namespace isaacObjectViewer
         const bool hasDiffuse  = (diffuse  != nullptr);
         const bool hasSpecular = (specular != nullptr);
         
-        const bool useMat = useMaterial && (hasDiffuse || hasSpecular);
+        const bool useMat = useMaterial && (hasDiffuse || hasSpecular || m_Material.UseColors);
 
         shader->setBool("useMaterial",   useMat);
         shader->setBool("hasDiffuseMap",  hasDiffuse);
         shader->setBool("hasSpecularMap", hasSpecular);
         shader->setFloat("material.shininess", m_Material.Shininess);
+        SetColorUniforms(shader);
 
         if (useMat) 
         {
@@ -269,55 +256,175 @@ namespace isaacObjectViewer
             shader->setVec3("objectColor", objectColor);
         }
 
-        renderer.Render(*m_VertexArray, *m_IndexBuffer, *shader);
+        DrawLods(renderer, model, shader, instanced, fullDetail);
+        // the shader is shared with objects that never bind instance attributes
+        if (instanced)
+            shader->setBool("useInstancing", false);
+        // like useInstancing: primitives share the shader and never set it
+        if (resetFormat)
+            shader->setBool("octNormals", false);
         glActiveTexture(GL_TEXTURE0);
     }
 
-    void Mesh::SetupMesh()
+    glm::mat4 Mesh::PlacedModel(const glm::mat4& parentModel)
     {
-        // Guard: no vertices => nothing to build
-        if (m_Vertices.empty())
-        {
-            m_VertexArray.reset();
-            m_VertexBuffer.reset();
-            m_IndexBuffer.reset();
-            m_BBoxMin = glm::vec3(0.0f);
-            m_BBoxMax = glm::vec3(0.0f);
+        // parent * local, then the node placement: per instance in the shader, or folded in here for one
+        glm::mat4 model = parentModel * GetModelMatrix();
+        if (m_InstanceTransforms.size() == 1)
+            model = model * m_InstanceTransforms.front();
+        return model;
+    }
+
+    void Mesh::AddClusterJob(const glm::mat4& parentModel, const glm::mat4& viewProjection,
+                             const glm::vec3& camera, std::vector<ClusterCullJob>& jobs)
+    {
+        m_ClustersCulled = false;
+        // instanced meshes and coarser levels are drawn whole
+        const std::vector<Meshlet>& meshlets = m_Geometry->GetMeshlets();
+        if (!ClusterCuller::GetSettings().Enabled || meshlets.empty() || !GetVertexArray()
+            || m_InstanceTransforms.size() > 1 || m_Lod.Current != 0)
             return;
+
+        const glm::mat4 model = PlacedModel(parentModel);
+        const glm::vec3 meshCamera(glm::inverse(model) * glm::vec4(camera, 1.0f));
+        jobs.push_back({ &meshlets, viewProjection * model, meshCamera, ClusterCuller::KeepsAngles(model), &m_VisibleClusters });
+        m_ClustersCulled = true;
+    }
+
+    std::size_t Mesh::DrawVisibleClusters(const Renderer& renderer, Shader* shader)
+    {
+        const IndexBuffer& indices = *GetIndexBuffer();
+        m_DrawCounts.clear();
+        m_DrawOffsets.clear();
+        std::size_t triangles = 0;
+        for (const IndexRange& range : m_VisibleClusters)
+        {
+            m_DrawCounts.push_back(static_cast<GLsizei>(range.IndexCount));
+            m_DrawOffsets.push_back(reinterpret_cast<const void*>(std::size_t(range.FirstIndex) * indices.GetIndexSize()));
+            triangles += range.IndexCount / 3;
         }
+        renderer.RenderMulti(*GetVertexArray(), indices, *shader, m_DrawCounts.data(), m_DrawOffsets.data(),
+                             static_cast<GLsizei>(m_DrawCounts.size()));
+        return triangles;
+    }
+
+    float Mesh::LodDistance(const glm::mat4& model, bool instanced) const
+    {
+        // errors are in the mesh's units, so the distance is divided by the placement's largest scale
+        const glm::vec3 center = 0.5f * (GetBBoxMin() + GetBBoxMax());
+        const float radius = 0.5f * glm::length(GetBBoxMax() - GetBBoxMin());
+        auto distanceTo = [&](const glm::mat4& placement)
+        {
+            const float scale = std::max({ glm::length(glm::vec3(placement[0])), glm::length(glm::vec3(placement[1])),
+                                           glm::length(glm::vec3(placement[2])) });
+            if (scale <= 0.0f)
+                return std::numeric_limits<float>::max();
+            const glm::vec3 worldCenter(placement * glm::vec4(center, 1.0f));
+            return std::max(glm::length(LodSelector::GetCameraPosition() - worldCenter) / scale - radius, 0.0f);
+        };
+
+        if (!instanced)
+            return distanceTo(model);
+        float nearest = std::numeric_limits<float>::max();
+        for (const glm::mat4& transform : m_InstanceTransforms)
+            nearest = std::min(nearest, distanceTo(model * transform));
+        return nearest;
+    }
+
+    void Mesh::DrawLods(const Renderer& renderer, const glm::mat4& model, Shader* shader, bool instanced, bool fullDetail)
+    {
+        const std::vector<LodRange>& lods = m_Geometry->GetLods();
+        if (lods.size() > 1 && !fullDetail)
+            LodSelector::Update(m_Lod, LodSelector::Select(lods.data(), lods.size(), LodDistance(model, instanced), m_Lod.Current));
+
+        const unsigned int instances = instanced ? static_cast<unsigned int>(m_InstanceTransforms.size()) : 1u;
+        const VertexArray& vertexArray = *m_Geometry->GetVertexArray(instanced);
+        // the instanced vertex array is shared by every mesh of the format: point it at this mesh's matrices
+        if (instanced)
+            vertexArray.BindVertexBuffer(GpuGeometry::kInstanceBinding, *m_InstanceBuffer, 0, sizeof(glm::mat4));
+        const bool debug = LodSelector::GetSettings().DebugColors;
+        auto draw = [&](unsigned int level, int dither)
+        {
+            const LodRange& range = lods[level];
+            shader->setInt("lodDither", dither);
+            if (debug)
+                shader->setVec3("lodColor", LodSelector::GetDebugColor(level));
+            if (instanced)
+                renderer.RenderInstanced(vertexArray, *GetIndexBuffer(), *shader, instances, range.IndexCount, range.FirstIndex);
+            else
+                renderer.Render(vertexArray, *GetIndexBuffer(), *shader, range.IndexCount, range.FirstIndex);
+            return std::size_t(range.IndexCount / 3) * instances;
+        };
 
-        m_VertexArray  = std::make_unique<VertexArray>();
-        m_VertexBuffer = std::make_unique<VertexBuffer>(m_Vertices.data(), m_Vertices.size() * sizeof(Vertex));
+        if (fullDetail)
+        {
+            shader->setBool("lodDebug", false);
+            draw(0, 0);
+            return;
+        }
 
-        // Guard indices
-        if (!m_Indices.empty())
-            m_IndexBuffer = std::make_unique<IndexBuffer>(m_Indices.data(), m_Indices.size());
+        shader->setBool("lodDebug", debug);
+        std::size_t drawn = 0;
+        const float fade = LodSelector::GetFade(m_Lod);
+        const bool fading = fade < 1.0f && m_Lod.Previous != m_Lod.Current;
+        const bool culled = m_ClustersCulled && !instanced && !fading && m_Lod.Current == 0;
+        m_ClustersCulled = false;
+        if (culled)
+        {
+            shader->setInt("lodDither", 0);
+            if (debug)
+                shader->setVec3("lodColor", LodSelector::GetDebugColor(0));
+            drawn += DrawVisibleClusters(renderer, shader);
+        }
+        else if (fading)
+        {
+            // complementary dither patterns: each pixel is covered by exactly one of the two levels
+            shader->setFloat("lodFade", fade);
+            drawn += draw(m_Lod.Current, 1);
+            drawn += draw(m_Lod.Previous, 2);
+            shader->setInt("lodDither", 0);
+        }
         else
-            m_IndexBuffer.reset(); // renderer should handle draw-arrays or skip
-
-        m_VertexArray->Bind();
-        m_VertexBuffer->Bind();
-        if (m_IndexBuffer) m_IndexBuffer->Bind();
-
-        VertexBufferLayout vb_layout;
-        vb_layout.Push<float>(3);         // Position
-        vb_layout.Push<float>(3);         // Normal
-        vb_layout.Push<float>(2);         // TexCoords
-        vb_layout.Push<float>(3);         // Tangent
-        vb_layout.Push<float>(3);         // Bitangent
-        vb_layout.Push<unsigned int>(4);  // Bone IDs (make sure this ends up as integer attrib)
-        vb_layout.Push<float>(4);         // Weights
-        m_VertexArray->AddBuffer(*m_VertexBuffer, vb_layout);
-
-        glBindVertexArray(0);
-
-        // Tight AABB
-        m_BBoxMin = m_BBoxMax = m_Vertices[0].Position;
-        for (size_t i = 1; i < m_Vertices.size(); ++i)
         {
-            m_BBoxMin = glm::min(m_BBoxMin, m_Vertices[i].Position);
-            m_BBoxMax = glm::max(m_BBoxMax, m_Vertices[i].Position);
+            drawn += draw(m_Lod.Current, 0);
         }
+        if (debug)
+            shader->setBool("lodDebug", false);
+        LodSelector::RecordDraw(m_Lod.Current, drawn, std::size_t(GetIndexCount() / 3) * instances);
+    }
+
+    bool Mesh::SetVertexFormatUniforms(Shader* shader) const
+    {
+        const bool quantized = GetVertexFormat().Quantized;
+        shader->setBool("octNormals", quantized);
+        return quantized;
     }
 
-}
\ No newline at end of file
+    void Mesh::SetColorUniforms(Shader* shader) const
+    {
+        shader->setBool("material.useColors", m_Material.UseColors);
+        if (m_Material.UseColors)
+        {
+            shader->setVec3("material.diffuseColor",  m_Material.DiffuseColor);
+            shader->setVec3("material.specularColor", m_Material.SpecularColor);
+        }
+    }
+
+    void Mesh::SetInstanceTransforms(std::vector<glm::mat4> transforms)
+    {
+        m_InstanceTransforms = std::move(transforms);
+        SetupInstances();
+    }
+
+    void Mesh::SetupInstances()
+    {
+        if (m_InstanceTransforms.size() <= 1 || !m_Geometry->IsValid())
+        {
+            m_InstanceBuffer.reset();
+            return;
+        }
+
+        m_InstanceBuffer = std::make_shared<const VertexBuffer>(m_InstanceTransforms.data(),
+                                                                static_cast<unsigned int>(m_InstanceTransforms.size() * sizeof(glm::mat4)));
+    }
+}
@@ -2,6 +2,10 @@
  * @file Mesh.h
  * @brief Header file for the Mesh class.
  * This class is responsible for managing and rendering 3D mesh data.
+ * The buffers live in a shared GpuGeometry, so copies of a Mesh draw the same uploaded data
+ * through the same vertex arrays.
+ * Each copy picks its own level of detail (see LodSelector) and, at level 0, draws only the
+ * meshlets ClusterCuller left visible.
  */
 
 #pragma once
@@ -15,50 +19,69 @@
 #include "Graphics/Renderer/IRenderable.h"
 #include "Graphics/Texture.h"
 #include "Graphics/Material.h"
-
-#define MAX_BONE_INFLUENCE 4
+#include "Graphics/Vertex.h"
+#include "Graphics/VertexFormat.h"
+#include "Graphics/MeshStreams.h"
+#include "Graphics/MeshData.h"
+#include "Graphics/GpuGeometry.h"
+#include "Graphics/ClusterCuller.h"
 
 namespace isaacObjectViewer
 {    
-    /// @brief Represents a single vertex in 3D space.
-    struct Vertex 
-    {
-        glm::vec3 Position;
-        glm::vec3 Normal;
-        glm::vec2 TexCoords;
-        glm::vec3 Tangent;
-        glm::vec3 Bitangent;
-
-        // match GL attribute type (unsigned int)
-        unsigned int m_BoneIDs[MAX_BONE_INFLUENCE] = {0};
-        float        m_Weights[MAX_BONE_INFLUENCE] = {0.f};
-    };
-
     class Mesh : public IRenderable
     {
     public:
-        /// @brief Constructs a Mesh object.
+        /// @brief Constructs a Mesh object. Pass the arrays as rvalues to hand them over without a copy.
         /// @param vertices The vertices of the mesh.
         /// @param indices The indices for the mesh.
         /// @param textures The textures used by the mesh.
         /// @param material The material properties of the mesh.
         /// @param name The name of the mesh.
-        Mesh(const std::vector<Vertex>& vertices,
-             const std::vector<unsigned int>& indices,
+        /// @param format The attributes and encodings to upload (see VertexPacker::SelectFormat).
+        /// @param residency What to keep of the vertices and indices after upload.
+        /// @param lods Coarser levels of detail over the same vertices (see MeshSimplifier).
+        /// @param meshlets Clusters of the indices, culled every frame (see MeshletBuilder).
+        Mesh(std::vector<Vertex> vertices,
+             std::vector<unsigned int> indices,
              const std::vector<std::shared_ptr<Texture>>& textures, 
+             Material material, const std::string& name,
+             const VertexFormat& format = VertexFormat{},
+             CpuResidency residency = CpuResidency::Full,
+             const std::vector<MeshLod>& lods = {},
+             std::vector<Meshlet> meshlets = {});
+
+        /// @brief Constructs a Mesh straight from source memory, without an interleaved CPU copy.
+        /// The stream ranges are uploaded as-is and only position, normal and UV are bound.
+        /// @param streams The vertex/index streams; their memory only needs to live for this call.
+        /// @param textures The textures used by the mesh.
+        /// @param material The material properties of the mesh.
+        /// @param name The name of the mesh.
+        /// @param residency What to keep after upload (positions and indices at most).
+        Mesh(const MeshStreams& streams,
+             const std::vector<std::shared_ptr<Texture>>& textures,
+             Material material, const std::string& name,
+             CpuResidency residency = CpuResidency::Full);
+
+        /// @brief Constructs a Mesh drawing already uploaded geometry.
+        /// @param geometry The geometry, shared with every other Mesh holding it.
+        /// @param textures The textures used by the mesh.
+        /// @param material The material properties of the mesh.
+        /// @param name The name of the mesh.
+        Mesh(std::shared_ptr<const GpuGeometry> geometry,
+             const std::vector<std::shared_ptr<Texture>>& textures,
              Material material, const std::string& name);
 
-        /// @brief Copy constructor.
+        /// @brief Copy constructor. Shares the geometry and instance buffer; no GL object is created.
         Mesh(const Mesh&);
         
-        /// @brief Copy assignment operator.
+        /// @brief Copy assignment operator. Shares the geometry and instance buffer like the copy constructor.
         Mesh& operator=(const Mesh&);
         
         /// @brief Move constructor.
-        Mesh(Mesh&& other) noexcept;
+        Mesh(Mesh&& other) noexcept = default;
         
         /// @brief Move assignment operator.
-        Mesh& operator=(Mesh&& other) noexcept;
+        Mesh& operator=(Mesh&& other) noexcept = default;
         
         /// @brief Destructor.
         ~Mesh() = default;
@@ -70,13 +93,24 @@ namespace isaacObjectViewer
                     Shader* shader = nullptr) override;
 
         /// @brief Renders the mesh with a parent model transformation.
+        /// @note fullDetail draws all of level 0, whatever the camera of the frame (impostor bakes).
         void RenderWithParent(const Renderer& renderer,
                               const glm::mat4& parentModel,
                               const glm::mat4& view,
                               const glm::mat4& projection,
                               Shader* shader = nullptr,
                               bool useMaterial = false,
-                              const glm::vec3& objectColor = glm::vec3(DEFAULT_COLOR));
+                              const glm::vec3& objectColor = glm::vec3(DEFAULT_COLOR),
+                              bool fullDetail = false);
+
+        /// @brief Adds the mesh's meshlets to this frame's cluster culling, if it has any and draws them
+        /// next: placed once and at level 0. RenderWithParent then draws the visible ones only.
+        /// @param parentModel The parent model transformation, as passed to RenderWithParent.
+        /// @param viewProjection projection * view.
+        /// @param camera The camera position, in world space.
+        /// @param jobs The frame's jobs; the job points at this mesh, which must stay put until it draws.
+        void AddClusterJob(const glm::mat4& parentModel, const glm::mat4& viewProjection,
+                           const glm::vec3& camera, std::vector<ClusterCullJob>& jobs);
 
         /// @brief Gets the ID of the mesh.
         /// @return The ID of the mesh.
@@ -166,41 +200,96 @@ namespace isaacObjectViewer
         /// @return The shininess of the material.
         float GetShininess() const { return m_Material.Shininess; }
 
-        /// @brief Gets the vertex array of the mesh.
-        /// @return The vertex array of the mesh.
-        const VertexArray*  GetVertexArray()  const { return m_VertexArray.get(); }
+        /// @brief Gets the vertex array of the mesh, shared with every mesh of the same vertex format.
+        /// @return The vertex array of the mesh, or nullptr for empty geometry.
+        const VertexArray*  GetVertexArray()  const { return m_Geometry->GetVertexArray(); }
 
         /// @brief Gets the vertex buffer of the mesh.
         /// @return The vertex buffer of the mesh.
-        const VertexBuffer* GetVertexBuffer() const { return m_VertexBuffer.get(); }
+        const VertexBuffer* GetVertexBuffer() const { return m_Geometry->GetVertexBuffer(); }
         
         /// @brief Gets the index buffer of the mesh.
         /// @return The index buffer of the mesh.
-        const IndexBuffer*  GetIndexBuffer()  const { return m_IndexBuffer.get(); }
+        const IndexBuffer*  GetIndexBuffer()  const { return m_Geometry->GetIndexBuffer(); }
 
         /// @brief Gets the index count of the mesh.
         /// @return The index count of the mesh.
-        unsigned int        GetIndexCount()   const { return static_cast<unsigned int>(m_Indices.size()); }
+        unsigned int        GetIndexCount()   const { return m_Geometry->GetIndexCount(); }
 
         /// @brief Gets the vertex count of the mesh.
         /// @return The vertex count of the mesh.
-        unsigned int        GetVertexCount()  const { return static_cast<unsigned int>(m_Vertices.size()); }
+        unsigned int        GetVertexCount()  const { return m_Geometry->GetVertexCount(); }
+
+        /// @brief Gets the format the vertices were uploaded in.
+        /// @return The format; meshes built from MeshStreams report the default.
+        const VertexFormat& GetVertexFormat() const { return m_Geometry->GetVertexFormat(); }
 
         /// @brief Gets the minimum bounding box of the mesh.
         /// @return The minimum bounding box of the mesh.
-        const glm::vec3& GetBBoxMin() const { return m_BBoxMin; }
+        const glm::vec3& GetBBoxMin() const { return m_Geometry->GetBBoxMin(); }
         /// @brief Gets the maximum bounding box of the mesh.
         /// @return The maximum bounding box of the mesh.
-        const glm::vec3& GetBBoxMax() const { return m_BBoxMax; }
+        const glm::vec3& GetBBoxMax() const { return m_Geometry->GetBBoxMax(); }
+
+        /// @brief Gets the geometry the mesh draws.
+        /// @return The geometry; never null, empty geometry is not IsValid().
+        const std::shared_ptr<const GpuGeometry>& GetGeometry() const { return m_Geometry; }
+
+        /// @brief Gets the level of detail drawn, and the one fading out.
+        const LodState& GetLodState() const { return m_Lod; }
+
+        /// @brief Gets the vertex cache efficiency recorded at import.
+        /// @return The ACMR/ATVR before and after the import's optimization stage.
+        const MeshOptimizationStats& GetCacheStats() const { return m_CacheStats; }
+
+        /// @brief Sets the vertex cache efficiency recorded at import.
+        /// @param stats The stats of the MeshData the mesh was built from.
+        void SetCacheStats(const MeshOptimizationStats& stats) { m_CacheStats = stats; }
+
+        /// @brief Sets the source meshes static batching merged into this one.
+        /// @param parts The parts, as ranges of the index buffer.
+        void SetParts(std::vector<MeshPart> parts) { m_Parts = std::move(parts); }
+
+        /// @brief Gets the source meshes static batching merged into this one.
+        /// @return The parts; empty when the mesh was not merged.
+        const std::vector<MeshPart>& GetParts() const { return m_Parts; }
+
+        /// @brief Places the mesh at several transforms, drawn in one instanced call when there is more than one.
+        /// @param transforms The placements, applied in the mesh's own space. Empty draws the mesh once, untransformed.
+        void SetInstanceTransforms(std::vector<glm::mat4> transforms);
+
+        /// @brief Gets the placements of the mesh.
+        /// @return The instance transforms; empty when the mesh is drawn once, untransformed.
+        const std::vector<glm::mat4>& GetInstanceTransforms() const { return m_InstanceTransforms; }
+
+        /// @brief First attribute location of the per-instance model matrix (four locations, see main.vs).
+        static constexpr unsigned int kInstanceLocation = GpuGeometry::kInstanceLocation;
     private:
-        /// @brief Sets up the mesh.
-        /// Creating the vertex array, vertex buffer, and index buffer.
-        void SetupMesh();
+        /// @brief Tells the shader how location 1 is encoded; returns true if it must be reset after the draw.
+        bool SetVertexFormatUniforms(Shader* shader) const;
+
+        /// @brief Sends the material's constant colors, which replace the textures it doesn't have.
+        void SetColorUniforms(Shader* shader) const;
+
+        /// @brief Uploads m_InstanceTransforms, if there is more than one; bound to the vertex array per draw.
+        void SetupInstances();
+
+        /// @brief The parent, the mesh's own transform and its single placement, if it has exactly one.
+        glm::mat4 PlacedModel(const glm::mat4& parentModel);
+
+        /// @brief Draws the ranges cluster culling left, in one call.
+        std::size_t DrawVisibleClusters(const Renderer& renderer, Shader* shader);
+
+        /// @brief Distance from the camera to the nearest placement's bounding sphere, in the mesh's units.
+        float LodDistance(const glm::mat4& model, bool instanced) const;
+
+        /// @brief Selects a level of detail and draws it, together with the level fading out.
+        /// With fullDetail, draws level 0 whole and leaves the selection and the stats alone.
+        void DrawLods(const Renderer& renderer, const glm::mat4& model, Shader* shader, bool instanced, bool fullDetail);
 
     private:
 
-        std::vector<Vertex> m_Vertices;
-        std::vector<unsigned int> m_Indices;
+        std::shared_ptr<const GpuGeometry> m_Geometry;
         std::vector<std::shared_ptr<Texture>> m_Textures;
 
         
@@ -215,12 +304,18 @@ namespace isaacObjectViewer
         
         Material m_Material;
 
-        std::unique_ptr<IndexBuffer> m_IndexBuffer;
-        std::unique_ptr<VertexBuffer> m_VertexBuffer;
-        std::unique_ptr<VertexArray> m_VertexArray;
-
-        glm::vec3 m_BBoxMin;
-        glm::vec3 m_BBoxMax; 
+        MeshOptimizationStats m_CacheStats;
+        std::vector<MeshPart> m_Parts;
+        std::vector<glm::mat4> m_InstanceTransforms;
+        /// @brief Shared between copies until one of them sets other transforms.
+        std::shared_ptr<const VertexBuffer> m_InstanceBuffer;
+        /// @brief Not copied: a copy selects its own level from where it is placed.
+        LodState m_Lod;
+        /// @brief This frame's cluster culling result; valid while m_ClustersCulled is set.
+        std::vector<IndexRange>  m_VisibleClusters;
+        bool                     m_ClustersCulled = false;
+        std::vector<GLsizei>     m_DrawCounts;
+        std::vector<const void*> m_DrawOffsets;
 
     };
 }
@@ -0,0 +1,743 @@
+#include "MeshCache.h"
+#include "Graphics/MeshProcessing.h"
+#include "Utility/Hash.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include "Utility/ThreadPool.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+namespace isaacObjectViewer
+{
+    // --- file layout ---------------------------------------------------------
+    //
+    //  FileHeader
+    //  u32 dependencyCount
+    //  per dependency: string path, u64 size (~0 if missing), i64 mtime   (other files the import read)
+    //  per material: u32 textureCount, { u32 type, string path } * textureCount,
+    //                string diffuseMap, string specularMap, vec3 kd, vec3 ks, f32 shininess
+    //  u32 nodeCount
+    //  per node:     string name, i32 parent, mat4 transform, u32 meshCount, u32[meshCount]
+    //  u32 imageCount
+    //  per image:    string key, u32 width, u32 height, u64 size, u8[size]   (embedded textures)
+    //  per mesh:     string name, u32 materialIndex, MeshOptimizationStats, VertexFormat,
+    //                u32 partCount, { string name, u32 firstIndex, u32 indexCount, u32 vertexCount,
+    //                                 vec3 bboxMin, vec3 bboxMax, MeshOptimizationStats } * partCount,
+    //                vec3 bboxMin, vec3 bboxMax, u64 vertexCount, pad to 16, packed vertices (VertexPacker::Pack),
+    //                u32 shortIndices, u64 indexCount, pad to 16, u16 or u32[indexCount]   (every level, as uploaded)
+    //                u32 levelCount, LodRange[levelCount], u64 meshletCount, pad to 16, Meshlet[meshletCount]
+    //
+    //  string = u32 length + bytes (no terminator). Everything is little-endian, native layout.
+    //  Meshes are stored as they upload, so a warm load hands the mapping straight to GL.
+    //
+    //  Derived entries (models read straight from a mapping) hold only what is slow to rebuild:
+    //
+    //  FileHeader (kDerivedMagic), u32 dependencyCount (always 0)
+    //  per mesh:     u64 vertexCount, u64 indexCount,
+    //                u32 lodCount, { f32 error, u64 indexCount, pad to 16, u32[indexCount] } * lodCount,
+    //                u64 meshletCount, pad to 16, Meshlet[meshletCount]
+
+    static constexpr char          kMagic[4]        = { 'I', 'O', 'V', 'M' };
+    static constexpr char          kDerivedMagic[4] = { 'I', 'O', 'V', 'D' };
+    static constexpr std::uint32_t kFormatVersion   = 9;
+    static constexpr std::size_t   kAlignment       = 16;
+
+    struct FileHeader
+    {
+        char          Magic[4];
+        std::uint32_t FormatVersion;
+        std::uint32_t EngineVersion;
+        std::uint32_t ImportFlags;
+        std::uint32_t Loader;
+        std::uint32_t PostProcess;
+        std::uint64_t SourceHash;
+        std::uint64_t SourceSize;
+        std::uint32_t MeshCount;
+        std::uint32_t MaterialCount;
+        std::uint32_t ZUp;
+        std::uint64_t FileSize;
+    };
+    static_assert(std::is_trivially_copyable_v<FileHeader>);
+    static_assert(std::is_trivially_copyable_v<VertexFormat>, "VertexFormat is written to the cache as raw bytes");
+    static_assert(std::is_trivially_copyable_v<LodRange>, "LodRange is written to the cache as raw bytes");
+    static_assert(std::is_trivially_copyable_v<Meshlet>, "Meshlet is written to the cache as raw bytes");
+
+    // files above this size are hashed in parallel chunks
+    static constexpr std::size_t kHashChunk = std::size_t(8) << 20;
+
+    // --- writing -------------------------------------------------------------
+
+    class CacheWriter
+    {
+    public:
+        explicit CacheWriter(std::ofstream& out) : m_Out(out) { }
+
+        void Bytes(const void* data, std::size_t size)
+        {
+            m_Out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            m_Offset += size;
+        }
+
+        template<typename T>
+        void Value(const T& value) { Bytes(&value, sizeof(T)); }
+
+        void String(const std::string& s)
+        {
+            Value(static_cast<std::uint32_t>(s.size()));
+            Bytes(s.data(), s.size());
+        }
+
+        void Align()
+        {
+            static const char zeros[kAlignment] = { };
+            Bytes(zeros, (kAlignment - m_Offset % kAlignment) % kAlignment);
+        }
+
+        std::size_t Offset() const { return m_Offset; }
+
+    private:
+        std::ofstream& m_Out;
+        std::size_t    m_Offset = 0;
+    };
+
+    // --- reading -------------------------------------------------------------
+
+    // Bounds-checked cursor over the mapped file; any overrun marks the file corrupt
+    class CacheReader
+    {
+    public:
+        CacheReader(const unsigned char* data, std::size_t size) : m_Data(data), m_Size(size) { }
+
+        const unsigned char* Bytes(std::size_t size)
+        {
+            if (!m_Ok || size > m_Size - m_Offset)
+            {
+                m_Ok = false;
+                return nullptr;
+            }
+            const unsigned char* p = m_Data + m_Offset;
+            m_Offset += size;
+            return p;
+        }
+
+        template<typename T>
+        T Value()
+        {
+            T value{};
+            if (const unsigned char* p = Bytes(sizeof(T)))
+                std::memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        std::string String()
+        {
+            const auto size = Value<std::uint32_t>();
+            const unsigned char* p = Bytes(size);
+            return p ? std::string(reinterpret_cast<const char*>(p), size) : std::string();
+        }
+
+        void Align() { Bytes((kAlignment - m_Offset % kAlignment) % kAlignment); }
+
+        bool Ok() const { return m_Ok; }
+
+    private:
+        const unsigned char* m_Data;
+        std::size_t          m_Size;
+        std::size_t          m_Offset = 0;
+        bool                 m_Ok     = true;
+    };
+
+    // --- dependencies --------------------------------------------------------
+
+    // size and modification time of a file the import read; a missing file is stamped too,
+    // since creating it would change the import
+    struct DependencyStamp
+    {
+        std::uint64_t Size  { ~std::uint64_t(0) };
+        std::int64_t  MTime { 0 };
+    };
+
+    static DependencyStamp stampDependency(const std::string& path)
+    {
+        DependencyStamp stamp;
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        if (ec)
+            return stamp;
+        const auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec)
+            return stamp;
+        stamp.Size  = size;
+        stamp.MTime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+        return stamp;
+    }
+
+    // reads the dependency table; false if it is corrupt or any file changed since the entry was written
+    static bool dependenciesUnchanged(CacheReader& in, std::size_t fileSize)
+    {
+        const auto count = in.Value<std::uint32_t>();
+        if (!in.Ok() || count > fileSize)
+            return false;
+        for (std::uint32_t d = 0; d < count; ++d)
+        {
+            const std::string path = in.String();
+            const auto size  = in.Value<std::uint64_t>();
+            const auto mtime = in.Value<std::int64_t>();
+            if (!in.Ok())
+                return false;
+            const DependencyStamp now = stampDependency(path);
+            if (now.Size != size || now.MTime != mtime)
+                return false;
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+
+    std::string MeshCache::GetCacheDirectory()
+    {
+        return GetProjectRootPath("cache/meshes");
+    }
+
+    std::string MeshCache::GetCachePath(const std::string& sourcePath)
+    {
+        std::error_code ec;
+        std::filesystem::path source(sourcePath);
+        auto canonical = std::filesystem::weakly_canonical(source, ec);
+        const std::string key = (ec ? source : canonical).string();
+
+        // readable stem + hash of the full path, so same-named models in different folders don't collide
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(HashBytes(key.data(), key.size())));
+        return (std::filesystem::path(GetCacheDirectory()) / (source.stem().string() + "-" + hex + ".iovmesh")).string();
+    }
+
+    bool MeshCache::MakeKey(const std::string& sourcePath, unsigned int importFlags, ThreadPool& pool, MeshCacheKey& out)
+    {
+        MappedFile file(sourcePath);
+        if (!file.IsOpen())
+            return false;
+
+        // fixed chunk boundaries keep the hash independent of the thread count
+        const std::size_t size   = file.Size();
+        const std::size_t chunks = (size + kHashChunk - 1) / kHashChunk;
+        std::vector<std::uint64_t> chunkHashes(chunks);
+        pool.ParallelFor(chunks, [&](std::size_t c)
+        {
+            const std::size_t begin = c * kHashChunk;
+            const std::size_t len   = std::min(kHashChunk, size - begin);
+            chunkHashes[c] = HashBytes(file.Data() + begin, len, c);
+        });
+
+        out.SourceHash    = HashBytes(chunkHashes.data(), chunkHashes.size() * sizeof(std::uint64_t), size);
+        out.SourceSize    = size;
+        out.ImportFlags   = importFlags;
+        out.EngineVersion = ENGINE_VERSION;
+        return true;
+    }
+
+    bool MeshCache::MakeStampKey(const std::string& sourcePath, unsigned int importFlags, MeshCacheKey& out)
+    {
+        const DependencyStamp stamp = stampDependency(sourcePath);
+        if (stamp.Size == ~std::uint64_t(0))
+            return false;
+
+        out.SourceHash    = HashBytes(&stamp.MTime, sizeof(stamp.MTime), stamp.Size);
+        out.SourceSize    = stamp.Size;
+        out.ImportFlags   = importFlags;
+        out.EngineVersion = ENGINE_VERSION;
+        return true;
+    }
+
+    // the header of an entry written for exactly this key, and a file of the size it claims
+    static bool headerMatches(const FileHeader& header, const MeshCacheKey& key, std::size_t fileSize,
+                              const char (&magic)[4] = kMagic)
+    {
+        return std::memcmp(header.Magic, magic, sizeof(magic)) == 0
+            && header.FormatVersion == kFormatVersion
+            && header.EngineVersion == key.EngineVersion
+            && header.ImportFlags   == key.ImportFlags
+            && header.Loader        == key.Loader
+            && header.PostProcess   == key.PostProcess
+            && header.SourceHash    == key.SourceHash
+            && header.SourceSize    == key.SourceSize
+            && header.FileSize      == fileSize
+            && header.MeshCount     <= fileSize
+            && header.MaterialCount <= fileSize;
+    }
+
+    bool MeshCache::IsCurrent(const std::string& cachePath, const MeshCacheKey& key)
+    {
+        MappedFile file(cachePath);
+        if (!file.IsOpen())
+            return false;
+        CacheReader in(file.Data(), file.Size());
+        const auto header = in.Value<FileHeader>();
+        return in.Ok() && headerMatches(header, key, file.Size()) && dependenciesUnchanged(in, file.Size());
+    }
+
+    std::unique_ptr<ImportedScene> MeshCache::Read(const std::string& cachePath, const MeshCacheKey& key)
+    {
+        MappedFile file(cachePath);
+        if (!file.IsOpen())
+            return nullptr; // plain miss
+
+        CacheReader in(file.Data(), file.Size());
+        const auto header = in.Value<FileHeader>();
+        if (!in.Ok() || !headerMatches(header, key, file.Size()) || !dependenciesUnchanged(in, file.Size()))
+        {
+            LOG_INFO("Mesh cache entry {} is stale, rebuilding", cachePath);
+            return nullptr;
+        }
+
+        auto scene = std::make_unique<ImportedScene>();
+        scene->ZUp = header.ZUp != 0;
+
+        scene->Materials.resize(header.MaterialCount);
+        for (MaterialData& material : scene->Materials)
+        {
+            const auto textureCount = in.Value<std::uint32_t>();
+            for (std::uint32_t t = 0; t < textureCount && in.Ok(); ++t)
+            {
+                TextureRef ref;
+                ref.Type = static_cast<TextureType>(in.Value<std::uint32_t>());
+                ref.Path = in.String();
+                material.Textures.push_back(std::move(ref));
+            }
+            material.DiffuseMap    = in.String();
+            material.SpecularMap   = in.String();
+            material.DiffuseColor  = in.Value<glm::vec3>();
+            material.SpecularColor = in.Value<glm::vec3>();
+            material.Shininess     = in.Value<float>();
+        }
+
+        const auto nodeCount = in.Value<std::uint32_t>();
+        if (nodeCount > file.Size())
+        {
+            LOG_ERROR("Mesh cache entry {} is corrupt, rebuilding", cachePath);
+            return nullptr;
+        }
+        scene->Nodes.resize(nodeCount);
+        for (SceneNode& node : scene->Nodes)
+        {
+            node.Name      = in.String();
+            node.Parent    = in.Value<std::int32_t>();
+            node.Transform = in.Value<glm::mat4>();
+            const auto meshCount = in.Value<std::uint32_t>();
+            if (const unsigned char* p = in.Bytes(std::size_t(meshCount) * sizeof(std::uint32_t)))
+            {
+                node.Meshes.resize(meshCount);
+                std::memcpy(node.Meshes.data(), p, node.Meshes.size() * sizeof(std::uint32_t));
+            }
+            if (!in.Ok())
+                break;
+        }
+
+        const auto imageCount = in.Value<std::uint32_t>();
+        for (std::uint32_t i = 0; i < imageCount && in.Ok(); ++i)
+        {
+            EmbeddedImage image;
+            image.Key    = in.String();
+            image.Width  = in.Value<std::uint32_t>();
+            image.Height = in.Value<std::uint32_t>();
+            const auto size = in.Value<std::uint64_t>();
+            const unsigned char* p = size <= file.Size() ? in.Bytes(size) : nullptr;
+            if (!p)
+                break;
+            // the scene keeps the mapping (SourceFiles), so the bytes are used in place
+            image.Data = p;
+            image.Size = size;
+            scene->EmbeddedImages.push_back(std::move(image));
+        }
+        if (!in.Ok() || scene->EmbeddedImages.size() != imageCount)
+        {
+            LOG_ERROR("Mesh cache entry {} is corrupt, rebuilding", cachePath);
+            return nullptr;
+        }
+
+        // the geometry stays in the mapping, which the scene keeps until the upload is done
+        scene->Meshes.resize(header.MeshCount);
+        bool sane = true;
+        for (std::uint32_t m = 0; m < header.MeshCount && in.Ok() && sane; ++m)
+        {
+            MeshData& mesh = scene->Meshes[m];
+            mesh.Name          = in.String();
+            mesh.MaterialIndex = in.Value<std::uint32_t>();
+            mesh.Stats         = in.Value<MeshOptimizationStats>();
+            mesh.Format        = in.Value<VertexFormat>();
+
+            const auto partCount = in.Value<std::uint32_t>();
+            sane = partCount <= file.Size();
+            for (std::uint32_t i = 0; i < partCount && in.Ok() && sane; ++i)
+            {
+                MeshPart& part  = mesh.Parts.emplace_back();
+                part.Name        = in.String();
+                part.FirstIndex  = in.Value<std::uint32_t>();
+                part.IndexCount  = in.Value<std::uint32_t>();
+                part.VertexCount = in.Value<std::uint32_t>();
+                part.BBoxMin     = in.Value<glm::vec3>();
+                part.BBoxMax     = in.Value<glm::vec3>();
+                part.Stats       = in.Value<MeshOptimizationStats>();
+            }
+
+            PackedGeometry& packed = mesh.Packed;
+            packed.BBoxMin     = in.Value<glm::vec3>();
+            packed.BBoxMax     = in.Value<glm::vec3>();
+            packed.VertexCount = in.Value<std::uint64_t>();
+            sane = sane && packed.VertexCount <= file.Size() / VertexFormat::kPositionStride;
+            if (!sane)
+                break;
+            in.Align();
+            packed.Vertices = in.Bytes(VertexPacker::PackedSize(packed.VertexCount, mesh.Format));
+
+            packed.ShortIndices = in.Value<std::uint32_t>() != 0;
+            packed.IndexCount   = in.Value<std::uint64_t>();
+            const std::size_t indexSize = packed.ShortIndices ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+            sane = packed.IndexCount <= file.Size() / indexSize;
+            if (!sane)
+                break;
+            in.Align();
+            packed.Indices = in.Bytes(packed.IndexCount * indexSize);
+
+            const auto levelCount = in.Value<std::uint32_t>();
+            sane = levelCount <= file.Size() / sizeof(LodRange);
+            const unsigned char* levels = sane ? in.Bytes(levelCount * sizeof(LodRange)) : nullptr;
+            if (levels)
+            {
+                packed.Levels.resize(levelCount);
+                std::memcpy(packed.Levels.data(), levels, levelCount * sizeof(LodRange));
+            }
+            for (const LodRange& level : packed.Levels)
+                sane = sane && std::uint64_t(level.FirstIndex) + level.IndexCount <= packed.IndexCount;
+
+            const auto meshletCount = in.Value<std::uint64_t>();
+            sane = sane && meshletCount <= file.Size() / sizeof(Meshlet);
+            if (!sane)
+                break;
+            in.Align();
+            if (const unsigned char* p = in.Bytes(meshletCount * sizeof(Meshlet)))
+            {
+                mesh.Meshlets.resize(meshletCount);
+                std::memcpy(mesh.Meshlets.data(), p, meshletCount * sizeof(Meshlet));
+            }
+        }
+        if (!in.Ok() || !sane)
+        {
+            LOG_ERROR("Mesh cache entry {} is corrupt, rebuilding", cachePath);
+            return nullptr;
+        }
+
+        scene->SourceFiles.push_back(std::move(file));
+        return scene;
+    }
+
+    // a header for the key; FileSize is patched in once known
+    static FileHeader makeHeader(const char (&magic)[4], const MeshCacheKey& key, std::size_t meshCount)
+    {
+        FileHeader header{};
+        std::memcpy(header.Magic, magic, sizeof(magic));
+        header.FormatVersion = kFormatVersion;
+        header.EngineVersion = key.EngineVersion;
+        header.ImportFlags   = key.ImportFlags;
+        header.Loader        = key.Loader;
+        header.PostProcess   = key.PostProcess;
+        header.SourceHash    = key.SourceHash;
+        header.SourceSize    = key.SourceSize;
+        header.MeshCount     = static_cast<std::uint32_t>(meshCount);
+        return header;
+    }
+
+    // the LOD chain and meshlets of a mesh, in a derived entry
+    static void writeDerivedData(CacheWriter& out, const MeshData& mesh)
+    {
+        out.Value(static_cast<std::uint32_t>(mesh.Lods.size()));
+        for (const MeshLod& lod : mesh.Lods)
+        {
+            out.Value(lod.Error);
+            out.Value(static_cast<std::uint64_t>(lod.Indices.size()));
+            out.Align();
+            out.Bytes(lod.Indices.data(), lod.Indices.size() * sizeof(unsigned int));
+        }
+
+        out.Value(static_cast<std::uint64_t>(mesh.Meshlets.size()));
+        out.Align();
+        out.Bytes(mesh.Meshlets.data(), mesh.Meshlets.size() * sizeof(Meshlet));
+    }
+
+    // the vertices, indices and levels of a mesh exactly as GpuGeometry uploads them
+    static void writePacked(CacheWriter& out, const MeshData& mesh)
+    {
+        if (mesh.Packed.IsSet())
+        {
+            const PackedGeometry& packed = mesh.Packed;
+            const std::size_t indexSize = packed.ShortIndices ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+            out.Value(packed.BBoxMin);
+            out.Value(packed.BBoxMax);
+            out.Value(static_cast<std::uint64_t>(packed.VertexCount));
+            out.Align();
+            out.Bytes(packed.Vertices, VertexPacker::PackedSize(packed.VertexCount, mesh.Format));
+            out.Value(static_cast<std::uint32_t>(packed.ShortIndices));
+            out.Value(static_cast<std::uint64_t>(packed.IndexCount));
+            out.Align();
+            out.Bytes(packed.Indices, packed.IndexCount * indexSize);
+            out.Value(static_cast<std::uint32_t>(packed.Levels.size()));
+            out.Bytes(packed.Levels.data(), packed.Levels.size() * sizeof(LodRange));
+            return;
+        }
+
+        glm::vec3 bboxMin(0.0f), bboxMax(0.0f);
+        if (!mesh.Vertices.empty())
+            bboxMin = bboxMax = mesh.Vertices[0].Position;
+        for (const Vertex& v : mesh.Vertices)
+        {
+            bboxMin = glm::min(bboxMin, v.Position);
+            bboxMax = glm::max(bboxMax, v.Position);
+        }
+        std::vector<unsigned char> vertices;
+        VertexPacker::Pack(mesh.Vertices, mesh.Format, vertices);
+
+        std::vector<unsigned int> allLevels;
+        const std::vector<LodRange> levels = MeshProcessing::ConcatenateLevels(mesh.Indices, mesh.Lods, allLevels);
+        const std::vector<unsigned int>& indices = allLevels.empty() ? mesh.Indices : allLevels;
+        std::vector<std::uint16_t> shortIndices;
+        const bool narrow = MeshProcessing::NarrowIndices(indices.data(), indices.size(), mesh.Vertices.size(), shortIndices);
+
+        out.Value(bboxMin);
+        out.Value(bboxMax);
+        out.Value(static_cast<std::uint64_t>(mesh.Vertices.size()));
+        out.Align();
+        out.Bytes(vertices.data(), vertices.size());
+        out.Value(static_cast<std::uint32_t>(narrow));
+        out.Value(static_cast<std::uint64_t>(indices.size()));
+        out.Align();
+        if (narrow)
+            out.Bytes(shortIndices.data(), shortIndices.size() * sizeof(std::uint16_t));
+        else
+            out.Bytes(indices.data(), indices.size() * sizeof(unsigned int));
+        out.Value(static_cast<std::uint32_t>(levels.size()));
+        out.Bytes(levels.data(), levels.size() * sizeof(LodRange));
+    }
+
+    // writes the entry next to the target and renames it, so readers never see a half-written file;
+    // body writes everything and patches the header's FileSize
+    static bool writeReplacing(const std::string& cachePath, const std::function<void(std::ofstream&)>& body)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+        const std::string tmpPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_ERROR("Failed to create mesh cache file: {}", tmpPath);
+                return false;
+            }
+
+            body(file);
+
+            if (!file)
+            {
+                LOG_ERROR("Failed to write mesh cache file: {}", tmpPath);
+                file.close();
+                std::filesystem::remove(tmpPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmpPath, cachePath, ec);
+        if (ec)
+        {
+            LOG_ERROR("Failed to replace mesh cache file {}: {}", cachePath, ec.message());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool MeshCache::Write(const std::string& cachePath, const ImportedScene& scene, const MeshCacheKey& key)
+    {
+        return writeReplacing(cachePath, [&](std::ofstream& file)
+        {
+            CacheWriter out(file);
+
+            FileHeader header    = makeHeader(kMagic, key, scene.Meshes.size());
+            header.MaterialCount = static_cast<std::uint32_t>(scene.Materials.size());
+            header.ZUp           = scene.ZUp ? 1 : 0;
+            out.Value(header);
+
+            out.Value(static_cast<std::uint32_t>(scene.Dependencies.size()));
+            for (const std::string& path : scene.Dependencies)
+            {
+                const DependencyStamp stamp = stampDependency(path);
+                out.String(path);
+                out.Value(stamp.Size);
+                out.Value(stamp.MTime);
+            }
+
+            for (const MaterialData& material : scene.Materials)
+            {
+                out.Value(static_cast<std::uint32_t>(material.Textures.size()));
+                for (const TextureRef& ref : material.Textures)
+                {
+                    out.Value(static_cast<std::uint32_t>(ref.Type));
+                    out.String(ref.Path);
+                }
+                out.String(material.DiffuseMap);
+                out.String(material.SpecularMap);
+                out.Value(material.DiffuseColor);
+                out.Value(material.SpecularColor);
+                out.Value(material.Shininess);
+            }
+
+            out.Value(static_cast<std::uint32_t>(scene.Nodes.size()));
+            for (const SceneNode& node : scene.Nodes)
+            {
+                out.String(node.Name);
+                out.Value(static_cast<std::int32_t>(node.Parent));
+                out.Value(node.Transform);
+                out.Value(static_cast<std::uint32_t>(node.Meshes.size()));
+                out.Bytes(node.Meshes.data(), node.Meshes.size() * sizeof(std::uint32_t));
+            }
+
+            out.Value(static_cast<std::uint32_t>(scene.EmbeddedImages.size()));
+            for (const EmbeddedImage& image : scene.EmbeddedImages)
+            {
+                out.String(image.Key);
+                out.Value(static_cast<std::uint32_t>(image.Width));
+                out.Value(static_cast<std::uint32_t>(image.Height));
+                out.Value(static_cast<std::uint64_t>(image.Size));
+                out.Bytes(image.Data, image.Size);
+            }
+
+            for (const MeshData& mesh : scene.Meshes)
+            {
+                out.String(mesh.Name);
+                out.Value(static_cast<std::uint32_t>(mesh.MaterialIndex));
+                out.Value(mesh.Stats);
+                out.Value(mesh.Format);
+
+                out.Value(static_cast<std::uint32_t>(mesh.Parts.size()));
+                for (const MeshPart& part : mesh.Parts)
+                {
+                    out.String(part.Name);
+                    out.Value(static_cast<std::uint32_t>(part.FirstIndex));
+                    out.Value(static_cast<std::uint32_t>(part.IndexCount));
+                    out.Value(static_cast<std::uint32_t>(part.VertexCount));
+                    out.Value(part.BBoxMin);
+                    out.Value(part.BBoxMax);
+                    out.Value(part.Stats);
+                }
+
+                writePacked(out, mesh);
+
+                out.Value(static_cast<std::uint64_t>(mesh.Meshlets.size()));
+                out.Align();
+                out.Bytes(mesh.Meshlets.data(), mesh.Meshlets.size() * sizeof(Meshlet));
+            }
+
+            header.FileSize = out.Offset();
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        });
+    }
+
+    std::string MeshCache::GetDerivedPath(const std::string& sourcePath)
+    {
+        return std::filesystem::path(GetCachePath(sourcePath)).replace_extension(".iovderived").string();
+    }
+
+    bool MeshCache::ReadDerived(const std::string& cachePath, const MeshCacheKey& key, ImportedScene& scene)
+    {
+        MappedFile file(cachePath);
+        if (!file.IsOpen())
+            return false;
+
+        CacheReader in(file.Data(), file.Size());
+        const auto header = in.Value<FileHeader>();
+        if (!in.Ok() || !headerMatches(header, key, file.Size(), kDerivedMagic) || !dependenciesUnchanged(in, file.Size())
+            || header.MeshCount != scene.Meshes.size())
+        {
+            LOG_INFO("Derived mesh cache entry {} is stale, rebuilding", cachePath);
+            return false;
+        }
+
+        // parsed into a copy, so a corrupt entry leaves the scene as it was
+        std::vector<std::vector<MeshLod>> lods(scene.Meshes.size());
+        std::vector<std::vector<Meshlet>> meshlets(scene.Meshes.size());
+        bool sane = true;
+        for (std::size_t m = 0; m < scene.Meshes.size() && in.Ok() && sane; ++m)
+        {
+            const MeshData& mesh = scene.Meshes[m];
+            const auto vertexCount = in.Value<std::uint64_t>();
+            const auto indexCount  = in.Value<std::uint64_t>();
+            sane = vertexCount == mesh.Vertices.size() && indexCount == mesh.Indices.size();
+
+            const auto lodCount = in.Value<std::uint32_t>();
+            sane = sane && lodCount <= file.Size();
+            for (std::uint32_t l = 0; l < lodCount && in.Ok() && sane; ++l)
+            {
+                MeshLod& lod = lods[m].emplace_back();
+                lod.Error = in.Value<float>();
+                const auto lodIndexCount = in.Value<std::uint64_t>();
+                sane = lodIndexCount <= file.Size() / sizeof(unsigned int);
+                in.Align();
+                const unsigned char* p = sane ? in.Bytes(lodIndexCount * sizeof(unsigned int)) : nullptr;
+                if (p)
+                {
+                    lod.Indices.resize(lodIndexCount);
+                    std::memcpy(lod.Indices.data(), p, lodIndexCount * sizeof(unsigned int));
+                }
+            }
+
+            const auto meshletCount = in.Value<std::uint64_t>();
+            sane = sane && meshletCount <= file.Size() / sizeof(Meshlet);
+            if (!sane)
+                break;
+            in.Align();
+            if (const unsigned char* p = in.Bytes(meshletCount * sizeof(Meshlet)))
+            {
+                meshlets[m].resize(meshletCount);
+                std::memcpy(meshlets[m].data(), p, meshletCount * sizeof(Meshlet));
+            }
+        }
+        if (!in.Ok() || !sane)
+        {
+            LOG_ERROR("Derived mesh cache entry {} does not match the model, rebuilding", cachePath);
+            return false;
+        }
+
+        for (std::size_t m = 0; m < scene.Meshes.size(); ++m)
+        {
+            scene.Meshes[m].Lods     = std::move(lods[m]);
+            scene.Meshes[m].Meshlets = std::move(meshlets[m]);
+        }
+        return true;
+    }
+
+    bool MeshCache::WriteDerived(const std::string& cachePath, const ImportedScene& scene, const MeshCacheKey& key)
+    {
+        return writeReplacing(cachePath, [&](std::ofstream& file)
+        {
+            CacheWriter out(file);
+            FileHeader header = makeHeader(kDerivedMagic, key, scene.Meshes.size());
+            out.Value(header);
+            out.Value(std::uint32_t(0)); // the key already covers the one source file
+
+            for (const MeshData& mesh : scene.Meshes)
+            {
+                out.Value(static_cast<std::uint64_t>(mesh.Vertices.size()));
+                out.Value(static_cast<std::uint64_t>(mesh.Indices.size()));
+                writeDerivedData(out, mesh);
+            }
+
+            header.FileSize = out.Offset();
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        });
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file MeshCache.h
+ * @brief On-disk cache of post-processed import results.
+ * A cache file holds the converted meshes (vertices packed in their upload format, every level's
+ * indices as one upload-ready buffer, meshlets and static batch parts), materials, node tree and
+ * embedded texture bytes of one source model. Files are keyed by a
+ * hash of the source contents, the import flags and ENGINE_VERSION, and record the size and
+ * modification time of every other file the import read (such as OBJ material libraries); any
+ * mismatch marks the entry stale and the model is imported again.
+ * Cached files are memory-mapped and uploaded from the mapping, with no parsing; only what the
+ * CPU residency keeps is copied out.
+ *
+ * Models read straight from a mapping (glTF, STL, PLY) parse faster than a full entry would load,
+ * so they only get a derived entry: the LOD chains and meshlets of their MeshData meshes, keyed
+ * by the source's size and modification time (MakeStampKey) and applied after every parse.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    /// @brief Identifies the exact import a cache entry was produced by.
+    struct MeshCacheKey
+    {
+        std::uint64_t SourceHash    { 0 };
+        std::uint64_t SourceSize    { 0 };
+        std::uint32_t ImportFlags   { 0 };
+        std::uint32_t EngineVersion { 0 };
+        /// @brief The importer that produced the entry (ModelManager::ImportLoader).
+        std::uint32_t Loader        { 0 };
+        /// @brief The engine post-processing stages that ran (PostProcessOptions::Pack).
+        std::uint32_t PostProcess   { 0 };
+    };
+
+    class MeshCache
+    {
+    public:
+        /// @brief Enables or disables the cache for subsequent imports.
+        /// @param enabled True to read and write cache files.
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+
+        /// @brief Checks if the cache is enabled.
+        /// @return True if imports read and write cache files.
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// @brief Gets the directory cache files are written to.
+        /// @return The cache directory.
+        static std::string GetCacheDirectory();
+
+        /// @brief Gets the cache file used for a source model.
+        /// @param sourcePath The path to the source model file.
+        /// @return The cache file path (one file per source path).
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        /// @brief Builds the cache key of a source file by hashing its contents.
+        /// @param sourcePath The path to the source model file.
+        /// @param importFlags The Assimp post-processing flags of the import.
+        /// @param pool Pool used to hash large files in parallel.
+        /// @param out Receives the key.
+        /// @return False if the source file can't be read.
+        static bool MakeKey(const std::string& sourcePath, unsigned int importFlags, ThreadPool& pool, MeshCacheKey& out);
+
+        /// @brief Builds a key from the source file's size and modification time, without reading it.
+        /// Cheaper than MakeKey for caches whose entries are small next to the source, but touching
+        /// the file without changing it makes the key change too.
+        /// @param sourcePath The path to the source model file.
+        /// @param importFlags The Assimp post-processing flags of the import.
+        /// @param out Receives the key.
+        /// @return False if the source file can't be stat'ed.
+        static bool MakeStampKey(const std::string& sourcePath, unsigned int importFlags, MeshCacheKey& out);
+
+        /// @brief Loads a cache file if it matches the key.
+        /// @param cachePath The cache file.
+        /// @param key The key the entry must have been written with.
+        /// @return The cached scene (without decoded images), or nullptr on a miss or stale entry. Its meshes
+        /// are packed (MeshData::Packed) and, like its embedded images, point into the mapped entry, which
+        /// the scene keeps in SourceFiles.
+        static std::unique_ptr<ImportedScene> Read(const std::string& cachePath, const MeshCacheKey& key);
+
+        /// @brief Checks if a cache file matches the key, reading only its header and dependency table.
+        /// @param cachePath The cache file.
+        /// @param key The key the entry must have been written with.
+        /// @return True if Read would load the entry.
+        static bool IsCurrent(const std::string& cachePath, const MeshCacheKey& key);
+
+        /// @brief Writes a cache file, replacing any previous entry atomically.
+        /// @param cachePath The cache file.
+        /// @param scene The imported scene, vertex formats chosen; Images are not stored.
+        /// @param key The key of the import that produced the scene.
+        /// @return True if the file was written.
+        static bool Write(const std::string& cachePath, const ImportedScene& scene, const MeshCacheKey& key);
+
+        /// @brief Gets the derived entry used for a source model.
+        /// @param sourcePath The path to the source model file.
+        /// @return The derived cache file path, next to GetCachePath's.
+        static std::string GetDerivedPath(const std::string& sourcePath);
+
+        /// @brief Gives a freshly parsed scene's meshes their cached LOD chains and meshlets. Nothing is changed
+        /// unless the entry matches the key and every mesh's vertex and index counts.
+        /// @param cachePath The derived cache file.
+        /// @param key The key the entry must have been written with.
+        /// @param scene The parsed scene.
+        /// @return True if the entry was applied.
+        static bool ReadDerived(const std::string& cachePath, const MeshCacheKey& key, ImportedScene& scene);
+
+        /// @brief Writes the LOD chains and meshlets of a scene's meshes to a derived entry, replacing
+        /// any previous one atomically.
+        /// @param cachePath The derived cache file.
+        /// @param scene The scene, after its LOD chains and meshlets were built.
+        /// @param key The key of the import that produced the scene.
+        /// @return True if the file was written.
+        static bool WriteDerived(const std::string& cachePath, const ImportedScene& scene, const MeshCacheKey& key);
+
+    private:
+        MeshCache() = delete;
+
+        static inline bool s_Enabled = true;
+    };
+}
@@ -0,0 +1,125 @@
+/**
+ * @file MeshData.h
+ * @brief Header file for the MeshData struct.
+ * CPU-side result of converting an imported mesh. It owns no GL objects,
+ * so it can be produced on worker threads and turned into a Mesh later
+ * on the thread that owns the GL context.
+ */
+
+#pragma once
+
+#include "Graphics/VertexFormat.h"
+#include "Graphics/LodSelector.h"
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief Post-transform vertex cache efficiency of an index buffer (see MeshOptimizer).
+    struct VertexCacheStats
+    {
+        /// @brief Average cache miss ratio: vertex shader runs per triangle (0.5 is ideal for large grids, 3 is worst).
+        float Acmr { 0.0f };
+        /// @brief Average transformed vertex ratio: vertex shader runs per referenced vertex (1 is ideal).
+        float Atvr { 0.0f };
+    };
+
+    /// @brief Vertex cache efficiency of a mesh before and after the import's optimization stage.
+    struct MeshOptimizationStats
+    {
+        VertexCacheStats Before;
+        VertexCacheStats After;
+        /// @brief True if the engine reordered the mesh; otherwise Before and After are equal.
+        bool             Optimized { false };
+    };
+
+    /// @brief One source mesh inside a mesh that static batching merged from several.
+    struct MeshPart
+    {
+        /// @brief The name of the source mesh.
+        std::string           Name;
+        /// @brief The part's triangles: a range of the merged index buffer.
+        unsigned int          FirstIndex  { 0 };
+        unsigned int          IndexCount  { 0 };
+        unsigned int          VertexCount { 0 };
+        /// @brief Bounds of the part in the merged mesh's space (its node transform applied).
+        glm::vec3             BBoxMin     { 0.0f };
+        glm::vec3             BBoxMax     { 0.0f };
+        /// @brief Vertex cache efficiency of the source mesh.
+        MeshOptimizationStats Stats;
+    };
+
+    /// @brief One coarser level of detail of a mesh, drawn from the same vertices (see MeshSimplifier).
+    struct MeshLod
+    {
+        /// @brief Triangle list indices into the mesh's Vertices.
+        std::vector<unsigned int> Indices;
+        /// @brief Estimated largest distance of the level from the full mesh, in the mesh's units.
+        float                     Error { 0.0f };
+    };
+
+    /// @brief A small cluster of a mesh's triangles, for culling on the CPU (see MeshletBuilder).
+    struct Meshlet
+    {
+        /// @brief The cluster's triangles: a range of the mesh's Indices.
+        unsigned int FirstIndex { 0 };
+        unsigned int IndexCount { 0 };
+        /// @brief Bounding sphere, in the mesh's space.
+        glm::vec3    Center     { 0.0f };
+        float        Radius     { 0.0f };
+        /// @brief Average facing of the triangles.
+        glm::vec3    ConeAxis   { 0.0f, 0.0f, 1.0f };
+        /// @brief Sine of the largest angle between ConeAxis and a triangle's normal; 1 when the
+        /// triangles face too many ways for the cluster to ever face away as a whole.
+        float        ConeCutoff { 1.0f };
+    };
+
+    /// @brief A mesh already in the layout it uploads in, in memory that outlives the upload
+    /// (a mapped mesh cache entry). GpuGeometry uploads it as it is.
+    struct PackedGeometry
+    {
+        /// @brief The vertices as VertexPacker::Pack writes them, in the mesh's Format.
+        const unsigned char*  Vertices     { nullptr };
+        std::size_t           VertexCount  { 0 };
+        /// @brief The full triangle list followed by every coarser level, 16-bit if ShortIndices is set.
+        const void*           Indices      { nullptr };
+        std::size_t           IndexCount   { 0 };
+        bool                  ShortIndices { false };
+        /// @brief Where each level sits in Indices, level 0 (the full mesh) first.
+        std::vector<LodRange> Levels;
+        glm::vec3             BBoxMin      { 0.0f };
+        glm::vec3             BBoxMax      { 0.0f };
+
+        /// @brief Checks if the mesh came packed.
+        /// @return True if Vertices is set.
+        bool IsSet() const { return Vertices != nullptr; }
+    };
+
+    struct MeshData
+    {
+        /// @brief The name of the source mesh.
+        std::string               Name;
+        /// @brief Interleaved vertex data, ready for upload.
+        std::vector<Vertex>       Vertices;
+        /// @brief Triangle list indices into Vertices.
+        std::vector<unsigned int> Indices;
+        /// @brief Index of the source material in the imported scene.
+        unsigned int              MaterialIndex { 0 };
+        /// @brief Vertex cache efficiency, filled in by the optimization stage of the import.
+        MeshOptimizationStats     Stats;
+        /// @brief The source meshes static batching merged into this one; empty for an unmerged mesh.
+        std::vector<MeshPart>     Parts;
+        /// @brief What the upload keeps of Vertices and how it encodes it, chosen at the end of the import.
+        VertexFormat              Format;
+        /// @brief Coarser levels of detail, finest first; empty unless the import built them.
+        std::vector<MeshLod>      Lods;
+        /// @brief Clusters covering Indices in order; empty unless the import built them.
+        std::vector<Meshlet>      Meshlets;
+        /// @brief Set instead of Vertices, Indices and Lods when the mesh was read from the mesh cache.
+        PackedGeometry            Packed;
+
+        /// @brief Checks if the mesh has anything to draw.
+        /// @return True if there are no vertices and no indices.
+        bool Empty() const { return Vertices.empty() && Indices.empty() && Packed.VertexCount == 0; }
+    };
+}
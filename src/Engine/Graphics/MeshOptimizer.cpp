@@ -0,0 +1,333 @@
+#include "MeshOptimizer.h"
+#include "Utility/Arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    // --- analysis ------------------------------------------------------------
+
+    // FIFO simulation with timestamps: a vertex is cached while fewer than cacheSize
+    // misses happened since it was last loaded
+    struct FifoCache
+    {
+        std::pmr::vector<unsigned int> LoadedAt;
+        unsigned int                   Time;
+        unsigned int                   Size;
+
+        FifoCache(std::size_t vertexCount, unsigned int size)
+            : LoadedAt(vertexCount, 0, ScratchArena::Get()), Time(size + 1), Size(size) { }
+
+        /// returns true on a miss
+        bool Access(unsigned int v)
+        {
+            if (Time - LoadedAt[v] <= Size)
+                return false;
+            LoadedAt[v] = Time++;
+            return true;
+        }
+    };
+
+    static bool indicesInRange(const unsigned int* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        return std::all_of(indices, indices + indexCount, [vertexCount](unsigned int i) { return i < vertexCount; });
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const unsigned int* indices, std::size_t indexCount,
+                                                       std::size_t vertexCount, unsigned int cacheSize)
+    {
+        VertexCacheStats stats;
+        const std::size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || !indicesInRange(indices, triangleCount * 3, vertexCount))
+            return stats;
+
+        ArenaScope scope;
+        FifoCache cache(vertexCount, cacheSize);
+        std::pmr::vector<bool> referenced(vertexCount, false, ScratchArena::Get());
+        std::size_t misses = 0, used = 0;
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            misses += cache.Access(indices[i]);
+            if (!referenced[indices[i]])
+            {
+                referenced[indices[i]] = true;
+                ++used;
+            }
+        }
+        stats.Acmr = float(misses) / float(triangleCount);
+        stats.Atvr = float(misses) / float(used);
+        return stats;
+    }
+
+    // --- vertex cache (Forsyth, "Linear-Speed Vertex Cache Optimisation") ------
+
+    // the LRU size the scores are tuned for; larger than kAnalyzeCacheSize on purpose
+    static constexpr unsigned int kForsythCacheSize = 32;
+    static constexpr unsigned int kMaxValence       = 32;
+
+    struct ScoreTables
+    {
+        float Cache[kForsythCacheSize];
+        float Valence[kMaxValence + 1];
+
+        ScoreTables()
+        {
+            for (unsigned int i = 0; i < kForsythCacheSize; ++i)
+            {
+                // the last triangle's vertices get a fixed score, so the next one doesn't just reuse its edge
+                Cache[i] = i < 3 ? 0.75f
+                                 : std::pow(1.0f - float(i - 3) / float(kForsythCacheSize - 3), 1.5f);
+            }
+            Valence[0] = 0.0f;
+            for (unsigned int i = 1; i <= kMaxValence; ++i)
+                Valence[i] = 2.0f / std::sqrt(float(i)); // finish off vertices with few triangles left
+        }
+    };
+
+    void MeshOptimizer::OptimizeVertexCache(unsigned int* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        const std::size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2 || !indicesInRange(indices, triangleCount * 3, vertexCount))
+            return;
+
+        static const ScoreTables tables;
+        auto vertexScore = [](int cachePosition, unsigned int remaining)
+        {
+            if (remaining == 0)
+                return -1.0f;
+            return (cachePosition >= 0 ? tables.Cache[cachePosition] : 0.0f) + tables.Valence[std::min(remaining, kMaxValence)];
+        };
+
+        ArenaScope scope;
+
+        // triangles of each vertex (CSR); the first remaining[v] entries are the ones not emitted yet
+        std::pmr::vector<unsigned int> remaining(vertexCount, 0, ScratchArena::Get());
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+            ++remaining[indices[i]];
+        std::pmr::vector<std::size_t> offsets(vertexCount + 1, 0, ScratchArena::Get());
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            offsets[v + 1] = offsets[v] + remaining[v];
+        std::pmr::vector<unsigned int> adjacency(triangleCount * 3, ScratchArena::Get());
+        {
+            std::pmr::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1, ScratchArena::Get());
+            for (std::size_t t = 0; t < triangleCount; ++t)
+                for (int k = 0; k < 3; ++k)
+                    adjacency[cursor[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+        }
+
+        std::pmr::vector<float> score(vertexCount, ScratchArena::Get());
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            score[v] = vertexScore(-1, remaining[v]);
+
+        auto triangleScore = [&](std::size_t t)
+        {
+            return score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+        };
+
+        std::size_t best = 0;
+        for (std::size_t t = 1; t < triangleCount; ++t)
+            if (triangleScore(t) > triangleScore(best))
+                best = t;
+
+        std::pmr::vector<unsigned int> out(triangleCount * 3, ScratchArena::Get());
+        std::pmr::vector<bool> emitted(triangleCount, false, ScratchArena::Get());
+        unsigned int cache[kForsythCacheSize + 3];
+        unsigned int next[kForsythCacheSize + 3];
+        std::size_t cacheCount = 0;
+        std::size_t deadEndCursor = 0;
+
+        for (std::size_t n = 0; n < triangleCount; ++n)
+        {
+            if (best == triangleCount)
+            {
+                // nothing left around the cache: continue with the next triangle in input order
+                while (emitted[deadEndCursor])
+                    ++deadEndCursor;
+                best = deadEndCursor;
+            }
+
+            const unsigned int tri[3] = { indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2] };
+            std::copy(tri, tri + 3, out.begin() + n * 3);
+            emitted[best] = true;
+
+            // drop the triangle from its vertices' remaining lists
+            for (unsigned int v : tri)
+            {
+                unsigned int* list = adjacency.data() + offsets[v];
+                const unsigned int count = remaining[v];
+                std::iter_swap(std::find(list, list + count, static_cast<unsigned int>(best)), list + count - 1);
+                --remaining[v];
+            }
+
+            // new LRU order: the triangle's vertices in front, then the previous cache
+            std::size_t nextCount = 0;
+            for (unsigned int v : tri)
+                if (std::find(next, next + nextCount, v) == next + nextCount)
+                    next[nextCount++] = v;
+            for (std::size_t i = 0; i < cacheCount; ++i)
+                if (std::find(tri, tri + 3, cache[i]) == tri + 3)
+                    next[nextCount++] = cache[i];
+
+            for (std::size_t i = kForsythCacheSize; i < nextCount; ++i)
+                score[next[i]] = vertexScore(-1, remaining[next[i]]); // fell out of the cache
+            cacheCount = std::min<std::size_t>(nextCount, kForsythCacheSize);
+            for (std::size_t i = 0; i < cacheCount; ++i)
+            {
+                cache[i] = next[i];
+                score[cache[i]] = vertexScore(static_cast<int>(i), remaining[cache[i]]);
+            }
+
+            // the best candidate is a remaining triangle of a cached vertex
+            best = triangleCount;
+            float bestScore = -1.0f;
+            for (std::size_t i = 0; i < cacheCount; ++i)
+            {
+                const unsigned int v = cache[i];
+                const unsigned int* list = adjacency.data() + offsets[v];
+                for (unsigned int j = 0; j < remaining[v]; ++j)
+                {
+                    const float s = triangleScore(list[j]);
+                    if (s > bestScore)
+                    {
+                        bestScore = s;
+                        best = list[j];
+                    }
+                }
+            }
+        }
+
+        std::copy(out.begin(), out.end(), indices);
+    }
+
+    // --- overdraw --------------------------------------------------------------
+
+    void MeshOptimizer::OptimizeOverdraw(unsigned int* indices, std::size_t indexCount,
+                                         const Vertex* vertices, std::size_t vertexCount, float threshold)
+    {
+        const std::size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2 || !indicesInRange(indices, triangleCount * 3, vertexCount))
+            return;
+
+        ArenaScope scope;
+
+        // clusters start where the cache restarts (all three corners miss), so moving
+        // them around costs almost nothing in cache efficiency
+        std::pmr::vector<std::size_t> clusterStart(ScratchArena::Get());
+        {
+            FifoCache cache(vertexCount, kAnalyzeCacheSize);
+            for (std::size_t t = 0; t < triangleCount; ++t)
+            {
+                int misses = 0;
+                for (int k = 0; k < 3; ++k)
+                    misses += cache.Access(indices[t * 3 + k]);
+                if (t == 0 || misses == 3)
+                    clusterStart.push_back(t);
+            }
+        }
+        const std::size_t clusterCount = clusterStart.size();
+        if (clusterCount < 2)
+            return;
+        clusterStart.push_back(triangleCount);
+
+        // area-weighted centroid and normal of every cluster
+        std::pmr::vector<glm::vec3> centroid(clusterCount, ScratchArena::Get()), normal(clusterCount, ScratchArena::Get());
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+        for (std::size_t c = 0; c < clusterCount; ++c)
+        {
+            glm::vec3 weighted(0.0f), plain(0.0f), n(0.0f);
+            float a = 0.0f;
+            for (std::size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t)
+            {
+                const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+                const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+                const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+                const glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+                const float triangleArea = glm::length(cross) * 0.5f;
+                const glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+                weighted += center * triangleArea;
+                plain    += center;
+                n        += cross;
+                a        += triangleArea;
+            }
+            const float count = float(clusterStart[c + 1] - clusterStart[c]);
+            centroid[c] = a > 0.0f ? weighted / a : plain / count;
+            normal[c]   = n;
+            meshCentroid += weighted;
+            meshArea     += a;
+        }
+        if (meshArea <= 0.0f)
+            return;
+        meshCentroid /= meshArea;
+
+        // clusters facing away from the center are likely in front of the ones that face in
+        std::pmr::vector<float> sortKey(clusterCount, ScratchArena::Get());
+        for (std::size_t c = 0; c < clusterCount; ++c)
+        {
+            const float len = glm::length(normal[c]);
+            sortKey[c] = len > 0.0f ? glm::dot(centroid[c] - meshCentroid, normal[c] / len) : 0.0f;
+        }
+        std::pmr::vector<std::size_t> order(clusterCount, ScratchArena::Get());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return sortKey[a] > sortKey[b]; });
+
+        std::pmr::vector<unsigned int> sorted(ScratchArena::Get());
+        sorted.reserve(triangleCount * 3);
+        for (std::size_t c : order)
+            sorted.insert(sorted.end(), indices + clusterStart[c] * 3, indices + clusterStart[c + 1] * 3);
+
+        const float before = AnalyzeVertexCache(indices, triangleCount * 3, vertexCount).Acmr;
+        const float after  = AnalyzeVertexCache(sorted.data(), sorted.size(), vertexCount).Acmr;
+        if (after <= before * threshold)
+            std::copy(sorted.begin(), sorted.end(), indices);
+    }
+
+    // --- vertex fetch ----------------------------------------------------------
+
+    void MeshOptimizer::OptimizeVertexFetch(MeshData& mesh)
+    {
+        const std::size_t vertexCount = mesh.Vertices.size();
+        if (!indicesInRange(mesh.Indices.data(), mesh.Indices.size(), vertexCount))
+            return;
+
+        ArenaScope scope;
+        static constexpr unsigned int kUnused = ~0u;
+        std::pmr::vector<unsigned int> remap(vertexCount, kUnused, ScratchArena::Get());
+        unsigned int next = 0;
+        for (unsigned int& index : mesh.Indices)
+        {
+            if (remap[index] == kUnused)
+                remap[index] = next++;
+            index = remap[index];
+        }
+
+        std::vector<Vertex> reordered(next);
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            if (remap[v] != kUnused)
+                reordered[remap[v]] = mesh.Vertices[v];
+        mesh.Vertices = std::move(reordered);
+    }
+
+    // ------------------------------------------------------------------------
+
+    void MeshOptimizer::Optimize(MeshData& mesh)
+    {
+        MeshOptimizationStats& stats = mesh.Stats;
+        stats.Before = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+        stats.After  = stats.Before;
+        stats.Optimized = false;
+        if (mesh.Indices.size() < 6 || mesh.Indices.size() % 3 != 0 ||
+            !indicesInRange(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size()))
+            return;
+
+        OptimizeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+        OptimizeOverdraw(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.data(), mesh.Vertices.size());
+        OptimizeVertexFetch(mesh);
+
+        stats.After     = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+        stats.Optimized = true;
+    }
+}
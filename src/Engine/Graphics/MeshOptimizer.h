@@ -0,0 +1,65 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief Reorders mesh data for faster drawing, and measures how much it helped.
+ * Three passes, in order: triangles for post-transform vertex cache hits (Forsyth's linear-speed
+ * algorithm), triangle clusters for less overdraw (front-facing-out clusters first, as in Sander
+ * et al.), and vertices in first-use order for vertex fetch locality. Replaces
+ * aiProcess_ImproveCacheLocality, whose effect could not be measured.
+ *
+ * Every pass is sequential per mesh; ModelManager runs meshes in parallel.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include <cstddef>
+
+namespace isaacObjectViewer
+{
+    class MeshOptimizer
+    {
+    public:
+        /// @brief FIFO size used when measuring ACMR/ATVR; a conservative figure for current GPUs.
+        static constexpr unsigned int kAnalyzeCacheSize = 16;
+
+        /// @brief Largest cluster ACMR increase the overdraw pass may cause, as a factor.
+        static constexpr float kOverdrawThreshold = 1.05f;
+
+        /// @brief Runs all three passes on a mesh and records ACMR/ATVR before and after in mesh.Stats.
+        /// @param mesh The mesh to reorder in place; vertices no triangle references are dropped.
+        static void Optimize(MeshData& mesh);
+
+        /// @brief Simulates a FIFO post-transform cache over a triangle list.
+        /// @param indices The triangle list.
+        /// @param indexCount The number of indices.
+        /// @param vertexCount The number of vertices the indices refer to.
+        /// @param cacheSize The number of cache entries.
+        /// @return The cache efficiency of the triangle order.
+        static VertexCacheStats AnalyzeVertexCache(const unsigned int* indices, std::size_t indexCount,
+                                                   std::size_t vertexCount, unsigned int cacheSize = kAnalyzeCacheSize);
+
+        /// @brief Reorders triangles so consecutive ones share vertices.
+        /// @param indices The triangle list, reordered in place.
+        /// @param indexCount The number of indices.
+        /// @param vertexCount The number of vertices the indices refer to.
+        static void OptimizeVertexCache(unsigned int* indices, std::size_t indexCount, std::size_t vertexCount);
+
+        /// @brief Reorders clusters of a cache-optimized triangle list so outward-facing ones draw
+        /// first, which lets early depth testing reject more of what follows.
+        /// @param indices The triangle list, reordered in place.
+        /// @param indexCount The number of indices.
+        /// @param vertices The vertices the indices refer to.
+        /// @param vertexCount The number of vertices.
+        /// @param threshold Largest ACMR increase accepted, as a factor; the order is kept otherwise.
+        static void OptimizeOverdraw(unsigned int* indices, std::size_t indexCount,
+                                     const Vertex* vertices, std::size_t vertexCount,
+                                     float threshold = kOverdrawThreshold);
+
+        /// @brief Reorders vertices by first use in the index buffer and remaps the indices.
+        /// @param mesh The mesh to reorder in place; unreferenced vertices are dropped.
+        static void OptimizeVertexFetch(MeshData& mesh);
+
+    private:
+        MeshOptimizer() = delete;
+    };
+}
@@ -0,0 +1,616 @@
+#include "MeshProcessing.h"
+#include "Utility/Arena.h"
+#include "Utility/Hash.h"
+#include "Utility/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+namespace isaacObjectViewer
+{
+    // triangles per ParallelFor task
+    static constexpr std::size_t kTriangleBlock = std::size_t(1) << 16;
+
+    static inline std::size_t blockCount(std::size_t count, std::size_t block)
+    {
+        return (count + block - 1) / block;
+    }
+
+    // --- weld ----------------------------------------------------------------
+
+    // folds -0 into +0 so both weld together
+    static inline std::uint32_t floatBits(float f)
+    {
+        if (f == 0.0f)
+            f = 0.0f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, 4);
+        return bits;
+    }
+
+    static inline std::uint64_t hashPosition(const std::uint32_t (&bits)[3])
+    {
+        std::uint64_t h = bits[0] * 0x9E3779B97F4A7C15ull;
+        h ^= (bits[1] + 0x7F4A7C15ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= (bits[2] + 0x165667B1ull) * 0x165667B19E3779F9ull;
+        return h ^ (h >> 29);
+    }
+
+    // One pass with a fixed-size table; fails if more than maxUnique positions show up
+    static bool tryWeld(const unsigned char* data, std::size_t triangleCount, std::size_t triangleStride,
+                        std::size_t cornerOffset, std::size_t expectedUnique, ThreadPool& pool, WeldedPositions& out)
+    {
+        // slot value: 0 = empty, kBusy = claimed and being written, otherwise vertex id + 1
+        static constexpr std::uint32_t kBusy = ~0u;
+
+        std::size_t capacity = 64;
+        while (capacity < expectedUnique * 2)
+            capacity <<= 1;
+        const std::size_t mask      = capacity - 1;
+        const std::size_t maxUnique = std::min<std::size_t>(capacity / 2, kBusy - 1);
+
+        std::unique_ptr<std::uint32_t[]> slots(new std::uint32_t[capacity]);
+        pool.ParallelFor(blockCount(capacity, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t begin = b * kTriangleBlock;
+            std::fill(slots.get() + begin, slots.get() + std::min(capacity, begin + kTriangleBlock), 0u);
+        });
+
+        // untouched pages of the position array are never made resident
+        out.Positions.reset(new glm::vec3[maxUnique]);
+        out.Indices.resize(triangleCount * 3);
+        glm::vec3*    positions = out.Positions.get();
+        unsigned int* indices   = out.Indices.data();
+
+        std::atomic<std::uint32_t> nextId { 0 };
+        std::atomic<bool>          overflow { false };
+
+        pool.ParallelFor(blockCount(triangleCount, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(triangleCount, (b + 1) * kTriangleBlock);
+            for (std::size_t t = b * kTriangleBlock; t < end; ++t)
+            {
+                if (overflow.load(std::memory_order_relaxed))
+                    return;
+
+                const unsigned char* corner = data + t * triangleStride + cornerOffset;
+                for (int k = 0; k < 3; ++k, corner += 12)
+                {
+                    float xyz[3];
+                    std::memcpy(xyz, corner, 12);
+                    const std::uint32_t bits[3] = { floatBits(xyz[0]), floatBits(xyz[1]), floatBits(xyz[2]) };
+
+                    std::size_t i = hashPosition(bits) & mask;
+                    for (;;)
+                    {
+                        std::atomic_ref<std::uint32_t> slot(slots[i]);
+                        std::uint32_t value = slot.load(std::memory_order_acquire);
+                        if (value == 0)
+                        {
+                            if (slot.compare_exchange_strong(value, kBusy, std::memory_order_acq_rel))
+                            {
+                                const std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+                                if (id >= maxUnique)
+                                {
+                                    overflow.store(true);
+                                    slot.store(0, std::memory_order_release);
+                                    return;
+                                }
+                                std::memcpy(&positions[id], bits, 12);
+                                slot.store(id + 1, std::memory_order_release);
+                                indices[t * 3 + k] = id;
+                                break;
+                            }
+                            // lost the race: value now holds the winner's state
+                        }
+                        while (value == kBusy)
+                        {
+                            std::this_thread::yield();
+                            value = slot.load(std::memory_order_acquire);
+                        }
+                        if (value != 0 && std::memcmp(&positions[value - 1], bits, 12) == 0)
+                        {
+                            indices[t * 3 + k] = value - 1;
+                            break;
+                        }
+                        if (value != 0)
+                            i = (i + 1) & mask;
+                    }
+                }
+            }
+        });
+
+        if (overflow.load())
+            return false;
+        out.VertexCount = nextId.load();
+        return true;
+    }
+
+    WeldedPositions MeshProcessing::WeldPositions(const unsigned char* data, std::size_t triangleCount,
+                                                  std::size_t triangleStride, std::size_t cornerOffset,
+                                                  ThreadPool& pool)
+    {
+        WeldedPositions out;
+        const std::size_t corners = triangleCount * 3;
+
+        // closed meshes have about corners / 6 unique positions; size for corners / 4 and
+        // only fall back to a table for every corner if the input is closer to a soup
+        if (!tryWeld(data, triangleCount, triangleStride, cornerOffset, corners / 4 + 64, pool, out))
+            tryWeld(data, triangleCount, triangleStride, cornerOffset, corners + 64, pool, out);
+        return out;
+    }
+
+    // --- normals -------------------------------------------------------------
+
+    std::vector<glm::vec3> MeshProcessing::ComputeSmoothNormals(const glm::vec3* positions, std::size_t vertexCount,
+                                                                const std::vector<unsigned int>& indices, ThreadPool& pool)
+    {
+        std::vector<glm::vec3> normals(vertexCount, glm::vec3(0.0f));
+        const std::size_t triangleCount = indices.size() / 3;
+
+        // faces are spread over all workers; shared vertices are rare collisions, so relaxed atomics stay cheap
+        pool.ParallelFor(blockCount(triangleCount, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(triangleCount, (b + 1) * kTriangleBlock);
+            for (std::size_t t = b * kTriangleBlock; t < end; ++t)
+            {
+                const unsigned int i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+                if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+                    continue;
+                const glm::vec3 n = glm::cross(positions[i1] - positions[i0], positions[i2] - positions[i0]);
+                for (unsigned int v : { i0, i1, i2 })
+                    for (int c = 0; c < 3; ++c)
+                        std::atomic_ref<float>(normals[v][c]).fetch_add(n[c], std::memory_order_relaxed);
+            }
+        });
+
+        pool.ParallelFor(blockCount(vertexCount, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(vertexCount, (b + 1) * kTriangleBlock);
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+            {
+                const float len = glm::length(normals[v]);
+                normals[v] = len > 0.0f ? normals[v] / len : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        });
+        return normals;
+    }
+
+    // --- mesh assembly -------------------------------------------------------
+
+    std::vector<MeshData> MeshProcessing::BuildMeshes(const std::string& name,
+                                                      const glm::vec3* positions, const glm::vec3* normals,
+                                                      const glm::vec2* texCoords, std::size_t vertexCount,
+                                                      std::vector<unsigned int>&& indices, ThreadPool& pool,
+                                                      std::size_t maxVertices)
+    {
+        auto fillVertex = [&](Vertex& dst, std::size_t src)
+        {
+            dst.Position = positions[src];
+            if (normals)
+                dst.Normal = normals[src];
+            if (texCoords)
+                dst.TexCoords = texCoords[src];
+        };
+
+        std::vector<MeshData> out;
+        if (vertexCount <= maxVertices)
+        {
+            out.resize(1);
+            MeshData& mesh = out[0];
+            mesh.Name = name;
+            mesh.Vertices.resize(vertexCount);
+            pool.ParallelFor(blockCount(vertexCount, kTriangleBlock), [&](std::size_t b)
+            {
+                const std::size_t end = std::min(vertexCount, (b + 1) * kTriangleBlock);
+                for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+                    fillVertex(mesh.Vertices[v], v);
+            });
+            mesh.Indices = std::move(indices);
+            return out;
+        }
+
+        // consecutive triangle blocks small enough that even unshared corners fit
+        const std::vector<unsigned int> source = std::move(indices);
+        const std::size_t trianglesPerPart = std::max<std::size_t>(1, maxVertices / 3);
+        const std::size_t triangleCount    = source.size() / 3;
+        out.resize(blockCount(triangleCount, trianglesPerPart));
+
+        pool.ParallelFor(out.size(), [&](std::size_t p)
+        {
+            const std::size_t begin = p * trianglesPerPart * 3;
+            const std::size_t end   = std::min(source.size(), (p + 1) * trianglesPerPart * 3);
+
+            // compact the referenced vertices: sorted unique ids, then binary search for the new index
+            ArenaScope scope; // the arena of whichever thread runs this part
+            std::pmr::vector<unsigned int> used(source.begin() + begin, source.begin() + end, ScratchArena::Get());
+            std::sort(used.begin(), used.end());
+            used.erase(std::unique(used.begin(), used.end()), used.end());
+
+            MeshData& mesh = out[p];
+            mesh.Name = name + "_" + std::to_string(p);
+            mesh.Vertices.resize(used.size());
+            for (std::size_t v = 0; v < used.size(); ++v)
+                fillVertex(mesh.Vertices[v], used[v]);
+
+            mesh.Indices.resize(end - begin);
+            for (std::size_t i = begin; i < end; ++i)
+                mesh.Indices[i - begin] = static_cast<unsigned int>(std::lower_bound(used.begin(), used.end(), source[i]) - used.begin());
+        });
+        return out;
+    }
+
+    std::vector<MeshData> MeshProcessing::SplitMesh(MeshData&& mesh, std::size_t maxVertices)
+    {
+        std::vector<MeshData> out;
+        maxVertices = std::max<std::size_t>(3, maxVertices);
+        if (mesh.Vertices.size() <= maxVertices)
+        {
+            out.push_back(std::move(mesh));
+            return out;
+        }
+
+        // slot[v] is v's index in the current part, valid while owner[v] is the current part's number
+        constexpr std::uint32_t kNone = ~0u;
+        ArenaScope scope;
+        std::pmr::vector<std::uint32_t> owner(mesh.Vertices.size(), kNone, ScratchArena::Get());
+        std::pmr::vector<std::uint32_t> slot(mesh.Vertices.size(), 0u, ScratchArena::Get());
+
+        MeshData* part = nullptr;
+        auto startPart = [&]()
+        {
+            part = &out.emplace_back();
+            part->Name          = mesh.Name + "_" + std::to_string(out.size() - 1);
+            part->MaterialIndex = mesh.MaterialIndex;
+            part->Stats         = mesh.Stats;
+        };
+        startPart();
+
+        const std::size_t triangleCount = mesh.Indices.size() / 3;
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            const unsigned int* corners = &mesh.Indices[t * 3];
+            const std::uint32_t current = static_cast<std::uint32_t>(out.size() - 1);
+            // distinct corners the part doesn't have yet (degenerate triangles repeat one)
+            std::size_t added = 0;
+            for (int c = 0; c < 3; ++c)
+            {
+                const bool repeated = (c > 0 && corners[c] == corners[0]) || (c > 1 && corners[c] == corners[1]);
+                added += owner[corners[c]] != current && !repeated;
+            }
+            if (part->Vertices.size() + added > maxVertices)
+                startPart();
+
+            const std::uint32_t number = static_cast<std::uint32_t>(out.size() - 1);
+            for (int c = 0; c < 3; ++c)
+            {
+                const unsigned int v = corners[c];
+                if (owner[v] != number)
+                {
+                    owner[v] = number;
+                    slot[v]  = static_cast<std::uint32_t>(part->Vertices.size());
+                    part->Vertices.push_back(mesh.Vertices[v]);
+                }
+                part->Indices.push_back(slot[v]);
+            }
+        }
+        mesh = MeshData{};
+        return out;
+    }
+
+    bool MeshProcessing::NarrowIndices(const unsigned int* indices, std::size_t count, std::size_t vertexCount,
+                                       std::vector<std::uint16_t>& out)
+    {
+        if (count == 0 || vertexCount > kMaxShortIndexVertices)
+            return false;
+        out.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = static_cast<std::uint16_t>(indices[i]);
+        return true;
+    }
+
+    std::vector<LodRange> MeshProcessing::ConcatenateLevels(const std::vector<unsigned int>& indices, const std::vector<MeshLod>& lods,
+                                                            std::vector<unsigned int>& out)
+    {
+        std::vector<LodRange> levels;
+        if (indices.empty())
+            return levels;
+        levels.push_back({ 0, static_cast<unsigned int>(indices.size()), 0.0f });
+        if (lods.empty())
+            return levels;
+
+        std::size_t total = indices.size();
+        for (const MeshLod& lod : lods)
+            total += lod.Indices.size();
+        out.reserve(total);
+        out.insert(out.end(), indices.begin(), indices.end());
+        for (const MeshLod& lod : lods)
+        {
+            levels.push_back({ static_cast<unsigned int>(out.size()), static_cast<unsigned int>(lod.Indices.size()), lod.Error });
+            out.insert(out.end(), lod.Indices.begin(), lod.Indices.end());
+        }
+        return levels;
+    }
+
+    // --- MeshData post-processing --------------------------------------------
+
+    // For every element, the index of the first element equal to it. Each slot of the shared
+    // table holds the smallest index (+1) of one class seen so far, so the result does not
+    // depend on which thread got there first. Allocates in the caller's arena scope.
+    template <typename Hash, typename Equal>
+    static std::pmr::vector<std::uint32_t> firstOccurrences(std::size_t count, Hash&& hash, Equal&& equal, ThreadPool& pool)
+    {
+        std::size_t capacity = 64;
+        while (capacity < count * 2)
+            capacity <<= 1;
+        const std::size_t mask = capacity - 1;
+
+        std::pmr::vector<std::uint32_t> slots(capacity, 0u, ScratchArena::Get());
+        std::pmr::vector<std::uint32_t> slotOf(count, ScratchArena::Get());
+        pool.ParallelFor(blockCount(count, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            for (std::size_t e = b * kTriangleBlock; e < end; ++e)
+            {
+                const std::uint32_t mine = static_cast<std::uint32_t>(e) + 1;
+                std::size_t i = hash(e) & mask;
+                for (;;)
+                {
+                    std::atomic_ref<std::uint32_t> slot(slots[i]);
+                    std::uint32_t value = slot.load(std::memory_order_relaxed);
+                    if (value == 0 && slot.compare_exchange_strong(value, mine, std::memory_order_relaxed))
+                        break;
+                    // value is set now; the slot only ever moves to smaller members of the same class
+                    if (equal(value - 1, e))
+                    {
+                        while (mine < value && !slot.compare_exchange_weak(value, mine, std::memory_order_relaxed)) { }
+                        break;
+                    }
+                    i = (i + 1) & mask;
+                }
+                slotOf[e] = static_cast<std::uint32_t>(i);
+            }
+        });
+
+        // every insert has finished: read back each class's final representative
+        pool.ParallelFor(blockCount(count, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            for (std::size_t e = b * kTriangleBlock; e < end; ++e)
+                slotOf[e] = slots[slotOf[e]] - 1;
+        });
+        return slotOf;
+    }
+
+    static inline std::uint64_t hashPosition(const glm::vec3& p)
+    {
+        const std::uint32_t bits[3] = { floatBits(p.x), floatBits(p.y), floatBits(p.z) };
+        return hashPosition(bits);
+    }
+
+    // adds value to target from several threads at once
+    static inline void atomicAdd(glm::vec3& target, const glm::vec3& value)
+    {
+        for (int c = 0; c < 3; ++c)
+            std::atomic_ref<float>(target[c]).fetch_add(value[c], std::memory_order_relaxed);
+    }
+
+    // angle between two edges leaving the same corner
+    static inline float cornerAngle(const glm::vec3& a, const glm::vec3& b)
+    {
+        const float len = glm::length(a) * glm::length(b);
+        return len > 0.0f ? std::acos(std::clamp(glm::dot(a, b) / len, -1.0f, 1.0f)) : 0.0f;
+    }
+
+    std::size_t MeshProcessing::WeldVertices(MeshData& mesh, ThreadPool& pool)
+    {
+        const std::size_t count = mesh.Vertices.size();
+        if (count == 0)
+            return 0;
+        const Vertex* vertices = mesh.Vertices.data();
+
+        ArenaScope scope;
+        const std::pmr::vector<std::uint32_t> first = firstOccurrences(count,
+            [&](std::size_t v) { return HashBytes(&vertices[v], sizeof(Vertex)); },
+            [&](std::size_t a, std::size_t b) { return std::memcmp(&vertices[a], &vertices[b], sizeof(Vertex)) == 0; },
+            pool);
+
+        // new ids: a prefix sum over the first occurrences, block by block
+        const std::size_t blocks = blockCount(count, kTriangleBlock);
+        std::pmr::vector<std::size_t> blockStart(blocks + 1, 0, ScratchArena::Get());
+        pool.ParallelFor(blocks, [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            std::size_t unique = 0;
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+                unique += first[v] == v;
+            blockStart[b + 1] = unique;
+        });
+        for (std::size_t b = 0; b < blocks; ++b)
+            blockStart[b + 1] += blockStart[b];
+
+        const std::size_t unique = blockStart[blocks];
+        if (unique == count)
+            return 0;
+
+        std::pmr::vector<std::uint32_t> remap(count, ScratchArena::Get());
+        std::vector<Vertex> welded(unique);
+        pool.ParallelFor(blocks, [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            std::uint32_t next = static_cast<std::uint32_t>(blockStart[b]);
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+            {
+                if (first[v] != v)
+                    continue;
+                welded[next] = vertices[v];
+                remap[v] = next++;
+            }
+        });
+        // a duplicate's first occurrence is always earlier, so its id exists by now
+        pool.ParallelFor(blocks, [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+                remap[v] = remap[first[v]];
+        });
+
+        std::vector<unsigned int>& indices = mesh.Indices;
+        pool.ParallelFor(blockCount(indices.size(), kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(indices.size(), (b + 1) * kTriangleBlock);
+            for (std::size_t i = b * kTriangleBlock; i < end; ++i)
+                if (indices[i] < count)
+                    indices[i] = remap[indices[i]];
+        });
+
+        mesh.Vertices = std::move(welded);
+        return count - unique;
+    }
+
+    void MeshProcessing::GenerateNormals(MeshData& mesh, ThreadPool& pool)
+    {
+        const std::size_t count = mesh.Vertices.size();
+        if (count == 0)
+            return;
+        Vertex* vertices = mesh.Vertices.data();
+
+        // accumulate per position, so corners split by other attributes still share one normal
+        ArenaScope scope;
+        const std::pmr::vector<std::uint32_t> group = firstOccurrences(count,
+            [&](std::size_t v) { return hashPosition(vertices[v].Position); },
+            [&](std::size_t a, std::size_t b) { return vertices[a].Position == vertices[b].Position; },
+            pool);
+
+        std::pmr::vector<glm::vec3> sums(count, glm::vec3(0.0f), ScratchArena::Get());
+        const std::vector<unsigned int>& indices = mesh.Indices;
+        const std::size_t triangleCount = indices.size() / 3;
+        pool.ParallelFor(blockCount(triangleCount, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(triangleCount, (b + 1) * kTriangleBlock);
+            for (std::size_t t = b * kTriangleBlock; t < end; ++t)
+            {
+                const unsigned int i[3] = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+                if (i[0] >= count || i[1] >= count || i[2] >= count)
+                    continue;
+                const glm::vec3& p0 = vertices[i[0]].Position;
+                const glm::vec3& p1 = vertices[i[1]].Position;
+                const glm::vec3& p2 = vertices[i[2]].Position;
+
+                glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+                const float len = glm::length(n);
+                if (len == 0.0f)
+                    continue;
+                n /= len;
+
+                const float angle[3] = {
+                    cornerAngle(p1 - p0, p2 - p0),
+                    cornerAngle(p2 - p1, p0 - p1),
+                    cornerAngle(p0 - p2, p1 - p2),
+                };
+                for (int k = 0; k < 3; ++k)
+                    atomicAdd(sums[group[i[k]]], n * angle[k]);
+            }
+        });
+
+        pool.ParallelFor(blockCount(count, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+            {
+                const glm::vec3& sum = sums[group[v]];
+                const float len = glm::length(sum);
+                vertices[v].Normal = len > 0.0f ? sum / len : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        });
+    }
+
+    void MeshProcessing::GenerateTangents(MeshData& mesh, ThreadPool& pool)
+    {
+        const std::size_t count = mesh.Vertices.size();
+        if (count == 0)
+            return;
+        Vertex* vertices = mesh.Vertices.data();
+
+        // corners with equal position, normal and UV share a tangent frame, welded or not
+        static constexpr std::size_t kKeySize = offsetof(Vertex, Tangent);
+        ArenaScope scope;
+        const std::pmr::vector<std::uint32_t> group = firstOccurrences(count,
+            [&](std::size_t v) { return HashBytes(&vertices[v], kKeySize); },
+            [&](std::size_t a, std::size_t b) { return std::memcmp(&vertices[a], &vertices[b], kKeySize) == 0; },
+            pool);
+
+        std::pmr::vector<glm::vec3> tangents(count, glm::vec3(0.0f), ScratchArena::Get());
+        std::pmr::vector<glm::vec3> bitangents(count, glm::vec3(0.0f), ScratchArena::Get());
+        const std::vector<unsigned int>& indices = mesh.Indices;
+        const std::size_t triangleCount = indices.size() / 3;
+        pool.ParallelFor(blockCount(triangleCount, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(triangleCount, (b + 1) * kTriangleBlock);
+            for (std::size_t t = b * kTriangleBlock; t < end; ++t)
+            {
+                const unsigned int i[3] = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+                if (i[0] >= count || i[1] >= count || i[2] >= count)
+                    continue;
+                const Vertex& v0 = vertices[i[0]];
+                const Vertex& v1 = vertices[i[1]];
+                const Vertex& v2 = vertices[i[2]];
+
+                const glm::vec3 e1 = v1.Position - v0.Position, e2 = v2.Position - v0.Position;
+                const glm::vec2 d1 = v1.TexCoords - v0.TexCoords, d2 = v2.TexCoords - v0.TexCoords;
+                const float det = d1.x * d2.y - d2.x * d1.y;
+                if (std::abs(det) < 1e-20f)
+                    continue; // no UV area: leaves the frame to the other triangles
+
+                const glm::vec3 sdir = (e1 * d2.y - e2 * d1.y) / det;
+                const glm::vec3 tdir = (e2 * d1.x - e1 * d2.x) / det;
+
+                const float angle[3] = {
+                    cornerAngle(v1.Position - v0.Position, v2.Position - v0.Position),
+                    cornerAngle(v2.Position - v1.Position, v0.Position - v1.Position),
+                    cornerAngle(v0.Position - v2.Position, v1.Position - v2.Position),
+                };
+                for (int k = 0; k < 3; ++k)
+                {
+                    // projected onto each corner's tangent plane before averaging, like MikkTSpace
+                    const glm::vec3& n = vertices[i[k]].Normal;
+                    glm::vec3 tangent = sdir - n * glm::dot(n, sdir);
+                    const float len = glm::length(tangent);
+                    if (len == 0.0f)
+                        continue;
+                    atomicAdd(tangents[group[i[k]]], tangent * (angle[k] / len));
+                    atomicAdd(bitangents[group[i[k]]], tdir * angle[k]);
+                }
+            }
+        });
+
+        pool.ParallelFor(blockCount(count, kTriangleBlock), [&](std::size_t b)
+        {
+            const std::size_t end = std::min(count, (b + 1) * kTriangleBlock);
+            for (std::size_t v = b * kTriangleBlock; v < end; ++v)
+            {
+                const glm::vec3& n = vertices[v].Normal;
+                glm::vec3 tangent = tangents[group[v]];
+                tangent -= n * glm::dot(n, tangent);
+                float len = glm::length(tangent);
+                if (len == 0.0f)
+                {
+                    // no usable UVs around this vertex: any frame perpendicular to the normal
+                    tangent = std::abs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                    tangent -= n * glm::dot(n, tangent);
+                    len = glm::length(tangent);
+                }
+                tangent /= len;
+
+                const glm::vec3 bitangent = glm::cross(n, tangent);
+                const float sign = glm::dot(bitangent, bitangents[group[v]]) < 0.0f ? -1.0f : 1.0f;
+                vertices[v].Tangent   = tangent;
+                vertices[v].Bitangent = bitangent * sign;
+            }
+        });
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file MeshProcessing.h
+ * @brief Parallel geometry building blocks shared by the native importers.
+ * Everything here works on plain CPU arrays and a ThreadPool, makes no GL calls and is
+ * safe to run on import worker threads. Designed for very large scanned meshes
+ * (hundreds of millions of corners): no per-corner allocations, no global locks.
+ *
+ * The MeshData stages (WeldVertices, GenerateNormals, GenerateTangents) replace Assimp's
+ * single-threaded JoinIdenticalVertices, GenSmoothNormals and CalcTangentSpace steps;
+ * PostProcessOptions picks per import which implementation runs each of them.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include "Graphics/CpuGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    /// @brief Unique positions and the triangle list that references them.
+    struct WeldedPositions
+    {
+        /// @brief VertexCount unique positions (left uninitialized past VertexCount).
+        std::unique_ptr<glm::vec3[]> Positions;
+        std::size_t                  VertexCount { 0 };
+        /// @brief One index per input corner.
+        std::vector<unsigned int>    Indices;
+    };
+
+    /// @brief Who runs one geometry post-processing stage of an import.
+    enum class PostProcessMode : unsigned int
+    {
+        Assimp = 0,
+        Engine,
+        Off,
+    };
+
+    /// @brief Gets a display name for a post-processing mode.
+    /// @param mode The mode.
+    /// @return The display name of the mode.
+    inline const char* PostProcessModeName(PostProcessMode mode)
+    {
+        switch (mode)
+        {
+            case PostProcessMode::Assimp: return "Assimp";
+            case PostProcessMode::Engine: return "Engine";
+            case PostProcessMode::Off:    return "Off";
+        }
+        return "Unknown";
+    }
+
+    /// @brief Per-import choice of implementation for each post-processing stage.
+    struct PostProcessOptions
+    {
+        /// @brief Replaces aiProcess_JoinIdenticalVertices.
+        PostProcessMode Weld     { PostProcessMode::Engine };
+        /// @brief Replaces aiProcess_GenSmoothNormals; only meshes without normals are affected.
+        PostProcessMode Normals  { PostProcessMode::Engine };
+        /// @brief Replaces aiProcess_CalcTangentSpace; only meshes with UVs and without tangents are affected.
+        PostProcessMode Tangents { PostProcessMode::Engine };
+        /// @brief Replaces aiProcess_ImproveCacheLocality with MeshOptimizer (cache, overdraw and fetch order).
+        /// Applies to every importer whose meshes go through MeshData, not just Assimp.
+        PostProcessMode Optimize { PostProcessMode::Engine };
+        /// @brief Merges small meshes that share a material and are placed once (see StaticBatcher).
+        /// The batches are stored in the mesh cache, so this is part of Pack().
+        bool            Batch    { true };
+        /// @brief Uploads octahedral normals and half-float UVs (see VertexFormat); tangents and
+        /// bone data are dropped from meshes that don't use them either way. The mesh cache stores
+        /// vertices packed for upload, so this is part of Pack().
+        bool            Quantize { true };
+        /// @brief Splits meshes over kMaxShortIndexVertices vertices so every part takes 16-bit indices
+        /// (meshes under it always do). Adds draw calls, so off by default. Runs before the LOD chains
+        /// are built and cached, so it is part of Pack().
+        bool            SplitForShortIndices { false };
+        /// @brief Builds coarser levels of detail of large meshes (see MeshSimplifier); they only cost
+        /// index buffers. The levels are stored in the mesh cache (a derived entry for glTF, STL and
+        /// PLY), so this is part of Pack(). glTF primitives uploaded straight from the file
+        /// (MeshStreams) get none.
+        bool            Lods { true };
+        /// @brief Clusters large meshes into meshlets that are culled on the CPU every frame (see
+        /// MeshletBuilder and ClusterCuller). The meshlets are stored in the mesh cache (a derived
+        /// entry for glTF, STL and PLY, whose static batches are clustered again on every load), so
+        /// this is part of Pack(). glTF primitives uploaded straight from the file (MeshStreams) get none.
+        bool            Meshlets { true };
+        /// @brief Bakes an impostor of the model once it is uploaded, drawn instead of the meshes while
+        /// the model is small on screen (see Impostor); models that are one draw call are skipped.
+        /// Not part of Pack().
+        bool            Impostors { true };
+        /// @brief What each mesh keeps on the CPU after upload; only positions and indices are read
+        /// afterwards (picking), so that is the default. Not part of Pack().
+        CpuResidency    Residency { CpuResidency::Picking };
+
+        /// @brief Packs the options into one word for cache keys; 0 when every stage runs in Assimp
+        /// and the engine-only stages are off.
+        /// @return The packed options.
+        unsigned int Pack() const
+        {
+            return static_cast<unsigned int>(Weld)
+                 | static_cast<unsigned int>(Normals)  << 2
+                 | static_cast<unsigned int>(Tangents) << 4
+                 | static_cast<unsigned int>(Optimize) << 6
+                 | static_cast<unsigned int>(SplitForShortIndices) << 8
+                 | static_cast<unsigned int>(Lods) << 9
+                 | static_cast<unsigned int>(Meshlets) << 10
+                 | static_cast<unsigned int>(Batch) << 11
+                 | static_cast<unsigned int>(Quantize) << 12;
+        }
+    };
+
+    class MeshProcessing
+    {
+    public:
+        /// @brief Largest vertex count of one Mesh built by BuildMeshes; keeps every VBO well below 4 GB.
+        static constexpr std::size_t kMaxMeshVertices = std::size_t(1) << 24;
+
+        /// @brief Largest vertex count whose indices fit in 16 bits.
+        static constexpr std::size_t kMaxShortIndexVertices = std::size_t(1) << 16;
+
+        /// @brief Merges bit-identical positions of a triangle soup with a lock-free hash table
+        /// shared by all workers. Corner order is preserved, so Indices[i] belongs to corner i.
+        /// Triangle t's three corners are consecutive float[3] at data + t * triangleStride + cornerOffset.
+        /// @param data The first byte of the triangle records.
+        /// @param triangleCount The number of triangles.
+        /// @param triangleStride Bytes from one triangle record to the next.
+        /// @param cornerOffset Byte offset of the first corner inside a triangle record.
+        /// @param pool The pool to weld on.
+        /// @return The welded positions and indices.
+        static WeldedPositions WeldPositions(const unsigned char* data, std::size_t triangleCount,
+                                             std::size_t triangleStride, std::size_t cornerOffset,
+                                             ThreadPool& pool);
+
+        /// @brief Computes area-weighted smooth vertex normals.
+        /// @param positions The vertex positions.
+        /// @param vertexCount The number of vertices.
+        /// @param indices The triangle list.
+        /// @param pool The pool to accumulate on.
+        /// @return One unit normal per vertex (+Y for vertices without any area around them).
+        static std::vector<glm::vec3> ComputeSmoothNormals(const glm::vec3* positions, std::size_t vertexCount,
+                                                           const std::vector<unsigned int>& indices, ThreadPool& pool);
+
+        /// @brief Builds MeshData from separate attribute arrays. Meshes with more than
+        /// maxVertices vertices are split into consecutive triangle blocks, each with its own
+        /// compacted vertex array.
+        /// @param name The name of the mesh; split parts get a _N suffix.
+        /// @param positions The vertex positions.
+        /// @param normals The vertex normals, or nullptr.
+        /// @param texCoords The vertex UVs, or nullptr.
+        /// @param vertexCount The number of vertices.
+        /// @param indices The triangle list; moved into the result when no split is needed.
+        /// @param pool The pool to fill vertices on.
+        /// @param maxVertices The largest vertex count of one part.
+        /// @return One or more meshes.
+        static std::vector<MeshData> BuildMeshes(const std::string& name,
+                                                 const glm::vec3* positions, const glm::vec3* normals,
+                                                 const glm::vec2* texCoords, std::size_t vertexCount,
+                                                 std::vector<unsigned int>&& indices, ThreadPool& pool,
+                                                 std::size_t maxVertices = kMaxMeshVertices);
+
+        /// @brief Splits a mesh into parts of at most maxVertices vertices, so each can use 16-bit
+        /// indices. Triangles keep their order and are taken greedily, so a part ends only when the
+        /// next triangle would bring in one vertex too many; each part's vertices are in first-use
+        /// order, which keeps the vertex fetch order MeshOptimizer chose.
+        /// @param mesh The mesh; moved into the single result when no split is needed.
+        /// @param maxVertices The largest vertex count of one part (at least 3).
+        /// @return One or more meshes; split parts get a _N suffix and the source's material and stats.
+        static std::vector<MeshData> SplitMesh(MeshData&& mesh, std::size_t maxVertices = kMaxShortIndexVertices);
+
+        /// @brief Copies 32-bit indices into 16-bit ones, if every index fits.
+        /// @param indices The indices.
+        /// @param count The number of indices.
+        /// @param vertexCount The number of vertices they index; nothing is copied above kMaxShortIndexVertices.
+        /// @param out Receives the narrowed indices.
+        /// @return False if the indices need 32 bits, or there are none.
+        static bool NarrowIndices(const unsigned int* indices, std::size_t count, std::size_t vertexCount,
+                                  std::vector<std::uint16_t>& out);
+
+        /// @brief Puts a mesh's coarser levels after its full triangle list, the index buffer it uploads with.
+        /// @param indices The full triangle list.
+        /// @param lods The coarser levels.
+        /// @param out Receives the concatenated indices; left empty without levels, as indices is then the whole buffer.
+        /// @return Where each level sits, level 0 first; empty when there are no indices.
+        static std::vector<LodRange> ConcatenateLevels(const std::vector<unsigned int>& indices, const std::vector<MeshLod>& lods,
+                                                       std::vector<unsigned int>& out);
+
+        /// @brief Merges bit-identical vertices (every attribute equal) and remaps the indices.
+        /// Vertices keep the order of their first occurrence, whatever the thread count.
+        /// @param mesh The mesh to weld in place.
+        /// @param pool The pool to weld on.
+        /// @return The number of vertices removed.
+        static std::size_t WeldVertices(MeshData& mesh, ThreadPool& pool);
+
+        /// @brief Replaces the normals with angle-weighted smooth normals. Vertices at the same
+        /// position share one normal even when they are not welded (split by UV seams, for example).
+        /// @param mesh The mesh to update in place.
+        /// @param pool The pool to accumulate on.
+        static void GenerateNormals(MeshData& mesh, ThreadPool& pool);
+
+        /// @brief Computes per-vertex tangents and bitangents from the UVs, following the
+        /// MikkTSpace conventions: per-corner tangents projected onto the normal plane and weighted
+        /// by corner angle, shared by corners with equal position, normal and UV, and
+        /// bitangent = sign * cross(normal, tangent).
+        /// @param mesh The mesh to update in place; normals and UVs must be set.
+        /// @param pool The pool to accumulate on.
+        static void GenerateTangents(MeshData& mesh, ThreadPool& pool);
+
+    private:
+        MeshProcessing() = delete;
+    };
+}
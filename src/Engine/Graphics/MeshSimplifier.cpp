@@ -0,0 +1,327 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "Utility/Arena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+namespace isaacObjectViewer
+{
+    // Sum of squared distances to a set of planes: e(p) = p.A.p + 2 b.p + c, A symmetric
+    struct Quadric
+    {
+        double A00 = 0, A01 = 0, A02 = 0, A11 = 0, A12 = 0, A22 = 0;
+        double B0 = 0, B1 = 0, B2 = 0, C = 0;
+
+        void AddPlane(const glm::dvec3& n, double d)
+        {
+            A00 += n.x * n.x; A01 += n.x * n.y; A02 += n.x * n.z;
+            A11 += n.y * n.y; A12 += n.y * n.z; A22 += n.z * n.z;
+            B0 += d * n.x; B1 += d * n.y; B2 += d * n.z;
+            C += d * d;
+        }
+
+        Quadric& operator+=(const Quadric& o)
+        {
+            A00 += o.A00; A01 += o.A01; A02 += o.A02; A11 += o.A11; A12 += o.A12; A22 += o.A22;
+            B0 += o.B0; B1 += o.B1; B2 += o.B2; C += o.C;
+            return *this;
+        }
+
+        double Error(const glm::vec3& p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            const double e = A00 * x * x + A11 * y * y + A22 * z * z
+                           + 2.0 * (A01 * x * y + A02 * x * z + A12 * y * z)
+                           + 2.0 * (B0 * x + B1 * y + B2 * z) + C;
+            return e > 0.0 ? e : 0.0;
+        }
+    };
+
+    static std::uint64_t hashKey(std::uint64_t k)
+    {
+        k ^= k >> 33; k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ull;
+        return k ^ (k >> 33);
+    }
+
+    static std::size_t tableSize(std::size_t count)
+    {
+        std::size_t size = 16;
+        while (size < count * 2)
+            size <<= 1;
+        return size;
+    }
+
+    // vertices at bit-identical positions share a class: the first vertex seen there
+    static void positionClasses(const Vertex* vertices, std::size_t vertexCount, std::pmr::vector<unsigned int>& classes)
+    {
+        const std::size_t size = tableSize(vertexCount);
+        std::pmr::vector<unsigned int> table(size, ~0u, ScratchArena::Get());
+        for (std::size_t v = 0; v < vertexCount; ++v)
+        {
+            std::uint32_t bits[3];
+            std::memcpy(bits, &vertices[v].Position, sizeof(bits));
+            std::size_t slot = hashKey((std::uint64_t(bits[0]) << 32 | bits[1]) ^ hashKey(bits[2])) & (size - 1);
+            for (;; slot = (slot + 1) & (size - 1))
+            {
+                if (table[slot] == ~0u)
+                {
+                    table[slot] = static_cast<unsigned int>(v);
+                    classes[v]  = static_cast<unsigned int>(v);
+                    break;
+                }
+                if (std::memcmp(&vertices[table[slot]].Position, bits, sizeof(bits)) == 0)
+                {
+                    classes[v] = table[slot];
+                    break;
+                }
+            }
+        }
+    }
+
+    // open addressing set of directed class edges
+    class EdgeSet
+    {
+    public:
+        explicit EdgeSet(std::size_t count) : m_Keys(tableSize(count), kEmpty, ScratchArena::Get()) { }
+
+        void Insert(unsigned int a, unsigned int b)
+        {
+            const std::uint64_t key = std::uint64_t(a) << 32 | b;
+            std::size_t slot = Find(key);
+            m_Keys[slot] = key;
+        }
+
+        bool Contains(unsigned int a, unsigned int b) const
+        {
+            const std::uint64_t key = std::uint64_t(a) << 32 | b;
+            return m_Keys[Find(key)] == key;
+        }
+
+    private:
+        static constexpr std::uint64_t kEmpty = ~std::uint64_t(0);
+
+        std::size_t Find(std::uint64_t key) const
+        {
+            const std::size_t mask = m_Keys.size() - 1;
+            std::size_t slot = hashKey(key) & mask;
+            while (m_Keys[slot] != kEmpty && m_Keys[slot] != key)
+                slot = (slot + 1) & mask;
+            return slot;
+        }
+
+        std::pmr::vector<std::uint64_t> m_Keys;
+    };
+
+    std::vector<unsigned int> MeshSimplifier::Simplify(const Vertex* vertices, std::size_t vertexCount,
+                                                       const unsigned int* indices, std::size_t indexCount,
+                                                       std::size_t targetIndexCount, float maxError, float* outError)
+    {
+        std::vector<unsigned int> result(indices, indices + indexCount / 3 * 3);
+        if (outError)
+            *outError = 0.0f;
+        if (result.size() <= targetIndexCount || vertexCount == 0 || maxError <= 0.0f
+            || !std::all_of(result.begin(), result.end(), [vertexCount](unsigned int i) { return i < vertexCount; }))
+            return result;
+
+        ArenaScope scope;
+        std::pmr::memory_resource* arena = ScratchArena::Get();
+
+        std::pmr::vector<unsigned int> classes(vertexCount, 0, arena);
+        positionClasses(vertices, vertexCount, classes);
+
+        // seams: a class with more than one vertex would tear if one of them moved alone
+        std::pmr::vector<unsigned int> classSize(vertexCount, 0, arena);
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            ++classSize[classes[v]];
+        std::pmr::vector<unsigned char> lockedClass(vertexCount, 0, arena);
+        for (std::size_t v = 0; v < vertexCount; ++v)
+            if (classSize[classes[v]] > 1)
+                lockedClass[classes[v]] = 1;
+
+        // open borders: an edge nobody walks the other way
+        {
+            ArenaScope edgeScope;
+            EdgeSet edges(result.size());
+            for (std::size_t i = 0; i < result.size(); i += 3)
+                for (int e = 0; e < 3; ++e)
+                    edges.Insert(classes[result[i + e]], classes[result[i + (e + 1) % 3]]);
+            for (std::size_t i = 0; i < result.size(); i += 3)
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int a = classes[result[i + e]], b = classes[result[i + (e + 1) % 3]];
+                    if (!edges.Contains(b, a))
+                        lockedClass[a] = lockedClass[b] = 1;
+                }
+        }
+
+        // one quadric per position, from the planes of the triangles around it
+        std::pmr::vector<Quadric> quadrics(vertexCount, Quadric{}, arena);
+        for (std::size_t i = 0; i < result.size(); i += 3)
+        {
+            const glm::dvec3 p0(vertices[result[i]].Position);
+            const glm::dvec3 normal = glm::cross(glm::dvec3(vertices[result[i + 1]].Position) - p0,
+                                                 glm::dvec3(vertices[result[i + 2]].Position) - p0);
+            const double length = glm::length(normal);
+            if (length == 0.0)
+                continue;
+            const glm::dvec3 n = normal / length;
+            const double d = -glm::dot(n, p0);
+            for (int c = 0; c < 3; ++c)
+                quadrics[classes[result[i + c]]].AddPlane(n, d);
+        }
+
+        struct Collapse
+        {
+            float        Cost;
+            unsigned int From;
+            unsigned int To;
+        };
+
+        const double maxCost = double(maxError) * double(maxError);
+        double worstCost = 0.0;
+        while (result.size() > targetIndexCount)
+        {
+            ArenaScope passScope;
+
+            // vertex -> triangles
+            std::pmr::vector<unsigned int> firstTriangle(vertexCount + 1, 0, arena);
+            std::pmr::vector<unsigned int> triangles(result.size(), 0, arena);
+            for (unsigned int index : result)
+                ++firstTriangle[index + 1];
+            std::partial_sum(firstTriangle.begin(), firstTriangle.end(), firstTriangle.begin());
+            {
+                std::pmr::vector<unsigned int> cursor(firstTriangle.begin(), firstTriangle.end() - 1, arena);
+                for (std::size_t i = 0; i < result.size(); ++i)
+                    triangles[cursor[result[i]]++] = static_cast<unsigned int>(i / 3);
+            }
+
+            std::pmr::vector<Collapse> collapses(arena);
+            collapses.reserve(result.size());
+            auto consider = [&](unsigned int from, unsigned int to)
+            {
+                if (lockedClass[classes[from]])
+                    return;
+                Quadric q = quadrics[classes[from]];
+                q += quadrics[classes[to]];
+                const double cost = q.Error(vertices[to].Position);
+                if (cost <= maxCost)
+                    collapses.push_back({ static_cast<float>(cost), from, to });
+            };
+            // each directed edge once: the triangle across an inner edge walks it the other way
+            for (std::size_t i = 0; i < result.size(); i += 3)
+                for (int e = 0; e < 3; ++e)
+                {
+                    const unsigned int a = result[i + e], b = result[i + (e + 1) % 3];
+                    if (classes[a] != classes[b])
+                        consider(a, b);
+                }
+            if (collapses.empty())
+                break;
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& l, const Collapse& r) { return l.Cost < r.Cost; });
+
+            // moving from onto to must not turn any of from's remaining triangles over
+            auto flips = [&](unsigned int from, unsigned int to)
+            {
+                const glm::vec3& target = vertices[to].Position;
+                for (unsigned int k = firstTriangle[from]; k < firstTriangle[from + 1]; ++k)
+                {
+                    const unsigned int* t = &result[std::size_t(triangles[k]) * 3];
+                    if (classes[t[0]] == classes[to] || classes[t[1]] == classes[to] || classes[t[2]] == classes[to])
+                        continue;
+                    glm::vec3 p[3] = { vertices[t[0]].Position, vertices[t[1]].Position, vertices[t[2]].Position };
+                    const glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    for (int c = 0; c < 3; ++c)
+                        if (t[c] == from)
+                            p[c] = target;
+                    const glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    if (glm::dot(before, after) <= 1e-2f * glm::length(before) * glm::length(after))
+                        return true;
+                }
+                return false;
+            };
+
+            // an independent set: nothing around a collapse moves again this pass, so the checks stay valid
+            std::pmr::vector<unsigned char> touched(vertexCount, 0, arena);
+            std::pmr::vector<unsigned int> remap(vertexCount, 0, arena);
+            std::iota(remap.begin(), remap.end(), 0u);
+            const std::size_t budget = (result.size() - targetIndexCount) / 6 + 1;
+            std::size_t done = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (touched[collapse.From] || touched[collapse.To] || flips(collapse.From, collapse.To))
+                    continue;
+                remap[collapse.From] = collapse.To;
+                quadrics[classes[collapse.To]] += quadrics[classes[collapse.From]];
+                worstCost = std::max(worstCost, double(collapse.Cost));
+                touched[collapse.From] = touched[collapse.To] = 1;
+                for (unsigned int k = firstTriangle[collapse.From]; k < firstTriangle[collapse.From + 1]; ++k)
+                    for (int c = 0; c < 3; ++c)
+                        touched[result[std::size_t(triangles[k]) * 3 + c]] = 1;
+                if (++done >= budget)
+                    break;
+            }
+            if (done == 0)
+                break;
+
+            std::size_t write = 0;
+            for (std::size_t i = 0; i < result.size(); i += 3)
+            {
+                const unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+                if (classes[a] == classes[b] || classes[b] == classes[c] || classes[a] == classes[c])
+                    continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (outError)
+            *outError = static_cast<float>(std::sqrt(worstCost));
+        return result;
+    }
+
+    std::vector<MeshLod> MeshSimplifier::BuildLodChain(const MeshData& mesh)
+    {
+        std::vector<MeshLod> lods;
+        if (mesh.Vertices.empty() || mesh.Indices.size() / 3 < 2 * kMinLodTriangles)
+            return lods;
+
+        glm::vec3 bboxMin = mesh.Vertices[0].Position, bboxMax = bboxMin;
+        for (const Vertex& v : mesh.Vertices)
+        {
+            bboxMin = glm::min(bboxMin, v.Position);
+            bboxMax = glm::max(bboxMax, v.Position);
+        }
+        const float limit = glm::length(bboxMax - bboxMin) * kMaxLodError;
+        if (!(limit > 0.0f))
+            return lods;
+
+        // each level simplifies the one before, so errors add up along the chain
+        lods.reserve(kMaxLodLevels);
+        const std::vector<unsigned int>* previous = &mesh.Indices;
+        float previousError = 0.0f;
+        while (lods.size() < kMaxLodLevels && previousError < limit)
+        {
+            const std::size_t triangles = previous->size() / 3;
+            if (triangles / 2 < kMinLodTriangles)
+                break;
+            float error = 0.0f;
+            std::vector<unsigned int> indices = Simplify(mesh.Vertices.data(), mesh.Vertices.size(), previous->data(), previous->size(),
+                                                         triangles / 2 * 3, limit - previousError, &error);
+            // not worth an index range if the error bound stopped it early
+            if (indices.size() > previous->size() * 3 / 4)
+                break;
+            MeshOptimizer::OptimizeVertexCache(indices.data(), indices.size(), mesh.Vertices.size());
+            previousError += error;
+            lods.push_back({ std::move(indices), previousError });
+            previous = &lods.back().Indices;
+        }
+        return lods;
+    }
+}
@@ -0,0 +1,55 @@
+/**
+ * @file MeshSimplifier.h
+ * @brief Builds coarser levels of detail of a mesh by quadric error edge collapse (Garland and
+ * Heckbert). A collapse moves one vertex onto a neighbour, so every level indexes the mesh's own
+ * vertex array and only costs an index buffer. Vertices on open borders and attribute seams
+ * (several vertices at one position) never move, which keeps outlines and UV seams intact.
+ *
+ * Each pass collapses an independent set of the cheapest edges, skipping collapses that would
+ * flip a triangle, until the target triangle count or the error bound is reached. Like
+ * MeshOptimizer every call is sequential; ModelManager runs meshes in parallel.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include <cstddef>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class MeshSimplifier
+    {
+    public:
+        /// @brief Most coarser levels built per mesh.
+        static constexpr std::size_t kMaxLodLevels = 4;
+
+        /// @brief Meshes with fewer triangles get no levels, and no level goes below it.
+        static constexpr std::size_t kMinLodTriangles = 1024;
+
+        /// @brief Largest error of any level, as a fraction of the mesh's bounding box diagonal.
+        static constexpr float kMaxLodError = 0.02f;
+
+        /// @brief Simplifies a triangle list without moving or adding vertices.
+        /// @param vertices The vertices the indices refer to.
+        /// @param vertexCount The number of vertices.
+        /// @param indices The triangle list.
+        /// @param indexCount The number of indices.
+        /// @param targetIndexCount Stop once the list has at most this many indices.
+        /// @param maxError Largest error a collapse may have, in the mesh's units.
+        /// @param outError Receives the largest error of a collapse made, or nullptr.
+        /// @return The simplified triangle list.
+        static std::vector<unsigned int> Simplify(const Vertex* vertices, std::size_t vertexCount,
+                                                  const unsigned int* indices, std::size_t indexCount,
+                                                  std::size_t targetIndexCount, float maxError, float* outError = nullptr);
+
+        /// @brief Builds the LOD chain of a mesh: each level about half the triangles of the one before,
+        /// cache-optimized, until kMinLodTriangles, kMaxLodLevels or kMaxLodError stops it.
+        /// @param mesh The mesh; its own indices are level 0.
+        /// @return The coarser levels, finest first, each with its estimated error in the mesh's units.
+        static std::vector<MeshLod> BuildLodChain(const MeshData& mesh);
+
+    private:
+        MeshSimplifier() = delete;
+    };
+}
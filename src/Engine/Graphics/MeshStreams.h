@@ -0,0 +1,76 @@
+/**
+ * @file MeshStreams.h
+ * @brief Header file for the MeshStreams struct.
+ * Describes a mesh whose vertex and index data already sit in memory in a layout the GPU
+ * can consume (typically a memory-mapped glTF buffer). Nothing is copied on the CPU:
+ * the byte ranges are uploaded as-is and the attributes are pointed at them with their
+ * original stride and component type. Like MeshData it owns no GL objects.
+ */
+
+#pragma once
+
+#include "Utility/config.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief A contiguous block of source bytes that becomes part of the vertex buffer.
+    struct StreamRange
+    {
+        const unsigned char* Data { nullptr };
+        std::size_t          Size { 0 };
+    };
+
+    /// @brief One vertex attribute inside a StreamRange.
+    struct VertexStream
+    {
+        static constexpr std::uint32_t kAbsent = ~0u;
+
+        /// @brief Index into MeshStreams::Ranges, or kAbsent if the mesh has no such attribute.
+        std::uint32_t Range         { kAbsent };
+        /// @brief Byte offset of the first element from the start of the range.
+        std::size_t   Offset        { 0 };
+        /// @brief Byte distance between consecutive elements.
+        std::uint32_t Stride        { 0 };
+        /// @brief GL component type (GL_FLOAT, GL_UNSIGNED_SHORT, ...).
+        std::uint32_t ComponentType { GL_FLOAT };
+        std::int32_t  Components    { 0 };
+        bool          Normalized    { false };
+
+        bool IsPresent() const { return Range != kAbsent; }
+    };
+
+    struct MeshStreams
+    {
+        /// @brief The name of the source mesh.
+        std::string               Name;
+        /// @brief Index of the source material in the imported scene.
+        unsigned int              MaterialIndex { 0 };
+        std::size_t               VertexCount   { 0 };
+
+        /// @brief Source byte ranges, packed back to back into one vertex buffer on upload.
+        std::vector<StreamRange>  Ranges;
+        /// @brief The attributes the shaders read, at locations 0, 1 and 2.
+        VertexStream              Position;
+        VertexStream              Normal;
+        VertexStream              TexCoord;
+
+        /// @brief Triangle list indices in source memory (unused when OwnedIndices is set).
+        const void*               Indices    { nullptr };
+        std::uint32_t             IndexCount { 0 };
+        /// @brief GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+        std::uint32_t             IndexType  { GL_UNSIGNED_INT };
+        /// @brief Indices the importer had to build itself (widened, generated or re-triangulated).
+        std::vector<unsigned char> OwnedIndices;
+
+        glm::vec3                 BBoxMin { 0.0f };
+        glm::vec3                 BBoxMax { 0.0f };
+
+        /// @brief Gets the index bytes to upload.
+        /// @return OwnedIndices when set, the source indices otherwise.
+        const void* IndexData() const { return OwnedIndices.empty() ? Indices : OwnedIndices.data(); }
+    };
+}
@@ -0,0 +1,108 @@
+#include "MeshletBuilder.h"
+#include "Utility/Arena.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace isaacObjectViewer
+{
+    std::vector<Meshlet> MeshletBuilder::Build(const Vertex* vertices, std::size_t vertexCount,
+                                               const unsigned int* indices, std::size_t indexCount)
+    {
+        std::vector<Meshlet> meshlets;
+        const std::size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0
+            || !std::all_of(indices, indices + triangleCount * 3, [vertexCount](unsigned int i) { return i < vertexCount; }))
+            return meshlets;
+
+        ArenaScope scope;
+        // the meshlet that last referenced each vertex: counts distinct vertices without clearing a set
+        std::pmr::vector<unsigned int> usedBy(vertexCount, ~0u, ScratchArena::Get());
+        std::pmr::vector<glm::vec3> normals(ScratchArena::Get());
+        normals.reserve(kMaxTriangles);
+        meshlets.reserve(triangleCount / (kMaxTriangles / 2) + 1);
+
+        std::size_t first = 0, meshletVertices = 0;
+        glm::vec3 normalSum(0.0f);
+        auto finish = [&](std::size_t end)
+        {
+            Meshlet meshlet;
+            meshlet.FirstIndex = static_cast<unsigned int>(first * 3);
+            meshlet.IndexCount = static_cast<unsigned int>((end - first) * 3);
+
+            glm::vec3 lo = vertices[indices[first * 3]].Position, hi = lo;
+            for (std::size_t i = first * 3; i < end * 3; ++i)
+            {
+                lo = glm::min(lo, vertices[indices[i]].Position);
+                hi = glm::max(hi, vertices[indices[i]].Position);
+            }
+            meshlet.Center = 0.5f * (lo + hi);
+            float radius2 = 0.0f;
+            for (std::size_t i = first * 3; i < end * 3; ++i)
+            {
+                const glm::vec3 d = vertices[indices[i]].Position - meshlet.Center;
+                radius2 = std::max(radius2, glm::dot(d, d));
+            }
+            meshlet.Radius = std::sqrt(radius2);
+
+            // the cone holds every normal; a spread near 90 degrees can never face away, so leave it open
+            const float sumLength = glm::length(normalSum);
+            if (sumLength > 0.0f)
+            {
+                meshlet.ConeAxis = normalSum / sumLength;
+                float minDot = 1.0f;
+                for (const glm::vec3& n : normals)
+                    if (n != glm::vec3(0.0f))
+                        minDot = std::min(minDot, glm::dot(meshlet.ConeAxis, n));
+                if (minDot > 0.1f)
+                    meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+            }
+            meshlets.push_back(meshlet);
+
+            first = end;
+            meshletVertices = 0;
+            normalSum = glm::vec3(0.0f);
+            normals.clear();
+        };
+
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            const unsigned int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+            const glm::vec3 p0 = vertices[a].Position;
+            const glm::vec3 n = glm::cross(vertices[b].Position - p0, vertices[c].Position - p0);
+            const float length = glm::length(n);
+            const glm::vec3 unit = length > 0.0f ? n / length : glm::vec3(0.0f);
+
+            auto fresh = [&]()
+            {
+                const unsigned int id = static_cast<unsigned int>(meshlets.size());
+                return std::size_t(usedBy[a] != id) + std::size_t(usedBy[b] != id && b != a)
+                     + std::size_t(usedBy[c] != id && c != a && c != b);
+            };
+            std::size_t added = fresh();
+            const std::size_t triangles = t - first;
+            const float sumLength = glm::length(normalSum);
+            const bool turns = length > 0.0f && sumLength > 0.0f && glm::dot(unit, normalSum / sumLength) < kMinNormalAgreement;
+            if (triangles > 0 && (triangles == kMaxTriangles || meshletVertices + added > kMaxVertices || turns))
+            {
+                finish(t);
+                added = fresh();
+            }
+
+            const unsigned int id = static_cast<unsigned int>(meshlets.size());
+            usedBy[a] = usedBy[b] = usedBy[c] = id;
+            meshletVertices += added;
+            normalSum += unit;
+            normals.push_back(unit);
+        }
+        finish(triangleCount);
+        return meshlets;
+    }
+
+    std::vector<Meshlet> MeshletBuilder::Build(const MeshData& mesh)
+    {
+        if (mesh.Indices.size() / 3 < kMinMeshTriangles)
+            return {};
+        return Build(mesh.Vertices.data(), mesh.Vertices.size(), mesh.Indices.data(), mesh.Indices.size());
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * @file MeshletBuilder.h
+ * @brief Splits a mesh's triangle list into meshlets: runs of at most kMaxVertices vertices and
+ * kMaxTriangles triangles, each with a bounding sphere and a normal cone. ClusterCuller tests
+ * them every frame so only the runs that can be visible are drawn.
+ *
+ * Clusters are cut from the triangle order as it is, without reordering: after MeshOptimizer the
+ * order already follows the surface, so consecutive triangles are neighbours, and each meshlet
+ * stays a plain range of the index buffer that glMultiDrawElements can draw. A run also ends
+ * where the surface turns sharply, which keeps the cones tight enough to cull.
+ */
+
+#pragma once
+
+#include "Graphics/MeshData.h"
+#include <cstddef>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class MeshletBuilder
+    {
+    public:
+        /// @brief Most vertices referenced by one meshlet.
+        static constexpr std::size_t kMaxVertices = 64;
+
+        /// @brief Most triangles in one meshlet.
+        static constexpr std::size_t kMaxTriangles = 124;
+
+        /// @brief Meshes with fewer triangles are drawn whole; culling them would cost more than it saves.
+        static constexpr std::size_t kMinMeshTriangles = 8192;
+
+        /// @brief Smallest cosine between a triangle's normal and its meshlet's average normal.
+        static constexpr float kMinNormalAgreement = 0.25f;
+
+        /// @brief Clusters a triangle list.
+        /// @param vertices The vertices the indices refer to.
+        /// @param vertexCount The number of vertices.
+        /// @param indices The triangle list.
+        /// @param indexCount The number of indices.
+        /// @return Meshlets covering the list in order; empty if an index is out of range.
+        static std::vector<Meshlet> Build(const Vertex* vertices, std::size_t vertexCount,
+                                          const unsigned int* indices, std::size_t indexCount);
+
+        /// @brief Clusters a mesh's own triangle list, if it is large enough to be worth culling.
+        /// @param mesh The mesh.
+        /// @return The meshlets, or none under kMinMeshTriangles.
+        static std::vector<Meshlet> Build(const MeshData& mesh);
+
+    private:
+        MeshletBuilder() = delete;
+    };
+}
@@ -1,4 +1,6 @@
 #include "Model.h"
+#include "Impostor.h"
+#include "ImpostorSelector.h"
 
 namespace isaacObjectViewer
 {
@@ -18,6 +20,29 @@ namespace isaacObjectViewer
         , m_Meshes(meshes)
     {}
 
+    Model::Model(std::vector<Mesh>&& meshes, const std::string& name)
+        : m_ID(++s_NextModelID)
+        , m_Name(name)
+        , m_FileType(ModelFileType::Unknown)
+        , m_Position(DEFAULT_POSITION)
+        , m_Rotation(DEFAULT_ROTATION)
+        , m_Orientation(glm::quat(glm::radians(DEFAULT_ROTATION)))
+        , m_Scale(DEFAULT_SCALE)
+        , m_Color(DEFAULT_COLOR)
+        , m_UseMaterial(true)
+        , m_Shininess(32.0f)
+        , m_Meshes(std::move(meshes))
+    {}
+
+    Model* Model::Duplicate() const
+    {
+        // Mesh copies share their geometry and instance buffers; each only creates a vertex array
+        Model* copy  = new Model(*this);
+        copy->m_ID   = ++s_NextModelID;
+        copy->m_Name = m_Name + " (copy)";
+        return copy;
+    }
+
     void Model::SetDiffuseTexture(const std::shared_ptr<Texture>& tex)
     {
         for (auto& m : m_Meshes) 
@@ -30,25 +55,135 @@ namespace isaacObjectViewer
             m.SetSpecularTexture(tex);
     }
 
+    void Model::SetNodes(std::vector<SceneNode> nodes)
+    {
+        m_Nodes = std::move(nodes);
+        if (m_Nodes.empty())
+        {
+            for (auto& mesh : m_Meshes)
+                mesh.SetInstanceTransforms({});
+            return;
+        }
+
+        std::vector<std::vector<glm::mat4>> instances = CollectInstances(m_Nodes, m_Meshes.size());
+        for (std::size_t i = 0; i < m_Meshes.size(); ++i)
+            m_Meshes[i].SetInstanceTransforms(std::move(instances[i]));
+    }
+
     void Model::Render(const Renderer& renderer,
                    const glm::mat4& view,
                    const glm::mat4& projection,
                    Shader* shader)
     {
-        const glm::mat4 parentModel = GetModelMatrix();
+        // drawn by RenderImpostor instead
+        if (m_DrawImpostor)
+            return;
+        RenderMeshes(renderer, GetModelMatrix(), view, projection, shader, false);
+    }
+
+    void Model::RenderForBake(const Renderer& renderer, const glm::mat4& view, const glm::mat4& projection, Shader* shader)
+    {
+        RenderMeshes(renderer, glm::mat4(1.0f), view, projection, shader, true);
+    }
+
+    void Model::RenderMeshes(const Renderer& renderer, const glm::mat4& parentModel, const glm::mat4& view,
+                             const glm::mat4& projection, Shader* shader, bool fullDetail)
+    {
         for (auto& mesh : m_Meshes)
         {
+            // with a node tree, meshes no node places are not drawn
+            if (!m_Nodes.empty() && mesh.GetInstanceTransforms().empty())
+                continue;
             if (!m_UseMaterial)
             {
                 mesh.SetColor(m_Color);
             }
             mesh.RenderWithParent(renderer, parentModel, view, projection, shader, 
-                                    m_UseMaterial, m_Color);
+                                    m_UseMaterial, m_Color, fullDetail);
+        }
+    }
+
+    void Model::SetImpostorKey(std::uint64_t key)
+    {
+        m_ImpostorKey = key;
+        m_Impostor.reset();
+        m_ImpostorBake = key != 0 ? std::make_shared<ImpostorBakeJob>(m_Name, key) : nullptr;
+    }
+
+    bool Model::BakeImpostor(const Renderer& renderer, Shader& bakeShader, float budgetMs)
+    {
+        if (!m_ImpostorBake)
+            return false;
+        // a duplicate may have finished the shared job already
+        const bool pending = !m_ImpostorBake->IsDone();
+        if (pending)
+            m_ImpostorBake->Step(*this, renderer, bakeShader, budgetMs);
+        m_Impostor = m_ImpostorBake->GetImpostor();
+        if (m_ImpostorBake->IsDone())
+            m_ImpostorBake.reset();
+        return pending;
+    }
+
+    bool Model::UpdateImpostor()
+    {
+        if (!m_Impostor)
+        {
+            m_DrawImpostor = false;
+            return false;
+        }
+
+        const glm::mat4 M = GetModelMatrix();
+        const float scale = std::max({ glm::length(glm::vec3(M[0])), glm::length(glm::vec3(M[1])), glm::length(glm::vec3(M[2])) });
+        const glm::vec3 center(M * glm::vec4(m_Impostor->GetCenter(), 1.0f));
+        m_DrawImpostor = ImpostorSelector::UseImpostor(center, m_Impostor->GetRadius() * scale, m_DrawImpostor);
+
+        std::size_t triangles = 0;
+        if (m_DrawImpostor)
+        {
+            for (const Mesh& mesh : m_Meshes)
+                triangles += std::size_t(mesh.GetIndexCount() / 3) * std::max<std::size_t>(mesh.GetInstanceTransforms().size(), 1);
+        }
+        ImpostorSelector::RecordModel(m_DrawImpostor, triangles);
+        return m_DrawImpostor;
+    }
+
+    void Model::RenderImpostor(const glm::vec3& camera, const glm::mat4& view, const glm::mat4& projection, Shader* shader)
+    {
+        if (!m_Impostor || !shader)
+            return;
+        shader->Bind();
+        shader->setFloat("shininess", m_Shininess);
+        m_Impostor->Draw(GetModelMatrix(), camera, view, projection, *shader);
+    }
+
+
+    void Model::AddClusterJobs(const glm::mat4& viewProjection, const glm::vec3& camera, std::vector<ClusterCullJob>& jobs)
+    {
+        const glm::mat4 parentModel = GetModelMatrix();
+        for (auto& mesh : m_Meshes)
+        {
+            if (!m_Nodes.empty() && mesh.GetInstanceTransforms().empty())
+                continue;
+            mesh.AddClusterJob(parentModel, viewProjection, camera, jobs);
         }
     }
 
+    // world-space box around a transformed box: its eight transformed corners
+    static void placedBox(const glm::mat4& transform, const glm::vec3& lo, const glm::vec3& hi,
+                          glm::vec3& outMin, glm::vec3& outMax)
+    {
+        outMin = glm::vec3( std::numeric_limits<float>::max());
+        outMax = glm::vec3(-std::numeric_limits<float>::max());
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const glm::vec3 p((corner & 1) ? hi.x : lo.x, (corner & 2) ? hi.y : lo.y, (corner & 4) ? hi.z : lo.z);
+            const glm::vec3 placed(transform * glm::vec4(p, 1.0f));
+            outMin = glm::min(outMin, placed);
+            outMax = glm::max(outMax, placed);
+        }
+    }
 
-    /* Very coarse: test ray vs model AABB first */
+    /* The model AABB first, then the triangles (or part boxes) of its meshes */
     bool Model::IntersectRay(const Ray& ray, float* outDist)
     {
         RecomputeBoundingBox();                    // cheap enough
@@ -56,10 +191,52 @@ namespace isaacObjectViewer
         if (!RayIntersectsAABB(ray, m_BBoxMin, m_BBoxMax, &hitDist))
             return false;
 
-        /* Optional: iterate meshes for finer test here */
+        // nearest triangle where the mesh kept its positions, else the nearest part box
+        // (the source meshes of a static batch count on their own)
+        const glm::mat4 M = GetModelMatrix();
+        static const std::vector<glm::mat4> kOnce { glm::mat4(1.0f) };
+        float nearest = std::numeric_limits<float>::max();
+        auto testBox = [&](const glm::mat4& transform, const glm::vec3& lo, const glm::vec3& hi)
+        {
+            glm::vec3 boxMin, boxMax;
+            placedBox(transform, lo, hi, boxMin, boxMax);
+            float dist;
+            if (RayIntersectsAABB(ray, boxMin, boxMax, &dist))
+                nearest = std::min(nearest, dist);
+        };
+        for (const Mesh& mesh : m_Meshes)
+        {
+            const std::vector<glm::mat4>& placements = mesh.GetInstanceTransforms().empty() && m_Nodes.empty()
+                                                     ? kOnce : mesh.GetInstanceTransforms();
+            const CpuGeometry& cpu = mesh.GetGeometry()->GetCpu();
+            for (const glm::mat4& placement : placements)
+            {
+                if (cpu.HasTriangles())
+                {
+                    glm::vec3 boxMin, boxMax;
+                    placedBox(M * placement, mesh.GetBBoxMin(), mesh.GetBBoxMax(), boxMin, boxMax);
+                    float dist;
+                    if (!RayIntersectsAABB(ray, boxMin, boxMax, &dist) || dist > nearest)
+                        continue;
+                    // an affine map keeps the ray parameter, so t is the world distance along the unit direction
+                    const glm::mat4 toMesh = glm::inverse(M * placement);
+                    float t;
+                    if (cpu.IntersectRay(glm::vec3(toMesh * glm::vec4(ray.GetOrigin(), 1.0f)),
+                                         glm::vec3(toMesh * glm::vec4(ray.GetDirection(), 0.0f)), &t))
+                        nearest = std::min(nearest, t);
+                    continue;
+                }
+                if (mesh.GetParts().empty())
+                    testBox(M * placement, mesh.GetBBoxMin(), mesh.GetBBoxMax());
+                for (const MeshPart& part : mesh.GetParts())
+                    testBox(M * placement, part.BBoxMin, part.BBoxMax);
+            }
+        }
+        if (nearest == std::numeric_limits<float>::max())
+            return false;
 
         if (outDist) 
-            *outDist = hitDist;
+            *outDist = std::max(hitDist, nearest);
 
         return true;
     }
@@ -69,20 +246,47 @@ namespace isaacObjectViewer
         if (m_Meshes.empty()) 
             return;
             
-        m_BBoxMin =  glm::vec3( std::numeric_limits<float>::max());
-        m_BBoxMax = -glm::vec3( std::numeric_limits<float>::max());
-
-        for (const auto& mesh : m_Meshes)
-        {
-            m_BBoxMin = glm::min(m_BBoxMin, mesh.GetBBoxMin());
-            m_BBoxMax = glm::max(m_BBoxMax, mesh.GetBBoxMax());
-        }
+        if (!GetLocalBounds(m_BBoxMin, m_BBoxMax))
+            return;
 
         glm::mat4 M = GetModelMatrix();
         m_BBoxMin = glm::vec3(M * glm::vec4(m_BBoxMin, 1.0));
         m_BBoxMax = glm::vec3(M * glm::vec4(m_BBoxMax, 1.0));
     }
 
+    bool Model::GetLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const
+    {
+        outMin =  glm::vec3( std::numeric_limits<float>::max());
+        outMax = -glm::vec3( std::numeric_limits<float>::max());
+
+        for (const auto& mesh : m_Meshes)
+        {
+            if (mesh.GetInstanceTransforms().empty())
+            {
+                if (m_Nodes.empty())
+                {
+                    outMin = glm::min(outMin, mesh.GetBBoxMin());
+                    outMax = glm::max(outMax, mesh.GetBBoxMax());
+                }
+                continue;
+            }
+
+            // the box of every placed copy: its eight transformed corners
+            const glm::vec3 lo = mesh.GetBBoxMin(), hi = mesh.GetBBoxMax();
+            for (const glm::mat4& transform : mesh.GetInstanceTransforms())
+            {
+                for (int corner = 0; corner < 8; ++corner)
+                {
+                    const glm::vec3 p((corner & 1) ? hi.x : lo.x, (corner & 2) ? hi.y : lo.y, (corner & 4) ? hi.z : lo.z);
+                    const glm::vec3 placed(transform * glm::vec4(p, 1.0f));
+                    outMin = glm::min(outMin, placed);
+                    outMax = glm::max(outMax, placed);
+                }
+            }
+        }
+        return outMin.x <= outMax.x;
+    }
+
     /* ---------------------------------------------------------- */
     std::size_t Model::GenerateUniqueID()
     {
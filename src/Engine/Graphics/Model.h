@@ -8,14 +8,18 @@
 #pragma once
 #include "Utility/config.h"
 
+#include "Graphics/ImportProfile.h"
 #include "Graphics/Ray.h"
 #include "Graphics/Mesh.h"          
+#include "Graphics/SceneNode.h"
 #include "Graphics/Renderer/Renderer.h"
 #include "Graphics/Shader/Shader.h"
 #include "IObject.h"
 
 namespace isaacObjectViewer
 {
+    class Impostor;
+    class ImpostorBakeJob;
 
     /// @brief Enumeration for different model file types.
     enum class ModelFileType
@@ -33,6 +37,11 @@ namespace isaacObjectViewer
         /// @param name The name of the model.
         explicit Model(const std::vector<Mesh>& meshes, const std::string& name);
 
+        /// @brief Constructs a Model object, taking over already uploaded meshes.
+        /// @param meshes The meshes that make up the model.
+        /// @param name The name of the model.
+        explicit Model(std::vector<Mesh>&& meshes, const std::string& name);
+
         
         /// @brief Gets the ID of the model.
         /// @return The ID of the model.
@@ -124,6 +133,56 @@ namespace isaacObjectViewer
                     const glm::mat4& projection,
                     Shader* shader) override;
 
+        /// @brief Draws every mesh at full detail in the model's own space, without its position,
+        /// rotation and scale (impostor bakes).
+        /// @param renderer The renderer to use.
+        /// @param view The view matrix.
+        /// @param projection The projection matrix.
+        /// @param shader The shader to use.
+        void RenderForBake(const Renderer& renderer, const glm::mat4& view, const glm::mat4& projection, Shader* shader);
+
+        /// @brief Sets what the model's impostor is cached under, and queues its bake; 0 means the
+        /// model gets no impostor.
+        /// @param key The content hash (ImportedScene::ImpostorKey).
+        void SetImpostorKey(std::uint64_t key);
+
+        /// @brief Advances the model's impostor bake, if one is queued: reads it from the impostor
+        /// cache or renders some of its views (see ImpostorBakeJob::Step). GL thread only; the
+        /// meshes must be uploaded.
+        /// @param renderer The renderer to bake with.
+        /// @param bakeShader The main shader.
+        /// @param budgetMs Time the call may take.
+        /// @return True if bake work was done.
+        bool BakeImpostor(const Renderer& renderer, Shader& bakeShader, float budgetMs);
+
+        /// @brief Decides if the model is drawn as its impostor this frame; call after
+        /// LodSelector::BeginFrame and before Render, which then skips the meshes.
+        /// @return True if RenderImpostor should draw it instead.
+        bool UpdateImpostor();
+
+        /// @brief Draws the model's impostor.
+        /// @param camera The camera position, in world space.
+        /// @param view The view matrix.
+        /// @param projection The projection matrix.
+        /// @param shader The impostor shader.
+        void RenderImpostor(const glm::vec3& camera, const glm::mat4& view, const glm::mat4& projection, Shader* shader);
+
+        /// @brief Gets the model's impostor.
+        /// @return The impostor, shared with duplicates; nullptr if it has none.
+        const Impostor* GetImpostor() const { return m_Impostor.get(); }
+
+        /// @brief Gets the box around the placed meshes, in the model's own space.
+        /// @param outMin Receives the minimum corner.
+        /// @param outMax Receives the maximum corner.
+        /// @return False if no mesh is placed.
+        bool GetLocalBounds(glm::vec3& outMin, glm::vec3& outMax) const;
+
+        /// @brief Adds the meshes to this frame's cluster culling (see Mesh::AddClusterJob); call before Render.
+        /// @param viewProjection projection * view.
+        /// @param camera The camera position, in world space.
+        /// @param jobs The frame's jobs.
+        void AddClusterJobs(const glm::mat4& viewProjection, const glm::vec3& camera, std::vector<ClusterCullJob>& jobs);
+
         /// @brief Gets the vertex array of the model.
         /// @return The vertex array of the model.
         const VertexArray&  GetVertexArray () const override { return *m_Meshes.front().GetVertexArray(); }
@@ -150,10 +209,34 @@ namespace isaacObjectViewer
         /// @return True if the ray intersects the model, false otherwise.
         bool IntersectRay(const Ray& ray, float* outDist) override;
 
+        /// @brief Creates a copy of the model that draws the same GPU geometry; nothing is uploaded.
+        /// @return The copy, with a new ID and the same transform, materials and nodes. The caller owns it.
+        Model* Duplicate() const;
+
+        /// @brief Gets the meshes of the model.
+        /// @return The meshes of the model.
+        const std::vector<Mesh>& GetMeshes() const { return m_Meshes; }
+
         /// @brief Adds a mesh to the model.
         /// @param mesh The mesh to add.
         void AddMesh(Mesh&& mesh) { m_Meshes.emplace_back(std::move(mesh)); }
 
+        /// @brief Sets the transform tree that places the meshes, and instances each mesh at its nodes.
+        /// @param nodes The nodes, parents first, referring to meshes by index. Empty draws every mesh once.
+        void SetNodes(std::vector<SceneNode> nodes);
+
+        /// @brief Gets the transform tree of the model.
+        /// @return The nodes, parents first; empty when the model has none.
+        const std::vector<SceneNode>& GetNodes() const { return m_Nodes; }
+
+        /// @brief Sets the profile of the import that created the model.
+        /// @param profile The import profile.
+        void SetImportProfile(ImportProfile profile) { m_ImportProfile = std::move(profile); }
+
+        /// @brief Gets the profile of the import that created the model.
+        /// @return The import profile; empty for models not created by ModelManager.
+        const ImportProfile& GetImportProfile() const { return m_ImportProfile; }
+
         /// @brief Generates a unique ID for the model.
         /// @return The unique ID for the model.
         std::size_t GenerateUniqueID() override;                 // (kept for completeness)
@@ -172,6 +255,14 @@ namespace isaacObjectViewer
         float               m_Shininess;
         
         std::vector<Mesh>   m_Meshes;
+        std::vector<SceneNode> m_Nodes;
+        ImportProfile       m_ImportProfile;
+
+        std::uint64_t       m_ImpostorKey  { 0 };
+        std::shared_ptr<const Impostor> m_Impostor;
+        /// @brief The bake still in progress, shared with duplicates.
+        std::shared_ptr<ImpostorBakeJob> m_ImpostorBake;
+        bool                m_DrawImpostor { false };
 
         /* Cached AABB for fast pick-testing */
         glm::vec3           m_BBoxMin {  std::numeric_limits<float>::max() };
@@ -179,5 +270,9 @@ namespace isaacObjectViewer
 
         /// @brief Recomputes the bounding box of the model.
         void RecomputeBoundingBox();
+
+        /// @brief Draws the placed meshes under a parent transform.
+        void RenderMeshes(const Renderer& renderer, const glm::mat4& parentModel, const glm::mat4& view,
+                          const glm::mat4& projection, Shader* shader, bool fullDetail);
     };
 }
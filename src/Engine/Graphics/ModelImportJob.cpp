@@ -0,0 +1,112 @@
+#include "ModelImportJob.h"
+#include "Model.h"
+#include "Utility/Log.hpp"
+#include <exception>
+#include <filesystem>
+
+namespace isaacObjectViewer
+{
+    ModelImportJob::ModelImportJob(const std::string &path, const PostProcessOptions& options)
+        : m_Path(path)
+        , m_Name(std::filesystem::path(path).stem().string())
+        , m_Options(options)
+    {
+        m_Worker = std::thread([this]()
+        {
+            // an exception escaping the thread would terminate the viewer; a broken file only fails its import
+            try
+            {
+                m_Result = ModelManager::ImportScene(m_Path, &m_Progress, m_Options);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Failed to import model {}: {}", m_Path, e.what());
+                m_Result.reset();
+                m_Progress.Enter(ImportStage::Failed);
+            }
+            m_WorkerDone.store(true);
+        });
+    }
+
+    ModelImportJob::~ModelImportJob()
+    {
+        Cancel();
+        JoinWorker();
+    }
+
+    void ModelImportJob::JoinWorker()
+    {
+        if (m_Worker.joinable())
+            m_Worker.join();
+    }
+
+    bool ModelImportJob::IsDone() const
+    {
+        const ImportStage stage = m_Progress.Stage.load();
+        return stage == ImportStage::Finished
+            || stage == ImportStage::Failed
+            || stage == ImportStage::Cancelled;
+    }
+
+    void ModelImportJob::UpdatePreview()
+    {
+        std::unique_ptr<ImportPreview> preview = m_Progress.TakePreview();
+        if (!preview || preview->Empty())
+            return;
+
+        // one small mesh of flat-shaded blocks; a few thousand boxes at most, so it uploads in well under a frame
+        MeshData data = ImportPreviewBuilder::BuildMesh(*preview);
+        std::vector<Mesh> meshes;
+        meshes.emplace_back(std::move(data.Vertices), std::move(data.Indices),
+                            std::vector<std::shared_ptr<Texture>>{}, Material{}, data.Name);
+        m_Preview = std::make_unique<Model>(std::move(meshes), m_Name + " (loading)");
+        m_Preview->SetUseMaterial(false);
+        m_Preview->SetColor(glm::vec3(0.55f));
+        if (preview->ZUp)
+            m_Preview->SetOrientation(glm::quat(glm::vec3(glm::radians(-90.0f), 0.0f, 0.0f)));
+    }
+
+    Model* ModelImportJob::Update(float budgetMs)
+    {
+        if (IsDone())
+        {
+            m_Preview.reset();
+            return nullptr;
+        }
+        UpdatePreview();
+        if (!m_WorkerDone.load())
+            return nullptr;
+
+        JoinWorker();
+
+        if (!m_Upload.Scene)
+        {
+            if (!m_Result)
+            {
+                // ImportScene already recorded Failed/Cancelled
+                if (!IsDone())
+                    m_Progress.Enter(ImportStage::Failed);
+                return nullptr;
+            }
+            m_Upload.Scene     = std::move(m_Result);
+            m_Upload.Residency = m_Options.Residency;
+        }
+
+        if (m_Progress.CancelRequested.load())
+        {
+            m_Upload = ModelUpload{};
+            m_Progress.Enter(ImportStage::Cancelled);
+            return nullptr;
+        }
+
+        if (!ModelManager::UploadStep(m_Upload, budgetMs, &m_Progress))
+            return nullptr;
+
+        // the proxy goes in the frame the Model arrives, so the model never blinks out
+        Model* model = ModelManager::FinishUpload(m_Upload);
+        m_Preview.reset();
+        m_Progress.Enter(ImportStage::Finished);
+        LOG_INFO("Imported model {}", m_Path);
+        return model;
+    }
+}
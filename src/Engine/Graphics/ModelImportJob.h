@@ -0,0 +1,85 @@
+/**
+ * @file ModelImportJob.h
+ * @brief One model import running in the background.
+ * The CPU half (ModelManager::ImportScene) runs on a dedicated thread; once it is done,
+ * Update uploads the result to GL in time-boxed steps on the GL thread and finally
+ * hands back the Model. Until then the job keeps a block proxy of the model (ImportPreview)
+ * that the viewer draws in its place.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include "Graphics/ModelManager.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace isaacObjectViewer
+{
+    class Model;
+
+    class ModelImportJob
+    {
+    public:
+        /// @brief Starts importing a model on a new thread.
+        /// @param path The path to the model file.
+        /// @param options Which implementation runs each post-processing stage.
+        ModelImportJob(const std::string& path, const PostProcessOptions& options = {});
+
+        /// @brief Cancels the import if it is still running and waits for the thread.
+        /// Must be destroyed on the GL thread, since partial uploads are freed here.
+        ~ModelImportJob();
+
+        /// @brief Gets the path of the model file.
+        /// @return The path of the model file.
+        const std::string&    GetPath()     const { return m_Path; }
+
+        /// @brief Gets the display name of the model.
+        /// @return The display name of the model.
+        const std::string&    GetName()     const { return m_Name; }
+
+        /// @brief Gets the progress of the import.
+        /// @return The progress of the import.
+        const ImportProgress& GetProgress() const { return m_Progress; }
+
+        /// @brief Checks if the import has finished, failed or been cancelled.
+        /// @return True if there is nothing left to do.
+        bool IsDone() const;
+
+        /// @brief Requests cancellation; takes effect at the next checkpoint.
+        void Cancel() { m_Progress.CancelRequested.store(true); }
+
+        /// @brief Advances the GL upload; must run on the GL thread.
+        /// @param budgetMs Time the upload may take this call, in milliseconds.
+        /// @return The finished Model once, then nullptr. The caller takes ownership.
+        Model* Update(float budgetMs);
+
+        /// @brief Gets the proxy to draw while the model is importing; dropped when the Model is handed back.
+        /// @return The proxy, or nullptr if none has been published yet.
+        Model* GetPreview() const { return m_Preview.get(); }
+
+    private:
+        ModelImportJob(const ModelImportJob&) = delete;
+        ModelImportJob& operator=(const ModelImportJob&) = delete;
+
+        void JoinWorker();
+        void UpdatePreview();
+
+    private:
+        std::string       m_Path;
+        std::string       m_Name;
+        PostProcessOptions m_Options;
+        ImportProgress    m_Progress;
+
+        std::thread       m_Worker;
+        std::atomic<bool> m_WorkerDone { false };
+        // written by the worker, only read after m_WorkerDone is set
+        std::unique_ptr<ImportedScene> m_Result;
+
+        ModelUpload       m_Upload;
+        // GL objects, created and destroyed on the GL thread
+        std::unique_ptr<Model> m_Preview;
+    };
+}
@@ -1,285 +1,1449 @@
 #include "ModelManager.h"
+#include "ModelImportJob.h"
 #include "Utility/Log.hpp"
+#include "Utility/MemoryStats.h"
+#include "Utility/Timer.h"
 #include "Mesh.h"
 #include "Model.h"
-#include "Core/Engine.h"
 #include "Graphics/TextureManager.h"
+#include "Graphics/MeshCache.h"
+#include "Graphics/TextureCache.h"
+#include "Graphics/MeshOptimizer.h"
+#include "Graphics/MeshSimplifier.h"
+#include "Graphics/MeshletBuilder.h"
+#include "Graphics/ObjLoader.h"
+#include "Graphics/GltfLoader.h"
+#include "Graphics/StlLoader.h"
+#include "Graphics/PlyLoader.h"
+#include "Graphics/StaticBatcher.h"
+#include "Graphics/ImportPreview.h"
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace isaacObjectViewer 
 {
     // --- tiny helpers --------------------------------------------------------
-    static std::shared_ptr<Texture> makeSolidTexture(unsigned char r, unsigned char g,
-                                                     unsigned char b, TextureType type)
+    static inline bool cancelRequested(const ImportProgress* progress)
     {
-        auto tex = std::make_shared<Texture>();
-        unsigned char px[4] = { r, g, b, 255 };
-        tex->Generate(1, 1, px, GL_RGBA, GL_RGBA, type);
-        return tex;
+        return progress && progress->CancelRequested.load();
     }
 
-    static inline unsigned char to8bit(float v)
+    // Times Assimp's post-processing steps. The progress handler hears of every step in the
+    // pipeline, active or not, just before it would run; the active ones announce themselves
+    // with a "<Step> begin" debug message. Together that is one timing per step that ran.
+    class AssimpStepTimer
     {
-        v = (v < 0.f) ? 0.f : (v > 1.f ? 1.f : v);
-        return static_cast<unsigned char>(v * 255.f + 0.5f);
+    public:
+        struct Step
+        {
+            std::string Name;
+            double      Milliseconds;
+        };
+
+        // a new pipeline slot starts; ends the previous step
+        void Next()
+        {
+            Close();
+            m_Timer.Start();
+            m_Open = true;
+        }
+
+        void OnDebugMessage(const char* message)
+        {
+            static constexpr std::string_view kBegin = " begin";
+            const std::string_view text(message);
+            if (m_Open && m_Name.empty() && text.size() > kBegin.size() && text.ends_with(kBegin))
+                m_Name = text.substr(0, text.size() - kBegin.size());
+        }
+
+        void Close()
+        {
+            if (m_Open && !m_Name.empty())
+                m_Steps.push_back({ std::move(m_Name), m_Timer.Stop() * 1000.0 });
+            m_Name.clear();
+            m_Open = false;
+        }
+
+        const std::vector<Step>& GetSteps() const { return m_Steps; }
+
+    private:
+        Timer             m_Timer;
+        std::string       m_Name;
+        bool              m_Open { false };
+        std::vector<Step> m_Steps;
+    };
+
+    // Assimp's logger is global; only the thread that is post-processing collects step names
+    static thread_local AssimpStepTimer* t_StepTimer = nullptr;
+
+    // Receives Assimp's log; debug messages name the post-processing steps, the rest is dropped
+    class AssimpStepLogger : public Assimp::Logger
+    {
+    public:
+        AssimpStepLogger() : Logger(Logger::DEBUGGING) { }
+
+        bool attachStream(Assimp::LogStream*, unsigned int) override { return false; }
+        bool detachStream(Assimp::LogStream*, unsigned int) override { return false; }
+
+    protected:
+        void OnDebug(const char* message) override
+        {
+            if (t_StepTimer)
+                t_StepTimer->OnDebugMessage(message);
+        }
+        void OnVerboseDebug(const char*) override { }
+        void OnInfo(const char*) override { }
+        void OnWarn(const char*) override { }
+        void OnError(const char*) override { }
+    };
+
+    // Forwards Assimp's read/post-process progress and lets the UI abort the parse
+    class AssimpProgress : public Assimp::ProgressHandler
+    {
+    public:
+        AssimpProgress(ImportProgress* progress, AssimpStepTimer* steps) : m_Progress(progress), m_Steps(steps) { }
+
+        bool Update(float percentage) override
+        {
+            if (percentage >= 0.0f)
+                m_Progress->Fraction.store(std::min(percentage, 1.0f));
+            return !m_Progress->CancelRequested.load();
+        }
+
+        void UpdatePostProcess(int currentStep, int numberOfSteps) override
+        {
+            m_Steps->Next();
+            ProgressHandler::UpdatePostProcess(currentStep, numberOfSteps);
+        }
+
+    private:
+        ImportProgress*  m_Progress;
+        AssimpStepTimer* m_Steps;
+    };
+
+    // Opens files like Assimp's default, and remembers which ones the importer read besides the
+    // model itself (OBJ material libraries, external glTF buffers), for the mesh cache to check
+    class DependencyRecorder : public Assimp::DefaultIOSystem
+    {
+    public:
+        explicit DependencyRecorder(std::string source) : m_Source(std::move(source)) { }
+
+        Assimp::IOStream* Open(const char* file, const char* mode) override
+        {
+            Assimp::IOStream* stream = DefaultIOSystem::Open(file, mode);
+            if (stream && !ComparePaths(file, m_Source.c_str()) &&
+                std::find(m_Opened.begin(), m_Opened.end(), file) == m_Opened.end())
+                m_Opened.emplace_back(file);
+            return stream;
+        }
+
+        const std::vector<std::string>& GetOpened() const { return m_Opened; }
+
+    private:
+        std::string              m_Source;
+        std::vector<std::string> m_Opened;
+    };
+
+    static const char* loaderName(ModelManager::ImportLoader loader)
+    {
+        switch (loader)
+        {
+            case ModelManager::ImportLoader::Assimp: return "Assimp";
+            case ModelManager::ImportLoader::Obj:    return "OBJ";
+            case ModelManager::ImportLoader::Gltf:   return "glTF";
+            case ModelManager::ImportLoader::Stl:    return "STL";
+            case ModelManager::ImportLoader::Ply:    return "PLY";
+        }
+        return "Unknown";
     }
 
-    std::string ModelManager::canonicalUnderBase(const std::filesystem::path& p) const
+    // draw calls the model makes: one per mesh a node places (instances share it), or per mesh without nodes
+    static std::size_t drawCount(const ImportedScene& scene)
     {
-        std::error_code ec;
-        auto full = (p.is_absolute() ? p : (m_BaseDir / p));
-        auto can  = std::filesystem::weakly_canonical(full, ec);
-        return (ec ? full : can).string();
+        const std::size_t meshes = scene.Meshes.size() + scene.StreamMeshes.size();
+        if (scene.Nodes.empty())
+            return meshes;
+        std::vector<bool> drawn(meshes, false);
+        for (const SceneNode& node : scene.Nodes)
+            for (unsigned int mesh : node.Meshes)
+                if (mesh < meshes)
+                    drawn[mesh] = true;
+        return static_cast<std::size_t>(std::count(drawn.begin(), drawn.end(), true));
     }
 
-    // Convert Assimp material → engine Material (textures or synthesized colors)
-    static Material toEngineMaterial(const aiMaterial* mat,
-                                     const std::filesystem::path& baseDir)
+    // bytes of what a derived cache entry keeps: the LOD chains' index arrays and the meshlets
+    static std::uint64_t derivedBytes(const ImportedScene& scene)
     {
-        Material out{};
-        float shininess = 32.0f;
-        mat->Get(AI_MATKEY_SHININESS, shininess);
-        out.Shininess = std::max(1.0f, std::min(shininess, 1000.0f) * 0.128f);
+        std::uint64_t bytes = 0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            for (const MeshLod& lod : mesh.Lods)
+                bytes += lod.Indices.size() * sizeof(unsigned int);
+            bytes += mesh.Meshlets.size() * sizeof(Meshlet);
+        }
+        return bytes;
+    }
 
-        aiColor3D kd(1.0f, 1.0f, 1.0f);
-        mat->Get(AI_MATKEY_COLOR_DIFFUSE, kd);
+    // bytes of converted geometry: the vertex and index arrays, or the mapped ranges packed meshes and streams point into
+    static std::uint64_t geometryBytes(const ImportedScene& scene)
+    {
+        std::uint64_t bytes = 0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            bytes += mesh.Vertices.size() * sizeof(Vertex) + mesh.Indices.size() * sizeof(unsigned int);
+            if (mesh.Packed.IsSet())
+                bytes += VertexPacker::PackedSize(mesh.Packed.VertexCount, mesh.Format)
+                       + mesh.Packed.IndexCount * (mesh.Packed.ShortIndices ? sizeof(std::uint16_t) : sizeof(unsigned int));
+            for (const MeshLod& lod : mesh.Lods)
+                bytes += lod.Indices.size() * sizeof(unsigned int);
+            bytes += mesh.Meshlets.size() * sizeof(Meshlet);
+        }
+        for (const MeshStreams& streams : scene.StreamMeshes)
+        {
+            for (const StreamRange& range : streams.Ranges)
+                bytes += range.Size;
+            bytes += streams.OwnedIndices.size();
+        }
+        return bytes;
+    }
+
+    // glTF and the scan formats are read straight from a mapping; a cache copy would only add disk traffic
+    static bool usesMeshCache(ModelManager::ImportLoader loader)
+    {
+        return loader != ModelManager::ImportLoader::Gltf
+            && loader != ModelManager::ImportLoader::Stl
+            && loader != ModelManager::ImportLoader::Ply;
+    }
+
+    // ------------------------------------------------------------------------
 
-        aiString texPath;
-        if (mat->GetTextureCount(aiTextureType_DIFFUSE) > 0 &&
-            mat->GetTexture(aiTextureType_DIFFUSE, 0, &texPath) == AI_SUCCESS)
+    ModelManager::ModelManager() = default;
+    ModelManager::~ModelManager() = default;
+
+    Model* ModelManager::LoadModel(const std::string &path, const PostProcessOptions& options)
+    {
+        ModelUpload upload;
+        upload.Residency = options.Residency;
+        upload.Scene = ImportScene(path, nullptr, options);
+        if (!upload.Scene)
+            return nullptr;
+
+        while (!UploadStep(upload, std::numeric_limits<float>::max()))
+            ;
+        return FinishUpload(upload);
+    }
+
+    void ModelManager::ImportModelAsync(const std::string &path, const PostProcessOptions& options)
+    {
+        m_ImportJobs.push_back(std::make_unique<ModelImportJob>(path, options));
+    }
+
+    std::vector<Model*> ModelManager::UpdateImports(float budgetMs)
+    {
+        std::vector<Model*> finished;
+        if (m_ImportJobs.empty())
+            return finished;
+
+        // the budget is shared, so one big import can't starve the frame when several are running
+        const float perJob = budgetMs / static_cast<float>(m_ImportJobs.size());
+        for (auto& job : m_ImportJobs)
         {
-            auto path = (baseDir / texPath.C_Str()).string();
-            out.Diffuse = TextureManager::LoadTexture(path, TextureType::DIFFUSE);
+            if (Model* model = job->Update(perJob))
+                finished.push_back(model);
         }
-        else
+
+        std::erase_if(m_ImportJobs, [](const std::unique_ptr<ModelImportJob>& job)
+        {
+            if (!job->IsDone())
+                return false;
+            if (job->GetProgress().Stage.load() == ImportStage::Cancelled)
+                LOG_INFO("Import of {} cancelled", job->GetPath());
+            return true;
+        });
+        return finished;
+    }
+
+    void ModelManager::CancelImports()
+    {
+        for (auto& job : m_ImportJobs)
+            job->Cancel();
+        // destroying a job joins its thread and frees anything uploaded so far (GL thread)
+        m_ImportJobs.clear();
+    }
+
+    // marks a scene mesh no node has referenced yet, or a converted mesh that was dropped
+    static constexpr unsigned int kNoMesh = std::numeric_limits<unsigned int>::max();
+
+    // always run by Assimp; welding, normals, tangents and cache order depend on PostProcessOptions
+    static constexpr unsigned int kBaseImportFlags =
+        aiProcess_Triangulate
+      | aiProcess_FlipUVs
+      | aiProcess_LimitBoneWeights;
+
+    unsigned int ModelManager::GetImportFlags(const PostProcessOptions& options)
+    {
+        unsigned int flags = kBaseImportFlags;
+        if (options.Weld == PostProcessMode::Assimp)
+            flags |= aiProcess_JoinIdenticalVertices;
+        if (options.Normals == PostProcessMode::Assimp)
+            flags |= aiProcess_GenSmoothNormals;
+        if (options.Tangents == PostProcessMode::Assimp)
+            flags |= aiProcess_CalcTangentSpace;
+        if (options.Optimize == PostProcessMode::Assimp)
+            flags |= aiProcess_ImproveCacheLocality;
+        return flags;
+    }
+
+    std::unique_ptr<ImportedScene> ModelManager::ImportScene(const std::string &path, ImportProgress* progress,
+                                                             const PostProcessOptions& options)
+    {
+        // only a caller that watches the progress can show a proxy
+        const bool preview = progress && s_ProgressiveImports;
+        ImportProgress local;
+        if (!progress)
+            progress = &local;
+
+        Timer timer;
+        timer.Start();
+        ThreadPool& pool = ThreadPool::GetInstance();
+
+        // process-wide, like the peak itself
+        const std::size_t residentBefore = MemoryStats::GetResidentBytes();
+        MemoryStats::ResetPeak();
+
+        // --- geometry: from the mesh cache when it is current, otherwise through Assimp ---
+        progress->Enter(ImportStage::Parsing);
+
+        Timer stage;
+        double previewMs = 0.0;
+
+        const ImportLoader loader = ChooseLoader(path);
+
+        // a first proxy straight from the file, before anything is parsed
+        std::vector<glm::vec3> samples;
+        if (preview)
         {
-            out.Diffuse = makeSolidTexture(to8bit(kd.r), to8bit(kd.g), to8bit(kd.b), TextureType::DIFFUSE);
+            stage.Start();
+            if (ImportPreviewBuilder::SampleSource(path, samples))
+            {
+                progress->PublishPreview(ImportPreviewBuilder::FromPoints(samples));
+                previewMs = stage.Stop() * 1000.0;
+            }
         }
 
-        aiColor3D ks(0.0f, 0.0f, 0.0f);
-        mat->Get(AI_MATKEY_COLOR_SPECULAR, ks);
+        stage.Start();
+        MeshCacheKey key;
+        const bool useCache = MeshCache::IsEnabled() && usesMeshCache(loader) &&
+                              MeshCache::MakeKey(path, GetImportFlags(options), pool, key);
+        // the loaders without one keep their LOD chains and meshlets in a derived entry, keyed without reading the file
+        const bool useDerived = MeshCache::IsEnabled() && !usesMeshCache(loader) && (options.Lods || options.Meshlets) &&
+                                MeshCache::MakeStampKey(path, GetImportFlags(options), key);
+        key.Loader      = static_cast<std::uint32_t>(loader);
+        key.PostProcess = options.Pack();
+        const std::string cachePath = useCache ? MeshCache::GetCachePath(path) : std::string();
+        const double hashMs = stage.Stop() * 1000.0;
 
-        if (mat->GetTextureCount(aiTextureType_SPECULAR) > 0 &&
-            mat->GetTexture(aiTextureType_SPECULAR, 0, &texPath) == AI_SUCCESS)
+        stage.Start();
+        std::unique_ptr<ImportedScene> out = useCache ? MeshCache::Read(cachePath, key) : nullptr;
+        const bool cacheHit = out != nullptr;
+        if (cacheHit)
         {
-            auto path = (baseDir / texPath.C_Str()).string();
-            out.Specular = TextureManager::LoadTexture(path, TextureType::SPECULAR);
+            out->Profile.Add("Hash source", hashMs, key.SourceSize);
+            out->Profile.Add("Mesh cache read", stage.Stop() * 1000.0, geometryBytes(*out), out->Meshes.size());
         }
         else
         {
-            float s = std::max({ks.r, ks.g, ks.b});
-            if (s > 0.f)
+            out = BuildScene(path, loader, progress, options, pool, useDerived ? &key : nullptr);
+            if (!out)
+                return nullptr;
+            ImportProfile& profile = out->Profile;
+            if (useCache)
             {
-                auto v = to8bit(s);
-                out.Specular = makeSolidTexture(v, v, v, TextureType::SPECULAR);
+                profile.Stages.insert(profile.Stages.begin(), ImportStageTiming{ "Hash source", 0, hashMs, key.SourceSize, 0, residentBefore });
+
+                stage.Start();
+                MeshCache::Write(cachePath, *out, key);
+                profile.Add("Mesh cache write", stage.Stop() * 1000.0, geometryBytes(*out), out->Meshes.size());
             }
         }
+
+        std::filesystem::path p(path);
+        out->Name = p.stem().string();
+        out->Path = path;
+
+        // impostors are cached under what shaped the model: the source and the import. The mesh cache
+        // already hashed the contents; the other loaders key on size and mtime rather than read a
+        // large file again just for this
+        // a model already drawn in one call gains nothing from its impostor, so it is not baked
+        if (options.Impostors && drawCount(*out) > 1)
+        {
+            if (useCache || useDerived || MeshCache::MakeStampKey(path, GetImportFlags(options), key))
+                out->ImpostorKey = HashBytes(&key, sizeof(key));
+        }
+
+        // the proxy from the real geometry, shown while textures decode and everything uploads
+        if (preview)
+        {
+            if (previewMs > 0.0)
+                out->Profile.Stages.insert(out->Profile.Stages.begin(),
+                                           ImportStageTiming{ "Sample preview", 0, previewMs, 0, samples.size(), residentBefore });
+            stage.Start();
+            samples.clear();
+            ImportPreviewBuilder::SampleScene(*out, samples);
+            ImportPreview scenePreview = ImportPreviewBuilder::FromPoints(samples);
+            scenePreview.ZUp       = out->ZUp;
+            scenePreview.FromScene = true;
+            out->Profile.Add("Scene preview", stage.Stop() * 1000.0, 0, scenePreview.Boxes.size());
+            progress->PublishPreview(std::move(scenePreview));
+            std::vector<glm::vec3>().swap(samples);
+        }
+
+        const float geometryMs = timer.Peek() * 1000.0f;
+
+        // --- decode textures ---
+        if (!DecodeTextures(*out, pool, progress))
+            return nullptr;
+
+        LOG_INFO("Imported {}: geometry {:.1f} ms ({}), total {:.1f} ms",
+                 out->Name, geometryMs, cacheHit ? "warm, mesh cache" : (useCache ? "cold, cache written" : "cold"),
+                 timer.Peek() * 1000.0f);
+
+        ImportProfile& profile      = out->Profile;
+        profile.Model               = out->Name;
+        profile.Path                = path;
+        profile.Loader              = loaderName(loader);
+        profile.CacheHit            = cacheHit;
+        profile.ResidentBytesBefore = residentBefore;
+        profile.ImportMilliseconds  = timer.Peek() * 1000.0;
+
+        progress->Enter(ImportStage::Uploading);
         return out;
     }
 
-    // ------------------------------------------------------------------------
+    std::unique_ptr<ImportedScene> ModelManager::BuildScene(const std::string& path, ImportLoader loader, ImportProgress* progress,
+                                                            const PostProcessOptions& options, ThreadPool& pool,
+                                                            const MeshCacheKey* derivedKey)
+    {
+        Timer stage;
+        stage.Start();
+        std::unique_ptr<ImportedScene> out = ParseScene(path, loader, progress, options);
+        if (!out)
+            return nullptr;
+        ImportProfile& profile = out->Profile;
+        if (loader != ImportLoader::Assimp)
+            profile.Add(std::string("Parse (") + loaderName(loader) + ")", stage.Stop() * 1000.0,
+                        geometryBytes(*out), out->Meshes.size() + out->StreamMeshes.size());
+
+        stage.Start();
+        if (const std::size_t removed = DeduplicateMaterials(*out))
+            LOG_INFO("Materials: {} identical of {} merged", removed, out->Materials.size() + removed);
+        profile.Add("Merge materials", stage.Stop() * 1000.0, 0, out->Materials.size());
+
+        stage.Start();
+        OptimizeMeshes(*out, options.Optimize == PostProcessMode::Engine, pool);
+        profile.Add("Optimize meshes", stage.Stop() * 1000.0, 0, out->Meshes.size());
 
-    Model* ModelManager::LoadModel(const std::string &path)
+        // before the LOD chains, which index one part's vertices each
+        if (options.SplitForShortIndices)
+        {
+            stage.Start();
+            const std::size_t before = out->Meshes.size();
+            const std::size_t added  = SplitForShortIndices(*out, pool);
+            profile.Add("Split for 16-bit indices", stage.Stop() * 1000.0, 0, added);
+            if (added > 0)
+                LOG_INFO("Split for 16-bit indices: {} -> {} meshes", before, out->Meshes.size());
+        }
+
+        // a loader that parses on every load keeps the next two stages in a derived entry
+        const std::string derivedPath = derivedKey ? MeshCache::GetDerivedPath(path) : std::string();
+        stage.Start();
+        const bool derived = derivedKey && MeshCache::ReadDerived(derivedPath, *derivedKey, *out);
+        if (derived)
+            profile.Add("Derived cache read", stage.Stop() * 1000.0, derivedBytes(*out), out->Meshes.size());
+
+        // the slowest stage of a cold import; the levels go into the mesh cache so warm loads skip it
+        if (options.Lods && !derived)
+        {
+            stage.Start();
+            const std::size_t levels = GenerateLods(*out, pool);
+            profile.Add("LOD chains", stage.Stop() * 1000.0, 0, levels);
+        }
+
+        // the triangle order is final from here on, and meshlets are ranges of it
+        if (options.Meshlets && !derived)
+        {
+            stage.Start();
+            const std::size_t meshlets = BuildMeshlets(*out, pool);
+            profile.Add("Meshlets", stage.Stop() * 1000.0, 0, meshlets);
+        }
+
+        if (derivedKey && !derived)
+        {
+            stage.Start();
+            MeshCache::WriteDerived(derivedPath, *out, *derivedKey);
+            profile.Add("Derived cache write", stage.Stop() * 1000.0, derivedBytes(*out), out->Meshes.size());
+        }
+
+        // merged after the derived entry, which keeps the LOD chains and meshlets of the unmerged meshes
+        if (options.Batch)
+        {
+            stage.Start();
+            const StaticBatchStats batched = StaticBatcher::Batch(*out);
+            profile.Add("Static batching", stage.Stop() * 1000.0, 0, batched.MeshesMerged);
+            if (batched.Batches > 0)
+                LOG_INFO("Static batching: {} small meshes merged into {} batches, {} -> {} meshes",
+                         batched.MeshesMerged, batched.Batches, batched.MeshesBefore, batched.MeshesAfter);
+        }
+
+        // the batches are new meshes; the others were clustered above
+        if (options.Meshlets && options.Batch)
+        {
+            stage.Start();
+            const std::size_t meshlets = BuildMeshlets(*out, pool, true);
+            profile.Add("Meshlets (batches)", stage.Stop() * 1000.0, 0, meshlets);
+        }
+
+        // last: the mesh cache stores the vertices packed in the format they upload with
+        stage.Start();
+        SelectVertexFormats(*out, options.Quantize, pool);
+        profile.Add("Vertex formats", stage.Stop() * 1000.0, 0, out->Meshes.size());
+
+        if ((options.Lods || options.Meshlets) && !out->StreamMeshes.empty())
+            LOG_INFO("{}: {} meshes are uploaded straight from the file, without LOD chains or meshlets",
+                     std::filesystem::path(path).filename().string(), out->StreamMeshes.size());
+        return out;
+    }
+
+    ModelManager::CacheResult ModelManager::UpdateMeshCache(const std::string& path, const PostProcessOptions& options, bool force,
+                                                            std::vector<std::string>* outTextures)
     {
-        m_Meshes.clear();
+        ThreadPool& pool = ThreadPool::GetInstance();
+        const ImportLoader loader = ChooseLoader(path);
+        auto collectTextures = [outTextures](const ImportedScene& scene)
+        {
+            if (!outTextures)
+                return;
+            for (const MaterialData& material : scene.Materials)
+            {
+                for (const TextureRef& ref : material.Textures)
+                {
+                    if (!ref.Path.starts_with('*')) // embedded images travel inside the model's own entry
+                        outTextures->push_back(ref.Path);
+                }
+            }
+        };
+
+        ImportProgress progress;
+        if (!usesMeshCache(loader))
+        {
+            // nothing to write, but a glTF file can still point at texture files
+            if (outTextures && loader == ImportLoader::Gltf)
+            {
+                if (auto scene = ParseScene(path, loader, &progress, options))
+                    collectTextures(*scene);
+            }
+            return CacheResult::NotCached;
+        }
+
+        MeshCacheKey key;
+        if (!MeshCache::MakeKey(path, GetImportFlags(options), pool, key))
+            return CacheResult::Failed;
+        key.Loader      = static_cast<std::uint32_t>(loader);
+        key.PostProcess = options.Pack();
+        const std::string cachePath = MeshCache::GetCachePath(path);
+        if (!force && MeshCache::IsCurrent(cachePath, key))
+            return CacheResult::UpToDate;
+
+        std::unique_ptr<ImportedScene> scene = BuildScene(path, loader, &progress, options, pool);
+        if (!scene)
+            return CacheResult::Failed;
+        collectTextures(*scene);
+        return MeshCache::Write(cachePath, *scene, key) ? CacheResult::Written : CacheResult::Failed;
+    }
+
+    std::string ModelManager::ResolveTexturePath(const std::filesystem::path& baseDir, const std::string& path)
+    {
+        // canonical full path (handles relative vs absolute and / vs \)
+        std::filesystem::path p(path);
+        std::error_code ec;
+        auto full = (p.is_absolute() ? p : (baseDir / p));
+        auto can  = std::filesystem::weakly_canonical(full, ec);
+        return (ec ? full : can).string();
+    }
+
+    ModelManager::ImportLoader ModelManager::ChooseLoader(const std::string &path)
+    {
+        if (!s_NativeLoadersEnabled)
+            return ImportLoader::Assimp;
+
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (ext == ".obj")
+            return ImportLoader::Obj;
+        if (ext == ".gltf" || ext == ".glb")
+            return ImportLoader::Gltf;
+        if (ext == ".stl")
+            return ImportLoader::Stl;
+        if (ext == ".ply")
+            return ImportLoader::Ply;
+        return ImportLoader::Assimp;
+    }
+
+    std::unique_ptr<ImportedScene> ModelManager::ParseScene(const std::string &path, ImportLoader loader, ImportProgress* progress,
+                                                            const PostProcessOptions& options)
+    {
+        if (loader == ImportLoader::Obj)
+            return ObjLoader::Load(path, ThreadPool::GetInstance(), progress);
+        if (loader == ImportLoader::Gltf)
+            return GltfLoader::Load(path, ThreadPool::GetInstance(), progress);
+        if (loader == ImportLoader::Stl)
+            return StlLoader::Load(path, ThreadPool::GetInstance(), progress);
+        if (loader == ImportLoader::Ply)
+            return PlyLoader::Load(path, ThreadPool::GetInstance(), progress);
+
+        auto fail = [progress](ImportStage stage) -> std::unique_ptr<ImportedScene>
+        {
+            progress->Enter(stage);
+            return nullptr;
+        };
+
+        // --- parse ---
+        progress->Enter(ImportStage::Parsing);
 
-        // robust base dir
         std::filesystem::path p(path);
-        m_BaseDir = p.parent_path();
+        const std::filesystem::path baseDir = p.parent_path();
+
+        // step names come from Assimp's debug log; installed once, for every importer
+        static std::once_flag loggerInstalled;
+        std::call_once(loggerInstalled, []()
+        {
+            if (Assimp::DefaultLogger::isNullLogger())
+                Assimp::DefaultLogger::set(new AssimpStepLogger());
+        });
 
+        AssimpStepTimer steps;
         Assimp::Importer import;
+        import.SetProgressHandler(new AssimpProgress(progress, &steps)); // importer takes ownership
+        auto* files = new DependencyRecorder(path);
+        import.SetIOHandler(files); // importer takes ownership
+
+        // read and post-process separately, so each can be timed; Assimp does the same inside ReadFile
+        Timer stage;
+        stage.Start();
+        const aiScene *scene = import.ReadFile(path, 0);
+        const double readMs = stage.Stop() * 1000.0;
 
-        // IMPORTANT: add safe flags for normals/tangents
-        const unsigned int flags =
-            aiProcess_Triangulate
-          | aiProcess_FlipUVs
-          | aiProcess_JoinIdenticalVertices
-          | aiProcess_ImproveCacheLocality
-          | aiProcess_LimitBoneWeights
-          | aiProcess_GenSmoothNormals
-          | aiProcess_CalcTangentSpace;
+        stage.Start();
+        if (scene && !cancelRequested(progress))
+        {
+            t_StepTimer = &steps;
+            scene = import.ApplyPostProcessing(GetImportFlags(options));
+            steps.Close();
+            t_StepTimer = nullptr;
+        }
+        const double postProcessMs = stage.Stop() * 1000.0;
 
-        const aiScene *scene = import.ReadFile(path, flags);
+        if (cancelRequested(progress))
+            return fail(ImportStage::Cancelled);
 
         if(!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode) 
         {
             LOG_ERROR("ERROR::ASSIMP::{}", import.GetErrorString());
-            return nullptr;
+            return fail(ImportStage::Failed);
+        }
+
+        auto out = std::make_unique<ImportedScene>();
+        out->Dependencies = files->GetOpened();
+        std::error_code ec;
+        const std::uintmax_t fileSize = std::filesystem::file_size(p, ec);
+        out->Profile.Add("Assimp read", readMs, ec ? 0 : fileSize, scene->mNumMeshes);
+        out->Profile.Add("Assimp post-process", postProcessMs, 0, steps.GetSteps().size());
+        for (const AssimpStepTimer::Step& step : steps.GetSteps())
+            out->Profile.Add(step.Name, step.Milliseconds, 0, 0, 1);
+        // FBX/DAE models are Z-up
+        out->ZUp  = path.ends_with(".fbx") || path.ends_with(".dae");
+
+        // --- convert ---
+        progress->Enter(ImportStage::Converting);
+
+        // each scene mesh is converted once, however many nodes place it
+        ProcessNode(scene->mRootNode, scene, out->Nodes);
+        std::vector<unsigned int> meshOrder;
+        std::vector<unsigned int> slot(scene->mNumMeshes, kNoMesh);
+        for (SceneNode& node : out->Nodes)
+        {
+            for (unsigned int& mesh : node.Meshes)
+            {
+                if (slot[mesh] == kNoMesh)
+                {
+                    slot[mesh] = static_cast<unsigned int>(meshOrder.size());
+                    meshOrder.push_back(mesh);
+                }
+                mesh = slot[mesh];
+            }
+        }
+
+        stage.Start();
+        out->Meshes = ConvertMeshes(scene, meshOrder, ThreadPool::GetInstance(), progress);
+        if (cancelRequested(progress))
+            return fail(ImportStage::Cancelled);
+        out->Profile.Add("Convert meshes", stage.Stop() * 1000.0, geometryBytes(*out), out->Meshes.size());
+
+        Timer timer;
+        timer.Start();
+        PostProcessMeshes(scene, meshOrder, out->Meshes, options, ThreadPool::GetInstance(), progress);
+        if (cancelRequested(progress))
+            return fail(ImportStage::Cancelled);
+        const float postProcessEngineMs = timer.Stop() * 1000.0f;
+        out->Profile.Add("Engine post-process", postProcessEngineMs, geometryBytes(*out), out->Meshes.size());
+        LOG_INFO("Post-processing {}: {:.1f} ms (weld: {}, normals: {}, tangents: {}, cache order: {})", p.filename().string(),
+                 postProcessEngineMs, PostProcessModeName(options.Weld), PostProcessModeName(options.Normals),
+                 PostProcessModeName(options.Tangents), PostProcessModeName(options.Optimize));
+
+        // skip empty meshes, and the node references to them
+        std::vector<unsigned int> remap(out->Meshes.size(), kNoMesh);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < out->Meshes.size(); ++i)
+        {
+            if (out->Meshes[i].Empty())
+                continue;
+            remap[i] = static_cast<unsigned int>(kept);
+            if (kept != i)
+                out->Meshes[kept] = std::move(out->Meshes[i]);
+            ++kept;
+        }
+        out->Meshes.resize(kept);
+        for (SceneNode& node : out->Nodes)
+        {
+            for (unsigned int& mesh : node.Meshes)
+                mesh = remap[mesh];
+            std::erase(node.Meshes, kNoMesh);
         }
 
-        ProcessNode(scene->mRootNode, scene);
+        std::size_t instances = 0;
+        for (const SceneNode& node : out->Nodes)
+            instances += node.Meshes.size();
+        LOG_INFO("{}: {} nodes place {} meshes {} times", p.filename().string(), out->Nodes.size(), out->Meshes.size(), instances);
 
-        std::string modelName = p.stem().string();
-        auto model = new Model(m_Meshes, modelName);
+        // embedded textures (GLB/FBX) die with the importer: keep their bytes, decode them later with the rest
+        stage.Start();
+        std::uint64_t embeddedBytes = 0;
+        std::vector<std::string> embeddedKeys(scene->mNumTextures);
+        for (unsigned int i = 0; i < scene->mNumTextures; ++i)
+        {
+            const aiTexture* texture = scene->mTextures[i];
+            std::vector<unsigned char> bytes;
+            if (texture->mHeight == 0)
+            {
+                // compressed file, mWidth bytes long
+                const auto* data = reinterpret_cast<const unsigned char*>(texture->pcData);
+                bytes.assign(data, data + texture->mWidth);
+            }
+            else
+            {
+                // raw BGRA texels
+                bytes.resize(std::size_t(texture->mWidth) * texture->mHeight * 4);
+                for (std::size_t t = 0, n = bytes.size() / 4; t < n; ++t)
+                {
+                    const aiTexel& texel = texture->pcData[t];
+                    bytes[t * 4 + 0] = texel.r;
+                    bytes[t * 4 + 1] = texel.g;
+                    bytes[t * 4 + 2] = texel.b;
+                    bytes[t * 4 + 3] = texel.a;
+                }
+            }
+            if (bytes.empty())
+                continue;
+            out->SourceBuffers.push_back(std::move(bytes));
+            const std::vector<unsigned char>& stored = out->SourceBuffers.back();
+            embeddedBytes += stored.size();
+            embeddedKeys[i] = out->AddEmbeddedImage(stored.data(), stored.size(), texture->mHeight ? texture->mWidth : 0, texture->mHeight);
+        }
+
+        out->Materials.reserve(scene->mNumMaterials);
+        for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+            out->Materials.push_back(ConvertMaterial(scene, scene->mMaterials[i], baseDir, embeddedKeys));
+        out->Profile.Add("Materials", stage.Stop() * 1000.0, embeddedBytes, out->Materials.size());
+
+        return out;
+    }
+
+    bool ModelManager::DecodeTextures(ImportedScene &scene, ThreadPool& pool, ImportProgress* progress)
+    {
+        progress->Enter(ImportStage::DecodingTextures);
+
+        // each file or embedded image once, skipping anything a previous import already uploaded
+        std::unordered_map<std::string, const EmbeddedImage*> embedded;
+        for (const EmbeddedImage& image : scene.EmbeddedImages)
+            embedded.emplace(image.Key, &image);
+
+        std::unordered_set<std::string> seen;
+        for (const MaterialData& material : scene.Materials)
+        {
+            for (const TextureRef& ref : material.Textures)
+            {
+                if (seen.insert(ref.Path).second && !TextureManager::Find(ref.Path))
+                    scene.Images.push_back({ ref.Path, ref.Type, {} });
+            }
+        }
+
+        Timer timer;
+        timer.Start();
+        std::atomic<std::size_t> decoded { 0 };
+        const std::size_t imageCount = scene.Images.size();
+        pool.ParallelFor(imageCount, [&](std::size_t i)
+        {
+            if (cancelRequested(progress))
+                return;
+
+            DecodedTexture& image = scene.Images[i];
+            const auto source = embedded.find(image.Path);
+            if (source == embedded.end())
+                image.Image = TextureCache::Load(image.Path);
+            else if (source->second->Width > 0)
+                image.Image = TextureManager::CopyPixels(source->second->Data, int(source->second->Width), int(source->second->Height));
+            else
+                image.Image = TextureManager::DecodeImageFromMemory(source->second->Data, source->second->Size);
+            if (!image.Image.IsValid())
+                LOG_ERROR("Failed to load texture at: {}", image.Path);
+
+            progress->Fraction.store(float(decoded.fetch_add(1) + 1) / float(imageCount));
+        });
+
+        if (cancelRequested(progress))
+        {
+            progress->Enter(ImportStage::Cancelled);
+            return false;
+        }
+
+        std::uint64_t pixelBytes = 0;
+        for (const DecodedTexture& image : scene.Images)
+            pixelBytes += std::uint64_t(image.Image.Width) * image.Image.Height * image.Image.Channels;
+        scene.Profile.Add("Decode textures", timer.Stop() * 1000.0, pixelBytes, imageCount);
+        return true;
+    }
+
+    bool ModelManager::UploadStep(ModelUpload &upload, float budgetMs, ImportProgress* progress)
+    {
+        ImportedScene& scene = *upload.Scene;
+
+        Timer timer;
+        timer.Start();
+        auto outOfTime = [&]() { return timer.Peek() * 1000.0f >= budgetMs; };
+
+        const std::size_t total = scene.Images.size() + scene.Meshes.size() + scene.StreamMeshes.size();
+        auto report = [&]()
+        {
+            if (progress && total > 0)
+                progress->Fraction.store(float(upload.NextImage + upload.NextMesh + upload.NextStreamMesh) / float(total));
+        };
+
+        // GL work of this step, per kind; added to the profile once per step, whichever way it ends
+        struct UploadCost
+        {
+            const char*   Name;
+            double        Milliseconds { 0.0 };
+            std::uint64_t Bytes        { 0 };
+            std::size_t   Items        { 0 };
+        };
+        UploadCost textures { "Upload textures" }, meshes { "Upload meshes" }, streamCost { "Upload streams" };
+        Timer item;
+        auto done = [&](bool finished)
+        {
+            for (const UploadCost* cost : { &textures, &meshes, &streamCost })
+            {
+                if (cost->Items > 0)
+                    scene.Profile.Add(cost->Name, cost->Milliseconds, cost->Bytes, cost->Items);
+            }
+            scene.Profile.UploadMilliseconds += timer.Peek() * 1000.0;
+            return finished;
+        };
+
+        // textures first, so materials can find them in the cache
+        while (upload.NextImage < scene.Images.size())
+        {
+            DecodedTexture& image = scene.Images[upload.NextImage++];
+            item.Start();
+            if (TextureManager::CreateTexture(image.Path, image.Image, image.Type))
+            {
+                ++upload.TexturesCreated;
+                textures.Bytes += std::uint64_t(image.Image.Width) * image.Image.Height * image.Image.Channels;
+            }
+            textures.Milliseconds += item.Stop() * 1000.0;
+            ++textures.Items;
+            image.Image.Pixels.reset(); // the GL copy is all we need now
+            report();
+            if (outOfTime())
+                return done(false);
+        }
+
+        if (!upload.MaterialsBuilt)
+        {
+            upload.Materials.reserve(scene.Materials.size());
+            upload.MaterialTextures.reserve(scene.Materials.size());
+            for (const MaterialData& data : scene.Materials)
+            {
+                std::vector<std::shared_ptr<Texture>> textures;
+                textures.reserve(data.Textures.size());
+                for (const TextureRef& ref : data.Textures)
+                {
+                    if (auto tex = TextureManager::Find(ref.Path))
+                        textures.push_back(tex);
+                }
+
+                // engine Material: textures where the file has them, constant colors (uniforms) elsewhere
+                Material material{};
+                material.Shininess = data.Shininess;
+                material.UseColors = true;
+                material.DiffuseColor = data.DiffuseColor;
+                // no specular color keeps the shader's default white tint
+                const bool hasSpecularColor = std::max({ data.SpecularColor.r, data.SpecularColor.g, data.SpecularColor.b }) > 0.0f;
+                material.SpecularColor = hasSpecularColor ? data.SpecularColor : glm::vec3(1.0f);
+
+                if (!data.DiffuseMap.empty())
+                    material.Diffuse = TextureManager::Find(data.DiffuseMap);
+                if (!data.SpecularMap.empty())
+                    material.Specular = TextureManager::Find(data.SpecularMap);
+
+                upload.Materials.push_back(std::move(material));
+                upload.MaterialTextures.push_back(std::move(textures));
+            }
+            upload.MaterialsBuilt = true;
+            upload.Meshes.reserve(scene.Meshes.size() + scene.StreamMeshes.size());
+        }
+
+        static const std::vector<std::shared_ptr<Texture>> kNoTextures;
+        while (upload.NextMesh < scene.Meshes.size())
+        {
+            MeshData& data = scene.Meshes[upload.NextMesh++];
+
+            const bool hasMaterial = data.MaterialIndex < upload.Materials.size();
+            const std::vector<std::shared_ptr<Texture>>& meshTextures = hasMaterial ? upload.MaterialTextures[data.MaterialIndex] : kNoTextures;
+            const Material material = hasMaterial ? upload.Materials[data.MaterialIndex] : Material{};
+            item.Start();
+            if (data.Packed.IsSet())
+            {
+                // straight from the mapped cache entry; only what upload.Residency asks for is copied out
+                const PackedGeometry& packed = data.Packed;
+                meshes.Bytes += VertexPacker::PackedSize(packed.VertexCount, data.Format)
+                              + packed.IndexCount * (packed.ShortIndices ? sizeof(std::uint16_t) : sizeof(unsigned int));
+                upload.Meshes.emplace_back(std::make_shared<const GpuGeometry>(packed, data.Format, upload.Residency, std::move(data.Meshlets)),
+                                           meshTextures, material, data.Name);
+            }
+            else
+            {
+                const std::size_t indexSize = data.Vertices.size() <= MeshProcessing::kMaxShortIndexVertices ? sizeof(std::uint16_t) : sizeof(unsigned int);
+                std::size_t indexCount = data.Indices.size();
+                for (const MeshLod& lod : data.Lods)
+                    indexCount += lod.Indices.size();
+                meshes.Bytes += VertexPacker::PackedSize(data.Vertices.size(), data.Format) + indexCount * indexSize;
+
+                // the arrays move into the Mesh, which keeps what upload.Residency asks for
+                upload.Meshes.emplace_back(std::move(data.Vertices), std::move(data.Indices), meshTextures, material,
+                                           data.Name, data.Format, upload.Residency, data.Lods,
+                                           std::move(data.Meshlets));
+            }
+            ++meshes.Items;
+            upload.Meshes.back().SetCacheStats(data.Stats);
+            upload.Meshes.back().SetParts(std::move(data.Parts));
+            meshes.Milliseconds += item.Stop() * 1000.0;
+            data = MeshData{};
+            report();
+            if (outOfTime())
+                return done(upload.NextMesh == scene.Meshes.size() && scene.StreamMeshes.empty());
+        }
+
+        // straight from the mapped source; the GL copy is the only one made
+        while (upload.NextStreamMesh < scene.StreamMeshes.size())
+        {
+            MeshStreams& streams = scene.StreamMeshes[upload.NextStreamMesh++];
+
+            const bool hasMaterial = streams.MaterialIndex < upload.Materials.size();
+            item.Start();
+            upload.Meshes.emplace_back(streams,
+                                       hasMaterial ? upload.MaterialTextures[streams.MaterialIndex] : kNoTextures,
+                                       hasMaterial ? upload.Materials[streams.MaterialIndex] : Material{},
+                                       streams.Name, upload.Residency);
+            streamCost.Milliseconds += item.Stop() * 1000.0;
+            for (const StreamRange& range : streams.Ranges)
+                streamCost.Bytes += range.Size;
+            streamCost.Bytes += streams.OwnedIndices.size();
+            ++streamCost.Items;
+
+            streams = MeshStreams{};
+            report();
+            if (outOfTime())
+                return done(upload.NextStreamMesh == scene.StreamMeshes.size());
+        }
+        return done(true);
+    }
+
+    Model* ModelManager::FinishUpload(ModelUpload &upload)
+    {
+        // moved, not copied: stream meshes have no CPU data to rebuild from
+        auto model = new Model(std::move(upload.Meshes), upload.Scene->Name);
+        model->SetNodes(std::move(upload.Scene->Nodes));
+        model->SetImpostorKey(upload.Scene->ImpostorKey);
+        LOG_INFO("{}: {} meshes share {} materials; {} GL textures created, {} alive", upload.Scene->Name,
+                 model->GetMeshes().size(), upload.Materials.size(), upload.TexturesCreated, Texture::GetLiveCount());
+
+        ImportProfile& profile    = upload.Scene->Profile;
+        profile.PeakResidentBytes = MemoryStats::GetPeakResidentBytes();
+        LOG_INFO("{}: import {:.1f} ms, upload {:.1f} ms, peak RSS {:.1f} MB", upload.Scene->Name, profile.ImportMilliseconds,
+                 profile.UploadMilliseconds, MemoryStats::ToMB(profile.PeakResidentBytes));
+        if (s_WriteProfiles)
+            profile.WriteJson(ImportProfile::MakeJsonPath(upload.Scene->Name));
+        model->SetImportProfile(std::move(profile));
         
-        if (path.ends_with(".fbx") || path.ends_with(".dae"))
+        if (upload.Scene->ZUp)
         {
             // FBX/DAE models are Z-up, convert to Y-up
             model->SetOrientation(glm::quat(glm::vec3(glm::radians(-90.0f), 0.0f, 0.0f)));
         }
 
+        upload.Meshes.clear();
+        upload.Scene.reset();
         return model;
     }
 
-    void ModelManager::ProcessNode(aiNode *node, const aiScene *scene)
+    void ModelManager::ProcessNode(aiNode *node, const aiScene *scene, std::vector<SceneNode>& nodes, int parent)
     {
+        const int index = static_cast<int>(nodes.size());
+        SceneNode& out = nodes.emplace_back();
+        out.Name   = node->mName.C_Str();
+        out.Parent = parent;
+        // Assimp matrices are row-major, glm's are column-major
+        out.Transform = glm::transpose(glm::make_mat4(&node->mTransformation.a1));
         for(unsigned int i = 0; i < node->mNumMeshes; i++)
         {
-            aiMesh *mesh = scene->mMeshes[node->mMeshes[i]]; 
-            Mesh m = ProcessMesh(mesh, scene);
-            if (m.GetIndexCount() > 0 || m.GetVertexCount() > 0) // skip empty
-                m_Meshes.push_back(std::move(m));
+            if (node->mMeshes[i] < scene->mNumMeshes)
+                out.Meshes.push_back(node->mMeshes[i]);
         }
         for(unsigned int i = 0; i < node->mNumChildren; i++)
-            ProcessNode(node->mChildren[i], scene);
+            ProcessNode(node->mChildren[i], scene, nodes, index);
     }  
-    
-    Mesh ModelManager::ProcessMesh(aiMesh *mesh, const aiScene *scene)
+
+    // vertices per task when a single large mesh is split across the pool
+    static constexpr std::size_t kVertexChunk = 1 << 16;
+
+    MeshData ModelManager::ConvertMesh(const aiMesh *mesh, ThreadPool* pool)
     {
-        std::string meshName = mesh->mName.C_Str();
-        std::vector<Vertex> vertices;
-        std::vector<unsigned int> indices;
+        MeshData out;
+        out.Name          = mesh->mName.C_Str();
+        out.MaterialIndex = mesh->mMaterialIndex;
+
+        // value-initialized, so streams the mesh lacks stay zero without per-vertex branches
+        const std::size_t vertexCount = mesh->mNumVertices;
+        out.Vertices.resize(vertexCount);
 
-        vertices.reserve(mesh->mNumVertices);
-        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+        // which streams exist is decided once per mesh; tangents are only used alongside UVs
+        const aiVector3D* positions  = mesh->mVertices;
+        const aiVector3D* normals    = mesh->mNormals;
+        const aiVector3D* uvs        = mesh->mTextureCoords[0];
+        const bool        tangents   = uvs && mesh->HasTangentsAndBitangents();
+        Vertex*           dst        = out.Vertices.data();
+
+        auto copyStreams = [=](std::size_t begin, std::size_t end)
         {
-            Vertex v{};
+            for (std::size_t i = begin; i < end; ++i)
+                dst[i].Position = glm::vec3(positions[i].x, positions[i].y, positions[i].z);
+
+            if (normals)
+                for (std::size_t i = begin; i < end; ++i)
+                    dst[i].Normal = glm::vec3(normals[i].x, normals[i].y, normals[i].z);
 
-            // positions
-            v.Position.x = mesh->mVertices[i].x;
-            v.Position.y = mesh->mVertices[i].y;
-            v.Position.z = mesh->mVertices[i].z;
+            if (uvs)
+                for (std::size_t i = begin; i < end; ++i)
+                    dst[i].TexCoords = glm::vec2(uvs[i].x, uvs[i].y);
 
-            // normals (assimp flag will generate if missing)
-            if (mesh->HasNormals())
+            if (tangents)
             {
-                v.Normal.x = mesh->mNormals[i].x;
-                v.Normal.y = mesh->mNormals[i].y;
-                v.Normal.z = mesh->mNormals[i].z;
+                const aiVector3D* t = mesh->mTangents;
+                const aiVector3D* b = mesh->mBitangents;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    dst[i].Tangent   = glm::vec3(t[i].x, t[i].y, t[i].z);
+                    dst[i].Bitangent = glm::vec3(b[i].x, b[i].y, b[i].z);
+                }
             }
-            else
+        };
+
+        const std::size_t chunks = (vertexCount + kVertexChunk - 1) / kVertexChunk;
+        if (pool && chunks > 1)
+        {
+            pool->ParallelFor(chunks, [&](std::size_t c)
+            {
+                copyStreams(c * kVertexChunk, std::min(vertexCount, (c + 1) * kVertexChunk));
+            });
+        }
+        else
+        {
+            copyStreams(0, vertexCount);
+        }
+
+        // indices: triangle-only meshes (the norm after aiProcess_Triangulate) copy 3 per face
+        const aiFace*     faces     = mesh->mFaces;
+        const std::size_t faceCount = mesh->mNumFaces;
+        if ((mesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) == aiPrimitiveType_TRIANGLE)
+        {
+            out.Indices.resize(faceCount * 3);
+            unsigned int* idx = out.Indices.data();
+            for (std::size_t f = 0; f < faceCount; ++f)
             {
-                v.Normal = glm::vec3(0.0f);
+                idx[f * 3 + 0] = faces[f].mIndices[0];
+                idx[f * 3 + 1] = faces[f].mIndices[1];
+                idx[f * 3 + 2] = faces[f].mIndices[2];
             }
+        }
+        else
+        {
+            std::size_t indexCount = 0;
+            for (std::size_t f = 0; f < faceCount; ++f)
+                indexCount += faces[f].mNumIndices;
+
+            out.Indices.resize(indexCount);
+            unsigned int* idx = out.Indices.data();
+            for (std::size_t f = 0; f < faceCount; ++f)
+                idx = std::copy(faces[f].mIndices, faces[f].mIndices + faces[f].mNumIndices, idx);
+        }
 
-            // UVs + tangents/bitangents
-            if (mesh->mTextureCoords[0])
+        return out;
+    }
+
+    std::vector<MeshData> ModelManager::ConvertMeshes(const aiScene *scene,
+                                                      const std::vector<unsigned int>& meshOrder,
+                                                      ThreadPool& pool,
+                                                      ImportProgress* progress)
+    {
+        // every task writes its own slot, so the result order never depends on scheduling
+        std::vector<MeshData> out(meshOrder.size());
+        std::atomic<std::size_t> converted { 0 };
+        pool.ParallelFor(meshOrder.size(), [&](std::size_t i)
+        {
+            if (cancelRequested(progress))
+                return;
+
+            out[i] = ConvertMesh(scene->mMeshes[meshOrder[i]], &pool);
+
+            const std::size_t done = converted.fetch_add(1) + 1;
+            if (progress)
+                progress->Fraction.store(float(done) / float(meshOrder.size()));
+        });
+        return out;
+    }
+
+    std::size_t ModelManager::DeduplicateMaterials(ImportedScene& scene)
+    {
+        // everything that reaches the engine Material, as bytes
+        auto key = [](const MaterialData& material)
+        {
+            std::string bytes;
+            auto add       = [&bytes](const void* data, std::size_t size) { bytes.append(static_cast<const char*>(data), size); };
+            auto addString = [&add](const std::string& s)
+            {
+                const auto size = static_cast<std::uint32_t>(s.size());
+                add(&size, sizeof(size));
+                add(s.data(), s.size());
+            };
+            const auto textureCount = static_cast<std::uint32_t>(material.Textures.size());
+            add(&textureCount, sizeof(textureCount));
+            for (const TextureRef& ref : material.Textures)
+            {
+                add(&ref.Type, sizeof(ref.Type));
+                addString(ref.Path);
+            }
+            addString(material.DiffuseMap);
+            addString(material.SpecularMap);
+            add(&material.DiffuseColor, sizeof(material.DiffuseColor));
+            add(&material.SpecularColor, sizeof(material.SpecularColor));
+            add(&material.Shininess, sizeof(material.Shininess));
+            return bytes;
+        };
+
+        const std::size_t count = scene.Materials.size();
+        std::unordered_map<std::string, unsigned int> first;
+        std::vector<unsigned int> remap(count);
+        std::vector<MaterialData> unique;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto [it, inserted] = first.try_emplace(key(scene.Materials[i]), static_cast<unsigned int>(unique.size()));
+            if (inserted)
+                unique.push_back(std::move(scene.Materials[i]));
+            remap[i] = it->second;
+        }
+        if (unique.size() == count)
+            return 0;
+
+        for (MeshData& mesh : scene.Meshes)
+            if (mesh.MaterialIndex < count)
+                mesh.MaterialIndex = remap[mesh.MaterialIndex];
+        for (MeshStreams& streams : scene.StreamMeshes)
+            if (streams.MaterialIndex < count)
+                streams.MaterialIndex = remap[streams.MaterialIndex];
+
+        scene.Materials = std::move(unique);
+        return count - scene.Materials.size();
+    }
+
+    void ModelManager::OptimizeMeshes(ImportedScene& scene, bool reorder, ThreadPool& pool)
+    {
+        Timer timer;
+        timer.Start();
+        pool.ParallelFor(scene.Meshes.size(), [&](std::size_t i)
+        {
+            MeshData& mesh = scene.Meshes[i];
+            if (reorder)
             {
-                v.TexCoords.x = mesh->mTextureCoords[0][i].x; 
-                v.TexCoords.y = mesh->mTextureCoords[0][i].y;
+                MeshOptimizer::Optimize(mesh);
+                return;
+            }
+            mesh.Stats.Before = MeshOptimizer::AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+            mesh.Stats.After  = mesh.Stats.Before;
+        });
 
-                if (mesh->HasTangentsAndBitangents())
-                {
-                    v.Tangent.x   = mesh->mTangents[i].x;
-                    v.Tangent.y   = mesh->mTangents[i].y;
-                    v.Tangent.z   = mesh->mTangents[i].z;
+        // triangle-weighted averages over the whole scene
+        double triangles = 0.0, before = 0.0, after = 0.0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            const double count = double(mesh.Indices.size() / 3);
+            triangles += count;
+            before    += mesh.Stats.Before.Acmr * count;
+            after     += mesh.Stats.After.Acmr * count;
+        }
+        if (triangles > 0.0)
+            LOG_INFO("Vertex cache: ACMR {:.3f} -> {:.3f}{} ({:.1f} ms)", before / triangles, after / triangles,
+                     reorder ? "" : " (not reordered)", timer.Stop() * 1000.0f);
+    }
+
+    std::size_t ModelManager::SplitForShortIndices(ImportedScene& scene, ThreadPool& pool)
+    {
+        const std::size_t before = scene.Meshes.size();
+        std::vector<std::vector<MeshData>> pieces(before);
+        pool.ParallelFor(before, [&](std::size_t i)
+        {
+            if (scene.Meshes[i].Parts.empty())
+                pieces[i] = MeshProcessing::SplitMesh(std::move(scene.Meshes[i]));
+            else
+                pieces[i].push_back(std::move(scene.Meshes[i]));
+        });
+
+        // first[i] is where mesh i's parts start; stream meshes, numbered after the meshes, shift by the parts added
+        std::vector<unsigned int> first(before + 1, 0);
+        for (std::size_t i = 0; i < before; ++i)
+            first[i + 1] = first[i] + static_cast<unsigned int>(pieces[i].size());
+        const std::size_t added = first[before] - before;
+        if (added == 0)
+        {
+            for (std::size_t i = 0; i < before; ++i)
+                scene.Meshes[i] = std::move(pieces[i].front());
+            return 0;
+        }
+
+        scene.Meshes.clear();
+        scene.Meshes.reserve(first[before]);
+        for (std::vector<MeshData>& parts : pieces)
+            std::move(parts.begin(), parts.end(), std::back_inserter(scene.Meshes));
 
-                    v.Bitangent.x = mesh->mBitangents[i].x;
-                    v.Bitangent.y = mesh->mBitangents[i].y;
-                    v.Bitangent.z = mesh->mBitangents[i].z;
+        for (SceneNode& node : scene.Nodes)
+        {
+            std::vector<unsigned int> meshes;
+            meshes.reserve(node.Meshes.size());
+            for (unsigned int mesh : node.Meshes)
+            {
+                if (mesh < before)
+                {
+                    for (unsigned int part = first[mesh]; part < first[mesh + 1]; ++part)
+                        meshes.push_back(part);
                 }
                 else
                 {
-                    v.Tangent   = glm::vec3(0.0f);
-                    v.Bitangent = glm::vec3(0.0f);
+                    meshes.push_back(static_cast<unsigned int>(mesh + added));
                 }
             }
-            else
-            {
-                v.TexCoords = glm::vec2(0.0f);
-                v.Tangent   = glm::vec3(0.0f);
-                v.Bitangent = glm::vec3(0.0f);
-            }
-
-            vertices.push_back(v);
+            node.Meshes = std::move(meshes);
         }
+        return added;
+    }
 
-        // indices
-        for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+    std::size_t ModelManager::GenerateLods(ImportedScene& scene, ThreadPool& pool)
+    {
+        pool.ParallelFor(scene.Meshes.size(), [&](std::size_t i)
         {
-            const aiFace& face = mesh->mFaces[i];
-            for(unsigned int j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);
-        }
+            MeshData& mesh = scene.Meshes[i];
+            mesh.Lods = mesh.Parts.empty() ? MeshSimplifier::BuildLodChain(mesh) : std::vector<MeshLod>();
+        });
 
-        // materials → textures
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+        std::size_t levels = 0, meshes = 0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            levels += mesh.Lods.size();
+            meshes += !mesh.Lods.empty();
+        }
+        if (levels > 0)
+            LOG_INFO("LOD chains: {} levels over {} meshes", levels, meshes);
+        return levels;
+    }
 
-        auto diffuse  = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "diffuse");
-        auto specular = LoadMaterialTextures(material, aiTextureType_SPECULAR, "specular");
+    std::size_t ModelManager::BuildMeshlets(ImportedScene& scene, ThreadPool& pool, bool batchesOnly)
+    {
+        auto selected = [batchesOnly](const MeshData& mesh) { return !batchesOnly || !mesh.Parts.empty(); };
+        pool.ParallelFor(scene.Meshes.size(), [&](std::size_t i)
+        {
+            if (selected(scene.Meshes[i]))
+                scene.Meshes[i].Meshlets = MeshletBuilder::Build(scene.Meshes[i]);
+        });
 
-        // normals: prefer NORMALS, then fallback to HEIGHT or DISPLACEMENT (quirky exporters)
-        auto normals  = LoadMaterialTextures(material, aiTextureType_NORMALS, "normal");
-        if (normals.empty())
-            normals = LoadMaterialTextures(material, aiTextureType_HEIGHT, "normal(height)");
-        if (normals.empty())
-            normals = LoadMaterialTextures(material, aiTextureType_DISPLACEMENT, "normal(disp)");
+        std::size_t meshlets = 0, meshes = 0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            if (!selected(mesh))
+                continue;
+            meshlets += mesh.Meshlets.size();
+            meshes   += !mesh.Meshlets.empty();
+        }
+        if (meshlets > 0)
+            LOG_INFO("Meshlets: {} over {} meshes", meshlets, meshes);
+        return meshlets;
+    }
 
-        // height/displacement (optional)
-        auto height   = LoadMaterialTextures(material, aiTextureType_HEIGHT, "height");
-        if (height.empty())
-            height = LoadMaterialTextures(material, aiTextureType_DISPLACEMENT, "height(disp)");
+    void ModelManager::SelectVertexFormats(ImportedScene& scene, bool quantize, ThreadPool& pool)
+    {
+        pool.ParallelFor(scene.Meshes.size(), [&](std::size_t i)
+        {
+            MeshData& mesh = scene.Meshes[i];
+            bool normalMapped = false;
+            if (mesh.MaterialIndex < scene.Materials.size())
+            {
+                for (const TextureRef& texture : scene.Materials[mesh.MaterialIndex].Textures)
+                    normalMapped |= texture.Type == TextureType::NORMAL;
+            }
+            mesh.Format = VertexPacker::SelectFormat(mesh.Vertices, normalMapped, quantize);
+        });
 
-        // combine
-        std::vector<std::shared_ptr<Texture>> textures;
-        textures.reserve(diffuse.size() + specular.size() + normals.size() + height.size());
-        textures.insert(textures.end(), diffuse.begin(),  diffuse.end());
-        textures.insert(textures.end(), specular.begin(), specular.end());
-        textures.insert(textures.end(), normals.begin(),  normals.end());
-        textures.insert(textures.end(), height.begin(),   height.end());
+        std::uint64_t full = 0, packed = 0;
+        for (const MeshData& mesh : scene.Meshes)
+        {
+            full   += mesh.Vertices.size() * sizeof(Vertex);
+            packed += VertexPacker::PackedSize(mesh.Vertices.size(), mesh.Format);
+        }
+        if (packed > 0)
+            LOG_INFO("Vertex formats: {:.1f} MB of vertices upload as {:.1f} MB ({:.1f}x smaller)",
+                     MemoryStats::ToMB(full), MemoryStats::ToMB(packed), double(full) / double(packed));
+    }
 
-        // engine Material (includes solid-color fallbacks)
-        Material engineMaterial = toEngineMaterial(material, m_BaseDir);
+    void ModelManager::PostProcessMeshes(const aiScene *scene,
+                                         const std::vector<unsigned int>& meshOrder,
+                                         std::vector<MeshData>& meshes,
+                                         const PostProcessOptions& options,
+                                         ThreadPool& pool,
+                                         ImportProgress* progress)
+    {
+        const bool weld     = options.Weld     == PostProcessMode::Engine;
+        const bool normals  = options.Normals  == PostProcessMode::Engine;
+        const bool tangents = options.Tangents == PostProcessMode::Engine;
+        if (!weld && !normals && !tangents)
+            return;
 
-        //LOG_INFO("ModelManager::ProcessMesh - Mesh: {}, V:{} I:{} Tex:{}",
-        //         meshName, vertices.size(), indices.size(), textures.size());
+        // same order as Assimp: normals and tangents on the unwelded corners, then the weld
+        pool.ParallelFor(meshes.size(), [&](std::size_t i)
+        {
+            if (cancelRequested(progress))
+                return;
 
-        return Mesh(vertices, indices, textures, engineMaterial, meshName);
+            const aiMesh* source = scene->mMeshes[meshOrder[i]];
+            MeshData&     mesh   = meshes[i];
+            if (normals && !source->HasNormals())
+                MeshProcessing::GenerateNormals(mesh, pool);
+            if (tangents && source->mTextureCoords[0] && !source->HasTangentsAndBitangents())
+                MeshProcessing::GenerateTangents(mesh, pool);
+            if (weld)
+                MeshProcessing::WeldVertices(mesh, pool);
+        });
     }
 
-    std::vector<std::shared_ptr<Texture>> ModelManager::LoadMaterialTextures(
-        aiMaterial *mat, aiTextureType type, const char* /*debugTypeName*/)
+    // Assimp texture slot → engine TextureType
+    static TextureType toTextureType(aiTextureType type)
     {
-        std::vector<std::shared_ptr<Texture>> out;
+        switch (type)
+        {
+            case aiTextureType_DIFFUSE:       return TextureType::DIFFUSE;
+            case aiTextureType_SPECULAR:      return TextureType::SPECULAR;
+            case aiTextureType_NORMALS:       return TextureType::NORMAL;
+            case aiTextureType_HEIGHT:        return TextureType::HEIGHT;
+            case aiTextureType_DISPLACEMENT:  return TextureType::HEIGHT;
+            default:                          return TextureType::DIFFUSE;
+        }
+    }
 
+    // Appends every texture of the given slot; returns how many were found
+    static std::size_t collectTextures(const aiMaterial* mat, aiTextureType type, const aiScene* scene,
+                                       const std::filesystem::path& baseDir, const std::vector<std::string>& embeddedKeys,
+                                       std::vector<TextureRef>& out)
+    {
         const unsigned int count = mat->GetTextureCount(type);
+        std::size_t found = 0;
         for(unsigned int i = 0; i < count; i++)
         {
             aiString rel;
             if (mat->GetTexture(type, i, &rel) != AI_SUCCESS) continue;
 
-            // canonical full path (handles relative vs absolute and / vs \)
-            const std::string canon = canonicalUnderBase(rel.C_Str());
-
-            // cache check
-            if (auto it = m_TextureCache.find(canon); it != m_TextureCache.end())
+            // "*N", or (FBX) the file name of an embedded texture
+            const int embedded = scene ? scene->GetEmbeddedTextureAndIndex(rel.C_Str()).second : -1;
+            if (embedded >= 0 && static_cast<std::size_t>(embedded) < embeddedKeys.size())
             {
-                if (auto sp = it->second.lock())
-                {
-                    out.push_back(sp);
-                    continue;
-                }
+                if (embeddedKeys[embedded].empty()) continue;
+                out.push_back({ embeddedKeys[embedded], toTextureType(type) });
             }
+            else
+                out.push_back({ ModelManager::ResolveTexturePath(baseDir, rel.C_Str()), toTextureType(type) });
+            ++found;
+        }
+        return found;
+    }
 
-            // decide TextureType
-            TextureType ttype = TextureType::DIFFUSE;
-            switch (type)
-            {
-                case aiTextureType_DIFFUSE:       ttype = TextureType::DIFFUSE;       break;
-                case aiTextureType_SPECULAR:      ttype = TextureType::SPECULAR;      break;
-                case aiTextureType_NORMALS:       ttype = TextureType::NORMAL;        break;
-                case aiTextureType_HEIGHT:        ttype = TextureType::HEIGHT;        break;
-                case aiTextureType_DISPLACEMENT:  ttype = TextureType::HEIGHT;        break;
-                default:                          ttype = TextureType::DIFFUSE;       break;
-            }
+    MaterialData ModelManager::ConvertMaterial(const aiScene* scene, const aiMaterial *mat, const std::filesystem::path& baseDir,
+                                               const std::vector<std::string>& embeddedKeys)
+    {
+        MaterialData out;
+        auto collect = [&](aiTextureType type) { return collectTextures(mat, type, scene, baseDir, embeddedKeys, out.Textures); };
+
+        collect(aiTextureType_DIFFUSE);
+        if (!out.Textures.empty())
+            out.DiffuseMap = out.Textures.front().Path;
+
+        const std::size_t specularBegin = out.Textures.size();
+        if (collect(aiTextureType_SPECULAR) > 0)
+            out.SpecularMap = out.Textures[specularBegin].Path;
+
+        // normals: prefer NORMALS, then fallback to HEIGHT or DISPLACEMENT (quirky exporters)
+        if (collect(aiTextureType_NORMALS) == 0 &&
+            collect(aiTextureType_HEIGHT) == 0)
+            collect(aiTextureType_DISPLACEMENT);
+
+        // height/displacement (optional)
+        if (collect(aiTextureType_HEIGHT) == 0)
+            collect(aiTextureType_DISPLACEMENT);
+
+        float shininess = 32.0f;
+        mat->Get(AI_MATKEY_SHININESS, shininess);
+        out.Shininess = std::max(1.0f, std::min(shininess, 1000.0f) * 0.128f);
+
+        aiColor3D kd(1.0f, 1.0f, 1.0f);
+        mat->Get(AI_MATKEY_COLOR_DIFFUSE, kd);
+        out.DiffuseColor = glm::vec3(kd.r, kd.g, kd.b);
+
+        aiColor3D ks(0.0f, 0.0f, 0.0f);
+        mat->Get(AI_MATKEY_COLOR_SPECULAR, ks);
+        out.SpecularColor = glm::vec3(ks.r, ks.g, ks.b);
 
-            auto tex = TextureManager::LoadTexture(canon, ttype);
-            if (tex)
-            {
-                m_TextureCache[canon] = tex;   // store weak_ptr
-                out.push_back(tex);
-            }
-        }
         return out;
     }
 }
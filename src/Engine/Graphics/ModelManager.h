@@ -3,23 +3,84 @@
  * This class is responsible for loading model files, processing their data,
  * and providing access to the resulting model objects.
  * It uses the Assimp library for importing various 3D model formats.
+ *
+ * Importing is split in two halves so it can run without blocking the frame:
+ * ImportScene parses, converts meshes and decodes textures with no GL calls (any thread),
+ * UploadStep then creates the GL objects a little at a time on the GL thread.
+ * ImportModelAsync drives both halves through a ModelImportJob; LoadModel runs them back to back.
+ * .obj, .gltf/.glb, .stl and .ply files go through native loaders (ObjLoader, GltfLoader,
+ * StlLoader, PlyLoader) instead of Assimp. For the formats Assimp still handles, vertex welding,
+ * normal and tangent generation run as parallel engine stages by default, and every MeshData
+ * mesh is reordered for the vertex cache by MeshOptimizer (PostProcessOptions).
+ * The node tree is kept as ImportedScene::Nodes; each mesh is converted once however many
+ * nodes place it, and the Model draws repeated placements instanced.
+ * Every stage of an import is timed into an ImportProfile, which the finished Model keeps.
+ * While a background import runs, its ModelImportJob draws a coarse block proxy (ImportPreview).
  */
 
 #pragma once
 #include "Utility/config.h"
 #include "Model.h"
 #include "Mesh.h"
+#include "MeshData.h"
+#include "ImportedScene.h"
+#include "MeshProcessing.h"
+#include "Utility/ThreadPool.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <filesystem>
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 namespace isaacObjectViewer
 {
+    class ModelImportJob;
+    struct MeshCacheKey;
+
+    /// @brief GL-thread state of an import that is being uploaded in steps.
+    struct ModelUpload
+    {
+        std::unique_ptr<ImportedScene> Scene;
+        std::size_t                    NextImage { 0 };
+        std::size_t                    NextMesh  { 0 };
+        std::size_t                    NextStreamMesh { 0 };
+        /// @brief GL textures created for the model's images.
+        std::size_t                    TexturesCreated { 0 };
+        bool                           MaterialsBuilt { false };
+        /// @brief What the meshes keep on the CPU once uploaded (PostProcessOptions::Residency).
+        CpuResidency                   Residency { CpuResidency::Picking };
+
+        /// @brief Engine materials, one per ImportedScene::Materials entry.
+        std::vector<Material>                              Materials;
+        /// @brief Textures bound to meshes, one list per ImportedScene::Materials entry.
+        std::vector<std::vector<std::shared_ptr<Texture>>> MaterialTextures;
+        std::vector<Mesh>                                  Meshes;
+    };
+
     class ModelManager 
     {
     public:
+        /// @brief The importers a model can be loaded with.
+        enum class ImportLoader : unsigned int
+        {
+            Assimp = 0,
+            Obj,
+            Gltf,
+            Stl,
+            Ply,
+        };
+
+        /// @brief What UpdateMeshCache did with a model.
+        enum class CacheResult : unsigned int
+        {
+            /// @brief The cache entry matched the source; nothing was imported.
+            UpToDate = 0,
+            Written,
+            /// @brief The format is read straight from the file and has no cache entry (glTF, STL, PLY).
+            NotCached,
+            Failed,
+        };
 
         /// @brief Gets the instance of the ModelManager.
         /// @return The instance of the ModelManager.
@@ -29,44 +90,240 @@ namespace isaacObjectViewer
             return instance;
         }
 
-        /// @brief Loads a 3D model from a file.
+        /// @brief Loads a 3D model from a file, blocking until it is ready.
         /// @param path The path to the model file.
+        /// @param options Which implementation runs each post-processing stage.
         /// @return A pointer to the loaded Model object, or nullptr if loading failed.
-        Model* LoadModel(const std::string& path);
+        Model* LoadModel(const std::string& path, const PostProcessOptions& options = {});
+
+        /// @brief Starts importing a model on a background thread.
+        /// Finished models are returned by UpdateImports.
+        /// @param path The path to the model file.
+        /// @param options Which implementation runs each post-processing stage.
+        void ImportModelAsync(const std::string& path, const PostProcessOptions& options = {});
+
+        /// @brief Advances background imports; must run on the GL thread once per frame.
+        /// @param budgetMs Time the GL uploads may take this frame, in milliseconds.
+        /// @return Models that finished this frame. The caller takes ownership.
+        std::vector<Model*> UpdateImports(float budgetMs);
 
-        /// @brief Processes a node in the Assimp scene.
+        /// @brief Cancels every running import and waits for their threads to exit.
+        void CancelImports();
+
+        /// @brief Gets the imports that are still running.
+        /// @return The running import jobs.
+        const std::vector<std::unique_ptr<ModelImportJob>>& GetImportJobs() const { return m_ImportJobs; }
+
+        /// @brief Prepares all CPU-side data of a model. Makes no GL calls.
+        /// Geometry comes from the mesh cache when it holds a current entry; otherwise the
+        /// model is parsed and the cache entry is (re)written. glTF skips the cache: its
+        /// buffers are already GPU-ready and are uploaded from the mapped file directly.
+        /// @param path The path to the model file.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the import. With
+        /// progressive imports on, block proxies of the model are published to it as they become available.
+        /// @param options Which implementation runs each post-processing stage of an Assimp import.
+        /// @return The imported scene, or nullptr if the import failed or was cancelled.
+        static std::unique_ptr<ImportedScene> ImportScene(const std::string& path, ImportProgress* progress = nullptr,
+                                                          const PostProcessOptions& options = {});
+
+        /// @brief Brings the mesh cache entry of a model up to date without decoding its textures or
+        /// touching GL; what ImportScene would write on a cache miss. Used by the iov-convert tool.
+        /// @param path The path to the model file.
+        /// @param options The post-processing the entry is built with; it is part of the cache key.
+        /// @param force True to rebuild the entry even when it is current.
+        /// @param outTextures Optional; receives the texture files the model's materials reference
+        /// when the model was parsed (not for UpToDate).
+        /// @return What was done.
+        static CacheResult UpdateMeshCache(const std::string& path, const PostProcessOptions& options = {}, bool force = false,
+                                           std::vector<std::string>* outTextures = nullptr);
+
+        /// @brief Creates GL objects for an imported scene until the time budget runs out.
+        /// @param upload The upload state; Scene must be set.
+        /// @param budgetMs Time budget in milliseconds; at least one item is uploaded per call.
+        /// @param progress Optional progress record to update.
+        /// @return True once everything has been uploaded.
+        static bool   UploadStep(ModelUpload& upload, float budgetMs, ImportProgress* progress = nullptr);
+
+        /// @brief Builds the Model from a completed upload.
+        /// @param upload The upload state; UploadStep must have returned true.
+        /// @return The new Model. The caller takes ownership.
+        static Model* FinishUpload(ModelUpload& upload);
+
+        /// @brief Copies a node and its subtree into a transform tree, parents first.
         /// @param node The node to process.
         /// @param scene The Assimp scene.
-        void   ProcessNode(aiNode *node, const aiScene *scene);
-        
-        /// @brief Processes a mesh in the Assimp scene.
-        /// @param mesh The mesh to process.
+        /// @param nodes Receives the nodes; their Meshes hold scene mesh indices.
+        /// @param parent Index of the node's parent in nodes, or -1 for the root.
+        static void   ProcessNode(aiNode *node, const aiScene *scene, std::vector<SceneNode>& nodes, int parent = -1);
+
+        /// @brief Converts one Assimp mesh into CPU-side vertex/index arrays.
+        /// Touches no GL or shared state, so it is safe to call from worker threads.
+        /// @param mesh The mesh to convert.
+        /// @param pool Pool used to split the streams of very large meshes; nullptr converts serially.
+        /// @return The converted mesh data.
+        static MeshData ConvertMesh(const aiMesh *mesh, ThreadPool* pool = nullptr);
+
+        /// @brief Converts the given scene meshes across a worker pool.
+        /// The output order always matches meshOrder, whatever the thread count.
         /// @param scene The Assimp scene.
-        /// @return The processed Mesh object.
-        Mesh   ProcessMesh(aiMesh *mesh, const aiScene *scene);
+        /// @param meshOrder Scene mesh indices, each once, in the order nodes first reference them.
+        /// @param pool The pool to fan out on.
+        /// @param progress Optional progress record; remaining meshes are skipped once cancel is requested.
+        /// @return One MeshData per entry in meshOrder.
+        static std::vector<MeshData> ConvertMeshes(const aiScene *scene,
+                                                   const std::vector<unsigned int>& meshOrder,
+                                                   ThreadPool& pool,
+                                                   ImportProgress* progress = nullptr);
+
+        /// @brief Runs the engine post-processing stages selected in options on converted meshes.
+        /// Normals are only generated for meshes Assimp delivered without them, tangents only
+        /// for meshes with UVs but without tangents; welding runs last.
+        /// @param scene The Assimp scene the meshes were converted from.
+        /// @param meshOrder Scene mesh indices, as passed to ConvertMeshes.
+        /// @param meshes The converted meshes, one per entry in meshOrder; updated in place.
+        /// @param options Which stages run in the engine.
+        /// @param pool The pool to fan out on.
+        /// @param progress Optional progress record; remaining meshes are skipped once cancel is requested.
+        static void PostProcessMeshes(const aiScene *scene,
+                                      const std::vector<unsigned int>& meshOrder,
+                                      std::vector<MeshData>& meshes,
+                                      const PostProcessOptions& options,
+                                      ThreadPool& pool,
+                                      ImportProgress* progress = nullptr);
 
-        /// @brief Loads the material textures for a mesh.
-        /// @param mat The material to load textures from.
-        /// @param type The type of texture to load.
-        /// @param debugTypeName A debug name for the texture type.
-        /// @return A vector of shared pointers to the loaded textures.
-        std::vector<std::shared_ptr<Texture>> LoadMaterialTextures(
-            aiMaterial *mat, aiTextureType type, const char* debugTypeName);
+        /// @brief Merges materials that would render identically and points meshes at the survivors.
+        /// @param scene The imported scene; Materials and the meshes' MaterialIndex are updated.
+        /// @return The number of materials removed.
+        static std::size_t DeduplicateMaterials(ImportedScene& scene);
+
+        /// @brief Records the vertex cache efficiency of every MeshData mesh in its Stats, after
+        /// reordering it with MeshOptimizer if requested. Meshes are processed in parallel.
+        /// @param scene The imported scene.
+        /// @param reorder True to run MeshOptimizer; false only measures.
+        /// @param pool The pool to fan out on.
+        static void OptimizeMeshes(ImportedScene& scene, bool reorder, ThreadPool& pool);
+
+        /// @brief Splits every MeshData mesh over MeshProcessing::kMaxShortIndexVertices vertices into
+        /// parts that take 16-bit indices, and points the nodes at all parts. Batches are left alone
+        /// (they are built under the limit). Meshes are split in parallel.
+        /// @param scene The imported scene.
+        /// @param pool The pool to fan out on.
+        /// @return The number of meshes added.
+        static std::size_t SplitForShortIndices(ImportedScene& scene, ThreadPool& pool);
+
+        /// @brief Builds the LOD chain of every MeshData mesh (MeshSimplifier::BuildLodChain).
+        /// Batched meshes are skipped: their parts are picked apart by index range. Meshes are processed in parallel.
+        /// @param scene The imported scene; each mesh's Lods are set.
+        /// @param pool The pool to fan out on.
+        /// @return The number of levels built.
+        static std::size_t GenerateLods(ImportedScene& scene, ThreadPool& pool);
+
+        /// @brief Clusters every MeshData mesh large enough to be worth culling (MeshletBuilder::Build).
+        /// Meshes are processed in parallel.
+        /// @param scene The imported scene; each mesh's Meshlets are set.
+        /// @param pool The pool to fan out on.
+        /// @param batchesOnly True to cluster only meshes static batching merged, which are built after
+        /// the derived entry is applied; the others keep their meshlets.
+        /// @return The number of meshlets built.
+        static std::size_t BuildMeshlets(ImportedScene& scene, ThreadPool& pool, bool batchesOnly = false);
+
+        /// @brief Chooses the upload format of every MeshData mesh (VertexPacker::SelectFormat),
+        /// keeping tangents only under a normal map. Meshes are processed in parallel.
+        /// @param scene The imported scene; each mesh's Format is set.
+        /// @param quantize True to allow the quantized encodings.
+        /// @param pool The pool to fan out on.
+        static void SelectVertexFormats(ImportedScene& scene, bool quantize, ThreadPool& pool);
+
+        /// @brief Gets the Assimp post-processing flags for an import.
+        /// @param options Stages set to PostProcessMode::Assimp add their flag.
+        /// @return The flags to pass to Assimp::Importer::ReadFile.
+        static unsigned int GetImportFlags(const PostProcessOptions& options);
+
+        /// @brief Reads the textures and colors of an Assimp material.
+        /// @param scene The scene the material belongs to, for its embedded textures; may be nullptr.
+        /// @param mat The material to read.
+        /// @param baseDir The directory texture paths are relative to.
+        /// @param embeddedKeys Per scene texture, the key it was registered under (ImportedScene::AddEmbeddedImage).
+        /// @return The CPU-side material description.
+        static MaterialData ConvertMaterial(const aiScene* scene, const aiMaterial *mat, const std::filesystem::path& baseDir,
+                                            const std::vector<std::string>& embeddedKeys);
+
+        /// @brief Picks the importer for a file: the native loader for its extension when there
+        /// is one (and native loaders are enabled), Assimp otherwise.
+        /// @param path The path to the model file.
+        /// @return The importer to use.
+        static ImportLoader ChooseLoader(const std::string& path);
+
+        /// @brief Enables or disables the native (non-Assimp) loaders.
+        /// @param enabled False routes every format through Assimp.
+        static void SetNativeLoadersEnabled(bool enabled) { s_NativeLoadersEnabled = enabled; }
+
+        /// @brief Enables or disables writing each finished import's profile as JSON
+        /// (to ImportProfile::GetDirectory()).
+        /// @param enabled True to write a file per import.
+        static void SetWriteProfiles(bool enabled) { s_WriteProfiles = enabled; }
+
+        /// @brief Checks if import profiles are written as JSON.
+        /// @return True if a file is written per import.
+        static bool IsWritingProfiles() { return s_WriteProfiles; }
+
+        /// @brief Enables or disables the block proxy (ImportPreview) background imports show
+        /// until the model is uploaded.
+        /// @param enabled True to publish a proxy from the file and another from the parsed scene.
+        static void SetProgressiveImports(bool enabled) { s_ProgressiveImports = enabled; }
+
+        /// @brief Checks if background imports show a proxy.
+        /// @return True if a proxy is shown while importing.
+        static bool IsProgressiveImports() { return s_ProgressiveImports; }
+
+        /// @brief Resolves a path referenced by a model file to a canonical full path.
+        /// Handles relative vs absolute paths and / vs \ separators, so each texture is cached once.
+        /// @param baseDir The directory of the model file.
+        /// @param path The path as written in the model or material file.
+        /// @return The canonical full path.
+        static std::string ResolveTexturePath(const std::filesystem::path& baseDir, const std::string& path);
 
     private:
+        /// @brief Parses a model with the given importer and converts its meshes and materials.
+        /// @param path The path to the model file.
+        /// @param loader The importer to use.
+        /// @param progress The progress record; its CancelRequested flag aborts the parse.
+        /// @param options Which implementation runs each post-processing stage of an Assimp import.
+        /// @return The scene without decoded images, or nullptr if parsing failed or was cancelled.
+        static std::unique_ptr<ImportedScene> ParseScene(const std::string& path, ImportLoader loader, ImportProgress* progress,
+                                                         const PostProcessOptions& options);
+
+        /// @brief Parses a model and runs the stages whose results the mesh cache stores:
+        /// material merging, mesh optimization, splitting for 16-bit indices, the LOD chains,
+        /// the meshlets, static batching and the choice of vertex formats.
+        /// @param path The path to the model file.
+        /// @param loader The importer to use.
+        /// @param progress The progress record; its CancelRequested flag aborts the parse.
+        /// @param options Which implementation runs each post-processing stage.
+        /// @param pool The pool to fan out on.
+        /// @param derivedKey For loaders without a mesh cache entry: the key of their derived entry,
+        /// which the LOD chains and meshlets are read from or written to (MeshCache::ReadDerived); nullptr for none.
+        /// @return The scene without decoded images, or nullptr if parsing failed or was cancelled.
+        static std::unique_ptr<ImportedScene> BuildScene(const std::string& path, ImportLoader loader, ImportProgress* progress,
+                                                         const PostProcessOptions& options, ThreadPool& pool,
+                                                         const MeshCacheKey* derivedKey = nullptr);
+
+        /// @brief Decodes every texture the scene's materials reference that isn't loaded yet;
+        /// embedded images are decoded straight from memory.
+        /// @param scene The scene; Images is filled in.
+        /// @param pool The pool to decode on.
+        /// @param progress The progress record.
+        /// @return False if the import was cancelled.
+        static bool DecodeTextures(ImportedScene& scene, ThreadPool& pool, ImportProgress* progress);
+
         /// @brief Constructs a ModelManager object.
-        ModelManager() 
-            : m_BaseDir()
-            , m_Meshes()
-        { }
-
-        // robust base-dir (works on / and \)
-        std::filesystem::path m_BaseDir;
-        std::vector<Mesh>     m_Meshes;
-
-        // canonical-path texture cache to avoid reloading duplicates
-        std::unordered_map<std::string, std::weak_ptr<Texture>> m_TextureCache;
-    
-        std::string canonicalUnderBase(const std::filesystem::path& p) const;
+        ModelManager();
+        ~ModelManager();
+
+        std::vector<std::unique_ptr<ModelImportJob>> m_ImportJobs;
+
+        static inline bool s_NativeLoadersEnabled = true;
+        static inline bool s_WriteProfiles = false;
+        static inline bool s_ProgressiveImports = true;
     };
 }
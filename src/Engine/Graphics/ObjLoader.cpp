@@ -0,0 +1,809 @@
+#include "ObjLoader.h"
+#include "ModelManager.h"
+#include "Utility/Arena.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include "Utility/ThreadPool.h"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "tiny_obj_loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace isaacObjectViewer
+{
+    // --- tokenizer -----------------------------------------------------------
+
+    static constexpr std::int32_t kMissing = std::numeric_limits<std::int32_t>::min();
+
+    // one triangle corner: zero-based v/vt/vn indices, kMissing when absent
+    struct ObjCorner
+    {
+        std::int32_t V, T, N;
+
+        bool operator==(const ObjCorner& o) const { return V == o.V && T == o.T && N == o.N; }
+    };
+
+    // a usemtl / o / g statement, effective from corner index Corner onwards
+    struct ObjSwitch
+    {
+        std::size_t Corner;
+        bool        IsMaterial;
+        std::string Name;
+    };
+
+    // what one chunk of the file produced; indices are fixed up once all chunks are done
+    struct ObjChunk
+    {
+        std::vector<glm::vec3>   Positions;
+        std::vector<glm::vec2>   TexCoords;
+        std::vector<glm::vec3>   Normals;
+        std::vector<ObjCorner>   Corners;    // 3 per triangle
+        std::vector<std::size_t> Relative;   // corner * 3 + component of negative (chunk-relative) indices
+        std::vector<ObjSwitch>   Switches;
+        std::vector<std::string> MtlLibs;
+        std::size_t              Skipped = 0;
+    };
+
+    static inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static inline void skipBlanks(const char*& p, const char* end)
+    {
+        while (p < end && isBlank(*p))
+            ++p;
+    }
+
+    // matches a keyword followed by whitespace (or end of line)
+    static inline bool keyword(const char*& p, const char* end, const char* word, std::size_t len)
+    {
+        if (std::size_t(end - p) < len || std::memcmp(p, word, len) != 0)
+            return false;
+        if (p + len < end && !isBlank(p[len]))
+            return false;
+        p += len;
+        return true;
+    }
+
+    static inline float parseFloat(const char*& p, const char* end)
+    {
+        skipBlanks(p, end);
+        if (p < end && *p == '+')
+            ++p;
+        float value = 0.0f;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec == std::errc())
+            p = result.ptr;
+        else
+            while (p < end && !isBlank(*p)) ++p; // skip malformed token
+        return value;
+    }
+
+    static inline bool parseInt(const char*& p, const char* end, std::int64_t& value)
+    {
+        if (p < end && *p == '+')
+            ++p;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc())
+            return false;
+        p = result.ptr;
+        return true;
+    }
+
+    static std::string restOfLine(const char* p, const char* end)
+    {
+        skipBlanks(p, end);
+        const char* stop = p;
+        while (stop < end && *stop != '#')
+            ++stop;
+        while (stop > p && isBlank(stop[-1]))
+            --stop;
+        return std::string(p, stop);
+    }
+
+    // converts a 1-based (or negative, relative) OBJ index; relative ones are resolved against
+    // the chunk-local count here and rebased onto the global count later
+    static inline std::int32_t resolveIndex(std::int64_t idx, std::size_t localCount, bool& relative)
+    {
+        relative = false;
+        if (idx > 0 && idx <= std::numeric_limits<std::int32_t>::max())
+            return static_cast<std::int32_t>(idx - 1);
+        if (idx < 0 && idx >= std::numeric_limits<std::int32_t>::min() + 1)
+        {
+            relative = true;
+            return static_cast<std::int32_t>(static_cast<std::int64_t>(localCount) + idx);
+        }
+        return kMissing;
+    }
+
+    static void parseFace(const char* p, const char* end, ObjChunk& chunk)
+    {
+        struct PolyCorner { ObjCorner C; unsigned char Relative; };
+        thread_local std::vector<PolyCorner> poly;
+        poly.clear();
+
+        for (;;)
+        {
+            skipBlanks(p, end);
+            if (p >= end || *p == '#')
+                break;
+
+            PolyCorner pc { { kMissing, kMissing, kMissing }, 0 };
+            std::int64_t idx;
+            bool relative;
+
+            if (!parseInt(p, end, idx))
+                break;
+            pc.C.V = resolveIndex(idx, chunk.Positions.size(), relative);
+            pc.Relative |= relative ? 1 : 0;
+
+            if (p < end && *p == '/')
+            {
+                ++p;
+                if (p < end && *p != '/' && parseInt(p, end, idx))
+                {
+                    pc.C.T = resolveIndex(idx, chunk.TexCoords.size(), relative);
+                    pc.Relative |= relative ? 2 : 0;
+                }
+                if (p < end && *p == '/')
+                {
+                    ++p;
+                    if (parseInt(p, end, idx))
+                    {
+                        pc.C.N = resolveIndex(idx, chunk.Normals.size(), relative);
+                        pc.Relative |= relative ? 4 : 0;
+                    }
+                }
+            }
+            // skip anything unexpected up to the next corner
+            while (p < end && !isBlank(*p))
+                ++p;
+
+            poly.push_back(pc);
+        }
+
+        if (poly.size() < 3)
+        {
+            ++chunk.Skipped; // points and lines are not drawn
+            return;
+        }
+
+        // fan triangulation (OBJ polygons are convex in practice)
+        auto emit = [&](const PolyCorner& pc)
+        {
+            const std::size_t corner = chunk.Corners.size();
+            chunk.Corners.push_back(pc.C);
+            for (unsigned int c = 0; c < 3; ++c)
+                if (pc.Relative & (1u << c))
+                    chunk.Relative.push_back(corner * 3 + c);
+        };
+        for (std::size_t i = 1; i + 1 < poly.size(); ++i)
+        {
+            emit(poly[0]);
+            emit(poly[i]);
+            emit(poly[i + 1]);
+        }
+    }
+
+    static void parseChunk(const char* p, const char* end, ObjChunk& chunk)
+    {
+        while (p < end)
+        {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!lineEnd)
+                lineEnd = end;
+
+            const char* q = p;
+            skipBlanks(q, lineEnd);
+            if (q < lineEnd)
+            {
+                switch (*q)
+                {
+                    case 'v':
+                        if (keyword(q, lineEnd, "v", 1))
+                        {
+                            glm::vec3 v;
+                            v.x = parseFloat(q, lineEnd);
+                            v.y = parseFloat(q, lineEnd);
+                            v.z = parseFloat(q, lineEnd);
+                            chunk.Positions.push_back(v);
+                        }
+                        else if (keyword(q, lineEnd, "vt", 2))
+                        {
+                            glm::vec2 t;
+                            t.x = parseFloat(q, lineEnd);
+                            t.y = parseFloat(q, lineEnd);
+                            chunk.TexCoords.push_back(t);
+                        }
+                        else if (keyword(q, lineEnd, "vn", 2))
+                        {
+                            glm::vec3 n;
+                            n.x = parseFloat(q, lineEnd);
+                            n.y = parseFloat(q, lineEnd);
+                            n.z = parseFloat(q, lineEnd);
+                            chunk.Normals.push_back(n);
+                        }
+                        break;
+                    case 'f':
+                        if (keyword(q, lineEnd, "f", 1))
+                            parseFace(q, lineEnd, chunk);
+                        break;
+                    case 'u':
+                        if (keyword(q, lineEnd, "usemtl", 6))
+                            chunk.Switches.push_back({ chunk.Corners.size(), true, restOfLine(q, lineEnd) });
+                        break;
+                    case 'o':
+                    case 'g':
+                        if (keyword(q, lineEnd, "o", 1) || keyword(q, lineEnd, "g", 1))
+                            chunk.Switches.push_back({ chunk.Corners.size(), false, restOfLine(q, lineEnd) });
+                        break;
+                    case 'm':
+                        if (keyword(q, lineEnd, "mtllib", 6))
+                            chunk.MtlLibs.push_back(restOfLine(q, lineEnd));
+                        break;
+                    default:
+                        break; // comments, s, l, p, vp, ...
+                }
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+    // --- welding -------------------------------------------------------------
+
+    static inline std::uint64_t hashCorner(const ObjCorner& c)
+    {
+        std::uint64_t h = static_cast<std::uint32_t>(c.V) * 0x9E3779B97F4A7C15ull;
+        h ^= (static_cast<std::uint32_t>(c.T) + 0x7F4A7C15ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= (static_cast<std::uint32_t>(c.N) + 0x165667B1ull) * 0x165667B19E3779F9ull;
+        return h ^ (h >> 29);
+    }
+
+    // open-addressing corner -> vertex index table that grows as it fills
+    class CornerTable
+    {
+    public:
+        explicit CornerTable(std::size_t expected)
+        {
+            std::size_t capacity = 64;
+            while (capacity < expected * 2)
+                capacity <<= 1;
+            Resize(capacity);
+        }
+
+        // returns the vertex index of c, inserting next if it is new
+        std::uint32_t FindOrInsert(const ObjCorner& c, std::uint64_t hash, std::uint32_t next, bool& inserted)
+        {
+            if ((m_Count + 1) * 2 > m_Slots.size())
+                Resize(m_Slots.size() * 2);
+
+            std::size_t i = hash & m_Mask;
+            for (;;)
+            {
+                Slot& slot = m_Slots[i];
+                if (slot.Value == kEmpty)
+                {
+                    slot.Key   = c;
+                    slot.Value = next;
+                    ++m_Count;
+                    inserted = true;
+                    return next;
+                }
+                if (slot.Key == c)
+                {
+                    inserted = false;
+                    return slot.Value;
+                }
+                i = (i + 1) & m_Mask;
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t kEmpty = std::numeric_limits<std::uint32_t>::max();
+
+        struct Slot
+        {
+            ObjCorner     Key;
+            std::uint32_t Value;
+        };
+
+        void Resize(std::size_t capacity)
+        {
+            std::vector<Slot> old;
+            old.swap(m_Slots);
+            m_Slots.assign(capacity, Slot{ { 0, 0, 0 }, kEmpty });
+            m_Mask = capacity - 1;
+            for (const Slot& slot : old)
+            {
+                if (slot.Value == kEmpty)
+                    continue;
+                std::size_t i = hashCorner(slot.Key) & m_Mask;
+                while (m_Slots[i].Value != kEmpty)
+                    i = (i + 1) & m_Mask;
+                m_Slots[i] = slot;
+            }
+        }
+
+        std::vector<Slot> m_Slots;
+        std::size_t       m_Mask  = 0;
+        std::size_t       m_Count = 0;
+    };
+
+    // a run of consecutive faces sharing object/group and material; becomes one mesh
+    struct ObjRun
+    {
+        struct Range { std::size_t Chunk, Begin, End; };
+
+        std::string        Group;
+        std::string        Material;
+        std::vector<Range> Ranges;
+        std::size_t        CornerCount = 0;
+    };
+
+    struct ObjAttributes
+    {
+        std::vector<glm::vec3> Positions;
+        std::vector<glm::vec2> TexCoords;
+        std::vector<glm::vec3> Normals;
+    };
+
+    // runs above this many corners are welded by all workers, hash-partitioned
+    static constexpr std::size_t kParallelWeldCorners = std::size_t(1) << 18;
+
+    static constexpr std::size_t kNormalBlock = std::size_t(1) << 16;
+
+    // area-weighted smooth normals for the vertices flagged in lacksNormal; vn from the file are kept.
+    // Faces are summed per OBJ position (so UV seams stay smooth) into a dense array spanning the
+    // positions this mesh uses; shared positions are rare collisions, so relaxed atomics stay cheap
+    static void generateSmoothNormals(MeshData& mesh, const std::pmr::vector<std::int32_t>& vertexPosition,
+                                      const std::pmr::vector<char>& lacksNormal, ThreadPool& pool)
+    {
+        const std::size_t vertexCount = mesh.Vertices.size();
+        if (vertexCount == 0)
+            return;
+        const auto [lo, hi] = std::minmax_element(vertexPosition.begin(), vertexPosition.end());
+        const std::int32_t first = *lo;
+
+        ArenaScope scope;
+        std::pmr::vector<glm::vec3> sums(std::size_t(*hi - first) + 1, glm::vec3(0.0f), ScratchArena::Get());
+        const Vertex* vertices = mesh.Vertices.data();
+        const auto& idx = mesh.Indices;
+        const std::size_t triangleCount = idx.size() / 3;
+        pool.ParallelFor((triangleCount + kNormalBlock - 1) / kNormalBlock, [&](std::size_t b)
+        {
+            const std::size_t end = std::min(triangleCount, (b + 1) * kNormalBlock);
+            for (std::size_t t = b * kNormalBlock; t < end; ++t)
+            {
+                const unsigned int i[3] = { idx[t * 3], idx[t * 3 + 1], idx[t * 3 + 2] };
+                const glm::vec3 n = glm::cross(vertices[i[1]].Position - vertices[i[0]].Position,
+                                               vertices[i[2]].Position - vertices[i[0]].Position);
+                for (unsigned int v : i)
+                {
+                    glm::vec3& sum = sums[vertexPosition[v] - first];
+                    for (int c = 0; c < 3; ++c)
+                        std::atomic_ref<float>(sum[c]).fetch_add(n[c], std::memory_order_relaxed);
+                }
+            }
+        });
+
+        pool.ParallelFor((vertexCount + kNormalBlock - 1) / kNormalBlock, [&](std::size_t b)
+        {
+            const std::size_t end = std::min(vertexCount, (b + 1) * kNormalBlock);
+            for (std::size_t v = b * kNormalBlock; v < end; ++v)
+            {
+                if (!lacksNormal[v])
+                    continue;
+                const glm::vec3& n = sums[vertexPosition[v] - first];
+                const float len = glm::length(n);
+                mesh.Vertices[v].Normal = len > 0.0f ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        });
+    }
+
+    static MeshData buildMesh(const ObjRun& run, const std::vector<ObjChunk>& chunks,
+                              const ObjAttributes& attr, ThreadPool& pool)
+    {
+        MeshData out;
+        ArenaScope scope;
+
+        // run-local corner offsets of each range, so workers can write indices in place
+        std::pmr::vector<std::size_t> rangeStart(run.Ranges.size() + 1, 0, ScratchArena::Get());
+        for (std::size_t r = 0; r < run.Ranges.size(); ++r)
+            rangeStart[r + 1] = rangeStart[r] + (run.Ranges[r].End - run.Ranges[r].Begin);
+        const std::size_t cornerCount = rangeStart.back();
+
+        auto cornerAt = [&](std::size_t range, std::size_t i) -> const ObjCorner&
+        {
+            return chunks[run.Ranges[range].Chunk].Corners[run.Ranges[range].Begin + i];
+        };
+
+        // partitions weld independently: a corner only ever lands in the partition of its hash
+        const std::size_t partitions = cornerCount >= kParallelWeldCorners
+            ? std::min<std::size_t>(64, std::max<std::size_t>(1, (pool.GetThreadCount() + 1) * 2))
+            : 1;
+        auto partitionOf = [partitions](std::uint64_t hash) { return (hash >> 40) % partitions; };
+
+        // bucket corners by partition (counting sort, ranges in order keeps buckets ascending)
+        std::pmr::vector<std::uint32_t> bucketCounts(run.Ranges.size() * partitions, 0, ScratchArena::Get());
+        pool.ParallelFor(run.Ranges.size(), [&](std::size_t r)
+        {
+            std::uint32_t* counts = &bucketCounts[r * partitions];
+            const std::size_t n = run.Ranges[r].End - run.Ranges[r].Begin;
+            for (std::size_t i = 0; i < n; ++i)
+                ++counts[partitionOf(hashCorner(cornerAt(r, i)))];
+        });
+
+        std::pmr::vector<std::size_t> bucketOffset(run.Ranges.size() * partitions, ScratchArena::Get());
+        std::pmr::vector<std::size_t> partitionStart(partitions + 1, 0, ScratchArena::Get());
+        {
+            std::size_t offset = 0;
+            for (std::size_t p = 0; p < partitions; ++p)
+            {
+                partitionStart[p] = offset;
+                for (std::size_t r = 0; r < run.Ranges.size(); ++r)
+                {
+                    bucketOffset[r * partitions + p] = offset;
+                    offset += bucketCounts[r * partitions + p];
+                }
+            }
+            partitionStart[partitions] = offset;
+        }
+
+        std::pmr::vector<std::uint32_t> buckets(partitions > 1 ? cornerCount : 0, ScratchArena::Get());
+        if (partitions > 1)
+        {
+            pool.ParallelFor(run.Ranges.size(), [&](std::size_t r)
+            {
+                std::size_t* cursor = &bucketOffset[r * partitions];
+                const std::size_t n = run.Ranges[r].End - run.Ranges[r].Begin;
+                for (std::size_t i = 0; i < n; ++i)
+                    buckets[cursor[partitionOf(hashCorner(cornerAt(r, i)))]++] = static_cast<std::uint32_t>(rangeStart[r] + i);
+            });
+        }
+
+        // weld each partition; indices receive partition-local ids for now
+        out.Indices.resize(cornerCount);
+        std::vector<std::vector<ObjCorner>> uniques(partitions);
+        pool.ParallelFor(partitions, [&](std::size_t p)
+        {
+            const std::size_t begin = partitionStart[p];
+            const std::size_t end   = partitionStart[p + 1];
+            CornerTable table((end - begin) / 4 + 16);
+            std::vector<ObjCorner>& unique = uniques[p];
+
+            std::size_t range = 0;
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                const std::size_t local = partitions > 1 ? buckets[k] : k;
+                while (local >= rangeStart[range + 1])
+                    ++range;
+                const ObjCorner& c = cornerAt(range, local - rangeStart[range]);
+
+                bool inserted;
+                const std::uint32_t id = table.FindOrInsert(c, hashCorner(c), static_cast<std::uint32_t>(unique.size()), inserted);
+                if (inserted)
+                    unique.push_back(c);
+                out.Indices[local] = id;
+            }
+        });
+
+        std::pmr::vector<std::uint32_t> vertexBase(partitions + 1, 0, ScratchArena::Get());
+        for (std::size_t p = 0; p < partitions; ++p)
+            vertexBase[p + 1] = vertexBase[p] + static_cast<std::uint32_t>(uniques[p].size());
+
+        if (partitions > 1)
+        {
+            // rebase partition-local ids; the partition is recomputed from the corner's hash
+            pool.ParallelFor(run.Ranges.size(), [&](std::size_t r)
+            {
+                const std::size_t n = run.Ranges[r].End - run.Ranges[r].Begin;
+                for (std::size_t i = 0; i < n; ++i)
+                    out.Indices[rangeStart[r] + i] += vertexBase[partitionOf(hashCorner(cornerAt(r, i)))];
+            }, 1);
+        }
+
+        // vertices, FlipUVs applied like the Assimp path
+        out.Vertices.resize(vertexBase[partitions]);
+        std::pmr::vector<std::int32_t> vertexPosition(out.Vertices.size(), ScratchArena::Get());
+        std::pmr::vector<char> lacksNormal(out.Vertices.size(), 0, ScratchArena::Get());
+        std::pmr::vector<char> partitionLacksNormals(partitions, 0, ScratchArena::Get());
+        pool.ParallelFor(partitions, [&](std::size_t p)
+        {
+            Vertex* dst = out.Vertices.data() + vertexBase[p];
+            std::int32_t* pos = vertexPosition.data() + vertexBase[p];
+            char* lacks = lacksNormal.data() + vertexBase[p];
+            for (const ObjCorner& c : uniques[p])
+            {
+                dst->Position = attr.Positions[c.V];
+                if (c.T != kMissing)
+                    dst->TexCoords = glm::vec2(attr.TexCoords[c.T].x, 1.0f - attr.TexCoords[c.T].y);
+                if (c.N != kMissing)
+                    dst->Normal = attr.Normals[c.N];
+                else
+                    *lacks = partitionLacksNormals[p] = 1;
+                ++lacks;
+                *pos++ = c.V;
+                ++dst;
+            }
+        });
+        uniques.clear();
+
+        const bool missingNormals = std::find(partitionLacksNormals.begin(), partitionLacksNormals.end(), 1) != partitionLacksNormals.end();
+        if (missingNormals)
+            generateSmoothNormals(out, vertexPosition, lacksNormal, pool);
+        return out;
+    }
+
+    // --- materials -----------------------------------------------------------
+
+    static MaterialData toMaterialData(const tinyobj::material_t& m, const std::filesystem::path& baseDir)
+    {
+        MaterialData out;
+        auto addTexture = [&](const std::string& name, TextureType type) -> std::string
+        {
+            if (name.empty())
+                return {};
+            std::string path = ModelManager::ResolveTexturePath(baseDir, name);
+            out.Textures.push_back({ path, type });
+            return path;
+        };
+
+        out.DiffuseMap  = addTexture(m.diffuse_texname,  TextureType::DIFFUSE);
+        out.SpecularMap = addTexture(m.specular_texname, TextureType::SPECULAR);
+        addTexture(m.normal_texname, TextureType::NORMAL);
+        addTexture(m.bump_texname.empty() ? m.displacement_texname : m.bump_texname, TextureType::HEIGHT);
+
+        out.DiffuseColor  = glm::vec3(m.diffuse[0],  m.diffuse[1],  m.diffuse[2]);
+        out.SpecularColor = glm::vec3(m.specular[0], m.specular[1], m.specular[2]);
+        out.Shininess     = std::max(1.0f, std::min(float(m.shininess), 1000.0f) * 0.128f);
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+
+    // smallest chunk worth a task of its own
+    static constexpr std::size_t kMinChunkBytes = std::size_t(1) << 20;
+
+    std::unique_ptr<ImportedScene> ObjLoader::Load(const std::string& path, ThreadPool& pool, ImportProgress* progress)
+    {
+        MappedFile file(path);
+        if (!file.IsOpen())
+        {
+            LOG_ERROR("Failed to open OBJ file: {}", path);
+            if (progress)
+                progress->Enter(ImportStage::Failed);
+            return nullptr;
+        }
+        return LoadFromMemory(reinterpret_cast<const char*>(file.Data()), file.Size(),
+                              std::filesystem::path(path).parent_path(), pool, progress);
+    }
+
+    std::unique_ptr<ImportedScene> ObjLoader::LoadFromMemory(const char* data, std::size_t size,
+                                                             const std::filesystem::path& baseDir,
+                                                             ThreadPool& pool, ImportProgress* progress)
+    {
+        auto cancelled = [progress]()
+        {
+            if (!progress || !progress->CancelRequested.load())
+                return false;
+            progress->Enter(ImportStage::Cancelled);
+            return true;
+        };
+
+        // --- tokenize line-aligned chunks in parallel ---
+        if (progress)
+            progress->Enter(ImportStage::Parsing);
+
+        const std::size_t target = std::max(kMinChunkBytes, size / (std::size_t(pool.GetThreadCount() + 1) * 4));
+        std::vector<std::pair<std::size_t, std::size_t>> spans;
+        for (std::size_t begin = 0; begin < size;)
+        {
+            std::size_t end = std::min(size, begin + target);
+            if (end < size)
+            {
+                const void* nl = std::memchr(data + end, '\n', size - end);
+                end = nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - data) + 1 : size;
+            }
+            spans.emplace_back(begin, end);
+            begin = end;
+        }
+
+        std::vector<ObjChunk> chunks(spans.size());
+        std::atomic<std::size_t> parsedBytes { 0 };
+        pool.ParallelFor(spans.size(), [&](std::size_t c)
+        {
+            if (progress && progress->CancelRequested.load())
+                return;
+            parseChunk(data + spans[c].first, data + spans[c].second, chunks[c]);
+            const std::size_t done = parsedBytes.fetch_add(spans[c].second - spans[c].first) + (spans[c].second - spans[c].first);
+            if (progress)
+                progress->Fraction.store(float(done) / float(size));
+        });
+        if (cancelled())
+            return nullptr;
+
+        if (progress)
+            progress->Enter(ImportStage::Converting);
+
+        // --- merge attributes and rebase chunk-relative indices ---
+        std::vector<std::size_t> baseV(chunks.size() + 1, 0), baseT(chunks.size() + 1, 0), baseN(chunks.size() + 1, 0);
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+        {
+            baseV[c + 1] = baseV[c] + chunks[c].Positions.size();
+            baseT[c + 1] = baseT[c] + chunks[c].TexCoords.size();
+            baseN[c + 1] = baseN[c] + chunks[c].Normals.size();
+        }
+
+        ObjAttributes attr;
+        attr.Positions.resize(baseV.back());
+        attr.TexCoords.resize(baseT.back());
+        attr.Normals.resize(baseN.back());
+
+        std::atomic<std::size_t> invalidFaces { 0 };
+        pool.ParallelFor(chunks.size(), [&](std::size_t c)
+        {
+            ObjChunk& chunk = chunks[c];
+            std::copy(chunk.Positions.begin(), chunk.Positions.end(), attr.Positions.begin() + baseV[c]);
+            std::copy(chunk.TexCoords.begin(), chunk.TexCoords.end(), attr.TexCoords.begin() + baseT[c]);
+            std::copy(chunk.Normals.begin(),   chunk.Normals.end(),   attr.Normals.begin()   + baseN[c]);
+            std::vector<glm::vec3>().swap(chunk.Positions);
+            std::vector<glm::vec2>().swap(chunk.TexCoords);
+            std::vector<glm::vec3>().swap(chunk.Normals);
+
+            const std::int64_t base[3] = { std::int64_t(baseV[c]), std::int64_t(baseT[c]), std::int64_t(baseN[c]) };
+            for (std::size_t rel : chunk.Relative)
+            {
+                ObjCorner& corner = chunk.Corners[rel / 3];
+                std::int32_t& component = rel % 3 == 0 ? corner.V : (rel % 3 == 1 ? corner.T : corner.N);
+                component = static_cast<std::int32_t>(component + base[rel % 3]);
+            }
+
+            // out-of-range uv/normal references are dropped; bad positions drop the whole triangle
+            const std::int64_t limit[3] = { std::int64_t(baseV.back()), std::int64_t(baseT.back()), std::int64_t(baseN.back()) };
+            std::size_t kept = 0;
+            std::size_t sw   = 0; // switches sit on triangle boundaries and move with the compaction
+            for (std::size_t t = 0; t + 2 < chunk.Corners.size(); t += 3)
+            {
+                while (sw < chunk.Switches.size() && chunk.Switches[sw].Corner <= t)
+                    chunk.Switches[sw++].Corner = kept;
+
+                bool valid = true;
+                for (int k = 0; k < 3; ++k)
+                {
+                    ObjCorner& corner = chunk.Corners[t + k];
+                    valid &= corner.V >= 0 && corner.V < limit[0];
+                    if (corner.T != kMissing && (corner.T < 0 || corner.T >= limit[1])) corner.T = kMissing;
+                    if (corner.N != kMissing && (corner.N < 0 || corner.N >= limit[2])) corner.N = kMissing;
+                }
+                if (!valid)
+                {
+                    invalidFaces.fetch_add(1);
+                    continue;
+                }
+                if (kept != t)
+                    std::copy(chunk.Corners.begin() + t, chunk.Corners.begin() + t + 3, chunk.Corners.begin() + kept);
+                kept += 3;
+            }
+            while (sw < chunk.Switches.size())
+                chunk.Switches[sw++].Corner = kept;
+            chunk.Corners.resize(kept);
+        });
+        if (invalidFaces.load() > 0)
+            LOG_ERROR("OBJ: skipped {} faces with out-of-range vertex indices", invalidFaces.load());
+
+        // --- split into runs of faces with the same object/group and material ---
+        std::vector<ObjRun> runs;
+        {
+            std::string group, material;
+            bool startNew = true;
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+            {
+                auto append = [&](std::size_t begin, std::size_t end)
+                {
+                    if (begin >= end)
+                        return;
+                    if (startNew || runs.empty())
+                    {
+                        runs.push_back({ group, material, {}, 0 });
+                        startNew = false;
+                    }
+                    runs.back().Ranges.push_back({ c, begin, end });
+                    runs.back().CornerCount += end - begin;
+                };
+
+                std::size_t cursor = 0;
+                for (const ObjSwitch& s : chunks[c].Switches)
+                {
+                    append(cursor, s.Corner);
+                    cursor = std::max(cursor, s.Corner);
+                    std::string& current = s.IsMaterial ? material : group;
+                    if (current != s.Name)
+                    {
+                        current = s.Name;
+                        startNew = true;
+                    }
+                }
+                append(cursor, chunks[c].Corners.size());
+            }
+        }
+
+        // --- materials ---
+        auto scene = std::make_unique<ImportedScene>();
+
+        std::map<std::string, int> materialIds;
+        std::vector<tinyobj::material_t> materials;
+        std::vector<std::string> loadedLibs;
+        for (const ObjChunk& chunk : chunks)
+        {
+            for (const std::string& lib : chunk.MtlLibs)
+            {
+                if (std::find(loadedLibs.begin(), loadedLibs.end(), lib) != loadedLibs.end())
+                    continue;
+                loadedLibs.push_back(lib);
+
+                const std::string libPath = ModelManager::ResolveTexturePath(baseDir, lib);
+                // a missing library counts too: creating it changes the materials
+                scene->Dependencies.push_back(libPath);
+                std::ifstream stream(libPath);
+                if (!stream)
+                {
+                    LOG_ERROR("OBJ: material library not found: {}", libPath);
+                    continue;
+                }
+                std::string warn, err;
+                tinyobj::LoadMtl(&materialIds, &materials, &stream, &warn, &err);
+                if (!err.empty())
+                    LOG_ERROR("OBJ: {}: {}", libPath, err);
+            }
+        }
+
+        scene->Materials.reserve(materials.size() + 1);
+        for (const tinyobj::material_t& m : materials)
+            scene->Materials.push_back(toMaterialData(m, baseDir));
+
+        unsigned int defaultMaterial = std::numeric_limits<unsigned int>::max();
+        auto materialIndexOf = [&](const std::string& name) -> unsigned int
+        {
+            if (auto it = materialIds.find(name); it != materialIds.end())
+                return static_cast<unsigned int>(it->second);
+            if (defaultMaterial == std::numeric_limits<unsigned int>::max())
+            {
+                defaultMaterial = static_cast<unsigned int>(scene->Materials.size());
+                scene->Materials.emplace_back();
+            }
+            return defaultMaterial;
+        };
+
+        // --- weld each run into a mesh ---
+        scene->Meshes.resize(runs.size());
+        for (std::size_t r = 0; r < runs.size(); ++r)
+        {
+            scene->Meshes[r].Name          = runs[r].Group;
+            scene->Meshes[r].MaterialIndex = materialIndexOf(runs[r].Material);
+        }
+
+        std::atomic<std::size_t> welded { 0 };
+        pool.ParallelFor(runs.size(), [&](std::size_t r)
+        {
+            if (progress && progress->CancelRequested.load())
+                return;
+
+            MeshData mesh = buildMesh(runs[r], chunks, attr, pool);
+            mesh.Name          = std::move(scene->Meshes[r].Name);
+            mesh.MaterialIndex = scene->Meshes[r].MaterialIndex;
+            scene->Meshes[r]   = std::move(mesh);
+
+            if (progress)
+                progress->Fraction.store(float(welded.fetch_add(1) + 1) / float(runs.size()));
+        });
+        if (cancelled())
+            return nullptr;
+
+        std::erase_if(scene->Meshes, [](const MeshData& mesh) { return mesh.Empty(); });
+        return scene;
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file ObjLoader.h
+ * @brief Native Wavefront OBJ importer.
+ * The file is memory-mapped and split into line-aligned chunks that are tokenized in
+ * parallel. Faces are fan-triangulated and their v/vt/vn triples are welded into
+ * indexed vertices with a hash table partitioned across the worker pool.
+ * Materials are read from the referenced .mtl libraries with tinyobj::LoadMtl.
+ *
+ * Produces the same ImportedScene as the Assimp path (FlipUVs, generated smooth normals
+ * for meshes without vn), so ModelManager can use it transparently for .obj files.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    class ObjLoader
+    {
+    public:
+        /// @brief Loads an OBJ file and the material libraries it references.
+        /// @param path The path to the .obj file.
+        /// @param pool The pool to tokenize and weld on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene (without decoded images), or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> Load(const std::string& path, ThreadPool& pool,
+                                                   ImportProgress* progress = nullptr);
+
+        /// @brief Loads OBJ text that is already in memory.
+        /// @param data The OBJ text.
+        /// @param size The size of the text in bytes.
+        /// @param baseDir The directory mtllib and texture paths are relative to.
+        /// @param pool The pool to tokenize and weld on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene (without decoded images), or nullptr on cancel.
+        static std::unique_ptr<ImportedScene> LoadFromMemory(const char* data, std::size_t size,
+                                                             const std::filesystem::path& baseDir,
+                                                             ThreadPool& pool,
+                                                             ImportProgress* progress = nullptr);
+
+    private:
+        ObjLoader() = delete;
+    };
+}
@@ -0,0 +1,721 @@
+#include "PlyLoader.h"
+#include "MeshProcessing.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include "Utility/MemoryStats.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+
+namespace isaacObjectViewer
+{
+    // --- header --------------------------------------------------------------
+
+    enum class PlyType : std::uint8_t
+    {
+        Invalid,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    enum class PlyFormat
+    {
+        Ascii,
+        BinaryLittleEndian,
+        BinaryBigEndian
+    };
+
+    struct PlyProperty
+    {
+        std::string Name;
+        PlyType     Type      { PlyType::Invalid }; // value type, or index type of a list
+        PlyType     CountType { PlyType::Invalid }; // list length type; Invalid for scalars
+        std::size_t Offset    { 0 };                // byte offset in a fixed-size record
+
+        bool IsList() const { return CountType != PlyType::Invalid; }
+    };
+
+    struct PlyElement
+    {
+        std::string              Name;
+        std::size_t              Count     { 0 };
+        std::vector<PlyProperty> Properties;
+        bool                     FixedSize { true };
+        std::size_t              Stride    { 0 };   // record size when FixedSize
+    };
+
+    struct PlyHeader
+    {
+        PlyFormat               Format { PlyFormat::Ascii };
+        std::vector<PlyElement> Elements;
+        std::size_t             DataOffset { 0 };
+    };
+
+    static PlyType parseType(std::string_view name)
+    {
+        if (name == "char"   || name == "int8")    return PlyType::Int8;
+        if (name == "uchar"  || name == "uint8")   return PlyType::UInt8;
+        if (name == "short"  || name == "int16")   return PlyType::Int16;
+        if (name == "ushort" || name == "uint16")  return PlyType::UInt16;
+        if (name == "int"    || name == "int32")   return PlyType::Int32;
+        if (name == "uint"   || name == "uint32")  return PlyType::UInt32;
+        if (name == "float"  || name == "float32") return PlyType::Float32;
+        if (name == "double" || name == "float64") return PlyType::Float64;
+        return PlyType::Invalid;
+    }
+
+    static std::size_t typeSize(PlyType type)
+    {
+        switch (type)
+        {
+            case PlyType::Int8:
+            case PlyType::UInt8:   return 1;
+            case PlyType::Int16:
+            case PlyType::UInt16:  return 2;
+            case PlyType::Int32:
+            case PlyType::UInt32:
+            case PlyType::Float32: return 4;
+            case PlyType::Float64: return 8;
+            case PlyType::Invalid: break;
+        }
+        return 0;
+    }
+
+    static std::vector<std::string_view> splitWords(std::string_view line)
+    {
+        std::vector<std::string_view> words;
+        std::size_t i = 0;
+        while (i < line.size())
+        {
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+                ++i;
+            const std::size_t begin = i;
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+                ++i;
+            if (i > begin)
+                words.push_back(line.substr(begin, i - begin));
+        }
+        return words;
+    }
+
+    static bool parseHeader(const unsigned char* data, std::size_t size, PlyHeader& out, std::string& error)
+    {
+        const std::string_view text(reinterpret_cast<const char*>(data), size);
+        if (text.substr(0, 3) != "ply")
+        {
+            error = "not a PLY file";
+            return false;
+        }
+
+        bool haveFormat = false;
+        std::size_t pos = 0;
+        while (pos < text.size())
+        {
+            std::size_t eol = text.find('\n', pos);
+            if (eol == std::string_view::npos)
+                break;
+            const std::vector<std::string_view> words = splitWords(text.substr(pos, eol - pos));
+            pos = eol + 1;
+            if (words.empty())
+                continue;
+
+            if (words[0] == "end_header")
+            {
+                out.DataOffset = pos;
+                if (!haveFormat)
+                    error = "missing format line";
+                return haveFormat;
+            }
+            if (words[0] == "format" && words.size() >= 2)
+            {
+                haveFormat = true;
+                if (words[1] == "ascii")                     out.Format = PlyFormat::Ascii;
+                else if (words[1] == "binary_little_endian") out.Format = PlyFormat::BinaryLittleEndian;
+                else if (words[1] == "binary_big_endian")    out.Format = PlyFormat::BinaryBigEndian;
+                else
+                {
+                    error = "unknown format " + std::string(words[1]);
+                    return false;
+                }
+            }
+            else if (words[0] == "element" && words.size() >= 3)
+            {
+                PlyElement element;
+                element.Name = std::string(words[1]);
+                std::from_chars(words[2].data(), words[2].data() + words[2].size(), element.Count);
+                out.Elements.push_back(std::move(element));
+            }
+            else if (words[0] == "property" && !out.Elements.empty())
+            {
+                PlyElement& element = out.Elements.back();
+                PlyProperty property;
+                if (words.size() >= 5 && words[1] == "list")
+                {
+                    property.CountType = parseType(words[2]);
+                    property.Type      = parseType(words[3]);
+                    property.Name      = std::string(words[4]);
+                    element.FixedSize  = false;
+                }
+                else if (words.size() >= 3)
+                {
+                    property.Type   = parseType(words[1]);
+                    property.Name   = std::string(words[2]);
+                    property.Offset = element.Stride;
+                    element.Stride += typeSize(property.Type);
+                }
+                if (property.Type == PlyType::Invalid || (property.IsList() && typeSize(property.CountType) == 0))
+                {
+                    error = "invalid property in element " + element.Name;
+                    return false;
+                }
+                element.Properties.push_back(std::move(property));
+            }
+            // comment, obj_info: ignored
+        }
+        error = "missing end_header";
+        return false;
+    }
+
+    // --- value decoding ------------------------------------------------------
+
+    template <typename T>
+    static inline T loadValue(const unsigned char* p, bool swap)
+    {
+        T value;
+        if (swap)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::reverse_copy(p, p + sizeof(T), bytes);
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        else
+        {
+            std::memcpy(&value, p, sizeof(T));
+        }
+        return value;
+    }
+
+    static inline double readNumber(const unsigned char* p, PlyType type, bool swap)
+    {
+        switch (type)
+        {
+            case PlyType::Float32: return loadValue<float>(p, swap);
+            case PlyType::Float64: return loadValue<double>(p, swap);
+            case PlyType::Int8:    return static_cast<std::int8_t>(p[0]);
+            case PlyType::UInt8:   return p[0];
+            case PlyType::Int16:   return loadValue<std::int16_t>(p, swap);
+            case PlyType::UInt16:  return loadValue<std::uint16_t>(p, swap);
+            case PlyType::Int32:   return loadValue<std::int32_t>(p, swap);
+            case PlyType::UInt32:  return loadValue<std::uint32_t>(p, swap);
+            case PlyType::Invalid: break;
+        }
+        return 0.0;
+    }
+
+    static inline float readFloat(const unsigned char* p, PlyType type, bool swap)
+    {
+        return type == PlyType::Float32 ? loadValue<float>(p, swap) : static_cast<float>(readNumber(p, type, swap));
+    }
+
+    // negative indices come out as huge values and are rejected later
+    static inline std::uint32_t readIndex(const unsigned char* p, PlyType type, bool swap)
+    {
+        switch (type)
+        {
+            case PlyType::Int32:
+            case PlyType::UInt32: return loadValue<std::uint32_t>(p, swap);
+            case PlyType::Int16:  return static_cast<std::uint32_t>(static_cast<std::int32_t>(loadValue<std::int16_t>(p, swap)));
+            case PlyType::UInt16: return loadValue<std::uint16_t>(p, swap);
+            case PlyType::Int8:   return static_cast<std::uint32_t>(static_cast<std::int32_t>(static_cast<std::int8_t>(p[0])));
+            case PlyType::UInt8:  return p[0];
+            default:              return static_cast<std::uint32_t>(readNumber(p, type, swap));
+        }
+    }
+
+    // --- decoded geometry ----------------------------------------------------
+
+    struct PlyGeometry
+    {
+        std::vector<glm::vec3>    Positions;
+        std::vector<glm::vec3>    Normals;
+        std::vector<glm::vec2>    TexCoords;
+        std::vector<unsigned int> Indices;
+    };
+
+    // where each attribute sits in a vertex record (index into PlyElement::Properties)
+    struct PlyVertexLayout
+    {
+        int Position[3] { -1, -1, -1 };
+        int Normal[3]   { -1, -1, -1 };
+        int TexCoord[2] { -1, -1 };
+
+        bool HasNormals()   const { return Normal[0] >= 0 && Normal[1] >= 0 && Normal[2] >= 0; }
+        bool HasTexCoords() const { return TexCoord[0] >= 0 && TexCoord[1] >= 0; }
+    };
+
+    static int findProperty(const PlyElement& element, std::initializer_list<std::string_view> names)
+    {
+        for (std::string_view name : names)
+            for (std::size_t i = 0; i < element.Properties.size(); ++i)
+                if (!element.Properties[i].IsList() && element.Properties[i].Name == name)
+                    return static_cast<int>(i);
+        return -1;
+    }
+
+    static PlyVertexLayout makeVertexLayout(const PlyElement& element)
+    {
+        PlyVertexLayout layout;
+        layout.Position[0] = findProperty(element, { "x" });
+        layout.Position[1] = findProperty(element, { "y" });
+        layout.Position[2] = findProperty(element, { "z" });
+        layout.Normal[0]   = findProperty(element, { "nx" });
+        layout.Normal[1]   = findProperty(element, { "ny" });
+        layout.Normal[2]   = findProperty(element, { "nz" });
+        layout.TexCoord[0] = findProperty(element, { "u", "s", "texture_u", "texture_s" });
+        layout.TexCoord[1] = findProperty(element, { "v", "t", "texture_v", "texture_t" });
+        return layout;
+    }
+
+    static int findIndexList(const PlyElement& element)
+    {
+        for (std::size_t i = 0; i < element.Properties.size(); ++i)
+            if (element.Properties[i].IsList() && (element.Properties[i].Name == "vertex_indices" || element.Properties[i].Name == "vertex_index"))
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    static void appendFan(std::vector<unsigned int>& out, const std::uint32_t* polygon, std::size_t n)
+    {
+        for (std::size_t i = 1; i + 1 < n; ++i)
+        {
+            out.push_back(polygon[0]);
+            out.push_back(polygon[i]);
+            out.push_back(polygon[i + 1]);
+        }
+    }
+
+    // vertices per ParallelFor task
+    static constexpr std::size_t kBlock = std::size_t(1) << 16;
+
+    // Walks one record of a variable-size element. visit(property, first value, list length) is
+    // called per property; returns the end of the record, or nullptr if it runs past end.
+    template <typename Visit>
+    static const unsigned char* walkRecord(const PlyElement& element, const unsigned char* p, const unsigned char* end,
+                                           bool swap, Visit&& visit)
+    {
+        for (std::size_t i = 0; i < element.Properties.size(); ++i)
+        {
+            const PlyProperty& property = element.Properties[i];
+            std::size_t count = 1;
+            if (property.IsList())
+            {
+                const std::size_t countSize = typeSize(property.CountType);
+                if (std::size_t(end - p) < countSize)
+                    return nullptr;
+                count = readIndex(p, property.CountType, swap);
+                p += countSize;
+            }
+            const std::size_t bytes = count * typeSize(property.Type);
+            if (std::size_t(end - p) < bytes)
+                return nullptr;
+            visit(i, p, count);
+            p += bytes;
+        }
+        return p;
+    }
+
+    // Smallest number of bytes one record can take: every scalar, plus the length of every list.
+    // Header counts are checked against this before anything is allocated for them.
+    static std::size_t minRecordSize(const PlyElement& element)
+    {
+        if (element.FixedSize)
+            return element.Stride;
+        std::size_t size = 0;
+        for (const PlyProperty& property : element.Properties)
+            size += typeSize(property.IsList() ? property.CountType : property.Type);
+        return size;
+    }
+
+    // true if count records of at least recordSize bytes each fit in the remaining data
+    static bool countFits(std::size_t count, std::size_t recordSize, const unsigned char* p, const unsigned char* end)
+    {
+        return count == 0 || (recordSize > 0 && count <= std::size_t(end - p) / recordSize);
+    }
+
+    // decodes the vertex element; returns the end of its data, or nullptr if the file is truncated
+    static const unsigned char* decodeVertices(const PlyElement& element, const PlyVertexLayout& layout,
+                                               const unsigned char* p, const unsigned char* end, bool swap,
+                                               ThreadPool& pool, PlyGeometry& out)
+    {
+        const std::size_t count = element.Count;
+        if (!countFits(count, minRecordSize(element), p, end))
+            return nullptr;
+        out.Positions.resize(count);
+        if (layout.HasNormals())
+            out.Normals.resize(count);
+        if (layout.HasTexCoords())
+            out.TexCoords.resize(count);
+
+        auto decode = [&](std::size_t v, auto&& at)
+        {
+            for (int c = 0; c < 3; ++c)
+                out.Positions[v][c] = at(layout.Position[c]);
+            if (layout.HasNormals())
+                for (int c = 0; c < 3; ++c)
+                    out.Normals[v][c] = at(layout.Normal[c]);
+            if (layout.HasTexCoords())
+                out.TexCoords[v] = glm::vec2(at(layout.TexCoord[0]), 1.0f - at(layout.TexCoord[1]));
+        };
+
+        if (element.FixedSize)
+        {
+            // fixed-stride records: every block decodes independently from the mapping
+            pool.ParallelFor((count + kBlock - 1) / kBlock, [&](std::size_t b)
+            {
+                const std::size_t last = std::min(count, (b + 1) * kBlock);
+                for (std::size_t v = b * kBlock; v < last; ++v)
+                {
+                    const unsigned char* record = p + v * element.Stride;
+                    decode(v, [&](int property)
+                    {
+                        const PlyProperty& prop = element.Properties[property];
+                        return readFloat(record + prop.Offset, prop.Type, swap);
+                    });
+                }
+            });
+            return p + count * element.Stride;
+        }
+
+        // a list inside the vertex element (rare): sequential walk
+        std::vector<const unsigned char*> values(element.Properties.size(), nullptr);
+        for (std::size_t v = 0; v < count; ++v)
+        {
+            p = walkRecord(element, p, end, swap, [&](std::size_t i, const unsigned char* value, std::size_t) { values[i] = value; });
+            if (!p)
+                return nullptr;
+            decode(v, [&](int property) { return readFloat(values[property], element.Properties[property].Type, swap); });
+        }
+        return p;
+    }
+
+    // decodes the face element into a triangle list; returns the end of its data, or nullptr if truncated
+    static const unsigned char* decodeFaces(const PlyElement& element, const unsigned char* p, const unsigned char* end,
+                                            bool swap, ThreadPool& pool, PlyGeometry& out)
+    {
+        const int listIndex = findIndexList(element);
+        const std::size_t count = element.Count;
+
+        // fast path: the index list is the only list and every face is a triangle, so records have a fixed size
+        if (listIndex >= 0)
+        {
+            const PlyProperty& list = element.Properties[listIndex];
+            std::size_t before = 0, after = 0;
+            bool onlyList = true;
+            for (std::size_t i = 0; i < element.Properties.size(); ++i)
+            {
+                const PlyProperty& property = element.Properties[i];
+                if (int(i) == listIndex)
+                    continue;
+                if (property.IsList())
+                    onlyList = false;
+                (int(i) < listIndex ? before : after) += typeSize(property.Type);
+            }
+
+            const std::size_t countSize = typeSize(list.CountType);
+            const std::size_t indexSize = typeSize(list.Type);
+            const std::size_t stride    = before + countSize + 3 * indexSize + after;
+            if (onlyList && count <= std::size_t(end - p) / stride)
+            {
+                std::atomic<bool> allTriangles { true };
+                pool.ParallelFor((count + kBlock - 1) / kBlock, [&](std::size_t b)
+                {
+                    const std::size_t last = std::min(count, (b + 1) * kBlock);
+                    for (std::size_t f = b * kBlock; f < last && allTriangles.load(std::memory_order_relaxed); ++f)
+                        if (readIndex(p + f * stride + before, list.CountType, swap) != 3)
+                            allTriangles.store(false);
+                });
+
+                if (allTriangles.load())
+                {
+                    out.Indices.resize(count * 3);
+                    pool.ParallelFor((count + kBlock - 1) / kBlock, [&](std::size_t b)
+                    {
+                        const std::size_t last = std::min(count, (b + 1) * kBlock);
+                        for (std::size_t f = b * kBlock; f < last; ++f)
+                        {
+                            const unsigned char* index = p + f * stride + before + countSize;
+                            for (int k = 0; k < 3; ++k)
+                                out.Indices[f * 3 + k] = readIndex(index + k * indexSize, list.Type, swap);
+                        }
+                    });
+                    return p + count * stride;
+                }
+            }
+        }
+
+        // general path: mixed polygons or extra lists, fan-triangulated in one pass.
+        // A face holds at least a triangle, so the count is bounded by the data before reserving for it.
+        std::size_t minFace = minRecordSize(element);
+        if (listIndex >= 0)
+            minFace += 3 * typeSize(element.Properties[listIndex].Type);
+        if (!countFits(count, minFace, p, end))
+            return nullptr;
+        out.Indices.reserve(count * 3);
+        std::vector<std::uint32_t> polygon;
+        for (std::size_t f = 0; f < count; ++f)
+        {
+            p = walkRecord(element, p, end, swap, [&](std::size_t i, const unsigned char* value, std::size_t n)
+            {
+                if (int(i) != listIndex)
+                    return;
+                const std::size_t indexSize = typeSize(element.Properties[i].Type);
+                polygon.resize(n);
+                for (std::size_t k = 0; k < n; ++k)
+                    polygon[k] = readIndex(value + k * indexSize, element.Properties[i].Type, swap);
+                appendFan(out.Indices, polygon.data(), n);
+            });
+            if (!p)
+                return nullptr;
+        }
+        return p;
+    }
+
+    // ASCII bodies: whitespace-separated numbers, one record per line
+    static bool decodeAscii(const PlyHeader& header, const char* p, const char* end, PlyGeometry& out)
+    {
+        auto next = [&](double& value) -> bool
+        {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+                ++p;
+            if (p < end && *p == '+')
+                ++p;
+            auto result = std::from_chars(p, end, value);
+            if (result.ec != std::errc())
+                return false;
+            p = result.ptr;
+            return true;
+        };
+
+        std::vector<double> values;
+        std::vector<std::uint32_t> polygon;
+        for (const PlyElement& element : header.Elements)
+        {
+            const bool isVertex = element.Name == "vertex";
+            const bool isFace   = element.Name == "face";
+            const PlyVertexLayout layout = makeVertexLayout(element);
+            const int listIndex = findIndexList(element);
+
+            // every value takes at least a digit and a separator; a face holds at least a triangle
+            const std::size_t minValues = element.Properties.size() + (isFace && listIndex >= 0 ? 3 : 0);
+            if (minValues > 0 && element.Count > (std::size_t(end - p) + 1) / (2 * minValues))
+                return false;
+            if (isVertex)
+            {
+                out.Positions.resize(element.Count);
+                if (layout.HasNormals())   out.Normals.resize(element.Count);
+                if (layout.HasTexCoords()) out.TexCoords.resize(element.Count);
+            }
+
+            values.resize(element.Properties.size());
+            for (std::size_t r = 0; r < element.Count; ++r)
+            {
+                for (std::size_t i = 0; i < element.Properties.size(); ++i)
+                {
+                    const PlyProperty& property = element.Properties[i];
+                    if (!next(values[i]))
+                        return false;
+                    if (!property.IsList())
+                        continue;
+
+                    if (values[i] < 0.0 || values[i] > double(end - p) / 2.0)
+                        return false;
+                    const std::size_t n = static_cast<std::size_t>(values[i]);
+                    polygon.resize(n);
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        double index;
+                        if (!next(index))
+                            return false;
+                        polygon[k] = index < 0.0 ? std::numeric_limits<std::uint32_t>::max() : static_cast<std::uint32_t>(index);
+                    }
+                    if (isFace && int(i) == listIndex)
+                        appendFan(out.Indices, polygon.data(), n);
+                }
+
+                if (isVertex)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        out.Positions[r][c] = layout.Position[c] >= 0 ? float(values[layout.Position[c]]) : 0.0f;
+                    if (layout.HasNormals())
+                        for (int c = 0; c < 3; ++c)
+                            out.Normals[r][c] = float(values[layout.Normal[c]]);
+                    if (layout.HasTexCoords())
+                        out.TexCoords[r] = glm::vec2(float(values[layout.TexCoord[0]]), 1.0f - float(values[layout.TexCoord[1]]));
+                }
+            }
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+
+    std::unique_ptr<ImportedScene> PlyLoader::Load(const std::string& path, ThreadPool& pool, ImportProgress* progress)
+    {
+        MappedFile file(path);
+        if (!file.IsOpen())
+        {
+            LOG_ERROR("Failed to open PLY file: {}", path);
+            if (progress)
+                progress->Enter(ImportStage::Failed);
+            return nullptr;
+        }
+        return LoadFromMemory(file.Data(), file.Size(), std::filesystem::path(path).stem().string(), pool, progress);
+    }
+
+    std::unique_ptr<ImportedScene> PlyLoader::LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                             const std::string& name, ThreadPool& pool,
+                                                             ImportProgress* progress)
+    {
+        auto fail = [progress](ImportStage stage) -> std::unique_ptr<ImportedScene>
+        {
+            if (progress)
+                progress->Enter(stage);
+            return nullptr;
+        };
+        auto cancelled = [progress]() { return progress && progress->CancelRequested.load(); };
+
+        Timer timer;
+        timer.Start();
+        if (progress)
+            progress->Enter(ImportStage::Parsing);
+
+        PlyHeader header;
+        std::string error;
+        if (!parseHeader(data, size, header, error))
+        {
+            LOG_ERROR("PLY: {}: {}", name, error);
+            return fail(ImportStage::Failed);
+        }
+
+        auto vertexElement = std::find_if(header.Elements.begin(), header.Elements.end(),
+                                          [](const PlyElement& e) { return e.Name == "vertex"; });
+        if (vertexElement == header.Elements.end())
+        {
+            LOG_ERROR("PLY: {} has no vertex element", name);
+            return fail(ImportStage::Failed);
+        }
+        const PlyVertexLayout layout = makeVertexLayout(*vertexElement);
+        if (layout.Position[0] < 0 || layout.Position[1] < 0 || layout.Position[2] < 0)
+        {
+            LOG_ERROR("PLY: {} has no x/y/z vertex properties", name);
+            return fail(ImportStage::Failed);
+        }
+
+        // --- decode the elements in file order ---
+        PlyGeometry geometry;
+        const unsigned char* p   = data + header.DataOffset;
+        const unsigned char* end = data + size;
+        bool ok = true;
+        if (header.Format == PlyFormat::Ascii)
+        {
+            ok = decodeAscii(header, reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(end), geometry);
+        }
+        else
+        {
+            const bool swap = (header.Format == PlyFormat::BinaryBigEndian) != (std::endian::native == std::endian::big);
+            for (const PlyElement& element : header.Elements)
+            {
+                if (!p || cancelled())
+                    break;
+                if (element.Name == "vertex")
+                    p = decodeVertices(element, layout, p, end, swap, pool, geometry);
+                else if (element.Name == "face")
+                    p = decodeFaces(element, p, end, swap, pool, geometry);
+                else if (element.FixedSize)
+                    p = element.Count <= std::size_t(end - p) / std::max<std::size_t>(element.Stride, 1) ? p + element.Count * element.Stride : nullptr;
+                else if (!countFits(element.Count, minRecordSize(element), p, end))
+                    p = nullptr;
+                else
+                    for (std::size_t r = 0; r < element.Count && p; ++r)
+                        p = walkRecord(element, p, end, swap, [](std::size_t, const unsigned char*, std::size_t) { });
+            }
+            ok = p != nullptr;
+        }
+        if (cancelled())
+            return fail(ImportStage::Cancelled);
+        if (!ok)
+        {
+            LOG_ERROR("PLY: {} is truncated or malformed", name);
+            return fail(ImportStage::Failed);
+        }
+
+        // drop faces that reference missing vertices
+        const std::size_t vertexCount = geometry.Positions.size();
+        std::vector<unsigned int>& indices = geometry.Indices;
+        std::atomic<std::size_t> invalid { 0 };
+        pool.ParallelFor((indices.size() + kBlock - 1) / kBlock, [&](std::size_t b)
+        {
+            const std::size_t last = std::min(indices.size(), (b + 1) * kBlock);
+            for (std::size_t i = b * kBlock; i < last; ++i)
+                if (indices[i] >= vertexCount)
+                    invalid.fetch_add(1, std::memory_order_relaxed);
+        });
+        if (invalid.load() > 0)
+        {
+            std::size_t kept = 0;
+            for (std::size_t t = 0; t + 2 < indices.size(); t += 3)
+            {
+                if (indices[t] < vertexCount && indices[t + 1] < vertexCount && indices[t + 2] < vertexCount)
+                {
+                    std::copy(indices.begin() + t, indices.begin() + t + 3, indices.begin() + kept);
+                    kept += 3;
+                }
+            }
+            LOG_ERROR("PLY: skipped {} faces with out-of-range vertex indices", (indices.size() - kept) / 3);
+            indices.resize(kept);
+        }
+        if (indices.empty())
+        {
+            // point clouds have nothing to draw
+            LOG_ERROR("PLY: {} has no faces", name);
+            return fail(ImportStage::Failed);
+        }
+
+        // --- normals and meshes ---
+        if (progress)
+            progress->Enter(ImportStage::Converting);
+
+        if (geometry.Normals.empty())
+            geometry.Normals = MeshProcessing::ComputeSmoothNormals(geometry.Positions.data(), vertexCount, indices, pool);
+        if (cancelled())
+            return fail(ImportStage::Cancelled);
+
+        const std::size_t triangleCount = indices.size() / 3;
+        auto scene = std::make_unique<ImportedScene>();
+        scene->Materials.emplace_back();
+        scene->Meshes = MeshProcessing::BuildMeshes(name, geometry.Positions.data(), geometry.Normals.data(),
+                                                    geometry.TexCoords.empty() ? nullptr : geometry.TexCoords.data(),
+                                                    vertexCount, std::move(indices), pool);
+
+        const float seconds = timer.Stop();
+        LOG_INFO("PLY: {} triangles, {} vertices in {:.1f} ms ({:.1f} M triangles/s), peak RSS {:.0f} MB",
+                 triangleCount, vertexCount, seconds * 1000.0f,
+                 seconds > 0.0f ? double(triangleCount) / seconds / 1e6 : 0.0,
+                 MemoryStats::ToMB(MemoryStats::GetPeakResidentBytes()));
+        return scene;
+    }
+}
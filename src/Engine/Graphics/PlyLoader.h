@@ -0,0 +1,49 @@
+/**
+ * @file PlyLoader.h
+ * @brief Native PLY (Stanford polygon file) importer for large scanned meshes.
+ * The header is parsed into a per-property byte layout once; binary vertex and face
+ * elements are then decoded straight from the memory-mapped file in parallel blocks.
+ * Faces that are all triangles (the usual scanner output) take a fixed-stride fast path;
+ * anything else is fan-triangulated in one sequential pass. ASCII files are supported
+ * through a slower sequential parser.
+ *
+ * Reads x/y/z, nx/ny/nz and u/v (or s/t, texture_u/texture_v); other properties are skipped.
+ * Missing normals are generated. Meshes too large for one vertex buffer are split.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    class PlyLoader
+    {
+    public:
+        /// @brief Loads a PLY file.
+        /// @param path The path to the .ply file.
+        /// @param pool The pool to decode on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene, or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> Load(const std::string& path, ThreadPool& pool,
+                                                   ImportProgress* progress = nullptr);
+
+        /// @brief Loads PLY contents that are already in memory.
+        /// @param data The file contents.
+        /// @param size The size of the contents in bytes.
+        /// @param name The name to give the mesh.
+        /// @param pool The pool to decode on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene, or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                             const std::string& name, ThreadPool& pool,
+                                                             ImportProgress* progress = nullptr);
+
+    private:
+        PlyLoader() = delete;
+    };
+}
@@ -19,18 +19,12 @@ namespace isaacObjectViewer
         // Set index count for our cube (36 indices)
         m_IndicesCount = 36;
 
-        // Create the VertexArray
-        m_VertexArray = std::make_unique<VertexArray>();
-
         // Create the VertexBuffer with our vertex data
         m_VertexBuffer = std::make_unique<VertexBuffer>(m_CubeVertices, sizeof(m_CubeVertices));
 
-        // Define the vertex layout: 3 floats for position, 3 for normal
-        VertexBufferLayout vb_layout;
-        vb_layout.Push<float>(3); // Positions
-        vb_layout.Push<float>(3); // Normals
-        vb_layout.Push<float>(2); // TexCoords
-        m_VertexArray->AddBuffer(*m_VertexBuffer, vb_layout);
+        // The vertex array shared by every position/normal/UV buffer
+        static_assert(sizeof(PositionNormalTexVertex) == m_FloatsPerVertex * sizeof(float));
+        m_VertexArray = VertexArray::ForVertexType<PositionNormalTexVertex>(*m_VertexBuffer);
 
         // Create the IndexBuffer with our index data
         m_IndexBuffer = std::make_unique<IndexBuffer>(m_CubeIndices, m_IndicesCount);
@@ -71,6 +65,7 @@ namespace isaacObjectViewer
         shader->setBool("hasDiffuseMap",  hasDiffuse);
         shader->setBool("hasSpecularMap", hasSpecular);
         shader->setFloat("material.shininess", m_Material.Shininess);
+        shader->setBool("material.useColors", false);
 
         if (useMaterial) 
         {
@@ -22,22 +22,15 @@ namespace isaacObjectViewer
         m_VertexCount = GenerateCylinder(0.5f, 0.5f, 1.0f, 36, vertices, indices);
         m_IndexCount = static_cast<unsigned int>(indices.size());
 
-        // Create the VertexArray
-        m_VertexArray = std::make_unique<VertexArray>();
-
         // Create the VertexBuffer and store it as a member
         m_VertexBuffer = std::make_unique<VertexBuffer>(vertices.data(), static_cast<unsigned int>(vertices.size() * sizeof(float)));
 
         // Create the IndexBuffer
         m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), m_IndexCount);
 
-        // Define the vertex layout: 3 floats for position and 3 floats for normal
-        VertexBufferLayout layout;
-        layout.Push<float>(3); // position
-        layout.Push<float>(3); // normal
-
-        m_VertexArray->AddBuffer(*m_VertexBuffer, layout);
-        m_VertexArray->Unbind();
+        // GenerateCylinder writes 3 floats of position and 3 of normal per vertex
+        static_assert(sizeof(PositionNormalVertex) == 6 * sizeof(float));
+        m_VertexArray = VertexArray::ForVertexType<PositionNormalVertex>(*m_VertexBuffer);
     }
 
     Cylinder::~Cylinder()
@@ -19,18 +19,12 @@ namespace isaacObjectViewer
         // Initialize vertex count for indexed drawing
         m_VertexCount = 4;
 
-        // Create the VertexArray
-        m_VertexArray = std::make_unique<VertexArray>();
-
         // Create the VertexBuffer with the vertex data
         m_VertexBuffer = std::make_unique<VertexBuffer>(m_PlaneVertices, sizeof(m_PlaneVertices));
 
-        // Set up the VertexBufferLayout
-        VertexBufferLayout vb_layout;
-        vb_layout.Push<float>(3); // Positions
-        vb_layout.Push<float>(3); // Normals
-        vb_layout.Push<float>(2); // TexCoords
-        m_VertexArray->AddBuffer(*m_VertexBuffer, vb_layout);
+        // The vertex array shared by every position/normal/UV buffer
+        static_assert(sizeof(PositionNormalTexVertex) == m_FloatsPerVertex * sizeof(float));
+        m_VertexArray = VertexArray::ForVertexType<PositionNormalTexVertex>(*m_VertexBuffer);
 
         // Create the IndexBuffer with the index data
         m_IndexBuffer = std::make_unique<IndexBuffer>(m_PlaneIndices, m_IndicesCount);
@@ -69,6 +63,7 @@ namespace isaacObjectViewer
         shader->setBool("hasDiffuseMap",  hasDiffuse);
         shader->setBool("hasSpecularMap", hasSpecular);
         shader->setFloat("material.shininess",m_Material.Shininess);
+        shader->setBool("material.useColors", false);
         
         if (useMaterial) 
         {
@@ -26,9 +26,6 @@ namespace isaacObjectViewer
         m_VertexCount = GenerateSphere(radius, sectorCount, stackCount, vertices, indices);
         m_IndexCount = static_cast<unsigned int>(indices.size());
 
-        // Create the VertexArray
-        m_VertexArray = std::make_unique<VertexArray>();
-
         // Create the VertexBuffer from the generated vertex data
         m_VertexBuffer = std::make_unique<VertexBuffer>(vertices.data(), 
                                     static_cast<unsigned int>(vertices.size() * sizeof(float)));
@@ -36,13 +33,9 @@ namespace isaacObjectViewer
         // Create the IndexBuffer from the generated indices
         m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), m_IndexCount);
 
-        // Define the vertex layout: 3 floats for position and 3 floats for normal
-        VertexBufferLayout layout;
-        layout.Push<float>(3); // position
-        layout.Push<float>(3); // normal
-
-        m_VertexArray->AddBuffer(*m_VertexBuffer, layout);
-        m_VertexArray->Unbind();
+        // GenerateSphere writes 3 floats of position and 3 of normal per vertex
+        static_assert(sizeof(PositionNormalVertex) == 6 * sizeof(float));
+        m_VertexArray = VertexArray::ForVertexType<PositionNormalVertex>(*m_VertexBuffer);
     }
 
     Sphere::~Sphere()
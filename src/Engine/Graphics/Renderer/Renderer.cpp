@@ -12,7 +12,45 @@ void Renderer::Render(const VertexArray& va, const IndexBuffer& ib, const Shader
     shader.Bind();
     va.Bind();
     ib.Bind();
-    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr));
+}
+
+void Renderer::Render(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, unsigned int firstIndex) const
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    const void* offset = reinterpret_cast<const void*>(std::size_t(firstIndex) * ib.GetIndexSize());
+    GLCall(glDrawElements(GL_TRIANGLES, count, ib.GetType(), offset));
+}
+
+void Renderer::RenderMulti(const VertexArray& va, const IndexBuffer& ib, const Shader& shader,
+                           const GLsizei* counts, const void* const* offsets, GLsizei drawCount) const
+{
+    if (drawCount <= 0)
+        return;
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    GLCall(glMultiDrawElements(GL_TRIANGLES, counts, ib.GetType(), offsets, drawCount));
+}
+
+void Renderer::RenderInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr, instanceCount));
+}
+
+void Renderer::RenderInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount,
+                               unsigned int count, unsigned int firstIndex) const
+{
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    const void* offset = reinterpret_cast<const void*>(std::size_t(firstIndex) * ib.GetIndexSize());
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, count, ib.GetType(), offset, instanceCount));
 }
 
 void Renderer::Render(const VertexArray& va, int count, const Shader& shader) const
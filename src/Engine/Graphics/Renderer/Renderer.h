@@ -7,6 +7,9 @@
  * Render: Renders the 3D objects, has two overloads.
  *   - One for rendering indexed geometry.
  *   - Another for rendering non-indexed geometry.
+ *   Indexed rendering can also draw a range of the index buffer (e.g. one level of detail),
+ *   or several ranges in one call (e.g. the meshlets that survived culling).
+ * RenderInstanced: Renders indexed geometry several times in one draw call.
  */
 
 #pragma once
@@ -29,12 +32,47 @@ public:
     /// @param shader The shader to use.
     void Render(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
 
+    /// @brief Renders a range of indexed geometry.
+    /// @param va The vertex array to render.
+    /// @param ib The index buffer to use.
+    /// @param shader The shader to use.
+    /// @param count The number of indices to draw.
+    /// @param firstIndex The first index to draw.
+    void Render(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, unsigned int firstIndex) const;
+
+    /// @brief Renders several ranges of indexed geometry in one call (glMultiDrawElements).
+    /// @param va The vertex array to render.
+    /// @param ib The index buffer to use.
+    /// @param shader The shader to use.
+    /// @param counts The number of indices of each range.
+    /// @param offsets The byte offset of each range in the index buffer.
+    /// @param drawCount The number of ranges.
+    void RenderMulti(const VertexArray& va, const IndexBuffer& ib, const Shader& shader,
+                     const GLsizei* counts, const void* const* offsets, GLsizei drawCount) const;
+
     /// @brief Renders non-indexed geometry.
     /// @param va The vertex array to render.
     /// @param count The number of vertices to render.
     /// @param shader The shader to use.
     void Render(const VertexArray& va, int count, const Shader& shader) const;
 
+    /// @brief Renders indexed geometry once per instance in a single draw call.
+    /// @param va The vertex array to render, with its per-instance attributes bound.
+    /// @param ib The index buffer to use.
+    /// @param shader The shader to use.
+    /// @param instanceCount The number of instances to draw.
+    void RenderInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+
+    /// @brief Renders a range of indexed geometry once per instance in a single draw call.
+    /// @param va The vertex array to render, with its per-instance attributes bound.
+    /// @param ib The index buffer to use.
+    /// @param shader The shader to use.
+    /// @param instanceCount The number of instances to draw.
+    /// @param count The number of indices to draw.
+    /// @param firstIndex The first index to draw.
+    void RenderInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount,
+                         unsigned int count, unsigned int firstIndex) const;
+
 private:
 };
 
@@ -0,0 +1,49 @@
+/**
+ * @file SceneNode.h
+ * @brief Header file for the SceneNode struct.
+ * One node of an imported model's transform tree. Nodes refer to the model's meshes by
+ * index, so geometry placed by several nodes is stored (and uploaded) once and drawn instanced.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief A node of an imported transform tree.
+    struct SceneNode
+    {
+        std::string               Name;
+        /// @brief Index of the parent node, or -1 for a root. Parents always come before their children.
+        int                       Parent { -1 };
+        /// @brief Transform relative to the parent.
+        glm::mat4                 Transform { 1.0f };
+        /// @brief Meshes drawn at this node, as indices into the model's meshes.
+        std::vector<unsigned int> Meshes;
+    };
+
+    /// @brief Flattens a transform tree into the placements of each mesh.
+    /// @param nodes The nodes, parents first.
+    /// @param meshCount The number of meshes the nodes refer to.
+    /// @return Per mesh, the model-space transform of every node that draws it, in node order.
+    inline std::vector<std::vector<glm::mat4>> CollectInstances(const std::vector<SceneNode>& nodes, std::size_t meshCount)
+    {
+        std::vector<std::vector<glm::mat4>> instances(meshCount);
+        std::vector<glm::mat4> global(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            const SceneNode& node = nodes[i];
+            const bool hasParent  = node.Parent >= 0 && static_cast<std::size_t>(node.Parent) < i;
+            global[i] = hasParent ? global[node.Parent] * node.Transform : node.Transform;
+            for (unsigned int mesh : node.Meshes)
+            {
+                if (mesh < meshCount)
+                    instances[mesh].push_back(global[i]);
+            }
+        }
+        return instances;
+    }
+}
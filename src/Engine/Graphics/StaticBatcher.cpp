@@ -0,0 +1,200 @@
+#include "StaticBatcher.h"
+#include "Graphics/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace isaacObjectViewer
+{
+    static constexpr unsigned int kNoBatch = std::numeric_limits<unsigned int>::max();
+
+    static glm::vec3 normalizeOrKeep(const glm::vec3& v)
+    {
+        const float len = glm::length(v);
+        return len > 0.0f ? v / len : v;
+    }
+
+    // appends a source mesh, placed by transform, and records it as a part
+    static void appendPart(MeshData& batch, MeshData& source, const glm::mat4& transform)
+    {
+        const unsigned int base = static_cast<unsigned int>(batch.Vertices.size());
+        MeshPart& part   = batch.Parts.emplace_back();
+        part.Name        = std::move(source.Name);
+        part.FirstIndex  = static_cast<unsigned int>(batch.Indices.size());
+        part.IndexCount  = static_cast<unsigned int>(source.Indices.size());
+        part.VertexCount = static_cast<unsigned int>(source.Vertices.size());
+        part.Stats       = source.Stats;
+        part.BBoxMin     = glm::vec3(std::numeric_limits<float>::max());
+        part.BBoxMax     = glm::vec3(std::numeric_limits<float>::lowest());
+
+        const bool      identity     = transform == glm::mat4(1.0f);
+        const glm::mat3 linear(transform);
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+        for (Vertex v : source.Vertices)
+        {
+            if (!identity)
+            {
+                v.Position  = glm::vec3(transform * glm::vec4(v.Position, 1.0f));
+                v.Normal    = normalizeOrKeep(normalMatrix * v.Normal);
+                v.Tangent   = normalizeOrKeep(linear * v.Tangent);
+                v.Bitangent = normalizeOrKeep(linear * v.Bitangent);
+            }
+            part.BBoxMin = glm::min(part.BBoxMin, v.Position);
+            part.BBoxMax = glm::max(part.BBoxMax, v.Position);
+            batch.Vertices.push_back(v);
+        }
+
+        // a mirroring transform turns the triangles around; swap two corners to keep them front-facing
+        const bool mirrored = glm::determinant(linear) < 0.0f;
+        for (std::size_t i = 0; i + 2 < source.Indices.size(); i += 3)
+        {
+            batch.Indices.push_back(base + source.Indices[i]);
+            batch.Indices.push_back(base + source.Indices[mirrored ? i + 2 : i + 1]);
+            batch.Indices.push_back(base + source.Indices[mirrored ? i + 1 : i + 2]);
+        }
+        source = MeshData{};
+    }
+
+    StaticBatchStats StaticBatcher::Batch(ImportedScene& scene, std::size_t maxPartVertices)
+    {
+        std::vector<MeshData>& meshes = scene.Meshes;
+        const std::size_t meshCount = meshes.size();
+
+        StaticBatchStats stats;
+        stats.MeshesBefore = stats.MeshesAfter = meshCount;
+        if (meshCount < 2)
+            return stats;
+
+        // without nodes every mesh is drawn once, as stored
+        const bool hasNodes = !scene.Nodes.empty();
+        const std::vector<std::vector<glm::mat4>> placements =
+            hasNodes ? CollectInstances(scene.Nodes, meshCount) : std::vector<std::vector<glm::mat4>>();
+        auto transformOf = [&](std::size_t m) { return hasNodes ? placements[m].front() : glm::mat4(1.0f); };
+
+        std::vector<unsigned int> candidates;
+        for (unsigned int m = 0; m < meshCount; ++m)
+        {
+            const MeshData& mesh = meshes[m];
+            if (mesh.Empty() || mesh.Indices.size() % 3 != 0 || mesh.Vertices.size() > maxPartVertices)
+                continue;
+            if (hasNodes && placements[m].size() != 1)
+                continue; // not drawn, or already instanced
+            if (std::abs(glm::determinant(glm::mat3(transformOf(m)))) < 1e-12f)
+                continue; // flattened by its node: no usable normal transform
+            candidates.push_back(m);
+        }
+
+        // by material, in mesh order; cut where a batch would get too large
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [&](unsigned int a, unsigned int b) { return meshes[a].MaterialIndex < meshes[b].MaterialIndex; });
+        std::vector<std::vector<unsigned int>> batches;
+        std::size_t batchVertices = 0;
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            const MeshData& mesh = meshes[candidates[i]];
+            const bool sameMaterial = i > 0 && meshes[candidates[i - 1]].MaterialIndex == mesh.MaterialIndex;
+            if (!sameMaterial || batchVertices + mesh.Vertices.size() > kMaxBatchVertices)
+            {
+                batches.emplace_back();
+                batchVertices = 0;
+            }
+            batches.back().push_back(candidates[i]);
+            batchVertices += mesh.Vertices.size();
+        }
+        batches.erase(std::remove_if(batches.begin(), batches.end(),
+                                     [](const std::vector<unsigned int>& members) { return members.size() < 2; }),
+                      batches.end());
+        if (batches.empty())
+            return stats;
+
+        std::vector<unsigned int> batchOf(meshCount, kNoBatch);
+        std::vector<MeshData> merged(batches.size());
+        for (std::size_t b = 0; b < batches.size(); ++b)
+        {
+            MeshData& batch = merged[b];
+            batch.MaterialIndex = meshes[batches[b].front()].MaterialIndex;
+            batch.Name = "Batch " + std::to_string(b) + " (" + std::to_string(batches[b].size()) + " parts)";
+
+            std::size_t vertices = 0, indices = 0;
+            for (unsigned int m : batches[b])
+            {
+                vertices += meshes[m].Vertices.size();
+                indices  += meshes[m].Indices.size();
+            }
+            batch.Vertices.reserve(vertices);
+            batch.Indices.reserve(indices);
+            batch.Parts.reserve(batches[b].size());
+
+            // cache figures of the parts, weighted like the Draw Statistics totals
+            double triangles = 0.0;
+            for (unsigned int m : batches[b])
+            {
+                const MeshOptimizationStats& part = meshes[m].Stats;
+                const double t = meshes[m].Indices.size() / 3.0, v = double(meshes[m].Vertices.size());
+                batch.Stats.Before.Acmr += float(part.Before.Acmr * t);
+                batch.Stats.Before.Atvr += float(part.Before.Atvr * v);
+                batch.Stats.Optimized   |= part.Optimized;
+                triangles += t;
+
+                batchOf[m] = static_cast<unsigned int>(b);
+                appendPart(batch, meshes[m], transformOf(m));
+            }
+            if (triangles > 0.0)
+                batch.Stats.Before.Acmr /= float(triangles);
+            if (!batch.Vertices.empty())
+                batch.Stats.Before.Atvr /= float(batch.Vertices.size());
+            batch.Stats.After = MeshOptimizer::AnalyzeVertexCache(batch.Indices.data(), batch.Indices.size(), batch.Vertices.size());
+            if (!batch.Stats.Optimized)
+                batch.Stats.Before = batch.Stats.After;
+            stats.MeshesMerged += batches[b].size();
+        }
+
+        // each batch takes the place of its first part; the other meshes keep their order
+        std::vector<unsigned int> remap(meshCount, kNoBatch);
+        std::vector<unsigned int> batchIndex(batches.size());
+        std::vector<MeshData> out;
+        out.reserve(meshCount - stats.MeshesMerged + batches.size());
+        for (unsigned int m = 0; m < meshCount; ++m)
+        {
+            const unsigned int b = batchOf[m];
+            if (b == kNoBatch)
+            {
+                remap[m] = static_cast<unsigned int>(out.size());
+                out.push_back(std::move(meshes[m]));
+            }
+            else if (batches[b].front() == m)
+            {
+                batchIndex[b] = static_cast<unsigned int>(out.size());
+                out.push_back(std::move(merged[b]));
+            }
+        }
+
+        if (hasNodes)
+        {
+            for (SceneNode& node : scene.Nodes)
+            {
+                std::vector<unsigned int> kept;
+                kept.reserve(node.Meshes.size());
+                for (unsigned int m : node.Meshes)
+                {
+                    if (m >= meshCount)
+                        kept.push_back(static_cast<unsigned int>(m - meshCount + out.size())); // stream meshes follow
+                    else if (remap[m] != kNoBatch)
+                        kept.push_back(remap[m]);
+                }
+                node.Meshes = std::move(kept);
+            }
+
+            // the batches are in model space already
+            SceneNode& root = scene.Nodes.emplace_back();
+            root.Name   = "Static batches";
+            root.Meshes = std::move(batchIndex);
+        }
+
+        meshes = std::move(out);
+        stats.MeshesAfter = meshes.size();
+        stats.Batches     = batches.size();
+        return stats;
+    }
+}
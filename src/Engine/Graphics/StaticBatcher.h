@@ -0,0 +1,51 @@
+/**
+ * @file StaticBatcher.h
+ * @brief Merges small meshes of an imported scene into fewer, larger ones.
+ * Every Mesh is its own draw call with its own uniforms and texture binds, so assets made of
+ * thousands of tiny parts are bound by draw submission. Meshes that share a material and are
+ * placed exactly once (a static transform) are pre-transformed into model space and appended
+ * to one vertex/index buffer per material. Each source mesh stays a MeshPart of the result, so
+ * the UI and picking still see the original parts.
+ *
+ * Meshes placed several times are left alone: instancing already draws them in one call.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <cstddef>
+
+namespace isaacObjectViewer
+{
+    /// @brief What one static batching pass did.
+    struct StaticBatchStats
+    {
+        std::size_t MeshesBefore { 0 };
+        std::size_t MeshesAfter  { 0 };
+        /// @brief Source meshes that ended up in a batch.
+        std::size_t MeshesMerged { 0 };
+        std::size_t Batches      { 0 };
+    };
+
+    class StaticBatcher
+    {
+    public:
+        /// @brief Meshes with more vertices than this are drawn on their own; batching only pays off for small ones.
+        static constexpr std::size_t kMaxPartVertices  = std::size_t(1) << 14;
+
+        /// @brief Largest vertex count of one batch, so a material used everywhere still yields several
+        /// buffers, each small enough for 16-bit indices.
+        static constexpr std::size_t kMaxBatchVertices = std::size_t(1) << 16;
+
+        /// @brief Merges the small, once-placed meshes of each material. Merged meshes are dropped from
+        /// their nodes and drawn by a new root node with an identity transform; node indices of the
+        /// remaining meshes and of the stream meshes are renumbered.
+        /// @param scene The scene to batch in place. Only MeshData meshes take part.
+        /// @param maxPartVertices Meshes with more vertices are left alone.
+        /// @return What was merged.
+        static StaticBatchStats Batch(ImportedScene& scene, std::size_t maxPartVertices = kMaxPartVertices);
+
+    private:
+        StaticBatcher() = delete;
+    };
+}
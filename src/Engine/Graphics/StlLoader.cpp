@@ -0,0 +1,148 @@
+#include "StlLoader.h"
+#include "MeshProcessing.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include "Utility/MemoryStats.h"
+#include "Utility/ThreadPool.h"
+#include "Utility/Timer.h"
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+
+namespace isaacObjectViewer
+{
+    // binary layout: 80-byte header, uint32 triangle count, then 50-byte records of
+    // normal[3], v0[3], v1[3], v2[3] (floats) and a 16-bit attribute word
+    static constexpr std::size_t kHeaderSize  = 84;
+    static constexpr std::size_t kRecordSize  = 50;
+    static constexpr std::size_t kCornerStart = 12;
+
+    static inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    // binary files may also start with "solid", so the size check decides first
+    static bool isBinary(const unsigned char* data, std::size_t size, std::size_t& triangleCount)
+    {
+        if (size < kHeaderSize)
+            return false;
+        std::uint32_t count;
+        std::memcpy(&count, data + 80, 4);
+        triangleCount = count;
+        if (kHeaderSize + std::size_t(count) * kRecordSize == size)
+            return true;
+
+        const bool looksAscii = size >= 5 && std::memcmp(data, "solid", 5) == 0;
+        if (!looksAscii && kHeaderSize + std::size_t(count) * kRecordSize <= size)
+            return true; // trailing bytes after the last record
+        return false;
+    }
+
+    // ASCII STL: only the "vertex x y z" lines matter; collected as 36-byte triangles
+    static std::vector<float> parseAscii(const char* p, const char* end)
+    {
+        std::vector<float> corners;
+        while (p < end)
+        {
+            while (p < end && isSpace(*p))
+                ++p;
+            const char* token = p;
+            while (p < end && !isSpace(*p))
+                ++p;
+            if (p - token != 6 || std::memcmp(token, "vertex", 6) != 0)
+                continue;
+
+            for (int c = 0; c < 3; ++c)
+            {
+                while (p < end && isSpace(*p))
+                    ++p;
+                if (p < end && *p == '+')
+                    ++p;
+                float value = 0.0f;
+                auto result = std::from_chars(p, end, value);
+                p = result.ptr;
+                corners.push_back(value);
+            }
+        }
+        corners.resize(corners.size() / 9 * 9); // drop an incomplete last facet
+        return corners;
+    }
+
+    std::unique_ptr<ImportedScene> StlLoader::Load(const std::string& path, ThreadPool& pool, ImportProgress* progress)
+    {
+        MappedFile file(path);
+        if (!file.IsOpen())
+        {
+            LOG_ERROR("Failed to open STL file: {}", path);
+            if (progress)
+                progress->Enter(ImportStage::Failed);
+            return nullptr;
+        }
+        return LoadFromMemory(file.Data(), file.Size(), std::filesystem::path(path).stem().string(), pool, progress);
+    }
+
+    std::unique_ptr<ImportedScene> StlLoader::LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                             const std::string& name, ThreadPool& pool,
+                                                             ImportProgress* progress)
+    {
+        auto cancelled = [progress]()
+        {
+            if (!progress || !progress->CancelRequested.load())
+                return false;
+            progress->Enter(ImportStage::Cancelled);
+            return true;
+        };
+
+        Timer timer;
+        timer.Start();
+        if (progress)
+            progress->Enter(ImportStage::Parsing);
+
+        // --- weld the triangle soup, straight from the mapping for binary files ---
+        std::size_t triangleCount = 0;
+        std::vector<float> ascii;
+        WeldedPositions welded;
+        if (isBinary(data, size, triangleCount))
+        {
+            welded = MeshProcessing::WeldPositions(data + kHeaderSize, triangleCount, kRecordSize, kCornerStart, pool);
+        }
+        else
+        {
+            ascii = parseAscii(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + size);
+            triangleCount = ascii.size() / 9;
+            welded = MeshProcessing::WeldPositions(reinterpret_cast<const unsigned char*>(ascii.data()),
+                                                   triangleCount, 36, 0, pool);
+            ascii = std::vector<float>();
+        }
+        if (cancelled())
+            return nullptr;
+
+        if (triangleCount == 0)
+        {
+            LOG_ERROR("STL: no triangles in {}", name);
+            if (progress)
+                progress->Enter(ImportStage::Failed);
+            return nullptr;
+        }
+
+        // --- normals and meshes ---
+        if (progress)
+            progress->Enter(ImportStage::Converting);
+
+        const std::vector<glm::vec3> normals =
+            MeshProcessing::ComputeSmoothNormals(welded.Positions.get(), welded.VertexCount, welded.Indices, pool);
+        if (cancelled())
+            return nullptr;
+
+        auto scene = std::make_unique<ImportedScene>();
+        scene->Materials.emplace_back();
+        scene->Meshes = MeshProcessing::BuildMeshes(name, welded.Positions.get(), normals.data(), nullptr,
+                                                    welded.VertexCount, std::move(welded.Indices), pool);
+
+        const float seconds = timer.Stop();
+        LOG_INFO("STL: {} triangles, {} vertices in {:.1f} ms ({:.1f} M triangles/s), peak RSS {:.0f} MB",
+                 triangleCount, welded.VertexCount, seconds * 1000.0f,
+                 seconds > 0.0f ? double(triangleCount) / seconds / 1e6 : 0.0,
+                 MemoryStats::ToMB(MemoryStats::GetPeakResidentBytes()));
+        return scene;
+    }
+}
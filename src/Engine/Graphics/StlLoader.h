@@ -0,0 +1,45 @@
+/**
+ * @file StlLoader.h
+ * @brief Native STL importer for large scanned meshes.
+ * Binary files are memory-mapped and their unindexed triangles are welded in place with
+ * a lock-free hash shared by the worker pool (MeshProcessing::WeldPositions); smooth
+ * normals are then accumulated in parallel. ASCII files are parsed into the same layout
+ * first. Meshes too large for one vertex buffer are split into several.
+ */
+
+#pragma once
+
+#include "Graphics/ImportedScene.h"
+#include <memory>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool;
+
+    class StlLoader
+    {
+    public:
+        /// @brief Loads a binary or ASCII STL file.
+        /// @param path The path to the .stl file.
+        /// @param pool The pool to weld on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene, or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> Load(const std::string& path, ThreadPool& pool,
+                                                   ImportProgress* progress = nullptr);
+
+        /// @brief Loads STL contents that are already in memory.
+        /// @param data The file contents.
+        /// @param size The size of the contents in bytes.
+        /// @param name The name to give the mesh.
+        /// @param pool The pool to weld on.
+        /// @param progress Optional progress record; its CancelRequested flag aborts the load.
+        /// @return The imported scene, or nullptr on failure or cancel.
+        static std::unique_ptr<ImportedScene> LoadFromMemory(const unsigned char* data, std::size_t size,
+                                                             const std::string& name, ThreadPool& pool,
+                                                             ImportProgress* progress = nullptr);
+
+    private:
+        StlLoader() = delete;
+    };
+}
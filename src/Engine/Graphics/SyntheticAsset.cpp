@@ -0,0 +1,665 @@
+#include "SyntheticAsset.h"
+#include "Utility/Hash.h"
+#include "Utility/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace isaacObjectViewer
+{
+    // splitmix64: tiny, and the same sequence on every platform (std distributions are not)
+    class SplitMix
+    {
+    public:
+        explicit SplitMix(std::uint64_t seed) : m_State(seed) { }
+
+        std::uint64_t Next()
+        {
+            std::uint64_t z = (m_State += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        /// uniform in [0, 1)
+        float Uniform() { return float(Next() >> 40) * (1.0f / 16777216.0f); }
+
+    private:
+        std::uint64_t m_State;
+    };
+
+    // buffered output; numbers are formatted with to_chars, so the text doesn't depend on the locale
+    class FileWriter
+    {
+    public:
+        explicit FileWriter(const std::string& path) : m_File(std::fopen(path.c_str(), "wb")) { m_Buffer.reserve(kFlushSize + 4096); }
+        ~FileWriter() { Close(); }
+
+        bool IsOpen() const { return m_File != nullptr; }
+
+        void Text(const char* text) { m_Buffer.append(text); Check(); }
+        void Text(const std::string& text) { m_Buffer.append(text); Check(); }
+        void Bytes(const void* data, std::size_t size) { m_Buffer.append(static_cast<const char*>(data), size); Check(); }
+
+        template<typename T>
+        void Number(T value)
+        {
+            char digits[32];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            m_Buffer.append(digits, result.ptr);
+        }
+
+        bool Close()
+        {
+            if (!m_File)
+                return m_Ok;
+            Flush();
+            m_Ok = std::fclose(m_File) == 0 && m_Ok;
+            m_File = nullptr;
+            return m_Ok;
+        }
+
+    private:
+        static constexpr std::size_t kFlushSize = std::size_t(4) << 20;
+
+        void Check()
+        {
+            if (m_Buffer.size() >= kFlushSize)
+                Flush();
+        }
+
+        void Flush()
+        {
+            if (m_File && !m_Buffer.empty())
+                m_Ok = std::fwrite(m_Buffer.data(), 1, m_Buffer.size(), m_File) == m_Buffer.size() && m_Ok;
+            m_Buffer.clear();
+        }
+
+        std::FILE*  m_File;
+        std::string m_Buffer;
+        bool        m_Ok = true;
+    };
+
+    // --- geometry --------------------------------------------------------
+
+    // a grid of quads, w wide, with a last partial row for the triangles left over
+    struct TileShape
+    {
+        std::uint64_t Triangles  { 0 };
+        std::uint64_t Columns    { 1 };
+        std::uint64_t FullRows   { 0 };
+        std::uint64_t Remainder  { 0 };
+        std::uint64_t VertexRows { 1 };
+
+        std::uint64_t VertexCount() const { return (Columns + 1) * VertexRows; }
+    };
+
+    static TileShape makeShape(std::uint64_t triangles)
+    {
+        TileShape shape;
+        shape.Triangles  = triangles;
+        shape.Columns    = std::max<std::uint64_t>(1, std::llround(std::sqrt(double(triangles) / 2.0)));
+        shape.FullRows   = triangles / (2 * shape.Columns);
+        shape.Remainder  = triangles - 2 * shape.Columns * shape.FullRows;
+        shape.VertexRows = shape.FullRows + 1 + (shape.Remainder > 0 ? 1 : 0);
+        return shape;
+    }
+
+    // a rolling heightfield over the unit square; amplitude and frequencies come from the mesh's own seed
+    struct TileWaves
+    {
+        float Amplitude, FrequencyX, FrequencyZ, PhaseX, PhaseZ;
+    };
+
+    static TileWaves makeWaves(std::uint64_t seed, unsigned int mesh)
+    {
+        SplitMix random(HashBytes(&mesh, sizeof(mesh), seed));
+        constexpr float kTau = 6.2831853f;
+        TileWaves waves;
+        waves.Amplitude  = 0.03f + 0.09f * random.Uniform();
+        waves.FrequencyX = kTau * (1.0f + 3.0f * random.Uniform());
+        waves.FrequencyZ = kTau * (1.0f + 3.0f * random.Uniform());
+        waves.PhaseX     = kTau * random.Uniform();
+        waves.PhaseZ     = kTau * random.Uniform();
+        return waves;
+    }
+
+    struct TileVertex
+    {
+        float Position[3];
+        float Normal[3];
+        float TexCoord[2];
+    };
+    static_assert(sizeof(TileVertex) == 32);
+
+    static TileVertex tileVertex(const TileShape& shape, const TileWaves& waves, std::uint64_t index, const float offset[3])
+    {
+        const std::uint64_t column = index % (shape.Columns + 1);
+        const std::uint64_t row    = index / (shape.Columns + 1);
+        const float x = float(column) / float(shape.Columns);
+        const float z = shape.VertexRows > 1 ? float(row) / float(shape.VertexRows - 1) : 0.0f;
+
+        const float sx = std::sin(waves.FrequencyX * x + waves.PhaseX), cx = std::cos(waves.FrequencyX * x + waves.PhaseX);
+        const float sz = std::sin(waves.FrequencyZ * z + waves.PhaseZ), cz = std::cos(waves.FrequencyZ * z + waves.PhaseZ);
+        const float dx =  waves.Amplitude * waves.FrequencyX * cx * cz;
+        const float dz = -waves.Amplitude * waves.FrequencyZ * sx * sz;
+        const float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+
+        TileVertex v;
+        v.Position[0] = x + offset[0];
+        v.Position[1] = waves.Amplitude * sx * cz + offset[1];
+        v.Position[2] = z + offset[2];
+        v.Normal[0]   = -dx / length;
+        v.Normal[1]   = 1.0f / length;
+        v.Normal[2]   = -dz / length;
+        v.TexCoord[0] = x;
+        v.TexCoord[1] = z;
+        return v;
+    }
+
+    // calls emit(a, b, c) for every triangle, counter-clockwise seen from +Y
+    template<typename F>
+    static void forEachTriangle(const TileShape& shape, F&& emit)
+    {
+        const std::uint64_t stride = shape.Columns + 1;
+        for (std::uint64_t row = 0; row < shape.FullRows; ++row)
+        {
+            for (std::uint64_t column = 0; column < shape.Columns; ++column)
+            {
+                const std::uint64_t a = row * stride + column, b = a + 1, c = a + stride, d = c + 1;
+                emit(a, c, b);
+                emit(b, c, d);
+            }
+        }
+        std::uint64_t left = shape.Remainder;
+        for (std::uint64_t column = 0; left > 0; ++column)
+        {
+            const std::uint64_t a = shape.FullRows * stride + column, b = a + 1, c = a + stride, d = c + 1;
+            emit(a, c, b);
+            if (--left > 0)
+            {
+                emit(b, c, d);
+                --left;
+            }
+        }
+    }
+
+    struct Layout
+    {
+        std::vector<TileShape> Shapes;
+        std::vector<TileWaves> Waves;
+        unsigned int           Materials  { 1 };
+        unsigned int           Instances  { 1 };
+        unsigned int           Columns    { 1 };
+
+        // placements sit on a grid of unit tiles with a small gap
+        void Offset(unsigned int mesh, unsigned int instance, float out[3]) const
+        {
+            const unsigned int k = mesh * Instances + instance;
+            out[0] = float(k % Columns) * 1.25f;
+            out[1] = 0.0f;
+            out[2] = float(k / Columns) * 1.25f;
+        }
+    };
+
+    static Layout makeLayout(const SyntheticAssetOptions& options)
+    {
+        Layout layout;
+        const std::uint64_t triangles = std::max<std::uint64_t>(1, options.Triangles);
+        const unsigned int meshes = static_cast<unsigned int>(std::clamp<std::uint64_t>(options.Meshes, 1, triangles));
+        layout.Materials = std::max(1u, options.Materials);
+        layout.Instances = std::max(1u, options.Instances);
+        layout.Columns   = std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(double(meshes) * layout.Instances))));
+        for (unsigned int m = 0; m < meshes; ++m)
+        {
+            layout.Shapes.push_back(makeShape(triangles / meshes + (m < triangles % meshes ? 1 : 0)));
+            layout.Waves.push_back(makeWaves(options.Seed, m));
+        }
+        return layout;
+    }
+
+    static std::array<float, 3> materialColor(std::uint64_t seed, unsigned int material)
+    {
+        SplitMix random(HashBytes(&material, sizeof(material), seed ^ 0x6d617465ull));
+        return { 0.2f + 0.8f * random.Uniform(), 0.2f + 0.8f * random.Uniform(), 0.2f + 0.8f * random.Uniform() };
+    }
+
+    // --- textures --------------------------------------------------------
+
+    static std::uint32_t crc32(const unsigned char* data, std::size_t size, std::uint32_t crc = 0)
+    {
+        static const auto table = []()
+        {
+            std::array<std::uint32_t, 256> t{};
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    static void bigEndian(std::string& out, std::uint32_t value)
+    {
+        const char bytes[4] = { char(value >> 24), char(value >> 16), char(value >> 8), char(value) };
+        out.append(bytes, 4);
+    }
+
+    static void pngChunk(std::string& out, const char* type, const std::string& data)
+    {
+        bigEndian(out, static_cast<std::uint32_t>(data.size()));
+        const std::string typed = std::string(type, 4) + data;
+        out += typed;
+        bigEndian(out, crc32(reinterpret_cast<const unsigned char*>(typed.data()), typed.size()));
+    }
+
+    // an RGB checkerboard in the material's color with per-pixel noise; stored (uncompressed) deflate
+    // keeps the writer small, and decode cost then scales with the pixel count alone
+    static bool writeTexture(const std::string& path, unsigned int size, std::uint64_t seed, unsigned int material)
+    {
+        const std::array<float, 3> color = materialColor(seed, material);
+        std::string raw;
+        raw.reserve(std::size_t(size) * (size * 3 + 1));
+        SplitMix noise(HashBytes(&material, sizeof(material), seed ^ 0x7465787475ull));
+        const unsigned int cell = std::max(1u, size / 8);
+        for (unsigned int y = 0; y < size; ++y)
+        {
+            raw += '\0'; // filter: none
+            for (unsigned int x = 0; x < size; ++x)
+            {
+                const float shade = (((x / cell) + (y / cell)) & 1) ? 1.0f : 0.6f;
+                const std::uint64_t n = noise.Next();
+                for (int c = 0; c < 3; ++c)
+                    raw += char(std::clamp(int(color[c] * shade * 230.0f) + int((n >> (c * 8)) & 0x1f), 0, 255));
+            }
+        }
+
+        std::string zlib = { char(0x78), char(0x01) };
+        for (std::size_t at = 0; at < raw.size() || at == 0; )
+        {
+            const std::size_t len = std::min<std::size_t>(65535, raw.size() - at);
+            const bool last = at + len == raw.size();
+            zlib += char(last ? 1 : 0);
+            zlib += char(len & 0xff);
+            zlib += char(len >> 8);
+            zlib += char(~len & 0xff);
+            zlib += char((~len >> 8) & 0xff);
+            zlib.append(raw, at, len);
+            at += len;
+            if (last)
+                break;
+        }
+        std::uint32_t a = 1, b = 0;
+        for (unsigned char c : raw)
+        {
+            a = (a + c) % 65521;
+            b = (b + a) % 65521;
+        }
+        bigEndian(zlib, (b << 16) | a);
+
+        std::string header;
+        bigEndian(header, size);
+        bigEndian(header, size);
+        header += { char(8), char(2), char(0), char(0), char(0) }; // 8-bit RGB
+
+        std::string png = "\x89PNG\r\n\x1a\n";
+        pngChunk(png, "IHDR", header);
+        pngChunk(png, "IDAT", zlib);
+        pngChunk(png, "IEND", std::string());
+
+        FileWriter out(path);
+        out.Bytes(png.data(), png.size());
+        return out.IsOpen() && out.Close();
+    }
+
+    // --- formats ---------------------------------------------------------
+
+    static void objVector(FileWriter& out, const char* prefix, const float* values, int count)
+    {
+        out.Text(prefix);
+        for (int i = 0; i < count; ++i)
+        {
+            out.Text(" ");
+            out.Number(values[i]);
+        }
+        out.Text("\n");
+    }
+
+    static bool writeObj(const std::string& path, const std::string& stem, const Layout& layout,
+                         const std::vector<std::string>& textures, const SyntheticAssetOptions& options, std::vector<std::string>& files)
+    {
+        const std::string mtlPath = (std::filesystem::path(path).parent_path() / (stem + ".mtl")).string();
+        {
+            FileWriter mtl(mtlPath);
+            for (unsigned int k = 0; k < layout.Materials; ++k)
+            {
+                const std::array<float, 3> color = materialColor(options.Seed, k);
+                mtl.Text("newmtl material_" + std::to_string(k) + "\n");
+                objVector(mtl, "Kd", color.data(), 3);
+                mtl.Text("Ks 0.2 0.2 0.2\nNs 32\n");
+                if (!textures.empty())
+                    mtl.Text("map_Kd " + textures[k] + "\n");
+            }
+            if (!mtl.IsOpen() || !mtl.Close())
+                return false;
+            files.push_back(mtlPath);
+        }
+
+        FileWriter out(path);
+        out.Text("# iov-gen synthetic asset, seed " + std::to_string(options.Seed) + "\n");
+        out.Text("mtllib " + stem + ".mtl\n");
+        std::uint64_t base = 1;
+        for (unsigned int m = 0; m < layout.Shapes.size(); ++m)
+        {
+            const TileShape& shape = layout.Shapes[m];
+            for (unsigned int p = 0; p < layout.Instances; ++p)
+            {
+                float offset[3];
+                layout.Offset(m, p, offset);
+                out.Text("o mesh_" + std::to_string(m) + (layout.Instances > 1 ? "_" + std::to_string(p) : std::string()) + "\n");
+                out.Text("usemtl material_" + std::to_string(m % layout.Materials) + "\n");
+                for (std::uint64_t v = 0; v < shape.VertexCount(); ++v)
+                {
+                    const TileVertex vertex = tileVertex(shape, layout.Waves[m], v, offset);
+                    objVector(out, "v",  vertex.Position, 3);
+                    objVector(out, "vt", vertex.TexCoord, 2);
+                    objVector(out, "vn", vertex.Normal, 3);
+                }
+                forEachTriangle(shape, [&](std::uint64_t a, std::uint64_t b, std::uint64_t c)
+                {
+                    out.Text("f");
+                    for (std::uint64_t index : { a, b, c })
+                    {
+                        out.Text(" ");
+                        out.Number(base + index);
+                        out.Text("/");
+                        out.Number(base + index);
+                        out.Text("/");
+                        out.Number(base + index);
+                    }
+                    out.Text("\n");
+                });
+                base += shape.VertexCount();
+            }
+        }
+        return out.IsOpen() && out.Close();
+    }
+
+    static bool writePly(const std::string& path, const Layout& layout, const SyntheticAssetOptions& options)
+    {
+        std::uint64_t vertices = 0, faces = 0;
+        for (const TileShape& shape : layout.Shapes)
+        {
+            vertices += shape.VertexCount() * layout.Instances;
+            faces    += shape.Triangles * layout.Instances;
+        }
+
+        FileWriter out(path);
+        out.Text("ply\nformat binary_little_endian 1.0\ncomment iov-gen synthetic asset, seed " + std::to_string(options.Seed) + "\n");
+        out.Text("element vertex " + std::to_string(vertices) + "\n");
+        out.Text("property float x\nproperty float y\nproperty float z\n");
+        out.Text("property float nx\nproperty float ny\nproperty float nz\n");
+        out.Text("property float u\nproperty float v\n");
+        out.Text("element face " + std::to_string(faces) + "\n");
+        out.Text("property list uchar uint vertex_indices\nend_header\n");
+
+        // all vertices first, then all faces, as the format wants
+        for (unsigned int m = 0; m < layout.Shapes.size(); ++m)
+        {
+            for (unsigned int p = 0; p < layout.Instances; ++p)
+            {
+                float offset[3];
+                layout.Offset(m, p, offset);
+                for (std::uint64_t v = 0; v < layout.Shapes[m].VertexCount(); ++v)
+                {
+                    const TileVertex vertex = tileVertex(layout.Shapes[m], layout.Waves[m], v, offset);
+                    out.Bytes(&vertex, sizeof(vertex));
+                }
+            }
+        }
+        std::uint64_t base = 0;
+        for (unsigned int m = 0; m < layout.Shapes.size(); ++m)
+        {
+            for (unsigned int p = 0; p < layout.Instances; ++p)
+            {
+                forEachTriangle(layout.Shapes[m], [&](std::uint64_t a, std::uint64_t b, std::uint64_t c)
+                {
+                    unsigned char face[13];
+                    face[0] = 3;
+                    const std::uint32_t indices[3] = { std::uint32_t(base + a), std::uint32_t(base + b), std::uint32_t(base + c) };
+                    std::memcpy(face + 1, indices, sizeof(indices));
+                    out.Bytes(face, sizeof(face));
+                });
+                base += layout.Shapes[m].VertexCount();
+            }
+        }
+        return out.IsOpen() && out.Close();
+    }
+
+    static bool writeGltf(const std::string& path, const std::string& stem, const Layout& layout,
+                          const std::vector<std::string>& textures, const SyntheticAssetOptions& options, std::vector<std::string>& files)
+    {
+        const std::string binName = stem + ".bin";
+        const std::string binPath = (std::filesystem::path(path).parent_path() / binName).string();
+        FileWriter bin(binPath);
+        if (!bin.IsOpen())
+            return false;
+
+        // one buffer; per mesh four views (positions, normals, UVs, indices) and an accessor for each
+        std::string views, accessors, meshes;
+        std::uint64_t offset = 0;
+        auto number = [](float value)
+        {
+            char digits[32];
+            return std::string(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+        };
+        auto addView = [&](std::uint64_t bytes, bool indices)
+        {
+            views += (views.empty() ? "" : ",") + std::string("\n    { \"buffer\": 0, \"byteOffset\": ") + std::to_string(offset) +
+                     ", \"byteLength\": " + std::to_string(bytes) + ", \"target\": " + (indices ? "34963" : "34962") + " }";
+            offset += bytes;
+        };
+        unsigned int accessorCount = 0;
+        auto addAccessor = [&](unsigned int view, std::uint64_t count, const char* type, int componentType, const std::string& bounds)
+        {
+            accessors += (accessors.empty() ? "" : ",") + std::string("\n    { \"bufferView\": ") + std::to_string(view) +
+                         ", \"componentType\": " + std::to_string(componentType) + ", \"count\": " + std::to_string(count) +
+                         ", \"type\": \"" + type + "\"" + bounds + " }";
+            return accessorCount++;
+        };
+
+        std::vector<float> positions, normals, uvs;
+        std::vector<std::uint32_t> indices;
+        const float origin[3] = { 0.0f, 0.0f, 0.0f };
+        for (unsigned int m = 0; m < layout.Shapes.size(); ++m)
+        {
+            const TileShape& shape = layout.Shapes[m];
+            positions.clear(); normals.clear(); uvs.clear(); indices.clear();
+            float lo[3] = {  1e30f,  1e30f,  1e30f };
+            float hi[3] = { -1e30f, -1e30f, -1e30f };
+            for (std::uint64_t v = 0; v < shape.VertexCount(); ++v)
+            {
+                const TileVertex vertex = tileVertex(shape, layout.Waves[m], v, origin);
+                positions.insert(positions.end(), vertex.Position, vertex.Position + 3);
+                normals.insert(normals.end(), vertex.Normal, vertex.Normal + 3);
+                uvs.insert(uvs.end(), vertex.TexCoord, vertex.TexCoord + 2);
+                for (int c = 0; c < 3; ++c)
+                {
+                    lo[c] = std::min(lo[c], vertex.Position[c]);
+                    hi[c] = std::max(hi[c], vertex.Position[c]);
+                }
+            }
+            forEachTriangle(shape, [&](std::uint64_t a, std::uint64_t b, std::uint64_t c)
+            {
+                indices.insert(indices.end(), { std::uint32_t(a), std::uint32_t(b), std::uint32_t(c) });
+            });
+
+            const unsigned int view = 4 * m;
+            bin.Bytes(positions.data(), positions.size() * sizeof(float)); addView(positions.size() * sizeof(float), false);
+            bin.Bytes(normals.data(),   normals.size() * sizeof(float));   addView(normals.size() * sizeof(float), false);
+            bin.Bytes(uvs.data(),       uvs.size() * sizeof(float));       addView(uvs.size() * sizeof(float), false);
+            bin.Bytes(indices.data(),   indices.size() * sizeof(std::uint32_t)); addView(indices.size() * sizeof(std::uint32_t), true);
+
+            const std::string bounds = ", \"min\": [" + number(lo[0]) + ", " + number(lo[1]) + ", " + number(lo[2]) +
+                                       "], \"max\": [" + number(hi[0]) + ", " + number(hi[1]) + ", " + number(hi[2]) + "]";
+            const unsigned int position = addAccessor(view,     shape.VertexCount(), "VEC3", 5126, bounds);
+            const unsigned int normal   = addAccessor(view + 1, shape.VertexCount(), "VEC3", 5126, "");
+            const unsigned int uv       = addAccessor(view + 2, shape.VertexCount(), "VEC2", 5126, "");
+            const unsigned int index    = addAccessor(view + 3, indices.size(),      "SCALAR", 5125, "");
+            meshes += (m ? "," : "") + std::string("\n    { \"name\": \"mesh_") + std::to_string(m) +
+                      "\", \"primitives\": [ { \"attributes\": { \"POSITION\": " + std::to_string(position) +
+                      ", \"NORMAL\": " + std::to_string(normal) + ", \"TEXCOORD_0\": " + std::to_string(uv) +
+                      " }, \"indices\": " + std::to_string(index) + ", \"material\": " + std::to_string(m % layout.Materials) + " } ] }";
+        }
+        if (!bin.Close())
+            return false;
+        files.push_back(binPath);
+
+        // shared references: every placement of a mesh is a node pointing at the same mesh
+        std::string nodes, sceneNodes;
+        unsigned int nodeCount = 0;
+        for (unsigned int m = 0; m < layout.Shapes.size(); ++m)
+        {
+            for (unsigned int p = 0; p < layout.Instances; ++p)
+            {
+                float at[3];
+                layout.Offset(m, p, at);
+                nodes += (nodeCount ? "," : "") + std::string("\n    { \"mesh\": ") + std::to_string(m) +
+                         ", \"translation\": [" + number(at[0]) + ", " + number(at[1]) + ", " + number(at[2]) + "] }";
+                sceneNodes += (nodeCount ? ", " : "") + std::to_string(nodeCount);
+                ++nodeCount;
+            }
+        }
+
+        std::string materials, images, textureList;
+        for (unsigned int k = 0; k < layout.Materials; ++k)
+        {
+            const std::array<float, 3> color = materialColor(options.Seed, k);
+            materials += (k ? "," : "") + std::string("\n    { \"name\": \"material_") + std::to_string(k) +
+                         "\", \"pbrMetallicRoughness\": { \"baseColorFactor\": [" + number(color[0]) + ", " + number(color[1]) +
+                         ", " + number(color[2]) + ", 1]" +
+                         (textures.empty() ? std::string() : ", \"baseColorTexture\": { \"index\": " + std::to_string(k) + " }") +
+                         ", \"metallicFactor\": 0, \"roughnessFactor\": 0.8 } }";
+            if (!textures.empty())
+            {
+                images      += (k ? "," : "") + std::string("\n    { \"uri\": \"") + textures[k] + "\" }";
+                textureList += (k ? "," : "") + std::string("\n    { \"source\": ") + std::to_string(k) + " }";
+            }
+        }
+
+        FileWriter out(path);
+        out.Text("{\n  \"asset\": { \"version\": \"2.0\", \"generator\": \"iov-gen, seed " + std::to_string(options.Seed) + "\" },\n");
+        out.Text("  \"scene\": 0,\n  \"scenes\": [ { \"nodes\": [" + sceneNodes + "] } ],\n");
+        out.Text("  \"nodes\": [" + nodes + "\n  ],\n");
+        out.Text("  \"meshes\": [" + meshes + "\n  ],\n");
+        out.Text("  \"materials\": [" + materials + "\n  ],\n");
+        if (!textures.empty())
+        {
+            out.Text("  \"textures\": [" + textureList + "\n  ],\n");
+            out.Text("  \"images\": [" + images + "\n  ],\n");
+        }
+        out.Text("  \"accessors\": [" + accessors + "\n  ],\n");
+        out.Text("  \"bufferViews\": [" + views + "\n  ],\n");
+        out.Text("  \"buffers\": [ { \"uri\": \"" + binName + "\", \"byteLength\": " + std::to_string(offset) + " } ]\n}\n");
+        return out.IsOpen() && out.Close();
+    }
+
+    // ------------------------------------------------------------------------
+
+    const char* SyntheticAsset::GetExtension(SyntheticFormat format)
+    {
+        switch (format)
+        {
+            case SyntheticFormat::Obj:  return ".obj";
+            case SyntheticFormat::Ply:  return ".ply";
+            case SyntheticFormat::Gltf: return ".gltf";
+        }
+        return "";
+    }
+
+    bool SyntheticAsset::ParseFormat(const std::string& name, SyntheticFormat& out)
+    {
+        for (SyntheticFormat format : { SyntheticFormat::Obj, SyntheticFormat::Ply, SyntheticFormat::Gltf })
+        {
+            if (name == GetExtension(format) + 1)
+            {
+                out = format;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool SyntheticAsset::Write(const std::string& path, const SyntheticAssetOptions& options, SyntheticAssetStats* stats)
+    {
+        const Layout layout = makeLayout(options);
+        const std::filesystem::path target(path);
+        const std::string stem = target.stem().string();
+        std::error_code ec;
+        if (target.has_parent_path())
+            std::filesystem::create_directories(target.parent_path(), ec);
+
+        std::vector<std::string> files;
+        std::vector<std::string> textures; // relative to the model, as written into it
+        if (options.TextureSize > 0 && options.Format != SyntheticFormat::Ply)
+        {
+            std::filesystem::create_directories(target.parent_path() / "textures", ec);
+            for (unsigned int k = 0; k < layout.Materials; ++k)
+            {
+                const std::string name = "textures/" + stem + "_material_" + std::to_string(k) + ".png";
+                const std::string file = (target.parent_path() / name).string();
+                if (!writeTexture(file, options.TextureSize, options.Seed, k))
+                {
+                    LOG_ERROR("Failed to write texture {}", file);
+                    return false;
+                }
+                textures.push_back(name);
+                files.push_back(file);
+            }
+        }
+
+        bool ok = false;
+        switch (options.Format)
+        {
+            case SyntheticFormat::Obj:  ok = writeObj(path, stem, layout, textures, options, files);  break;
+            case SyntheticFormat::Ply:  ok = writePly(path, layout, options);                         break;
+            case SyntheticFormat::Gltf: ok = writeGltf(path, stem, layout, textures, options, files); break;
+        }
+        if (!ok)
+        {
+            LOG_ERROR("Failed to write synthetic asset {}", path);
+            return false;
+        }
+        files.insert(files.begin(), path);
+
+        if (stats)
+        {
+            *stats = SyntheticAssetStats{};
+            for (const TileShape& shape : layout.Shapes)
+            {
+                stats->Triangles += shape.Triangles;
+                stats->Vertices  += shape.VertexCount();
+            }
+            stats->DrawnTriangles = stats->Triangles * layout.Instances;
+            stats->Meshes         = static_cast<unsigned int>(layout.Shapes.size());
+            stats->Materials      = options.Format == SyntheticFormat::Ply ? 0 : layout.Materials;
+            stats->Placements     = stats->Meshes * layout.Instances;
+            for (const std::string& file : files)
+                stats->Bytes += std::filesystem::file_size(file, ec);
+            stats->Files = std::move(files);
+        }
+        return true;
+    }
+}
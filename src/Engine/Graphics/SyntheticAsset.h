@@ -0,0 +1,82 @@
+/**
+ * @file SyntheticAsset.h
+ * @brief Writes deterministic model files of a chosen size, for import and render benchmarks.
+ * Customer models can't be shared, so performance problems are reproduced on generated ones
+ * instead: the same options and seed always give byte-identical files. Each mesh is a
+ * rolling heightfield tile with normals and UVs; meshes are spread over materials, materials
+ * can carry a generated texture, and every mesh can be placed several times. glTF files
+ * reference a placed mesh from several nodes; OBJ and PLY have no instancing, so their copies
+ * are written out in full. PLY holds a single mesh without materials, so meshes are
+ * concatenated and materials ignored.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    enum class SyntheticFormat : unsigned int
+    {
+        Obj = 0,
+        Ply,
+        Gltf,
+    };
+
+    /// @brief What to generate.
+    struct SyntheticAssetOptions
+    {
+        SyntheticFormat Format      { SyntheticFormat::Obj };
+        /// @brief Triangles of distinct geometry, split evenly over the meshes; drawn triangles are this times Instances.
+        std::uint64_t   Triangles   { 1u << 20 };
+        unsigned int    Meshes      { 16 };
+        unsigned int    Materials   { 4 };
+        /// @brief Width and height of each material's texture; 0 writes no textures.
+        unsigned int    TextureSize { 0 };
+        /// @brief Placements of each mesh (shared references in glTF).
+        unsigned int    Instances   { 1 };
+        std::uint64_t   Seed        { 1 };
+    };
+
+    /// @brief What a call to SyntheticAsset::Write produced.
+    struct SyntheticAssetStats
+    {
+        std::uint64_t            Triangles     { 0 };
+        std::uint64_t            Vertices      { 0 };
+        /// @brief Triangles drawn once every placement is counted.
+        std::uint64_t            DrawnTriangles { 0 };
+        unsigned int             Meshes        { 0 };
+        unsigned int             Materials     { 0 };
+        unsigned int             Placements    { 0 };
+        /// @brief Every file written (model, side files, textures) and their total size.
+        std::vector<std::string> Files;
+        std::uint64_t            Bytes         { 0 };
+    };
+
+    class SyntheticAsset
+    {
+    public:
+        /// @brief Writes a model and its side files (.mtl, .bin, textures/) next to it.
+        /// @param path The model file to write; its extension should match the format.
+        /// @param options What to generate. Meshes is clamped to [1, Triangles].
+        /// @param stats Optional; receives what was written.
+        /// @return False if a file could not be written.
+        static bool Write(const std::string& path, const SyntheticAssetOptions& options, SyntheticAssetStats* stats = nullptr);
+
+        /// @brief Gets the file extension of a format, with the dot.
+        /// @param format The format.
+        /// @return ".obj", ".ply" or ".gltf".
+        static const char* GetExtension(SyntheticFormat format);
+
+        /// @brief Reads a format name ("obj", "ply", "gltf").
+        /// @param name The name.
+        /// @param out Receives the format.
+        /// @return False if the name is unknown.
+        static bool ParseFormat(const std::string& name, SyntheticFormat& out);
+
+    private:
+        SyntheticAsset() = delete;
+    };
+}
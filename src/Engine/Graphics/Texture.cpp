@@ -12,11 +12,13 @@ namespace isaacObjectViewer
         , m_Filter_Max(GL_LINEAR)
     {
         glGenTextures(1, &this->m_ID);
+        ++s_LiveCount;
     }
 
     Texture::~Texture()
     {
         glDeleteTextures(1, &m_ID);
+        --s_LiveCount;
     }
     void Texture::Generate(unsigned int width, unsigned int height, unsigned char* data, GLint internalFormat, GLenum dataFormat,TextureType type)
     {
@@ -55,6 +55,10 @@ namespace isaacObjectViewer
         /// @param newPath The new path of the texture.
         void SetPath(const std::string& newPath) { m_Path = newPath; }
 
+        /// @brief Gets the number of GL texture objects currently alive.
+        /// @return The number of Texture objects that exist.
+        static std::size_t GetLiveCount() { return s_LiveCount; }
+
     private:
         // holds the ID of the texture object, used for all texture operations to reference to this particular texture
         unsigned int m_ID;
@@ -68,5 +72,7 @@ namespace isaacObjectViewer
         unsigned int m_Wrap_T; // wrapping mode on T axis
         unsigned int m_Filter_Min; // filtering mode if texture pixels < screen pixels
         unsigned int m_Filter_Max; // filtering mode if texture pixels > screen pixels
+
+        static inline std::size_t s_LiveCount = 0; // GL thread only
     };
 } // namespace isaacGraphicsEngine
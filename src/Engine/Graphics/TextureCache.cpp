@@ -0,0 +1,173 @@
+#include "TextureCache.h"
+#include "Utility/config.h"
+#include "Utility/Hash.h"
+#include "Utility/Log.hpp"
+#include "Utility/MappedFile.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
+namespace isaacObjectViewer
+{
+    // --- file layout ---------------------------------------------------------
+    //
+    //  FileHeader, then Width * Height * Channels bytes of pixels, rows as stb_image returns them
+
+    static constexpr char          kMagic[4]      = { 'I', 'O', 'V', 'T' };
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    struct FileHeader
+    {
+        char          Magic[4];
+        std::uint32_t FormatVersion;
+        std::uint32_t EngineVersion;
+        std::uint32_t Channels;
+        std::uint64_t SourceHash;
+        std::uint64_t SourceSize;
+        std::uint32_t Width;
+        std::uint32_t Height;
+        std::uint64_t FileSize;
+    };
+    static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+    static std::uint64_t pixelBytes(const FileHeader& header)
+    {
+        return std::uint64_t(header.Width) * header.Height * header.Channels;
+    }
+
+    static bool readHeader(const MappedFile& file, const TextureCacheKey& key, FileHeader& header)
+    {
+        if (!file.IsOpen() || file.Size() < sizeof(FileHeader))
+            return false;
+        std::memcpy(&header, file.Data(), sizeof(FileHeader));
+        return std::memcmp(header.Magic, kMagic, sizeof(kMagic)) == 0
+            && header.FormatVersion == kFormatVersion
+            && header.EngineVersion == key.EngineVersion
+            && header.SourceHash    == key.SourceHash
+            && header.SourceSize    == key.SourceSize
+            && header.Channels      >= 1 && header.Channels <= 4
+            && header.FileSize      == file.Size()
+            && sizeof(FileHeader) + pixelBytes(header) == file.Size();
+    }
+
+    std::string TextureCache::GetCacheDirectory()
+    {
+        return GetProjectRootPath("cache/textures");
+    }
+
+    std::string TextureCache::GetCachePath(const std::string& sourcePath)
+    {
+        std::error_code ec;
+        std::filesystem::path source(sourcePath);
+        auto canonical = std::filesystem::weakly_canonical(source, ec);
+        const std::string key = (ec ? source : canonical).string();
+
+        // readable stem + hash of the full path, like the mesh cache
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(HashBytes(key.data(), key.size())));
+        return (std::filesystem::path(GetCacheDirectory()) / (source.stem().string() + "-" + hex + ".iovtex")).string();
+    }
+
+    bool TextureCache::MakeKey(const std::string& sourcePath, TextureCacheKey& out)
+    {
+        MappedFile file(sourcePath);
+        if (!file.IsOpen())
+            return false;
+        out.SourceHash    = HashBytes(file.Data(), file.Size());
+        out.SourceSize    = file.Size();
+        out.EngineVersion = ENGINE_VERSION;
+        return true;
+    }
+
+    bool TextureCache::IsCurrent(const std::string& cachePath, const TextureCacheKey& key)
+    {
+        MappedFile file(cachePath);
+        FileHeader header;
+        return readHeader(file, key, header);
+    }
+
+    DecodedImage TextureCache::Read(const std::string& cachePath, const TextureCacheKey& key)
+    {
+        DecodedImage image;
+        MappedFile file(cachePath);
+        FileHeader header;
+        if (!readHeader(file, key, header) || pixelBytes(header) == 0)
+            return image;
+
+        // malloc, since DecodedImageDeleter frees through stbi_image_free
+        const std::size_t size = static_cast<std::size_t>(pixelBytes(header));
+        image.Pixels.reset(static_cast<unsigned char*>(std::malloc(size)));
+        if (!image.Pixels)
+            return image;
+        std::memcpy(image.Pixels.get(), file.Data() + sizeof(FileHeader), size);
+        image.Width    = static_cast<int>(header.Width);
+        image.Height   = static_cast<int>(header.Height);
+        image.Channels = static_cast<int>(header.Channels);
+        return image;
+    }
+
+    bool TextureCache::Write(const std::string& cachePath, const DecodedImage& image, const TextureCacheKey& key)
+    {
+        if (!image.IsValid())
+            return false;
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+        FileHeader header{};
+        std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+        header.FormatVersion = kFormatVersion;
+        header.EngineVersion = key.EngineVersion;
+        header.Channels      = static_cast<std::uint32_t>(image.Channels);
+        header.SourceHash    = key.SourceHash;
+        header.SourceSize    = key.SourceSize;
+        header.Width         = static_cast<std::uint32_t>(image.Width);
+        header.Height        = static_cast<std::uint32_t>(image.Height);
+        header.FileSize      = sizeof(FileHeader) + pixelBytes(header);
+
+        // write next to the target and rename, so readers never see a half-written file
+        const std::string tmpPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_ERROR("Failed to create texture cache file: {}", tmpPath);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(image.Pixels.get()), static_cast<std::streamsize>(pixelBytes(header)));
+            if (!file)
+            {
+                LOG_ERROR("Failed to write texture cache file: {}", tmpPath);
+                file.close();
+                std::filesystem::remove(tmpPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmpPath, cachePath, ec);
+        if (ec)
+        {
+            LOG_ERROR("Failed to replace texture cache file {}: {}", cachePath, ec.message());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    DecodedImage TextureCache::Load(const std::string& sourcePath)
+    {
+        TextureCacheKey key;
+        if (s_Enabled && MakeKey(sourcePath, key))
+        {
+            DecodedImage cached = Read(GetCachePath(sourcePath), key);
+            if (cached.IsValid())
+                return cached;
+        }
+        return TextureManager::DecodeImage(sourcePath);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file TextureCache.h
+ * @brief On-disk cache of decoded texture files.
+ * Decoding PNG or JPEG is the slow part of loading a texture; a cache entry holds the pixels
+ * exactly as TextureManager::DecodeImage returns them, so an import reads them back with one
+ * copy out of a mapping. Entries are keyed like the mesh cache: a hash of the source bytes and
+ * ENGINE_VERSION, and a stale entry is ignored. Imports only read the cache; entries are
+ * written by the iov-convert tool, since raw pixels are several times the size of the source.
+ */
+
+#pragma once
+
+#include "Graphics/TextureManager.h"
+#include <cstdint>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    /// @brief Identifies the source a texture cache entry was decoded from.
+    struct TextureCacheKey
+    {
+        std::uint64_t SourceHash    { 0 };
+        std::uint64_t SourceSize    { 0 };
+        std::uint32_t EngineVersion { 0 };
+    };
+
+    class TextureCache
+    {
+    public:
+        /// @brief Enables or disables reading cache entries for subsequent imports.
+        /// @param enabled True to read cache files.
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+
+        /// @brief Checks if the cache is enabled.
+        /// @return True if imports read cache files.
+        static bool IsEnabled() { return s_Enabled; }
+
+        /// @brief Gets the directory cache files are written to.
+        /// @return The cache directory.
+        static std::string GetCacheDirectory();
+
+        /// @brief Gets the cache file used for a source image.
+        /// @param sourcePath The path to the image file.
+        /// @return The cache file path (one file per source path).
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        /// @brief Builds the cache key of a source image by hashing its contents.
+        /// @param sourcePath The path to the image file.
+        /// @param out Receives the key.
+        /// @return False if the file can't be read.
+        static bool MakeKey(const std::string& sourcePath, TextureCacheKey& out);
+
+        /// @brief Checks if a cache file matches the key, reading only its header.
+        /// @param cachePath The cache file.
+        /// @param key The key the entry must have been written with.
+        /// @return True if Read would load the entry.
+        static bool IsCurrent(const std::string& cachePath, const TextureCacheKey& key);
+
+        /// @brief Loads the pixels of a cache file if it matches the key. Safe to call from any thread.
+        /// @param cachePath The cache file.
+        /// @param key The key the entry must have been written with.
+        /// @return The image; IsValid() is false on a miss or stale entry.
+        static DecodedImage Read(const std::string& cachePath, const TextureCacheKey& key);
+
+        /// @brief Writes a cache file, replacing any previous entry atomically.
+        /// @param cachePath The cache file.
+        /// @param image The decoded pixels.
+        /// @param key The key of the source the pixels were decoded from.
+        /// @return True if the file was written.
+        static bool Write(const std::string& cachePath, const DecodedImage& image, const TextureCacheKey& key);
+
+        /// @brief Decodes an image file, from its cache entry when there is a current one.
+        /// Safe to call from any thread.
+        /// @param sourcePath The path to the image file.
+        /// @return The decoded image; IsValid() is false if decoding failed.
+        static DecodedImage Load(const std::string& sourcePath);
+
+    private:
+        TextureCache() = delete;
+
+        static inline bool s_Enabled = true;
+    };
+}
@@ -2,72 +2,126 @@
 #include "stb_image.h"
 #include "Utility/config.h"
 #include "Utility/Log.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 
 namespace isaacObjectViewer
 {
     std::unordered_map<std::string, std::shared_ptr<Texture>> TextureManager::m_Textures;
-    
+    std::mutex TextureManager::m_Mutex;
+
+    void DecodedImageDeleter::operator()(unsigned char* pixels) const
+    {
+        stbi_image_free(pixels);
+    }
+
     std::shared_ptr<Texture> TextureManager::LoadTexture(const std::string &path, TextureType type)
     {
-        m_Textures[path] = LoadTextureFromFile(path,type);
-        return m_Textures[path];
+        return LoadTextureFromFile(path,type);
     }
 
     std::shared_ptr<Texture> TextureManager::LoadTextureFromFile(const std::string &path, TextureType type)
     {
         // check if already exists exists
-        auto it = m_Textures.find(path);
-        if (it != m_Textures.end()) 
-            return it->second;
+        if (auto cached = Find(path))
+            return cached;
+
+        // load image
+        DecodedImage image = DecodeImage(path);
+        if (!image.IsValid())
+        {
+            LOG_ERROR("Failed to load texture at: {}",path);
+            return nullptr;
+        }
+        return CreateTexture(path, image, type);
+    }
+
+    DecodedImage TextureManager::DecodeImage(const std::string &path)
+    {
+        DecodedImage image;
+        image.Pixels.reset(stbi_load(path.c_str(), &image.Width, &image.Height, &image.Channels, 0));
+        return image;
+    }
+
+    DecodedImage TextureManager::DecodeImageFromMemory(const unsigned char* data, std::size_t size)
+    {
+        DecodedImage image;
+        if (size > 0 && size <= static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            image.Pixels.reset(stbi_load_from_memory(data, static_cast<int>(size), &image.Width, &image.Height, &image.Channels, 0));
+        return image;
+    }
+
+    DecodedImage TextureManager::CopyPixels(const unsigned char* rgba, int width, int height)
+    {
+        DecodedImage image;
+        if (width <= 0 || height <= 0)
+            return image;
+        const std::size_t size = std::size_t(width) * std::size_t(height) * 4;
+        // malloc, since DecodedImageDeleter frees through stbi_image_free (free by default)
+        image.Pixels.reset(static_cast<unsigned char*>(std::malloc(size)));
+        if (!image.Pixels)
+            return image;
+        std::memcpy(image.Pixels.get(), rgba, size);
+        image.Width    = width;
+        image.Height   = height;
+        image.Channels = 4;
+        return image;
+    }
+
+    std::shared_ptr<Texture> TextureManager::CreateTexture(const std::string &path, const DecodedImage &image, TextureType type)
+    {
+        if (auto cached = Find(path))
+            return cached;
+        if (!image.IsValid())
+            return nullptr;
 
         // create texture object
         auto texture = std::make_shared<Texture>();
         texture->SetType(type);
         texture->SetPath(path);
-        // load image
-        int width, height, nrChannels;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrChannels, 0);
-        if(data)
+
+        GLenum internalFormat = GL_RGB;
+        GLenum dataFormat = GL_RGB;
+        if (image.Channels == 1)
         {
-            GLenum internalFormat = GL_RGB;
-            GLenum dataFormat = GL_RGB;
-            if (nrChannels == 1) 
-            {
-                internalFormat = GL_RED;
-                dataFormat = GL_RED;
-            } 
-            else if (nrChannels == 3) 
-            {
-                internalFormat = GL_RGB;
-                dataFormat = GL_RGB;
-            } 
-            else if (nrChannels == 4) 
-            {
-                internalFormat = GL_RGBA;
-                dataFormat = GL_RGBA;
-            }
-
-            
-            texture->Generate(width, height, data, internalFormat,dataFormat,type);
+            internalFormat = GL_RED;
+            dataFormat = GL_RED;
         }
-        else 
+        else if (image.Channels == 3)
         {
-            LOG_ERROR("Failed to load texture at: {}",path);
-            return nullptr;
+            internalFormat = GL_RGB;
+            dataFormat = GL_RGB;
         }
-        
-        stbi_image_free(data);
+        else if (image.Channels == 4)
+        {
+            internalFormat = GL_RGBA;
+            dataFormat = GL_RGBA;
+        }
+
+        texture->Generate(image.Width, image.Height, image.Pixels.get(), internalFormat,dataFormat,type);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Textures[path] = texture;
         return texture;
     }
-    
+
+    std::shared_ptr<Texture> TextureManager::Find(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Textures.find(path);
+        return it != m_Textures.end() ? it->second : nullptr;
+    }
+
     void TextureManager::UnloadTexture(const std::string &path)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Textures.erase(path);
     }
 
     void TextureManager::UnloadAll()
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Textures.clear();
     }
-}
\ No newline at end of file
+}
@@ -2,17 +2,39 @@
  * @brief Manages the loading and unloading of textures.
  * This class provides methods to load textures from files, unload them,
  * and keep track of all loaded textures.
+ * Loading is split in two halves: DecodeImage only touches the CPU and may run on
+ * any thread, CreateTexture uploads to GL and must run on the GL thread.
+ * The cache itself is guarded, so lookups are safe from worker threads.
  */
 
 #pragma once
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include "Texture.h"
 
 namespace isaacObjectViewer
 {
-    class TextureManager 
+    /// @brief Releases pixel memory returned by stb_image.
+    struct DecodedImageDeleter
+    {
+        void operator()(unsigned char* pixels) const;
+    };
+
+    /// @brief Pixels decoded on the CPU, waiting to be uploaded.
+    struct DecodedImage
+    {
+        int Width    = 0;
+        int Height   = 0;
+        int Channels = 0;
+        std::unique_ptr<unsigned char, DecodedImageDeleter> Pixels;
+
+        /// @brief Checks if decoding succeeded.
+        bool IsValid() const { return Pixels != nullptr; }
+    };
+
+    class TextureManager
     {
     public:
 
@@ -22,6 +44,37 @@ namespace isaacObjectViewer
         /// @return A shared pointer to the loaded texture.
         static std::shared_ptr<Texture> LoadTexture(const std::string& path,TextureType type);
 
+        /// @brief Decodes an image file into CPU memory. Safe to call from any thread.
+        /// @param path The file path of the image.
+        /// @return The decoded image; IsValid() is false if decoding failed.
+        static DecodedImage DecodeImage(const std::string& path);
+
+        /// @brief Decodes an image file that is already in memory (PNG, JPEG, ...). Safe to call from any thread.
+        /// @param data The file bytes.
+        /// @param size The number of bytes.
+        /// @return The decoded image; IsValid() is false if decoding failed.
+        static DecodedImage DecodeImageFromMemory(const unsigned char* data, std::size_t size);
+
+        /// @brief Copies raw RGBA8 pixels into a DecodedImage. Safe to call from any thread.
+        /// @param rgba The pixels, row by row.
+        /// @param width The width in pixels.
+        /// @param height The height in pixels.
+        /// @return The image; IsValid() is false if the size is zero.
+        static DecodedImage CopyPixels(const unsigned char* rgba, int width, int height);
+
+        /// @brief Uploads decoded pixels and caches the texture under path. GL thread only.
+        /// If path is already cached, the cached texture is returned and image is ignored.
+        /// @param path The key (file path) of the texture.
+        /// @param image The decoded pixels.
+        /// @param type The type of the texture.
+        /// @return A shared pointer to the texture, or nullptr if image is invalid.
+        static std::shared_ptr<Texture> CreateTexture(const std::string& path, const DecodedImage& image, TextureType type);
+
+        /// @brief Looks up a cached texture. Safe to call from any thread.
+        /// @param path The file path of the texture.
+        /// @return The cached texture, or nullptr if it is not loaded.
+        static std::shared_ptr<Texture> Find(const std::string& path);
+
         /// @brief Unloads a texture.
         /// @param path The file path of the texture to unload.
         static void UnloadTexture(const std::string& path);
@@ -33,6 +86,7 @@ namespace isaacObjectViewer
         /// @brief Constructs a TextureManager object.
         TextureManager() { }
         static std::unordered_map<std::string, std::shared_ptr<Texture>> m_Textures;
+        static std::mutex m_Mutex;
         static std::shared_ptr<Texture> LoadTextureFromFile(const std::string& path,TextureType type);
 
     };
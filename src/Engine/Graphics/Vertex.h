@@ -0,0 +1,44 @@
+/**
+ * @file Vertex.h
+ * @brief Header file for the Vertex struct.
+ * Kept apart from Mesh.h so CPU-side import code can build vertex arrays
+ * without pulling in any of the GL buffer classes.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#define MAX_BONE_INFLUENCE 4
+
+namespace isaacObjectViewer
+{
+    /// @brief Represents a single vertex in 3D space.
+    struct Vertex
+    {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec2 TexCoords;
+        glm::vec3 Tangent;
+        glm::vec3 Bitangent;
+
+        // match GL attribute type (unsigned int)
+        unsigned int m_BoneIDs[MAX_BONE_INFLUENCE] = {0};
+        float        m_Weights[MAX_BONE_INFLUENCE] = {0.f};
+    };
+
+    /// @brief A vertex of the cube and plane primitives.
+    struct PositionNormalTexVertex
+    {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec2 TexCoords;
+    };
+
+    /// @brief A vertex of the sphere and cylinder primitives.
+    struct PositionNormalVertex
+    {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+    };
+}
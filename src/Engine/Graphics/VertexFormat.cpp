@@ -0,0 +1,209 @@
+#include "VertexFormat.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace isaacObjectViewer
+{
+    // octahedral mapping: project onto |x| + |y| + |z| = 1, fold the lower half over the diagonals
+    static glm::vec2 octWrap(const glm::vec2& v)
+    {
+        return glm::vec2((1.0f - std::abs(v.y)) * (v.x >= 0.0f ? 1.0f : -1.0f),
+                         (1.0f - std::abs(v.x)) * (v.y >= 0.0f ? 1.0f : -1.0f));
+    }
+
+    void VertexPacker::OctEncode(const glm::vec3& direction, std::int16_t out[2])
+    {
+        const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (!(length > 0.0f))
+        {
+            out[0] = out[1] = 0;
+            return;
+        }
+        glm::vec2 p = glm::vec2(direction.x, direction.y) / length;
+        if (direction.z < 0.0f)
+            p = octWrap(p);
+
+        // of the four neighbouring snorm16 pairs, keep the one that decodes closest to the input
+        const glm::vec3 target = glm::normalize(direction);
+        const float fx = std::floor(std::clamp(p.x, -1.0f, 1.0f) * 32767.0f);
+        const float fy = std::floor(std::clamp(p.y, -1.0f, 1.0f) * 32767.0f);
+        float best = 4.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            const std::int16_t candidate[2] = {
+                static_cast<std::int16_t>(std::clamp(fx + float(i & 1), -32767.0f, 32767.0f)),
+                static_cast<std::int16_t>(std::clamp(fy + float(i >> 1), -32767.0f, 32767.0f)),
+            };
+            // a distance, not a dot product: near 1 the dot can't tell the candidates apart in float
+            const glm::vec3 error = OctDecode(candidate) - target;
+            const float distance = glm::dot(error, error);
+            if (distance < best)
+            {
+                best   = distance;
+                out[0] = candidate[0];
+                out[1] = candidate[1];
+            }
+        }
+    }
+
+    glm::vec3 VertexPacker::OctDecode(const std::int16_t encoded[2])
+    {
+        const glm::vec2 e(std::max(encoded[0] / 32767.0f, -1.0f), std::max(encoded[1] / 32767.0f, -1.0f));
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    VertexFormat VertexPacker::SelectFormat(const std::vector<Vertex>& vertices, bool normalMapped, bool quantize)
+    {
+        VertexFormat format;
+        format.Quantized = quantize;
+
+        bool tangents = false, weighted = false, smallTexCoords = true;
+        for (const Vertex& v : vertices)
+        {
+            tangents |= v.Tangent != glm::vec3(0.0f);
+            for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
+                weighted |= v.m_Weights[i] != 0.0f;
+            smallTexCoords &= std::abs(v.TexCoords.x) <= kMaxHalfTexCoord && std::abs(v.TexCoords.y) <= kMaxHalfTexCoord;
+        }
+        format.Tangents      = normalMapped && tangents;
+        format.Skinned       = weighted;
+        format.HalfTexCoords = quantize && smallTexCoords;
+        return format;
+    }
+
+    void VertexPacker::Pack(const std::vector<Vertex>& vertices, const VertexFormat& format, std::vector<unsigned char>& out)
+    {
+        out.resize(PackedSize(vertices.size(), format));
+        unsigned char* positions = out.data();
+        unsigned char* attributes = out.data() + AttributeOffset(vertices.size());
+        const std::uint32_t stride = format.AttributeStride();
+
+        auto direction = [&](unsigned char* dst, const glm::vec3& value)
+        {
+            if (format.Quantized)
+            {
+                std::int16_t encoded[2];
+                OctEncode(value, encoded);
+                std::memcpy(dst, encoded, sizeof(encoded));
+            }
+            else
+            {
+                std::memcpy(dst, &value, sizeof(value));
+            }
+        };
+
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            const Vertex& v = vertices[i];
+            std::memcpy(positions + i * VertexFormat::kPositionStride, &v.Position, VertexFormat::kPositionStride);
+
+            unsigned char* element = attributes + i * stride;
+            direction(element + format.NormalOffset(), v.Normal);
+            if (format.HalfTexCoords)
+            {
+                const std::uint16_t uv[2] = { glm::packHalf1x16(v.TexCoords.x), glm::packHalf1x16(v.TexCoords.y) };
+                std::memcpy(element + format.TexCoordOffset(), uv, sizeof(uv));
+            }
+            else
+            {
+                std::memcpy(element + format.TexCoordOffset(), &v.TexCoords, sizeof(v.TexCoords));
+            }
+            if (format.Tangents)
+            {
+                direction(element + format.TangentOffset(), v.Tangent);
+                direction(element + format.BitangentOffset(), v.Bitangent);
+            }
+            if (format.Skinned)
+            {
+                if (format.Quantized)
+                {
+                    std::uint16_t ids[MAX_BONE_INFLUENCE], weights[MAX_BONE_INFLUENCE];
+                    for (int k = 0; k < MAX_BONE_INFLUENCE; ++k)
+                    {
+                        ids[k]     = static_cast<std::uint16_t>(std::min(v.m_BoneIDs[k], 0xffffu));
+                        weights[k] = static_cast<std::uint16_t>(std::lround(std::clamp(v.m_Weights[k], 0.0f, 1.0f) * 65535.0f));
+                    }
+                    std::memcpy(element + format.BoneIDOffset(), ids, sizeof(ids));
+                    std::memcpy(element + format.WeightOffset(), weights, sizeof(weights));
+                }
+                else
+                {
+                    std::memcpy(element + format.BoneIDOffset(), v.m_BoneIDs, sizeof(v.m_BoneIDs));
+                    std::memcpy(element + format.WeightOffset(), v.m_Weights, sizeof(v.m_Weights));
+                }
+            }
+        }
+    }
+
+    void VertexPacker::Unpack(const unsigned char* packed, std::size_t vertexCount, const VertexFormat& format, std::vector<Vertex>& out)
+    {
+        out.assign(vertexCount, Vertex{});
+        const unsigned char* attributes = packed + AttributeOffset(vertexCount);
+        const std::uint32_t stride = format.AttributeStride();
+
+        auto direction = [&](const unsigned char* src)
+        {
+            glm::vec3 value;
+            if (format.Quantized)
+            {
+                std::int16_t encoded[2];
+                std::memcpy(encoded, src, sizeof(encoded));
+                value = OctDecode(encoded);
+            }
+            else
+            {
+                std::memcpy(&value, src, sizeof(value));
+            }
+            return value;
+        };
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            Vertex& v = out[i];
+            std::memcpy(&v.Position, packed + i * VertexFormat::kPositionStride, VertexFormat::kPositionStride);
+
+            const unsigned char* element = attributes + i * stride;
+            v.Normal = direction(element + format.NormalOffset());
+            if (format.HalfTexCoords)
+            {
+                std::uint16_t uv[2];
+                std::memcpy(uv, element + format.TexCoordOffset(), sizeof(uv));
+                v.TexCoords = glm::vec2(glm::unpackHalf1x16(uv[0]), glm::unpackHalf1x16(uv[1]));
+            }
+            else
+            {
+                std::memcpy(&v.TexCoords, element + format.TexCoordOffset(), sizeof(v.TexCoords));
+            }
+            if (format.Tangents)
+            {
+                v.Tangent   = direction(element + format.TangentOffset());
+                v.Bitangent = direction(element + format.BitangentOffset());
+            }
+            if (format.Skinned)
+            {
+                if (format.Quantized)
+                {
+                    std::uint16_t ids[MAX_BONE_INFLUENCE], weights[MAX_BONE_INFLUENCE];
+                    std::memcpy(ids, element + format.BoneIDOffset(), sizeof(ids));
+                    std::memcpy(weights, element + format.WeightOffset(), sizeof(weights));
+                    for (int k = 0; k < MAX_BONE_INFLUENCE; ++k)
+                    {
+                        v.m_BoneIDs[k] = ids[k];
+                        v.m_Weights[k] = weights[k] / 65535.0f;
+                    }
+                }
+                else
+                {
+                    std::memcpy(v.m_BoneIDs, element + format.BoneIDOffset(), sizeof(v.m_BoneIDs));
+                    std::memcpy(v.m_Weights, element + format.WeightOffset(), sizeof(v.m_Weights));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file VertexFormat.h
+ * @brief Header file for the VertexFormat struct and the VertexPacker class.
+ * Import code works on the full Vertex; what reaches the GPU is chosen per mesh. Positions go
+ * first as their own tightly packed float3 stream, so a pass that needs nothing else (depth,
+ * picking) reads 12 bytes per vertex. The other attributes follow as a second interleaved
+ * stream that only holds what the mesh uses: tangents only under a normal map, bone data only
+ * when a vertex is weighted. Quantized formats store normals and tangents octahedral-encoded
+ * in two snorm16 and UVs as half floats, which takes a static mesh from 88 to 20 bytes a vertex.
+ * Like Vertex.h this stays free of GL, so worker threads and tests can use it.
+ */
+
+#pragma once
+
+#include "Graphics/Vertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    /// @brief The attributes and encodings a mesh is uploaded with.
+    /// The default is the full float layout, the same data as Vertex.
+    struct VertexFormat
+    {
+        /// @brief Normals and tangents as octahedral snorm16x2, bone IDs as uint16x4, weights as unorm16x4.
+        bool Quantized     { false };
+        /// @brief UVs as half floats (only chosen when they stay within kMaxHalfTexCoord).
+        bool HalfTexCoords { false };
+        /// @brief Tangent and bitangent are uploaded.
+        bool Tangents      { true };
+        /// @brief Bone IDs and weights are uploaded.
+        bool Skinned       { true };
+
+        /// @brief Bytes per vertex of the position stream.
+        static constexpr std::uint32_t kPositionStride = 3 * sizeof(float);
+
+        /// @brief Bytes of one normal, tangent or bitangent.
+        std::uint32_t DirectionSize() const { return Quantized ? 2 * sizeof(std::int16_t) : 3 * sizeof(float); }
+        /// @brief Bytes of one UV.
+        std::uint32_t TexCoordSize() const  { return HalfTexCoords ? 2 * sizeof(std::uint16_t) : 2 * sizeof(float); }
+        /// @brief Bytes of the bone IDs, and of the bone weights, of one vertex.
+        std::uint32_t BoneSize() const      { return MAX_BONE_INFLUENCE * (Quantized ? sizeof(std::uint16_t) : sizeof(std::uint32_t)); }
+
+        /// @brief Offsets of each attribute inside an element of the attribute stream.
+        std::uint32_t NormalOffset() const    { return 0; }
+        std::uint32_t TexCoordOffset() const  { return DirectionSize(); }
+        std::uint32_t TangentOffset() const   { return TexCoordOffset() + TexCoordSize(); }
+        std::uint32_t BitangentOffset() const { return TangentOffset() + DirectionSize(); }
+        std::uint32_t BoneIDOffset() const    { return TangentOffset() + (Tangents ? 2 * DirectionSize() : 0); }
+        std::uint32_t WeightOffset() const    { return BoneIDOffset() + BoneSize(); }
+
+        /// @brief Bytes per vertex of the attribute stream.
+        std::uint32_t AttributeStride() const { return BoneIDOffset() + (Skinned ? 2 * BoneSize() : 0); }
+        /// @brief Bytes per vertex of both streams together.
+        std::uint32_t VertexSize() const      { return kPositionStride + AttributeStride(); }
+
+        bool operator==(const VertexFormat& other) const
+        {
+            return Quantized == other.Quantized && HalfTexCoords == other.HalfTexCoords
+                && Tangents == other.Tangents && Skinned == other.Skinned;
+        }
+        bool operator!=(const VertexFormat& other) const { return !(*this == other); }
+    };
+
+    class VertexPacker
+    {
+    public:
+        /// @brief Largest |u| or |v| stored as a half float: spacing there is 2^-9 of a repeat.
+        static constexpr float kMaxHalfTexCoord = 4.0f;
+
+        /// @brief Picks the smallest format that keeps what a mesh uses.
+        /// @param vertices The mesh's vertices.
+        /// @param normalMapped True if the mesh's material has a normal map (keeps the tangents).
+        /// @param quantize True to allow the quantized encodings.
+        /// @return The format.
+        static VertexFormat SelectFormat(const std::vector<Vertex>& vertices, bool normalMapped, bool quantize);
+
+        /// @brief Packs vertices for upload: the position stream, then the attribute stream at AttributeOffset().
+        /// @param vertices The vertices.
+        /// @param format The format to encode them in.
+        /// @param out Receives the bytes (resized to PackedSize()).
+        static void Pack(const std::vector<Vertex>& vertices, const VertexFormat& format, std::vector<unsigned char>& out);
+
+        /// @brief Decodes packed vertices back into full ones. Attributes the format dropped come back zero,
+        /// quantized ones as close as their encoding allows.
+        /// @param packed The bytes Pack wrote.
+        /// @param vertexCount The number of vertices.
+        /// @param format The format they were packed in.
+        /// @param out Receives the vertices.
+        static void Unpack(const unsigned char* packed, std::size_t vertexCount, const VertexFormat& format, std::vector<Vertex>& out);
+
+        /// @brief Gets the byte offset of the attribute stream in packed data.
+        /// @param vertexCount The number of vertices.
+        /// @return The offset; the position stream fills everything before it.
+        static std::size_t AttributeOffset(std::size_t vertexCount) { return vertexCount * VertexFormat::kPositionStride; }
+
+        /// @brief Gets the size of packed data.
+        /// @param vertexCount The number of vertices.
+        /// @param format The format.
+        /// @return The number of bytes Pack writes.
+        static std::size_t PackedSize(std::size_t vertexCount, const VertexFormat& format)
+        {
+            return vertexCount * format.VertexSize();
+        }
+
+        /// @brief Encodes a unit vector as octahedral snorm16 (decoded in main.vs, see OctDecode).
+        /// @param direction The vector; need not be normalized, zero maps to +Z.
+        /// @param out Receives the two components.
+        static void OctEncode(const glm::vec3& direction, std::int16_t out[2]);
+
+        /// @brief Decodes an octahedral snorm16 pair, as the shader does.
+        /// @param encoded The two components.
+        /// @return The unit vector.
+        static glm::vec3 OctDecode(const std::int16_t encoded[2]);
+
+    private:
+        VertexPacker() = delete;
+    };
+}
@@ -4,6 +4,13 @@
 #include "TextureManager.h"
 #include "ImGuiFileDialog/ImGuiFileDialog.h"
 #include "Graphics/ModelManager.h"
+#include "Graphics/ModelImportJob.h"
+#include "Graphics/Model.h"
+#include "Graphics/LodSelector.h"
+#include "Graphics/ClusterCuller.h"
+#include "Graphics/Impostor.h"
+#include "Graphics/ImpostorSelector.h"
+#include "Utility/MemoryStats.h"
 
 namespace isaacObjectViewer
 {
@@ -15,7 +22,7 @@ namespace isaacObjectViewer
         , m_CurrentPath(std::filesystem::current_path().string())
         , m_SelectedPath("")
         , m_ImageDialogFilters("All Images{.png,.jpg,.jpeg},.png,.jpg,.jpeg")
-        , m_ImportObjDialogFilters("All Objects{.obj,.fbx,.dae,},.obj,.fbx,.dae")
+        , m_ImportObjDialogFilters("All Objects{.obj,.fbx,.dae,.gltf,.glb,.stl,.ply,},.obj,.fbx,.dae,.gltf,.glb,.stl,.ply")
         , m_IsMouseOverUI(false)
         , M_RightPanelWidth(350.0f)
         , M_TopPanelHeight(40.0f)
@@ -156,6 +163,7 @@ namespace isaacObjectViewer
         DrawTopPanel(engine);
         DrawSceneHierarchyPanel(engine);
         DrawRightPanel(engine);
+        DrawImportProgress();
         
         DrawGizmos(engine, m_GizmoOperation);
         
@@ -220,6 +228,13 @@ namespace isaacObjectViewer
                     }
                     ImGui::EndMenu();
                 }
+
+                ImGui::Separator();
+                // the copy shares the model's vertex and index buffers
+                if (ImGui::MenuItem("Duplicate Model", "Ctrl+D", false, dynamic_cast<Model*>(engine->GetSelectedObject()) != nullptr))
+                {
+                    engine->DuplicateSelectedModel();
+                }
                 
                 ImGui::EndMenu();
             }
@@ -228,16 +243,11 @@ namespace isaacObjectViewer
         }
         if (m_ImportObjectDialog.Display("Import 3D Object",32,{500.f,500.f}))
         {
-            LOG_ERROR("Loading Model...");
             if (m_ImportObjectDialog.IsOk()) 
             {
+                // imported in the background; the Engine adds the model once it is uploaded
                 std::string path = m_ImportObjectDialog.GetFilePathName();
-                auto* model = ModelManager::GetInstance().LoadModel(path);
-                if (model) 
-                {
-                    Engine::GetInstance()->GetSceneObjects().push_back(model);
-                    Engine::GetInstance()->SetSelectedObject(model);
-                }
+                ModelManager::GetInstance().ImportModelAsync(path, m_PostProcessOptions);
             } 
             else
             {
@@ -323,6 +333,51 @@ namespace isaacObjectViewer
         ImGui::End();
     }
 
+    void ImGuiLayer::DrawImportProgress()
+    {
+        // ===================================================
+        // Import Progress: one row per background import
+        // ===================================================
+        const auto& jobs = ModelManager::GetInstance().GetImportJobs();
+        if (jobs.empty())
+            return;
+
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + 20.0f, viewport->WorkPos.y + viewport->WorkSize.y - 20.0f),
+                                ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+        ImGui::SetNextWindowSize(ImVec2(360.0f, 0.0f));
+
+        ImGuiWindowFlags flags =
+            ImGuiWindowFlags_NoDocking |
+            ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoResize |
+            ImGuiWindowFlags_NoCollapse |
+            ImGuiWindowFlags_NoSavedSettings;
+
+        if (ImGui::Begin("Importing", nullptr, flags))
+        {
+            for (const auto& job : jobs)
+            {
+                const ImportProgress& progress = job->GetProgress();
+                const ImportStage stage = progress.Stage.load();
+
+                ImGui::PushID(job.get());
+                ImGui::TextUnformatted(job->GetName().c_str());
+                ImGui::SameLine();
+                ImGui::TextDisabled("%s", progress.CancelRequested.load() ? "Cancelling..." : ImportStageName(stage));
+
+                ImGui::ProgressBar(progress.Overall(), ImVec2(-70.0f, 0.0f));
+                ImGui::SameLine();
+                ImGui::BeginDisabled(progress.CancelRequested.load());
+                if (ImGui::Button("Cancel", ImVec2(-1.0f, 0.0f)))
+                    job->Cancel();
+                ImGui::EndDisabled();
+                ImGui::PopID();
+            }
+        }
+        ImGui::End();
+    }
+
     void ImGuiLayer::DrawRightPanel(Engine* engine)
     {
         // ===================================================
@@ -416,9 +471,84 @@ namespace isaacObjectViewer
                     changed = false;
                 }
 
+                // Level of detail
+                LodSettings& lod = LodSelector::GetSettings();
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Level of Detail");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##lod_enabled", &lod.Enabled);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Draw coarser levels of meshes whose simplification error stays under the pixel error on screen");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("LOD Pixel Error");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::SliderFloat("##lod_pixel_error", &lod.PixelError, 0.25f, 16.0f, "%.2f px", ImGuiSliderFlags_Logarithmic);
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("LOD Fade");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::SliderFloat("##lod_fade", &lod.FadeSeconds, 0.0f, 1.0f, "%.2f s");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("LOD Debug Colors");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##lod_debug", &lod.DebugColors);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Tint meshes by level: green is the full mesh, then blue, yellow, orange, red");
+
+                // Cluster culling
+                ClusterCullSettings& culling = ClusterCuller::GetSettings();
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Cluster Culling");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##cluster_culling", &culling.Enabled);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Skip the meshlets of large meshes that are outside the view");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Cull Back-Facing");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##cluster_backfaces", &culling.Backfaces);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Also skip meshlets that face away from the camera; single-sided surfaces such as scans show holes from behind");
+
+                // Impostors
+                ImpostorSettings& impostors = ImpostorSelector::GetSettings();
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Impostors");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##impostors", &impostors.Enabled);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Draw models that are small on screen as one quad textured with baked views");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Impostor Size");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::SliderFloat("##impostor_size", &impostors.ScreenSize, 4.0f, 256.0f, "%.0f px", ImGuiSliderFlags_Logarithmic);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Models whose bounding sphere is narrower than this on screen are drawn as impostors");
+
                 ImGui::EndTable();
             }
 
+            const LodFrameStats& lodFrame = LodSelector::GetLastFrame();
+            ImGui::Text("LOD: %zu of %zu triangles drawn; meshes per level %zu / %zu / %zu / %zu / %zu",
+                        lodFrame.DrawnTriangles, lodFrame.FullTriangles, lodFrame.Meshes[0], lodFrame.Meshes[1],
+                        lodFrame.Meshes[2], lodFrame.Meshes[3], lodFrame.Meshes[4]);
+            const ClusterCullStats& cullFrame = ClusterCuller::GetLastFrame();
+            ImGui::Text("Clusters: %zu of %zu triangles culled (frustum %zu, back-facing %zu%s), %zu ranges, %.2f ms",
+                        cullFrame.FrustumTriangles + (ClusterCuller::GetSettings().Backfaces ? cullFrame.BackfaceTriangles : 0),
+                        cullFrame.Triangles, cullFrame.FrustumTriangles, cullFrame.BackfaceTriangles,
+                        ClusterCuller::GetSettings().Backfaces ? "" : " not culled", cullFrame.Ranges, cullFrame.Milliseconds);
+            const ImpostorFrameStats& impostorFrame = ImpostorSelector::GetLastFrame();
+            ImGui::Text("Impostors: %zu of %zu models, %zu triangles skipped; %zu baked, %zu from cache (%.1f ms)",
+                        impostorFrame.Impostors, impostorFrame.Models, impostorFrame.SkippedTriangles,
+                        impostorFrame.Baked, impostorFrame.Cached, impostorFrame.BakeMilliseconds);
+
             if (ImGui::CollapsingHeader("Directional Light")) 
             {
                 DirectionalLight& dirLight = engine->GetDirectionalLight();
@@ -633,6 +763,110 @@ namespace isaacObjectViewer
                 mouse->SetSensitivity(sensitivity);
         }
 
+        ImGui::Separator();
+
+        if (ImGui::CollapsingHeader("Import Settings"))
+        {
+            if (ImGui::BeginTable("ImportTable", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+            {
+                ImGui::TableSetupColumn("Label", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+                ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+
+                // who runs each post-processing stage of the next import
+                auto modeRow = [](const char* label, const char* id, PostProcessMode& mode)
+                {
+                    static const char* kModes[] = { "Assimp", "Engine", "Off" };
+                    int current = static_cast<int>(mode);
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::TextUnformatted(label);
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::Combo(id, &current, kModes, IM_ARRAYSIZE(kModes)))
+                        mode = static_cast<PostProcessMode>(current);
+                };
+                modeRow("Weld Vertices",    "##import_weld",     m_PostProcessOptions.Weld);
+                modeRow("Smooth Normals",   "##import_normals",  m_PostProcessOptions.Normals);
+                modeRow("Tangent Space",    "##import_tangents", m_PostProcessOptions.Tangents);
+                modeRow("Cache Order",      "##import_optimize", m_PostProcessOptions.Optimize);
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Static Batching");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_batch", &m_PostProcessOptions.Batch);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Merge small meshes that share a material and are placed once into one draw call per material");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Quantize Vertices");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_quantize", &m_PostProcessOptions.Quantize);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Upload octahedral normals and half-float UVs; unused tangents and bone data are dropped either way");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Split For 16-bit Indices");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_split", &m_PostProcessOptions.SplitForShortIndices);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Split meshes over 65536 vertices so every part draws with 16-bit indices; smaller meshes always do");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Generate LODs");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_lods", &m_PostProcessOptions.Lods);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Simplify meshes over 2048 triangles into up to 4 coarser levels, drawn by distance; they only add index buffers");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Build Meshlets");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_meshlets", &m_PostProcessOptions.Meshlets);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Cluster meshes over 8192 triangles into meshlets of up to 124 triangles, culled against the view every frame");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Bake Impostors");
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Checkbox("##import_impostors", &m_PostProcessOptions.Impostors);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Bake 64 views of the model when it loads (cached on disk), drawn instead of the meshes while it is small on screen");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("CPU Geometry");
+                ImGui::TableSetColumnIndex(1);
+                {
+                    static const char* kResidency[] = { "Full Vertices", "Positions + Indices", "None" };
+                    int current = static_cast<int>(m_PostProcessOptions.Residency);
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::Combo("##import_residency", &current, kResidency, IM_ARRAYSIZE(kResidency)))
+                        m_PostProcessOptions.Residency = static_cast<CpuResidency>(current);
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("What each mesh keeps in memory after upload: positions and indices pick exact triangles, None picks by bounding boxes");
+                }
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Progressive Preview");
+                ImGui::TableSetColumnIndex(1);
+                bool progressive = ModelManager::IsProgressiveImports();
+                if (ImGui::Checkbox("##import_progressive", &progressive))
+                    ModelManager::SetProgressiveImports(progressive);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Show a block proxy of the model while it imports, first sampled from the file, then from the parsed meshes");
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted("Write Profiles");
+                ImGui::TableSetColumnIndex(1);
+                bool writeProfiles = ModelManager::IsWritingProfiles();
+                if (ImGui::Checkbox("##import_write_profiles", &writeProfiles))
+                    ModelManager::SetWriteProfiles(writeProfiles);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Write each import's profile as JSON to %s", ImportProfile::GetDirectory().c_str());
+
+                ImGui::EndTable();
+            }
+        }
+
         ImGui::Separator();
         
         if(selected)
@@ -728,6 +962,174 @@ namespace isaacObjectViewer
             }
         }
 
+        if (auto* model = dynamic_cast<Model*>(selected))
+        {
+            if (ImGui::CollapsingHeader("Draw Statistics"))
+            {
+                // GPU vertex and index memory against the fixed 88-byte Vertex and 32-bit indices
+                std::size_t vertexBytes = 0, fullBytes = 0, indexBytes = 0, wideIndexBytes = 0;
+                std::size_t sharedMeshes = 0, sharedBytes = 0;
+                std::size_t cpuBytes = 0, cpuFull = 0, cpuPicking = 0;
+                std::size_t lodMeshes = 0, lodLevels = 0, lodIndexBytes = 0;
+                std::size_t meshlets = 0, meshletMeshes = 0;
+                for (const Mesh& mesh : model->GetMeshes())
+                {
+                    const GpuGeometry& geometry = *mesh.GetGeometry();
+                    meshlets      += geometry.GetMeshlets().size();
+                    meshletMeshes += !geometry.GetMeshlets().empty();
+                    if (geometry.GetLods().size() > 1 && mesh.GetIndexBuffer())
+                    {
+                        ++lodMeshes;
+                        lodLevels += geometry.GetLods().size() - 1;
+                        for (std::size_t level = 1; level < geometry.GetLods().size(); ++level)
+                            lodIndexBytes += std::size_t(geometry.GetLods()[level].IndexCount) * mesh.GetIndexBuffer()->GetIndexSize();
+                    }
+                    cpuBytes   += geometry.GetCpu().GetBytes();
+                    cpuFull    += geometry.GetCpuBytesFor(CpuResidency::Full);
+                    cpuPicking += geometry.GetCpuBytesFor(CpuResidency::Picking);
+                    // held by another Mesh too: a duplicate (or the model it was duplicated from)
+                    if (mesh.GetGeometry().use_count() > 1)
+                    {
+                        ++sharedMeshes;
+                        sharedBytes += mesh.GetGeometry()->GetGpuBytes();
+                    }
+                    if (mesh.GetVertexBuffer())
+                        vertexBytes += mesh.GetVertexBuffer()->GetSize();
+                    fullBytes += std::size_t(mesh.GetVertexCount()) * sizeof(Vertex);
+                    if (const IndexBuffer* indices = mesh.GetIndexBuffer())
+                    {
+                        indexBytes     += std::size_t(indices->GetCount()) * indices->GetIndexSize();
+                        wideIndexBytes += std::size_t(indices->GetCount()) * sizeof(unsigned int);
+                    }
+                }
+                ImGui::Text("Vertex buffers: %.1f MB (%.1f MB as full vertices)", MemoryStats::ToMB(vertexBytes), MemoryStats::ToMB(fullBytes));
+                ImGui::Text("Index buffers: %.1f MB (%.1f MB as 32-bit)", MemoryStats::ToMB(indexBytes), MemoryStats::ToMB(wideIndexBytes));
+                ImGui::Text("Shared geometry: %zu of %zu meshes (%.1f MB)", sharedMeshes, model->GetMeshes().size(), MemoryStats::ToMB(sharedBytes));
+                // what each residency would keep, so the import setting can be weighed against the memory saved
+                ImGui::Text("CPU geometry: %.1f MB (full %.1f MB, positions + indices %.1f MB, none 0 MB)",
+                            MemoryStats::ToMB(cpuBytes), MemoryStats::ToMB(cpuFull), MemoryStats::ToMB(cpuPicking));
+                ImGui::Text("Levels of detail: %zu levels over %zu of %zu meshes (%.1f MB of indices)",
+                            lodLevels, lodMeshes, model->GetMeshes().size(), MemoryStats::ToMB(lodIndexBytes));
+                ImGui::Text("Meshlets: %zu over %zu of %zu meshes", meshlets, meshletMeshes, model->GetMeshes().size());
+                if (const Impostor* impostor = model->GetImpostor())
+                    ImGui::Text("Impostor: %dx%d atlas of %dx%d views (%.1f MB)", impostor->GetAtlasSize(), impostor->GetAtlasSize(),
+                                ImpostorSelector::kFramesPerSide, ImpostorSelector::kFramesPerSide, MemoryStats::ToMB(impostor->GetBytes()));
+                else
+                    ImGui::TextUnformatted("Impostor: none");
+
+                // ACMR: vertex shader runs per triangle; ATVR: per vertex (1.0 is ideal)
+                if (ImGui::BeginTable("DrawStatsTable", 5, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+                {
+                    ImGui::TableSetupColumn("Mesh");
+                    ImGui::TableSetupColumn("Triangles");
+                    ImGui::TableSetupColumn("Instances");
+                    ImGui::TableSetupColumn("ACMR");
+                    ImGui::TableSetupColumn("ATVR");
+                    ImGui::TableHeadersRow();
+
+                    auto statsRow = [](const char* name, double triangles, std::size_t instances,
+                                       const VertexCacheStats& before, const VertexCacheStats& after, bool optimized)
+                    {
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(name);
+                        ImGui::TableSetColumnIndex(1); ImGui::Text("%.0f", triangles);
+                        ImGui::TableSetColumnIndex(2); ImGui::Text("%zu", instances);
+                        ImGui::TableSetColumnIndex(3);
+                        if (optimized) ImGui::Text("%.3f -> %.3f", before.Acmr, after.Acmr);
+                        else           ImGui::Text("%.3f", after.Acmr);
+                        ImGui::TableSetColumnIndex(4);
+                        if (optimized) ImGui::Text("%.3f -> %.3f", before.Atvr, after.Atvr);
+                        else           ImGui::Text("%.3f", after.Atvr);
+                    };
+
+                    // totals are weighted by triangles (ACMR) and vertices (ATVR) of the stored geometry
+                    double triangles = 0.0, vertices = 0.0;
+                    std::size_t instances = 0;
+                    VertexCacheStats totalBefore, totalAfter;
+                    bool anyOptimized = false;
+                    // placements by the model's node tree; without one every mesh is drawn once
+                    auto instanceCount = [&](const Mesh& mesh) -> std::size_t
+                    {
+                        return model->GetNodes().empty() ? 1 : mesh.GetInstanceTransforms().size();
+                    };
+                    for (const Mesh& mesh : model->GetMeshes())
+                    {
+                        const MeshOptimizationStats& stats = mesh.GetCacheStats();
+                        const double t = mesh.GetIndexCount() / 3.0;
+                        const double v = mesh.GetVertexCount();
+                        triangles += t;
+                        vertices  += v;
+                        totalBefore.Acmr += float(stats.Before.Acmr * t);
+                        totalAfter.Acmr  += float(stats.After.Acmr * t);
+                        totalBefore.Atvr += float(stats.Before.Atvr * v);
+                        totalAfter.Atvr  += float(stats.After.Atvr * v);
+                        anyOptimized |= stats.Optimized;
+                        instances += instanceCount(mesh);
+                    }
+                    if (triangles > 0.0 && vertices > 0.0)
+                    {
+                        totalBefore.Acmr /= float(triangles); totalAfter.Acmr /= float(triangles);
+                        totalBefore.Atvr /= float(vertices);  totalAfter.Atvr /= float(vertices);
+                    }
+                    statsRow("All meshes", triangles, instances, totalBefore, totalAfter, anyOptimized);
+
+                    for (const Mesh& mesh : model->GetMeshes())
+                    {
+                        const MeshOptimizationStats& stats = mesh.GetCacheStats();
+                        statsRow(mesh.GetName().c_str(), mesh.GetIndexCount() / 3.0, instanceCount(mesh),
+                                 stats.Before, stats.After, stats.Optimized);
+
+                        // the source meshes of a static batch, drawn within its one call
+                        ImGui::Indent();
+                        for (const MeshPart& part : mesh.GetParts())
+                            statsRow(part.Name.c_str(), part.IndexCount / 3.0, 1, part.Stats.Before, part.Stats.After, part.Stats.Optimized);
+                        ImGui::Unindent();
+                    }
+                    ImGui::EndTable();
+                }
+            }
+
+            const ImportProfile& profile = model->GetImportProfile();
+            if (!profile.Stages.empty() && ImGui::CollapsingHeader("Import Profile"))
+            {
+                ImGui::Text("%s loader%s: import %.1f ms, upload %.1f ms", profile.Loader.c_str(),
+                            profile.CacheHit ? " (mesh cache)" : "", profile.ImportMilliseconds, profile.UploadMilliseconds);
+                ImGui::Text("Resident memory: %.1f MB before, %.1f MB peak",
+                            MemoryStats::ToMB(profile.ResidentBytesBefore), MemoryStats::ToMB(profile.PeakResidentBytes));
+
+                if (ImGui::BeginTable("ImportProfileTable", 5, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+                {
+                    ImGui::TableSetupColumn("Stage");
+                    ImGui::TableSetupColumn("ms");
+                    ImGui::TableSetupColumn("MB");
+                    ImGui::TableSetupColumn("Items");
+                    ImGui::TableSetupColumn("RSS MB");
+                    ImGui::TableHeadersRow();
+
+                    for (const ImportStageTiming& stage : profile.Stages)
+                    {
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        if (stage.Depth > 0)
+                            ImGui::Indent();
+                        ImGui::TextUnformatted(stage.Name.c_str());
+                        if (stage.Depth > 0)
+                            ImGui::Unindent();
+                        ImGui::TableSetColumnIndex(1); ImGui::Text("%.2f", stage.Milliseconds);
+                        ImGui::TableSetColumnIndex(2);
+                        if (stage.Bytes > 0) ImGui::Text("%.2f", MemoryStats::ToMB(stage.Bytes));
+                        ImGui::TableSetColumnIndex(3);
+                        if (stage.Items > 0) ImGui::Text("%zu", stage.Items);
+                        ImGui::TableSetColumnIndex(4); ImGui::Text("%.1f", MemoryStats::ToMB(stage.ResidentBytes));
+                    }
+                    ImGui::EndTable();
+                }
+
+                if (ImGui::Button("Save JSON##import_profile"))
+                    profile.WriteJson(ImportProfile::MakeJsonPath(profile.Model));
+            }
+        }
+
         if(selected->GetType() == ObjectType::PointLight)
         {
             auto* light = dynamic_cast<PointLight*>(selected);
@@ -8,6 +8,7 @@
 
 #include "Utility/config.h"
 #include "Core/IObject.h"
+#include "Graphics/MeshProcessing.h"
 #include <ImGuizmo.h>
 #include "ImGuiFileDialog/ImGuiFileDialog.h"
 
@@ -84,6 +85,9 @@ namespace isaacObjectViewer
         /// @param engine The engine instance.
         void DrawSceneHierarchyPanel(Engine* engine);
 
+        /// @brief Draws the progress of background model imports, with a cancel button per import.
+        void DrawImportProgress();
+
         /// @brief Draws the settings panel.
         /// @param selected The selected scene object.
         void DrawSettings(IObject* selected);
@@ -110,6 +114,7 @@ namespace isaacObjectViewer
         std::string m_SelectedPath;     
         const char* m_ImageDialogFilters;
         const char* m_ImportObjDialogFilters;
+        PostProcessOptions m_PostProcessOptions;
 
         bool m_IsMouseOverUI;
 
@@ -0,0 +1,136 @@
+#version 460 core
+
+struct DirLight 
+{
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct PointLight 
+{
+    vec3 position;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+#define MAX_LIGHTS 8
+
+in vec3 FragPos;
+
+out vec4 FragColor;
+
+uniform vec3 viewPos;
+uniform vec3 center;
+
+uniform DirLight    dirLight;
+uniform PointLight  point_lights[MAX_LIGHTS];
+uniform int         numPointLights;
+uniform bool        useBlinnPhong;
+uniform float       shininess;
+
+// albedo + coverage, and model-space normal + specular strength (see Impostor)
+uniform sampler2D atlasAlbedo;
+uniform sampler2D atlasNormal;
+uniform int       framesPerSide;
+uniform mat3      normalMatrix;
+
+// the four views blended for this camera: the world offset from the center along each view's
+// axes gives the position in its tile, [-0.5, 0.5]
+uniform vec3  frameRight[4];
+uniform vec3  frameUp[4];
+uniform vec2  frameTile[4];
+uniform float frameWeight[4];
+
+// ---- Helpers
+vec3 CalcDirLight(DirLight light, vec3 N, vec3 V, vec3 albedo, vec3 specTint);
+vec3 CalcPointLight(PointLight light, vec3 N, vec3 P, vec3 V, vec3 albedo, vec3 specTint);
+
+void main()
+{
+    vec3 offset = FragPos - center;
+    vec4 albedo = vec4(0.0);
+    vec4 normalSpec = vec4(0.0);
+    for (int i = 0; i < 4; ++i)
+    {
+        vec2 uv = vec2(dot(offset, frameRight[i]), dot(offset, frameUp[i])) + 0.5;
+        if (any(lessThan(uv, vec2(0.0))) || any(greaterThan(uv, vec2(1.0))))
+            continue;
+        vec2 atlasUV = (frameTile[i] + uv) / float(framesPerSide);
+        albedo     += frameWeight[i] * texture(atlasAlbedo, atlasUV);
+        normalSpec += frameWeight[i] * texture(atlasNormal, atlasUV);
+    }
+    if (albedo.a < 0.5)
+        discard;
+
+    // both atlases are zero where nothing was drawn, so filtering weighs them by coverage; undo that
+    vec3 color    = albedo.rgb / albedo.a;
+    vec3 normal   = normalize(normalMatrix * (normalSpec.xyz / albedo.a * 2.0 - 1.0));
+    vec3 specTint = vec3(normalSpec.a / albedo.a);
+    vec3 V = normalize(viewPos - FragPos);
+
+    vec3 result = CalcDirLight(dirLight, normal, V, color, specTint);
+    for (int i = 0; i < numPointLights; ++i)
+        result += CalcPointLight(point_lights[i], normal, FragPos, V, color, specTint);
+
+    FragColor = vec4(result, 1.0);
+}
+
+vec3 CalcDirLight(DirLight L, vec3 normal, vec3 V, vec3 albedo, vec3 specTint)
+{
+    vec3 Ldir = normalize(-L.direction);
+
+    float diff = max(dot(normal, Ldir), 0.0);
+    float spec = 0.0;
+    if(useBlinnPhong)
+    {
+        vec3 H = normalize(Ldir + V);
+        spec = pow(max(dot(normal, H), 0.0), shininess);
+    }
+    else
+    {
+        vec3 R = reflect(-Ldir, normal);
+        spec = pow(max(dot(V, R), 0.0), shininess);
+    }
+
+    vec3 ambient  = L.ambient  * albedo;
+    vec3 diffuse  = L.diffuse  * diff    * albedo;
+    vec3 specular = L.specular * spec    * specTint;
+
+    return ambient + diffuse + specular;
+}
+
+vec3 CalcPointLight(PointLight L, vec3 normal, vec3 P, vec3 V, vec3 albedo, vec3 specTint)
+{
+    vec3 lightDir = normalize(L.position - P);
+
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    float spec = 0.0;
+
+    if (useBlinnPhong)
+    {
+        vec3 halfwayDir = normalize(lightDir + V);
+        spec = pow(max(dot(normal, halfwayDir), 0.0), shininess);
+    }
+    else
+    {
+        vec3 reflectDir = reflect(-lightDir, normal);
+        spec = pow(max(dot(V, reflectDir), 0.0), shininess);
+    }
+
+    float dist = length(L.position - P);
+    float att  = 1.0 / (L.constant + L.linear * dist + L.quadratic * (dist * dist));
+
+    vec3 ambient  = L.ambient  * albedo;
+    vec3 diffuse  = L.diffuse  * diff    * albedo;
+    vec3 specular = L.specular * spec    * specTint;
+
+    return (ambient + diffuse + specular) * att;
+}
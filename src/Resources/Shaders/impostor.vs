@@ -0,0 +1,24 @@
+#version 460 core
+
+// no vertex buffers: the six corners of a quad facing the camera, from gl_VertexID
+
+uniform mat4  view;
+uniform mat4  projection;
+uniform vec3  center;     // the model's bounding sphere, in world space
+uniform float halfSize;
+
+out vec3 FragPos;
+
+const vec2 kCorners[6] = vec2[6](vec2(-1.0, -1.0), vec2( 1.0, -1.0), vec2( 1.0,  1.0),
+                                 vec2(-1.0, -1.0), vec2( 1.0,  1.0), vec2(-1.0,  1.0));
+
+void main()
+{
+    // the camera's right and up axes are the first two rows of the view matrix
+    vec3 right = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 up    = vec3(view[0][1], view[1][1], view[2][1]);
+    vec2 corner = kCorners[gl_VertexID];
+    FragPos = center + (right * corner.x + up * corner.y) * halfSize;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
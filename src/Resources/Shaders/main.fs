@@ -5,6 +5,9 @@ struct Material
     sampler2D diffuse;
     sampler2D specular;
     float shininess;
+    vec3 diffuseColor;    // stands in for a missing diffuse map when useColors is set
+    vec3 specularColor;   // stands in for a missing specular map when useColors is set
+    bool useColors;
 };
 
 struct DirLight 
@@ -33,7 +36,9 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
 
-out vec4 FragColor;
+layout(location=0) out vec4 FragColor;
+// impostor bakes only: model-space normal * 0.5 + 0.5 and specular strength (see Impostor)
+layout(location=1) out vec4 BakeNormal;
 
 uniform vec3 viewPos;
 uniform vec3 objectColor;
@@ -50,18 +55,53 @@ uniform bool hasDiffuseMap;
 uniform bool hasSpecularMap;
 uniform bool useBlinnPhong;
 
+// LOD transitions: 1 keeps the fragments under lodFade on a 4x4 ordered dither, 2 the rest,
+// so the outgoing and incoming levels together cover each pixel once
+uniform int   lodDither;
+uniform float lodFade;
+// LOD debug view: lodColor replaces the albedo
+uniform bool  lodDebug;
+uniform vec3  lodColor;
+// Impostor bakes: albedo and normal go out unlit, and every drawn pixel is fully covered
+uniform bool  impostorBake;
+
+const float kBayer4[16] = float[16]( 0.0,  8.0,  2.0, 10.0,
+                                    12.0,  4.0, 14.0,  6.0,
+                                     3.0, 11.0,  1.0,  9.0,
+                                    15.0,  7.0, 13.0,  5.0);
+
 // ---- Helpers
 vec3 CalcDirLight(DirLight light, vec3 N, vec3 V, vec3 albedo, vec3 specTint);
 vec3 CalcPointLight(PointLight light, vec3 N, vec3 P, vec3 V, vec3 albedo, vec3 specTint);
 
 void main()
 {
+    if (lodDither != 0)
+    {
+        ivec2 cell = ivec2(gl_FragCoord.xy) & 3;
+        bool under = (kBayer4[cell.y * 4 + cell.x] + 0.5) / 16.0 < lodFade;
+        if (under != (lodDither == 1))
+            discard;
+    }
+
     vec3 normal = normalize(Normal);
     vec3 V = normalize(viewPos - FragPos);
 
     // Sample once (with graceful fallbacks)
-    vec3 albedo   = (useMaterial && hasDiffuseMap)  ? texture(material.diffuse,  TexCoords).rgb : objectColor;
-    vec3 specTint = (useMaterial && hasSpecularMap) ? texture(material.specular, TexCoords).rgb : vec3(1.0);
+    bool useColors = useMaterial && material.useColors;
+    vec3 albedo   = (useMaterial && hasDiffuseMap)  ? texture(material.diffuse,  TexCoords).rgb
+                  : (useColors ? material.diffuseColor : objectColor);
+    if (lodDebug)
+        albedo = lodColor;
+    vec3 specTint = (useMaterial && hasSpecularMap) ? texture(material.specular, TexCoords).rgb
+                  : (useColors ? material.specularColor : vec3(1.0));
+
+    if (impostorBake)
+    {
+        FragColor  = vec4(albedo, 1.0);
+        BakeNormal = vec4(normal * 0.5 + 0.5, dot(specTint, vec3(1.0 / 3.0)));
+        return;
+    }
 
     vec3 color = CalcDirLight(dirLight, normal, V, albedo, specTint);
     for (int i = 0; i < numPointLights; ++i)
@@ -1,22 +1,36 @@
 #version 460 core 
 
 layout(location=0) in vec3 vertexPos;
-layout(location=1) in vec3 vertexNormal;
+layout(location=1) in vec3 vertexNormal;   // octahedral snorm16x2 in .xy when octNormals is set
 layout(location=2) in vec2 vertexTexCoords;
+layout(location=8) in mat4 instanceModel;   // locations 8-11, bound only for instanced meshes
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform vec3 viewPos;
+uniform bool useInstancing;
+uniform bool octNormals;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
+// inverse of VertexPacker::OctEncode
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
 void main()
 { 
-    FragPos = vec3(model * vec4(vertexPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * vertexNormal;
+    vec3 normal = octNormals ? octDecode(vertexNormal.xy) : vertexNormal;
+    mat4 world = useInstancing ? model * instanceModel : model;
+    FragPos = vec3(world * vec4(vertexPos, 1.0));
+    Normal = mat3(transpose(inverse(world))) * normal;
     TexCoords = vertexTexCoords;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
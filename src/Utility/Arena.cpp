@@ -0,0 +1,89 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace isaacObjectViewer
+{
+    // what an idle thread keeps between outermost scopes; bigger peaks go back to the heap
+    static constexpr std::size_t kMaxRetained = std::size_t(8) << 20;
+
+    ScratchArena::ScratchArena(std::size_t blockSize)
+        : m_BlockSize(std::max<std::size_t>(blockSize, 4096))
+    {
+    }
+
+    ScratchArena::~ScratchArena()
+    {
+        for (Block& block : m_Blocks)
+            ::operator delete(block.Data);
+    }
+
+    std::pmr::memory_resource* ScratchArena::Get()
+    {
+        return s_Enabled.load(std::memory_order_relaxed) ? &ForThread() : std::pmr::new_delete_resource();
+    }
+
+    ScratchArena& ScratchArena::ForThread()
+    {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        // the current block first, then any later block kept from before a rewind
+        for (; m_Current < m_Blocks.size(); ++m_Current)
+        {
+            Block& block = m_Blocks[m_Current];
+            const std::uintptr_t base    = reinterpret_cast<std::uintptr_t>(block.Data);
+            const std::uintptr_t aligned = (base + block.Used + alignment - 1) & ~std::uintptr_t(alignment - 1);
+            const std::size_t    offset  = aligned - base;
+            if (offset <= block.Size && bytes <= block.Size - offset)
+            {
+                block.Used = offset + bytes;
+                return block.Data + offset;
+            }
+            if (m_Current + 1 < m_Blocks.size())
+                m_Blocks[m_Current + 1].Used = 0;
+        }
+
+        // large arrays get a block of their own size; operator new aligns to max_align_t,
+        // larger alignments get slack
+        const std::size_t size = std::max(m_BlockSize, bytes + alignment);
+        auto* data = static_cast<unsigned char*>(::operator new(size));
+        s_BlocksAllocated.fetch_add(1, std::memory_order_relaxed);
+
+        m_Blocks.push_back({ data, size, 0 });
+        m_Current = m_Blocks.size() - 1;
+        return do_allocate(bytes, alignment);
+    }
+
+    void ScratchArena::Rewind(const Marker& marker)
+    {
+        if (m_Blocks.empty())
+            return;
+
+        m_Current = std::min(marker.Block, m_Blocks.size() - 1);
+        m_Blocks[m_Current].Used = marker.Offset;
+
+        // outermost scope done: fold several blocks into one that fits next time, within the retained limit
+        if (marker.Block == 0 && marker.Offset == 0 && (m_Blocks.size() > 1 || m_Blocks[0].Size > kMaxRetained))
+        {
+            const std::size_t capacity = GetCapacity();
+            for (Block& block : m_Blocks)
+                ::operator delete(block.Data);
+            m_Blocks.clear();
+            m_Current   = 0;
+            m_BlockSize = std::clamp(capacity, kDefaultBlockSize, kMaxRetained);
+        }
+    }
+
+    std::size_t ScratchArena::GetCapacity() const
+    {
+        std::size_t capacity = 0;
+        for (const Block& block : m_Blocks)
+            capacity += block.Size;
+        return capacity;
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file Arena.h
+ * @brief Per-thread monotonic scratch memory for import stages.
+ * Allocation bumps a pointer through large blocks; nothing is freed one by one. An
+ * ArenaScope remembers the current position and rewinds to it when it ends, so the next
+ * mesh reuses the same blocks instead of going back to malloc. Scratch containers are
+ * std::pmr containers on ScratchArena::Get().
+ *
+ * Scopes nest like the call stack. Memory allocated inside a scope must not outlive it:
+ * declare the scope before the containers, and don't return arena memory out of a scope.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class ScratchArena : public std::pmr::memory_resource
+    {
+    public:
+        /// @brief A position in the arena to rewind to.
+        struct Marker
+        {
+            std::size_t Block  { 0 };
+            std::size_t Offset { 0 };
+        };
+
+        /// @brief Constructs an empty arena.
+        /// @param blockSize Size of the first block; later blocks grow to fit large requests.
+        explicit ScratchArena(std::size_t blockSize = kDefaultBlockSize);
+        ~ScratchArena() override;
+
+        /// @brief Gets the memory resource scratch containers should use on this thread:
+        /// the thread's arena, or the default heap when arenas are disabled.
+        /// @return The memory resource.
+        static std::pmr::memory_resource* Get();
+
+        /// @brief Gets the calling thread's arena.
+        /// @return The arena.
+        static ScratchArena& ForThread();
+
+        /// @brief Enables or disables arenas for subsequent scratch allocations (for comparisons).
+        /// @param enabled False sends scratch containers to the default heap.
+        static void SetEnabled(bool enabled) { s_Enabled.store(enabled); }
+
+        /// @brief Checks if scratch allocations go to the arenas.
+        /// @return True if arenas are enabled.
+        static bool IsEnabled() { return s_Enabled.load(); }
+
+        /// @brief Gets the current position.
+        /// @return The marker to pass to Rewind.
+        Marker GetMarker() const { return { m_Current, m_Current < m_Blocks.size() ? m_Blocks[m_Current].Used : 0 }; }
+
+        /// @brief Releases everything allocated since the marker; the blocks are kept for reuse.
+        /// @param marker A position returned by GetMarker.
+        void Rewind(const Marker& marker);
+
+        /// @brief Gets the bytes the arena holds in blocks.
+        /// @return The capacity in bytes.
+        std::size_t GetCapacity() const;
+
+        /// @brief Gets the number of blocks requested from the heap by all arenas since start.
+        /// @return The block count.
+        static std::size_t GetBlocksAllocated() { return s_BlocksAllocated.load(); }
+
+        static constexpr std::size_t kDefaultBlockSize = 1 << 20;
+
+    private:
+        struct Block
+        {
+            unsigned char* Data { nullptr };
+            std::size_t    Size { 0 };
+            std::size_t    Used { 0 };
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void  do_deallocate(void*, std::size_t, std::size_t) override { } // released by Rewind
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+    private:
+        std::vector<Block> m_Blocks;
+        std::size_t        m_Current { 0 };
+        std::size_t        m_BlockSize;
+
+        static inline std::atomic<bool>        s_Enabled { true };
+        static inline std::atomic<std::size_t> s_BlocksAllocated { 0 };
+    };
+
+    /// @brief Rewinds the calling thread's arena to where it was when the scope began.
+    class ArenaScope
+    {
+    public:
+        ArenaScope() : m_Arena(ScratchArena::ForThread()), m_Marker(m_Arena.GetMarker()) { }
+        ~ArenaScope() { m_Arena.Rewind(m_Marker); }
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+        ScratchArena&        m_Arena;
+        ScratchArena::Marker m_Marker;
+    };
+}
@@ -0,0 +1,116 @@
+/**
+ * @brief Fast non-cryptographic 64-bit hashing (the XXH64 algorithm).
+ * Used to key on-disk caches by file contents; not suitable for security purposes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace isaacObjectViewer
+{
+    namespace detail
+    {
+        constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+        constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+        constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+        inline std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        inline std::uint64_t Read64(const unsigned char* p) { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+        inline std::uint32_t Read32(const unsigned char* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+        inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+        {
+            acc += input * kPrime2;
+            acc  = Rotl(acc, 31);
+            return acc * kPrime1;
+        }
+
+        inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t val)
+        {
+            acc ^= Round(0, val);
+            return acc * kPrime1 + kPrime4;
+        }
+    }
+
+    /// @brief Hashes a block of memory.
+    /// @param data The bytes to hash.
+    /// @param size The number of bytes.
+    /// @param seed The seed; different seeds give independent hashes.
+    /// @return The 64-bit hash.
+    inline std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t seed = 0)
+    {
+        using namespace detail;
+        const unsigned char* p   = static_cast<const unsigned char*>(data);
+        const unsigned char* end = p + size;
+        std::uint64_t h;
+
+        if (size >= 32)
+        {
+            std::uint64_t v1 = seed + kPrime1 + kPrime2;
+            std::uint64_t v2 = seed + kPrime2;
+            std::uint64_t v3 = seed;
+            std::uint64_t v4 = seed - kPrime1;
+            const unsigned char* limit = end - 32;
+            do
+            {
+                v1 = Round(v1, Read64(p));      p += 8;
+                v2 = Round(v2, Read64(p));      p += 8;
+                v3 = Round(v3, Read64(p));      p += 8;
+                v4 = Round(v4, Read64(p));      p += 8;
+            } while (p <= limit);
+
+            h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+            h = MergeRound(h, v1);
+            h = MergeRound(h, v2);
+            h = MergeRound(h, v3);
+            h = MergeRound(h, v4);
+        }
+        else
+        {
+            h = seed + kPrime5;
+        }
+
+        h += static_cast<std::uint64_t>(size);
+
+        while (p + 8 <= end)
+        {
+            h ^= Round(0, Read64(p));
+            h  = Rotl(h, 27) * kPrime1 + kPrime4;
+            p += 8;
+        }
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<std::uint64_t>(Read32(p)) * kPrime1;
+            h  = Rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        while (p < end)
+        {
+            h ^= (*p) * kPrime5;
+            h  = Rotl(h, 11) * kPrime1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    /// @brief Mixes a value into a running hash.
+    /// @param seed The running hash.
+    /// @param value The value to mix in.
+    /// @return The combined hash.
+    inline std::uint64_t HashCombine(std::uint64_t seed, std::uint64_t value)
+    {
+        return HashBytes(&value, sizeof(value), seed);
+    }
+}
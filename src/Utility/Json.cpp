@@ -0,0 +1,299 @@
+#include "Json.h"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace isaacObjectViewer
+{
+    static const JsonValue s_Null;
+
+    // Recursive-descent parser over a string_view; fails on the first syntax error
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(std::string_view text) : m_Text(text) { }
+
+        bool ParseDocument(JsonValue& out)
+        {
+            SkipSpace();
+            if (!ParseValue(out, 0))
+                return false;
+            SkipSpace();
+            return m_Pos == m_Text.size() || Fail("trailing characters");
+        }
+
+        const std::string& GetError() const { return m_Error; }
+
+    private:
+        // deep enough for any real scene description, shallow enough to protect the stack
+        static constexpr int kMaxDepth = 256;
+
+        bool Fail(const char* what)
+        {
+            if (m_Error.empty())
+                m_Error = std::string(what) + " at offset " + std::to_string(m_Pos);
+            return false;
+        }
+
+        void SkipSpace()
+        {
+            while (m_Pos < m_Text.size() &&
+                   (m_Text[m_Pos] == ' ' || m_Text[m_Pos] == '\t' || m_Text[m_Pos] == '\n' || m_Text[m_Pos] == '\r'))
+                ++m_Pos;
+        }
+
+        bool Consume(std::string_view literal)
+        {
+            if (m_Text.substr(m_Pos, literal.size()) != literal)
+                return false;
+            m_Pos += literal.size();
+            return true;
+        }
+
+        bool ParseValue(JsonValue& out, int depth)
+        {
+            if (depth > kMaxDepth)
+                return Fail("nesting too deep");
+            if (m_Pos >= m_Text.size())
+                return Fail("unexpected end of input");
+
+            switch (m_Text[m_Pos])
+            {
+                case '{': return ParseObject(out, depth);
+                case '[': return ParseArray(out, depth);
+                case '"':
+                    out.m_Type = JsonValue::Type::String;
+                    return ParseString(out.m_String);
+                case 't':
+                case 'f':
+                    out.m_Type = JsonValue::Type::Bool;
+                    out.m_Bool = m_Text[m_Pos] == 't';
+                    return Consume(out.m_Bool ? "true" : "false") || Fail("invalid literal");
+                case 'n':
+                    out.m_Type = JsonValue::Type::Null;
+                    return Consume("null") || Fail("invalid literal");
+                default:
+                    return ParseNumber(out);
+            }
+        }
+
+        bool ParseObject(JsonValue& out, int depth)
+        {
+            out.m_Type = JsonValue::Type::Object;
+            ++m_Pos; // {
+            SkipSpace();
+            if (Consume("}"))
+                return true;
+
+            while (true)
+            {
+                SkipSpace();
+                std::string key;
+                if (m_Pos >= m_Text.size() || m_Text[m_Pos] != '"' || !ParseString(key))
+                    return Fail("expected member name");
+                SkipSpace();
+                if (!Consume(":"))
+                    return Fail("expected ':'");
+                SkipSpace();
+
+                out.m_Members.emplace_back(std::move(key), JsonValue());
+                if (!ParseValue(out.m_Members.back().second, depth + 1))
+                    return false;
+
+                SkipSpace();
+                if (Consume("}"))
+                    return true;
+                if (!Consume(","))
+                    return Fail("expected ',' or '}'");
+            }
+        }
+
+        bool ParseArray(JsonValue& out, int depth)
+        {
+            out.m_Type = JsonValue::Type::Array;
+            ++m_Pos; // [
+            SkipSpace();
+            if (Consume("]"))
+                return true;
+
+            while (true)
+            {
+                SkipSpace();
+                out.m_Elements.emplace_back();
+                if (!ParseValue(out.m_Elements.back(), depth + 1))
+                    return false;
+
+                SkipSpace();
+                if (Consume("]"))
+                    return true;
+                if (!Consume(","))
+                    return Fail("expected ',' or ']'");
+            }
+        }
+
+        bool ParseNumber(JsonValue& out)
+        {
+            const std::size_t begin = m_Pos;
+            if (m_Pos < m_Text.size() && m_Text[m_Pos] == '-')
+                ++m_Pos;
+            while (m_Pos < m_Text.size() &&
+                   ((m_Text[m_Pos] >= '0' && m_Text[m_Pos] <= '9') || m_Text[m_Pos] == '.' ||
+                    m_Text[m_Pos] == 'e' || m_Text[m_Pos] == 'E' || m_Text[m_Pos] == '+' || m_Text[m_Pos] == '-'))
+                ++m_Pos;
+            if (m_Pos == begin)
+                return Fail("unexpected character");
+
+            // strtod needs a terminated copy; numbers are short
+            const std::string token(m_Text.substr(begin, m_Pos - begin));
+            char* end = nullptr;
+            out.m_Type   = JsonValue::Type::Number;
+            out.m_Number = std::strtod(token.c_str(), &end);
+            return end == token.c_str() + token.size() || Fail("invalid number");
+        }
+
+        bool ParseHex4(unsigned int& code)
+        {
+            if (m_Pos + 4 > m_Text.size())
+                return false;
+            const char* first = m_Text.data() + m_Pos;
+            auto [ptr, ec] = std::from_chars(first, first + 4, code, 16);
+            if (ec != std::errc() || ptr != first + 4)
+                return false;
+            m_Pos += 4;
+            return true;
+        }
+
+        static void AppendUtf8(std::string& out, unsigned int code)
+        {
+            if (code < 0x80)
+            {
+                out += static_cast<char>(code);
+            }
+            else if (code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        bool ParseString(std::string& out)
+        {
+            ++m_Pos; // opening quote
+            while (m_Pos < m_Text.size())
+            {
+                const char c = m_Text[m_Pos++];
+                if (c == '"')
+                    return true;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+
+                if (m_Pos >= m_Text.size())
+                    break;
+                switch (m_Text[m_Pos++])
+                {
+                    case '"':  out += '"';  break;
+                    case '\\': out += '\\'; break;
+                    case '/':  out += '/';  break;
+                    case 'b':  out += '\b'; break;
+                    case 'f':  out += '\f'; break;
+                    case 'n':  out += '\n'; break;
+                    case 'r':  out += '\r'; break;
+                    case 't':  out += '\t'; break;
+                    case 'u':
+                    {
+                        unsigned int code = 0;
+                        if (!ParseHex4(code))
+                            return Fail("invalid \\u escape");
+                        // surrogate pair
+                        if (code >= 0xD800 && code <= 0xDBFF && Consume("\\u"))
+                        {
+                            unsigned int low = 0;
+                            if (!ParseHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                                return Fail("invalid surrogate pair");
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        AppendUtf8(out, code);
+                        break;
+                    }
+                    default:
+                        return Fail("invalid escape");
+                }
+            }
+            return Fail("unterminated string");
+        }
+
+    private:
+        std::string_view m_Text;
+        std::size_t      m_Pos = 0;
+        std::string      m_Error;
+    };
+
+    bool JsonValue::Parse(std::string_view text, JsonValue& out, std::string* error)
+    {
+        out = JsonValue();
+        JsonParser parser(text);
+        if (parser.ParseDocument(out))
+            return true;
+        if (error)
+            *error = parser.GetError();
+        out = JsonValue();
+        return false;
+    }
+
+    const JsonValue& JsonValue::operator[](std::size_t index) const
+    {
+        return (m_Type == Type::Array && index < m_Elements.size()) ? m_Elements[index] : s_Null;
+    }
+
+    const JsonValue& JsonValue::operator[](std::string_view key) const
+    {
+        if (m_Type == Type::Object)
+        {
+            for (const auto& member : m_Members)
+                if (member.first == key)
+                    return member.second;
+        }
+        return s_Null;
+    }
+
+    std::string JsonQuote(std::string_view text)
+    {
+        std::string out = "\"";
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n";  break;
+                case '\t': out += "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out += escaped;
+                    }
+                    else
+                        out += c;
+            }
+        }
+        return out + "\"";
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @brief Minimal read-only JSON document model.
+ * Parses UTF-8 JSON text into a tree of JsonValue nodes. Meant for small structured
+ * headers such as a glTF scene description, not for bulk data: numbers are doubles,
+ * objects keep their keys in file order and are searched linearly.
+ * Lookups never fail; a missing key or index yields a shared null value.
+ * JsonQuote is the one writing helper, for the reports and profiles the engine emits.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            Null,
+            Bool,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        /// @brief Parses a JSON document.
+        /// @param text The JSON text.
+        /// @param out Receives the root value.
+        /// @param error Receives a description of the first syntax error, if any.
+        /// @return True if the whole text was valid JSON.
+        static bool Parse(std::string_view text, JsonValue& out, std::string* error = nullptr);
+
+        Type GetType()   const { return m_Type; }
+        bool IsNull()    const { return m_Type == Type::Null; }
+        bool IsBool()    const { return m_Type == Type::Bool; }
+        bool IsNumber()  const { return m_Type == Type::Number; }
+        bool IsString()  const { return m_Type == Type::String; }
+        bool IsArray()   const { return m_Type == Type::Array; }
+        bool IsObject()  const { return m_Type == Type::Object; }
+
+        /// @brief Gets the number of elements of an array or members of an object.
+        /// @return The element count, 0 for scalars.
+        std::size_t Size() const { return m_Type == Type::Array ? m_Elements.size() : (m_Type == Type::Object ? m_Members.size() : 0); }
+
+        /// @brief Gets an array element.
+        /// @param index The element index.
+        /// @return The element, or a null value if this is not an array or index is out of range.
+        const JsonValue& operator[](std::size_t index) const;
+        const JsonValue& operator[](int index) const { return (*this)[static_cast<std::size_t>(index)]; } // negative wraps to out of range
+
+        /// @brief Gets an object member.
+        /// @param key The member name.
+        /// @return The member, or a null value if this is not an object or has no such key.
+        const JsonValue& operator[](std::string_view key) const;
+        const JsonValue& operator[](const char* key) const { return (*this)[std::string_view(key)]; }
+
+        /// @brief Checks if an object has a member.
+        /// @param key The member name.
+        /// @return True if the member exists.
+        bool Has(std::string_view key) const { return !(*this)[key].IsNull(); }
+
+        bool               AsBool(bool fallback = false) const     { return m_Type == Type::Bool ? m_Bool : fallback; }
+        double             AsNumber(double fallback = 0.0) const  { return m_Type == Type::Number ? m_Number : fallback; }
+        float              AsFloat(float fallback = 0.0f) const   { return m_Type == Type::Number ? static_cast<float>(m_Number) : fallback; }
+        std::size_t        AsSize(std::size_t fallback = 0) const { return m_Type == Type::Number && m_Number >= 0.0 ? static_cast<std::size_t>(m_Number) : fallback; }
+        int                AsInt(int fallback = 0) const          { return m_Type == Type::Number ? static_cast<int>(m_Number) : fallback; }
+        const std::string& AsString() const                       { return m_String; }
+
+        /// @brief Gets the elements of an array (empty for other types).
+        const std::vector<JsonValue>& Elements() const { return m_Elements; }
+
+        /// @brief Gets the members of an object, in file order (empty for other types).
+        const std::vector<std::pair<std::string, JsonValue>>& Members() const { return m_Members; }
+
+    private:
+        friend class JsonParser;
+
+        Type                                           m_Type   = Type::Null;
+        bool                                           m_Bool   = false;
+        double                                         m_Number = 0.0;
+        std::string                                    m_String;
+        std::vector<JsonValue>                         m_Elements;
+        std::vector<std::pair<std::string, JsonValue>> m_Members;
+    };
+
+    /// @brief Formats text as a JSON string literal, escaping quotes, backslashes and control characters.
+    /// @param text The text to quote.
+    /// @return The quoted literal.
+    std::string JsonQuote(std::string_view text);
+}
@@ -0,0 +1,146 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace isaacObjectViewer
+{
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Open = std::exchange(other.m_Open, false);
+#ifdef _WIN32
+            m_File    = std::exchange(other.m_File, nullptr);
+            m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::Open(const std::string& path)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_File = file;
+        m_Size = static_cast<std::size_t>(size.QuadPart);
+        m_Open = true;
+        if (m_Size == 0) // CreateFileMapping rejects empty files
+            return true;
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            Close();
+            return false;
+        }
+        m_Mapping = mapping;
+
+        m_Data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data)
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping)
+            CloseHandle(static_cast<HANDLE>(m_Mapping));
+        if (m_File)
+            CloseHandle(static_cast<HANDLE>(m_File));
+        m_Data    = nullptr;
+        m_Mapping = nullptr;
+        m_File    = nullptr;
+        m_Size    = 0;
+        m_Open    = false;
+    }
+
+#else
+
+    bool MappedFile::Open(const std::string& path)
+    {
+        Close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        m_Size = static_cast<std::size_t>(st.st_size);
+        m_Open = true;
+        if (m_Size > 0)
+        {
+            void* data = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                Close();
+                return false;
+            }
+            // files are read front to back; let the kernel read ahead aggressively
+            ::madvise(data, m_Size, MADV_SEQUENTIAL);
+            m_Data = static_cast<const unsigned char*>(data);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            ::munmap(const_cast<unsigned char*>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+    }
+
+#endif
+}
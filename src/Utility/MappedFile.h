@@ -0,0 +1,64 @@
+/**
+ * @brief Read-only memory-mapped view of a file.
+ * Maps the whole file with mmap (POSIX) or a file mapping (Windows) so large assets
+ * can be read without copying them into the process first. Move-only; the mapping is
+ * released when the object is destroyed or Close is called.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace isaacObjectViewer
+{
+    class MappedFile
+    {
+    public:
+        /// @brief Constructs an empty (unmapped) MappedFile.
+        MappedFile() = default;
+
+        /// @brief Maps a file; check IsOpen for success.
+        /// @param path The path of the file to map.
+        explicit MappedFile(const std::string& path) { Open(path); }
+
+        /// @brief Unmaps the file.
+        ~MappedFile() { Close(); }
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /// @brief Maps a file, replacing any previous mapping.
+        /// @param path The path of the file to map.
+        /// @return True if the file was mapped (an empty file maps to a null, zero-sized view).
+        bool Open(const std::string& path);
+
+        /// @brief Unmaps the file.
+        void Close();
+
+        /// @brief Checks if a file is mapped.
+        /// @return True if a file is mapped.
+        bool IsOpen() const { return m_Open; }
+
+        /// @brief Gets the mapped bytes.
+        /// @return A pointer to the start of the file, or nullptr if nothing is mapped.
+        const unsigned char* Data() const { return m_Data; }
+
+        /// @brief Gets the size of the mapping.
+        /// @return The size of the file in bytes.
+        std::size_t Size() const { return m_Size; }
+
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+    private:
+        const unsigned char* m_Data = nullptr;
+        std::size_t          m_Size = 0;
+        bool                 m_Open = false;
+#ifdef _WIN32
+        void*                m_File    = nullptr;
+        void*                m_Mapping = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,95 @@
+#include "MemoryStats.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+namespace isaacObjectViewer
+{
+#ifdef __linux__
+    // reads a "Key:   1234 kB" line from /proc/self/status
+    static std::size_t readStatusKB(const char* key)
+    {
+        std::FILE* file = std::fopen("/proc/self/status", "r");
+        if (!file)
+            return 0;
+
+        char line[256];
+        std::size_t value = 0;
+        const std::size_t keyLength = std::strlen(key);
+        while (std::fgets(line, sizeof(line), file))
+        {
+            if (std::strncmp(line, key, keyLength) == 0 && line[keyLength] == ':')
+            {
+                unsigned long long kb = 0;
+                if (std::sscanf(line + keyLength + 1, "%llu", &kb) == 1)
+                    value = static_cast<std::size_t>(kb) * 1024;
+                break;
+            }
+        }
+        std::fclose(file);
+        return value;
+    }
+#endif
+
+    std::size_t MemoryStats::GetResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.WorkingSetSize;
+        return 0;
+#elif defined(__linux__)
+        return readStatusKB("VmRSS");
+#else
+        return 0;
+#endif
+    }
+
+    std::size_t MemoryStats::GetPeakResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#elif defined(__linux__)
+        return readStatusKB("VmHWM");
+#else
+        rusage usage {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+    #ifdef __APPLE__
+        return static_cast<std::size_t>(usage.ru_maxrss);         // bytes
+    #else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // kilobytes
+    #endif
+#endif
+    }
+
+    bool MemoryStats::ResetPeak()
+    {
+#ifdef __linux__
+        // "5" resets VmHWM to the current RSS (Linux 4.0+)
+        std::FILE* file = std::fopen("/proc/self/clear_refs", "w");
+        if (!file)
+            return false;
+        const bool ok = std::fputs("5", file) >= 0;
+        return std::fclose(file) == 0 && ok;
+#else
+        return false;
+#endif
+    }
+}
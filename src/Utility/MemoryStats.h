@@ -0,0 +1,34 @@
+/**
+ * @brief Process memory counters (resident set size), for import reports and benchmarks.
+ * Backed by /proc on Linux, getrusage elsewhere on POSIX and the process memory
+ * counters on Windows. Values are 0 where the platform doesn't provide them.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace isaacObjectViewer
+{
+    class MemoryStats
+    {
+    public:
+        /// @brief Gets the memory the process currently has resident.
+        /// @return The resident set size in bytes.
+        static std::size_t GetResidentBytes();
+
+        /// @brief Gets the highest resident set size since start (or since ResetPeak).
+        /// @return The peak resident set size in bytes.
+        static std::size_t GetPeakResidentBytes();
+
+        /// @brief Restarts peak tracking from the current resident size, where supported (Linux).
+        /// @return True if the peak was reset.
+        static bool ResetPeak();
+
+        /// @brief Converts a byte count to mebibytes, for logging.
+        static double ToMB(std::size_t bytes) { return double(bytes) / (1024.0 * 1024.0); }
+
+    private:
+        MemoryStats() = delete;
+    };
+}
@@ -0,0 +1,192 @@
+/**
+ * @brief A small fixed-size worker pool.
+ * Workers are started once and pull tasks from a shared queue. ParallelFor splits
+ * an index range into chunks that are claimed by the calling thread and by the
+ * workers alike, so it is safe to call from inside a pool task (nested loops never
+ * wait on a worker that has not started yet).
+ *
+ * A pool constructed with zero threads runs everything inline on the caller,
+ * which is handy for benchmarking the serial path with the same code.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace isaacObjectViewer
+{
+    class ThreadPool
+    {
+    public:
+        /// @brief Gets the shared engine worker pool, sized to the hardware.
+        /// @return The shared worker pool.
+        static ThreadPool& GetInstance()
+        {
+            static ThreadPool instance(DefaultThreadCount());
+            return instance;
+        }
+
+        /// @brief Gets the number of workers the shared pool uses.
+        /// @return One less than the hardware thread count (the caller participates too).
+        static unsigned int DefaultThreadCount()
+        {
+            const unsigned int hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 0;
+        }
+
+        /// @brief Constructs a pool with the given number of worker threads.
+        /// @param threadCount The number of workers; 0 runs every task inline.
+        explicit ThreadPool(unsigned int threadCount)
+        {
+            m_Workers.reserve(threadCount);
+            for (unsigned int i = 0; i < threadCount; ++i)
+                m_Workers.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        /// @brief Stops the workers after draining the queue.
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stopping = true;
+            }
+            m_Condition.notify_all();
+            for (auto& worker : m_Workers)
+                worker.join();
+        }
+
+        /// @brief Gets the number of worker threads.
+        /// @return The number of worker threads (not counting callers).
+        unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+
+        /// @brief Queues a task on the pool.
+        /// @param fn The callable to run.
+        /// @return A future holding the task's result.
+        template<typename F>
+        auto Submit(F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+            std::future<Result> result = task->get_future();
+
+            if (m_Workers.empty())
+            {
+                (*task)();
+                return result;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Tasks.emplace([task]() { (*task)(); });
+            }
+            m_Condition.notify_one();
+            return result;
+        }
+
+        /// @brief Runs fn(i) for every i in [0, count) across the pool and the calling thread.
+        /// Returns once every index has been processed.
+        /// @param count The number of indices.
+        /// @param fn The callable, invoked as fn(std::size_t index).
+        /// @param grain The number of consecutive indices claimed at a time.
+        template<typename F>
+        void ParallelFor(std::size_t count, F&& fn, std::size_t grain = 1)
+        {
+            if (count == 0)
+                return;
+            if (grain == 0)
+                grain = 1;
+
+            const std::size_t chunks = (count + grain - 1) / grain;
+            if (m_Workers.empty() || chunks == 1)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    fn(i);
+                return;
+            }
+
+            // Shared so helpers that start after the loop finished can still exit cleanly
+            struct LoopState
+            {
+                std::atomic<std::size_t> NextChunk { 0 };
+                std::atomic<std::size_t> DoneChunks { 0 };
+                std::mutex               Mutex;
+                std::condition_variable  Done;
+            };
+            auto state = std::make_shared<LoopState>();
+            auto* body = &fn;
+
+            auto drain = [state, body, count, grain, chunks]()
+            {
+                for (;;)
+                {
+                    const std::size_t chunk = state->NextChunk.fetch_add(1);
+                    if (chunk >= chunks)
+                        return;
+
+                    const std::size_t begin = chunk * grain;
+                    const std::size_t end   = std::min(begin + grain, count);
+                    for (std::size_t i = begin; i < end; ++i)
+                        (*body)(i);
+
+                    if (state->DoneChunks.fetch_add(1) + 1 == chunks)
+                    {
+                        std::lock_guard<std::mutex> lock(state->Mutex);
+                        state->Done.notify_all();
+                    }
+                }
+            };
+
+            const std::size_t helpers = std::min<std::size_t>(m_Workers.size(), chunks - 1);
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (std::size_t i = 0; i < helpers; ++i)
+                    m_Tasks.emplace(drain);
+            }
+            m_Condition.notify_all();
+
+            drain();
+
+            std::unique_lock<std::mutex> lock(state->Mutex);
+            state->Done.wait(lock, [&]() { return state->DoneChunks.load() == chunks; });
+        }
+
+    private:
+        void WorkerLoop()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+                    if (m_Stopping && m_Tasks.empty())
+                        return;
+                    task = std::move(m_Tasks.front());
+                    m_Tasks.pop();
+                }
+                task();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+    private:
+        std::vector<std::thread>          m_Workers;
+        std::queue<std::function<void()>> m_Tasks;
+        std::mutex                        m_Mutex;
+        std::condition_variable           m_Condition;
+        bool                              m_Stopping = false;
+    };
+}
@@ -28,6 +28,8 @@
 constexpr double PI = 3.14159265358979323846;
 constexpr int SCREEN_WIDTH = 1600;
 constexpr int SCREEN_HEIGHT = 900;
+// bump whenever imported mesh data changes shape, so on-disk caches are rebuilt
+constexpr unsigned int ENGINE_VERSION = 1;
 
 #include <glad/glad.h>
 
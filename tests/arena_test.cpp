@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "Utility/Arena.h"
+#include <cstdint>
+
+using namespace isaacObjectViewer;
+
+TEST(ArenaTest, ScopesRewindAndReuseBlocks)
+{
+    ScratchArena arena(4096);
+
+    void* first = arena.allocate(100, 8);
+    const ScratchArena::Marker marker = arena.GetMarker();
+    void* a = arena.allocate(1000, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a) % 64, 0u);
+
+    // larger than a block: gets a block of its own
+    void* big = arena.allocate(10000, 16);
+    EXPECT_NE(big, nullptr);
+    const std::size_t capacity = arena.GetCapacity();
+    EXPECT_GE(capacity, 4096u + 10000u);
+
+    // rewinding hands out the same memory again, without new blocks
+    arena.Rewind(marker);
+    EXPECT_EQ(arena.allocate(1000, 64), a);
+    EXPECT_EQ(arena.allocate(10000, 16), big);
+    EXPECT_EQ(arena.GetCapacity(), capacity);
+
+    // what came before the marker stays where it was
+    arena.Rewind(marker);
+    EXPECT_GT(static_cast<unsigned char*>(arena.allocate(1, 1)), static_cast<unsigned char*>(first));
+}
+
+TEST(ArenaTest, ContainersUseTheThreadArena)
+{
+    ScratchArena::SetEnabled(true);
+    ScratchArena& arena = ScratchArena::ForThread();
+    const ScratchArena::Marker before = arena.GetMarker();
+    {
+        ArenaScope scope;
+        std::pmr::vector<int> values(1000, 7, ScratchArena::Get());
+        EXPECT_EQ(values.get_allocator().resource(), &arena);
+        EXPECT_EQ(values[999], 7);
+    }
+    const ScratchArena::Marker after = arena.GetMarker();
+    EXPECT_EQ(after.Block, before.Block);
+    EXPECT_EQ(after.Offset, before.Offset);
+
+    ScratchArena::SetEnabled(false);
+    EXPECT_EQ(ScratchArena::Get(), std::pmr::new_delete_resource());
+    ScratchArena::SetEnabled(true);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/CpuGeometry.h"
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    // two unit quads in z = 0 and z = -2, facing +Z
+    void MakeQuads(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        for (float z : { 0.0f, -2.0f })
+        {
+            const unsigned int base = static_cast<unsigned int>(vertices.size());
+            for (const glm::vec2& corner : { glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(1, 1), glm::vec2(-1, 1) })
+            {
+                Vertex v{};
+                v.Position = glm::vec3(corner, z);
+                vertices.push_back(v);
+            }
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+    }
+}
+
+TEST(CpuGeometryTest, ResidencyKeepsWhatItSays)
+{
+    for (CpuResidency residency : { CpuResidency::Full, CpuResidency::Picking, CpuResidency::None })
+    {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        MakeQuads(vertices, indices);
+        const CpuGeometry cpu(std::move(vertices), std::move(indices), residency);
+
+        EXPECT_EQ(cpu.GetResidency(), residency);
+        EXPECT_EQ(cpu.GetVertices().size(),  residency == CpuResidency::Full ? 8u : 0u);
+        EXPECT_EQ(cpu.GetPositions().size(), residency == CpuResidency::Picking ? 8u : 0u);
+        EXPECT_EQ(cpu.GetIndices().size(),   residency == CpuResidency::None ? 0u : 12u);
+        EXPECT_EQ(cpu.GetBytes(), CpuGeometry::BytesFor(residency, 8, 12));
+    }
+    EXPECT_EQ(CpuGeometry::BytesFor(CpuResidency::Picking, 8, 12), 8 * 12u + 12 * 4u);
+}
+
+TEST(CpuGeometryTest, RaysHitTheNearestTriangle)
+{
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    MakeQuads(vertices, indices);
+    const CpuGeometry cpu(std::move(vertices), std::move(indices), CpuResidency::Picking);
+
+    float t = 0.0f;
+    ASSERT_TRUE(cpu.IntersectRay(glm::vec3(0.25f, 0.5f, 5.0f), glm::vec3(0, 0, -1), &t));
+    EXPECT_FLOAT_EQ(t, 5.0f);
+
+    // from between the quads, backwards: the back face of the first one counts
+    ASSERT_TRUE(cpu.IntersectRay(glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0, 0, 2), &t));
+    EXPECT_FLOAT_EQ(t, 0.5f);
+
+    // beside the quads, and pointing away from them
+    EXPECT_FALSE(cpu.IntersectRay(glm::vec3(1.5f, 0.0f, 5.0f), glm::vec3(0, 0, -1), &t));
+    EXPECT_FALSE(cpu.IntersectRay(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0, 0, 1), &t));
+
+    const CpuGeometry none;
+    EXPECT_FALSE(none.IntersectRay(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0, 0, -1), &t));
+}
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/GltfLoader.h"
+#include "Utility/Json.h"
+#include "Utility/ThreadPool.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    void Append32(std::vector<unsigned char>& out, std::uint32_t v)
+    {
+        unsigned char bytes[4];
+        std::memcpy(bytes, &v, 4);
+        out.insert(out.end(), bytes, bytes + 4);
+    }
+
+    template <typename T>
+    void AppendValues(std::vector<unsigned char>& out, const std::vector<T>& values)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+        out.insert(out.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    std::vector<unsigned char> MakeGlb(std::string json, std::vector<unsigned char> bin)
+    {
+        while (json.size() % 4) json += ' ';
+        while (bin.size() % 4)  bin.push_back(0);
+
+        std::vector<unsigned char> glb;
+        Append32(glb, 0x46546C67);
+        Append32(glb, 2);
+        Append32(glb, static_cast<std::uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+        Append32(glb, static_cast<std::uint32_t>(json.size()));
+        Append32(glb, 0x4E4F534A);
+        glb.insert(glb.end(), json.begin(), json.end());
+        Append32(glb, static_cast<std::uint32_t>(bin.size()));
+        Append32(glb, 0x004E4942);
+        glb.insert(glb.end(), bin.begin(), bin.end());
+        return glb;
+    }
+
+    // one triangle: interleaved position + normal (24 byte stride), then 16-bit indices
+    std::vector<unsigned char> TriangleBin()
+    {
+        std::vector<unsigned char> bin;
+        AppendValues(bin, std::vector<float>{ 0, 0, 0,  0, 0, 1,
+                                              2, 0, 0,  0, 0, 1,
+                                              0, 3, 0,  0, 0, 1 });
+        AppendValues(bin, std::vector<std::uint16_t>{ 0, 1, 2 });
+        return bin;
+    }
+}
+
+TEST(JsonTest, ParsesNestedValuesAndEscapes)
+{
+    JsonValue root;
+    ASSERT_TRUE(JsonValue::Parse(R"({"a": [1, 2.5e1, -3], "s": "x\"é\n", "t": true, "n": null, "o": {}})", root));
+    EXPECT_EQ(root["a"].Size(), 3u);
+    EXPECT_DOUBLE_EQ(root["a"][1].AsNumber(), 25.0);
+    EXPECT_EQ(root["a"][2].AsInt(), -3);
+    EXPECT_EQ(root["s"].AsString(), "x\"\xC3\xA9\n");
+    EXPECT_TRUE(root["t"].AsBool());
+    EXPECT_TRUE(root["n"].IsNull());
+    EXPECT_TRUE(root["o"].IsObject());
+    EXPECT_TRUE(root["missing"]["deeper"][3].IsNull());
+
+    std::string error;
+    EXPECT_FALSE(JsonValue::Parse(R"({"a": [1, 2})", root, &error));
+    EXPECT_FALSE(error.empty());
+}
+
+TEST(GltfLoaderTest, GlbAttributesPointIntoTheSourceBuffer)
+{
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 78}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0,  "byteLength": 72, "byteStride": 24},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 6}
+        ],
+        "accessors": [
+            {"bufferView": 0, "byteOffset": 0,  "componentType": 5126, "count": 3, "type": "VEC3", "min": [0,0,0], "max": [2,3,0]},
+            {"bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ],
+        "meshes": [{"name": "tri", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2}]}],
+        "nodes": [{"mesh": 0}],
+        "scenes": [{"nodes": [0]}]
+    })";
+    const std::vector<unsigned char> glb = MakeGlb(json, TriangleBin());
+
+    ThreadPool pool(0);
+    auto scene = GltfLoader::LoadFromMemory(glb.data(), glb.size(), ".", pool);
+    ASSERT_NE(scene, nullptr);
+    EXPECT_TRUE(scene->Meshes.empty());
+    ASSERT_EQ(scene->StreamMeshes.size(), 1u);
+
+    const MeshStreams& mesh = scene->StreamMeshes[0];
+    EXPECT_EQ(mesh.Name, "tri");
+    EXPECT_EQ(mesh.VertexCount, 3u);
+
+    // interleaved position + normal share one range, which is the GLB chunk itself
+    ASSERT_EQ(mesh.Ranges.size(), 1u);
+    EXPECT_GE(mesh.Ranges[0].Data, glb.data());
+    EXPECT_LT(mesh.Ranges[0].Data, glb.data() + glb.size());
+    EXPECT_EQ(mesh.Ranges[0].Size, 72u);
+    EXPECT_EQ(mesh.Normal.Offset, 12u);
+    EXPECT_EQ(mesh.Normal.Stride, 24u);
+    EXPECT_FALSE(mesh.TexCoord.IsPresent());
+
+    // 16-bit indices are used as they are
+    EXPECT_EQ(mesh.IndexType, static_cast<std::uint32_t>(GL_UNSIGNED_SHORT));
+    EXPECT_EQ(mesh.IndexCount, 3u);
+    EXPECT_TRUE(mesh.OwnedIndices.empty());
+    EXPECT_EQ(mesh.IndexData(), static_cast<const void*>(mesh.Ranges[0].Data + 72));
+
+    EXPECT_EQ(mesh.BBoxMax, glm::vec3(2.0f, 3.0f, 0.0f));
+}
+
+TEST(GltfLoaderTest, OutOfRangeIndicesAreNotUploadedAsTheyAre)
+{
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 84}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0,  "byteLength": 72, "byteStride": 24},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 12}
+        ],
+        "accessors": [
+            {"bufferView": 0, "byteOffset": 0,  "componentType": 5126, "count": 3, "type": "VEC3", "min": [0,0,0], "max": [2,3,0]},
+            {"bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 1, "componentType": 5123, "count": 6, "type": "SCALAR"}
+        ],
+        "meshes": [{"name": "tri", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2}]}],
+        "nodes": [{"mesh": 0}],
+        "scenes": [{"nodes": [0]}]
+    })";
+    std::vector<unsigned char> bin = TriangleBin();
+    // a second triangle reaching past the three vertices
+    AppendValues(bin, std::vector<std::uint16_t>{ 0, 2, 9 });
+    const std::vector<unsigned char> glb = MakeGlb(json, bin);
+
+    ThreadPool pool(2);
+    auto scene = GltfLoader::LoadFromMemory(glb.data(), glb.size(), ".", pool);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->StreamMeshes.size(), 1u);
+
+    // the vertices are still read in place, but the indices are rebuilt without the bad triangle
+    const MeshStreams& mesh = scene->StreamMeshes[0];
+    EXPECT_EQ(mesh.IndexCount, 3u);
+    EXPECT_FALSE(mesh.OwnedIndices.empty());
+    EXPECT_EQ(mesh.IndexData(), static_cast<const void*>(mesh.OwnedIndices.data()));
+}
+
+TEST(GltfLoaderTest, PrimitivesWithoutNormalsGetFlatNormals)
+{
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 36}],
+        "bufferViews": [{"buffer": 0, "byteLength": 36}],
+        "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"}],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "mode": 6}]}]
+    })";
+    std::vector<unsigned char> bin;
+    AppendValues(bin, std::vector<float>{ 0, 0, 0,  1, 0, 0,  0, 1, 0 });
+    const std::vector<unsigned char> glb = MakeGlb(json, bin);
+
+    ThreadPool pool(0);
+    auto scene = GltfLoader::LoadFromMemory(glb.data(), glb.size(), ".", pool);
+    ASSERT_NE(scene, nullptr);
+    EXPECT_TRUE(scene->StreamMeshes.empty());
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+
+    // a fan of three vertices is one triangle; missing material maps to the default one
+    const MeshData& mesh = scene->Meshes[0];
+    ASSERT_EQ(mesh.Indices.size(), 3u);
+    EXPECT_EQ(mesh.Vertices[0].Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+    ASSERT_EQ(scene->Materials.size(), 1u);
+    EXPECT_EQ(mesh.MaterialIndex, 0u);
+}
+
+TEST(GltfLoaderTest, NodesPlaceSharedMeshes)
+{
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 78}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0,  "byteLength": 72, "byteStride": 24},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 6}
+        ],
+        "accessors": [
+            {"bufferView": 0, "byteOffset": 0,  "componentType": 5126, "count": 3, "type": "VEC3", "min": [0,0,0], "max": [2,3,0]},
+            {"bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ],
+        "meshes": [{"name": "bolt", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2}]}],
+        "nodes": [
+            {"name": "root", "translation": [10, 0, 0], "children": [1, 2]},
+            {"name": "a", "mesh": 0, "translation": [0, 1, 0]},
+            {"name": "b", "mesh": 0, "matrix": [2,0,0,0, 0,2,0,0, 0,0,2,0, 0,0,5,1]}
+        ],
+        "scenes": [{"nodes": [0]}]
+    })";
+    const std::vector<unsigned char> glb = MakeGlb(json, TriangleBin());
+
+    ThreadPool pool(0);
+    auto scene = GltfLoader::LoadFromMemory(glb.data(), glb.size(), ".", pool);
+    ASSERT_NE(scene, nullptr);
+
+    // the mesh is loaded once, and both nodes refer to it
+    ASSERT_EQ(scene->StreamMeshes.size(), 1u);
+    ASSERT_EQ(scene->Nodes.size(), 3u);
+    EXPECT_EQ(scene->Nodes[0].Parent, -1);
+    EXPECT_EQ(scene->Nodes[2].Parent, 0);
+    EXPECT_EQ(scene->Nodes[2].Name, "b");
+
+    const auto instances = CollectInstances(scene->Nodes, 1);
+    ASSERT_EQ(instances[0].size(), 2u);
+    EXPECT_EQ(glm::vec3(instances[0][0] * glm::vec4(1, 1, 1, 1)), glm::vec3(11, 2, 1));
+    EXPECT_EQ(glm::vec3(instances[0][1] * glm::vec4(1, 1, 1, 1)), glm::vec3(12, 2, 7));
+}
+
+TEST(GltfLoaderTest, EmbeddedImagesAreSharedAndDecodedFromMemory)
+{
+    // a 1x1 red PNG stored in a buffer view after the triangle
+    const std::vector<unsigned char> png = {
+        0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1F, 0x15, 0xC4, 0x89, 0x00, 0x00, 0x00,
+        0x0D, 0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0x63, 0xF8, 0xCF, 0xC0, 0xF0, 0x1F, 0x00, 0x05, 0x00, 0x01, 0xFF,
+        0x56, 0xC7, 0x2F, 0x0D, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82 };
+    std::vector<unsigned char> bin = TriangleBin();
+    bin.resize(80);
+    bin.insert(bin.end(), png.begin(), png.end());
+
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 150}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0,  "byteLength": 72, "byteStride": 24},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 6},
+            {"buffer": 0, "byteOffset": 80, "byteLength": 70}
+        ],
+        "accessors": [
+            {"bufferView": 0, "byteOffset": 0,  "componentType": 5126, "count": 3, "type": "VEC3", "min": [0,0,0], "max": [2,3,0]},
+            {"bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ],
+        "images": [{"bufferView": 2, "mimeType": "image/png"}, {"bufferView": 2, "mimeType": "image/png"}],
+        "textures": [{"source": 0}, {"source": 1}],
+        "materials": [
+            {"pbrMetallicRoughness": {"baseColorTexture": {"index": 0}}},
+            {"pbrMetallicRoughness": {"baseColorTexture": {"index": 1}}, "normalTexture": {"index": 0}}
+        ],
+        "meshes": [{"name": "tri", "primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2, "material": 1}]}],
+        "nodes": [{"mesh": 0}],
+        "scenes": [{"nodes": [0]}]
+    })";
+    const std::vector<unsigned char> glb = MakeGlb(json, bin);
+
+    ThreadPool pool(0);
+    auto scene = GltfLoader::LoadFromMemory(glb.data(), glb.size(), ".", pool);
+    ASSERT_NE(scene, nullptr);
+
+    // the bytes are referenced in place, once, and every material points at the same key
+    ASSERT_EQ(scene->EmbeddedImages.size(), 1u);
+    const EmbeddedImage& image = scene->EmbeddedImages[0];
+    EXPECT_EQ(image.Size, png.size());
+    EXPECT_GE(image.Data, glb.data());
+    EXPECT_LT(image.Data, glb.data() + glb.size());
+    ASSERT_EQ(scene->Materials.size(), 2u);
+    EXPECT_EQ(scene->Materials[0].DiffuseMap, image.Key);
+    ASSERT_EQ(scene->Materials[1].Textures.size(), 2u);
+    EXPECT_EQ(scene->Materials[1].Textures[1].Path, image.Key);
+
+    const DecodedImage decoded = TextureManager::DecodeImageFromMemory(image.Data, image.Size);
+    ASSERT_TRUE(decoded.IsValid());
+    EXPECT_EQ(decoded.Width, 1);
+    EXPECT_EQ(decoded.Channels, 4);
+    EXPECT_EQ(decoded.Pixels.get()[0], 0xFF);
+    EXPECT_EQ(decoded.Pixels.get()[1], 0x00);
+}
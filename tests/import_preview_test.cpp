@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/ImportPreview.h"
+#include "Engine/Graphics/ImportedScene.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+TEST(ImportPreviewTest, BinsPointsIntoCubicCells)
+{
+    // two clusters at the ends of a 4 x 1 x 1 bar
+    const std::vector<glm::vec3> points = { { 0.0f, 0.0f, 0.0f }, { 0.1f, 0.9f, 0.5f }, { 4.0f, 1.0f, 1.0f } };
+    const ImportPreview preview = ImportPreviewBuilder::FromPoints(points, 4);
+    ASSERT_EQ(preview.Boxes.size(), 2u);
+    EXPECT_EQ(preview.Boxes[0].Min, glm::vec3(0.0f));
+    EXPECT_EQ(preview.Boxes[0].Max, glm::vec3(1.0f));
+    EXPECT_EQ(preview.Boxes[1].Min, glm::vec3(3.0f, 0.0f, 0.0f));
+
+    const MeshData mesh = ImportPreviewBuilder::BuildMesh(preview);
+    EXPECT_EQ(mesh.Vertices.size(), 48u);
+    ASSERT_EQ(mesh.Indices.size(), 72u);
+
+    // every triangle faces the way its normal points: out of the box
+    for (std::size_t i = 0; i < mesh.Indices.size(); i += 3)
+    {
+        const Vertex& a = mesh.Vertices[mesh.Indices[i]];
+        const Vertex& b = mesh.Vertices[mesh.Indices[i + 1]];
+        const Vertex& c = mesh.Vertices[mesh.Indices[i + 2]];
+        EXPECT_GT(glm::dot(glm::cross(b.Position - a.Position, c.Position - a.Position), a.Normal), 0.0f);
+    }
+
+    EXPECT_TRUE(ImportPreviewBuilder::FromPoints({}).Empty());
+}
+
+TEST(ImportPreviewTest, SamplesObjVertexRecords)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "iov_import_preview_test.obj").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "# bar\nv 0 0 0\nvn 0 0 1\nvt 0.5 0.5\n  v 8 2 -1\nf 1 2 1\n";
+    }
+
+    std::vector<glm::vec3> points;
+    ASSERT_TRUE(ImportPreviewBuilder::SampleSource(path, points));
+    ASSERT_EQ(points.size(), 2u);
+    EXPECT_EQ(points[1], glm::vec3(8.0f, 2.0f, -1.0f));
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(ImportPreviewBuilder::SampleSource("missing.fbx", points));
+}
+
+TEST(ImportPreviewTest, SamplesScenePlacedByNodes)
+{
+    ImportedScene scene;
+    scene.Meshes.resize(1);
+    scene.Meshes[0].Vertices.resize(2);
+    scene.Meshes[0].Vertices[0].Position = { 0.0f, 0.0f, 0.0f };
+    scene.Meshes[0].Vertices[1].Position = { 1.0f, 0.0f, 0.0f };
+
+    SceneNode node;
+    node.Transform = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 5.0f, 0.0f));
+    node.Meshes    = { 0 };
+    scene.Nodes.push_back(node);
+    node.Transform = glm::mat4(1.0f);
+    scene.Nodes.push_back(node);
+
+    std::vector<glm::vec3> points;
+    ImportPreviewBuilder::SampleScene(scene, points);
+    ASSERT_EQ(points.size(), 4u);
+    EXPECT_EQ(points[1], glm::vec3(1.0f, 5.0f, 0.0f));
+    EXPECT_EQ(points[3], glm::vec3(1.0f, 0.0f, 0.0f));
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/ImportProfile.h"
+#include "Utility/Json.h"
+#include <string>
+
+using namespace isaacObjectViewer;
+
+TEST(ImportProfileTest, StagesAccumulateAndSerialize)
+{
+    ImportProfile profile;
+    profile.Model    = "crate \"v2\"";
+    profile.Loader   = "Assimp";
+    profile.CacheHit = true;
+
+    profile.Add("Assimp post-process", 4.0, 0, 2);
+    profile.Add("TriangulateProcess", 1.5, 0, 0, 1);
+    // uploads are recorded once per step and add up
+    profile.Add("Upload meshes", 2.0, 100, 3);
+    profile.Add("Upload meshes", 0.5, 50, 1);
+
+    ASSERT_EQ(profile.Stages.size(), 3u);
+    EXPECT_EQ(profile.Stages[1].Depth, 1);
+    EXPECT_DOUBLE_EQ(profile.Stages[2].Milliseconds, 2.5);
+    EXPECT_EQ(profile.Stages[2].Bytes, 150u);
+    EXPECT_EQ(profile.Stages[2].Items, 4u);
+
+    JsonValue root;
+    std::string error;
+    ASSERT_TRUE(JsonValue::Parse(profile.ToJson(), root, &error)) << error;
+    EXPECT_EQ(root["model"].AsString(), "crate \"v2\"");
+    EXPECT_TRUE(root["cacheHit"].AsBool());
+    ASSERT_EQ(root["stages"].Size(), 3u);
+    EXPECT_EQ(root["stages"][1]["name"].AsString(), "TriangulateProcess");
+    EXPECT_EQ(root["stages"][1]["depth"].AsInt(), 1);
+    EXPECT_EQ(root["stages"][2]["bytes"].AsSize(), 150u);
+    EXPECT_DOUBLE_EQ(root["stages"][2]["ms"].AsNumber(), 2.5);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/ImpostorSelector.h"
+#include "Engine/Graphics/ImpostorCache.h"
+#include "Engine/Graphics/LodSelector.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <filesystem>
+
+using namespace isaacObjectViewer;
+
+TEST(ImpostorTest, OctahedralMapRoundTrips)
+{
+    const glm::vec3 directions[] = { { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { 0, -1, 0 },
+                                     glm::normalize(glm::vec3(1, 2, -3)), glm::normalize(glm::vec3(-0.2f, 0.1f, 0.9f)) };
+    for (const glm::vec3& d : directions)
+    {
+        const glm::vec2 e = ImpostorSelector::OctEncode(d);
+        EXPECT_LE(std::abs(e.x), 1.0f + 1e-5f);
+        EXPECT_LE(std::abs(e.y), 1.0f + 1e-5f);
+        EXPECT_NEAR(glm::dot(ImpostorSelector::OctDecode(e), d), 1.0f, 1e-5f);
+    }
+}
+
+TEST(ImpostorTest, ViewsAroundADirectionAreBlendedBilinearly)
+{
+    // at a view's own direction, that view alone
+    const glm::ivec2 tile(3, 5);
+    const ImpostorViews exact = ImpostorSelector::SelectViews(ImpostorSelector::FrameDirection(tile));
+    float total = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+        total += exact.Weights[i];
+        if (exact.Weights[i] > 0.99f)
+        {
+            EXPECT_EQ(exact.Tiles[i], tile);
+        }
+    }
+    EXPECT_NEAR(total, 1.0f, 1e-5f);
+    EXPECT_NEAR(std::max({ exact.Weights[0], exact.Weights[1], exact.Weights[2], exact.Weights[3] }), 1.0f, 1e-4f);
+
+    // anywhere else the weights still sum to one and the tiles stay inside the atlas
+    const ImpostorViews between = ImpostorSelector::SelectViews(glm::normalize(glm::vec3(0.3f, -0.8f, -0.5f)));
+    total = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+        total += between.Weights[i];
+        EXPECT_TRUE(glm::all(glm::greaterThanEqual(between.Tiles[i], glm::ivec2(0))));
+        EXPECT_TRUE(glm::all(glm::lessThan(between.Tiles[i], glm::ivec2(ImpostorSelector::kFramesPerSide))));
+    }
+    EXPECT_NEAR(total, 1.0f, 1e-5f);
+
+    // the bake camera's axes are orthonormal and match glm::lookAt
+    const glm::vec3 direction = ImpostorSelector::FrameDirection(tile);
+    glm::vec3 right, up;
+    ImpostorSelector::FrameBasis(direction, right, up);
+    EXPECT_NEAR(glm::dot(right, up), 0.0f, 1e-5f);
+    EXPECT_NEAR(glm::dot(right, direction), 0.0f, 1e-5f);
+    const glm::mat4 view = glm::lookAt(direction * 2.0f, glm::vec3(0.0f), up);
+    EXPECT_NEAR(glm::dot(glm::vec3(view[0][0], view[1][0], view[2][0]), right), 1.0f, 1e-5f);
+}
+
+TEST(ImpostorTest, SmallModelsUseImpostorsWithHysteresis)
+{
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 1000.0f);
+    LodSelector::BeginFrame(view, projection, 1000.0f, 0.0f);
+
+    // a unit sphere 9 units away covers about 2 * 1000 / (2 * tan(22.5 deg) * 9) = 268 px
+    ImpostorSelector::GetSettings().ScreenSize = 32.0f;
+    EXPECT_FALSE(ImpostorSelector::UseImpostor(glm::vec3(0.0f), 1.0f, false));
+    EXPECT_TRUE(ImpostorSelector::UseImpostor(glm::vec3(0.0f), 0.05f, false));
+
+    // just over the threshold: stays an impostor, but doesn't become one
+    ImpostorSelector::GetSettings().ScreenSize = 260.0f;
+    EXPECT_TRUE(ImpostorSelector::UseImpostor(glm::vec3(0.0f), 1.0f, true));
+    EXPECT_FALSE(ImpostorSelector::UseImpostor(glm::vec3(0.0f), 1.0f, false));
+
+    // the camera inside the sphere always draws the meshes
+    EXPECT_FALSE(ImpostorSelector::UseImpostor(glm::vec3(0.0f, 0.0f, 9.5f), 1.0f, true));
+
+    ImpostorSelector::GetSettings().Enabled = false;
+    EXPECT_FALSE(ImpostorSelector::UseImpostor(glm::vec3(0.0f), 0.05f, true));
+    ImpostorSelector::GetSettings() = ImpostorSettings{};
+}
+
+TEST(ImpostorTest, CacheRoundTripsAndRejectsStaleEntries)
+{
+    ImpostorBake bake;
+    bake.FramesPerSide = 2;
+    bake.FrameSize     = 4;
+    bake.Center        = glm::vec3(1.0f, 2.0f, 3.0f);
+    bake.Radius        = 0.5f;
+    bake.Albedo.resize(bake.AtlasBytes());
+    bake.Normal.resize(bake.AtlasBytes());
+    for (std::size_t i = 0; i < bake.Albedo.size(); ++i)
+    {
+        bake.Albedo[i] = static_cast<unsigned char>(i);
+        bake.Normal[i] = static_cast<unsigned char>(255 - i);
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "iov_impostor_test.iovimp").string();
+    const ImpostorCacheKey key{ 0x1234u, 7u };
+    ASSERT_TRUE(ImpostorCache::Write(path, bake, key));
+
+    const ImpostorBake read = ImpostorCache::Read(path, key);
+    ASSERT_TRUE(read.IsValid());
+    EXPECT_EQ(read.FramesPerSide, 2);
+    EXPECT_EQ(read.FrameSize, 4);
+    EXPECT_EQ(read.Center, bake.Center);
+    EXPECT_EQ(read.Radius, bake.Radius);
+    EXPECT_EQ(read.Albedo, bake.Albedo);
+    EXPECT_EQ(read.Normal, bake.Normal);
+
+    EXPECT_FALSE(ImpostorCache::Read(path, ImpostorCacheKey{ 0x1235u, 7u }).IsValid());
+    EXPECT_FALSE(ImpostorCache::Read(path, ImpostorCacheKey{ 0x1234u, 8u }).IsValid());
+    std::filesystem::remove(path);
+    EXPECT_FALSE(ImpostorCache::Read(path, key).IsValid());
+}
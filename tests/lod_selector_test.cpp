@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/LodSelector.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    // camera at the origin looking down -Z, 1000 pixels high: 1 unit at distance d is about 1207/d pixels
+    void BeginPerspectiveFrame(float deltaSeconds = 0.0f)
+    {
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        LodSelector::BeginFrame(view, glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 1000.0f), 1000.0f, deltaSeconds);
+    }
+
+    std::vector<LodRange> MakeLevels()
+    {
+        return { { 0, 3000, 0.0f }, { 3000, 1500, 0.001f }, { 4500, 750, 0.01f }, { 5250, 375, 0.1f } };
+    }
+}
+
+TEST(LodSelectorTest, PicksCoarsestLevelUnderPixelError)
+{
+    LodSelector::GetSettings() = LodSettings{};
+    BeginPerspectiveFrame();
+    const std::vector<LodRange> levels = MakeLevels();
+
+    EXPECT_NEAR(LodSelector::ProjectedError(1.0f, 100.0f), 500.0f / std::tan(glm::radians(22.5f)) / 100.0f, 1e-2f);
+
+    // at 100 units: 0.012, 0.12 and 1.2 pixels
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 100.0f, 0), 2u);
+    // far enough for the coarsest, and inside the bounds always the full mesh
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 1000.0f, 0), 3u);
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 0.0f, 3), 0u);
+
+    LodSelector::GetSettings().Enabled = false;
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 1000.0f, 3), 0u);
+    LodSelector::GetSettings() = LodSettings{};
+}
+
+TEST(LodSelectorTest, HysteresisKeepsTheCurrentLevelNearTheThreshold)
+{
+    LodSelector::GetSettings() = LodSettings{};
+    BeginPerspectiveFrame();
+    const std::vector<LodRange> levels = MakeLevels();
+
+    // level 3 projects to about 0.9 pixels: under PixelError, but not under PixelError * (1 - Hysteresis)
+    const float distance = 0.1f * LodSelector::ProjectedError(1.0f, 1.0f) / 0.9f;
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), distance, 2), 2u);
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), distance, 3), 3u);
+}
+
+TEST(LodSelectorTest, OrthographicIgnoresDistance)
+{
+    LodSelector::GetSettings() = LodSettings{};
+    // 10 units tall on 1000 pixels: 100 pixels per unit
+    LodSelector::BeginFrame(glm::mat4(1.0f), glm::ortho(-5.0f, 5.0f, -5.0f, 5.0f, 0.1f, 100.0f), 1000.0f, 0.0f);
+    const std::vector<LodRange> levels = MakeLevels();
+
+    EXPECT_NEAR(LodSelector::ProjectedError(0.01f, 1.0f), 1.0f, 1e-4f);
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 1.0f, 0), 1u);
+    EXPECT_EQ(LodSelector::Select(levels.data(), levels.size(), 1000.0f, 0), 1u);
+}
+
+TEST(LodSelectorTest, LevelChangesFadeOverFadeSeconds)
+{
+    LodSelector::GetSettings() = LodSettings{};
+    LodSelector::GetSettings().FadeSeconds = 0.5f;
+    BeginPerspectiveFrame();
+
+    LodState state;
+    LodSelector::Update(state, 0);
+    EXPECT_EQ(LodSelector::GetFade(state), 1.0f);
+
+    LodSelector::Update(state, 2);
+    EXPECT_EQ(state.Current, 2u);
+    EXPECT_EQ(state.Previous, 0u);
+    EXPECT_NEAR(LodSelector::GetFade(state), 0.0f, 1e-6f);
+
+    BeginPerspectiveFrame(0.25f);
+    EXPECT_NEAR(LodSelector::GetFade(state), 0.5f, 1e-4f);
+    BeginPerspectiveFrame(0.5f);
+    EXPECT_EQ(LodSelector::GetFade(state), 1.0f);
+
+    // without a fade the switch is immediate
+    LodSelector::GetSettings().FadeSeconds = 0.0f;
+    LodSelector::Update(state, 1);
+    EXPECT_EQ(LodSelector::GetFade(state), 1.0f);
+    LodSelector::GetSettings() = LodSettings{};
+}
+
+TEST(LodSelectorTest, FrameStatsCoverTheLastCompleteFrame)
+{
+    BeginPerspectiveFrame();
+    LodSelector::RecordDraw(0, 1000, 1000);
+    LodSelector::RecordDraw(2, 250, 1000);
+    EXPECT_EQ(LodSelector::GetLastFrame().DrawnTriangles, 0u);
+
+    BeginPerspectiveFrame();
+    const LodFrameStats& stats = LodSelector::GetLastFrame();
+    EXPECT_EQ(stats.DrawnTriangles, 1250u);
+    EXPECT_EQ(stats.FullTriangles, 2000u);
+    EXPECT_EQ(stats.Meshes[0], 1u);
+    EXPECT_EQ(stats.Meshes[2], 1u);
+}
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/MeshCache.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    ImportedScene MakeScene()
+    {
+        ImportedScene scene;
+        scene.ZUp = true;
+
+        MaterialData material;
+        material.Textures.push_back({ "textures/brick.png", TextureType::DIFFUSE });
+        material.DiffuseMap   = "textures/brick.png";
+        material.DiffuseColor = glm::vec3(0.5f, 0.25f, 1.0f);
+        material.Shininess    = 12.0f;
+        scene.Materials.push_back(material);
+
+        MeshData mesh;
+        mesh.Name = "quad";
+        for (int i = 0; i < 4; ++i)
+        {
+            Vertex v{};
+            v.Position  = glm::vec3(float(i), float(i * 2), 0.0f);
+            v.TexCoords = glm::vec2(float(i) * 0.25f, 1.0f);
+            mesh.Vertices.push_back(v);
+        }
+        mesh.Indices = { 0, 1, 2, 0, 2, 3 };
+        mesh.Lods.push_back({ { 0, 1, 2 }, 0.5f });
+        Meshlet meshlet;
+        meshlet.IndexCount = 6;
+        meshlet.Center     = glm::vec3(1.5f, 3.0f, 0.0f);
+        meshlet.Radius     = 3.5f;
+        mesh.Meshlets.push_back(meshlet);
+        MeshPart part;
+        part.Name       = "left";
+        part.IndexCount = 3;
+        part.BBoxMax    = glm::vec3(2.0f, 4.0f, 0.0f);
+        mesh.Parts.push_back(part);
+        mesh.Format.Quantized = true;
+        scene.Meshes.push_back(mesh);
+
+        SceneNode root;
+        root.Name = "root";
+        SceneNode child;
+        child.Name      = "child";
+        child.Parent    = 0;
+        child.Transform = glm::mat4(2.0f);
+        child.Meshes    = { 0, 0 };
+        scene.Nodes = { root, child };
+
+        scene.SourceBuffers.push_back({ 1, 2, 3, 4, 5 });
+        scene.AddEmbeddedImage(scene.SourceBuffers.back().data(), scene.SourceBuffers.back().size());
+        return scene;
+    }
+
+    MeshCacheKey MakeKey()
+    {
+        MeshCacheKey key;
+        key.SourceHash    = 0xfeedbeefull;
+        key.SourceSize    = 1234;
+        key.ImportFlags   = 7;
+        key.EngineVersion = ENGINE_VERSION;
+        return key;
+    }
+
+    std::string TempCachePath()
+    {
+        return (std::filesystem::temp_directory_path() / "iov_mesh_cache_test.iovmesh").string();
+    }
+}
+
+TEST(MeshCacheTest, RoundTrip)
+{
+    const std::string path = TempCachePath();
+    const ImportedScene scene = MakeScene();
+
+    ASSERT_TRUE(MeshCache::Write(path, scene, MakeKey()));
+    auto loaded = MeshCache::Read(path, MakeKey());
+    ASSERT_NE(loaded, nullptr);
+
+    EXPECT_TRUE(loaded->ZUp);
+    ASSERT_EQ(loaded->Materials.size(), 1u);
+    EXPECT_EQ(loaded->Materials[0].DiffuseMap, "textures/brick.png");
+    EXPECT_EQ(loaded->Materials[0].DiffuseColor, glm::vec3(0.5f, 0.25f, 1.0f));
+    ASSERT_EQ(loaded->Meshes.size(), 1u);
+    EXPECT_EQ(loaded->Meshes[0].Name, "quad");
+    EXPECT_EQ(loaded->Meshes[0].Format, scene.Meshes[0].Format);
+    ASSERT_EQ(loaded->Meshes[0].Parts.size(), 1u);
+    EXPECT_EQ(loaded->Meshes[0].Parts[0].Name, "left");
+    EXPECT_EQ(loaded->Meshes[0].Parts[0].IndexCount, 3u);
+    EXPECT_EQ(loaded->Meshes[0].Parts[0].BBoxMax, glm::vec3(2.0f, 4.0f, 0.0f));
+
+    // stored as uploaded: packed vertices, then every level in one 16-bit index buffer
+    const PackedGeometry& packed = loaded->Meshes[0].Packed;
+    ASSERT_TRUE(packed.IsSet());
+    EXPECT_TRUE(loaded->Meshes[0].Vertices.empty());
+    ASSERT_EQ(packed.VertexCount, 4u);
+    std::vector<unsigned char> expected;
+    VertexPacker::Pack(scene.Meshes[0].Vertices, scene.Meshes[0].Format, expected);
+    EXPECT_EQ(std::vector<unsigned char>(packed.Vertices, packed.Vertices + expected.size()), expected);
+    EXPECT_EQ(packed.BBoxMin, glm::vec3(0.0f));
+    EXPECT_EQ(packed.BBoxMax, glm::vec3(3.0f, 6.0f, 0.0f));
+    ASSERT_TRUE(packed.ShortIndices);
+    ASSERT_EQ(packed.IndexCount, 9u);
+    const std::uint16_t* indices = static_cast<const std::uint16_t*>(packed.Indices);
+    EXPECT_EQ(std::vector<std::uint16_t>(indices, indices + 9), (std::vector<std::uint16_t>{ 0, 1, 2, 0, 2, 3, 0, 1, 2 }));
+    ASSERT_EQ(packed.Levels.size(), 2u);
+    EXPECT_EQ(packed.Levels[0].IndexCount, 6u);
+    EXPECT_EQ(packed.Levels[1].FirstIndex, 6u);
+    EXPECT_EQ(packed.Levels[1].IndexCount, 3u);
+    EXPECT_EQ(packed.Levels[1].Error, 0.5f);
+    ASSERT_EQ(loaded->Meshes[0].Meshlets.size(), 1u);
+    EXPECT_EQ(loaded->Meshes[0].Meshlets[0].IndexCount, 6u);
+    EXPECT_EQ(loaded->Meshes[0].Meshlets[0].Center, glm::vec3(1.5f, 3.0f, 0.0f));
+    EXPECT_EQ(loaded->Meshes[0].Meshlets[0].Radius, 3.5f);
+
+    ASSERT_EQ(loaded->Nodes.size(), 2u);
+    EXPECT_EQ(loaded->Nodes[1].Name, "child");
+    EXPECT_EQ(loaded->Nodes[1].Parent, 0);
+    EXPECT_EQ(loaded->Nodes[1].Transform, glm::mat4(2.0f));
+    EXPECT_EQ(loaded->Nodes[1].Meshes, scene.Nodes[1].Meshes);
+
+    ASSERT_EQ(loaded->EmbeddedImages.size(), 1u);
+    EXPECT_EQ(loaded->EmbeddedImages[0].Key, scene.EmbeddedImages[0].Key);
+    ASSERT_EQ(loaded->EmbeddedImages[0].Size, 5u);
+    EXPECT_EQ(loaded->EmbeddedImages[0].Data[4], 5);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MeshCacheTest, StaleOrCorruptEntriesAreRejected)
+{
+    const std::string path = TempCachePath();
+    ASSERT_TRUE(MeshCache::Write(path, MakeScene(), MakeKey()));
+    EXPECT_TRUE(MeshCache::IsCurrent(path, MakeKey()));
+
+    MeshCacheKey changedSource = MakeKey();
+    changedSource.SourceHash ^= 1;
+    EXPECT_EQ(MeshCache::Read(path, changedSource), nullptr);
+    EXPECT_FALSE(MeshCache::IsCurrent(path, changedSource));
+
+    MeshCacheKey changedFlags = MakeKey();
+    changedFlags.ImportFlags = 8;
+    EXPECT_EQ(MeshCache::Read(path, changedFlags), nullptr);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_EQ(MeshCache::Read(path, MakeKey()), nullptr);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MeshCacheTest, ChangedDependenciesMakeEntriesStale)
+{
+    const std::string path = TempCachePath();
+    const auto library = std::filesystem::temp_directory_path() / "iov_mesh_cache_test.mtl";
+    {
+        std::ofstream mtl(library);
+        mtl << "newmtl brick\nKd 0.5 0.25 1\n";
+    }
+
+    ImportedScene scene = MakeScene();
+    scene.Dependencies.push_back(library.string());
+    ASSERT_TRUE(MeshCache::Write(path, scene, MakeKey()));
+    EXPECT_TRUE(MeshCache::IsCurrent(path, MakeKey()));
+    EXPECT_NE(MeshCache::Read(path, MakeKey()), nullptr);
+
+    {
+        std::ofstream mtl(library, std::ios::app);
+        mtl << "Ks 1 1 1\n";
+    }
+    EXPECT_FALSE(MeshCache::IsCurrent(path, MakeKey()));
+    EXPECT_EQ(MeshCache::Read(path, MakeKey()), nullptr);
+
+    std::filesystem::remove(library);
+    EXPECT_EQ(MeshCache::Read(path, MakeKey()), nullptr);
+
+    std::filesystem::remove(path);
+}
+
+TEST(MeshCacheTest, StampKeysFollowSizeAndModificationTime)
+{
+    const auto source = std::filesystem::temp_directory_path() / "iov_mesh_cache_test_stamp.obj";
+    {
+        std::ofstream obj(source);
+        obj << "v 0 0 0\n";
+    }
+
+    MeshCacheKey first, again, grown;
+    ASSERT_TRUE(MeshCache::MakeStampKey(source.string(), 7, first));
+    ASSERT_TRUE(MeshCache::MakeStampKey(source.string(), 7, again));
+    EXPECT_EQ(first.SourceHash, again.SourceHash);
+    EXPECT_EQ(first.SourceSize, 8u);
+
+    {
+        std::ofstream obj(source, std::ios::app);
+        obj << "v 1 0 0\n";
+    }
+    ASSERT_TRUE(MeshCache::MakeStampKey(source.string(), 7, grown));
+    EXPECT_NE(grown.SourceSize, first.SourceSize);
+
+    std::filesystem::remove(source);
+    EXPECT_FALSE(MeshCache::MakeStampKey(source.string(), 7, first));
+}
+
+TEST(MeshCacheTest, DerivedEntriesOnlyApplyToMatchingMeshes)
+{
+    const std::string path = TempCachePath() + ".derived";
+    ASSERT_TRUE(MeshCache::WriteDerived(path, MakeScene(), MakeKey()));
+
+    // what a loader parses again: the same meshes without their LOD chains and meshlets
+    ImportedScene parsed = MakeScene();
+    parsed.Meshes[0].Lods.clear();
+    parsed.Meshes[0].Meshlets.clear();
+    ASSERT_TRUE(MeshCache::ReadDerived(path, MakeKey(), parsed));
+    ASSERT_EQ(parsed.Meshes[0].Lods.size(), 1u);
+    EXPECT_EQ(parsed.Meshes[0].Lods[0].Indices, (std::vector<unsigned int>{ 0, 1, 2 }));
+    EXPECT_EQ(parsed.Meshes[0].Lods[0].Error, 0.5f);
+    ASSERT_EQ(parsed.Meshes[0].Meshlets.size(), 1u);
+    EXPECT_EQ(parsed.Meshes[0].Meshlets[0].IndexCount, 6u);
+    EXPECT_EQ(parsed.Meshes[0].Meshlets[0].Radius, 3.5f);
+
+    ImportedScene changed = MakeScene();
+    changed.Meshes[0].Lods.clear();
+    changed.Meshes[0].Meshlets.clear();
+    changed.Meshes[0].Indices.resize(3);
+    EXPECT_FALSE(MeshCache::ReadDerived(path, MakeKey(), changed));
+    EXPECT_TRUE(changed.Meshes[0].Lods.empty());
+    EXPECT_TRUE(changed.Meshes[0].Meshlets.empty());
+
+    MeshCacheKey changedSource = MakeKey();
+    changedSource.SourceSize += 1;
+    EXPECT_FALSE(MeshCache::ReadDerived(path, changedSource, changed));
+
+    // a full entry is not a derived one, and the other way round
+    EXPECT_EQ(MeshCache::Read(path, MakeKey()), nullptr);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/MeshOptimizer.h"
+#include "test_meshes.h"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    void ShuffleTriangles(MeshData& mesh)
+    {
+        std::vector<std::array<unsigned int, 3>> triangles(mesh.Indices.size() / 3);
+        std::copy(mesh.Indices.begin(), mesh.Indices.end(), &triangles[0][0]);
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+        std::copy(&triangles[0][0], &triangles[0][0] + mesh.Indices.size(), mesh.Indices.begin());
+    }
+
+    // triangles as position triples, rotated to start at the smallest corner, sorted
+    std::vector<std::array<float, 9>> TriangleSet(const MeshData& mesh)
+    {
+        std::vector<std::array<float, 9>> set;
+        for (std::size_t t = 0; t + 2 < mesh.Indices.size(); t += 3)
+        {
+            std::array<std::array<float, 3>, 3> corners;
+            for (int k = 0; k < 3; ++k)
+            {
+                const glm::vec3& p = mesh.Vertices[mesh.Indices[t + k]].Position;
+                corners[k] = { p.x, p.y, p.z };
+            }
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+            std::array<float, 9> flat;
+            for (int k = 0; k < 3; ++k)
+                std::copy(corners[k].begin(), corners[k].end(), flat.begin() + k * 3);
+            set.push_back(flat);
+        }
+        std::sort(set.begin(), set.end());
+        return set;
+    }
+}
+
+TEST(MeshOptimizerTest, AnalyzeCountsFifoMisses)
+{
+    // two triangles sharing an edge: 4 misses over 2 triangles and 4 vertices
+    const unsigned int quad[] = { 0, 1, 2, 0, 2, 3 };
+    VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(quad, 6, 4);
+    EXPECT_FLOAT_EQ(stats.Acmr, 2.0f);
+    EXPECT_FLOAT_EQ(stats.Atvr, 1.0f);
+
+    // a 3-entry FIFO has evicted vertex 0 by the time the last triangle needs it again
+    const unsigned int strip[] = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+    stats = MeshOptimizer::AnalyzeVertexCache(strip, 9, 6, 3);
+    EXPECT_FLOAT_EQ(stats.Acmr, 3.0f);
+    EXPECT_FLOAT_EQ(stats.Atvr, 1.5f);
+}
+
+TEST(MeshOptimizerTest, OptimizeImprovesCacheAndKeepsTriangles)
+{
+    MeshData mesh = MakeGrid(40, glm::vec2(0.0f), glm::vec2(40.0f));
+    ShuffleTriangles(mesh);
+    const std::vector<std::array<float, 9>> before = TriangleSet(mesh);
+
+    MeshOptimizer::Optimize(mesh);
+    EXPECT_TRUE(mesh.Stats.Optimized);
+    EXPECT_GT(mesh.Stats.Before.Acmr, 2.0f);
+    EXPECT_LT(mesh.Stats.After.Acmr, 0.8f);
+    EXPECT_LT(mesh.Stats.After.Atvr, mesh.Stats.Before.Atvr);
+    EXPECT_EQ(TriangleSet(mesh), before);
+
+    const VertexCacheStats measured = MeshOptimizer::AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(),
+                                                                        mesh.Vertices.size());
+    EXPECT_FLOAT_EQ(measured.Acmr, mesh.Stats.After.Acmr);
+}
+
+TEST(MeshOptimizerTest, VertexFetchUsesFirstUseOrderAndDropsUnused)
+{
+    MeshData mesh;
+    for (int i = 0; i < 5; ++i)
+    {
+        Vertex v{};
+        v.Position = glm::vec3(float(i), 0.0f, 0.0f);
+        mesh.Vertices.push_back(v);
+    }
+    mesh.Indices = { 3, 1, 4, 4, 1, 0 };  // vertex 2 is unused
+
+    MeshOptimizer::OptimizeVertexFetch(mesh);
+    ASSERT_EQ(mesh.Vertices.size(), 4u);
+    const std::vector<unsigned int> expected = { 0, 1, 2, 2, 1, 3 };
+    EXPECT_EQ(mesh.Indices, expected);
+    const float order[] = { 3.0f, 1.0f, 4.0f, 0.0f };
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(mesh.Vertices[i].Position.x, order[i]);
+}
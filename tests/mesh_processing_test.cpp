@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/MeshProcessing.h"
+#include "Utility/ThreadPool.h"
+#include <cmath>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    Vertex MakeVertex(const glm::vec3& position, const glm::vec2& uv = glm::vec2(0.0f),
+                      const glm::vec3& normal = glm::vec3(0.0f, 0.0f, 1.0f))
+    {
+        Vertex v{};
+        v.Position  = position;
+        v.Normal    = normal;
+        v.TexCoords = uv;
+        return v;
+    }
+
+    void ExpectNear(const glm::vec3& a, const glm::vec3& b)
+    {
+        EXPECT_NEAR(a.x, b.x, 1e-5f);
+        EXPECT_NEAR(a.y, b.y, 1e-5f);
+        EXPECT_NEAR(a.z, b.z, 1e-5f);
+    }
+
+    // unit quad in z = 0 as two unwelded triangles, UVs equal to xy (optionally mirrored in u)
+    MeshData MakeQuadSoup(float uScale = 1.0f)
+    {
+        const glm::vec3 corners[6] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } };
+        MeshData mesh;
+        for (unsigned int i = 0; i < 6; ++i)
+        {
+            mesh.Vertices.push_back(MakeVertex(corners[i], glm::vec2(corners[i].x * uScale, corners[i].y)));
+            mesh.Indices.push_back(i);
+        }
+        return mesh;
+    }
+}
+
+TEST(MeshProcessingTest, WeldKeepsFirstOccurrenceOrder)
+{
+    MeshData mesh = MakeQuadSoup();
+    ThreadPool pool(3);
+    EXPECT_EQ(MeshProcessing::WeldVertices(mesh, pool), 2u);
+
+    ASSERT_EQ(mesh.Vertices.size(), 4u);
+    EXPECT_EQ(mesh.Vertices[3].Position, glm::vec3(0.0f, 1.0f, 0.0f));
+    const std::vector<unsigned int> expected = { 0, 1, 2, 0, 2, 3 };
+    EXPECT_EQ(mesh.Indices, expected);
+
+    // corners that differ in any attribute stay apart
+    MeshData seams = MakeQuadSoup();
+    seams.Vertices[3].TexCoords = glm::vec2(0.5f);
+    EXPECT_EQ(MeshProcessing::WeldVertices(seams, pool), 1u);
+}
+
+TEST(MeshProcessingTest, NormalsAreAngleWeightedAcrossSplitVertices)
+{
+    // three right-angled triangles of very different areas meet at the origin;
+    // each origin corner has its own UV, so only the position ties them together
+    const glm::vec3 x(1, 0, 0), y(0, 1, 0), z(0, 0, 1);
+    const glm::vec3 triangles[3][3] = {
+        { glm::vec3(0.0f), x,        y        },  // +z
+        { glm::vec3(0.0f), y * 2.0f, z * 2.0f },  // +x
+        { glm::vec3(0.0f), z,        x * 3.0f },  // +y
+    };
+    MeshData mesh;
+    for (int t = 0; t < 3; ++t)
+        for (int k = 0; k < 3; ++k)
+        {
+            mesh.Vertices.push_back(MakeVertex(triangles[t][k], glm::vec2(float(t), 0.0f), glm::vec3(0.0f)));
+            mesh.Indices.push_back(static_cast<unsigned int>(mesh.Indices.size()));
+        }
+
+    ThreadPool pool(2);
+    MeshProcessing::GenerateNormals(mesh, pool);
+    const glm::vec3 expected = glm::normalize(glm::vec3(1.0f));
+    for (int t = 0; t < 3; ++t)
+        ExpectNear(mesh.Vertices[t * 3].Normal, expected);
+    ExpectNear(mesh.Vertices[1].Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+TEST(MeshProcessingTest, TangentsFollowUVsAndMirroring)
+{
+    ThreadPool pool(0);
+
+    MeshData mesh = MakeQuadSoup();
+    MeshProcessing::GenerateTangents(mesh, pool);
+    for (const Vertex& v : mesh.Vertices)
+    {
+        ExpectNear(v.Tangent, glm::vec3(1.0f, 0.0f, 0.0f));
+        ExpectNear(v.Bitangent, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    // u runs against x: the tangent flips, the bitangent keeps following v
+    MeshData mirrored = MakeQuadSoup(-1.0f);
+    MeshProcessing::GenerateTangents(mirrored, pool);
+    for (const Vertex& v : mirrored.Vertices)
+    {
+        ExpectNear(v.Tangent, glm::vec3(-1.0f, 0.0f, 0.0f));
+        ExpectNear(v.Bitangent, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+}
+
+TEST(MeshProcessingTest, SplitPartsFitAndKeepEveryTriangle)
+{
+    // a 20x20 grid, split with at most 40 vertices per part
+    MeshData mesh;
+    mesh.Name = "grid";
+    mesh.MaterialIndex = 3;
+    const unsigned int side = 21;
+    for (unsigned int y = 0; y < side; ++y)
+        for (unsigned int x = 0; x < side; ++x)
+            mesh.Vertices.push_back(MakeVertex(glm::vec3(float(x), float(y), 0.0f)));
+    for (unsigned int y = 0; y + 1 < side; ++y)
+        for (unsigned int x = 0; x + 1 < side; ++x)
+        {
+            const unsigned int i = y * side + x;
+            mesh.Indices.insert(mesh.Indices.end(), { i, i + 1, i + side, i + 1, i + side + 1, i + side });
+        }
+    const MeshData source = mesh;
+
+    const std::vector<MeshData> parts = MeshProcessing::SplitMesh(std::move(mesh), 40);
+    ASSERT_GT(parts.size(), 1u);
+    EXPECT_EQ(parts[1].Name, "grid_1");
+    std::size_t corner = 0;
+    for (const MeshData& part : parts)
+    {
+        EXPECT_LE(part.Vertices.size(), 40u);
+        EXPECT_EQ(part.MaterialIndex, 3u);
+        // triangles come out in order, so the corners line up with the source's
+        for (unsigned int index : part.Indices)
+        {
+            ASSERT_LT(index, part.Vertices.size());
+            EXPECT_EQ(part.Vertices[index].Position, source.Vertices[source.Indices[corner++]].Position);
+        }
+    }
+    EXPECT_EQ(corner, source.Indices.size());
+
+    // a mesh under the limit passes through whole
+    MeshData small = source;
+    EXPECT_EQ(MeshProcessing::SplitMesh(std::move(small)).size(), 1u);
+}
+
+TEST(MeshProcessingTest, IndicesNarrowOnlyWhenTheVerticesFit)
+{
+    const std::vector<unsigned int> indices = { 0, 65535, 7 };
+    std::vector<std::uint16_t> narrow;
+    ASSERT_TRUE(MeshProcessing::NarrowIndices(indices.data(), indices.size(), 65536, narrow));
+    EXPECT_EQ(narrow, (std::vector<std::uint16_t>{ 0, 65535, 7 }));
+    EXPECT_FALSE(MeshProcessing::NarrowIndices(indices.data(), indices.size(), 65537, narrow));
+    EXPECT_FALSE(MeshProcessing::NarrowIndices(indices.data(), 0, 3, narrow));
+}
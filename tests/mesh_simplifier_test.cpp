@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/MeshSimplifier.h"
+#include "test_meshes.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    // area-weighted normal sum, to check nothing was flipped
+    glm::vec3 NormalSum(const MeshData& mesh, const std::vector<unsigned int>& indices)
+    {
+        glm::vec3 sum(0.0f);
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            const glm::vec3& p0 = mesh.Vertices[indices[i]].Position;
+            sum += glm::cross(mesh.Vertices[indices[i + 1]].Position - p0, mesh.Vertices[indices[i + 2]].Position - p0);
+        }
+        return sum;
+    }
+}
+
+TEST(MeshSimplifierTest, FlatGridCollapsesToTargetAndKeepsItsBorder)
+{
+    const MeshData mesh = MakeGrid(32);
+    float error = -1.0f;
+    const std::vector<unsigned int> simplified = MeshSimplifier::Simplify(mesh.Vertices.data(), mesh.Vertices.size(),
+                                                                          mesh.Indices.data(), mesh.Indices.size(),
+                                                                          mesh.Indices.size() / 4, 0.01f, &error);
+
+    EXPECT_LE(simplified.size(), mesh.Indices.size() / 4);
+    EXPECT_GT(simplified.size(), 0u);
+    EXPECT_NEAR(error, 0.0f, 1e-5f);
+
+    // still covers the whole square, facing +Z
+    const glm::vec3 normal = NormalSum(mesh, simplified);
+    EXPECT_NEAR(normal.z, 2.0f * 1.0f, 1e-3f);
+
+    // border vertices never move, so every one of the four corners is still used
+    for (unsigned int corner : { 0u, 32u, 33u * 32u, 33u * 33u - 1u })
+        EXPECT_NE(std::find(simplified.begin(), simplified.end(), corner), simplified.end()) << corner;
+}
+
+TEST(MeshSimplifierTest, ErrorBoundStopsCollapsesOnCurvedSurfaces)
+{
+    const MeshData mesh = MakeGrid(32, [](float u, float w) { return 0.2f * std::sin(u * 12.0f) * std::cos(w * 12.0f); });
+    float error = 0.0f;
+    const std::vector<unsigned int> simplified = MeshSimplifier::Simplify(mesh.Vertices.data(), mesh.Vertices.size(),
+                                                                          mesh.Indices.data(), mesh.Indices.size(),
+                                                                          0, 1e-4f, &error);
+
+    EXPECT_LE(error, 1e-4f);
+    EXPECT_GT(simplified.size(), mesh.Indices.size() / 2);
+}
+
+TEST(MeshSimplifierTest, LodChainHalvesWithGrowingError)
+{
+    const MeshData mesh = MakeGrid(96, [](float u, float w) { return 0.02f * std::sin(u * 6.0f) * std::cos(w * 6.0f); });
+    const std::vector<MeshLod> lods = MeshSimplifier::BuildLodChain(mesh);
+
+    ASSERT_FALSE(lods.empty());
+    EXPECT_LE(lods.size(), MeshSimplifier::kMaxLodLevels);
+    std::size_t previousCount = mesh.Indices.size();
+    float previousError = 0.0f;
+    for (const MeshLod& lod : lods)
+    {
+        EXPECT_LE(lod.Indices.size(), previousCount * 3 / 4);
+        EXPECT_GE(lod.Indices.size() / 3, MeshSimplifier::kMinLodTriangles);
+        EXPECT_GE(lod.Error, previousError);
+        for (unsigned int index : lod.Indices)
+            ASSERT_LT(index, mesh.Vertices.size());
+        EXPECT_GT(NormalSum(mesh, lod.Indices).z, 0.9f);
+        previousCount = lod.Indices.size();
+        previousError = lod.Error;
+    }
+    EXPECT_LE(lods.back().Error, std::sqrt(2.0f) * MeshSimplifier::kMaxLodError * 1.01f + 0.01f);
+
+    // small meshes are left alone
+    EXPECT_TRUE(MeshSimplifier::BuildLodChain(MakeGrid(8)).empty());
+}
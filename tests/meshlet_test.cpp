@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/MeshletBuilder.h"
+#include "Engine/Graphics/ClusterCuller.h"
+#include "Utility/ThreadPool.h"
+#include "test_meshes.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <unordered_set>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    // a cells x cells grid over [-1, 1]^2 in z = 0, facing +Z
+    MeshData MakeCenteredGrid(unsigned int cells)
+    {
+        return MakeGrid(cells, glm::vec2(-1.0f), glm::vec2(1.0f));
+    }
+
+    ClusterCullJob MakeJob(const std::vector<Meshlet>& meshlets, const glm::vec3& camera, const glm::vec3& target,
+                           std::vector<IndexRange>& visible)
+    {
+        const glm::mat4 view = glm::lookAt(camera, target, glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+        return { &meshlets, projection * view, camera, true, &visible };
+    }
+}
+
+TEST(MeshletTest, MeshletsCoverTheIndicesWithinLimits)
+{
+    const MeshData mesh = MakeCenteredGrid(128);
+    const std::vector<Meshlet> meshlets = MeshletBuilder::Build(mesh);
+    ASSERT_FALSE(meshlets.empty());
+
+    unsigned int next = 0;
+    for (const Meshlet& meshlet : meshlets)
+    {
+        EXPECT_EQ(meshlet.FirstIndex, next);
+        EXPECT_LE(meshlet.IndexCount / 3, MeshletBuilder::kMaxTriangles);
+        next += meshlet.IndexCount;
+
+        std::unordered_set<unsigned int> vertices(mesh.Indices.begin() + meshlet.FirstIndex,
+                                                  mesh.Indices.begin() + meshlet.FirstIndex + meshlet.IndexCount);
+        EXPECT_LE(vertices.size(), MeshletBuilder::kMaxVertices);
+        for (unsigned int v : vertices)
+            EXPECT_LE(glm::length(mesh.Vertices[v].Position - meshlet.Center), meshlet.Radius * 1.0001f + 1e-6f);
+
+        // a flat grid gives the tightest cone there is
+        EXPECT_NEAR(meshlet.ConeAxis.z, 1.0f, 1e-4f);
+        EXPECT_LT(meshlet.ConeCutoff, 0.01f);
+    }
+    EXPECT_EQ(next, mesh.Indices.size());
+
+    // small meshes are drawn whole
+    EXPECT_TRUE(MeshletBuilder::Build(MakeCenteredGrid(16)).empty());
+}
+
+TEST(MeshletTest, SharpTurnsStartANewMeshlet)
+{
+    // two triangles facing +Z, then two facing -Z
+    MeshData mesh;
+    for (const glm::vec3& p : { glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(1, 1, 0), glm::vec3(0, 1, 0) })
+    {
+        Vertex v{};
+        v.Position = p;
+        mesh.Vertices.push_back(v);
+    }
+    mesh.Indices = { 0, 1, 2, 0, 2, 3, 2, 1, 0, 3, 2, 0 };
+    const std::vector<Meshlet> meshlets = MeshletBuilder::Build(mesh.Vertices.data(), mesh.Vertices.size(),
+                                                                mesh.Indices.data(), mesh.Indices.size());
+    ASSERT_EQ(meshlets.size(), 2u);
+    EXPECT_EQ(meshlets[1].FirstIndex, 6u);
+    EXPECT_NEAR(meshlets[1].ConeAxis.z, -1.0f, 1e-4f);
+}
+
+TEST(MeshletTest, CullerDropsClustersOutsideTheFrustum)
+{
+    const MeshData mesh = MakeCenteredGrid(128);
+    const std::vector<Meshlet> meshlets = MeshletBuilder::Build(mesh);
+    ThreadPool pool(2);
+    std::vector<IndexRange> visible;
+
+    // the whole grid in view: one merged range
+    std::vector<ClusterCullJob> jobs = { MakeJob(meshlets, glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f), visible) };
+    ClusterCullStats stats = ClusterCuller::Run(jobs, pool);
+    EXPECT_EQ(stats.Triangles, mesh.Indices.size() / 3);
+    EXPECT_EQ(stats.FrustumTriangles, 0u);
+    ASSERT_EQ(visible.size(), 1u);
+    EXPECT_EQ(visible[0].IndexCount, mesh.Indices.size());
+
+    // close up on one corner: most of the grid is off screen
+    jobs = { MakeJob(meshlets, glm::vec3(0.8f, 0.8f, 0.3f), glm::vec3(0.8f, 0.8f, 0.0f), visible) };
+    stats = ClusterCuller::Run(jobs, pool);
+    EXPECT_GT(stats.FrustumTriangles, stats.Triangles / 2);
+    std::size_t drawn = 0;
+    for (const IndexRange& range : visible)
+        drawn += range.IndexCount / 3;
+    EXPECT_EQ(drawn, stats.Triangles - stats.FrustumTriangles);
+    EXPECT_EQ(stats.Ranges, visible.size());
+}
+
+TEST(MeshletTest, CullerDropsBackFacingClustersOnlyWhenAsked)
+{
+    const MeshData mesh = MakeCenteredGrid(128);
+    const std::vector<Meshlet> meshlets = MeshletBuilder::Build(mesh);
+    ThreadPool pool(2);
+    std::vector<IndexRange> visible;
+    std::vector<ClusterCullJob> jobs = { MakeJob(meshlets, glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f), visible) };
+
+    ClusterCuller::GetSettings().Backfaces = false;
+    ClusterCullStats stats = ClusterCuller::Run(jobs, pool);
+    EXPECT_EQ(stats.BackfaceTriangles, stats.Triangles);
+    EXPECT_EQ(stats.VisibleClusters, meshlets.size());
+
+    ClusterCuller::GetSettings().Backfaces = true;
+    stats = ClusterCuller::Run(jobs, pool);
+    EXPECT_EQ(stats.VisibleClusters, 0u);
+    EXPECT_TRUE(visible.empty());
+
+    // seen from the front nothing faces away
+    jobs = { MakeJob(meshlets, glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f), visible) };
+    stats = ClusterCuller::Run(jobs, pool);
+    EXPECT_EQ(stats.BackfaceTriangles, 0u);
+    ClusterCuller::GetSettings() = ClusterCullSettings{};
+
+    EXPECT_TRUE(ClusterCuller::KeepsAngles(glm::scale(glm::rotate(glm::mat4(1.0f), 0.7f, glm::vec3(0, 1, 0)), glm::vec3(3.0f))));
+    EXPECT_FALSE(ClusterCuller::KeepsAngles(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 1.0f))));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/ModelManager.h"
+
+using namespace isaacObjectViewer;
+
+TEST(ModelManagerTest, IdenticalMaterialsAreMerged)
+{
+    ImportedScene scene;
+    MaterialData red;
+    red.DiffuseColor = glm::vec3(1.0f, 0.0f, 0.0f);
+    MaterialData textured = red;
+    textured.Textures.push_back({ "bolt.png", TextureType::DIFFUSE });
+    textured.DiffuseMap = "bolt.png";
+    scene.Materials = { red, textured, red, textured, red };
+
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        MeshData mesh;
+        mesh.MaterialIndex = i;
+        scene.Meshes.push_back(mesh);
+    }
+    MeshStreams streams;
+    streams.MaterialIndex = 3;
+    scene.StreamMeshes.push_back(streams);
+
+    EXPECT_EQ(ModelManager::DeduplicateMaterials(scene), 3u);
+    ASSERT_EQ(scene.Materials.size(), 2u);
+    EXPECT_EQ(scene.Materials[1].DiffuseMap, "bolt.png");
+    const unsigned int expected[] = { 0, 1, 0, 1, 0 };
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(scene.Meshes[i].MaterialIndex, expected[i]);
+    EXPECT_EQ(scene.StreamMeshes[0].MaterialIndex, 1u);
+
+    // nothing left to merge
+    EXPECT_EQ(ModelManager::DeduplicateMaterials(scene), 0u);
+}
+
+TEST(ModelManagerTest, SplitMeshesKeepTheirNodes)
+{
+    // mesh 0 needs two parts, mesh 1 fits; the stream mesh is numbered after both
+    ImportedScene scene;
+    MeshData large;
+    for (unsigned int i = 0; i < MeshProcessing::kMaxShortIndexVertices + 3; ++i)
+    {
+        Vertex v{};
+        v.Position = glm::vec3(float(i), 0.0f, 0.0f);
+        large.Vertices.push_back(v);
+        if (i % 3 == 2)
+            large.Indices.insert(large.Indices.end(), { i - 2, i - 1, i });
+    }
+    MeshData small;
+    small.Vertices.resize(3);
+    small.Indices = { 0, 1, 2 };
+    scene.Meshes = { large, small };
+    scene.StreamMeshes.emplace_back();
+    scene.Nodes.resize(2);
+    scene.Nodes[0].Meshes = { 0, 2 };
+    scene.Nodes[1].Parent = 0;
+    scene.Nodes[1].Meshes = { 1, 0 };
+
+    ThreadPool pool(2);
+    EXPECT_EQ(ModelManager::SplitForShortIndices(scene, pool), 1u);
+    ASSERT_EQ(scene.Meshes.size(), 3u);
+    EXPECT_LE(scene.Meshes[0].Vertices.size(), MeshProcessing::kMaxShortIndexVertices);
+    EXPECT_EQ(scene.Meshes[1].Vertices.size(), 3u);
+    EXPECT_EQ(scene.Meshes[2].Indices, (std::vector<unsigned int>{ 0, 1, 2 }));
+    EXPECT_EQ(scene.Nodes[0].Meshes, (std::vector<unsigned int>{ 0, 1, 3 }));
+    EXPECT_EQ(scene.Nodes[1].Meshes, (std::vector<unsigned int>{ 2, 0, 1 }));
+}
+
+TEST(ModelManagerTest, LodsSkipSmallAndBatchedMeshes)
+{
+    // a flat 64 x 64 grid (8192 triangles) collapses freely
+    MeshData grid;
+    const unsigned int cells = 64;
+    for (unsigned int y = 0; y <= cells; ++y)
+        for (unsigned int x = 0; x <= cells; ++x)
+        {
+            Vertex v{};
+            v.Position = glm::vec3(float(x), float(y), 0.0f);
+            grid.Vertices.push_back(v);
+        }
+    for (unsigned int y = 0; y < cells; ++y)
+        for (unsigned int x = 0; x < cells; ++x)
+        {
+            const unsigned int i = y * (cells + 1) + x;
+            grid.Indices.insert(grid.Indices.end(), { i, i + 1, i + cells + 2, i, i + cells + 2, i + cells + 1 });
+        }
+    MeshData batched = grid;
+    MeshPart part;
+    part.IndexCount = static_cast<unsigned int>(grid.Indices.size());
+    batched.Parts.push_back(part);
+    MeshData small;
+    small.Vertices.resize(3);
+    small.Indices = { 0, 1, 2 };
+
+    ImportedScene scene;
+    scene.Meshes = { grid, batched, small };
+    ThreadPool pool(2);
+    const std::size_t levels = ModelManager::GenerateLods(scene, pool);
+    EXPECT_GT(levels, 0u);
+    EXPECT_EQ(scene.Meshes[0].Lods.size(), levels);
+    EXPECT_TRUE(scene.Meshes[1].Lods.empty());
+    EXPECT_TRUE(scene.Meshes[2].Lods.empty());
+    EXPECT_LT(scene.Meshes[0].Lods.front().Indices.size(), grid.Indices.size());
+}
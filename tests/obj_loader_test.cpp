@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/ObjLoader.h"
+#include "Utility/ThreadPool.h"
+#include <string>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    std::unique_ptr<ImportedScene> LoadText(const std::string& text, unsigned int threads = 0)
+    {
+        ThreadPool pool(threads);
+        return ObjLoader::LoadFromMemory(text.data(), text.size(), ".", pool);
+    }
+}
+
+TEST(ObjLoaderTest, WeldsSharedCornersAndTriangulatesQuads)
+{
+    const std::string obj =
+        "# unit quad\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\r\n";
+
+    auto scene = LoadText(obj);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+
+    const MeshData& mesh = scene->Meshes[0];
+    EXPECT_EQ(mesh.Vertices.size(), 4u);
+    ASSERT_EQ(mesh.Indices.size(), 6u);
+    EXPECT_EQ(mesh.Vertices[mesh.Indices[2]].Position, glm::vec3(1.0f, 1.0f, 0.0f));
+    // FlipUVs, like the Assimp path
+    EXPECT_EQ(mesh.Vertices[mesh.Indices[0]].TexCoords, glm::vec2(0.0f, 1.0f));
+    EXPECT_EQ(mesh.Vertices[mesh.Indices[0]].Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+TEST(ObjLoaderTest, SplitsOnMaterialAndResolvesRelativeIndices)
+{
+    const std::string obj =
+        "o first\n"
+        "usemtl red\n"
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f -3 -2 -1\n"
+        "usemtl blue\n"
+        "v 0 0 1\nv 1 0 1\nv 0 1 1\n"
+        "f -3 -2 -1\n"
+        "f 1 2 3\n";
+
+    auto scene = LoadText(obj);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 2u);
+
+    const MeshData& second = scene->Meshes[1];
+    EXPECT_EQ(second.Name, "first");
+    EXPECT_EQ(second.Vertices.size(), 6u);
+    EXPECT_EQ(second.Vertices[second.Indices[0]].Position, glm::vec3(0.0f, 0.0f, 1.0f));
+    EXPECT_EQ(second.Vertices[second.Indices[3]].Position, glm::vec3(0.0f, 0.0f, 0.0f));
+    // no vn: smooth normals are generated
+    EXPECT_NEAR(second.Vertices[0].Normal.z, 1.0f, 1e-5f);
+}
+
+TEST(ObjLoaderTest, ParallelWeldMatchesSerial)
+{
+    // a grid big enough to take the partitioned weld path
+    const int n = 400;
+    std::string obj;
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            obj += "v " + std::to_string(x) + " " + std::to_string(y) + " 0\n";
+    for (int y = 0; y < n; ++y)
+        for (int x = 0; x < n; ++x)
+        {
+            const int i = y * (n + 1) + x + 1;
+            obj += "f " + std::to_string(i) + " " + std::to_string(i + 1) + " " +
+                   std::to_string(i + n + 2) + " " + std::to_string(i + n + 1) + "\n";
+        }
+
+    auto serial   = LoadText(obj, 0);
+    auto parallel = LoadText(obj, 3);
+    ASSERT_NE(serial, nullptr);
+    ASSERT_NE(parallel, nullptr);
+    ASSERT_EQ(parallel->Meshes.size(), 1u);
+
+    const MeshData& a = serial->Meshes[0];
+    const MeshData& b = parallel->Meshes[0];
+    EXPECT_EQ(a.Vertices.size(), std::size_t((n + 1) * (n + 1)));
+    EXPECT_EQ(b.Vertices.size(), a.Vertices.size());
+    ASSERT_EQ(b.Indices.size(), a.Indices.size());
+    for (std::size_t i = 0; i < a.Indices.size(); ++i)
+        ASSERT_EQ(b.Vertices[b.Indices[i]].Position, a.Vertices[a.Indices[i]].Position) << "corner " << i;
+}
+
+TEST(ObjLoaderTest, GeneratesNormalsOnlyWhereMissing)
+{
+    // one triangle with a (deliberately tilted) vn, one without; they share positions 1 and 3
+    const std::string obj =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vn 1 0 0\n"
+        "f 1//1 2//1 3//1\n"
+        "f 1 3 4\n";
+
+    auto scene = LoadText(obj, 3);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+
+    const MeshData& mesh = scene->Meshes[0];
+    ASSERT_EQ(mesh.Indices.size(), 6u);
+    for (int k = 0; k < 3; ++k)
+        EXPECT_EQ(mesh.Vertices[mesh.Indices[k]].Normal, glm::vec3(1.0f, 0.0f, 0.0f));
+    for (int k = 3; k < 6; ++k)
+        EXPECT_NEAR(mesh.Vertices[mesh.Indices[k]].Normal.z, 1.0f, 1e-5f);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/StlLoader.h"
+#include "Engine/Graphics/PlyLoader.h"
+#include "Engine/Graphics/MeshProcessing.h"
+#include "Utility/ThreadPool.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    template <typename T>
+    void Append(std::vector<unsigned char>& out, T value)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void AppendBigEndian(std::vector<unsigned char>& out, T value)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (std::size_t i = sizeof(T); i > 0; --i)
+            out.push_back(bytes[i - 1]);
+    }
+
+    // two triangles of a unit quad in z = 0, the first corner of the second one written as -0
+    std::vector<unsigned char> MakeBinaryStl()
+    {
+        const float triangles[2][9] = {
+            { 0, 0, 0,   1, 0, 0,   1, 1, 0 },
+            { -0.0f, 0, 0,   1, 1, 0,   0, 1, 0 },
+        };
+        std::vector<unsigned char> stl(80, 0);
+        std::memcpy(stl.data(), "solid but actually binary", 25);
+        Append<std::uint32_t>(stl, 2);
+        for (const auto& triangle : triangles)
+        {
+            for (int c = 0; c < 3; ++c)
+                Append(stl, 0.0f);
+            for (float value : triangle)
+                Append(stl, value);
+            Append<std::uint16_t>(stl, 0);
+        }
+        return stl;
+    }
+}
+
+TEST(StlLoaderTest, BinaryTrianglesAreWeldedWithSmoothNormals)
+{
+    const std::vector<unsigned char> stl = MakeBinaryStl();
+    ThreadPool pool(2);
+    auto scene = StlLoader::LoadFromMemory(stl.data(), stl.size(), "quad", pool);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+    ASSERT_EQ(scene->Materials.size(), 1u);
+
+    const MeshData& mesh = scene->Meshes[0];
+    EXPECT_EQ(mesh.Vertices.size(), 4u);
+    ASSERT_EQ(mesh.Indices.size(), 6u);
+    EXPECT_EQ(mesh.Indices[0], mesh.Indices[3]);
+    EXPECT_EQ(mesh.Vertices[mesh.Indices[5]].Position, glm::vec3(0.0f, 1.0f, 0.0f));
+    for (const Vertex& vertex : mesh.Vertices)
+        EXPECT_EQ(vertex.Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+TEST(StlLoaderTest, AsciiFacetsAreParsed)
+{
+    const std::string stl =
+        "solid tri\n"
+        " facet normal 0 0 1\n  outer loop\n"
+        "   vertex 0 0 0\n   vertex 1 0 0\n   vertex 0 1 0\n"
+        "  endloop\n endfacet\n"
+        "endsolid tri\n";
+    ThreadPool pool(0);
+    auto scene = StlLoader::LoadFromMemory(reinterpret_cast<const unsigned char*>(stl.data()), stl.size(), "tri", pool);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+    EXPECT_EQ(scene->Meshes[0].Vertices.size(), 3u);
+    EXPECT_EQ(scene->Meshes[0].Vertices[scene->Meshes[0].Indices[1]].Position, glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST(PlyLoaderTest, BinaryBigEndianWithExtraPropertiesAndQuads)
+{
+    const std::string header =
+        "ply\n"
+        "format binary_big_endian 1.0\n"
+        "comment written by hand\n"
+        "element vertex 4\n"
+        "property float x\nproperty float y\nproperty float z\n"
+        "property uchar red\n"
+        "property float u\nproperty float v\n"
+        "element face 1\n"
+        "property list uchar int vertex_indices\n"
+        "property uchar flags\n"
+        "end_header\n";
+    std::vector<unsigned char> ply(header.begin(), header.end());
+
+    const float corners[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    for (const auto& corner : corners)
+    {
+        AppendBigEndian(ply, corner[0]);
+        AppendBigEndian(ply, corner[1]);
+        AppendBigEndian(ply, 0.0f);
+        ply.push_back(255);
+        AppendBigEndian(ply, corner[0]);
+        AppendBigEndian(ply, corner[1]);
+    }
+    ply.push_back(4);
+    for (std::int32_t index : { 0, 1, 2, 3 })
+        AppendBigEndian(ply, index);
+    ply.push_back(0);
+
+    ThreadPool pool(2);
+    auto scene = PlyLoader::LoadFromMemory(ply.data(), ply.size(), "quad", pool);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+
+    const MeshData& mesh = scene->Meshes[0];
+    EXPECT_EQ(mesh.Vertices.size(), 4u);
+    ASSERT_EQ(mesh.Indices.size(), 6u);
+    EXPECT_EQ(mesh.Vertices[2].Position, glm::vec3(1.0f, 1.0f, 0.0f));
+    // v is flipped, like the other loaders
+    EXPECT_EQ(mesh.Vertices[2].TexCoords, glm::vec2(1.0f, 0.0f));
+    EXPECT_EQ(mesh.Vertices[0].Normal, glm::vec3(0.0f, 0.0f, 1.0f));
+}
+
+TEST(PlyLoaderTest, AsciiDropsOutOfRangeFaces)
+{
+    const std::string ply =
+        "ply\r\n"
+        "format ascii 1.0\r\n"
+        "element vertex 3\r\n"
+        "property double x\r\nproperty double y\r\nproperty double z\r\n"
+        "property float nx\r\nproperty float ny\r\nproperty float nz\r\n"
+        "element face 2\r\n"
+        "property list uchar uint vertex_index\r\n"
+        "end_header\r\n"
+        "0 0 0 0 0 1\r\n1 0 0 0 0 1\r\n0 1 0 0 0 1\r\n"
+        "3 0 1 2\r\n3 0 1 7\r\n";
+    ThreadPool pool(0);
+    auto scene = PlyLoader::LoadFromMemory(reinterpret_cast<const unsigned char*>(ply.data()), ply.size(), "tri", pool);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->Meshes.size(), 1u);
+    EXPECT_EQ(scene->Meshes[0].Indices.size(), 3u);
+    EXPECT_EQ(scene->Meshes[0].Vertices[1].Position, glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST(PlyLoaderTest, OverstatedCountsFailWithoutAllocating)
+{
+    // headers claiming far more records than the file holds must be rejected before anything is sized by them
+    const std::string vertexCount =
+        "ply\nformat binary_little_endian 1.0\n"
+        "element vertex 4000000000000\nproperty float x\nproperty float y\nproperty float z\n"
+        "end_header\n";
+    const std::string faceCount =
+        "ply\nformat binary_little_endian 1.0\n"
+        "element vertex 0\nproperty float x\nproperty float y\nproperty float z\n"
+        "element face 4000000000000\nproperty list uchar int vertex_indices\nproperty list uchar float texcoord\n"
+        "end_header\n";
+    const std::string asciiCount =
+        "ply\nformat ascii 1.0\n"
+        "element vertex 4000000000000\nproperty float x\nproperty float y\nproperty float z\n"
+        "end_header\n0 0 0\n";
+    const std::string asciiList =
+        "ply\nformat ascii 1.0\n"
+        "element vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+        "element face 1\nproperty list uint uint vertex_indices\n"
+        "end_header\n0 0 0\n1 0 0\n0 1 0\n4000000000 0 1 2\n";
+
+    ThreadPool pool(2);
+    for (const std::string* ply : { &vertexCount, &faceCount, &asciiCount, &asciiList })
+    {
+        ImportProgress progress;
+        auto scene = PlyLoader::LoadFromMemory(reinterpret_cast<const unsigned char*>(ply->data()), ply->size(), "bad", pool, &progress);
+        EXPECT_EQ(scene, nullptr);
+        EXPECT_EQ(progress.Stage.load(), ImportStage::Failed);
+    }
+}
+
+TEST(MeshProcessingTest, LargeMeshesAreSplitIntoCompactedParts)
+{
+    // a strip of 10 triangles over 12 vertices, split with at most 6 vertices per part
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < 12; ++i)
+        positions.emplace_back(float(i / 2), float(i % 2), 0.0f);
+    std::vector<unsigned int> indices;
+    for (unsigned int i = 0; i + 2 < 12; ++i)
+        indices.insert(indices.end(), { i, i + 1, i + 2 });
+
+    ThreadPool pool(2);
+    const std::vector<MeshData> parts =
+        MeshProcessing::BuildMeshes("strip", positions.data(), nullptr, nullptr, positions.size(), std::move(indices), pool, 6);
+    ASSERT_EQ(parts.size(), 5u);
+    EXPECT_EQ(parts[0].Name, "strip_0");
+    for (std::size_t p = 0; p < parts.size(); ++p)
+    {
+        EXPECT_LE(parts[p].Vertices.size(), 6u);
+        ASSERT_EQ(parts[p].Indices.size(), 6u);
+        // the first corner of part p is vertex 2p of the strip
+        EXPECT_EQ(parts[p].Vertices[parts[p].Indices[0]].Position, positions[p * 2]);
+    }
+}
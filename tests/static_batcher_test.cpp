@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/StaticBatcher.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace isaacObjectViewer;
+
+static MeshData Triangle(const std::string& name, unsigned int material)
+{
+    MeshData mesh;
+    mesh.Name = name;
+    mesh.MaterialIndex = material;
+    mesh.Vertices.resize(3);
+    mesh.Vertices[0].Position = { 0.0f, 0.0f, 0.0f };
+    mesh.Vertices[1].Position = { 1.0f, 0.0f, 0.0f };
+    mesh.Vertices[2].Position = { 0.0f, 1.0f, 0.0f };
+    for (Vertex& v : mesh.Vertices)
+        v.Normal = { 0.0f, 0.0f, 1.0f };
+    mesh.Indices = { 0, 1, 2 };
+    return mesh;
+}
+
+static SceneNode Node(const glm::mat4& transform, std::vector<unsigned int> meshes)
+{
+    SceneNode node;
+    node.Transform = transform;
+    node.Meshes    = std::move(meshes);
+    return node;
+}
+
+TEST(StaticBatcherTest, MergesOncePlacedMeshesPerMaterial)
+{
+    ImportedScene scene;
+    scene.Meshes.push_back(Triangle("a", 0));
+    scene.Meshes.push_back(Triangle("bolt", 0));   // placed twice: stays instanced
+    scene.Meshes.push_back(Triangle("b", 0));
+    scene.Meshes.push_back(Triangle("other", 1));  // the only mesh of its material
+    scene.StreamMeshes.resize(1);
+
+    const glm::mat4 moved    = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f));
+    const glm::mat4 mirrored = glm::scale(glm::mat4(1.0f), glm::vec3(-1.0f, 1.0f, 1.0f));
+    scene.Nodes.push_back(Node(glm::mat4(1.0f), { 0, 1, 4 }));
+    scene.Nodes.push_back(Node(moved, { 1, 3 }));
+    scene.Nodes.push_back(Node(mirrored, { 2 }));
+    scene.Nodes[1].Parent = scene.Nodes[2].Parent = 0;
+
+    const StaticBatchStats stats = StaticBatcher::Batch(scene);
+    EXPECT_EQ(stats.Batches, 1u);
+    EXPECT_EQ(stats.MeshesMerged, 2u);
+    ASSERT_EQ(scene.Meshes.size(), 3u);
+
+    // the batch takes the first part's place; the others keep their order
+    const MeshData& batch = scene.Meshes[0];
+    EXPECT_EQ(scene.Meshes[1].Name, "bolt");
+    EXPECT_EQ(scene.Meshes[2].Name, "other");
+    ASSERT_EQ(batch.Parts.size(), 2u);
+    EXPECT_EQ(batch.Parts[0].Name, "a");
+    EXPECT_EQ(batch.Parts[1].Name, "b");
+    EXPECT_EQ(batch.Parts[1].FirstIndex, 3u);
+    EXPECT_EQ(batch.Parts[1].IndexCount, 3u);
+
+    // the mirrored part is in model space and still wound the same way
+    EXPECT_FLOAT_EQ(batch.Vertices[4].Position.x, -1.0f);
+    EXPECT_FLOAT_EQ(batch.Parts[1].BBoxMin.x, -1.0f);
+    const std::vector<unsigned int> expected = { 0, 1, 2, 3, 5, 4 };
+    EXPECT_EQ(batch.Indices, expected);
+
+    // merged meshes leave their nodes; stream meshes follow the new mesh count
+    EXPECT_EQ(scene.Nodes[0].Meshes, (std::vector<unsigned int>{ 1, 3 }));
+    EXPECT_EQ(scene.Nodes[1].Meshes, (std::vector<unsigned int>{ 1, 2 }));
+    EXPECT_TRUE(scene.Nodes[2].Meshes.empty());
+    ASSERT_EQ(scene.Nodes.size(), 4u);
+    EXPECT_EQ(scene.Nodes[3].Meshes, (std::vector<unsigned int>{ 0 }));
+    EXPECT_EQ(scene.Nodes[3].Transform, glm::mat4(1.0f));
+}
+
+TEST(StaticBatcherTest, WithoutNodesEveryMeshIsStatic)
+{
+    ImportedScene scene;
+    for (int i = 0; i < 4; ++i)
+        scene.Meshes.push_back(Triangle("part" + std::to_string(i), 0));
+    scene.Meshes.push_back(Triangle("large", 0));
+    scene.Meshes.back().Vertices.resize(StaticBatcher::kMaxPartVertices + 1);
+
+    const StaticBatchStats stats = StaticBatcher::Batch(scene);
+    EXPECT_EQ(stats.MeshesBefore, 5u);
+    EXPECT_EQ(stats.MeshesAfter, 2u);
+    ASSERT_EQ(scene.Meshes.size(), 2u);
+    EXPECT_EQ(scene.Meshes[0].Parts.size(), 4u);
+    EXPECT_EQ(scene.Meshes[0].Vertices.size(), 12u);
+    EXPECT_EQ(scene.Meshes[1].Name, "large");
+    EXPECT_TRUE(scene.Nodes.empty());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/SyntheticAsset.h"
+#include "Engine/Graphics/ObjLoader.h"
+#include "Engine/Graphics/PlyLoader.h"
+#include "Engine/Graphics/GltfLoader.h"
+#include "Utility/ThreadPool.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    std::string TempPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / "iov_synthetic_asset_test" / name).string();
+    }
+
+    std::string ReadAll(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    std::size_t CountTriangles(const ImportedScene& scene)
+    {
+        std::size_t triangles = 0;
+        for (const MeshData& mesh : scene.Meshes)
+            triangles += mesh.Indices.size() / 3;
+        for (const MeshStreams& mesh : scene.StreamMeshes)
+            triangles += mesh.IndexCount / 3;
+        return triangles;
+    }
+
+    SyntheticAssetOptions MakeOptions(SyntheticFormat format)
+    {
+        SyntheticAssetOptions options;
+        options.Format    = format;
+        options.Triangles = 1001; // not a multiple of the mesh count, nor of any row width
+        options.Meshes    = 3;
+        options.Materials = 2;
+        options.Seed      = 7;
+        return options;
+    }
+}
+
+TEST(SyntheticAssetTest, SameSeedGivesIdenticalFiles)
+{
+    SyntheticAssetOptions options = MakeOptions(SyntheticFormat::Gltf);
+    options.TextureSize = 16;
+
+    SyntheticAssetStats first, second;
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("first.gltf"), options, &first));
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("second.gltf"), options, &second));
+    ASSERT_EQ(first.Files.size(), second.Files.size());
+    EXPECT_EQ(first.Files.size(), 4u); // .gltf, .bin and one texture per material
+    for (std::size_t i = 1; i < first.Files.size(); ++i)
+        EXPECT_EQ(ReadAll(first.Files[i]), ReadAll(second.Files[i])) << first.Files[i];
+
+    options.Seed = 8;
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("third.gltf"), options));
+    EXPECT_NE(ReadAll(TempPath("first.bin")), ReadAll(TempPath("third.bin")));
+}
+
+TEST(SyntheticAssetTest, LoadersSeeExactCounts)
+{
+    ThreadPool pool(0);
+
+    SyntheticAssetStats stats;
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("counts.obj"), MakeOptions(SyntheticFormat::Obj), &stats));
+    EXPECT_EQ(stats.Triangles, 1001u);
+    EXPECT_EQ(stats.Meshes, 3u);
+    auto obj = ObjLoader::Load(TempPath("counts.obj"), pool);
+    ASSERT_TRUE(obj);
+    EXPECT_EQ(CountTriangles(*obj), 1001u);
+    EXPECT_EQ(obj->Materials.size(), 2u);
+
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("counts.ply"), MakeOptions(SyntheticFormat::Ply), &stats));
+    auto ply = PlyLoader::Load(TempPath("counts.ply"), pool);
+    ASSERT_TRUE(ply);
+    EXPECT_EQ(CountTriangles(*ply), 1001u);
+
+    // glTF shares each mesh between its placements: geometry once, one node per placement
+    SyntheticAssetOptions options = MakeOptions(SyntheticFormat::Gltf);
+    options.Instances = 4;
+    ASSERT_TRUE(SyntheticAsset::Write(TempPath("counts.gltf"), options, &stats));
+    EXPECT_EQ(stats.DrawnTriangles, 4004u);
+    auto gltf = GltfLoader::Load(TempPath("counts.gltf"), pool);
+    ASSERT_TRUE(gltf);
+    EXPECT_EQ(CountTriangles(*gltf), 1001u);
+    std::size_t placements = 0;
+    for (const SceneNode& node : gltf->Nodes)
+        placements += node.Meshes.size();
+    EXPECT_EQ(placements, 12u);
+
+    std::error_code ec;
+    std::filesystem::remove_all(TempPath(""), ec);
+}
@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
+#include "Utility/Log.hpp"
 
 // Tests entry point
 int main(int argc, char **argv) {
+    Log::Init(); // engine code logs; tests that don't start the Engine still need a logger
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
@@ -0,0 +1,46 @@
+// Meshes shared by the geometry tests.
+
+#pragma once
+
+#include "Engine/Graphics/MeshData.h"
+
+namespace isaacObjectViewer
+{
+    /// @brief A cells x cells grid of quads from min to max, two triangles per quad in row-major order,
+    /// with normals along +Z.
+    /// @param height Gives z for the grid coordinates u, w in [0, 1].
+    template <typename Height>
+    MeshData MakeGrid(unsigned int cells, const glm::vec2& min, const glm::vec2& max, Height height)
+    {
+        MeshData mesh;
+        for (unsigned int y = 0; y <= cells; ++y)
+            for (unsigned int x = 0; x <= cells; ++x)
+            {
+                Vertex v{};
+                const float u = float(x) / float(cells), w = float(y) / float(cells);
+                v.Position = glm::vec3(glm::mix(min, max, glm::vec2(u, w)), height(u, w));
+                v.Normal   = glm::vec3(0.0f, 0.0f, 1.0f);
+                mesh.Vertices.push_back(v);
+            }
+        for (unsigned int y = 0; y < cells; ++y)
+            for (unsigned int x = 0; x < cells; ++x)
+            {
+                const unsigned int i = y * (cells + 1) + x;
+                mesh.Indices.insert(mesh.Indices.end(), { i, i + 1, i + cells + 2, i, i + cells + 2, i + cells + 1 });
+            }
+        return mesh;
+    }
+
+    /// @brief A grid over [0, 1]^2 with z from height(u, w).
+    template <typename Height>
+    MeshData MakeGrid(unsigned int cells, Height height)
+    {
+        return MakeGrid(cells, glm::vec2(0.0f), glm::vec2(1.0f), height);
+    }
+
+    /// @brief A flat grid in z = 0.
+    inline MeshData MakeGrid(unsigned int cells, const glm::vec2& min = glm::vec2(0.0f), const glm::vec2& max = glm::vec2(1.0f))
+    {
+        return MakeGrid(cells, min, max, [](float, float) { return 0.0f; });
+    }
+}
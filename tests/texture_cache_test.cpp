@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/TextureCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    TextureCacheKey MakeKey()
+    {
+        TextureCacheKey key;
+        key.SourceHash    = 0xfeedbeef;
+        key.SourceSize    = 1234;
+        key.EngineVersion = ENGINE_VERSION;
+        return key;
+    }
+
+    std::string TempCachePath()
+    {
+        return (std::filesystem::temp_directory_path() / "iov_texture_cache_test.iovtex").string();
+    }
+}
+
+TEST(TextureCacheTest, RoundTripAndStaleKeys)
+{
+    const unsigned char rgba[] = { 1, 2, 3, 4,  5, 6, 7, 8,  9, 10, 11, 12,  13, 14, 15, 16,  17, 18, 19, 20,  21, 22, 23, 24 };
+    const DecodedImage image = TextureManager::CopyPixels(rgba, 3, 2);
+    const std::string path = TempCachePath();
+    ASSERT_TRUE(TextureCache::Write(path, image, MakeKey()));
+    EXPECT_TRUE(TextureCache::IsCurrent(path, MakeKey()));
+
+    const DecodedImage loaded = TextureCache::Read(path, MakeKey());
+    ASSERT_TRUE(loaded.IsValid());
+    EXPECT_EQ(loaded.Width, 3);
+    EXPECT_EQ(loaded.Height, 2);
+    EXPECT_EQ(loaded.Channels, 4);
+    EXPECT_EQ(std::memcmp(loaded.Pixels.get(), rgba, sizeof(rgba)), 0);
+
+    TextureCacheKey changed = MakeKey();
+    changed.SourceHash ^= 1;
+    EXPECT_FALSE(TextureCache::IsCurrent(path, changed));
+    EXPECT_FALSE(TextureCache::Read(path, changed).IsValid());
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(TextureCache::Read(path, MakeKey()).IsValid());
+    std::filesystem::remove(path);
+}
+
+TEST(TextureCacheTest, KeyFollowsSourceContents)
+{
+    const std::string source = (std::filesystem::temp_directory_path() / "iov_texture_cache_source.png").string();
+    std::ofstream(source, std::ios::binary) << "first";
+    TextureCacheKey first, second;
+    ASSERT_TRUE(TextureCache::MakeKey(source, first));
+    std::ofstream(source, std::ios::binary | std::ios::trunc) << "other";
+    ASSERT_TRUE(TextureCache::MakeKey(source, second));
+    EXPECT_EQ(first.SourceSize, 5u);
+    EXPECT_NE(first.SourceHash, second.SourceHash);
+    std::filesystem::remove(source);
+
+    EXPECT_FALSE(TextureCache::MakeKey(source, first));
+}
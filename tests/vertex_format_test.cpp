@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "Engine/Graphics/VertexFormat.h"
+#include "Engine/Graphics/Buffers/VertexBufferLayout.h"
+#include <glm/gtc/packing.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    struct SkinnedTestVertex
+    {
+        glm::vec3     Position;
+        std::uint16_t Color[4];
+        unsigned int  BoneIDs[4];
+        glm::vec4     Weights;
+    };
+}
+
+template<> struct isaacObjectViewer::VertexLayoutOf<SkinnedTestVertex>
+{
+    static constexpr auto Layout = MakeVertexBufferLayout<SkinnedTestVertex>(
+        VERTEX_ATTRIBUTE(SkinnedTestVertex, Position, 0),
+        MakeVertexAttribute<std::uint16_t[4]>(3, offsetof(SkinnedTestVertex, Color), true),
+        VERTEX_ATTRIBUTE(SkinnedTestVertex, BoneIDs, 5),
+        VERTEX_ATTRIBUTE(SkinnedTestVertex, Weights, 6));
+};
+
+namespace
+{
+    Vertex MakeVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& uv)
+    {
+        Vertex v{};
+        v.Position  = position;
+        v.Normal    = normal;
+        v.TexCoords = uv;
+        return v;
+    }
+}
+
+TEST(VertexFormatTest, Strides)
+{
+    // the default keeps everything Vertex has, in two streams
+    EXPECT_EQ(VertexFormat{}.VertexSize(), sizeof(Vertex));
+
+    VertexFormat compact;
+    compact.Quantized     = true;
+    compact.HalfTexCoords = true;
+    compact.Tangents      = false;
+    compact.Skinned       = false;
+    EXPECT_EQ(compact.AttributeStride(), 8u);
+    EXPECT_EQ(compact.VertexSize(), 20u);
+
+    compact.Tangents = true;
+    compact.Skinned  = true;
+    EXPECT_EQ(compact.WeightOffset(), 24u);
+    EXPECT_EQ(compact.VertexSize(), 44u);
+}
+
+TEST(VertexFormatTest, OctahedralRoundTrip)
+{
+    // a spiral over the whole sphere, plus the axes and the octahedron's folds
+    std::vector<glm::vec3> directions = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 },
+        { 1, 1, -1 }, { -1, 1, -1 }, { 1, -1, -1 }, { -1, -1, -1 }, { 1, 0, -1 }, { 0, -1, -1 },
+    };
+    for (int i = 0; i < 2000; ++i)
+    {
+        const float z = 1.0f - 2.0f * (i + 0.5f) / 2000.0f;
+        const float r = std::sqrt(1.0f - z * z);
+        const float a = 2.39996323f * i;
+        directions.emplace_back(r * std::cos(a), r * std::sin(a), z);
+    }
+
+    float worst = 0.0f;
+    for (const glm::vec3& direction : directions)
+    {
+        std::int16_t encoded[2];
+        VertexPacker::OctEncode(direction, encoded);
+        worst = std::max(worst, glm::length(VertexPacker::OctDecode(encoded) - glm::normalize(direction)));
+    }
+    EXPECT_LT(worst, 5e-5f);
+
+    std::int16_t zero[2] = { 1, 1 };
+    VertexPacker::OctEncode(glm::vec3(0.0f), zero);
+    EXPECT_EQ(zero[0], 0);
+    EXPECT_EQ(zero[1], 0);
+}
+
+TEST(VertexFormatTest, SelectKeepsOnlyWhatIsUsed)
+{
+    std::vector<Vertex> vertices = {
+        MakeVertex({ 0, 0, 0 }, { 0, 1, 0 }, { 0.0f, 0.0f }),
+        MakeVertex({ 1, 0, 0 }, { 0, 1, 0 }, { 1.0f, 0.5f }),
+    };
+    vertices[1].Tangent = glm::vec3(1, 0, 0);
+
+    VertexFormat format = VertexPacker::SelectFormat(vertices, false, true);
+    EXPECT_TRUE(format.Quantized);
+    EXPECT_TRUE(format.HalfTexCoords);
+    EXPECT_FALSE(format.Tangents);
+    EXPECT_FALSE(format.Skinned);
+
+    // tangents only count under a normal map
+    EXPECT_TRUE(VertexPacker::SelectFormat(vertices, true, true).Tangents);
+
+    // tiled UVs lose too much as half floats; weights make a mesh skinned
+    vertices[0].TexCoords  = glm::vec2(12.0f, 0.0f);
+    vertices[1].m_Weights[0] = 1.0f;
+    format = VertexPacker::SelectFormat(vertices, false, true);
+    EXPECT_FALSE(format.HalfTexCoords);
+    EXPECT_TRUE(format.Skinned);
+
+    format = VertexPacker::SelectFormat(vertices, false, false);
+    EXPECT_FALSE(format.Quantized);
+    EXPECT_FALSE(format.HalfTexCoords);
+}
+
+TEST(VertexFormatTest, PackWritesPositionsThenAttributes)
+{
+    const std::vector<Vertex> vertices = {
+        MakeVertex({ 1.5f, -2.0f, 3.25f }, { 0, 0, -1 }, { 0.25f, 0.75f }),
+        MakeVertex({ 4.0f, 5.0f, -6.0f },  { 0.6f, 0.8f, 0 }, { 1.0f, 0.5f }),
+        MakeVertex({ 7.0f, 8.0f, 9.0f },   { 0, 1, 0 }, { 0.0f, 1.0f }),
+    };
+    const VertexFormat format = VertexPacker::SelectFormat(vertices, false, true);
+
+    std::vector<unsigned char> packed;
+    VertexPacker::Pack(vertices, format, packed);
+    ASSERT_EQ(packed.size(), VertexPacker::PackedSize(vertices.size(), format));
+    ASSERT_EQ(packed.size(), 3u * 20u);
+
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        glm::vec3 position;
+        std::memcpy(&position, packed.data() + i * VertexFormat::kPositionStride, sizeof(position));
+        EXPECT_EQ(position, vertices[i].Position);
+
+        const unsigned char* element = packed.data() + VertexPacker::AttributeOffset(vertices.size()) + i * format.AttributeStride();
+        std::int16_t normal[2];
+        std::memcpy(normal, element + format.NormalOffset(), sizeof(normal));
+        EXPECT_LT(glm::length(VertexPacker::OctDecode(normal) - vertices[i].Normal), 5e-5f);
+
+        std::uint16_t uv[2];
+        std::memcpy(uv, element + format.TexCoordOffset(), sizeof(uv));
+        EXPECT_FLOAT_EQ(glm::unpackHalf1x16(uv[0]), vertices[i].TexCoords.x);
+        EXPECT_FLOAT_EQ(glm::unpackHalf1x16(uv[1]), vertices[i].TexCoords.y);
+    }
+}
+
+TEST(VertexFormatTest, UnpackReversesPack)
+{
+    std::vector<Vertex> vertices = {
+        MakeVertex({ 1.5f, -2.0f, 3.25f }, { 0, 0, -1 }, { 0.25f, 0.75f }),
+        MakeVertex({ 4.0f, 5.0f, -6.0f },  { 0.6f, 0.8f, 0 }, { 1.0f, 0.5f }),
+    };
+    vertices[0].Tangent      = glm::vec3(1, 0, 0);
+    vertices[0].Bitangent    = glm::vec3(0, 1, 0);
+    vertices[1].m_BoneIDs[0] = 7;
+    vertices[1].m_Weights[0] = 0.75f;
+
+    for (bool quantize : { false, true })
+    {
+        const VertexFormat format = VertexPacker::SelectFormat(vertices, true, quantize);
+        std::vector<unsigned char> packed;
+        VertexPacker::Pack(vertices, format, packed);
+        std::vector<Vertex> unpacked;
+        VertexPacker::Unpack(packed.data(), vertices.size(), format, unpacked);
+        ASSERT_EQ(unpacked.size(), vertices.size());
+
+        const float tolerance = quantize ? 5e-5f : 0.0f;
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            EXPECT_EQ(unpacked[i].Position, vertices[i].Position);
+            EXPECT_LE(glm::length(unpacked[i].Normal - vertices[i].Normal), tolerance);
+            EXPECT_EQ(unpacked[i].TexCoords, vertices[i].TexCoords);
+            EXPECT_EQ(unpacked[i].m_BoneIDs[0], vertices[i].m_BoneIDs[0]);
+            EXPECT_NEAR(unpacked[i].m_Weights[0], vertices[i].m_Weights[0], quantize ? 1e-4f : 0.0f);
+        }
+        EXPECT_LE(glm::length(unpacked[0].Tangent - vertices[0].Tangent), tolerance);
+        EXPECT_LE(glm::length(unpacked[0].Bitangent - vertices[0].Bitangent), tolerance);
+    }
+}
+
+TEST(VertexFormatTest, LayoutsAreDerivedFromVertexStructs)
+{
+    constexpr const auto& primitive = VertexLayoutOf<PositionNormalTexVertex>::Layout;
+    static_assert(primitive.GetStride() == 8 * sizeof(float));
+    static_assert(primitive.GetAttributes().size() == 3);
+    static_assert(primitive.GetAttributes()[2].m_Offset == 6 * sizeof(float));
+    const unsigned int counts[] = { 3, 3, 2 };
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const VertexBufferAttribute& attribute = primitive.GetAttributes()[i];
+        EXPECT_EQ(attribute.m_Location, i);
+        EXPECT_EQ(attribute.m_Element.m_Count, counts[i]);
+        EXPECT_EQ(attribute.m_Element.m_Type, static_cast<unsigned int>(GL_FLOAT));
+        EXPECT_FALSE(attribute.m_Element.m_Integer);
+    }
+    EXPECT_EQ(VertexLayoutOf<PositionNormalVertex>::Layout.GetStride(), 6 * sizeof(float));
+
+    // integer members stay integers unless normalized
+    constexpr const auto& skinned = VertexLayoutOf<SkinnedTestVertex>::Layout;
+    EXPECT_EQ(skinned.GetStride(), sizeof(SkinnedTestVertex));
+    const VertexBufferAttribute& color   = skinned.GetAttributes()[1];
+    const VertexBufferAttribute& boneIDs = skinned.GetAttributes()[2];
+    const VertexBufferAttribute& weights = skinned.GetAttributes()[3];
+    EXPECT_EQ(color.m_Element.m_Type, static_cast<unsigned int>(GL_UNSIGNED_SHORT));
+    EXPECT_TRUE(color.m_Element.m_Normalized);
+    EXPECT_FALSE(color.m_Element.m_Integer);
+    EXPECT_EQ(boneIDs.m_Location, 5u);
+    EXPECT_EQ(boneIDs.m_Offset, offsetof(SkinnedTestVertex, BoneIDs));
+    EXPECT_EQ(boneIDs.m_Element.m_Count, 4u);
+    EXPECT_EQ(boneIDs.m_Element.m_Type, static_cast<unsigned int>(GL_UNSIGNED_INT));
+    EXPECT_TRUE(boneIDs.m_Element.m_Integer);
+    EXPECT_EQ(weights.m_Element.m_Count, 4u);
+    EXPECT_FALSE(weights.m_Element.m_Integer);
+}
@@ -0,0 +1,285 @@
+// iov-convert: offline asset converter. Walks a directory tree and brings the viewer's caches
+// up to date for everything in it, with no window or GL context: every model gets its mesh
+// cache entry (cache/meshes/) and every texture, found in the tree or referenced by a model,
+// its decoded texture cache entry (cache/textures/). Files run in parallel on the engine's
+// thread pool; entries that already match their source are skipped. A summary with throughput
+// and failures is printed, and optionally written as JSON.
+//
+// Usage: iov-convert <directory> [--force] [--report <file.json>]
+
+#include "Graphics/MeshCache.h"
+#include "Graphics/ModelManager.h"
+#include "Graphics/TextureCache.h"
+#include "Utility/Json.h"
+#include "Utility/Log.hpp"
+#include "Utility/Timer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace isaacObjectViewer;
+
+namespace
+{
+    enum class Status { UpToDate, Written, NotCached, Failed };
+
+    const char* StatusName(Status status)
+    {
+        switch (status)
+        {
+            case Status::UpToDate:  return "up to date";
+            case Status::Written:   return "written";
+            case Status::NotCached: return "read directly";
+            case Status::Failed:    return "failed";
+        }
+        return "unknown";
+    }
+
+    struct FileResult
+    {
+        std::string   Path;
+        Status        State        { Status::Failed };
+        std::uint64_t SourceBytes  { 0 };
+        double        Milliseconds { 0.0 };
+    };
+
+    std::string Extension(const std::filesystem::path& path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        return ext;
+    }
+
+    bool IsModel(const std::string& ext)
+    {
+        static const char* kModels[] = { ".obj", ".fbx", ".dae", ".gltf", ".glb", ".stl", ".ply" };
+        return std::any_of(std::begin(kModels), std::end(kModels), [&](const char* m) { return ext == m; });
+    }
+
+    bool IsTexture(const std::string& ext)
+    {
+        static const char* kTextures[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr" };
+        return std::any_of(std::begin(kTextures), std::end(kTextures), [&](const char* t) { return ext == t; });
+    }
+
+    std::string Canonical(const std::string& path)
+    {
+        std::error_code ec;
+        const auto canonical = std::filesystem::weakly_canonical(path, ec);
+        return ec ? path : canonical.string();
+    }
+
+    std::uint64_t FileSize(const std::string& path)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : size;
+    }
+
+    Status ConvertTexture(const std::string& path, bool force)
+    {
+        TextureCacheKey key;
+        if (!TextureCache::MakeKey(path, key))
+            return Status::Failed;
+        const std::string cachePath = TextureCache::GetCachePath(path);
+        if (!force && TextureCache::IsCurrent(cachePath, key))
+            return Status::UpToDate;
+
+        const DecodedImage image = TextureManager::DecodeImage(path);
+        if (!image.IsValid())
+        {
+            LOG_ERROR("Failed to decode texture at: {}", path);
+            return Status::Failed;
+        }
+        return TextureCache::Write(cachePath, image, key) ? Status::Written : Status::Failed;
+    }
+
+    struct Summary
+    {
+        const char*   Kind;
+        std::size_t   Counts[4] = {};
+        std::uint64_t ConvertedBytes = 0;
+        double        Seconds        = 0.0;
+
+        Summary(const char* kind, const std::vector<FileResult>& results, double seconds) : Kind(kind), Seconds(seconds)
+        {
+            for (const FileResult& result : results)
+            {
+                ++Counts[static_cast<int>(result.State)];
+                if (result.State == Status::Written)
+                    ConvertedBytes += result.SourceBytes;
+            }
+        }
+
+        double MegabytesPerSecond() const { return Seconds > 0.0 ? ConvertedBytes / (1024.0 * 1024.0) / Seconds : 0.0; }
+
+        void Print() const
+        {
+            std::printf("%-8s %6zu written, %6zu up to date, %6zu read directly, %6zu failed | %8.1f MB in %7.2f s, %7.1f MB/s\n",
+                        Kind, Counts[int(Status::Written)], Counts[int(Status::UpToDate)], Counts[int(Status::NotCached)],
+                        Counts[int(Status::Failed)], ConvertedBytes / (1024.0 * 1024.0), Seconds, MegabytesPerSecond());
+        }
+    };
+
+    bool WriteReport(const std::string& path, const std::string& root, const std::vector<FileResult>& models,
+                     const std::vector<FileResult>& textures, const Summary& modelSummary, const Summary& textureSummary)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+            return false;
+
+        auto writeSummary = [&](const Summary& summary)
+        {
+            out << "{ \"written\": " << summary.Counts[int(Status::Written)]
+                << ", \"upToDate\": " << summary.Counts[int(Status::UpToDate)]
+                << ", \"readDirectly\": " << summary.Counts[int(Status::NotCached)]
+                << ", \"failed\": " << summary.Counts[int(Status::Failed)]
+                << ", \"convertedBytes\": " << summary.ConvertedBytes
+                << ", \"seconds\": " << summary.Seconds
+                << ", \"megabytesPerSecond\": " << summary.MegabytesPerSecond() << " }";
+        };
+        auto writeFiles = [&](const std::vector<FileResult>& results)
+        {
+            out << "[";
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const FileResult& result = results[i];
+                out << (i ? ",\n    " : "\n    ") << "{ \"path\": " << JsonQuote(result.Path)
+                    << ", \"status\": " << JsonQuote(StatusName(result.State))
+                    << ", \"bytes\": " << result.SourceBytes
+                    << ", \"milliseconds\": " << result.Milliseconds << " }";
+            }
+            out << "\n  ]";
+        };
+
+        out << "{\n  \"root\": " << JsonQuote(root) << ",\n";
+        out << "  \"models\": ";   writeSummary(modelSummary);   out << ",\n";
+        out << "  \"textures\": "; writeSummary(textureSummary); out << ",\n";
+        out << "  \"modelFiles\": ";   writeFiles(models);   out << ",\n";
+        out << "  \"textureFiles\": "; writeFiles(textures); out << "\n}\n";
+        return bool(out);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    std::string root, reportPath;
+    bool force = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--force") == 0)
+            force = true;
+        else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc)
+            reportPath = argv[++i];
+        else if (root.empty())
+            root = argv[i];
+    }
+    std::error_code ec;
+    if (root.empty() || !std::filesystem::is_directory(root, ec))
+    {
+        std::fprintf(stderr, "Usage: iov-convert <directory> [--force] [--report <file.json>]\n");
+        return 2;
+    }
+
+    // caches are keyed by source content, so the walk order doesn't matter; sorted for a stable report
+    std::vector<std::string> modelPaths;
+    std::set<std::string> texturePaths;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (ec || !it->is_regular_file(ec))
+            continue;
+        const std::string ext = Extension(it->path());
+        if (IsModel(ext))
+            modelPaths.push_back(Canonical(it->path().string()));
+        else if (IsTexture(ext))
+            texturePaths.insert(Canonical(it->path().string()));
+    }
+    std::sort(modelPaths.begin(), modelPaths.end());
+
+    ThreadPool& pool = ThreadPool::GetInstance();
+    MeshCache::SetEnabled(true);
+    std::printf("iov-convert: %zu models, %zu textures under %s, %u worker threads%s\n",
+                modelPaths.size(), texturePaths.size(), root.c_str(), pool.GetThreadCount(), force ? ", forced" : "");
+
+    // models first: they add the textures they reference, wherever those live
+    // (each import fans out on the same pool, so a single huge model still uses every core)
+    Timer timer;
+    timer.Start();
+    std::mutex textureMutex;
+    std::vector<FileResult> models(modelPaths.size());
+    pool.ParallelFor(modelPaths.size(), [&](std::size_t i)
+    {
+        FileResult& result = models[i];
+        result.Path        = modelPaths[i];
+        result.SourceBytes = FileSize(result.Path);
+
+        Timer fileTimer;
+        fileTimer.Start();
+        std::vector<std::string> referenced;
+        switch (ModelManager::UpdateMeshCache(result.Path, {}, force, &referenced))
+        {
+            case ModelManager::CacheResult::UpToDate:  result.State = Status::UpToDate;  break;
+            case ModelManager::CacheResult::Written:   result.State = Status::Written;   break;
+            case ModelManager::CacheResult::NotCached: result.State = Status::NotCached; break;
+            case ModelManager::CacheResult::Failed:    result.State = Status::Failed;    break;
+        }
+        result.Milliseconds = fileTimer.Stop() * 1000.0;
+
+        std::lock_guard<std::mutex> lock(textureMutex);
+        for (const std::string& texture : referenced)
+            texturePaths.insert(Canonical(texture));
+    });
+    const Summary modelSummary("models", models, timer.Stop());
+
+    timer.Start();
+    const std::vector<std::string> textureList(texturePaths.begin(), texturePaths.end());
+    std::vector<FileResult> textures(textureList.size());
+    pool.ParallelFor(textureList.size(), [&](std::size_t i)
+    {
+        FileResult& result = textures[i];
+        result.Path        = textureList[i];
+        result.SourceBytes = FileSize(result.Path);
+
+        Timer fileTimer;
+        fileTimer.Start();
+        result.State        = ConvertTexture(result.Path, force);
+        result.Milliseconds = fileTimer.Stop() * 1000.0;
+    });
+    const Summary textureSummary("textures", textures, timer.Stop());
+
+    std::printf("\n");
+    modelSummary.Print();
+    textureSummary.Print();
+
+    std::size_t failures = 0;
+    for (const std::vector<FileResult>* results : { &models, &textures })
+    {
+        for (const FileResult& result : *results)
+        {
+            if (result.State != Status::Failed)
+                continue;
+            if (failures++ == 0)
+                std::printf("\nfailed:\n");
+            std::printf("  %s\n", result.Path.c_str());
+        }
+    }
+
+    if (!reportPath.empty())
+    {
+        if (WriteReport(reportPath, Canonical(root), models, textures, modelSummary, textureSummary))
+            std::printf("\nreport written to %s\n", reportPath.c_str());
+        else
+            std::fprintf(stderr, "failed to write report %s\n", reportPath.c_str());
+    }
+    return failures > 0 ? 1 : 0;
+}